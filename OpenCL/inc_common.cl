@@ -2986,6 +2986,23 @@ DECLSPEC u32 check_bitmap (GLOBAL_AS const u32 *bitmap, const u32 bitmap_mask, c
   return (bitmap[(digest >> bitmap_shift) & bitmap_mask] & (1 << (digest & 0x1f)));
 }
 
+DECLSPEC u32 check_l1 (PRIVATE_AS const u32 *digest, BITMAP_L1_AS const u32 *bitmap_l1, const u32 bitmap_l1_enabled)
+{
+  if (bitmap_l1_enabled == 0) return (1);
+
+  const u32 bit0 = digest[0] >> (32 - BITMAP_L1_BITS);
+  const u32 bit1 = digest[1] >> (32 - BITMAP_L1_BITS);
+  const u32 bit2 = digest[2] >> (32 - BITMAP_L1_BITS);
+  const u32 bit3 = digest[3] >> (32 - BITMAP_L1_BITS);
+
+  if ((bitmap_l1[bit0 >> 5] & (1u << (bit0 & 0x1f))) == 0) return (0);
+  if ((bitmap_l1[bit1 >> 5] & (1u << (bit1 & 0x1f))) == 0) return (0);
+  if ((bitmap_l1[bit2 >> 5] & (1u << (bit2 & 0x1f))) == 0) return (0);
+  if ((bitmap_l1[bit3 >> 5] & (1u << (bit3 & 0x1f))) == 0) return (0);
+
+  return (1);
+}
+
 DECLSPEC u32 check (PRIVATE_AS const u32 *digest, GLOBAL_AS const u32 *bitmap_s1_a, GLOBAL_AS const u32 *bitmap_s1_b, GLOBAL_AS const u32 *bitmap_s1_c, GLOBAL_AS const u32 *bitmap_s1_d, GLOBAL_AS const u32 *bitmap_s2_a, GLOBAL_AS const u32 *bitmap_s2_b, GLOBAL_AS const u32 *bitmap_s2_c, GLOBAL_AS const u32 *bitmap_s2_d, const u32 bitmap_mask, const u32 bitmap_shift1, const u32 bitmap_shift2)
 {
   if (check_bitmap (bitmap_s1_a, bitmap_mask, bitmap_shift1, digest[0]) == 0) return (0);
@@ -3007,6 +3024,9 @@ DECLSPEC void mark_hash (GLOBAL_AS plain_t *plains_buf, GLOBAL_AS u32 *d_result,
 
   #if ATTACK_MODE == 9
 
+  #elif defined SALT_PACK
+  // digests_cnt is per salt but one launch can cover several salts, hashes_shown still allows only one plain per
+  // digest and plains_buf is sized for all digests
   #else
   if (idx >= digests_cnt)
   {
@@ -196,6 +196,45 @@
 #define KERN_ATTR_FUNC_VECTOR()                _KERN_ATTR_VECTOR(), KERN_ATTR_FUNC_PARAMS
 #define KERN_ATTR_FUNC_VECTOR_ESALT(e)         _KERN_ATTR_VECTOR_ESALT(e), KERN_ATTR_FUNC_PARAMS
 
+/*
+ * First-level bitmap for the multi-hash compares (COMPARE_M_SCALAR, COMPARE_M_SIMD, COMPARE_M)
+ *
+ * A kernel which defines BITMAP_L1_LOCAL before its includes loads the bitmap with BITMAP_L1_LOAD ()
+ * before its gid check and passes s_bitmap_l1 on to its DECLSPEC functions as BITMAP_L1_AS const u32 *.
+ * With real shared memory it is copied into local memory once per work-group, otherwise it is read from
+ * bitmaps_buf_s1_a directly. A digest rejected by it never touches the global memory bitmaps.
+ */
+
+#ifdef REAL_SHM
+#define BITMAP_L1_AS LOCAL_AS
+#else
+#define BITMAP_L1_AS GLOBAL_AS
+#endif
+
+#ifdef REAL_SHM
+#define BITMAP_L1_LOAD()                                      \
+  LOCAL_VK u32 s_bitmap_l1[BITMAP_L1_NUMS];                   \
+                                                              \
+  if (BITMAP_L1_ENABLED)                                      \
+  {                                                           \
+    for (u32 i = lid; i < BITMAP_L1_NUMS; i += lsz)           \
+    {                                                         \
+      s_bitmap_l1[i] = bitmaps_buf_s1_a[BITMAP_MASK + 1 + i]; \
+    }                                                         \
+  }                                                           \
+                                                              \
+  SYNC_THREADS ()
+#else
+#define BITMAP_L1_LOAD()                                      \
+  GLOBAL_AS const u32 *s_bitmap_l1 = bitmaps_buf_s1_a + BITMAP_MASK + 1
+#endif
+
+#ifdef BITMAP_L1_LOCAL
+#define CHECK_L1(digest) check_l1 ((digest), s_bitmap_l1, BITMAP_L1_ENABLED)
+#else
+#define CHECK_L1(digest) (1)
+#endif
+
 // basic functions
 
 DECLSPEC u32 u16_bin_to_u32_hex_lsn (const u32 v);
@@ -317,6 +356,7 @@ DECLSPEC int pkcs_padding_bs16 (PRIVATE_AS const u32 *data_buf, const int data_l
 DECLSPEC int asn1_detect (PRIVATE_AS const u32 *buf, const int len);
 DECLSPEC int asn1_check_int_tag (PRIVATE_AS const u32 *buf, const int len);
 DECLSPEC u32 check_bitmap (GLOBAL_AS const u32 *bitmap, const u32 bitmap_mask, const u32 bitmap_shift, const u32 digest);
+DECLSPEC u32 check_l1 (PRIVATE_AS const u32 *digest, BITMAP_L1_AS const u32 *bitmap_l1, const u32 bitmap_l1_enabled);
 DECLSPEC u32 check (PRIVATE_AS const u32 *digest, GLOBAL_AS const u32 *bitmap_s1_a, GLOBAL_AS const u32 *bitmap_s1_b, GLOBAL_AS const u32 *bitmap_s1_c, GLOBAL_AS const u32 *bitmap_s1_d, GLOBAL_AS const u32 *bitmap_s2_a, GLOBAL_AS const u32 *bitmap_s2_b, GLOBAL_AS const u32 *bitmap_s2_c, GLOBAL_AS const u32 *bitmap_s2_d, const u32 bitmap_mask, const u32 bitmap_shift1, const u32 bitmap_shift2);
 DECLSPEC void mark_hash (GLOBAL_AS plain_t *plains_buf, GLOBAL_AS u32 *d_result, const u32 salt_pos, const u32 digests_cnt, const u32 digest_pos, const u32 hash_pos, const u64 gid, const u32 il_pos, const u32 extra1, const u32 extra2);
 DECLSPEC int hc_count_char (PRIVATE_AS const u32 *buf, const int elems, const u32 c);
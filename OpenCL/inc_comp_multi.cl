@@ -5,18 +5,18 @@ digest_tp[1] = r1;
 digest_tp[2] = r2;
 digest_tp[3] = r3;
 
-if (check (digest_tp,
-             bitmaps_buf_s1_a,
-             bitmaps_buf_s1_b,
-             bitmaps_buf_s1_c,
-             bitmaps_buf_s1_d,
-             bitmaps_buf_s2_a,
-             bitmaps_buf_s2_b,
-             bitmaps_buf_s2_c,
-             bitmaps_buf_s2_d,
-             BITMAP_MASK,
-             BITMAP_SHIFT1,
-             BITMAP_SHIFT2))
+if (CHECK_L1 (digest_tp) && check (digest_tp,
+                                   bitmaps_buf_s1_a,
+                                   bitmaps_buf_s1_b,
+                                   bitmaps_buf_s1_c,
+                                   bitmaps_buf_s1_d,
+                                   bitmaps_buf_s2_a,
+                                   bitmaps_buf_s2_b,
+                                   bitmaps_buf_s2_c,
+                                   bitmaps_buf_s2_d,
+                                   BITMAP_MASK,
+                                   BITMAP_SHIFT1,
+                                   BITMAP_SHIFT2))
 {
   int digest_pos = find_hash (digest_tp, DIGESTS_CNT, &digests_buf[DIGESTS_OFFSET_HOST]);
 
@@ -0,0 +1,89 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef INC_NATIVE_H
+#define INC_NATIVE_H
+
+/**
+ * Forced include (-include) for kernels built by the native backend with the host C compiler.
+ * Defining HC_CPU_OPENCL_EMU_H selects IS_NATIVE in inc_vendor.h, the same path the emu_inc_*.c files use,
+ * everything the host provides for them (bitops.c, emu_general.c) is defined here instead.
+ */
+
+#define HC_CPU_OPENCL_EMU_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t  uchar;
+typedef uint16_t ushort;
+typedef uint32_t uint;
+typedef uint64_t ulong;
+typedef uint64_t ullong;
+
+// gpu_memset() and gpu_bzero() in shared.cl use the emulated scalar type
+
+typedef uint32_t uint4;
+
+#define NATIVE_EXPORT __attribute__ ((visibility ("default")))
+
+/**
+ * work-item index, set by hc_native_launch() for each work-item the calling pool thread runs
+ * work-groups are of size 1, so local id is always 0 and the group id equals the global id
+ */
+
+static __thread size_t hc_native_gid;
+
+static inline size_t get_global_id  (const uint32_t dimindx __attribute__ ((unused))) { return hc_native_gid; }
+static inline size_t get_group_id   (const uint32_t dimindx __attribute__ ((unused))) { return hc_native_gid; }
+static inline size_t get_local_id   (const uint32_t dimindx __attribute__ ((unused))) { return 0; }
+static inline size_t get_local_size (const uint32_t dimindx __attribute__ ((unused))) { return 1; }
+
+static inline uint32_t rotl32 (const uint32_t a, const int n) { return (a << n) | (a >> ((32 - n) & 31)); }
+static inline uint32_t rotr32 (const uint32_t a, const int n) { return (a >> n) | (a << ((32 - n) & 31)); }
+static inline uint64_t rotl64 (const uint64_t a, const int n) { return (a << n) | (a >> ((64 - n) & 63)); }
+static inline uint64_t rotr64 (const uint64_t a, const int n) { return (a >> n) | (a << ((64 - n) & 63)); }
+
+static inline uint16_t byte_swap_16 (const uint16_t n) { return (uint16_t) ((n >> 8) | (n << 8)); }
+static inline uint32_t byte_swap_32 (const uint32_t n) { return __builtin_bswap32 (n); }
+static inline uint64_t byte_swap_64 (const uint64_t n) { return __builtin_bswap64 (n); }
+
+// work-items run concurrently on the pool threads, so unlike in emu_general.c these have to be real atomics
+
+static inline uint32_t hc_atomic_dec (volatile uint32_t *p)                     { return __atomic_fetch_sub (p, 1,   __ATOMIC_RELAXED); }
+static inline uint32_t hc_atomic_inc (volatile uint32_t *p)                     { return __atomic_fetch_add (p, 1,   __ATOMIC_RELAXED); }
+static inline uint32_t hc_atomic_or  (volatile uint32_t *p, const uint32_t val) { return __atomic_fetch_or  (p, val, __ATOMIC_RELAXED); }
+
+/**
+ * entry point resolved by hc_nativeModuleLoad(), runs the work-items [gid_start, gid_end) of one kernel
+ * all kernel arguments are pointers or integers, so they are passed as 64 bit values in their declared order
+ */
+
+#define NATIVE_ARGS_MAX 32
+
+typedef void (*hc_native_kernel_t) (uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+                                    uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+                                    uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+                                    uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
+
+NATIVE_EXPORT void hc_native_launch (void *kernel, const uint64_t *a, const uint64_t gid_start, const uint64_t gid_end)
+{
+  const hc_native_kernel_t k = (hc_native_kernel_t) kernel;
+
+  for (uint64_t gid = gid_start; gid < gid_end; gid++)
+  {
+    hc_native_gid = (size_t) gid;
+
+    k (a[ 0], a[ 1], a[ 2], a[ 3], a[ 4], a[ 5], a[ 6], a[ 7],
+       a[ 8], a[ 9], a[10], a[11], a[12], a[13], a[14], a[15],
+       a[16], a[17], a[18], a[19], a[20], a[21], a[22], a[23],
+       a[24], a[25], a[26], a[27], a[28], a[29], a[30], a[31]);
+  }
+}
+
+#endif // INC_NATIVE_H
@@ -20,7 +20,7 @@
 {                                                                                                           \
   const u32 digest_tp0[4] = { h0, h1, h2, h3 };                                                             \
                                                                                                             \
-  if (check (digest_tp0,                                                                                    \
+  if (CHECK_L1 (digest_tp0) && check (digest_tp0,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
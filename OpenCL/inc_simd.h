@@ -30,7 +30,7 @@
 {                                                                                                           \
   const u32 digest_tp0[4] = { h0, h1, h2, h3 };                                                             \
                                                                                                             \
-  if (check (digest_tp0,                                                                                    \
+  if (CHECK_L1 (digest_tp0) && check (digest_tp0,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -90,7 +90,7 @@
   const u32 digest_tp0[4] = { h0.s0, h1.s0, h2.s0, h3.s0 };                                                 \
   const u32 digest_tp1[4] = { h0.s1, h1.s1, h2.s1, h3.s1 };                                                 \
                                                                                                             \
-  if (check (digest_tp0,                                                                                    \
+  if (CHECK_L1 (digest_tp0) && check (digest_tp0,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -110,7 +110,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp1,                                                                                    \
+  if (CHECK_L1 (digest_tp1) && check (digest_tp1,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -190,7 +190,7 @@
   const u32 digest_tp2[4] = { h0.s2, h1.s2, h2.s2, h3.s2 };                                                 \
   const u32 digest_tp3[4] = { h0.s3, h1.s3, h2.s3, h3.s3 };                                                 \
                                                                                                             \
-  if (check (digest_tp0,                                                                                    \
+  if (CHECK_L1 (digest_tp0) && check (digest_tp0,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -210,7 +210,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp1,                                                                                    \
+  if (CHECK_L1 (digest_tp1) && check (digest_tp1,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -230,7 +230,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp2,                                                                                    \
+  if (CHECK_L1 (digest_tp2) && check (digest_tp2,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -250,7 +250,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp3,                                                                                    \
+  if (CHECK_L1 (digest_tp3) && check (digest_tp3,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -373,7 +373,7 @@
   const u32 digest_tp6[4] = { h0.s6, h1.s6, h2.s6, h3.s6 };                                                 \
   const u32 digest_tp7[4] = { h0.s7, h1.s7, h2.s7, h3.s7 };                                                 \
                                                                                                             \
-  if (check (digest_tp0,                                                                                    \
+  if (CHECK_L1 (digest_tp0) && check (digest_tp0,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -393,7 +393,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp1,                                                                                    \
+  if (CHECK_L1 (digest_tp1) && check (digest_tp1,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -413,7 +413,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp2,                                                                                    \
+  if (CHECK_L1 (digest_tp2) && check (digest_tp2,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -433,7 +433,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp3,                                                                                    \
+  if (CHECK_L1 (digest_tp3) && check (digest_tp3,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -452,7 +452,7 @@
       }                                                                                                     \
     }                                                                                                       \
   }                                                                                                         \
-  if (check (digest_tp4,                                                                                    \
+  if (CHECK_L1 (digest_tp4) && check (digest_tp4,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -472,7 +472,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp5,                                                                                    \
+  if (CHECK_L1 (digest_tp5) && check (digest_tp5,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -492,7 +492,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp6,                                                                                    \
+  if (CHECK_L1 (digest_tp6) && check (digest_tp6,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -512,7 +512,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp7,                                                                                    \
+  if (CHECK_L1 (digest_tp7) && check (digest_tp7,                                                           \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -723,7 +723,7 @@
   const u32 digest_tp14[4] = { h0.se, h1.se, h2.se, h3.se };                                                \
   const u32 digest_tp15[4] = { h0.sf, h1.sf, h2.sf, h3.sf };                                                \
                                                                                                             \
-  if (check (digest_tp00,                                                                                   \
+  if (CHECK_L1 (digest_tp00) && check (digest_tp00,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -743,7 +743,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp01,                                                                                   \
+  if (CHECK_L1 (digest_tp01) && check (digest_tp01,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -763,7 +763,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp02,                                                                                   \
+  if (CHECK_L1 (digest_tp02) && check (digest_tp02,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -783,7 +783,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp03,                                                                                   \
+  if (CHECK_L1 (digest_tp03) && check (digest_tp03,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -803,7 +803,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp04,                                                                                   \
+  if (CHECK_L1 (digest_tp04) && check (digest_tp04,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -823,7 +823,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp05,                                                                                   \
+  if (CHECK_L1 (digest_tp05) && check (digest_tp05,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -843,7 +843,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp06,                                                                                   \
+  if (CHECK_L1 (digest_tp06) && check (digest_tp06,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -863,7 +863,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp07,                                                                                   \
+  if (CHECK_L1 (digest_tp07) && check (digest_tp07,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -883,7 +883,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp08,                                                                                   \
+  if (CHECK_L1 (digest_tp08) && check (digest_tp08,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -903,7 +903,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp09,                                                                                   \
+  if (CHECK_L1 (digest_tp09) && check (digest_tp09,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -923,7 +923,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp10,                                                                                   \
+  if (CHECK_L1 (digest_tp10) && check (digest_tp10,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -943,7 +943,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp11,                                                                                   \
+  if (CHECK_L1 (digest_tp11) && check (digest_tp11,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -963,7 +963,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp12,                                                                                   \
+  if (CHECK_L1 (digest_tp12) && check (digest_tp12,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -983,7 +983,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp13,                                                                                   \
+  if (CHECK_L1 (digest_tp13) && check (digest_tp13,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -1003,7 +1003,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp14,                                                                                   \
+  if (CHECK_L1 (digest_tp14) && check (digest_tp14,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -1023,7 +1023,7 @@
     }                                                                                                       \
   }                                                                                                         \
                                                                                                             \
-  if (check (digest_tp15,                                                                                   \
+  if (CHECK_L1 (digest_tp15) && check (digest_tp15,                                                         \
              bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d,                        \
              bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d,                        \
              BITMAP_MASK,                                                                                   \
@@ -7,17 +7,41 @@
 #define INC_TYPES_H
 
 #if ATTACK_MODE == 9
+// each hash has association_width consecutive candidates in pws_buf, so work-item gid tests candidate
+// (pws_pos + gid) % association_width against the salt and the single digest (pws_pos + gid) / association_width
+#define ASSOCIATION_SLOT(id) ((u32) ((kernel_param->pws_pos + (id)) / kernel_param->association_width))
 #define BITMAP_MASK         kernel_param->bitmap_mask
 #define BITMAP_SHIFT1       kernel_param->bitmap_shift1
 #define BITMAP_SHIFT2       kernel_param->bitmap_shift2
-#define SALT_POS_HOST       (kernel_param->pws_pos + gid)
-#define SALT_POS_HOST_BID   (kernel_param->pws_pos + bid)
+#define BITMAP_L1_ENABLED   kernel_param->bitmap_l1_enabled
+#define SALT_POS_HOST       ASSOCIATION_SLOT (gid)
+#define SALT_POS_HOST_BID   ASSOCIATION_SLOT (bid)
 #define LOOP_POS            kernel_param->loop_pos
 #define LOOP_CNT            kernel_param->loop_cnt
 #define IL_CNT              kernel_param->il_cnt
 #define DIGESTS_CNT         1
-#define DIGESTS_OFFSET_HOST     (kernel_param->pws_pos + gid)
-#define DIGESTS_OFFSET_HOST_BID (kernel_param->pws_pos + bid)
+#define DIGESTS_OFFSET_HOST     ASSOCIATION_SLOT (gid)
+#define DIGESTS_OFFSET_HOST_BID ASSOCIATION_SLOT (bid)
+#define COMBS_MODE          kernel_param->combs_mode
+#define SALT_REPEAT         kernel_param->salt_repeat
+#define PWS_POS             kernel_param->pws_pos
+#define GID_CNT             kernel_param->gid_max
+#elif defined SALT_PACK
+// the host packs the candidates of consecutive single-digest salts into one launch,
+// each work-item takes its salt from its slot, slots are salt_pack_stride work-items wide
+#define SALT_PACK_SLOT(id)  ((kernel_param->salt_pack_stride == 0) ? 0 : (u32) ((id) / kernel_param->salt_pack_stride))
+#define BITMAP_MASK         kernel_param->bitmap_mask
+#define BITMAP_SHIFT1       kernel_param->bitmap_shift1
+#define BITMAP_SHIFT2       kernel_param->bitmap_shift2
+#define BITMAP_L1_ENABLED   kernel_param->bitmap_l1_enabled
+#define SALT_POS_HOST       (kernel_param->salt_pos_host + SALT_PACK_SLOT (get_global_id (0)))
+#define SALT_POS_HOST_BID   (kernel_param->salt_pos_host + SALT_PACK_SLOT (get_group_id (0)))
+#define LOOP_POS            kernel_param->loop_pos
+#define LOOP_CNT            kernel_param->loop_cnt
+#define IL_CNT              kernel_param->il_cnt
+#define DIGESTS_CNT         kernel_param->digests_cnt
+#define DIGESTS_OFFSET_HOST     (kernel_param->digests_offset_host + SALT_PACK_SLOT (get_global_id (0)))
+#define DIGESTS_OFFSET_HOST_BID (kernel_param->digests_offset_host + SALT_PACK_SLOT (get_group_id (0)))
 #define COMBS_MODE          kernel_param->combs_mode
 #define SALT_REPEAT         kernel_param->salt_repeat
 #define PWS_POS             kernel_param->pws_pos
@@ -26,6 +50,7 @@
 #define BITMAP_MASK         kernel_param->bitmap_mask
 #define BITMAP_SHIFT1       kernel_param->bitmap_shift1
 #define BITMAP_SHIFT2       kernel_param->bitmap_shift2
+#define BITMAP_L1_ENABLED   kernel_param->bitmap_l1_enabled
 #define SALT_POS_HOST       kernel_param->salt_pos_host
 #define SALT_POS_HOST_BID   SALT_POS_HOST
 #define LOOP_POS            kernel_param->loop_pos
@@ -40,6 +65,13 @@
 #define GID_CNT             kernel_param->gid_max
 #endif
 
+// the first-level bitmap, small enough for local memory, is stored behind bitmaps_buf_s1_a
+// each digest sets one bit per compared digest word, taken from its top BITMAP_L1_BITS bits
+
+#define BITMAP_L1_BITS      16
+#define BITMAP_L1_NUMS      (1u << (BITMAP_L1_BITS - 5))
+#define BITMAP_L1_SIZE      (BITMAP_L1_NUMS * 4)
+
 #ifdef IS_CUDA
 // https://docs.nvidia.com/cuda/nvrtc/index.html#integer-size
 typedef unsigned char       uchar;
@@ -2000,6 +2032,9 @@ typedef struct kernel_param
   u32 salt_repeat;          // 34
   u64 pws_pos;              // 35
   u64 gid_max;              // 36
+  u64 salt_pack_stride;     // 37
+  u32 bitmap_l1_enabled;    // 38
+  u32 association_width;    // 39
 
 } kernel_param_t;
 
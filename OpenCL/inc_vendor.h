@@ -31,7 +31,7 @@ using namespace metal;
 #define LOCAL_VK
 #define LOCAL_AS
 #define PRIVATE_AS
-#define KERNEL_FQ
+#define KERNEL_FQ   __attribute__ ((visibility ("default")))
 #elif defined IS_CUDA
 #define CONSTANT_VK __constant__
 #define CONSTANT_AS
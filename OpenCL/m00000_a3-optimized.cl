@@ -4,6 +4,7 @@
  */
 
 #define NEW_SIMD_CODE
+#define BITMAP_L1_LOCAL
 
 #ifdef KERNEL_STATIC
 #include M2S(INCLUDE_PATH/inc_vendor.h)
@@ -31,7 +32,7 @@
   a -= t;                               \
 }
 
-DECLSPEC void m00000m (PRIVATE_AS u32 *w, const u32 pw_len, KERN_ATTR_FUNC_VECTOR ())
+DECLSPEC void m00000m (PRIVATE_AS u32 *w, const u32 pw_len, KERN_ATTR_FUNC_VECTOR (), BITMAP_L1_AS const u32 *s_bitmap_l1)
 {
   /**
    * modifiers are taken from args
@@ -433,6 +434,12 @@ KERNEL_FQ KERNEL_FA void m00000_m04 (KERN_ATTR_VECTOR ())
   const u64 gid = get_global_id (0);
   const u64 lsz = get_local_size (0);
 
+  /**
+   * first-level bitmap
+   */
+
+  BITMAP_L1_LOAD ();
+
   if (gid >= GID_CNT) return;
 
   u32 w[16];
@@ -460,7 +467,7 @@ KERNEL_FQ KERNEL_FA void m00000_m04 (KERN_ATTR_VECTOR ())
    * main
    */
 
-  m00000m (w, pw_len, pws, rules_buf, combs_buf, words_buf_r, tmps, hooks, bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d, bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d, plains_buf, digests_buf, hashes_shown, salt_bufs, esalt_bufs, d_return_buf, d_extra0_buf, d_extra1_buf, d_extra2_buf, d_extra3_buf, kernel_param, gid, lid, lsz);
+  m00000m (w, pw_len, pws, rules_buf, combs_buf, words_buf_r, tmps, hooks, bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d, bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d, plains_buf, digests_buf, hashes_shown, salt_bufs, esalt_bufs, d_return_buf, d_extra0_buf, d_extra1_buf, d_extra2_buf, d_extra3_buf, kernel_param, gid, lid, lsz, s_bitmap_l1);
 }
 
 KERNEL_FQ KERNEL_FA void m00000_m08 (KERN_ATTR_VECTOR ())
@@ -473,6 +480,12 @@ KERNEL_FQ KERNEL_FA void m00000_m08 (KERN_ATTR_VECTOR ())
   const u64 gid = get_global_id (0);
   const u64 lsz = get_local_size (0);
 
+  /**
+   * first-level bitmap
+   */
+
+  BITMAP_L1_LOAD ();
+
   if (gid >= GID_CNT) return;
 
   u32 w[16];
@@ -500,7 +513,7 @@ KERNEL_FQ KERNEL_FA void m00000_m08 (KERN_ATTR_VECTOR ())
    * main
    */
 
-  m00000m (w, pw_len, pws, rules_buf, combs_buf, words_buf_r, tmps, hooks, bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d, bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d, plains_buf, digests_buf, hashes_shown, salt_bufs, esalt_bufs, d_return_buf, d_extra0_buf, d_extra1_buf, d_extra2_buf, d_extra3_buf, kernel_param, gid, lid, lsz);
+  m00000m (w, pw_len, pws, rules_buf, combs_buf, words_buf_r, tmps, hooks, bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d, bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d, plains_buf, digests_buf, hashes_shown, salt_bufs, esalt_bufs, d_return_buf, d_extra0_buf, d_extra1_buf, d_extra2_buf, d_extra3_buf, kernel_param, gid, lid, lsz, s_bitmap_l1);
 }
 
 KERNEL_FQ KERNEL_FA void m00000_m16 (KERN_ATTR_VECTOR ())
@@ -513,6 +526,12 @@ KERNEL_FQ KERNEL_FA void m00000_m16 (KERN_ATTR_VECTOR ())
   const u64 gid = get_global_id (0);
   const u64 lsz = get_local_size (0);
 
+  /**
+   * first-level bitmap
+   */
+
+  BITMAP_L1_LOAD ();
+
   if (gid >= GID_CNT) return;
 
   u32 w[16];
@@ -540,7 +559,7 @@ KERNEL_FQ KERNEL_FA void m00000_m16 (KERN_ATTR_VECTOR ())
    * main
    */
 
-  m00000m (w, pw_len, pws, rules_buf, combs_buf, words_buf_r, tmps, hooks, bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d, bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d, plains_buf, digests_buf, hashes_shown, salt_bufs, esalt_bufs, d_return_buf, d_extra0_buf, d_extra1_buf, d_extra2_buf, d_extra3_buf, kernel_param, gid, lid, lsz);
+  m00000m (w, pw_len, pws, rules_buf, combs_buf, words_buf_r, tmps, hooks, bitmaps_buf_s1_a, bitmaps_buf_s1_b, bitmaps_buf_s1_c, bitmaps_buf_s1_d, bitmaps_buf_s2_a, bitmaps_buf_s2_b, bitmaps_buf_s2_c, bitmaps_buf_s2_d, plains_buf, digests_buf, hashes_shown, salt_bufs, esalt_bufs, d_return_buf, d_extra0_buf, d_extra1_buf, d_extra2_buf, d_extra3_buf, kernel_param, gid, lid, lsz, s_bitmap_l1);
 }
 
 KERNEL_FQ KERNEL_FA void m00000_s04 (KERN_ATTR_VECTOR ())
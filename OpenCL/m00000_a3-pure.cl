@@ -4,6 +4,7 @@
  */
 
 #define NEW_SIMD_CODE
+#define BITMAP_L1_LOCAL
 
 #ifdef KERNEL_STATIC
 #include M2S(INCLUDE_PATH/inc_vendor.h)
@@ -22,6 +23,13 @@ KERNEL_FQ KERNEL_FA void m00000_mxx (KERN_ATTR_VECTOR ())
 
   const u64 lid = get_local_id (0);
   const u64 gid = get_global_id (0);
+  const u64 lsz = get_local_size (0);
+
+  /**
+   * first-level bitmap
+   */
+
+  BITMAP_L1_LOAD ();
 
   if (gid >= GID_CNT) return;
 
@@ -23,6 +23,21 @@
 #include <windows.h>
 #endif // _WIN
 
+#if defined (__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif // __linux__
+
 int set_cpu_affinity (hashcat_ctx_t *hashcat_ctx);
 
+int   numa_topology_init    (numa_topology_t *numa_topology);
+void  numa_topology_destroy (numa_topology_t *numa_topology);
+int   numa_node_for_unit    (const numa_topology_t *numa_topology, const int unit_idx, const int units_cnt);
+int   numa_bind_thread      (const numa_topology_t *numa_topology, const int node_idx);
+
+void *hcmalloc_numa         (const numa_topology_t *numa_topology, const size_t sz, const int node_idx, const bool hugepages);
+void  hcfree_numa           (void *ptr);
+
 #endif // HC_AFFINITY_H
@@ -6,6 +6,12 @@
 #ifndef HC_AUTOTUNE_H
 #define HC_AUTOTUNE_H
 
+// --tune-energy
+
+#define TUNE_ENERGY_MSEC            250 // per measurement, RAPL counters update about every millisecond
+#define TUNE_ENERGY_THREADS_STEPS   4   // 100%, 75%, 50% and 25% of the threads
+#define TUNE_ENERGY_ACCEL_DIV_MAX   4
+
 int find_tuning_function (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
 
 HC_API_CALL void *thread_autotune (void *p);
@@ -33,8 +33,11 @@ void backend_ctx_devices_sync_tuning        (hashcat_ctx_t *hashcat_ctx);
 void backend_ctx_devices_update_power       (hashcat_ctx_t *hashcat_ctx);
 void backend_ctx_devices_kernel_loops       (hashcat_ctx_t *hashcat_ctx);
 
+bool backend_session_build_needs_hashes     (hashcat_ctx_t *hashcat_ctx);
+int  backend_session_build                  (hashcat_ctx_t *hashcat_ctx);
 int  backend_session_begin                  (hashcat_ctx_t *hashcat_ctx);
 void backend_session_destroy                (hashcat_ctx_t *hashcat_ctx);
+void backend_session_programs_destroy       (hashcat_ctx_t *hashcat_ctx);
 void backend_session_reset                  (hashcat_ctx_t *hashcat_ctx);
 int  backend_session_update_combinator      (hashcat_ctx_t *hashcat_ctx);
 int  backend_session_update_mp              (hashcat_ctx_t *hashcat_ctx);
@@ -56,6 +59,8 @@ int gidd_to_pw_t                            (hashcat_ctx_t *hashcat_ctx, hc_devi
 int copy_pws_idx                            (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, u64 gidd, const u64 cnt, pw_idx_t *dest);
 int copy_pws_comp                           (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, u32 off, u32 cnt, u32 *dest);
 
+u64 salt_pack_gidvid                        (const hc_device_param_t *device_param, const u64 gidvid);
+
 int choose_kernel                           (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 highest_pw_len, const u64 pws_pos, const u64 pws_cnt, const u32 fast_iteration, const u32 salt_pos, const bool is_autotune);
 
 int run_cuda_kernel_atinit                  (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, CUdeviceptr buf, const u64 num);
@@ -84,6 +89,12 @@ int run_opencl_kernel_memset                (hashcat_ctx_t *hashcat_ctx, hc_devi
 int run_opencl_kernel_memset32              (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, cl_mem buf, const u64 offset, const u32 value, const u64 size);
 int run_opencl_kernel_bzero                 (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, cl_mem buf, const u64 size);
 
+int run_native_kernel_atinit                (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void *buf, const u64 num);
+int run_native_kernel_utf8toutf16le         (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void *buf, const u64 num);
+int run_native_kernel_memset                (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void *buf, const u64 offset, const u8  value, const u64 size);
+int run_native_kernel_memset32              (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void *buf, const u64 offset, const u32 value, const u64 size);
+int run_native_kernel_bzero                 (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void *buf, const u64 size);
+
 int run_kernel                              (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u64 pws_pos, const u64 num, const u32 event_update, const u32 iteration, const bool is_autotune);
 int run_kernel_mp                           (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u64 num);
 int run_kernel_tm                           (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
@@ -8,6 +8,8 @@
 
 #include <string.h>
 
+#define BITMAP_L1_PASS_MAX 0.5 // only use the first-level bitmap if it rejects at least half of the candidates
+
 int  bitmap_ctx_init    (hashcat_ctx_t *hashcat_ctx);
 void bitmap_ctx_destroy (hashcat_ctx_t *hashcat_ctx);
 
@@ -0,0 +1,43 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_BLOCKFILE_H
+#define HC_BLOCKFILE_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define BLOCKFILE_KIND_GZIP 1 // BGZF style gzip, one member per block with its size in the extra field
+#define BLOCKFILE_KIND_XZ   2 // multi-block xz, sizes from the xz index
+#define BLOCKFILE_KIND_ZSTD 3 // zstd frames with content size, otherwise decoded as a stream
+
+#define BLOCKFILE_THREADS_MAX    8
+#define BLOCKFILE_JOB_SIZE       (4 * 1024 * 1024)  // decoded bytes a worker produces at once
+#define BLOCKFILE_BLOCK_MAX      (64 * 1024 * 1024) // files with larger blocks are decoded as a stream
+#define BLOCKFILE_STREAM_SIZE    (256 * 1024)
+#define BLOCKFILE_INDEX_INCR     0x1000
+#define BLOCKFILE_INDEX_MAGIC    0x49424348 // HCBI
+#define BLOCKFILE_INDEX_VERSION  1
+#define BLOCKFILE_INDEX_STREAM   1          // index flag, file has no usable block layout
+#define BLOCKFILE_MARK_DISTANCE  (4 * 1024 * 1024) // minimum decoded distance between two word marks
+
+void         blockfile_init          (void);
+void         blockfile_set_cache_dir (const char *cache_dir);
+blockfile_t *blockfile_open          (const char *path, const int kind);
+void         blockfile_close         (blockfile_t *bfp);
+size_t       blockfile_read          (blockfile_t *bfp, void *ptr, const size_t len);
+int          blockfile_getc          (blockfile_t *bfp);
+bool         blockfile_eof           (const blockfile_t *bfp);
+int          blockfile_seek          (blockfile_t *bfp, const u64 offset);
+void         blockfile_rewind        (blockfile_t *bfp);
+u64          blockfile_tell          (const blockfile_t *bfp);
+u64          blockfile_size          (const blockfile_t *bfp);
+void         blockfile_mark          (blockfile_t *bfp, const u64 sig, const u64 words, const u64 offset);
+bool         blockfile_find_mark     (const blockfile_t *bfp, const u64 sig, const u64 words, u64 *mark_words, u64 *mark_offset);
+
+#endif // HC_BLOCKFILE_H
@@ -42,14 +42,16 @@
 
 static const int BRAIN_CLIENT_CONNECT_TIMEOUT     = 5;
 static const int BRAIN_SERVER_TIMER               = 5 * 60;
+static const int BRAIN_SERVER_LEASE               = 10 * 60;
 static const int BRAIN_SERVER_SESSIONS_MAX        = 64;
 static const int BRAIN_SERVER_ATTACKS_MAX         = 64 * 1024;
 static const int BRAIN_SERVER_CLIENTS_MAX         = 256;
 static const int BRAIN_SERVER_REALLOC_HASH_SIZE   = 1024 * 1024;
 static const int BRAIN_SERVER_REALLOC_ATTACK_SIZE = 1024;
 static const int BRAIN_HASH_SIZE                  = 2 * sizeof (u32);
-static const int BRAIN_LINK_VERSION_CUR           = 1;
+static const int BRAIN_LINK_VERSION_CUR           = 2;
 static const int BRAIN_LINK_VERSION_MIN           = 1;
+static const int BRAIN_LINK_VERSION_CLAIM         = 2; // first version which knows BRAIN_OPERATION_ATTACK_CLAIM
 static const int BRAIN_LINK_CHUNK_SIZE            = 4 * 1024;
 static const int BRAIN_LINK_CANDIDATES_MAX        = 128 * 1024 * 256; // units * threads * accel
 
@@ -58,6 +60,7 @@ typedef enum brain_operation
   BRAIN_OPERATION_COMMIT         = 1,
   BRAIN_OPERATION_HASH_LOOKUP    = 2,
   BRAIN_OPERATION_ATTACK_RESERVE = 3,
+  BRAIN_OPERATION_ATTACK_CLAIM   = 4,
 
 } brain_operation_t;
 
@@ -65,6 +68,7 @@ typedef enum brain_client_feature
 {
   BRAIN_CLIENT_FEATURE_HASHES    = 1,
   BRAIN_CLIENT_FEATURE_ATTACKS   = 2,
+  BRAIN_CLIENT_FEATURE_CLAIMS    = 4,
 
 } brain_client_feature_t;
 
@@ -145,6 +149,18 @@ typedef struct brain_server_db_hash
 
 } brain_server_db_hash_t;
 
+// written by the client thread and read by the other clients of the same attack, both under mux_ag of the attack
+
+typedef struct brain_server_client_state
+{
+  u32 brain_attack;
+
+  u64 speed; // candidates per second, as reported by the client with each claim
+
+  time_t seen;
+
+} brain_server_client_state_t;
+
 typedef struct brain_server_db_short
 {
   brain_server_hash_short_t *short_buf;
@@ -167,6 +183,8 @@ typedef struct brain_server_dbs
 
   int *client_slots;
 
+  brain_server_client_state_t *client_state;
+
 } brain_server_dbs_t;
 
 typedef struct brain_server_dumper_options
@@ -189,6 +207,8 @@ typedef struct brain_server_client_options
   u32 *session_whitelist_buf;
   int  session_whitelist_cnt;
 
+  u32 lease_timeout;
+
 } brain_server_client_options_t;
 
 int   brain_logging                     (FILE *stream, const int client_idx, const char *format, ...);
@@ -207,13 +227,14 @@ bool  brain_recv_all                    (int sockfd, void *buf, size_t len, int
 bool  brain_send_all                    (int sockfd, void *buf, size_t len, int flags, hc_device_param_t *device_param, const status_ctx_t *status_ctx);
 
 bool  brain_client_reserve              (hc_device_param_t *device_param, const status_ctx_t *status_ctx, u64 words_off, u64 work, u64 *overlap);
+bool  brain_client_claim                (hc_device_param_t *device_param, const status_ctx_t *status_ctx, u64 words_base, u64 work, u64 *claim_off, u64 *claim_len);
 bool  brain_client_commit               (hc_device_param_t *device_param, const status_ctx_t *status_ctx);
 bool  brain_client_lookup               (hc_device_param_t *device_param, const status_ctx_t *status_ctx);
 bool  brain_client_connect              (hc_device_param_t *device_param, const status_ctx_t *status_ctx, const char *host, const int port, const char *password, u32 brain_session, u32 brain_attack, i64 passwords_max, u64 *highest);
 void  brain_client_disconnect           (hc_device_param_t *device_param);
 void  brain_client_generate_hash        (u64 *hash, const char *line_buf, const size_t line_len);
 
-int   brain_server                      (const char *listen_host, const int listen_port, const char *brain_password, const char *brain_session_whitelist, const u32 brain_server_timer);
+int   brain_server                      (const char *listen_host, const int listen_port, const char *brain_password, const char *brain_session_whitelist, const u32 brain_server_timer, const u32 brain_server_lease);
 bool  brain_server_read_hash_dumps      (brain_server_dbs_t *brain_server_dbs, const char *path);
 bool  brain_server_write_hash_dumps     (brain_server_dbs_t *brain_server_dbs, const char *path);
 bool  brain_server_read_hash_dump       (brain_server_db_hash_t *brain_server_db_hash, const char *file);
@@ -229,6 +250,9 @@ u64   brain_server_highest_attack_long  (const brain_server_attack_long_t  *buf,
 u64   brain_server_highest_attack_short (const brain_server_attack_short_t *buf, const i64 cnt, const u64 start);
 u64   brain_server_find_attack_long     (const brain_server_attack_long_t  *buf, const i64 cnt, const u64 offset, const u64 length);
 u64   brain_server_find_attack_short    (const brain_server_attack_short_t *buf, const i64 cnt, const u64 offset, const u64 length);
+u64   brain_server_find_attack_gap      (const brain_server_db_attack_t *buf, const u64 limit, u64 *gap_len);
+u64   brain_server_find_attack_pending  (const brain_server_db_attack_t *buf, const int client_idx, const u64 limit);
+i64   brain_server_reclaim_attack       (brain_server_db_attack_t *buf, const brain_server_client_state_t *client_state, const int client_idx, const u32 lease_timeout);
 i64   brain_server_find_hash_long       (const u32 *search, const brain_server_hash_long_t  *buf, const i64 cnt);
 i64   brain_server_find_hash_short      (const u32 *search, const brain_server_hash_short_t *buf, const i64 cnt);
 int   brain_server_sort_db_hash         (const void *v1, const void *v2);
@@ -9,7 +9,14 @@
 #include <stdio.h>
 #include <errno.h>
 
-int  combinator_ctx_init    (hashcat_ctx_t *hashcat_ctx);
-void combinator_ctx_destroy (hashcat_ctx_t *hashcat_ctx);
+#define COMBS_CACHE_SIZE_MAX  (256 * 1024 * 1024)
+#define COMBS_CACHE_BUF_INC   (1024 * 1024)
+#define COMBS_CACHE_CNT_INC   (64 * 1024)
+
+int  combinator_ctx_init        (hashcat_ctx_t *hashcat_ctx);
+void combinator_ctx_destroy     (hashcat_ctx_t *hashcat_ctx);
+int  combinator_ctx_update_loop (hashcat_ctx_t *hashcat_ctx);
+
+void combinator_cache_to_pw     (const combinator_ctx_t *combinator_ctx, const u64 idx, pw_t *pw);
 
 #endif // HC_COMBINATOR_H
@@ -0,0 +1,29 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_DAEMON_H
+#define HC_DAEMON_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+
+#if !defined (_WIN)
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+#define DAEMON_REQUEST_SIZE 0x10000
+#define DAEMON_ARGV_MAX     256
+#define DAEMON_POLL_MSEC    100
+
+int daemon_run (hashcat_ctx_t *hashcat_ctx, int argc, char **argv);
+
+#endif // HC_DAEMON_H
@@ -0,0 +1,31 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_DEDUP_H
+#define HC_DEDUP_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#define DEDUP_VERSION       (0x6863646564757000 | 0x01)
+#define DEDUP_BUCKET_SLOTS  4
+#define DEDUP_KICKS_MAX     500
+#define DEDUP_MEMORY_SHARE  16                   // at most 1/16 of the free host memory
+#define DEDUP_MEMORY_MIN    (1024 * 1024)
+#define DEDUP_MEMORY_MAX    (1024 * 1024 * 1024)
+
+int  dedup_init           (hashcat_ctx_t *hashcat_ctx);
+void dedup_destroy        (hashcat_ctx_t *hashcat_ctx);
+int  dedup_write          (hashcat_ctx_t *hashcat_ctx);
+
+int  dedup_device_init    (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+void dedup_device_destroy (hc_device_param_t *device_param);
+
+bool dedup_lookup         (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u8 *pw_buf, const u32 pw_len);
+void dedup_commit         (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+void dedup_discard        (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+
+#endif // HC_DEDUP_H
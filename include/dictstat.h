@@ -18,6 +18,7 @@
 #define MAX_DICTSTAT 100000
 
 #define DICTSTAT_FILENAME "hashcat.dictstat2"
+#define DICTSTAT_INDEXDIR "hashcat.dictidx"
 #define DICTSTAT_VERSION  (0x6863646963743200 | 0x03)
 
 int sort_by_dictstat (const void *s1, const void *s2);
@@ -49,6 +49,7 @@ typedef enum openclBufferMemoryFlagsId
   opencl_d_rules_c_memoryFlags,
   opencl_d_combs_memoryFlags,
   opencl_d_combs_c_memoryFlags,
+  opencl_d_combs_cache_memoryFlags,
   opencl_d_bfs_memoryFlags,
   opencl_d_bfs_c_memoryFlags,
   opencl_d_tm_c_memoryFlags,
@@ -92,6 +93,7 @@ static const cl_mem_flags openclMemoryFlags[OCL_BUFFER_CNT] =
   [opencl_d_rules_c_memoryFlags] = CL_MEM_READ_ONLY,
   [opencl_d_combs_memoryFlags] = CL_MEM_READ_ONLY,
   [opencl_d_combs_c_memoryFlags] = CL_MEM_READ_ONLY,
+  [opencl_d_combs_cache_memoryFlags] = CL_MEM_READ_ONLY,
   [opencl_d_bfs_memoryFlags] = CL_MEM_READ_ONLY,
   [opencl_d_bfs_c_memoryFlags] = CL_MEM_READ_ONLY,
   [opencl_d_tm_c_memoryFlags] = CL_MEM_READ_ONLY,
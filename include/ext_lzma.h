@@ -8,12 +8,15 @@
 
 #include <LzmaDec.h>
 #include <Lzma2Dec.h>
+#include <Lzma2Enc.h>
 
 #include "minizip/unzip.h"
 
 int hc_lzma1_decompress (const unsigned char *in, SizeT *in_len, unsigned char *out, SizeT *out_len, const char *props);
 int hc_lzma2_decompress (const unsigned char *in, SizeT *in_len, unsigned char *out, SizeT *out_len, const char *props);
 
+int hc_lzma2_compress (const unsigned char *in, const SizeT in_len, unsigned char *out, SizeT *out_len, char *props, const int threads);
+
 void *hc_lzma_alloc (MAYBE_UNUSED ISzAllocPtr p, size_t size);
 void  hc_lzma_free  (MAYBE_UNUSED ISzAllocPtr p, void *address);
 
@@ -47,6 +47,7 @@ typedef enum metalBufferStorageModeId
   metal_d_rules_c_storageMode,
   metal_d_combs_storageMode,
   metal_d_combs_c_storageMode,
+  metal_d_combs_cache_storageMode,
   metal_d_bfs_storageMode,
   metal_d_bfs_c_storageMode,
   metal_d_tm_c_storageMode,
@@ -94,6 +95,7 @@ static const metalResourceStorageMode_t metalResourceStorageModes[MTL_BUFFER_CNT
   [metal_d_rules_c_storageMode] = MTL_STORAGE_MODE_SHARED,
   [metal_d_combs_storageMode] = MTL_STORAGE_MODE_SHARED,
   [metal_d_combs_c_storageMode] = MTL_STORAGE_MODE_SHARED,
+  [metal_d_combs_cache_storageMode] = MTL_STORAGE_MODE_SHARED,
   [metal_d_bfs_storageMode] = MTL_STORAGE_MODE_SHARED,
   [metal_d_bfs_c_storageMode] = MTL_STORAGE_MODE_SHARED,
   [metal_d_tm_c_storageMode] = MTL_STORAGE_MODE_SHARED,
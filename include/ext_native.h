@@ -0,0 +1,102 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_EXT_NATIVE_H
+#define HC_EXT_NATIVE_H
+
+// the native backend runs the kernels on the host, so "device" memory is plain host memory
+// and a kernel is a function in a shared object built from the kernel source with the host C compiler
+
+#define NATIVE_ARGS_MAX     32      // must match OpenCL/inc_native.h
+#define NATIVE_CHUNKS       8       // work-item chunks per pool thread and launch, for load balancing
+#define NATIVE_MEM_ALIGN    64
+#define NATIVE_LOG_SIZE     (64 * 1024)
+#define NATIVE_PREFIX_MAX   8       // max words in $CC
+
+typedef void (*NATIVE_LAUNCH) (void *, const u64 *, const u64, const u64);
+
+typedef struct native_module
+{
+  hc_dynlib_t   lib;
+
+  NATIVE_LAUNCH launch;
+
+} native_module_t;
+
+typedef struct native_function
+{
+  NATIVE_LAUNCH launch;
+
+  void         *kernel;
+
+} native_function_t;
+
+typedef struct native_worker
+{
+  struct native_pool    *pool;
+
+  hc_thread_t            thread;
+  hc_thread_semaphore_t  sem_work;
+
+  const struct numa_topology *numa_topology;
+  int                    numa_node;   // -1 if the worker is not placed
+
+} native_worker_t;
+
+typedef struct native_pool
+{
+  native_worker_t          *workers;
+  int                       workers_cnt;
+  int                       workers_active;  // --tune-energy can leave some cpus idle, 0 means all
+
+  hc_thread_semaphore_t     sem_done;
+  hc_thread_mutex_t         mux;
+
+  // the launch in flight
+
+  const native_function_t  *function;
+  const u64                *args;
+
+  u64                       gid_pos;
+  u64                       gid_max;
+  u64                       gid_chunk;
+
+  bool                      shutdown;
+
+} native_pool_t;
+
+typedef struct hc_native_lib
+{
+  char *compiler[NATIVE_PREFIX_MAX]; // $CC split into words, or "cc"
+  int   compiler_cnt;
+
+  char *version;                     // first line of "cc --version"
+
+} hc_native_lib_t;
+
+typedef hc_native_lib_t NATIVE_PTR;
+
+int  native_init                (void *hashcat_ctx);
+void native_close               (void *hashcat_ctx);
+
+int  hc_nativeCompile           (void *hashcat_ctx, const char *source_file, const char *include_file, const char *build_options, const char *output_file, char **build_log);
+int  hc_nativeModuleLoad        (void *hashcat_ctx, native_module_t *module, const char *filename);
+int  hc_nativeModuleUnload      (void *hashcat_ctx, native_module_t *module);
+int  hc_nativeModuleGetFunction (void *hashcat_ctx, native_function_t *function, const native_module_t *module, const char *name);
+
+int  hc_nativeMemAlloc          (void *hashcat_ctx, void **dptr, const size_t bytesize);
+int  hc_nativeMemFreePtr        (void *hashcat_ctx, void **dptr);
+int  hc_nativeMemcpyDtoD        (void *hashcat_ctx, void *dst, const void *src, const size_t bytes);
+int  hc_nativeMemcpyDtoH        (void *hashcat_ctx, void *dst, const void *src, const size_t bytes);
+int  hc_nativeMemcpyHtoD        (void *hashcat_ctx, void *dst, const void *src, const size_t bytes);
+int  hc_nativeMemsetD8          (void *hashcat_ctx, void *dst, const u8  value, const size_t N);
+int  hc_nativeMemsetD32         (void *hashcat_ctx, void *dst, const u32 value, const size_t N);
+
+int  hc_nativePoolCreate        (void *hashcat_ctx, native_pool_t **pool, const int threads_cnt);
+void hc_nativePoolDestroy       (void *hashcat_ctx, native_pool_t **pool);
+int  hc_nativeSetKernelArg      (void *hashcat_ctx, u64 *args, const u32 arg_index, const size_t arg_size, const void *arg_value);
+int  hc_nativeLaunchKernel      (void *hashcat_ctx, native_pool_t *pool, const native_function_t *function, const u64 *args, const u64 gid_max);
+
+#endif // HC_EXT_NATIVE_H
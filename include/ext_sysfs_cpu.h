@@ -8,7 +8,9 @@
 
 #include <stdbool.h>
 
-static const char SYSFS_HWMON[] = "/sys/class/hwmon";
+static const char SYSFS_ROOT[]     = "/sys";
+static const char SYSFS_HWMON[]    = "class/hwmon";
+static const char SYSFS_POWERCAP[] = "class/powercap";
 
 static const char SENSOR_CORETEMP[] = "coretemp";
 static const char SENSOR_K10TEMP[]  = "k10temp";
@@ -17,16 +19,44 @@ static const char SENSOR_ACPITZ[]   = "acpitz";
 
 static const char PROC_STAT[] = "/proc/stat";
 
+// only the package zones, the psys zone (if any) already contains them
+
+static const char RAPL_ZONE_PACKAGE[] = "package";
+
+#define SYSFS_CPU_RAPL_ZONES_MAX 16
+
 typedef int HM_ADAPTER_SYSFS_CPU;
 
 typedef void *SYSFS_CPU_LIB;
 
+typedef struct hm_sysfs_cpu_rapl_zone
+{
+  char *energy_path;
+
+  u64   max_energy_range_uj;  // the counter wraps around at this value
+  u64   energy_uj_prev;
+
+} hm_sysfs_cpu_rapl_zone_t;
+
 typedef struct hm_sysfs_cpu_lib
 {
   // currently not using libudev, because it can only read values, not set them, so using /sys instead
 
   SYSFS_CPU_LIB lib;
 
+  char *sysfs_root;
+
+  // powercap/RAPL energy counters of all packages
+
+  hm_sysfs_cpu_rapl_zone_t rapl_zones[SYSFS_CPU_RAPL_ZONES_MAX];
+  int                      rapl_zones_cnt;
+
+  u64        energy_uj;             // since sysfs_cpu_init (), wrap-arounds included
+
+  u64        power_energy_uj_prev;  // power is averaged between two reads
+  int64_t    power_mw;
+  hc_timer_t power_timer;
+
 } hm_sysfs_cpu_lib_t;
 
 typedef struct
@@ -48,10 +78,13 @@ typedef hm_sysfs_cpu_lib_t SYSFS_CPU_PTR;
 
 bool sysfs_cpu_init (void *hashcat_ctx);
 void sysfs_cpu_close (void *hashcat_ctx);
-char *hm_SYSFS_CPU_get_syspath_hwmon (void);
+char *hm_SYSFS_CPU_get_syspath_hwmon (void *hashcat_ctx);
 int hm_SYSFS_CPU_get_temperature_current (void *hashcat_ctx, int *val);
 
 bool read_proc_stat (void *hashcat_ctx, proc_stat_t *proc_stat);
 int hm_SYSFS_CPU_get_utilization_current (void *hashcat_ctx, int *val);
 
+int hm_SYSFS_CPU_get_energy_current (void *hashcat_ctx, u64 *val);
+int hm_SYSFS_CPU_get_power_current (void *hashcat_ctx, int64_t *val);
+
 #endif // HC_EXT_SYSFS_CPU_H
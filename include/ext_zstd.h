@@ -0,0 +1,59 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_EXT_ZSTD_H
+#define HC_EXT_ZSTD_H
+
+/**
+ * from zstd.h (stable API only, libzstd >= 1.3.0), the library is loaded at runtime
+ */
+
+typedef struct ZSTD_DCtx_s ZSTD_DCtx;
+
+typedef ZSTD_DCtx ZSTD_DStream;
+
+typedef struct ZSTD_inBuffer_s
+{
+  const void *src;
+  size_t      size;
+  size_t      pos;
+
+} ZSTD_inBuffer;
+
+typedef struct ZSTD_outBuffer_s
+{
+  void       *dst;
+  size_t      size;
+  size_t      pos;
+
+} ZSTD_outBuffer;
+
+#define ZSTD_MAGICNUMBER           0xFD2FB528
+#define ZSTD_MAGIC_SKIPPABLE_START 0x184D2A50
+#define ZSTD_MAGIC_SKIPPABLE_MASK  0xFFFFFFF0
+
+typedef ZSTD_DCtx  *(*ZSTD_CREATEDCTX)        (void);
+typedef size_t      (*ZSTD_FREEDCTX)          (ZSTD_DCtx *);
+typedef size_t      (*ZSTD_DECOMPRESSDCTX)    (ZSTD_DCtx *, void *, size_t, const void *, size_t);
+typedef size_t      (*ZSTD_INITDSTREAM)       (ZSTD_DStream *);
+typedef size_t      (*ZSTD_DECOMPRESSSTREAM)  (ZSTD_DStream *, ZSTD_outBuffer *, ZSTD_inBuffer *);
+typedef unsigned    (*ZSTD_ISERROR)           (size_t);
+
+typedef struct hc_zstd_lib
+{
+  hc_dynlib_t lib;
+
+  ZSTD_CREATEDCTX        ZSTD_createDCtx;
+  ZSTD_FREEDCTX          ZSTD_freeDCtx;
+  ZSTD_DECOMPRESSDCTX    ZSTD_decompressDCtx;
+  ZSTD_INITDSTREAM       ZSTD_initDStream;
+  ZSTD_DECOMPRESSSTREAM  ZSTD_decompressStream;
+  ZSTD_ISERROR           ZSTD_isError;
+
+} hc_zstd_lib_t;
+
+typedef hc_zstd_lib_t ZSTD_PTR;
+
+#endif // HC_EXT_ZSTD_H
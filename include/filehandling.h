@@ -33,6 +33,8 @@ int    hc_fputc     (int c, HCFILE *fp);
 char  *hc_fgets     (char *buf, int len, HCFILE *fp);
 size_t hc_fwrite    (const void *ptr, size_t size, size_t nmemb, HCFILE *fp);
 size_t hc_fread     (void *ptr, size_t size, size_t nmemb, HCFILE *fp);
+void   hc_fmark     (HCFILE *fp, const u64 sig, const u64 words);
+bool   hc_fseek_mark (HCFILE *fp, const u64 sig, const u64 words_cur, const u64 words_off, u64 *mark_words);
 
 size_t fgetl        (HCFILE *fp, char *line_buf, const size_t line_sz);
 u64    count_lines  (HCFILE *fp);
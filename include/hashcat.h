@@ -19,6 +19,9 @@ int   hashcat_session_finish     (hashcat_ctx_t *hashcat_ctx);
 int   hashcat_session_quit       (hashcat_ctx_t *hashcat_ctx);
 int   hashcat_session_destroy    (hashcat_ctx_t *hashcat_ctx);
 
+int   hashcat_session_job_init    (hashcat_ctx_t *hashcat_ctx, int argc, char **argv);
+int   hashcat_session_job_destroy (hashcat_ctx_t *hashcat_ctx);
+
 char *hashcat_get_log            (hashcat_ctx_t *hashcat_ctx);
 int   hashcat_get_status         (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_status);
 
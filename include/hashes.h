@@ -6,6 +6,8 @@
 #ifndef HC_HASHES_H
 #define HC_HASHES_H
 
+#define INCR_CRACKED 0x10000
+
 int sort_by_digest_p0p1  (const void *v1, const void *v2, void *v3);
 int sort_by_salt         (const void *v1, const void *v2);
 int sort_by_hash         (const void *v1, const void *v2, void *v3);
@@ -15,11 +17,16 @@ int hash_encode (const hashconfig_t *hashconfig, const hashes_t *hashes, const m
 
 int save_hash (hashcat_ctx_t *hashcat_ctx);
 
-int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain);
+int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain, cracked_batch_t *cracked_batch);
 
 //int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 salt_pos);
 int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
 
+void cracked_queue_init    (hashcat_ctx_t *hashcat_ctx);
+void cracked_queue_destroy (hashcat_ctx_t *hashcat_ctx);
+
+HC_API_CALL void *thread_cracked (void *p);
+
 int hashes_init_filename  (hashcat_ctx_t *hashcat_ctx);
 int hashes_init_stage1    (hashcat_ctx_t *hashcat_ctx);
 int hashes_init_stage2    (hashcat_ctx_t *hashcat_ctx);
@@ -0,0 +1,23 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_IDENTIFY_H
+#define HC_IDENTIFY_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#define IDENTIFY_CHUNK_SIZE  (HCBUFSIZ_LARGE * 2)
+#define IDENTIFY_CHUNK_LINES 0x40000
+#define IDENTIFY_MATCH_INCR  0x10000
+#define IDENTIFY_HLFMTS_MAX  8
+#define IDENTIFY_NONE        0xffffffff
+
+#define IDENTIFY_SPLIT_UNIDENTIFIED "unidentified.hash"
+
+int identify_all (hashcat_ctx_t *hashcat_ctx);
+
+#endif // HC_IDENTIFY_H
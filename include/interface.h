@@ -22,9 +22,13 @@ static const int MODULE_HASH_MODES_MAXIMUM = 100000;
  */
 
 int  module_filename (const folder_config_t *folder_config, const int hash_mode, char *out_buf, const size_t out_size);
+bool module_exists   (const folder_config_t *folder_config, const int hash_mode);
 bool module_load     (hashcat_ctx_t *hashcat_ctx, module_ctx_t *module_ctx, const u32 hash_mode);
 void module_unload   (module_ctx_t *module_ctx);
 
+void                   module_static_register (const module_static_t *modules_buf, const int modules_cnt, const u64 modules_stamp);
+const module_static_t *module_static_list     (int *modules_cnt, u64 *modules_stamp);
+
 int         hashconfig_init                 (hashcat_ctx_t *hashcat_ctx);
 void        hashconfig_destroy              (hashcat_ctx_t *hashcat_ctx);
 
@@ -13,11 +13,18 @@
 
 static const char LOOPBACK_FILE[] = "hashcat.loopback";
 
+#define LOOPBACK_QUEUE_INCR  0x1000
+#define LOOPBACK_QUEUE_MAX   0x100000 // pending plains, later ones go to the loopback file directly
+#define LOOPBACK_QUEUE_SHARE 8        // at most 1/8 of a batch is taken from the queue
+#define LOOPBACK_SEEN_SIZE   0x10000  // initial size of the plain hash set, power of two
+
 int  loopback_init          (hashcat_ctx_t *hashcat_ctx);
 void loopback_destroy       (hashcat_ctx_t *hashcat_ctx);
 int  loopback_write_open    (hashcat_ctx_t *hashcat_ctx);
 void loopback_write_close   (hashcat_ctx_t *hashcat_ctx);
 void loopback_write_append  (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, const unsigned int plain_len);
 void loopback_write_unlink  (hashcat_ctx_t *hashcat_ctx);
+u64  loopback_queue_reserve (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param);
+u64  loopback_queue_fill    (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
 
 #endif // HC_LOOPBACK_H
@@ -0,0 +1,33 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_MANIFEST_H
+#define HC_MANIFEST_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#define MODULE_MANIFEST_MAGIC     0x6d6d6368 // hcmm
+#define MODULE_MANIFEST_VERSION   1
+#define MODULE_MANIFEST_INCR      256
+#define MODULE_MANIFEST_SIG_LINES 10000
+#define MODULE_MANIFEST_SIG_LENS  256
+
+#define MODULE_MANIFEST_SIG_NONE  0 // no usable signature, module is always verified
+#define MODULE_MANIFEST_SIG_CHAR  1 // hash starts with sig_char, for instance '$' or '{'
+#define MODULE_MANIFEST_SIG_HEX   2 // hash is a hex string of sig_len characters
+
+int sort_by_manifest_entry (const void *p1, const void *p2);
+
+module_manifest_entry_t *module_manifest_read   (hashcat_ctx_t *hashcat_ctx, int *entries_cnt);
+int                      module_manifest_filter (hashcat_ctx_t *hashcat_ctx, const module_manifest_entry_t *entries_buf, const int entries_cnt, u32 *modes_buf);
+bool                     module_manifest_match  (const module_manifest_entry_t *manifest_entry, const char *hash_buf, const int hash_len);
+
+#endif // HC_MANIFEST_H
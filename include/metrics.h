@@ -0,0 +1,41 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_METRICS_H
+#define HC_METRICS_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#if !defined (_WIN)
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
+
+#if defined (__linux__)
+#define METRICS_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define METRICS_SEND_FLAGS 0
+#endif
+
+#define METRICS_REQUEST_SIZE 0x1000
+#define METRICS_PAGE_SIZE    0x4000
+#define METRICS_POLL_MSEC    100
+#define METRICS_RECV_MSEC    1000
+
+#define METRICS_CONTENT_TYPE "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+int  metrics_init    (hashcat_ctx_t *hashcat_ctx);
+void metrics_destroy (hashcat_ctx_t *hashcat_ctx);
+void metrics_update  (hashcat_ctx_t *hashcat_ctx);
+
+#endif // HC_METRICS_H
@@ -20,8 +20,19 @@
 #define SP_MARKOV_CNT (SP_PW_MAX * CHARSIZ * CHARSIZ)
 #define SP_FILESZ     (sizeof (u64) + sizeof (u64) + (sizeof (u64) * SP_ROOT_CNT) + (sizeof (u64) * SP_MARKOV_CNT))
 
+#define SP_CACHE_FOLDER  "hcstat2"
+#define SP_CACHE_VERSION (0x6863746263000000 | 0x0001)
+#define SP_CACHE_FILESZ  (sizeof (sp_cache_header_t) + SP_ROOT_CNT + SP_MARKOV_CNT)
+
+#define SP_GEN_BLOCK_SZ  (32 * 1024 * 1024)
+#define SP_GEN_LOCAL_POS 32
+
 #define INCR_MASKS    1000
 
+#define MASK_FUSE_TOKENS    (CHARSIZ + 8) // literal bytes followed by ?l ?u ?d ?s ?a ?b ?h ?H
+#define MASK_FUSE_SET_WORDS ((MASK_FUSE_TOKENS + 31) / 32)
+#define MASK_FUSE_CS_MAX    8
+
 u32   mp_get_length (const char *mask, const u32 opts_type);
 
 void  sp_exec (u64 ctx, char *pw_buf, cs_t *root_css_buf, cs_t *markov_css_buf, u32 start, u32 stop);
@@ -31,4 +42,8 @@ int   mask_ctx_init           (hashcat_ctx_t *hashcat_ctx);
 void  mask_ctx_destroy        (hashcat_ctx_t *hashcat_ctx);
 int   mask_ctx_parse_maskfile (hashcat_ctx_t *hashcat_ctx);
 
+int   sp_hcstat2_create       (hashcat_ctx_t *hashcat_ctx);
+
+HC_API_CALL void *sp_gen_thread (void *p);
+
 #endif // HC_MPSP_H
@@ -13,16 +13,26 @@
 
 #define INCR_POT 1000
 
+#define POTFILE_SHARD_DIR    "hashcat.potfile.d"
+#define POTFILE_SHARD_SUFFIX ".potfile"
+
+#define POTFILE_COMPACT_RUN_SIZE  (256 * 1024 * 1024) // lines sorted in memory at once by --potfile-compact
+#define POTFILE_COMPACT_MERGE_WAY 64                  // runs merged at once, each holds a file open
+
 int  potfile_init             (hashcat_ctx_t *hashcat_ctx);
 int  potfile_read_open        (hashcat_ctx_t *hashcat_ctx);
 void potfile_read_close       (hashcat_ctx_t *hashcat_ctx);
 int  potfile_write_open       (hashcat_ctx_t *hashcat_ctx);
 void potfile_write_close      (hashcat_ctx_t *hashcat_ctx);
 void potfile_write_append     (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len);
+void potfile_write_line       (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len);
+void potfile_write_lock       (hashcat_ctx_t *hashcat_ctx);
+void potfile_write_unlock     (hashcat_ctx_t *hashcat_ctx);
 int  potfile_remove_parse     (hashcat_ctx_t *hashcat_ctx);
 void potfile_destroy          (hashcat_ctx_t *hashcat_ctx);
 int  potfile_handle_show      (hashcat_ctx_t *hashcat_ctx);
 int  potfile_handle_left      (hashcat_ctx_t *hashcat_ctx);
+int  potfile_compact          (hashcat_ctx_t *hashcat_ctx);
 
 void potfile_update_hash      (hashcat_ctx_t *hashcat_ctx, hash_t *found,  char *line_pw_buf, int line_pw_len);
 void potfile_update_hashes    (hashcat_ctx_t *hashcat_ctx, hash_t *hash_buf, char *line_pw_buf, int line_pw_len, pot_tree_entry_t *tree);
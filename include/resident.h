@@ -0,0 +1,22 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_RESIDENT_H
+#define HC_RESIDENT_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+int  resident_ctx_init     (hashcat_ctx_t *hashcat_ctx);
+void resident_ctx_destroy  (hashcat_ctx_t *hashcat_ctx);
+
+bool resident_hashes_load  (hashcat_ctx_t *hashcat_ctx);
+void resident_hashes_store (hashcat_ctx_t *hashcat_ctx);
+
+bool resident_tune_load    (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, u32 *kernel_accel, u32 *kernel_loops, u32 *kernel_threads);
+void resident_tune_store   (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param);
+
+#endif // HC_RESIDENT_H
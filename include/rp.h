@@ -16,6 +16,9 @@
 #define RULES_MAX 32
 #define MAX_KERNEL_RULES (RULES_MAX - 1)
 
+#define RP_PROBE_LEN_MAX 48
+#define RP_PROBE_LEN_ROT 40
+
 typedef struct
 {
   char *grp_op_nop_selection;
@@ -43,6 +46,14 @@ typedef struct
 
 } rp_gen_ops_t;
 
+typedef struct
+{
+  u32  fp[4];
+  u32  pos;
+  bool accepted; // at least one probe word was not rejected
+
+} kernel_rule_fp_t;
+
 bool class_num       (const u8 c);
 bool class_lower     (const u8 c);
 bool class_upper     (const u8 c);
@@ -54,6 +65,9 @@ bool class_alpha     (const u8 c);
 int conv_ctoi (const u8 c);
 int conv_itoc (const u8 c);
 
+void rp_gen_ops_init       (rp_gen_ops_t *rp_gen_ops, const char *rp_gen_func_selection);
+void rp_gen_ops_destroy    (rp_gen_ops_t *rp_gen_ops);
+
 int generate_random_rule (char rule_buf[RP_RULE_SIZE], const u32 rp_gen_func_min, const u32 rp_gen_func_max, const rp_gen_ops_t *rp_gen_ops);
 
 bool is_hex_notation (const char *rule_buf, u32 rule_len, u32 rule_pos);
@@ -63,7 +77,9 @@ int kernel_rule_to_cpu_rule (char *rule_buf, kernel_rule_t *rule);
 
 bool kernel_rules_has_noop (const kernel_rule_t *kernel_rules_buf, const u32 kernel_rules_cnt);
 
-int kernel_rules_load     (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt);
-int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt, const char *rp_gen_func_selection);
+int kernel_rules_load         (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt);
+int kernel_rules_generate     (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt, const char *rp_gen_func_selection);
+int kernel_rules_optimize     (hashcat_ctx_t *hashcat_ctx, kernel_rule_t *kernel_rules_buf, u32 *kernel_rules_cnt);
+int kernel_rules_optimize_out (hashcat_ctx_t *hashcat_ctx);
 
 #endif // HC_RP_H
@@ -14,5 +14,6 @@
 int _old_apply_rule (const char *rule, int rule_len, char in[RP_PASSWORD_SIZE], int in_len, char out[RP_PASSWORD_SIZE]);
 
 int run_rule_engine (const int rule_len, const char *rule_buf);
+bool run_rule_engine_rejects (const int rule_len, const char *rule_buf);
 
 #endif // HC_RP_CPU_H
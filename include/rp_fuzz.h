@@ -0,0 +1,52 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_RP_FUZZ_H
+#define HC_RP_FUZZ_H
+
+#include <string.h>
+
+#define RP_FUZZ_WORDS          1024
+#define RP_FUZZ_WORD_LEN_MAX   24
+#define RP_FUZZ_PURE_LEN_MAX   (RP_PASSWORD_SIZE - 1)
+#define RP_FUZZ_OPTI_LEN_MAX   31 // buf0 and buf1 of apply_rules_optimized()
+#define RP_FUZZ_REPORT_MAX     20
+
+typedef struct rp_fuzz_rule
+{
+  kernel_rule_t kernel_rule;
+
+  char rule_buf[RP_RULE_SIZE];
+  int  rule_len;
+
+} rp_fuzz_rule_t;
+
+typedef struct rp_fuzz_word
+{
+  char buf[RP_PASSWORD_SIZE];
+  int  len;
+
+} rp_fuzz_word_t;
+
+typedef void (*RP_FUZZ_APPLY) (const rp_fuzz_rule_t *, const rp_fuzz_word_t *, const int, rp_fuzz_word_t *);
+
+typedef struct rp_fuzz_engine
+{
+  const char   *name;
+  RP_FUZZ_APPLY apply;
+
+  // longest word the engine can hold, before, after and in between the rule functions
+
+  int len_max;
+
+  u64 mismatches;
+  u64 compared;
+  u64 skipped;
+
+} rp_fuzz_engine_t;
+
+int rules_fuzz (hashcat_ctx_t *hashcat_ctx);
+
+#endif // HC_RP_FUZZ_H
@@ -0,0 +1,45 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_RP_SIMD_H
+#define HC_RP_SIMD_H
+
+#include <string.h>
+
+// words per batch, one byte lane of a 256 bit vector each, or two passes with 128 bit vectors
+
+#define RP_SIMD_LANES 32
+
+typedef struct rp_simd
+{
+  // the rule, compiled once with cpu_rule_to_kernel_rule ()
+  // if it uses a function the SoA engine does not implement, the batch runs through _old_apply_rule ()
+
+  const char   *rule_buf;
+  int           rule_len;
+
+  kernel_rule_t kernel_rule;
+  bool          vectorized;
+
+  // the words of the current batch, out_len is RULE_RC_REJECT_ERROR for a word which is too long for the rule engine
+  // unlike _old_apply_rule (), the bytes of out_buf after out_len are not cleared
+
+  int  cnt;
+  int  pos;
+
+  int  in_len[RP_SIMD_LANES];
+  char in_buf[RP_SIMD_LANES][RP_PASSWORD_SIZE];
+
+  int  out_len[RP_SIMD_LANES];
+  char out_buf[RP_SIMD_LANES][RP_PASSWORD_SIZE];
+
+} rp_simd_t;
+
+void rp_simd_init  (rp_simd_t *rp_simd, const char *rule_buf, const int rule_len);
+void rp_simd_reset (rp_simd_t *rp_simd);
+void rp_simd_add   (rp_simd_t *rp_simd, const char *buf, const int len);
+void rp_simd_apply (rp_simd_t *rp_simd);
+
+#endif // HC_RP_SIMD_H
@@ -0,0 +1,355 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+// the SoA engine, rp_simd.c includes this file once for each vector size
+// RP_SIMD_RUN names the function, RP_SIMD_VEC_SIZE is the number of lanes per vector and RP_SIMD_TARGET its target attribute
+
+RP_SIMD_TARGET static void RP_SIMD_RUN (rp_simd_t *rp_simd)
+{
+  typedef u8   rp_simd_vec_t  __attribute__ ((vector_size (RP_SIMD_VEC_SIZE)));
+  typedef char rp_simd_cvec_t __attribute__ ((vector_size (RP_SIMD_VEC_SIZE))); // R shifts like a char does in _old_apply_rule ()
+
+  for (int base = 0; base < rp_simd->cnt; base += RP_SIMD_VEC_SIZE)
+  {
+    const int cnt = MIN (rp_simd->cnt - base, RP_SIMD_VEC_SIZE);
+
+    rp_simd_vec_t row[RP_PASSWORD_SIZE];
+
+    rp_simd_vec_t len = SIMD_SPLAT (0);
+
+    const rp_simd_vec_t zero = SIMD_SPLAT (0);
+    const rp_simd_vec_t one  = SIMD_SPLAT (1);
+    const rp_simd_vec_t flip = SIMD_SPLAT (0x20);
+
+    const rp_simd_vec_t len_limit = SIMD_SPLAT (RP_PASSWORD_SIZE - 1);
+
+    int len_max = 0;
+
+    for (int i = 0; i < cnt; i++)
+    {
+      len_max = MAX (len_max, rp_simd->in_len[base + i]);
+    }
+
+    memset (row, 0, (len_max + 1) * sizeof (rp_simd_vec_t));
+
+    for (int i = 0; i < cnt; i++)
+    {
+      const int in_len = rp_simd->in_len[base + i];
+
+      if (in_len < 0) continue;
+
+      const u8 *in_buf = (const u8 *) rp_simd->in_buf[base + i];
+
+      for (int p = 0; p < in_len; p++) row[p][i] = in_buf[p];
+
+      len[i] = (u8) in_len;
+    }
+
+    for (int i = 0; i < MAX_KERNEL_RULES; i++)
+    {
+      const u32 cmd = rp_simd->kernel_rule.cmds[i];
+
+      if (cmd == 0) break;
+
+      const u8 name = (u8) (cmd >>  0);
+      const u8 p0   = (u8) (cmd >>  8);
+      const u8 p1   = (u8) (cmd >> 16);
+
+      switch (name)
+      {
+        case RULE_OP_MANGLE_NOOP:
+          break;
+
+        case RULE_OP_MANGLE_LREST:
+          for (int p = 0; p < len_max; p++) row[p] ^= SIMD_UPPER (row[p]) & flip;
+          break;
+
+        case RULE_OP_MANGLE_UREST:
+          for (int p = 0; p < len_max; p++) row[p] ^= SIMD_LOWER (row[p]) & flip;
+          break;
+
+        case RULE_OP_MANGLE_LREST_UFIRST:
+          for (int p = 0; p < len_max; p++) row[p] ^= SIMD_UPPER (row[p]) & flip;
+          row[0] ^= SIMD_LOWER (row[0]) & flip;
+          break;
+
+        case RULE_OP_MANGLE_UREST_LFIRST:
+          for (int p = 0; p < len_max; p++) row[p] ^= SIMD_LOWER (row[p]) & flip;
+          row[0] ^= SIMD_UPPER (row[0]) & flip;
+          break;
+
+        case RULE_OP_MANGLE_TREST:
+          for (int p = 0; p < len_max; p++) row[p] ^= SIMD_ALPHA (row[p]) & flip;
+          break;
+
+        case RULE_OP_MANGLE_TOGGLE_AT:
+          if (p0 < len_max) row[p0] ^= SIMD_ALPHA (row[p0]) & flip;
+          break;
+
+        case RULE_OP_MANGLE_REVERSE:
+        {
+          // reverse all rows in use, then shift each word down by the difference of its length to len_max
+          // the shift differs per lane, it runs as one conditional shift for each of its bits
+
+          for (int l = 0, r = len_max - 1; l < r; l++, r--)
+          {
+            const rp_simd_vec_t tmp = row[l];
+
+            row[l] = row[r];
+            row[r] = tmp;
+          }
+
+          const rp_simd_vec_t shift = SIMD_SPLAT (len_max) - len;
+
+          for (int bit = 1; bit < len_max; bit <<= 1)
+          {
+            const rp_simd_vec_t m = SIMD_MASK ((shift & SIMD_SPLAT (bit)) != zero);
+
+            for (int p = 0; p < len_max; p++)
+            {
+              const rp_simd_vec_t src = ((p + bit) < len_max) ? row[p + bit] : zero;
+
+              row[p] = SIMD_BLEND (m, src, row[p]);
+            }
+          }
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_ROTATE_LEFT:
+        {
+          const rp_simd_vec_t first = row[0];
+
+          for (int p = 0; p < len_max; p++) row[p] = SIMD_BLEND (SIMD_MASK (len == SIMD_SPLAT (p + 1)), first, row[p + 1]);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_ROTATE_RIGHT:
+        {
+          rp_simd_vec_t last = zero;
+
+          for (int p = 0; p < len_max; p++) last |= row[p] & SIMD_MASK (len == SIMD_SPLAT (p + 1));
+
+          for (int p = len_max - 1; p > 0; p--) row[p] = SIMD_BLEND (SIMD_MASK (SIMD_SPLAT (p) < len), row[p - 1], row[p]);
+
+          row[0] = SIMD_BLEND (SIMD_MASK (len > zero), last, row[0]);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_APPEND:
+        {
+          const rp_simd_vec_t ok = SIMD_MASK (len < len_limit);
+
+          if (len_max < RP_PASSWORD_SIZE - 1) row[len_max + 1] = zero;
+
+          for (int p = 0; p <= len_max; p++) row[p] = SIMD_BLEND (SIMD_MASK (len == SIMD_SPLAT (p)) & ok, SIMD_SPLAT (p0), row[p]);
+
+          len += ok & one;
+
+          len_max = MIN (len_max + 1, RP_PASSWORD_SIZE - 1);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_PREPEND:
+        {
+          const rp_simd_vec_t ok = SIMD_MASK (len < len_limit);
+
+          if (len_max < RP_PASSWORD_SIZE - 1) row[len_max + 1] = zero;
+
+          for (int p = MIN (len_max, RP_PASSWORD_SIZE - 2); p >= 0; p--) row[p + 1] = SIMD_BLEND (ok, row[p], row[p + 1]);
+
+          row[0] = SIMD_BLEND (ok, SIMD_SPLAT (p0), row[0]);
+
+          len += ok & one;
+
+          len_max = MIN (len_max + 1, RP_PASSWORD_SIZE - 1);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_DELETE_FIRST:
+        {
+          const rp_simd_vec_t ok = SIMD_MASK (len > zero);
+
+          for (int p = 0; p < len_max; p++) row[p] = SIMD_BLEND (ok, row[p + 1], row[p]);
+
+          len -= ok & one;
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_DELETE_LAST:
+        {
+          const rp_simd_vec_t ok = SIMD_MASK (len > zero);
+
+          for (int p = 0; p < len_max; p++) row[p] &= ~(SIMD_MASK (len == SIMD_SPLAT (p + 1)) & ok);
+
+          len -= ok & one;
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_DELETE_AT:
+        {
+          if (p0 >= len_max) break;
+
+          const rp_simd_vec_t ok = SIMD_MASK (SIMD_SPLAT (p0) < len);
+
+          for (int p = p0; p < len_max; p++) row[p] = SIMD_BLEND (ok, row[p + 1], row[p]);
+
+          len -= ok & one;
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_INSERT:
+        {
+          if (p0 > len_max) break;
+
+          const rp_simd_vec_t ok = SIMD_MASK ((SIMD_SPLAT (p0) <= len) & (len < len_limit));
+
+          if (len_max < RP_PASSWORD_SIZE - 1) row[len_max + 1] = zero;
+
+          for (int p = MIN (len_max, RP_PASSWORD_SIZE - 2); p >= p0; p--) row[p + 1] = SIMD_BLEND (ok, row[p], row[p + 1]);
+
+          row[p0] = SIMD_BLEND (ok, SIMD_SPLAT (p1), row[p0]);
+
+          len += ok & one;
+
+          len_max = MIN (len_max + 1, RP_PASSWORD_SIZE - 1);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_OVERSTRIKE:
+        {
+          if (p0 >= len_max) break;
+
+          const rp_simd_vec_t ok = SIMD_MASK (SIMD_SPLAT (p0) < len);
+
+          row[p0] = SIMD_BLEND (ok, SIMD_SPLAT (p1), row[p0]);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_TRUNCATE_AT:
+        {
+          if (p0 >= len_max) break;
+
+          const rp_simd_vec_t ok = SIMD_MASK (SIMD_SPLAT (p0) < len);
+
+          for (int p = p0; p < len_max; p++) row[p] &= ~ok;
+
+          len = SIMD_BLEND (ok, SIMD_SPLAT (p0), len);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_REPLACE:
+          for (int p = 0; p < len_max; p++) row[p] = SIMD_BLEND (SIMD_MASK ((row[p] == SIMD_SPLAT (p0)) & (SIMD_SPLAT (p) < len)), SIMD_SPLAT (p1), row[p]);
+          break;
+
+        case RULE_OP_MANGLE_REPLACE_CLASS:
+        {
+          for (int p = 0; p < len_max; p++)
+          {
+            const rp_simd_vec_t v = row[p];
+
+            rp_simd_vec_t m = zero;
+
+            switch (p0)
+            {
+              case '?': m = SIMD_MASK (v == SIMD_SPLAT ('?')); break;
+              case 'l': m = SIMD_LOWER (v);                    break;
+              case 'u': m = SIMD_UPPER (v);                    break;
+              case 'd': m = SIMD_NUM (v);                      break;
+              case 'h': m = SIMD_LOWER_HEX (v);                break;
+              case 'H': m = SIMD_UPPER_HEX (v);                break;
+              case 's': m = SIMD_SYM (v);                      break;
+            }
+
+            row[p] = SIMD_BLEND (m, SIMD_SPLAT (p1), v);
+          }
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_SWITCH_FIRST:
+        {
+          if (len_max < 2) break;
+
+          const rp_simd_vec_t ok = SIMD_MASK (len > one);
+
+          const rp_simd_vec_t tmp = row[0];
+
+          row[0] = SIMD_BLEND (ok, row[1], row[0]);
+          row[1] = SIMD_BLEND (ok, tmp,    row[1]);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_SWITCH_AT:
+        {
+          if (p0 >= len_max) break;
+          if (p1 >= len_max) break;
+
+          const rp_simd_vec_t ok = SIMD_MASK ((SIMD_SPLAT (p0) < len) & (SIMD_SPLAT (p1) < len));
+
+          const rp_simd_vec_t tmp = row[p0];
+
+          row[p0] = SIMD_BLEND (ok, row[p1], row[p0]);
+          row[p1] = SIMD_BLEND (ok, tmp,     row[p1]);
+
+          break;
+        }
+
+        case RULE_OP_MANGLE_CHR_SHIFTL:
+          if (p0 < len_max) row[p0] = SIMD_BLEND (SIMD_MASK (SIMD_SPLAT (p0) < len), row[p0] << 1, row[p0]);
+          break;
+
+        case RULE_OP_MANGLE_CHR_SHIFTR:
+          if (p0 < len_max) row[p0] = SIMD_BLEND (SIMD_MASK (SIMD_SPLAT (p0) < len), (rp_simd_vec_t) (((rp_simd_cvec_t) row[p0]) >> 1), row[p0]);
+          break;
+
+        case RULE_OP_MANGLE_CHR_INCR:
+          if (p0 < len_max) row[p0] = SIMD_BLEND (SIMD_MASK (SIMD_SPLAT (p0) < len), row[p0] + one, row[p0]);
+          break;
+
+        case RULE_OP_MANGLE_CHR_DECR:
+          if (p0 < len_max) row[p0] = SIMD_BLEND (SIMD_MASK (SIMD_SPLAT (p0) < len), row[p0] - one, row[p0]);
+          break;
+
+        case RULE_OP_MANGLE_REPLACE_NP1:
+          if ((p0 + 1) < len_max) row[p0] = SIMD_BLEND (SIMD_MASK (SIMD_SPLAT (p0 + 1) < len), row[p0 + 1], row[p0]);
+          break;
+
+        case RULE_OP_MANGLE_REPLACE_NM1:
+          if ((p0 >= 1) && (p0 < len_max)) row[p0] = SIMD_BLEND (SIMD_MASK (SIMD_SPLAT (p0) < len), row[p0 - 1], row[p0]);
+          break;
+      }
+    }
+
+    for (int i = 0; i < cnt; i++)
+    {
+      if (rp_simd->in_len[base + i] < 0)
+      {
+        rp_simd->out_len[base + i] = RULE_RC_REJECT_ERROR;
+
+        continue;
+      }
+
+      const int out_len = len[i];
+
+      u8 *out_buf = (u8 *) rp_simd->out_buf[base + i];
+
+      for (int p = 0; p < out_len; p++) out_buf[p] = row[p][i];
+
+      rp_simd->out_len[base + i] = out_len;
+    }
+  }
+}
@@ -52,7 +52,8 @@ typedef struct extra_info_mask
 
 } extra_info_mask_t;
 
-void slow_candidates_seek (hashcat_ctx_t *hashcat_ctx, void *extra_info, const u64 cur, const u64 end);
-void slow_candidates_next (hashcat_ctx_t *hashcat_ctx, void *extra_info);
+void slow_candidates_seek   (hashcat_ctx_t *hashcat_ctx, void *extra_info, const u64 cur, const u64 end);
+void slow_candidates_rewind (hashcat_ctx_t *hashcat_ctx, void *extra_info);
+void slow_candidates_next   (hashcat_ctx_t *hashcat_ctx, void *extra_info);
 
 #endif // HC_SLOW_CANDIDATES_H
@@ -0,0 +1,26 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_STARTUP_H
+#define HC_STARTUP_H
+
+#include <inttypes.h>
+
+typedef int (*STARTUP_TASK) (hashcat_ctx_t *);
+
+int    startup_ctx_init    (hashcat_ctx_t *hashcat_ctx);
+void   startup_ctx_destroy (hashcat_ctx_t *hashcat_ctx);
+void   startup_ctx_reset   (hashcat_ctx_t *hashcat_ctx);
+
+int    startup_task_add    (hashcat_ctx_t *hashcat_ctx, const char *name, STARTUP_TASK func, const u32 deps);
+int    startup_run         (hashcat_ctx_t *hashcat_ctx);
+void   startup_cancel      (hashcat_ctx_t *hashcat_ctx);
+bool   startup_cancelled   (hashcat_ctx_t *hashcat_ctx);
+
+double startup_stage_begin (hashcat_ctx_t *hashcat_ctx);
+void   startup_stage_end   (hashcat_ctx_t *hashcat_ctx, const char *name, const double start_ms);
+void   startup_finish      (hashcat_ctx_t *hashcat_ctx);
+
+#endif // HC_STARTUP_H
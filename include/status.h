@@ -64,6 +64,11 @@ double      status_get_progress_finished_percent      (const hashcat_ctx_t *hash
 u64         status_get_progress_done                  (const hashcat_ctx_t *hashcat_ctx);
 u64         status_get_progress_rejected              (const hashcat_ctx_t *hashcat_ctx);
 double      status_get_progress_rejected_percent      (const hashcat_ctx_t *hashcat_ctx);
+u64         status_get_progress_dedup                 (const hashcat_ctx_t *hashcat_ctx);
+double      status_get_dedup_fill_percent             (const hashcat_ctx_t *hashcat_ctx);
+int64_t     status_get_energy                         (const hashcat_ctx_t *hashcat_ctx);
+double      status_get_energy_joules                  (const hashcat_ctx_t *hashcat_ctx);
+double      status_get_hashes_per_joule               (const hashcat_ctx_t *hashcat_ctx);
 u64         status_get_progress_restored              (const hashcat_ctx_t *hashcat_ctx);
 u64         status_get_progress_cur                   (const hashcat_ctx_t *hashcat_ctx);
 u64         status_get_progress_end                   (const hashcat_ctx_t *hashcat_ctx);
@@ -116,6 +121,8 @@ int         status_get_kernel_accel_dev               (const hashcat_ctx_t *hash
 int         status_get_kernel_loops_dev               (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx);
 int         status_get_kernel_threads_dev             (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx);
 int         status_get_vector_width_dev               (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx);
+int         status_get_numa_node_dev                  (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx);
+int         status_get_startup_stages                 (const hashcat_ctx_t *hashcat_ctx, startup_stage_t *stages_buf);
 
 int         status_progress_init                      (hashcat_ctx_t *hashcat_ctx);
 void        status_progress_destroy                   (hashcat_ctx_t *hashcat_ctx);
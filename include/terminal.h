@@ -52,6 +52,7 @@ int tty_fix (void);
 bool is_stdout_terminal (void);
 
 void compress_terminal_line_length (char *out_buf, const size_t keep_from_beginning, const size_t keep_from_end);
+void json_encode (const char *text, char *escaped);
 
 void hash_info                          (hashcat_ctx_t *hashcat_ctx);
 
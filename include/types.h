@@ -699,6 +699,7 @@ typedef enum increment {
 typedef enum user_options_defaults
 {
   ADVICE                   = true,
+  ASSOCIATION_WIDTH        = 1,
   ATTACK_MODE              = ATTACK_MODE_STRAIGHT,
   AUTODETECT               = false,
   BACKEND_DEVICES_VIRTMULTI = 1,
@@ -710,6 +711,7 @@ typedef enum user_options_defaults
   BENCHMARK                = false,
   BITMAP_MAX               = 18,
   BITMAP_MIN               = 16,
+  BITMAP_L1                = true,
   #ifdef WITH_BRAIN
   BRAIN_CLIENT             = false,
   BRAIN_CLIENT_FEATURES    = 2,
@@ -718,7 +720,9 @@ typedef enum user_options_defaults
   BRAIN_SESSION            = 0,
   #endif
   COLOR_CRACKED            = false,
+  DAEMON                   = false,
   DEBUG_MODE               = 0,
+  DEDUP                    = false,
   DEPRECATED_CHECK         = true,
   DYNAMIC_X                = false,
   FORCE                    = false,
@@ -736,6 +740,7 @@ typedef enum user_options_defaults
   HEX_WORDLIST             = false,
   HOOK_THREADS             = 0,
   IDENTIFY                 = false,
+  IDENTIFY_ALL             = false,
   INCREMENT                = INCREMENT_NONE,
   INCREMENT_INVERSE        = false,
   INCREMENT_MAX            = PW_MAX,
@@ -750,13 +755,18 @@ typedef enum user_options_defaults
   LIMIT                    = 0,
   LOGFILE                  = true,
   LOOPBACK                 = false,
+  LOOPBACK_QUEUE           = false,
   MACHINE_READABLE         = false,
+  MASK_FUSION              = false,
   MARKOV_CLASSIC           = false,
   MARKOV                   = true,
   MARKOV_INVERSE           = false,
   MARKOV_THRESHOLD         = 0,
   METAL_COMPILER_RUNTIME   = 120,
+  METRICS_PORT             = 0,
   NONCE_ERROR_CORRECTIONS  = 8,
+  NUMA                     = true,
+  NUMA_HUGEPAGES           = false,
   BACKEND_IGNORE_CUDA      = false,
   BACKEND_IGNORE_HIP       = false,
   #if defined (__APPLE__)
@@ -764,6 +774,7 @@ typedef enum user_options_defaults
   #endif
   BACKEND_IGNORE_OPENCL    = false,
   BACKEND_INFO             = 0,
+  BACKEND_NATIVE           = false,
   BACKEND_VECTOR_WIDTH     = 0,
   OPTIMIZED_KERNEL         = false,
   MULTIPLY_ACCEL           = true,
@@ -772,6 +783,8 @@ typedef enum user_options_defaults
   OUTFILE_FORMAT           = 3,
   OUTFILE_JSON             = false,
   POTFILE                  = true,
+  POTFILE_COMPACT          = false,
+  POTFILE_SHARD            = false,
   PROGRESS_ONLY            = false,
   QUIET                    = false,
   REMOVE                   = false,
@@ -783,7 +796,10 @@ typedef enum user_options_defaults
   RP_GEN_FUNC_MAX          = 4,
   RP_GEN_FUNC_MIN          = 1,
   RP_GEN_SEED              = 0,
+  RULES_FUZZ               = 0,
+  RULES_OPTIMIZE           = false,
   RUNTIME                  = 0,
+  SALT_PACK                = false,
   SCRYPT_TMTO              = 0,
   SEGMENT_SIZE             = 33554432,
   SELF_TEST                = true,
@@ -797,6 +813,7 @@ typedef enum user_options_defaults
   STATUS_TIMER             = 10,
   STDIN_TIMEOUT_ABORT      = 120,
   STDOUT_FLAG              = false,
+  TUNE_ENERGY              = false,
   USAGE                    = 0,
   USERNAME                 = false,
   VERSION                  = false,
@@ -835,6 +852,7 @@ typedef enum user_options_map
   IDX_BRAIN_PORT                = 0xff0c,
   IDX_BRAIN_SERVER              = 0xff0d,
   IDX_BRAIN_SERVER_TIMER        = 0xff0e,
+  IDX_BRAIN_SERVER_LEASE        = 0xff89,
   IDX_BRAIN_SESSION             = 0xff0f,
   IDX_BRAIN_SESSION_WHITELIST   = 0xff10,
   #endif
@@ -854,6 +872,8 @@ typedef enum user_options_map
   IDX_CUSTOM_CHARSET_6          = '6',
   IDX_CUSTOM_CHARSET_7          = '7',
   IDX_CUSTOM_CHARSET_8          = '8',
+  IDX_DAEMON                    = 0xff8c,
+  IDX_DAEMON_SOCKET             = 0xff8d,
   IDX_DEBUG_FILE                = 0xff12,
   IDX_DEBUG_MODE                = 0xff13,
   IDX_DEPRECATED_CHECK_DISABLE  = 0xff14,
@@ -872,6 +892,8 @@ typedef enum user_options_map
   IDX_HEX_WORDLIST              = 0xff1e,
   IDX_HOOK_THREADS              = 0xff1f,
   IDX_IDENTIFY                  = 0xff20,
+  IDX_IDENTIFY_ALL              = 0xff8a,
+  IDX_IDENTIFY_SPLIT_DIR        = 0xff8b,
   IDX_INCREMENT                 = 'i',
   IDX_INCREMENT_INVERSE         = 0xff61,
   IDX_INCREMENT_MAX             = 0xff21,
@@ -891,9 +913,25 @@ typedef enum user_options_map
   IDX_MARKOV_CLASSIC            = 0xff2b,
   IDX_MARKOV_DISABLE            = 0xff2c,
   IDX_MARKOV_HCSTAT2            = 0xff2d,
+  IDX_MARKOV_HCSTAT2_CREATE     = 0xff86,
   IDX_MARKOV_INVERSE            = 0xff2e,
   IDX_MARKOV_THRESHOLD          = 't',
   IDX_METAL_COMPILER_RUNTIME    = 0xff2f,
+  IDX_METRICS_PORT              = 0xff8e,
+  IDX_METRICS_SOCKET            = 0xff8f,
+  IDX_MASK_FUSION               = 0xff91,
+  IDX_LOOPBACK_QUEUE            = 0xff92,
+  IDX_POTFILE_SHARD             = 0xff93,
+  IDX_POTFILE_COMPACT           = 0xff94,
+  IDX_BACKEND_NATIVE            = 0xff95,
+  IDX_SALT_PACK                 = 0xff96,
+  IDX_DEDUP                     = 0xff97,
+  IDX_NUMA_DISABLE              = 0xff98,
+  IDX_NUMA_HUGEPAGES            = 0xff99,
+  IDX_HWMON_SYSFS_ROOT          = 0xff9a,
+  IDX_TUNE_ENERGY               = 0xff9b,
+  IDX_BITMAP_L1_DISABLE         = 0xff9c,
+  IDX_ASSOCIATION_WIDTH         = 0xff9d,
   IDX_NONCE_ERROR_CORRECTIONS   = 0xff30,
   IDX_OPENCL_DEVICE_TYPES       = 'D',
   IDX_OPTIMIZED_KERNEL_ENABLE   = 'O',
@@ -921,6 +959,9 @@ typedef enum user_options_map
   IDX_RP_GEN_SEED               = 0xff42,
   IDX_RULE_BUF_L                = 'j',
   IDX_RULE_BUF_R                = 'k',
+  IDX_RULES_OPTIMIZE            = 0xff87,
+  IDX_RULES_OPTIMIZE_OUT        = 0xff88,
+  IDX_RULES_FUZZ                = 0xff9e,
   IDX_RUNTIME                   = 0xff43,
   IDX_SCRYPT_TMTO               = 0xff44,
   IDX_SEGMENT_SIZE              = 'c',
@@ -1065,6 +1106,32 @@ typedef struct logfile_ctx
 
 } logfile_ctx_t;
 
+typedef struct cracked_entry
+{
+  u64 crackpos;
+
+  u32 out_len;
+  u32 pot_len;
+  u32 plain_len;
+
+  int debug_rule_len; // -1 error
+  int debug_plain_len;
+
+} cracked_entry_t;
+
+typedef struct cracked_batch
+{
+  u8  *buf; // cracked_entry_t records, each followed by hash, potfile hash, plain and debug data
+
+  u64  buf_len;
+  u64  buf_size;
+
+  u32  entries_cnt;
+
+  struct cracked_batch *next;
+
+} cracked_batch_t;
+
 typedef struct hashes
 {
   const char  *hashfile;
@@ -1101,6 +1168,17 @@ typedef struct hashes
   u8          *out_buf; // allocates [HCBUFSIZ_LARGE];
   u8          *tmp_buf; // allocates [HCBUFSIZ_LARGE];
 
+  // cracked queue, filled by the device threads and written by thread_cracked
+
+  hc_thread_mutex_t     mux_cracked;
+  hc_thread_semaphore_t sem_cracked; // posted for each queued batch and once for the shutdown request
+
+  cracked_batch_t *cracked_head;
+  cracked_batch_t *cracked_tail;
+
+  bool         cracked_active;
+  bool         cracked_shutdown;
+
   // selftest buffers
 
   void        *st_digests_buf;
@@ -1227,21 +1305,24 @@ typedef struct link_speed
 
 typedef struct xzfile xzfile_t;
 
+typedef struct blockfile blockfile_t;
+
 typedef struct hc_fp
 {
-  int         fd;
+  int          fd;
 
-  FILE       *pfp; // plain fp
-  gzFile      gfp; //  gzip fp
-  unzFile     ufp; //   zip fp
-  xzfile_t   *xfp; //    xz fp
+  FILE        *pfp; // plain fp
+  gzFile       gfp; //  gzip fp
+  unzFile      ufp; //   zip fp
+  xzfile_t    *xfp; //    xz fp
+  blockfile_t *bfp; // block fp, multi-threaded bgzf, xz and zstd
 
-  int         bom_size;
+  int          bom_size;
 
-  const char *mode;
-  const char *path;
+  const char  *mode;
+  const char  *path;
 
-  off_t       uncompressed_size;
+  off_t        uncompressed_size;
 
 } HCFILE;
 
@@ -1252,6 +1333,7 @@ typedef struct hc_fp
 #include "ext_hip.h"
 #include "ext_OpenCL.h"
 #include "ext_metal.h"
+#include "ext_native.h"
 
 typedef struct hc_device_param
 {
@@ -1290,6 +1372,7 @@ typedef struct hc_device_param
   u32     kernel_preferred_wgs_multiple;
 
   int     bridge_link_device;
+  int     numa_node;              // index into backend_ctx->numa_topology, -1 if not placed
 
   st_status_t st_status;        // selftest status
 
@@ -1418,6 +1501,8 @@ typedef struct hc_device_param
   u32     kernel_threads_min;
   u32     kernel_threads_max;
 
+  u32     kern_type;            // after module_kern_type_dynamic(), set by backend_session_build()
+
   bool    overtune_unfriendly;  // whatever sets this decide we operate in a mode that is not allowing to overtune threads_max or accel_max in autotuner
 
   u64     kernel_power;
@@ -1433,6 +1518,8 @@ typedef struct hc_device_param
   u64  size_hooks;
   u64  size_bfs;
   u64  size_combs;
+  u64  size_combs_cache;
+  u64  size_total;
   u64  size_rules;
   u64  size_rules_c;
   u64  size_root_css;
@@ -1456,6 +1543,7 @@ typedef struct hc_device_param
   u64  size_brain_link_out;
 
   int           brain_link_client_fd;
+  u32           brain_link_version; // of the server, older servers only confirm ours with 1
   link_speed_t  brain_link_recv_speed;
   link_speed_t  brain_link_send_speed;
   bool          brain_link_recv_active;
@@ -1467,15 +1555,18 @@ typedef struct hc_device_param
   #endif
 
   char     *scratch_buf;
+  u8       *cracked_buf; // allocates [HCBUFSIZ_LARGE], hash and potfile hash encoding of check_cracked()
 
   HCFILE    combs_fp;
   pw_t     *combs_buf;
+  u32       combs_cache_gen;
 
   void     *hooks_buf;
 
   pw_idx_t *pws_idx;
   u32      *pws_comp;
   u64       pws_cnt;
+  u64       pws_loopback_cnt; // pws_cnt share fed from the loopback queue, not part of the keyspace
 
   pw_pre_t *pws_pre_buf;  // for slow candidates
   u64       pws_pre_cnt;
@@ -1483,6 +1574,12 @@ typedef struct hc_device_param
   pw_pre_t *pws_base_buf; // for debug mode
   u64       pws_base_cnt;
 
+  u64      *dedup_buf;     // --dedup, candidate hashes of the batch in flight, committed to the filter once it is done
+  u64       dedup_cnt;
+  u64       dedup_avail;
+  u64      *dedup_seen;    // open addressing set over dedup_buf, catches duplicates within the batch
+  u64       dedup_seen_size;
+
   void    *h_tmps; // we need this only for bridges
 
   u64     words_off;
@@ -1496,9 +1593,18 @@ typedef struct hc_device_param
   u64     innerloop_pos;
   u64     innerloop_left;
 
+  // --salt-pack, salts in the current launch and candidates per salt
+
+  u32     salt_pack_cnt;
+  u64     salt_pack_pws;
+
   u32     exec_pos;
   double  exec_msec[EXEC_CACHE];
 
+  // time spent waiting on mux_dispatcher, exported by --metrics-port
+
+  double  dispatcher_wait_msec;
+
   // workaround cpu spinning
 
   double  exec_us_prev1[EXPECTED_ITERATIONS];
@@ -1651,6 +1757,7 @@ typedef struct hc_device_param
   CUdeviceptr       cuda_d_rules_c;
   CUdeviceptr       cuda_d_combs;
   CUdeviceptr       cuda_d_combs_c;
+  CUdeviceptr       cuda_d_combs_cache;
   CUdeviceptr       cuda_d_bfs;
   CUdeviceptr       cuda_d_bfs_c;
   CUdeviceptr       cuda_d_tm_c;
@@ -1734,6 +1841,7 @@ typedef struct hc_device_param
   hipDeviceptr_t    hip_d_rules_c;
   hipDeviceptr_t    hip_d_combs;
   hipDeviceptr_t    hip_d_combs_c;
+  hipDeviceptr_t    hip_d_combs_cache;
   hipDeviceptr_t    hip_d_bfs;
   hipDeviceptr_t    hip_d_bfs_c;
   hipDeviceptr_t    hip_d_tm_c;
@@ -1855,6 +1963,7 @@ typedef struct hc_device_param
   mtl_mem_t         metal_d_rules_c;
   mtl_mem_t         metal_d_combs;
   mtl_mem_t         metal_d_combs_c;
+  mtl_mem_t         metal_d_combs_cache;
   mtl_mem_t         metal_d_bfs;
   mtl_mem_t         metal_d_bfs_c;
   mtl_mem_t         metal_d_tm_c;
@@ -1944,6 +2053,7 @@ typedef struct hc_device_param
   cl_mem            opencl_d_rules_c;
   cl_mem            opencl_d_combs;
   cl_mem            opencl_d_combs_c;
+  cl_mem            opencl_d_combs_cache;
   cl_mem            opencl_d_bfs;
   cl_mem            opencl_d_bfs_c;
   cl_mem            opencl_d_tm_c;
@@ -1974,8 +2084,107 @@ typedef struct hc_device_param
   cl_mem            opencl_d_st_esalts_buf;
   cl_mem            opencl_d_kernel_param;
 
+  // API: native
+
+  bool              is_native;
+
+  native_pool_t    *native_pool;
+
+  native_module_t   native_module;
+  native_module_t   native_module_shared;
+  native_module_t   native_module_mp;
+  native_module_t   native_module_amp;
+
+  native_function_t native_function1;
+  native_function_t native_function12;
+  native_function_t native_function2p;
+  native_function_t native_function2;
+  native_function_t native_function2e;
+  native_function_t native_function23;
+  native_function_t native_function3;
+  native_function_t native_function4;
+  native_function_t native_function_init2;
+  native_function_t native_function_loop2p;
+  native_function_t native_function_loop2;
+  native_function_t native_function_mp;
+  native_function_t native_function_mp_l;
+  native_function_t native_function_mp_r;
+  native_function_t native_function_amp;
+  native_function_t native_function_tm;
+  native_function_t native_function_memset;
+  native_function_t native_function_bzero;
+  native_function_t native_function_atinit;
+  native_function_t native_function_utf8toutf16le;
+  native_function_t native_function_decompress;
+  native_function_t native_function_aux1;
+  native_function_t native_function_aux2;
+  native_function_t native_function_aux3;
+  native_function_t native_function_aux4;
+
+  void             *native_d_pws_buf;
+  void             *native_d_pws_amp_buf;
+  void             *native_d_pws_comp_buf;
+  void             *native_d_pws_idx;
+  void             *native_d_rules;
+  void             *native_d_rules_c;
+  void             *native_d_combs;
+  void             *native_d_combs_c;
+  void             *native_d_combs_cache;
+  void             *native_d_bfs;
+  void             *native_d_bfs_c;
+  void             *native_d_tm_c;
+  void             *native_d_bitmap_s1_a;
+  void             *native_d_bitmap_s1_b;
+  void             *native_d_bitmap_s1_c;
+  void             *native_d_bitmap_s1_d;
+  void             *native_d_bitmap_s2_a;
+  void             *native_d_bitmap_s2_b;
+  void             *native_d_bitmap_s2_c;
+  void             *native_d_bitmap_s2_d;
+  void             *native_d_plain_bufs;
+  void             *native_d_digests_buf;
+  void             *native_d_digests_shown;
+  void             *native_d_salt_bufs;
+  void             *native_d_esalt_bufs;
+  void             *native_d_tmps;
+  void             *native_d_hooks;
+  void             *native_d_result;
+  void             *native_d_extra0_buf;
+  void             *native_d_extra1_buf;
+  void             *native_d_extra2_buf;
+  void             *native_d_extra3_buf;
+  void             *native_d_root_css_buf;
+  void             *native_d_markov_css_buf;
+  void             *native_d_st_digests_buf;
+  void             *native_d_st_salts_buf;
+  void             *native_d_st_esalts_buf;
+  void             *native_d_kernel_param;
+
+  // the cached kernel files the programs above were loaded from, a daemon keeps them between its jobs
+
+  char             *program_file;
+  char             *program_file_shared;
+  char             *program_file_mp;
+  char             *program_file_amp;
+
 } hc_device_param_t;
 
+typedef struct numa_node
+{
+  int   node_id;    // the N in /sys/devices/system/node/nodeN
+  int  *cpus_buf;
+  int   cpus_cnt;
+
+} numa_node_t;
+
+typedef struct numa_topology
+{
+  numa_node_t *nodes_buf;   // only nodes with at least one online cpu
+  int          nodes_cnt;
+  int          cpus_cnt;
+
+} numa_topology_t;
+
 typedef struct backend_ctx
 {
   bool                enabled;
@@ -1991,12 +2200,21 @@ typedef struct backend_ctx
   bool                mixed_warnings;
   bool                self_test_warnings;
 
+  // backend_session_build() runs ahead of backend_session_begin(), see outer_loop()
+
+  bool                session_built;
+  int                 session_build_rc;
+  int                 build_runtime_skip_warnings;
+  int                 build_kernel_build_warnings;
+  int                 build_kernel_create_warnings;
+
   // generic
 
   void               *cuda;
   void               *hip;
   void               *mtl;
   void               *ocl;
+  void               *native;
 
   void               *nvrtc;
   void               *hiprtc;
@@ -2006,6 +2224,7 @@ typedef struct backend_ctx
   int                 backend_device_from_metal[DEVICES_MAX];                             // from metal device index to backend device index
   int                 backend_device_from_opencl[DEVICES_MAX];                            // from opencl device index to backend device index
   int                 backend_device_from_opencl_platform[CL_PLATFORMS_MAX][DEVICES_MAX]; // from opencl device index to backend device index (by platform)
+  int                 backend_device_from_native[DEVICES_MAX];                            // from native device index to backend device index
 
   int                 backend_devices_cnt;
   int                 backend_devices_virtmulti;
@@ -2021,6 +2240,8 @@ typedef struct backend_ctx
   int                 metal_devices_active;
   int                 opencl_devices_cnt;
   int                 opencl_devices_active;
+  int                 native_devices_cnt;
+  int                 native_devices_active;
 
   int                 backend_devices_filter[DEVICES_MAX];
 
@@ -2081,6 +2302,15 @@ typedef struct backend_ctx
 
   cl_device_type      opencl_device_types_filter;
 
+  // native
+
+  int                 rc_native_init;
+
+  // host topology, used to place bridge units and host threads
+
+  numa_topology_t     numa_topology;
+  bool                numa_enabled;
+
 } backend_ctx_t;
 
 typedef enum kernel_workload
@@ -2126,6 +2356,7 @@ typedef struct hm_attrs
   bool utilization_get_supported;
   bool memoryused_get_supported;
   bool power_get_supported;
+  bool energy_get_supported;
 
 } hm_attrs_t;
 
@@ -2220,6 +2451,32 @@ typedef struct dictstat_ctx
 
 } dictstat_ctx_t;
 
+typedef struct dedup_ctx
+{
+  bool  enabled;
+
+  char *filename;
+
+  hc_thread_mutex_t mux;
+
+  u32  *buckets_buf;  // cuckoo filter, DEDUP_BUCKET_SLOTS fingerprints per bucket, 0 marks an empty slot
+  u64   buckets_cnt;  // power of two
+
+  u64   items;
+  u64   skipped;      // candidates skipped as duplicates, including earlier runs of the session
+  u64   dropped;      // fingerprints lost to a full filter, they only cost a repeated test
+
+  u32   kick_pos;
+
+} dedup_ctx_t;
+
+typedef struct loopback_entry
+{
+  u32 pw_len;
+  u8  pw_buf[PW_MAX];
+
+} loopback_entry_t;
+
 typedef struct loopback_ctx
 {
   HCFILE  fp;
@@ -2229,6 +2486,22 @@ typedef struct loopback_ctx
 
   char   *filename;
 
+  // in-memory queue feeding new plains back into the running attack
+
+  bool               queue;
+
+  hc_thread_mutex_t  mux_queue;
+
+  loopback_entry_t  *queue_buf;
+  u64                queue_pos;
+  u64                queue_cnt;
+  u64                queue_avail;
+  u64                queue_done;
+
+  u64               *seen_buf;   // open addressing set of plain hashes
+  u64                seen_cnt;
+  u64                seen_size;
+
 } loopback_ctx_t;
 
 typedef struct mf
@@ -2238,6 +2511,18 @@ typedef struct mf
 
 } mf_t;
 
+typedef struct mask_fuse
+{
+  char *mask;   // maskfile line this entry was parsed from
+  u32  *sets;   // per position token bitset, NULL if the mask can not be fused
+  u32   len;
+  u32   first;  // index of the first maskfile line fused into this entry
+  u64   hash;
+  bool  alive;
+  bool  fused;
+
+} mask_fuse_t;
+
 typedef struct outfile_ctx
 {
   HCFILE  fp;
@@ -2269,6 +2554,7 @@ typedef struct potfile_ctx
   bool     enabled;
 
   char    *filename;
+  char    *shard_dir; // --potfile-shard, filename follows the hash-mode of the current outer loop
 
   u8      *out_buf; // allocates [HCBUFSIZ_LARGE];
   u8      *tmp_buf; // allocates [HCBUFSIZ_LARGE];
@@ -2418,6 +2704,8 @@ typedef struct wl_data
   iconv_t iconv_ctx;
   char   *iconv_tmp;
 
+  bool    rule_l_rejects; // -j can reject a word, so counting and reading the words has to run it
+
   void (*func) (char *, u64, u64 *, u64 *);
 
 } wl_data_t;
@@ -2436,12 +2724,14 @@ typedef struct user_options
   bool         brain_port_chgd;
   bool         brain_password_chgd;
   bool         brain_server_timer_chgd;
+  bool         brain_server_lease_chgd;
   #endif
   bool         bypass_delay_chgd;
   bool         bypass_threshold_chgd;
   bool         hash_mode_chgd;
   bool         hccapx_message_pair_chgd;
   bool         identify;
+  bool         identify_all;
   bool         increment_max_chgd;
   bool         increment_min_chgd;
   bool         kernel_accel_chgd;
@@ -2469,12 +2759,15 @@ typedef struct user_options
   bool         advice;
   bool         benchmark;
   bool         benchmark_all;
+  bool         bitmap_l1;
   #ifdef WITH_BRAIN
   bool         brain_client;
   bool         brain_server;
   #endif
   bool         color_cracked;
   bool         force;
+  bool         daemon;
+  bool         dedup;
   bool         deprecated_check;
   bool         dynamic_x;
   bool         hwmon;
@@ -2488,7 +2781,9 @@ typedef struct user_options
   bool         left;
   bool         logfile;
   bool         loopback;
+  bool         loopback_queue;
   bool         machine_readable;
+  bool         mask_fusion;
   bool         markov_classic;
   bool         markov;
   bool         markov_inverse;
@@ -2496,16 +2791,23 @@ typedef struct user_options
   bool         backend_ignore_hip;
   bool         backend_ignore_metal;
   bool         backend_ignore_opencl;
+  bool         backend_native;
   bool         optimized_kernel;
   bool         multiply_accel;
+  bool         numa;
+  bool         numa_hugepages;
   bool         outfile_autohex;
   bool         outfile_json;
   bool         potfile;
+  bool         potfile_compact;
+  bool         potfile_shard;
   bool         progress_only;
   bool         quiet;
   bool         remove;
   bool         restore;
   bool         restore_enable;
+  bool         rules_optimize;
+  bool         salt_pack;
   bool         self_test;
   bool         show;
   bool         slow_candidates;
@@ -2514,6 +2816,7 @@ typedef struct user_options
   bool         status_json;
   bool         stdout_flag;
   bool         stdin_timeout_abort_chgd;
+  bool         tune_energy;
   bool         username;
   bool         veracrypt_pim_start_chgd;
   bool         veracrypt_pim_stop_chgd;
@@ -2529,10 +2832,16 @@ typedef struct user_options
   char        *bridge_parameter3;
   char        *bridge_parameter4;
   char        *cpu_affinity;
+  char        *daemon_socket;
   char        *debug_file;
+  char        *hwmon_sysfs_root;
+  char        *identify_split_dir;
   char        *induction_dir;
   char        *keyboard_layout_mapping;
   char        *markov_hcstat2;
+  char        *markov_hcstat2_create;
+  char        *metrics_socket;
+  char        *rules_optimize_out;
   char        *backend_devices;
   char        *opencl_device_types;
   char        *outfile;
@@ -2557,6 +2866,7 @@ typedef struct user_options
   const char  *rule_buf_l;
   const char  *rule_buf_r;
   const char  *session;
+  u32          association_width;
   u32          attack_mode;
   u32          backend_devices_virtmulti;
   u32          backend_devices_virthost;
@@ -2568,6 +2878,7 @@ typedef struct user_options
   u32          bitmap_min;
   #ifdef WITH_BRAIN
   u32          brain_server_timer;
+  u32          brain_server_lease;
   u32          brain_client_features;
   u32          brain_port;
   u32          brain_session;
@@ -2587,6 +2898,7 @@ typedef struct user_options
   u32          kernel_loops;
   u32          kernel_threads;
   u32          markov_threshold;
+  u32          metrics_port;
   u32          nonce_error_corrections;
   u32          spin_damp;
   u32          backend_vector_width;
@@ -2599,6 +2911,7 @@ typedef struct user_options
   u32          rp_gen_func_max;
   u32          rp_gen_func_min;
   u32          rp_gen_seed;
+  u32          rules_fuzz;
   u32          runtime;
   u32          metal_compiler_runtime;
   u32          scrypt_tmto;
@@ -2659,6 +2972,9 @@ typedef struct bitmap_ctx
   u32  *bitmap_s2_c;
   u32  *bitmap_s2_d;
 
+  bool   bitmap_l1_enabled;
+  double bitmap_l1_fill;
+
 } bitmap_ctx_t;
 
 typedef struct folder_config
@@ -2719,8 +3035,51 @@ typedef struct combinator_ctx
   u32 combs_mode;
   u64 combs_cnt;
 
+  // parsed and packed right-hand wordlist, shared by all devices
+
+  bool  cache_enabled;
+  char *cache_file;
+  u32   cache_gen;
+  u8    cache_pad;
+
+  u8   *cache_buf;
+  u64  *cache_off;  // cache_cnt + 1 entries
+  u64  *cache_rej;  // cache_cnt + 1 entries, cumulative count of rule-rejected lines
+  u64   cache_cnt;
+
 } combinator_ctx_t;
 
+typedef struct sp_cache_header
+{
+  u64 version;
+  u32 hcstat_crc32;
+  u32 hcstat_size;
+  u32 markov;
+  u32 classic;
+  u32 inverse;
+  u32 reserved[9];
+
+} sp_cache_header_t;
+
+typedef struct sp_gen_thread_param
+{
+  u32 tid;
+
+  const u8 *buf;
+  size_t    buf_len;
+
+  u32 *root_local_buf;
+  u32 *markov_local_buf;
+
+  u64 *root_stats_buf;
+  u64 *markov_stats_buf;
+
+  hc_thread_mutex_t *mux_stats;
+
+  u64 words_cnt;
+
+} sp_gen_thread_param_t;
+
 typedef struct mask_ctx
 {
   bool   enabled;
@@ -2733,8 +3092,11 @@ typedef struct mask_ctx
   cs_t  *css_buf;
   u32    css_cnt;
 
-  hcstat_table_t *root_table_buf;
-  hcstat_table_t *markov_table_buf;
+  u8    *tbl_buf;     // sp_cache_header_t followed by both sorted key tables
+  bool   tbl_mapped;  // tbl_buf is a read-only mapping of the hcstat2 cache file
+
+  u8    *root_table_buf;
+  u8    *markov_table_buf;
 
   cs_t  *root_css_buf;
   cs_t  *markov_css_buf;
@@ -2838,6 +3200,7 @@ typedef struct device_info
   int     kernel_loops_dev;
   int     kernel_threads_dev;
   int     vector_width_dev;
+  int     numa_node_dev;
   int     salt_pos_dev;
   u64     innerloop_pos_dev;
   u64     innerloop_left_dev;
@@ -2858,6 +3221,56 @@ typedef struct device_info
 
 } device_info_t;
 
+/**
+ * startup, the hash-mode depending setup in outer_loop() as a small graph of tasks running on their own threads
+ */
+
+#define STARTUP_TASKS_MAX  8
+#define STARTUP_STAGES_MAX 16
+
+struct hashcat_ctx;
+
+typedef struct startup_stage
+{
+  const char *name;
+
+  double      start_ms;   // relative to the begin of the hash-mode setup
+  double      ms;
+
+} startup_stage_t;
+
+typedef struct startup_task
+{
+  const char *name;
+
+  int       (*func) (struct hashcat_ctx *);
+
+  u32         deps;       // bitmask of task indices which have to finish first
+  int         rc;
+
+  hc_thread_semaphore_t sem_done; // posted once the task finished, every waiter posts it again
+
+  struct hashcat_ctx *hashcat_ctx;
+
+} startup_task_t;
+
+typedef struct startup_ctx
+{
+  hc_timer_t        timer;
+
+  bool              finished;   // the first cracker threads started, no more stages
+  bool              cancelled;  // the tasks still running can stop, outer_loop () will not use their results
+
+  startup_task_t    tasks_buf[STARTUP_TASKS_MAX];
+  int               tasks_cnt;
+
+  startup_stage_t   stages_buf[STARTUP_STAGES_MAX];
+  int               stages_cnt;
+
+  hc_thread_mutex_t mux_stages;
+
+} startup_ctx_t;
+
 typedef struct hashcat_status
 {
   char       *hash_target;
@@ -2909,6 +3322,10 @@ typedef struct hashcat_status
   u64         progress_ignore;
   u64         progress_rejected;
   double      progress_rejected_percent;
+  u64         progress_dedup;
+  double      dedup_fill_percent;
+  double      energy_joules;
+  double      hashes_per_joule;
   u64         progress_restored;
   u64         progress_skip;
   u64         restore_point;
@@ -2930,6 +3347,9 @@ typedef struct hashcat_status
   double  exec_msec_all;
   char   *speed_sec_all;
 
+  startup_stage_t startup_stages_buf[STARTUP_STAGES_MAX];
+  int             startup_stages_cnt;
+
 } hashcat_status_t;
 
 typedef struct status_ctx
@@ -2987,6 +3407,9 @@ typedef struct status_ctx
   u64 *words_progress_rejected; // progress number of words rejected per salt
   u64 *words_progress_restored; // progress number of words restored per salt
 
+  u64  words_progress_done_session;     // sum of words_progress_done     of the finished queue entries, under mux_counter
+  u64  words_progress_rejected_session; // sum of words_progress_rejected of the finished queue entries, under mux_counter
+
   int bypass_digests_done_new;  // --bypass-threshold cracked counter
 
   /**
@@ -3000,6 +3423,7 @@ typedef struct status_ctx
   time_t timer_bypass_cur;
 
   hc_timer_t timer_running;     // timer on current dict
+  int64_t    energy_running;    // cpu package energy in uJ when timer_running was set, -1 if unknown
   hc_timer_t timer_paused;      // timer on current dict
 
   double  msec_paused;          // timer on current dict
@@ -3120,6 +3544,14 @@ typedef struct bridge_ctx
 
 typedef void (*MODULE_INIT) (void *);
 
+typedef struct module_static
+{
+  u32         hash_mode;
+
+  MODULE_INIT module_init;
+
+} module_static_t;
+
 typedef struct module_ctx
 {
   size_t      module_context_size;
@@ -3218,6 +3650,148 @@ typedef struct module_ctx
 
 } module_ctx_t;
 
+typedef struct module_manifest_header
+{
+  u32 magic;
+  u32 version;
+  u32 entries_cnt;
+  u32 reserved[5];
+
+} module_manifest_header_t;
+
+typedef struct module_manifest_entry
+{
+  u32  hash_mode;
+  u32  hash_category;
+  u64  opts_type;
+  u32  salt_type;
+
+  // signature of the example hash, used to skip modules without loading them
+
+  u32  sig_type;
+  u32  sig_char;
+  u32  sig_len;
+
+  // to find out if the module file was replaced since the manifest was written
+
+  u64  file_size;
+  u64  file_mtime;
+
+  char hash_name[256];
+
+} module_manifest_entry_t;
+
+typedef struct metrics_ctx
+{
+  bool    enabled;
+
+  int     server_fd;
+  char   *socket_path;
+
+  hc_thread_t        thread;
+  hc_thread_mutex_t  mux_page;
+
+  bool    shutdown;
+
+  // page is rendered by the monitor thread, the server thread only copies it
+
+  char   *page_buf;
+  size_t  page_len;
+
+} metrics_ctx_t;
+
+typedef struct resident_hashes_key
+{
+  u32     hash_mode;
+  u32     hashlist_mode;
+  u32     salt_type;
+  u32     dgst_size;
+  u32     opti_type;
+  u64     opts_type;
+  u64     esalt_size;
+  u64     hook_salt_size;
+  bool    is_salted;
+  bool    potfile_keep_all_hashes;
+  char    separator;
+  bool    hlfmt_disable;
+  u32     pwdump_column;
+  u32     pw_max;
+  u32     salt_max;
+
+  bool    association;
+  bool    dynamic_x;
+  bool    hex_salt;
+  bool    username;
+  bool    hccapx_message_pair_chgd;
+  u32     hccapx_message_pair;
+  bool    nonce_error_corrections_chgd;
+  u32     nonce_error_corrections;
+
+  u64     file_dev;
+  u64     file_ino;
+  u64     file_size;
+  u64     file_mtime;
+
+} resident_hashes_key_t;
+
+typedef struct resident_tune_key
+{
+  u32     hash_mode;
+  u32     kern_type;
+  u32     attack_exec;
+  u32     attack_kern;
+  u32     attack_mode;
+  u32     opti_type;
+  u64     opts_type;
+
+  u32     salts_cnt;
+  u32     digests_cnt;
+  u32     salt_iter;
+
+  double  target_msec;
+  bool    tune_energy;
+  u32     association_width;
+
+  u32     vector_width;
+  u32     kernel_accel_min;
+  u32     kernel_accel_max;
+  u32     kernel_loops_min;
+  u32     kernel_loops_max;
+  u32     kernel_threads_min;
+  u32     kernel_threads_max;
+
+} resident_tune_key_t;
+
+typedef struct resident_tune
+{
+  bool    valid;
+
+  resident_tune_key_t key;
+
+  u32     kernel_accel;
+  u32     kernel_loops;
+  u32     kernel_threads;
+  int     workers_active;
+
+} resident_tune_t;
+
+typedef struct resident_ctx
+{
+  bool    enabled;
+
+  // the hashlist of the last job after hashes_init_stage2 (), before the potfile is applied
+
+  hashes_t             *hashes;
+  char                 *hashes_file;
+  resident_hashes_key_t hashes_key;
+
+  // the last autotune result of each device
+
+  resident_tune_t      *tunes_buf;
+  int                   tunes_cnt;
+
+} resident_ctx_t;
+
 typedef struct hashcat_ctx
 {
   brain_ctx_t           *brain_ctx;
@@ -3226,6 +3800,7 @@ typedef struct hashcat_ctx
   combinator_ctx_t      *combinator_ctx;
   cpt_ctx_t             *cpt_ctx;
   debugfile_ctx_t       *debugfile_ctx;
+  dedup_ctx_t           *dedup_ctx;
   dictstat_ctx_t        *dictstat_ctx;
   event_ctx_t           *event_ctx;
   folder_config_t       *folder_config;
@@ -3238,13 +3813,16 @@ typedef struct hashcat_ctx
   logfile_ctx_t         *logfile_ctx;
   loopback_ctx_t        *loopback_ctx;
   mask_ctx_t            *mask_ctx;
+  metrics_ctx_t         *metrics_ctx;
   module_ctx_t          *module_ctx;
   backend_ctx_t         *backend_ctx;
   outcheck_ctx_t        *outcheck_ctx;
   outfile_ctx_t         *outfile_ctx;
   pidfile_ctx_t         *pidfile_ctx;
   potfile_ctx_t         *potfile_ctx;
+  resident_ctx_t        *resident_ctx;
   restore_ctx_t         *restore_ctx;
+  startup_ctx_t         *startup_ctx;
   status_ctx_t          *status_ctx;
   straight_ctx_t        *straight_ctx;
   tuning_db_t           *tuning_db;
@@ -3264,6 +3842,93 @@ typedef struct thread_param
 
 } thread_param_t;
 
+typedef struct autodetect_thread_param
+{
+  hashcat_ctx_t *hashcat_ctx; // private copy, shares everything but hashconfig, hashes, module_ctx and user_options
+
+  const u32 *modes_buf;
+  int        modes_cnt;
+  int       *modes_pos;
+
+  // one entry per hash-mode in modes_buf, hash_name_buf[i] is set on match
+
+  char     **hash_name_buf;
+  u32       *hash_category_buf;
+
+  hc_thread_mutex_t *mux_pos;
+  hc_thread_mutex_t *mux_module;
+
+} autodetect_thread_param_t;
+
+typedef struct identify_mode
+{
+  hashcat_ctx_t  hashcat_ctx; // copy of the main context, pointing to the private parts below
+  hashconfig_t   hashconfig;
+  module_ctx_t   module_ctx;
+  user_options_t user_options;
+
+  const module_manifest_entry_t *manifest_entry;
+
+  u32    hlfmt;     // hashlist format as seen by this hash-mode
+  int    hlfmt_idx; // index into the per-line hash position cache
+
+  u64    lines_cnt;
+
+  HCFILE fp;        // --identify-split-dir
+  bool   fp_open;
+
+} identify_mode_t;
+
+typedef struct identify_thread_param
+{
+  identify_mode_t  *modes_buf;
+  int               modes_cnt;
+
+  identify_mode_t **hlfmts_buf; // one hash-mode per distinct hashlist format, see hlfmt_idx
+  int               hlfmts_cnt;
+
+  char *chunk_buf;
+  u64  *lines_off;
+  u32  *lines_len;
+  u32   lines_start;
+  u32   lines_end;
+
+  // pairs of line index and mode index, in line order
+
+  u32  *match_buf;
+  u64   match_cnt;
+  u64   match_avail;
+
+  void       *digest;
+  salt_t     *salt;
+  void       *esalt;
+  void       *hook_salt;
+  hashinfo_t *hash_info;
+
+} identify_thread_param_t;
+
+typedef struct daemon_request
+{
+  char    cmd[32];
+
+  int     argc;
+  char  **argv;
+
+  char   *line;
+
+} daemon_request_t;
+
+typedef struct daemon_job
+{
+  hashcat_ctx_t *hashcat_ctx;
+
+  hc_thread_mutex_t mux;   // guards rc and finished, the job thread sets them
+
+  int   rc;
+  bool  finished;
+
+} daemon_job_t;
+
 typedef struct hook_thread_param
 {
   int tid;
@@ -22,6 +22,7 @@ void get_next_word_std (char *buf, u64 sz, u64 *len, u64 *off);
 void get_next_word   (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, char **out_buf, u32 *out_len);
 int  load_segment    (hashcat_ctx_t *hashcat_ctx, HCFILE *fp);
 int  count_words     (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u64 *result);
+void wordlist_seek   (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, u64 *words_cur, const u64 words_off);
 
 int  wl_data_init    (hashcat_ctx_t *hashcat_ctx);
 void wl_data_destroy (hashcat_ctx_t *hashcat_ctx);
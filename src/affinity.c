@@ -7,6 +7,7 @@
 #include "types.h"
 #include "memory.h"
 #include "event.h"
+#include "filehandling.h"
 #include "affinity.h"
 
 #if defined (__APPLE__)
@@ -194,3 +195,304 @@ int set_cpu_affinity (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
   return 0;
   #endif
 }
+
+/**
+ * numa topology, as exported by linux in /sys/devices/system/node
+ * other platforms report zero nodes, which disables placement
+ */
+
+static int numa_parse_cpulist (const char *line, int **cpus_buf)
+{
+  // format is "0-15,32-47"
+
+  int cpus_cnt = 0;
+  int cpus_max = 0;
+
+  int *cpus = NULL;
+
+  const char *pos = line;
+
+  while (*pos)
+  {
+    char *end = NULL;
+
+    const long first = strtol (pos, &end, 10);
+
+    if (end == pos) break;
+
+    long last = first;
+
+    pos = end;
+
+    if (*pos == '-')
+    {
+      pos++;
+
+      last = strtol (pos, &end, 10);
+
+      if (end == pos) break;
+
+      pos = end;
+    }
+
+    for (long cpu = first; cpu <= last; cpu++)
+    {
+      if (cpus_cnt == cpus_max)
+      {
+        cpus_max += 64;
+
+        cpus = (int *) hcrealloc (cpus, cpus_cnt * sizeof (int), 64 * sizeof (int));
+      }
+
+      cpus[cpus_cnt++] = (int) cpu;
+    }
+
+    if (*pos != ',') break;
+
+    pos++;
+  }
+
+  *cpus_buf = cpus;
+
+  return cpus_cnt;
+}
+
+int numa_topology_init (numa_topology_t *numa_topology)
+{
+  memset (numa_topology, 0, sizeof (numa_topology_t));
+
+  #if defined (__linux__)
+
+  #define NUMA_NODES_MAX 1024
+
+  for (int node_id = 0; node_id < NUMA_NODES_MAX; node_id++)
+  {
+    char path[256];
+
+    snprintf (path, sizeof (path), "/sys/devices/system/node/node%d/cpulist", node_id);
+
+    HCFILE fp;
+
+    if (hc_fopen_raw (&fp, path, "rb") == false)
+    {
+      // node ids can have holes, but only after node0 exists
+
+      if (node_id == 0) break;
+
+      continue;
+    }
+
+    char line[4096] = { 0 };
+
+    const size_t nread = hc_fread (line, 1, sizeof (line) - 1, &fp);
+
+    hc_fclose (&fp);
+
+    line[nread] = 0;
+
+    int *cpus_buf = NULL;
+
+    const int cpus_cnt = numa_parse_cpulist (line, &cpus_buf);
+
+    // memory-only nodes (e.g. cxl or hbm) have an empty cpulist
+
+    if (cpus_cnt == 0)
+    {
+      hcfree (cpus_buf);
+
+      continue;
+    }
+
+    numa_topology->nodes_buf = (numa_node_t *) hcrealloc (numa_topology->nodes_buf, numa_topology->nodes_cnt * sizeof (numa_node_t), sizeof (numa_node_t));
+
+    numa_node_t *numa_node = &numa_topology->nodes_buf[numa_topology->nodes_cnt];
+
+    numa_node->node_id  = node_id;
+    numa_node->cpus_buf = cpus_buf;
+    numa_node->cpus_cnt = cpus_cnt;
+
+    numa_topology->nodes_cnt++;
+    numa_topology->cpus_cnt += cpus_cnt;
+  }
+
+  #undef NUMA_NODES_MAX
+
+  #endif
+
+  return 0;
+}
+
+void numa_topology_destroy (numa_topology_t *numa_topology)
+{
+  for (int node_idx = 0; node_idx < numa_topology->nodes_cnt; node_idx++)
+  {
+    hcfree (numa_topology->nodes_buf[node_idx].cpus_buf);
+  }
+
+  hcfree (numa_topology->nodes_buf);
+
+  memset (numa_topology, 0, sizeof (numa_topology_t));
+}
+
+int numa_node_for_unit (const numa_topology_t *numa_topology, const int unit_idx, const int units_cnt)
+{
+  if (numa_topology->nodes_cnt < 2) return -1;
+
+  if ((unit_idx < 0) || (units_cnt < 1)) return -1;
+
+  // units are spread over the nodes in proportion to their cpu count and in node order,
+  // so with one unit per cpu each node gets exactly as many units as it has cpus
+
+  const u64 pos = ((u64) (unit_idx % units_cnt) * (u64) numa_topology->cpus_cnt) / (u64) units_cnt;
+
+  u64 sum = 0;
+
+  for (int node_idx = 0; node_idx < numa_topology->nodes_cnt; node_idx++)
+  {
+    sum += numa_topology->nodes_buf[node_idx].cpus_cnt;
+
+    if (pos < sum) return node_idx;
+  }
+
+  return numa_topology->nodes_cnt - 1;
+}
+
+int numa_bind_thread (const numa_topology_t *numa_topology, const int node_idx)
+{
+  if ((node_idx < 0) || (node_idx >= numa_topology->nodes_cnt)) return 0;
+
+  #if defined (__linux__)
+
+  const numa_node_t *numa_node = &numa_topology->nodes_buf[node_idx];
+
+  cpu_set_t cpuset;
+
+  CPU_ZERO (&cpuset);
+
+  for (int cpus_idx = 0; cpus_idx < numa_node->cpus_cnt; cpus_idx++)
+  {
+    const int cpu = numa_node->cpus_buf[cpus_idx];
+
+    if (cpu < CPU_SETSIZE) CPU_SET (cpu, &cpuset);
+  }
+
+  if (pthread_setaffinity_np (pthread_self (), sizeof (cpu_set_t), &cpuset) != 0) return -1;
+
+  #endif
+
+  return 0;
+}
+
+/**
+ * node-local allocations
+ * the pages are mapped directly and get a preferred policy for the node before they are touched,
+ * so placement doesn't depend on which thread happens to write them first
+ */
+
+#define NUMA_ALLOC_ALIGN    64
+#define NUMA_HUGEPAGE_SIZE  (2 * 1024 * 1024)
+#define NUMA_NODEMASK_WORDS 16
+
+typedef struct numa_alloc
+{
+  void   *raw;
+  size_t  raw_size;
+  bool    is_mmap;
+
+} numa_alloc_t;
+
+void *hcmalloc_numa (const numa_topology_t *numa_topology, const size_t sz, const int node_idx, const bool hugepages)
+{
+  const size_t align = (hugepages == true) ? NUMA_HUGEPAGE_SIZE : NUMA_ALLOC_ALIGN;
+
+  // room for the header in front of the aligned block
+
+  const size_t head = (sizeof (numa_alloc_t) + NUMA_ALLOC_ALIGN - 1) & ~((size_t) NUMA_ALLOC_ALIGN - 1);
+
+  const size_t raw_size = sz + head + align;
+
+  void *raw     = NULL;
+  bool  is_mmap = false;
+
+  #if defined (__linux__)
+
+  const bool node_valid = (node_idx >= 0) && (node_idx < numa_topology->nodes_cnt);
+
+  if ((node_valid == true) || (hugepages == true))
+  {
+    raw = mmap (NULL, raw_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (raw == MAP_FAILED)
+    {
+      raw = NULL;
+    }
+    else
+    {
+      is_mmap = true;
+
+      #if defined (SYS_mbind)
+
+      // MPOL_PREFERRED, best effort: the kernel falls back to other nodes if this one is full
+
+      const int node_id = (node_valid == true) ? numa_topology->nodes_buf[node_idx].node_id : -1;
+
+      unsigned long nodemask[NUMA_NODEMASK_WORDS] = { 0 };
+
+      if ((node_id >= 0) && (node_id < (int) (NUMA_NODEMASK_WORDS * 8 * sizeof (unsigned long))))
+      {
+        nodemask[node_id / (8 * sizeof (unsigned long))] |= 1UL << (node_id % (8 * sizeof (unsigned long)));
+
+        syscall (SYS_mbind, raw, raw_size, 1, nodemask, (unsigned long) (NUMA_NODEMASK_WORDS * 8 * sizeof (unsigned long)) + 1, 0);
+      }
+
+      #endif
+
+      #if defined (MADV_HUGEPAGE)
+
+      if (hugepages == true) madvise (raw, raw_size, MADV_HUGEPAGE);
+
+      #endif
+    }
+  }
+
+  #endif
+
+  if (raw == NULL)
+  {
+    raw = malloc (raw_size);
+
+    if (raw == NULL) return NULL;
+
+    memset (raw, 0, raw_size);
+  }
+
+  const uintptr_t aligned_addr = ((uintptr_t) raw + head + align - 1) & ~((uintptr_t) align - 1);
+
+  numa_alloc_t *numa_alloc = (numa_alloc_t *) (aligned_addr - sizeof (numa_alloc_t));
+
+  numa_alloc->raw      = raw;
+  numa_alloc->raw_size = raw_size;
+  numa_alloc->is_mmap  = is_mmap;
+
+  return (void *) aligned_addr;
+}
+
+void hcfree_numa (void *ptr)
+{
+  if (ptr == NULL) return;
+
+  const numa_alloc_t *numa_alloc = (const numa_alloc_t *) ((uintptr_t) ptr - sizeof (numa_alloc_t));
+
+  #if defined (__linux__)
+
+  if (numa_alloc->is_mmap == true)
+  {
+    munmap (numa_alloc->raw, numa_alloc->raw_size);
+
+    return;
+  }
+
+  #endif
+
+  free (numa_alloc->raw);
+}
@@ -9,6 +9,10 @@
 #include "backend.h"
 #include "status.h"
 #include "shared.h"
+#include "thread.h"
+#include "timer.h"
+#include "hwmon.h"
+#include "resident.h"
 #include "autotune.h"
 
 int find_tuning_function (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED hc_device_param_t *device_param)
@@ -34,15 +38,11 @@ int find_tuning_function (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED hc_device_par
   return -1;
 }
 
-static double try_run (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kernel_accel, const u32 kernel_loops, const u32 kernel_threads)
+static u32 try_run_power (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kernel_accel, const u32 kernel_threads)
 {
   hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
   user_options_t *user_options = hashcat_ctx->user_options;
 
-  device_param->kernel_param.loop_pos = 0;
-  device_param->kernel_param.loop_cnt = kernel_loops; // not a bug, both need to be set
-  device_param->kernel_param.il_cnt   = kernel_loops; // because there's two variables for inner iters for slow and fast hashes
-
   const u32 hardware_power = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE)     ? 1 : device_param->device_processors)
                            * ((hashconfig->opts_type & OPTS_TYPE_THREAD_MULTI_DISABLE) ? 1 : kernel_threads);
 
@@ -52,14 +52,25 @@ static double try_run (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
   {
     hashes_t *hashes = hashcat_ctx->hashes;
 
-    const u32 salts_cnt = hashes->salts_cnt;
+    const u64 association_cnt = (u64) hashes->salts_cnt * user_options->association_width;
 
-    if (kernel_power_try > salts_cnt)
+    if (kernel_power_try > association_cnt)
     {
-      kernel_power_try = salts_cnt;
+      kernel_power_try = (u32) association_cnt;
     }
   }
 
+  return kernel_power_try;
+}
+
+static double try_run (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kernel_accel, const u32 kernel_loops, const u32 kernel_threads)
+{
+  device_param->kernel_param.loop_pos = 0;
+  device_param->kernel_param.loop_cnt = kernel_loops; // not a bug, both need to be set
+  device_param->kernel_param.il_cnt   = kernel_loops; // because there's two variables for inner iters for slow and fast hashes
+
+  const u32 kernel_power_try = try_run_power (hashcat_ctx, device_param, kernel_accel, kernel_threads);
+
   const u32 kernel_threads_sav = device_param->kernel_threads;
 
   device_param->kernel_threads = kernel_threads;
@@ -97,6 +108,148 @@ static double try_run_times (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
   return exec_msec_best;
 }
 
+static int64_t try_run_energy_get (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  hc_thread_mutex_lock (status_ctx->mux_hwmon);
+
+  const int64_t energy = hm_get_energy_with_devices_idx (hashcat_ctx, device_param->device_id);
+
+  hc_thread_mutex_unlock (status_ctx->mux_hwmon);
+
+  return energy;
+}
+
+// work per joule of a configuration, the energy counters are coarse so we need to run it for a while
+
+static double try_run_energy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kernel_accel, const u32 kernel_loops, const u32 kernel_threads)
+{
+  try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops, kernel_threads);
+
+  const int64_t energy_start = try_run_energy_get (hashcat_ctx, device_param);
+
+  if (energy_start == -1) return -1;
+
+  hc_timer_t timer;
+
+  hc_timer_set (&timer);
+
+  u64 runs = 0;
+
+  do
+  {
+    try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops, kernel_threads);
+
+    runs++;
+
+  } while (hc_timer_get (timer) < TUNE_ENERGY_MSEC);
+
+  const int64_t energy_stop = try_run_energy_get (hashcat_ctx, device_param);
+
+  if (energy_stop <= energy_start) return -1;
+
+  const double work = (double) runs * try_run_power (hashcat_ctx, device_param, kernel_accel, kernel_threads) * kernel_loops;
+
+  return work / ((double) (energy_stop - energy_start) / 1000000);
+}
+
+static int autotune_store (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kernel_accel, const u32 kernel_loops, const u32 kernel_threads)
+{
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+
+  // reset them fake words
+  // reset other buffers in case autotune cracked something
+
+  device_param->at_rc = -5;
+
+  if (device_param->is_cuda == true)
+  {
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_buf, device_param->size_pws) == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_plain_bufs, device_param->size_plains) == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_digests_shown, device_param->size_shown) == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_result, device_param->size_results) == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tmps, device_param->size_tmps) == -1) return -1;
+  }
+
+  if (device_param->is_hip == true)
+  {
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_buf, device_param->size_pws) == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_plain_bufs, device_param->size_plains) == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_digests_shown, device_param->size_shown) == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_result, device_param->size_results) == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_tmps, device_param->size_tmps) == -1) return -1;
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_buf, device_param->size_pws) == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_plain_bufs, device_param->size_plains) == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_digests_shown, device_param->size_shown) == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_result, device_param->size_results) == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_tmps, device_param->size_tmps) == -1) return -1;
+  }
+  #endif
+
+  if (device_param->is_opencl == true)
+  {
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_buf, device_param->size_pws) == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_plain_bufs, device_param->size_plains) == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_digests_shown, device_param->size_shown) == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_result, device_param->size_results) == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tmps, device_param->size_tmps) == -1) return -1;
+
+    device_param->at_rc = -6;
+
+    if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
+  }
+
+  if (device_param->is_native == true)
+  {
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_pws_buf, device_param->size_pws) == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_plain_bufs, device_param->size_plains) == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_digests_shown, device_param->size_shown) == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_result, device_param->size_results) == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_tmps, device_param->size_tmps) == -1) return -1;
+  }
+
+  // reset timer
+
+  device_param->exec_pos = 0;
+
+  memset (device_param->exec_msec,          0,          EXEC_CACHE * sizeof (double));
+  memset (device_param->exec_us_prev1,      0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev2,      0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev3,      0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev4,      0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev_init2, 0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev_loop2, 0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev_aux1,  0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev_aux2,  0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev_aux3,  0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev_aux4,  0, EXPECTED_ITERATIONS * sizeof (double));
+
+  // store
+
+  device_param->kernel_accel   = kernel_accel;
+  device_param->kernel_loops   = kernel_loops;
+  device_param->kernel_threads = kernel_threads;
+
+  const u32 hardware_power = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE)     ? 1 : device_param->device_processors)
+                           * ((hashconfig->opts_type & OPTS_TYPE_THREAD_MULTI_DISABLE) ? 1 : device_param->kernel_threads);
+
+  device_param->hardware_power = hardware_power;
+
+  const u32 kernel_power = device_param->hardware_power * device_param->kernel_accel;
+
+  device_param->kernel_power = kernel_power;
+
+  //printf ("Final: %d %d %d %d %d\n", kernel_accel, kernel_loops, kernel_threads, hardware_power, kernel_power);
+
+  return 0;
+}
+
 static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
   const hashes_t       *hashes       = hashcat_ctx->hashes;
@@ -223,11 +376,11 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
     {
       hashes_t *hashes = hashcat_ctx->hashes;
 
-      const u32 salts_cnt = hashes->salts_cnt;
+      const u64 association_cnt = (u64) hashes->salts_cnt * user_options->association_width;
 
-      if (kernel_power_max > salts_cnt)
+      if (kernel_power_max > association_cnt)
       {
-        kernel_power_max = salts_cnt;
+        kernel_power_max = (u32) association_cnt;
       }
     }
 
@@ -255,6 +408,11 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
       if (run_opencl_kernel_atinit (hashcat_ctx, device_param, device_param->opencl_d_pws_buf, kernel_power_max) == -1) return -1;
     }
 
+    if (device_param->is_native == true)
+    {
+      if (run_native_kernel_atinit (hashcat_ctx, device_param, device_param->native_d_pws_buf, kernel_power_max) == -1) return -1;
+    }
+
     if (user_options->slow_candidates == true)
     {
     }
@@ -287,6 +445,11 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
           {
             if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_rules, device_param->opencl_d_rules_c, 0, 0, MIN (kernel_loops_max, KERNEL_RULES) * sizeof (kernel_rule_t), 0, NULL, NULL) == -1) return -1;
           }
+
+          if (device_param->is_native == true)
+          {
+            if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_rules_c, device_param->native_d_rules, MIN (kernel_loops_max, KERNEL_RULES) * sizeof (kernel_rule_t)) == -1) return -1;
+          }
         }
       }
     }
@@ -611,89 +774,68 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
         }
       }
     }
-  }
-
-  // reset them fake words
-  // reset other buffers in case autotune cracked something
 
-  device_param->at_rc = -5;
+    // the values so far give the highest speed, on cpus we can trade some of it for less energy.
+    // the native backend runs one thread per cpu, so there the thread count is the number of busy cpus,
+    // otherwise it's kernel-threads
 
-  if (device_param->is_cuda == true)
-  {
-    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_buf, device_param->size_pws) == -1) return -1;
-    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_plain_bufs, device_param->size_plains) == -1) return -1;
-    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_digests_shown, device_param->size_shown) == -1) return -1;
-    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_result, device_param->size_results) == -1) return -1;
-    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tmps, device_param->size_tmps) == -1) return -1;
-  }
+    if ((user_options->tune_energy == true) && (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU))
+    {
+      double wpj_best = try_run_energy (hashcat_ctx, device_param, kernel_accel, kernel_loops, kernel_threads);
 
-  if (device_param->is_hip == true)
-  {
-    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_buf, device_param->size_pws) == -1) return -1;
-    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_plain_bufs, device_param->size_plains) == -1) return -1;
-    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_digests_shown, device_param->size_shown) == -1) return -1;
-    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_result, device_param->size_results) == -1) return -1;
-    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_tmps, device_param->size_tmps) == -1) return -1;
-  }
+      if (wpj_best > 0)
+      {
+        const u32 threads_max = (device_param->is_native == true) ? (u32) device_param->native_pool->workers_cnt : kernel_threads;
+        const u32 threads_min = (device_param->is_native == true) ? 1 : kernel_threads_min;
 
-  #if defined (__APPLE__)
-  if (device_param->is_metal == true)
-  {
-    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_buf, device_param->size_pws) == -1) return -1;
-    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_plain_bufs, device_param->size_plains) == -1) return -1;
-    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_digests_shown, device_param->size_shown) == -1) return -1;
-    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_result, device_param->size_results) == -1) return -1;
-    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_tmps, device_param->size_tmps) == -1) return -1;
-  }
-  #endif
+        u32 threads_best = threads_max;
+        u32 accel_best   = kernel_accel;
 
-  if (device_param->is_opencl == true)
-  {
-    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_buf, device_param->size_pws) == -1) return -1;
-    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_plain_bufs, device_param->size_plains) == -1) return -1;
-    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_digests_shown, device_param->size_shown) == -1) return -1;
-    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_result, device_param->size_results) == -1) return -1;
-    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tmps, device_param->size_tmps) == -1) return -1;
+        for (int threads_step = 0; threads_step < TUNE_ENERGY_THREADS_STEPS; threads_step++)
+        {
+          const u32 threads_test = (threads_max * (TUNE_ENERGY_THREADS_STEPS - threads_step)) / TUNE_ENERGY_THREADS_STEPS;
 
-    device_param->at_rc = -6;
+          if (threads_test < threads_min) break;
 
-    if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
-  }
+          if (device_param->is_native == true) device_param->native_pool->workers_active = threads_test;
 
-  // reset timer
+          const u32 kernel_threads_test = (device_param->is_native == true) ? kernel_threads : threads_test;
 
-  device_param->exec_pos = 0;
+          for (u32 accel_div = 1; accel_div <= TUNE_ENERGY_ACCEL_DIV_MAX; accel_div <<= 1)
+          {
+            if ((threads_step == 0) && (accel_div == 1)) continue; // that's the baseline
 
-  memset (device_param->exec_msec,          0,          EXEC_CACHE * sizeof (double));
-  memset (device_param->exec_us_prev1,      0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev2,      0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev3,      0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev4,      0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev_init2, 0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev_loop2, 0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev_aux1,  0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev_aux2,  0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev_aux3,  0, EXPECTED_ITERATIONS * sizeof (double));
-  memset (device_param->exec_us_prev_aux4,  0, EXPECTED_ITERATIONS * sizeof (double));
+            const u32 kernel_accel_test = kernel_accel / accel_div;
 
-  // store
+            if (kernel_accel_test < kernel_accel_min) break;
 
-  device_param->kernel_accel   = kernel_accel;
-  device_param->kernel_loops   = kernel_loops;
-  device_param->kernel_threads = kernel_threads;
+            const double wpj = try_run_energy (hashcat_ctx, device_param, kernel_accel_test, kernel_loops, kernel_threads_test);
 
-  const u32 hardware_power = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE)     ? 1 : device_param->device_processors)
-                           * ((hashconfig->opts_type & OPTS_TYPE_THREAD_MULTI_DISABLE) ? 1 : device_param->kernel_threads);
+            // counter noise is in the low percent range
 
-  device_param->hardware_power = hardware_power;
+            if (wpj < (wpj_best * 1.02)) continue;
 
-  const u32 kernel_power = device_param->hardware_power * device_param->kernel_accel;
+            wpj_best     = wpj;
+            threads_best = threads_test;
+            accel_best   = kernel_accel_test;
+          }
+        }
 
-  device_param->kernel_power = kernel_power;
+        kernel_accel = accel_best;
 
-  //printf ("Final: %d %d %d %d %d\n", kernel_accel, kernel_loops, kernel_threads, hardware_power, kernel_power);
+        if (device_param->is_native == true)
+        {
+          device_param->native_pool->workers_active = (threads_best < threads_max) ? threads_best : 0;
+        }
+        else
+        {
+          kernel_threads = threads_best;
+        }
+      }
+    }
+  }
 
-  return 0;
+  return autotune_store (hashcat_ctx, device_param, kernel_accel, kernel_loops, kernel_threads);
 }
 
 HC_API_CALL void *thread_autotune (void *p)
@@ -726,11 +868,26 @@ HC_API_CALL void *thread_autotune (void *p)
   }
 
   // check for autotune failure
+  // a daemon job reuses the result of its previous job if nothing autotune () depends on changed, see resident.c
 
-  if (autotune (hashcat_ctx, device_param) == 0)
+  u32 kernel_accel   = 0;
+  u32 kernel_loops   = 0;
+  u32 kernel_threads = 0;
+
+  if (resident_tune_load (hashcat_ctx, device_param, &kernel_accel, &kernel_loops, &kernel_threads) == true)
+  {
+    if (autotune_store (hashcat_ctx, device_param, kernel_accel, kernel_loops, kernel_threads) == 0)
+    {
+      device_param->at_status = AT_STATUS_PASSED;
+      device_param->at_rc = 0;
+    }
+  }
+  else if (autotune (hashcat_ctx, device_param) == 0)
   {
     device_param->at_status = AT_STATUS_PASSED;
     device_param->at_rc = 0;
+
+    resident_tune_store (hashcat_ctx, device_param);
   }
 
   if (device_param->is_cuda == true)
@@ -14,10 +14,13 @@
 #include "rp_cpu.h"
 #include "mpsp.h"
 #include "convert.h"
+#include "combinator.h"
+#include "dedup.h"
 #include "stdout.h"
 #include "filehandling.h"
 #include "wordlist.h"
 #include "shared.h"
+#include "startup.h"
 #include "hashes.h"
 #include "emu_inc_hash_md5.h"
 #include "event.h"
@@ -26,6 +29,7 @@
 #include "terminal.h"
 #include "hwmon.h"
 #include "autotune.h"
+#include "affinity.h"
 
 #if defined (__linux__)
 static const char *const  dri_card0_path = "/dev/dri/card0";
@@ -82,6 +86,13 @@ static bool is_same_device (const hc_device_param_t *src, const hc_device_param_
   }
   #endif
 
+  // The native backend runs on the host CPU, so it can only be an alias of an OpenCL CPU device
+
+  if ((src->is_native == true) || (dst->is_native == true))
+  {
+    if (src->opencl_device_type != dst->opencl_device_type) return false;
+  }
+
   // But OpenCL can have aliases
 
   if ((src->is_opencl == true) && (dst->is_opencl == true))
@@ -217,6 +228,30 @@ static CUfunction cuda_function_with_id (hc_device_param_t *device_param, const
   return NULL;
 }
 
+static native_function_t *native_function_with_id (hc_device_param_t *device_param, const int kern_run)
+{
+  switch (kern_run)
+  {
+    case KERN_RUN_1:      return &device_param->native_function1;       break;
+    case KERN_RUN_12:     return &device_param->native_function12;      break;
+    case KERN_RUN_2P:     return &device_param->native_function2p;      break;
+    case KERN_RUN_2:      return &device_param->native_function2;       break;
+    case KERN_RUN_2E:     return &device_param->native_function2e;      break;
+    case KERN_RUN_23:     return &device_param->native_function23;      break;
+    case KERN_RUN_3:      return &device_param->native_function3;       break;
+    case KERN_RUN_4:      return &device_param->native_function4;       break;
+    case KERN_RUN_INIT2:  return &device_param->native_function_init2;  break;
+    case KERN_RUN_LOOP2P: return &device_param->native_function_loop2p; break;
+    case KERN_RUN_LOOP2:  return &device_param->native_function_loop2;  break;
+    case KERN_RUN_AUX1:   return &device_param->native_function_aux1;   break;
+    case KERN_RUN_AUX2:   return &device_param->native_function_aux2;   break;
+    case KERN_RUN_AUX3:   return &device_param->native_function_aux3;   break;
+    case KERN_RUN_AUX4:   return &device_param->native_function_aux4;   break;
+  }
+
+  return NULL;
+}
+
 #if defined (__APPLE__)
 int metal_query_max_local_size_bytes (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
@@ -409,9 +444,13 @@ static int backend_ctx_find_alias_devices (hashcat_ctx_t *hashcat_ctx)
       if (alias_device->is_metal == true) continue;
       #endif
 
+      // this lets the native backend survive over OpenCL, it is only enabled on request
+
+      if (alias_device->is_native == true) continue;
+
       // this lets native OpenCL runtime survive over generic OpenCL runtime
 
-      if (alias_device->opencl_device_type & CL_DEVICE_TYPE_CPU)
+      if ((alias_device->opencl_device_type & CL_DEVICE_TYPE_CPU) && (backend_device->is_native == false))
       {
         if (alias_device->opencl_platform_vendor_id == alias_device->opencl_device_vendor_id) continue;
       }
@@ -442,6 +481,7 @@ static bool is_same_device_type (const hc_device_param_t *src, const hc_device_p
   if (src->is_metal  != dst->is_metal)  return false;
   #endif
   if (src->is_opencl != dst->is_opencl) return false;
+  if (src->is_native != dst->is_native) return false;
 
   if (strcmp (src->device_name, dst->device_name) != 0) return false;
 
@@ -1064,6 +1104,11 @@ int gidd_to_pw_t (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, c
     if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_idx, CL_TRUE, gidd * sizeof (pw_idx_t), sizeof (pw_idx_t), &pw_idx, 0, NULL, NULL) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    if (hc_nativeMemcpyDtoH (hashcat_ctx, &pw_idx, (u8 *) device_param->native_d_pws_idx + (gidd * sizeof (pw_idx_t)), sizeof (pw_idx_t)) == -1) return -1;
+  }
+
   const u32 off = pw_idx.off;
   const u32 cnt = pw_idx.cnt;
   const u32 len = pw_idx.len;
@@ -1096,6 +1141,11 @@ int gidd_to_pw_t (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, c
       /* blocking */
       if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_comp_buf, CL_TRUE, off * sizeof (u32), cnt * sizeof (u32), pw->i, 0, NULL, NULL) == -1) return -1;
     }
+
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemcpyDtoH (hashcat_ctx, pw->i, (u8 *) device_param->native_d_pws_comp_buf + (off * sizeof (u32)), cnt * sizeof (u32)) == -1) return -1;
+    }
   }
 
   for (u32 i = cnt; i < 64; i++)
@@ -1148,6 +1198,11 @@ int copy_pws_idx (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, u
     if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_idx, CL_TRUE, gidd * sizeof (pw_idx_t), (cnt * sizeof (pw_idx_t)), dest, 0, NULL, NULL) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    if (hc_nativeMemcpyDtoH (hashcat_ctx, dest, (u8 *) device_param->native_d_pws_idx + (gidd * sizeof (pw_idx_t)), (cnt * sizeof (pw_idx_t))) == -1) return -1;
+  }
+
   return 0;
 }
 
@@ -1186,9 +1241,79 @@ int copy_pws_comp (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
     if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_comp_buf, CL_TRUE, off * sizeof (u32), cnt * sizeof (u32), dest, 0, NULL, NULL) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    if (hc_nativeMemcpyDtoH (hashcat_ctx, dest, (u8 *) device_param->native_d_pws_comp_buf + (off * sizeof (u32)), cnt * sizeof (u32)) == -1) return -1;
+  }
+
+  return 0;
+}
+
+static int salt_pack_copy_pws (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 dst, const u64 src, const u64 cnt)
+{
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuMemcpyDtoD (hashcat_ctx, device_param->cuda_d_pws_buf + (dst * sizeof (pw_t)), device_param->cuda_d_pws_buf + (src * sizeof (pw_t)), cnt * sizeof (pw_t)) == -1) return -1;
+  }
+
+  if (device_param->is_hip == true)
+  {
+    if (hc_hipMemcpyDtoD (hashcat_ctx, device_param->hip_d_pws_buf + (dst * sizeof (pw_t)), device_param->hip_d_pws_buf + (src * sizeof (pw_t)), cnt * sizeof (pw_t)) == -1) return -1;
+  }
+
+  if (device_param->is_opencl == true)
+  {
+    if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_buf, device_param->opencl_d_pws_buf, src * sizeof (pw_t), dst * sizeof (pw_t), cnt * sizeof (pw_t), 0, NULL, NULL) == -1) return -1;
+  }
+
+  if (device_param->is_native == true)
+  {
+    if (hc_nativeMemcpyDtoD (hashcat_ctx, (u8 *) device_param->native_d_pws_buf + (dst * sizeof (pw_t)), (u8 *) device_param->native_d_pws_buf + (src * sizeof (pw_t)), cnt * sizeof (pw_t)) == -1) return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * --salt-pack: the candidates [0, pws_cnt) of pws_buf are replicated into salt_pack_cnt slots of salt_pack_stride entries,
+ * the stride is rounded up to the thread count so that no work-group spans two salts. the padding repeats the candidates,
+ * so entry gid always holds candidate (gid % stride) % pws_cnt, see salt_pack_gidvid(). the filled part is doubled with
+ * each copy, so source and destination never overlap.
+ */
+
+static int salt_pack_replicate (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt)
+{
+  const u64 stride = device_param->kernel_param.salt_pack_stride;
+  const u64 total  = stride * device_param->salt_pack_cnt;
+
+  for (u64 done = pws_cnt; done < stride;)
+  {
+    const u64 cnt = MIN (done, stride - done);
+
+    if (salt_pack_copy_pws (hashcat_ctx, device_param, done, 0, cnt) == -1) return -1;
+
+    done += cnt;
+  }
+
+  for (u64 done = stride; done < total;)
+  {
+    const u64 cnt = MIN (done, total - done);
+
+    if (salt_pack_copy_pws (hashcat_ctx, device_param, done, 0, cnt) == -1) return -1;
+
+    done += cnt;
+  }
+
   return 0;
 }
 
+u64 salt_pack_gidvid (const hc_device_param_t *device_param, const u64 gidvid)
+{
+  if (device_param->salt_pack_cnt < 2) return gidvid;
+
+  return (gidvid % device_param->kernel_param.salt_pack_stride) % device_param->salt_pack_pws;
+}
+
 int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 highest_pw_len, const u64 pws_pos, const u64 pws_cnt, const u32 fast_iteration, const u32 salt_pos, const bool is_autotune)
 {
   bridge_ctx_t   *bridge_ctx   = hashcat_ctx->bridge_ctx;
@@ -1238,6 +1363,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
             if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tm_c, size_tm) == -1) return -1;
           }
 
+          if (device_param->is_native == true)
+          {
+            if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_tm_c, size_tm) == -1) return -1;
+          }
+
           if (run_kernel_tm (hashcat_ctx, device_param) == -1) return -1;
 
           if (device_param->is_cuda == true)
@@ -1263,6 +1393,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
             if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
           }
+
+          if (device_param->is_native == true)
+          {
+            if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_bfs_c, device_param->native_d_tm_c, size_tm) == -1) return -1;
+          }
         }
       }
     }
@@ -1348,6 +1483,14 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
         CLEAN_HOOK_DATA
     */
 
+    // with --salt-pack, run_cracker() hands over several salts at once and the amplified
+    // candidates are replicated into one slot per salt, see salt_pack_replicate()
+
+    const u32 salt_pack_cnt = MAX (device_param->salt_pack_cnt, 1);
+
+    const u64 pws_cnt_launch = (salt_pack_cnt > 1) ? device_param->kernel_param.salt_pack_stride * salt_pack_cnt : pws_cnt;
+    const u64 pws_cnt_salts  = pws_cnt * salt_pack_cnt;
+
     if (true)
     {
       if (device_param->is_cuda == true)
@@ -1372,6 +1515,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
         if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_amp_buf, device_param->opencl_d_pws_buf, 0, 0, pws_cnt * sizeof (pw_t), 0, NULL, NULL) == -1) return -1;
       }
 
+      if (device_param->is_native == true)
+      {
+        if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_pws_buf, device_param->native_d_pws_amp_buf, pws_cnt * sizeof (pw_t)) == -1) return -1;
+      }
+
       if (user_options->slow_candidates == true)
       {
       }
@@ -1403,16 +1551,26 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
         {
           if (run_opencl_kernel_utf8toutf16le (hashcat_ctx, device_param, device_param->opencl_d_pws_buf, pws_cnt) == -1) return -1;
         }
+
+        if (device_param->is_native == true)
+        {
+          if (run_native_kernel_utf8toutf16le (hashcat_ctx, device_param, device_param->native_d_pws_buf, pws_cnt) == -1) return -1;
+        }
+      }
+
+      if (salt_pack_cnt > 1)
+      {
+        if (salt_pack_replicate (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
       }
 
       if (hashconfig->opts_type & OPTS_TYPE_INIT)
       {
-        if (run_kernel (hashcat_ctx, device_param, KERN_RUN_1, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+        if (run_kernel (hashcat_ctx, device_param, KERN_RUN_1, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
       }
 
       if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
       {
-        if (run_kernel (hashcat_ctx, device_param, KERN_RUN_12, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+        if (run_kernel (hashcat_ctx, device_param, KERN_RUN_12, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
 
         if (device_param->is_cuda == true)
         {
@@ -1441,6 +1599,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
           if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, pws_cnt * hashconfig->hook_size, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
         }
 
+        if (device_param->is_native == true)
+        {
+          if (hc_nativeMemcpyDtoH (hashcat_ctx, device_param->hooks_buf, device_param->native_d_hooks, pws_cnt * hashconfig->hook_size) == -1) return -1;
+        }
+
         const int hook_threads = (int) user_options->hook_threads;
 
         hook_thread_param_t *hook_threads_param = (hook_thread_param_t *) hcmalloc (hook_threads * sizeof (hook_thread_param_t));
@@ -1494,6 +1657,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
         {
           if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, pws_cnt * hashconfig->hook_size, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
         }
+
+        if (device_param->is_native == true)
+        {
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_hooks, device_param->hooks_buf, pws_cnt * hashconfig->hook_size) == -1) return -1;
+        }
       }
     }
 
@@ -1507,7 +1675,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
         if (hashconfig->opts_type & OPTS_TYPE_LOOP_PREPARE)
         {
-          if (run_kernel (hashcat_ctx, device_param, KERN_RUN_2P, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+          if (run_kernel (hashcat_ctx, device_param, KERN_RUN_2P, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
         }
 
         if (true)
@@ -1527,12 +1695,12 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
             if (hashconfig->opts_type & OPTS_TYPE_LOOP)
             {
-              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_2, pws_pos, pws_cnt, true, slow_iteration, is_autotune) == -1) return -1;
+              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_2, pws_pos, pws_cnt_launch, true, slow_iteration, is_autotune) == -1) return -1;
             }
 
             if (hashconfig->opts_type & OPTS_TYPE_LOOP_EXTENDED)
             {
-              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_2E, pws_pos, pws_cnt, true, slow_iteration, is_autotune) == -1) return -1;
+              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_2E, pws_pos, pws_cnt_launch, true, slow_iteration, is_autotune) == -1) return -1;
             }
 
             //bug?
@@ -1548,7 +1716,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
             const double iter_part = (double) ((iter * salt_repeat) + loop_pos + loop_left) / (double) (iter1r + iter2r);
 
-            const u64 perf_sum_all = (u64) (pws_cnt * iter_part);
+            const u64 perf_sum_all = (u64) (pws_cnt_salts * iter_part);
 
             double speed_msec = hc_timer_get (device_param->timer_speed);
 
@@ -1602,6 +1770,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
               if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, pws_cnt * hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
             }
 
+            if (device_param->is_native == true)
+            {
+              if (hc_nativeMemcpyDtoH (hashcat_ctx, device_param->h_tmps, device_param->native_d_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+            }
+
             if (bridge_ctx->launch_loop (bridge_ctx->platform_context, device_param, hashconfig, hashes, salt_pos, pws_cnt) == false) return -1;
 
             if (device_param->is_cuda == true)
@@ -1631,6 +1804,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
               if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, pws_cnt * hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
             }
 
+            if (device_param->is_native == true)
+            {
+              if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_tmps, device_param->h_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+            }
+
             //bug?
             //while (status_ctx->run_thread_level2 == false) break;
             if (status_ctx->run_thread_level2 == false) break;
@@ -1639,7 +1817,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
              * speed
              */
 
-            const u64 perf_sum_all = (u64) (pws_cnt);
+            const u64 perf_sum_all = (u64) (pws_cnt_salts);
 
             double speed_msec = hc_timer_get (device_param->timer_speed);
 
@@ -1664,7 +1842,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
           if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
           {
-            if (run_kernel (hashcat_ctx, device_param, KERN_RUN_23, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+            if (run_kernel (hashcat_ctx, device_param, KERN_RUN_23, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
 
             if (device_param->is_cuda == true)
             {
@@ -1693,6 +1871,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
               if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, pws_cnt * hashconfig->hook_size, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
             }
 
+            if (device_param->is_native == true)
+            {
+              if (hc_nativeMemcpyDtoH (hashcat_ctx, device_param->hooks_buf, device_param->native_d_hooks, pws_cnt * hashconfig->hook_size) == -1) return -1;
+            }
+
             const int hook_threads = (int) user_options->hook_threads;
 
             hook_thread_param_t *hook_threads_param = (hook_thread_param_t *) hcmalloc (hook_threads * sizeof (hook_thread_param_t));
@@ -1746,6 +1929,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
             {
               if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, pws_cnt * hashconfig->hook_size, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
             }
+
+            if (device_param->is_native == true)
+            {
+              if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_hooks, device_param->hooks_buf, pws_cnt * hashconfig->hook_size) == -1) return -1;
+            }
           }
         }
       }
@@ -1756,7 +1944,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
     if (hashconfig->opts_type & OPTS_TYPE_INIT2)
     {
-      if (run_kernel (hashcat_ctx, device_param, KERN_RUN_INIT2, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+      if (run_kernel (hashcat_ctx, device_param, KERN_RUN_INIT2, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
     }
 
     if (true)
@@ -1769,7 +1957,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
         if (hashconfig->opts_type & OPTS_TYPE_LOOP2_PREPARE)
         {
-          if (run_kernel (hashcat_ctx, device_param, KERN_RUN_LOOP2P, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+          if (run_kernel (hashcat_ctx, device_param, KERN_RUN_LOOP2P, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
         }
 
         if (hashconfig->opts_type & OPTS_TYPE_LOOP2)
@@ -1787,7 +1975,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
             device_param->kernel_param.loop_pos = loop_pos;
             device_param->kernel_param.loop_cnt = loop_left;
 
-            if (run_kernel (hashcat_ctx, device_param, KERN_RUN_LOOP2, pws_pos, pws_cnt, true, slow_iteration, is_autotune) == -1) return -1;
+            if (run_kernel (hashcat_ctx, device_param, KERN_RUN_LOOP2, pws_pos, pws_cnt_launch, true, slow_iteration, is_autotune) == -1) return -1;
 
             //bug?
             //while (status_ctx->run_thread_level2 == false) break;
@@ -1802,7 +1990,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
             const double iter_part = (double) (iter1r + (iter * salt_repeat) + loop_pos + loop_left) / (double) (iter1r + iter2r);
 
-            const u64 perf_sum_all = (u64) (pws_cnt * iter_part);
+            const u64 perf_sum_all = (u64) (pws_cnt_salts * iter_part);
 
             double speed_msec = hc_timer_get (device_param->timer_speed);
 
@@ -1842,6 +2030,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
               if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, pws_cnt * hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
             }
 
+            if (device_param->is_native == true)
+            {
+              if (hc_nativeMemcpyDtoH (hashcat_ctx, device_param->h_tmps, device_param->native_d_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+            }
+
             if (bridge_ctx->launch_loop2 (bridge_ctx->platform_context, device_param, hashconfig, hashes, salt_pos, pws_cnt) == false) return -1;
 
             if (device_param->is_cuda == true)
@@ -1870,6 +2063,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
               /* blocking */
               if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, pws_cnt * hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
             }
+
+            if (device_param->is_native == true)
+            {
+              if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_tmps, device_param->h_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+            }
           }
         }
       }
@@ -1895,7 +2093,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
             if (hashconfig->opts_type & OPTS_TYPE_AUX1)
             {
-              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_AUX1, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_AUX1, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
 
               if (status_ctx->run_thread_level2 == false) break;
 
@@ -1904,7 +2102,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
             if (hashconfig->opts_type & OPTS_TYPE_AUX2)
             {
-              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_AUX2, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_AUX2, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
 
               if (status_ctx->run_thread_level2 == false) break;
 
@@ -1913,7 +2111,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
             if (hashconfig->opts_type & OPTS_TYPE_AUX3)
             {
-              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_AUX3, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_AUX3, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
 
               if (status_ctx->run_thread_level2 == false) break;
 
@@ -1922,7 +2120,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
             if (hashconfig->opts_type & OPTS_TYPE_AUX4)
             {
-              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_AUX4, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+              if (run_kernel (hashcat_ctx, device_param, KERN_RUN_AUX4, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
 
               if (status_ctx->run_thread_level2 == false) break;
 
@@ -1933,7 +2131,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
             {
               if (hashconfig->opts_type & OPTS_TYPE_COMP)
               {
-                if (run_kernel (hashcat_ctx, device_param, KERN_RUN_3, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+                if (run_kernel (hashcat_ctx, device_param, KERN_RUN_3, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
               }
 
               if (status_ctx->run_thread_level2 == false) break;
@@ -1961,7 +2159,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
       {
         if (hashconfig->opts_type & OPTS_TYPE_COMP)
         {
-          if (run_kernel (hashcat_ctx, device_param, KERN_RUN_3, pws_pos, pws_cnt, false, 0, is_autotune) == -1) return -1;
+          if (run_kernel (hashcat_ctx, device_param, KERN_RUN_3, pws_pos, pws_cnt_launch, false, 0, is_autotune) == -1) return -1;
         }
       }
     }
@@ -2009,6 +2207,11 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
       {
         if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_hooks, pws_cnt * hashconfig->hook_size) == -1) return -1;
       }
+
+      if (device_param->is_native == true)
+      {
+        if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_hooks, pws_cnt * hashconfig->hook_size) == -1) return -1;
+      }
     }
   }
 
@@ -2516,6 +2719,49 @@ int run_opencl_kernel_bzero (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
   return 0;
 }
 
+int run_native_kernel_atinit (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void *buf, const u64 num)
+{
+  u64 args[NATIVE_ARGS_MAX] = { 0 };
+
+  if (hc_nativeSetKernelArg (hashcat_ctx, args, 0, sizeof (void *), &buf) == -1) return -1;
+  if (hc_nativeSetKernelArg (hashcat_ctx, args, 1, sizeof (u64),    &num) == -1) return -1;
+
+  return hc_nativeLaunchKernel (hashcat_ctx, device_param->native_pool, &device_param->native_function_atinit, args, num);
+}
+
+int run_native_kernel_utf8toutf16le (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void *buf, const u64 num)
+{
+  u64 args[NATIVE_ARGS_MAX] = { 0 };
+
+  if (hc_nativeSetKernelArg (hashcat_ctx, args, 0, sizeof (void *), &buf) == -1) return -1;
+  if (hc_nativeSetKernelArg (hashcat_ctx, args, 1, sizeof (u64),    &num) == -1) return -1;
+
+  return hc_nativeLaunchKernel (hashcat_ctx, device_param->native_pool, &device_param->native_function_utf8toutf16le, args, num);
+}
+
+int run_native_kernel_memset (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED hc_device_param_t *device_param, void *buf, const u64 offset, const u8 value, const u64 size)
+{
+  return hc_nativeMemsetD8 (hashcat_ctx, (u8 *) buf + offset, value, size);
+}
+
+int run_native_kernel_memset32 (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED hc_device_param_t *device_param, void *buf, const u64 offset, const u32 value, const u64 size)
+{
+  /* check that the size is multiple of element size */
+  if (size % 4 != 0)
+  {
+    return -1;
+  }
+
+  return hc_nativeMemsetD32 (hashcat_ctx, (u8 *) buf + offset, value, size / 4);
+}
+
+int run_native_kernel_bzero (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED hc_device_param_t *device_param, void *buf, const u64 size)
+{
+  // the buffer is host memory, a plain memset beats waking up the pool for gpu_bzero
+
+  return hc_nativeMemsetD8 (hashcat_ctx, buf, 0, size);
+}
+
 int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u64 pws_pos, const u64 num, const u32 event_update, const u32 iteration, const bool is_autotune)
 {
   const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
@@ -3249,6 +3495,46 @@ int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, con
     if (hc_clReleaseEvent (hashcat_ctx, opencl_event) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    const native_function_t *native_function = native_function_with_id (device_param, kern_run);
+
+    if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_kernel_param, &device_param->kernel_param, device_param->size_kernel_params) == -1) return -1;
+
+    u64 native_args[NATIVE_ARGS_MAX] = { 0 };
+
+    for (u32 i = 0; i <= 24; i++)
+    {
+      if (hc_nativeSetKernelArg (hashcat_ctx, native_args, i, sizeof (void *), device_param->kernel_params[i]) == -1) return -1;
+    }
+
+    // work-groups are of size 1 and the vector width is 1, so there is exactly one work-item per password
+
+    hc_timer_t timer;
+
+    hc_timer_set (&timer);
+
+    if (hc_nativeLaunchKernel (hashcat_ctx, device_param->native_pool, native_function, native_args, num_elements) == -1) return -1;
+
+    const double exec_ms = hc_timer_get (timer);
+
+    if (event_update)
+    {
+      u32 exec_pos = device_param->exec_pos;
+
+      device_param->exec_msec[exec_pos] = exec_ms;
+
+      exec_pos++;
+
+      if (exec_pos == EXEC_CACHE)
+      {
+        exec_pos = 0;
+      }
+
+      device_param->exec_pos = exec_pos;
+    }
+  }
+
   return 0;
 }
 
@@ -3441,6 +3727,47 @@ int run_kernel_mp (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
     if (hc_clEnqueueNDRangeKernel (hashcat_ctx, device_param->opencl_command_queue, opencl_kernel, 1, NULL, global_work_size, local_work_size, 0, NULL, NULL) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    const native_function_t *native_function = NULL;
+
+    void **native_params = NULL;
+
+    u32 arg_last = 8;
+
+    switch (kern_run)
+    {
+      case KERN_RUN_MP:   native_function = &device_param->native_function_mp;
+                          native_params   = device_param->kernel_params_mp;
+                          break;
+      case KERN_RUN_MP_R: native_function = &device_param->native_function_mp_r;
+                          native_params   = device_param->kernel_params_mp_r;
+                          break;
+      case KERN_RUN_MP_L: native_function = &device_param->native_function_mp_l;
+                          native_params   = device_param->kernel_params_mp_l;
+                          arg_last        = 9;
+                          break;
+    }
+
+    u64 native_args[NATIVE_ARGS_MAX] = { 0 };
+
+    for (u32 i = 0; i < 3; i++)
+    {
+      if (hc_nativeSetKernelArg (hashcat_ctx, native_args, i, sizeof (void *), native_params[i]) == -1) return -1;
+    }
+
+    if (hc_nativeSetKernelArg (hashcat_ctx, native_args, 3, sizeof (u64), native_params[3]) == -1) return -1;
+
+    for (u32 i = 4; i < arg_last; i++)
+    {
+      if (hc_nativeSetKernelArg (hashcat_ctx, native_args, i, sizeof (u32), native_params[i]) == -1) return -1;
+    }
+
+    if (hc_nativeSetKernelArg (hashcat_ctx, native_args, arg_last, sizeof (u64), native_params[arg_last]) == -1) return -1;
+
+    if (hc_nativeLaunchKernel (hashcat_ctx, device_param->native_pool, native_function, native_args, num_elements) == -1) return -1;
+  }
+
   return 0;
 }
 
@@ -3497,6 +3824,18 @@ int run_kernel_tm (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
     if (hc_clEnqueueNDRangeKernel (hashcat_ctx, device_param->opencl_command_queue, cuda_kernel, 1, NULL, global_work_size, local_work_size, 0, NULL, NULL) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    u64 native_args[NATIVE_ARGS_MAX] = { 0 };
+
+    for (u32 i = 0; i < 2; i++)
+    {
+      if (hc_nativeSetKernelArg (hashcat_ctx, native_args, i, sizeof (void *), device_param->kernel_params_tm[i]) == -1) return -1;
+    }
+
+    if (hc_nativeLaunchKernel (hashcat_ctx, device_param->native_pool, &device_param->native_function_tm, native_args, num_elements) == -1) return -1;
+  }
+
   return 0;
 }
 
@@ -3598,6 +3937,21 @@ int run_kernel_amp (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
     if (hc_clEnqueueNDRangeKernel (hashcat_ctx, device_param->opencl_command_queue, opencl_kernel, 1, NULL, global_work_size, local_work_size, 0, NULL, NULL) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    u64 native_args[NATIVE_ARGS_MAX] = { 0 };
+
+    for (u32 i = 0; i < 5; i++)
+    {
+      if (hc_nativeSetKernelArg (hashcat_ctx, native_args, i, sizeof (void *), device_param->kernel_params_amp[i]) == -1) return -1;
+    }
+
+    if (hc_nativeSetKernelArg (hashcat_ctx, native_args, 5, sizeof (u32), device_param->kernel_params_amp[5]) == -1) return -1;
+    if (hc_nativeSetKernelArg (hashcat_ctx, native_args, 6, sizeof (u64), device_param->kernel_params_amp[6]) == -1) return -1;
+
+    if (hc_nativeLaunchKernel (hashcat_ctx, device_param->native_pool, &device_param->native_function_amp, native_args, num_elements) == -1) return -1;
+  }
+
   return 0;
 }
 
@@ -3667,6 +4021,20 @@ int run_kernel_decompress (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device
     if (hc_clEnqueueNDRangeKernel (hashcat_ctx, device_param->opencl_command_queue, opencl_kernel, 1, NULL, global_work_size, local_work_size, 0, NULL, NULL) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    u64 native_args[NATIVE_ARGS_MAX] = { 0 };
+
+    for (u32 i = 0; i < 3; i++)
+    {
+      if (hc_nativeSetKernelArg (hashcat_ctx, native_args, i, sizeof (void *), device_param->kernel_params_decompress[i]) == -1) return -1;
+    }
+
+    if (hc_nativeSetKernelArg (hashcat_ctx, native_args, 3, sizeof (u64), device_param->kernel_params_decompress[3]) == -1) return -1;
+
+    if (hc_nativeLaunchKernel (hashcat_ctx, device_param->native_pool, &device_param->native_function_decompress, native_args, num_elements) == -1) return -1;
+  }
+
   return 0;
 }
 
@@ -3751,6 +4119,20 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
       }
     }
 
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+
+      const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+      const u32 off = pw_idx->off;
+
+      if (off)
+      {
+        if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
+      }
+    }
+
     if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
   }
   else
@@ -3815,6 +4197,20 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
         }
       }
 
+      if (device_param->is_native == true)
+      {
+        if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+
+        const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+        const u32 off = pw_idx->off;
+
+        if (off)
+        {
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
+        }
+      }
+
       if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
     }
     else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
@@ -3913,6 +4309,20 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
           }
         }
 
+        if (device_param->is_native == true)
+        {
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+
+          const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+          const u32 off = pw_idx->off;
+
+          if (off)
+          {
+            if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
+          }
+        }
+
         if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
       }
       else
@@ -3977,13 +4387,9 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
             }
           }
 
-          if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
-        }
-        else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-        {
-          if (device_param->is_cuda == true)
+          if (device_param->is_native == true)
           {
-            if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+            if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
 
             const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
 
@@ -3991,12 +4397,30 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
 
             if (off)
             {
-              if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
+              if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
             }
           }
 
-          if (device_param->is_hip == true)
-          {
+          if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
+        }
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+        {
+          if (device_param->is_cuda == true)
+          {
+            if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+
+            const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+            const u32 off = pw_idx->off;
+
+            if (off)
+            {
+              if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
+            }
+          }
+
+          if (device_param->is_hip == true)
+          {
             if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
 
             const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
@@ -4039,6 +4463,20 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
             }
           }
 
+          if (device_param->is_native == true)
+          {
+            if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+
+            const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+            const u32 off = pw_idx->off;
+
+            if (off)
+            {
+              if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
+            }
+          }
+
           if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
         }
         else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
@@ -4083,9 +4521,308 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
     if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+
+  }
+
+  return 0;
+}
+
+static void combs_cache_release (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  if (device_param->size_combs_cache == 0) return;
+
+  if (device_param->is_cuda == true)
+  {
+    hc_cuMemFreePtr (hashcat_ctx, &device_param->cuda_d_combs_cache);
+  }
+
+  if (device_param->is_hip == true)
+  {
+    hc_hipMemFreePtr (hashcat_ctx, &device_param->hip_d_combs_cache);
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    hc_mtlReleaseMemObject (hashcat_ctx, &device_param->metal_d_combs_cache);
+  }
+  #endif
+
+  if (device_param->is_opencl == true)
+  {
+    hc_clReleaseMemObjectPtr (hashcat_ctx, &device_param->opencl_d_combs_cache);
+  }
+
+  if (device_param->is_native == true)
+  {
+    hc_nativeMemFreePtr (hashcat_ctx, &device_param->native_d_combs_cache);
+  }
+
+  device_param->size_combs_cache = 0;
+}
+
+static int combs_cache_upload (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
+
+  combs_cache_release (hashcat_ctx, device_param);
+
+  device_param->combs_cache_gen = combinator_ctx->cache_gen;
+
+  if (combinator_ctx->cache_enabled == false) return 0;
+
+  // keep the expanded wordlist resident only if it fits next to the buffers sized in backend_session_begin()
+
+  const u64 size_combs_cache = combinator_ctx->cache_cnt * sizeof (pw_t);
+
+  if (size_combs_cache == 0) return 0;
+
+  if (size_combs_cache > device_param->device_maxmem_alloc) return 0;
+
+  if ((device_param->size_total + size_combs_cache) > device_param->device_available_mem) return 0;
+
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs_cache, size_combs_cache) == -1) return -1;
+  }
+
+  if (device_param->is_hip == true)
+  {
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_combs_cache, size_combs_cache) == -1) return -1;
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_combs_cache, NULL, combs_cache);
+  }
+  #endif
+
+  if (device_param->is_opencl == true)
+  {
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_combs_cache, NULL, combs_cache);
+  }
+
+  if (device_param->is_native == true)
+  {
+    if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_combs_cache, size_combs_cache) == -1) return -1;
+  }
+
+  device_param->size_combs_cache = size_combs_cache;
+
+  // expand in chunks through the host side combs_buf
+
+  for (u64 pos = 0; pos < combinator_ctx->cache_cnt; pos += KERNEL_COMBS)
+  {
+    const u64 cnt = MIN (KERNEL_COMBS, combinator_ctx->cache_cnt - pos);
+
+    for (u64 i = 0; i < cnt; i++)
+    {
+      combinator_cache_to_pw (combinator_ctx, pos + i, &device_param->combs_buf[i]);
+    }
+
+    const u64 off = pos * sizeof (pw_t);
+    const u64 len = cnt * sizeof (pw_t);
+
+    if (device_param->is_cuda == true)
+    {
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_combs_cache + off, device_param->combs_buf, len) == -1) return -1;
+    }
+
+    if (device_param->is_hip == true)
+    {
+      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_combs_cache + off, device_param->combs_buf, len) == -1) return -1;
+    }
+
+    #if defined (__APPLE__)
+    if (device_param->is_metal == true)
+    {
+      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_combs_cache, off, device_param->combs_buf, len) == -1) return -1;
+    }
+    #endif
+
+    if (device_param->is_opencl == true)
+    {
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs_cache, CL_TRUE, off, len, device_param->combs_buf, 0, NULL, NULL) == -1) return -1;
+    }
+
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, (u8 *) device_param->native_d_combs_cache + off, device_param->combs_buf, len) == -1) return -1;
+    }
+  }
+
+  return 0;
+}
+
+static int combs_cache_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 salt_pos, const u64 pws_cnt, const u64 innerloop_pos, u64 *innerloop_left)
+{
+  combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
+  status_ctx_t     *status_ctx     = hashcat_ctx->status_ctx;
+
+  const u64 cache_cnt = combinator_ctx->cache_cnt;
+
+  // each batch consumes innerloop_step accepted words, so the read position equals innerloop_pos
+
+  const u64 pos = MIN (innerloop_pos, cache_cnt);
+  const u64 cnt = MIN (*innerloop_left, cache_cnt - pos);
+
+  // account rule-rejected lines in the same batch that would have read them from the file
+
+  if (innerloop_pos <= cache_cnt)
+  {
+    const u64 rej_lo = (pos == 0)              ? 0 : combinator_ctx->cache_rej[pos - 1];
+    const u64 rej_hi = (cnt < *innerloop_left) ? combinator_ctx->cache_rej[cache_cnt] : combinator_ctx->cache_rej[pos + cnt - 1];
+
+    status_ctx->words_progress_rejected[salt_pos] += pws_cnt * (rej_hi - rej_lo);
+  }
+
+  *innerloop_left = cnt;
+
+  if (cnt == 0) return 0;
+
+  const u64 len = cnt * sizeof (pw_t);
+
+  if (device_param->size_combs_cache)
+  {
+    const u64 off = pos * sizeof (pw_t);
+
+    if (device_param->is_cuda == true)
+    {
+      if (hc_cuMemcpyDtoD (hashcat_ctx, device_param->cuda_d_combs_c, device_param->cuda_d_combs_cache + off, len) == -1) return -1;
+    }
+
+    if (device_param->is_hip == true)
+    {
+      if (hc_hipMemcpyDtoD (hashcat_ctx, device_param->hip_d_combs_c, device_param->hip_d_combs_cache + off, len) == -1) return -1;
+    }
+
+    #if defined (__APPLE__)
+    if (device_param->is_metal == true)
+    {
+      if (hc_mtlMemcpyDtoD (hashcat_ctx, device_param->metal_command_queue, device_param->metal_d_combs_c, 0, device_param->metal_d_combs_cache, off, len) == -1) return -1;
+    }
+    #endif
+
+    if (device_param->is_opencl == true)
+    {
+      if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs_cache, device_param->opencl_d_combs_c, off, 0, len, 0, NULL, NULL) == -1) return -1;
+    }
+
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_combs_c, (u8 *) device_param->native_d_combs_cache + off, len) == -1) return -1;
+    }
+
+    return 0;
+  }
+
+  // does not fit on the device, still skips parsing the file
+
+  for (u64 i = 0; i < cnt; i++)
+  {
+    combinator_cache_to_pw (combinator_ctx, pos + i, &device_param->combs_buf[i]);
+  }
+
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_combs_c, device_param->combs_buf, len) == -1) return -1;
+  }
+
+  if (device_param->is_hip == true)
+  {
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_combs_c, device_param->combs_buf, len) == -1) return -1;
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_combs_c, 0, device_param->combs_buf, len) == -1) return -1;
+  }
+  #endif
+
+  if (device_param->is_opencl == true)
+  {
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs_c, CL_TRUE, 0, len, device_param->combs_buf, 0, NULL, NULL) == -1) return -1;
+  }
+
+  if (device_param->is_native == true)
+  {
+    if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_combs_c, device_param->combs_buf, len) == -1) return -1;
+  }
+
   return 0;
 }
 
+static u32 salt_pack_slots (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, const u64 pws_cnt, u64 *stride)
+{
+  const hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  const hashes_t             *hashes             = hashcat_ctx->hashes;
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  if (user_options->salt_pack == false) return 0;
+
+  if (hashconfig->attack_exec != ATTACK_EXEC_OUTSIDE_KERNEL) return 0;
+
+  if (hashes->salts_cnt < 2) return 0;
+
+  // the kernels are built without SALT_PACK on metal, see backend_session_build_devices()
+
+  if (device_param->is_metal == true) return 0;
+
+  // association attack already takes the salt from the gid, the combinator reads the right-hand words once per salt
+
+  if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION) return 0;
+  if (user_options->slow_candidates == true) return 0;
+  if (user_options->speed_only == true) return 0;
+
+  if (user_options_extra->attack_kern == ATTACK_KERN_COMBI) return 0;
+
+  // the host side hooks and bridges work on a single salt, COPY_TMPS reads the tmps at the candidate index
+
+  if (hashconfig->opts_type & (OPTS_TYPE_HOOK12 | OPTS_TYPE_HOOK23 | OPTS_TYPE_DEEP_COMP_KERNEL | OPTS_TYPE_COPY_TMPS)) return 0;
+
+  if (hashconfig->bridge_type & (BRIDGE_TYPE_LAUNCH_LOOP | BRIDGE_TYPE_LAUNCH_LOOP2)) return 0;
+
+  if (pws_cnt == 0) return 0;
+
+  const u64 kernel_threads = device_param->kernel_threads;
+
+  *stride = CEILDIV (pws_cnt, kernel_threads) * kernel_threads;
+
+  return (u32) MIN (device_param->kernel_power / *stride, hashes->salts_cnt);
+}
+
+static u32 salt_pack_count (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos, const u32 salt_pack_max)
+{
+  const hashes_t *hashes = hashcat_ctx->hashes;
+
+  // the kernel derives the digest offset from the slot, so only consecutive single-digest salts can share a launch,
+  // they also have to share the iteration counts as the loop kernel is launched for all slots at once
+
+  const salt_t *salt_first = &hashes->salts_buf[salt_pos];
+
+  u32 cnt = 0;
+
+  for (u32 pos = salt_pos; pos < hashes->salts_cnt && cnt < salt_pack_max; pos++, cnt++)
+  {
+    const salt_t *salt_buf = &hashes->salts_buf[pos];
+
+    if (hashes->salts_shown[pos] == 1) break;
+
+    if (salt_buf->digests_cnt != 1) break;
+
+    if (salt_buf->salt_iter    != salt_first->salt_iter)    break;
+    if (salt_buf->salt_iter2   != salt_first->salt_iter2)   break;
+    if (salt_buf->salt_repeats != salt_first->salt_repeats) break;
+  }
+
+  return MAX (cnt, 1);
+}
+
 int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_pos, const u64 pws_cnt)
 {
   combinator_ctx_t      *combinator_ctx     = hashcat_ctx->combinator_ctx;
@@ -4162,7 +4899,22 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
     salts_cnt = 1;
   }
 
-  for (u32 salt_pos = 0; salt_pos < salts_cnt; salt_pos++)
+  // the parsed right-hand wordlist changes with each hybrid wordlist
+
+  if (device_param->combs_cache_gen != combinator_ctx->cache_gen)
+  {
+    if (combs_cache_upload (hashcat_ctx, device_param) == -1) return -1;
+  }
+
+  // --salt-pack, the number of salts which fit into one launch with this pws_cnt
+
+  u64 salt_pack_stride = 0;
+
+  const u32 salt_pack_max = salt_pack_slots (hashcat_ctx, device_param, pws_cnt, &salt_pack_stride);
+
+  u32 salt_pack_cnt = 1;
+
+  for (u32 salt_pos = 0; salt_pos < salts_cnt; salt_pos += salt_pack_cnt)
   {
     while (status_ctx->devices_status == STATUS_PAUSED) sleep (1);
 
@@ -4172,6 +4924,13 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
     device_param->kernel_param.digests_cnt         = salt_buf->digests_cnt;
     device_param->kernel_param.digests_offset_host = salt_buf->digests_offset;
 
+    salt_pack_cnt = (salt_pack_max > 1) ? salt_pack_count (hashcat_ctx, salt_pos, salt_pack_max) : 1;
+
+    device_param->salt_pack_cnt = salt_pack_cnt;
+    device_param->salt_pack_pws = pws_cnt;
+
+    device_param->kernel_param.salt_pack_stride = (salt_pack_cnt > 1) ? salt_pack_stride : 0;
+
     HCFILE *combs_fp = &device_param->combs_fp;
 
     if (user_options->slow_candidates == true)
@@ -4250,9 +5009,19 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
       }
       else
       {
-        if (hashes->salts_shown[salt_pos] == 1)
+        u32 salt_pack_shown = 0;
+
+        for (u32 salt_pack_pos = 0; salt_pack_pos < salt_pack_cnt; salt_pack_pos++)
+        {
+          salt_pack_shown += hashes->salts_shown[salt_pos + salt_pack_pos];
+        }
+
+        if (salt_pack_shown == salt_pack_cnt)
         {
-          status_ctx->words_progress_done[salt_pos] += pws_cnt * innerloop_left;
+          for (u32 salt_pack_pos = 0; salt_pack_pos < salt_pack_cnt; salt_pack_pos++)
+          {
+            status_ctx->words_progress_done[salt_pos + salt_pack_pos] += (pws_cnt - device_param->pws_loopback_cnt) * innerloop_left;
+          }
 
           continue;
         }
@@ -4288,6 +5057,11 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
           {
             if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_rules, device_param->opencl_d_rules_c, innerloop_pos * sizeof (kernel_rule_t), 0, innerloop_left * sizeof (kernel_rule_t), 0, NULL, NULL) == -1) return -1;
           }
+
+          if (device_param->is_native == true)
+          {
+            if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_rules_c, (u8 *) device_param->native_d_rules + (innerloop_pos * sizeof (kernel_rule_t)), innerloop_left * sizeof (kernel_rule_t)) == -1) return -1;
+          }
         }
         else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
         {
@@ -4295,130 +5069,142 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
           {
             if (user_options->attack_mode == ATTACK_MODE_COMBI)
             {
-              char *line_buf = device_param->scratch_buf;
+              if (combinator_ctx->cache_enabled == true)
+              {
+                if (combs_cache_copy (hashcat_ctx, device_param, salt_pos, pws_cnt, innerloop_pos, &innerloop_left) == -1) return -1;
+              }
+              else
+              {
+                char *line_buf = device_param->scratch_buf;
 
-              u64 i = 0;
+                u64 i = 0;
 
-              while (i < innerloop_left)
-              {
-                if (hc_feof (combs_fp)) break;
+                while (i < innerloop_left)
+                {
+                  if (hc_feof (combs_fp)) break;
 
-                size_t line_len = fgetl (combs_fp, line_buf, HCBUFSIZ_LARGE);
+                  size_t line_len = fgetl (combs_fp, line_buf, HCBUFSIZ_LARGE);
 
-                line_len = convert_from_hex (hashcat_ctx, line_buf, line_len);
+                  line_len = convert_from_hex (hashcat_ctx, line_buf, line_len);
 
-                if (line_len > PW_MAX) continue;
+                  if (line_len > PW_MAX) continue;
 
-                char *line_buf_new = line_buf;
+                  char *line_buf_new = line_buf;
 
-                char rule_buf_out[RP_PASSWORD_SIZE];
+                  char rule_buf_out[RP_PASSWORD_SIZE];
 
-                if (run_rule_engine (user_options_extra->rule_len_r, user_options->rule_buf_r))
-                {
-                  if (line_len >= RP_PASSWORD_SIZE) continue;
+                  if (run_rule_engine (user_options_extra->rule_len_r, user_options->rule_buf_r))
+                  {
+                    if (line_len >= RP_PASSWORD_SIZE) continue;
 
-                  memset (rule_buf_out, 0, sizeof (rule_buf_out));
+                    memset (rule_buf_out, 0, sizeof (rule_buf_out));
 
-                  const int rule_len_out = _old_apply_rule (user_options->rule_buf_r, user_options_extra->rule_len_r, line_buf, (u32) line_len, rule_buf_out);
+                    const int rule_len_out = _old_apply_rule (user_options->rule_buf_r, user_options_extra->rule_len_r, line_buf, (u32) line_len, rule_buf_out);
 
-                  if (rule_len_out < 0)
-                  {
-                    if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
+                    if (rule_len_out < 0)
                     {
-                      for (u32 association_salt_pos = 0; association_salt_pos < pws_cnt; association_salt_pos++)
+                      if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
                       {
-                        status_ctx->words_progress_rejected[association_salt_pos] += 1;
+                        for (u32 association_salt_pos = 0; association_salt_pos < pws_cnt; association_salt_pos++)
+                        {
+                          status_ctx->words_progress_rejected[association_salt_pos] += 1;
+                        }
+                      }
+                      else
+                      {
+                        status_ctx->words_progress_rejected[salt_pos] += pws_cnt;
                       }
-                    }
-                    else
-                    {
-                      status_ctx->words_progress_rejected[salt_pos] += pws_cnt;
-                    }
-
-                    continue;
-                  }
 
-                  line_len = rule_len_out;
+                      continue;
+                    }
 
-                  line_buf_new = rule_buf_out;
-                }
+                    line_len = rule_len_out;
 
-                // do the on-the-fly encoding
+                    line_buf_new = rule_buf_out;
+                  }
 
-                if (iconv_enabled == true)
-                {
-                  char  *iconv_ptr = iconv_tmp;
-                  size_t iconv_sz  = HCBUFSIZ_TINY;
+                  // do the on-the-fly encoding
 
-                  if (iconv (iconv_ctx, &line_buf_new, &line_len, &iconv_ptr, &iconv_sz) == (size_t) -1) continue;
+                  if (iconv_enabled == true)
+                  {
+                    char  *iconv_ptr = iconv_tmp;
+                    size_t iconv_sz  = HCBUFSIZ_TINY;
 
-                  line_buf_new = iconv_tmp;
-                  line_len     = HCBUFSIZ_TINY - iconv_sz;
-                }
+                    if (iconv (iconv_ctx, &line_buf_new, &line_len, &iconv_ptr, &iconv_sz) == (size_t) -1) continue;
 
-                line_len = MIN (line_len, PW_MAX);
+                    line_buf_new = iconv_tmp;
+                    line_len     = HCBUFSIZ_TINY - iconv_sz;
+                  }
 
-                u8 *ptr = (u8 *) device_param->combs_buf[i].i;
+                  line_len = MIN (line_len, PW_MAX);
 
-                memcpy (ptr, line_buf_new, line_len);
+                  u8 *ptr = (u8 *) device_param->combs_buf[i].i;
 
-                memset (ptr + line_len, 0, PW_MAX - line_len);
+                  memcpy (ptr, line_buf_new, line_len);
 
-                if (hashconfig->opts_type & OPTS_TYPE_PT_UPPER)
-                {
-                  uppercase (ptr, line_len);
-                }
+                  memset (ptr + line_len, 0, PW_MAX - line_len);
 
-                if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT)
-                {
-                  if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)
+                  if (hashconfig->opts_type & OPTS_TYPE_PT_UPPER)
                   {
-                    ptr[line_len] = 0x80;
+                    uppercase (ptr, line_len);
                   }
 
-                  if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)
+                  if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT)
                   {
-                    ptr[line_len] = 0x06;
-                  }
+                    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)
+                    {
+                      ptr[line_len] = 0x80;
+                    }
 
-                  if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)
-                  {
-                    ptr[line_len] = 0x01;
+                    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)
+                    {
+                      ptr[line_len] = 0x06;
+                    }
+
+                    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)
+                    {
+                      ptr[line_len] = 0x01;
+                    }
                   }
-                }
 
-                device_param->combs_buf[i].pw_len = (u32) line_len;
+                  device_param->combs_buf[i].pw_len = (u32) line_len;
 
-                i++;
-              }
+                  i++;
+                }
 
-              for (u64 j = i; j < innerloop_left; j++)
-              {
-                memset (&device_param->combs_buf[j], 0, sizeof (pw_t));
-              }
+                for (u64 j = i; j < innerloop_left; j++)
+                {
+                  memset (&device_param->combs_buf[j], 0, sizeof (pw_t));
+                }
 
-              innerloop_left = i;
+                innerloop_left = i;
 
-              if (device_param->is_cuda == true)
-              {
-                if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
-              }
+                if (device_param->is_cuda == true)
+                {
+                  if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
+                }
 
-              if (device_param->is_hip == true)
-              {
-                if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
-              }
+                if (device_param->is_hip == true)
+                {
+                  if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
+                }
 
-              #if defined (__APPLE__)
-              if (device_param->is_metal == true)
-              {
-                if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_combs_c, 0, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
-              }
-              #endif
+                #if defined (__APPLE__)
+                if (device_param->is_metal == true)
+                {
+                  if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_combs_c, 0, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
+                }
+                #endif
 
-              if (device_param->is_opencl == true)
-              {
-                if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs_c, CL_TRUE, 0, innerloop_left * sizeof (pw_t), device_param->combs_buf, 0, NULL, NULL) == -1) return -1;
+                if (device_param->is_opencl == true)
+                {
+                  if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs_c, CL_TRUE, 0, innerloop_left * sizeof (pw_t), device_param->combs_buf, 0, NULL, NULL) == -1) return -1;
+                }
+
+                if (device_param->is_native == true)
+                {
+                  if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
+                }
               }
             }
             else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
@@ -4450,6 +5236,11 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
               {
                 if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs, device_param->opencl_d_combs_c, 0, 0, innerloop_left * sizeof (pw_t), 0, NULL, NULL) == -1) return -1;
               }
+
+              if (device_param->is_native == true)
+              {
+                if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_combs_c, device_param->native_d_combs, innerloop_left * sizeof (pw_t)) == -1) return -1;
+              }
             }
             else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
             {
@@ -4480,138 +5271,155 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
               {
                 if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs, device_param->opencl_d_combs_c, 0, 0, innerloop_left * sizeof (pw_t), 0, NULL, NULL) == -1) return -1;
               }
+
+              if (device_param->is_native == true)
+              {
+                if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_combs_c, device_param->native_d_combs, innerloop_left * sizeof (pw_t)) == -1) return -1;
+              }
             }
           }
           else
           {
             if ((user_options->attack_mode == ATTACK_MODE_COMBI) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
             {
-              char *line_buf = device_param->scratch_buf;
+              if (combinator_ctx->cache_enabled == true)
+              {
+                if (combs_cache_copy (hashcat_ctx, device_param, salt_pos, pws_cnt, innerloop_pos, &innerloop_left) == -1) return -1;
+              }
+              else
+              {
+                char *line_buf = device_param->scratch_buf;
 
-              u64 i = 0;
+                u64 i = 0;
 
-              while (i < innerloop_left)
-              {
-                if (hc_feof (combs_fp)) break;
+                while (i < innerloop_left)
+                {
+                  if (hc_feof (combs_fp)) break;
 
-                size_t line_len = fgetl (combs_fp, line_buf, HCBUFSIZ_LARGE);
+                  size_t line_len = fgetl (combs_fp, line_buf, HCBUFSIZ_LARGE);
 
-                line_len = convert_from_hex (hashcat_ctx, line_buf, line_len);
+                  line_len = convert_from_hex (hashcat_ctx, line_buf, line_len);
 
-                if (line_len > PW_MAX) continue;
+                  if (line_len > PW_MAX) continue;
 
-                char *line_buf_new = line_buf;
+                  char *line_buf_new = line_buf;
 
-                char rule_buf_out[RP_PASSWORD_SIZE];
+                  char rule_buf_out[RP_PASSWORD_SIZE];
 
-                if (run_rule_engine (user_options_extra->rule_len_r, user_options->rule_buf_r))
-                {
-                  if (line_len >= RP_PASSWORD_SIZE) continue;
+                  if (run_rule_engine (user_options_extra->rule_len_r, user_options->rule_buf_r))
+                  {
+                    if (line_len >= RP_PASSWORD_SIZE) continue;
 
-                  memset (rule_buf_out, 0, sizeof (rule_buf_out));
+                    memset (rule_buf_out, 0, sizeof (rule_buf_out));
 
-                  const int rule_len_out = _old_apply_rule (user_options->rule_buf_r, user_options_extra->rule_len_r, line_buf, (u32) line_len, rule_buf_out);
+                    const int rule_len_out = _old_apply_rule (user_options->rule_buf_r, user_options_extra->rule_len_r, line_buf, (u32) line_len, rule_buf_out);
 
-                  if (rule_len_out < 0)
-                  {
-                    if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
+                    if (rule_len_out < 0)
                     {
-                      for (u32 association_salt_pos = 0; association_salt_pos < pws_cnt; association_salt_pos++)
+                      if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
                       {
-                        status_ctx->words_progress_rejected[association_salt_pos] += 1;
+                        for (u32 association_salt_pos = 0; association_salt_pos < pws_cnt; association_salt_pos++)
+                        {
+                          status_ctx->words_progress_rejected[association_salt_pos] += 1;
+                        }
+                      }
+                      else
+                      {
+                        status_ctx->words_progress_rejected[salt_pos] += pws_cnt;
                       }
-                    }
-                    else
-                    {
-                      status_ctx->words_progress_rejected[salt_pos] += pws_cnt;
-                    }
-
-                    continue;
-                  }
 
-                  line_len = rule_len_out;
+                      continue;
+                    }
 
-                  line_buf_new = rule_buf_out;
-                }
+                    line_len = rule_len_out;
 
-                // do the on-the-fly encoding
+                    line_buf_new = rule_buf_out;
+                  }
 
-                if (iconv_enabled == true)
-                {
-                  char  *iconv_ptr = iconv_tmp;
-                  size_t iconv_sz  = HCBUFSIZ_TINY;
+                  // do the on-the-fly encoding
 
-                  if (iconv (iconv_ctx, &line_buf_new, &line_len, &iconv_ptr, &iconv_sz) == (size_t) -1) continue;
+                  if (iconv_enabled == true)
+                  {
+                    char  *iconv_ptr = iconv_tmp;
+                    size_t iconv_sz  = HCBUFSIZ_TINY;
 
-                  line_buf_new = iconv_tmp;
-                  line_len     = HCBUFSIZ_TINY - iconv_sz;
-                }
+                    if (iconv (iconv_ctx, &line_buf_new, &line_len, &iconv_ptr, &iconv_sz) == (size_t) -1) continue;
 
-                line_len = MIN (line_len, PW_MAX);
+                    line_buf_new = iconv_tmp;
+                    line_len     = HCBUFSIZ_TINY - iconv_sz;
+                  }
 
-                u8 *ptr = (u8 *) device_param->combs_buf[i].i;
+                  line_len = MIN (line_len, PW_MAX);
 
-                memcpy (ptr, line_buf_new, line_len);
+                  u8 *ptr = (u8 *) device_param->combs_buf[i].i;
 
-                memset (ptr + line_len, 0, PW_MAX - line_len);
+                  memcpy (ptr, line_buf_new, line_len);
 
-                if (hashconfig->opts_type & OPTS_TYPE_PT_UPPER)
-                {
-                  uppercase (ptr, line_len);
-                }
+                  memset (ptr + line_len, 0, PW_MAX - line_len);
 
-                /*
-                if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT)
-                {
-                  if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)
+                  if (hashconfig->opts_type & OPTS_TYPE_PT_UPPER)
                   {
-                    ptr[line_len] = 0x80;
+                    uppercase (ptr, line_len);
                   }
 
-                  if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)
+                  /*
+                  if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT)
                   {
-                    ptr[line_len] = 0x06;
-                  }
+                    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)
+                    {
+                      ptr[line_len] = 0x80;
+                    }
 
-                  if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)
-                  {
-                    ptr[line_len] = 0x01;
+                    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)
+                    {
+                      ptr[line_len] = 0x06;
+                    }
+
+                    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)
+                    {
+                      ptr[line_len] = 0x01;
+                    }
                   }
-                }
-                */
+                  */
 
-                device_param->combs_buf[i].pw_len = (u32) line_len;
+                  device_param->combs_buf[i].pw_len = (u32) line_len;
 
-                i++;
-              }
+                  i++;
+                }
 
-              for (u64 j = i; j < innerloop_left; j++)
-              {
-                memset (&device_param->combs_buf[j], 0, sizeof (pw_t));
-              }
+                for (u64 j = i; j < innerloop_left; j++)
+                {
+                  memset (&device_param->combs_buf[j], 0, sizeof (pw_t));
+                }
 
-              innerloop_left = i;
+                innerloop_left = i;
 
-              if (device_param->is_cuda == true)
-              {
-                if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
-              }
+                if (device_param->is_cuda == true)
+                {
+                  if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
+                }
 
-              if (device_param->is_hip == true)
-              {
-                if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
-              }
+                if (device_param->is_hip == true)
+                {
+                  if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
+                }
 
-              #if defined (__APPLE__)
-              if (device_param->is_metal == true)
-              {
-                if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_combs_c, 0, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
-              }
-              #endif
+                #if defined (__APPLE__)
+                if (device_param->is_metal == true)
+                {
+                  if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_combs_c, 0, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
+                }
+                #endif
 
-              if (device_param->is_opencl == true)
-              {
-                if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs_c, CL_TRUE, 0, innerloop_left * sizeof (pw_t), device_param->combs_buf, 0, NULL, NULL) == -1) return -1;
+                if (device_param->is_opencl == true)
+                {
+                  if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs_c, CL_TRUE, 0, innerloop_left * sizeof (pw_t), device_param->combs_buf, 0, NULL, NULL) == -1) return -1;
+                }
+
+                if (device_param->is_native == true)
+                {
+                  if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_combs_c, device_param->combs_buf, innerloop_left * sizeof (pw_t)) == -1) return -1;
+                }
               }
             }
             else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
@@ -4643,6 +5451,11 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
               {
                 if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_combs, device_param->opencl_d_combs_c, 0, 0, innerloop_left * sizeof (pw_t), 0, NULL, NULL) == -1) return -1;
               }
+
+              if (device_param->is_native == true)
+              {
+                if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_combs_c, device_param->native_d_combs, innerloop_left * sizeof (pw_t)) == -1) return -1;
+              }
             }
           }
         }
@@ -4675,6 +5488,11 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
           {
             if (hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bfs, device_param->opencl_d_bfs_c, 0, 0, innerloop_left * sizeof (bf_t), 0, NULL, NULL) == -1) return -1;
           }
+
+          if (device_param->is_native == true)
+          {
+            if (hc_nativeMemcpyDtoD (hashcat_ctx, device_param->native_d_bfs_c, device_param->native_d_bfs, innerloop_left * sizeof (bf_t)) == -1) return -1;
+          }
         }
       }
 
@@ -4696,7 +5514,7 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
 
         if (status_ctx->run_thread_level2 == true)
         {
-          const u64 perf_sum_all = pws_cnt * innerloop_left;
+          const u64 perf_sum_all = pws_cnt * salt_pack_cnt * innerloop_left;
 
           const double speed_msec = hc_timer_get (device_param->timer_speed);
 
@@ -4725,14 +5543,19 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
 
           if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
           {
-            for (u32 association_salt_pos = 0; association_salt_pos < pws_cnt; association_salt_pos++)
+            const u32 association_width = device_param->kernel_param.association_width;
+
+            for (u64 association_pws_pos = pws_pos; association_pws_pos < pws_pos + pws_cnt; association_pws_pos++)
             {
-              status_ctx->words_progress_done[pws_pos + association_salt_pos] += innerloop_left;
+              status_ctx->words_progress_done[association_pws_pos / association_width] += innerloop_left;
             }
           }
           else
           {
-            status_ctx->words_progress_done[salt_pos] += perf_sum_all;
+            for (u32 salt_pack_pos = 0; salt_pack_pos < salt_pack_cnt; salt_pack_pos++)
+            {
+              status_ctx->words_progress_done[salt_pos + salt_pack_pos] += (pws_cnt - device_param->pws_loopback_cnt) * innerloop_left;
+            }
           }
 
           hc_thread_mutex_unlock (status_ctx->mux_counter);
@@ -4805,6 +5628,13 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
     if (status_ctx->run_thread_level2 == false) break;
   }
 
+  // autotune and selftest launch a single salt
+
+  device_param->salt_pack_cnt = 0;
+  device_param->salt_pack_pws = 0;
+
+  device_param->kernel_param.salt_pack_stride = 0;
+
   //status screen makes use of this, can't reset here
   //device_param->outerloop_msec = 0;
   //device_param->outerloop_pos  = 0;
@@ -5126,6 +5956,32 @@ int backend_ctx_init (hashcat_ctx_t *hashcat_ctx)
   }
   #endif // __APPLE__
 
+  /**
+   * Init native backend, it is the only one which is opt-in
+   */
+
+  int rc_native_init = -1;
+
+  if (user_options->backend_native == true)
+  {
+    NATIVE_PTR *native = (NATIVE_PTR *) hcmalloc (sizeof (NATIVE_PTR));
+
+    backend_ctx->native = native;
+
+    rc_native_init = native_init (hashcat_ctx);
+
+    if (rc_native_init == -1)
+    {
+      backend_ctx->rc_native_init = rc_native_init;
+
+      event_log_warning (hashcat_ctx, "Failed to run the host C compiler, native backend disabled.");
+      event_log_warning (hashcat_ctx, "Set $CC if the compiler is not in PATH as 'cc'.");
+      event_log_warning (hashcat_ctx, NULL);
+
+      native_close (hashcat_ctx);
+    }
+  }
+
   /**
    * Load and map OpenCL library calls
    */
@@ -5149,7 +6005,7 @@ int backend_ctx_init (hashcat_ctx_t *hashcat_ctx)
      * return if both CUDA and OpenCL initialization failed
      */
 
-    if ((rc_cuda_init == -1) && (rc_hip_init == -1) && (rc_ocl_init == -1) && (rc_metal_init == -1))
+    if ((rc_cuda_init == -1) && (rc_hip_init == -1) && (rc_ocl_init == -1) && (rc_metal_init == -1) && (rc_native_init == -1))
     {
       #if defined (__APPLE__)
       event_log_error (hashcat_ctx, "ATTENTION! No OpenCL, Metal, HIP or CUDA compatible platform found.");
@@ -5505,7 +6361,7 @@ int backend_ctx_init (hashcat_ctx_t *hashcat_ctx)
    * Final checks
    */
 
-  if ((backend_ctx->cuda == NULL) && (backend_ctx->hip == NULL) && (backend_ctx->ocl == NULL) && (backend_ctx->mtl == NULL))
+  if ((backend_ctx->cuda == NULL) && (backend_ctx->hip == NULL) && (backend_ctx->ocl == NULL) && (backend_ctx->mtl == NULL) && (backend_ctx->native == NULL))
   {
     #if defined (__APPLE__)
     event_log_error (hashcat_ctx, "ATTENTION! No OpenCL, Metal, HIP or CUDA compatible platform found.");
@@ -5539,6 +6395,14 @@ int backend_ctx_init (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
+  /**
+   * NUMA topology, bridge units and host threads are only placed automatically if the user did not pin the process
+   */
+
+  numa_topology_init (&backend_ctx->numa_topology);
+
+  backend_ctx->numa_enabled = (user_options->numa == true) && (user_options->cpu_affinity == NULL) && (backend_ctx->numa_topology.nodes_cnt > 1);
+
   backend_ctx->enabled = true;
 
   return 0;
@@ -5552,6 +6416,8 @@ void backend_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
 
   hcfree (backend_ctx->devices_param);
 
+  numa_topology_destroy (&backend_ctx->numa_topology);
+
   if (backend_ctx->ocl)
   {
     hcfree (backend_ctx->opencl_platforms);
@@ -5569,6 +6435,7 @@ void backend_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
   cuda_close   (hashcat_ctx);
   hip_close    (hashcat_ctx);
   ocl_close    (hashcat_ctx);
+  native_close (hashcat_ctx);
 
   memset (backend_ctx, 0, sizeof (backend_ctx_t));
 }
@@ -8385,108 +9252,272 @@ static void backend_ctx_devices_init_opencl (hashcat_ctx_t *hashcat_ctx, int *vi
   backend_ctx->opencl_devices_active  = opencl_devices_active;
 }
 
-int backend_ctx_devices_init (hashcat_ctx_t *hashcat_ctx, const int comptime)
+static void backend_ctx_devices_init_native (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED int *virthost, MAYBE_UNUSED int *virthost_finder, int *backend_devices_idx, int *bridge_link_device)
 {
   backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
 
-  if (backend_ctx->enabled == false) return 0;
+  int native_devices_cnt    = 0;
+  int native_devices_active = 0;
 
-  user_options_t    *user_options  = hashcat_ctx->user_options;
-  hc_device_param_t *devices_param = backend_ctx->devices_param;
+  if (backend_ctx->native)
+  {
+    const user_options_t  *user_options  = hashcat_ctx->user_options;
 
-  backend_ctx->need_adl             = false;
-  backend_ctx->need_nvml            = false;
-  backend_ctx->need_nvapi           = false;
-  backend_ctx->need_sysfs_amdgpu    = false;
-  backend_ctx->need_sysfs_intelgpu  = false;
-  backend_ctx->need_sysfs_cpu       = false;
-  backend_ctx->need_iokit           = false;
+    hc_device_param_t     *devices_param = backend_ctx->devices_param;
 
-  int bridge_link_device = 0; // this will only count active device
+    NATIVE_PTR *native = (NATIVE_PTR *) backend_ctx->native;
 
-  int backend_devices_idx = 0; // this will not only count active devices
+    // there is only one host, so no virtualization
 
-  int virthost = -1;
-  int virthost_finder = user_options->backend_devices_virthost;
+    native_devices_cnt = 1;
 
-  // CUDA
+    backend_ctx->native_devices_cnt = native_devices_cnt;
 
-  backend_ctx_devices_init_cuda (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+    // device specific
 
-  // HIP
+    for (int native_devices_idx = 0; native_devices_idx < native_devices_cnt; native_devices_idx++, (*backend_devices_idx)++)
+    {
+      const u32 device_id = *backend_devices_idx;
 
-  backend_ctx_devices_init_hip (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+      hc_device_param_t *device_param = &devices_param[*backend_devices_idx];
 
-  // Metal
+      device_param->device_id = device_id;
 
-  backend_ctx_devices_init_metal (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+      backend_ctx->backend_device_from_native[native_devices_idx] = *backend_devices_idx;
 
-  // OCL
+      device_param->is_cuda   = false;
+      device_param->is_hip    = false;
+      device_param->is_metal  = false;
+      device_param->is_opencl = false;
+      device_param->is_native = true;
 
-  backend_ctx_devices_init_opencl (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+      device_param->use_opencl11 = false;
+      device_param->use_opencl12 = false;
+      device_param->use_opencl20 = false;
+      device_param->use_opencl30 = false;
 
-  // all devices combined go into backend_* variables
+      // some attributes have to be hardcoded values because they are used for instance in the build options
+      // memory is host memory, there is no faster local memory
 
-  backend_ctx->backend_devices_cnt    = backend_ctx->cuda_devices_cnt    + backend_ctx->hip_devices_cnt    + backend_ctx->metal_devices_cnt    + backend_ctx->opencl_devices_cnt;
-  backend_ctx->backend_devices_active = backend_ctx->cuda_devices_active + backend_ctx->hip_devices_active + backend_ctx->metal_devices_active + backend_ctx->opencl_devices_active;
+      device_param->device_local_mem_type     = CL_GLOBAL;
+      device_param->opencl_device_type        = CL_DEVICE_TYPE_CPU;
+      device_param->opencl_device_vendor_id   = VENDOR_ID_GENERIC;
+      device_param->opencl_platform_vendor_id = VENDOR_ID_GENERIC;
 
-  #if defined (__APPLE__)
-  // disable Metal devices if at least one OpenCL device is enabled
-  if (backend_ctx->opencl_devices_active > 0)
-  {
-    if (backend_ctx->mtl)
-    {
-      for (int backend_devices_cnt = 0; backend_devices_cnt < backend_ctx->backend_devices_cnt; backend_devices_cnt++)
-      {
-        hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_cnt];
+      // or in the cached kernel checksum
 
-        if (device_param->is_metal == false) continue;
+      device_param->opencl_device_version     = "";
+      device_param->opencl_driver_version     = native->version;
 
-        // Since we can't match OpenCL with Metal devices (missing PCI ID etc.) and at the same time we have better OpenCL support than Metal support,
-        // we disable all Metal devices by default. The user can reactivate them with -d.
+      // or just to make sure they are not NULL
 
-        if (device_param->skipped == false)
-        {
-          if (backend_ctx->backend_devices_filter[device_param->device_id] == 1)
-          {
-            if ((user_options->quiet == false) && (user_options->backend_info == 0))
-            {
-              event_log_warning (hashcat_ctx, "The device #%d has been disabled as it most likely also exists as an OpenCL device, but it is not possible to automatically map it.", device_param->device_id + 1);
-              event_log_warning (hashcat_ctx, "You can use -d %d to use Metal API instead of OpenCL API. In some rare cases this is more stable.", device_param->device_id + 1);
-              event_log_warning (hashcat_ctx, NULL);
-            }
+      device_param->opencl_device_vendor      = "";
+      device_param->opencl_device_c_version   = "";
 
-            device_param->skipped = true;
-          }
-          else
-          {
-            if (backend_ctx->backend_devices_filter[device_param->device_id])
-            {
-              // ok
-            }
-            else
-            {
-              device_param->skipped = true;
-            }
-          }
+      // device_name
 
-          if (device_param->skipped == true)
-          {
-            backend_ctx->metal_devices_active--;
-            backend_ctx->backend_devices_active--;
-          }
-        }
-      }
-    }
-  }
-  #endif
+      char *device_name = (char *) hcmalloc (HCBUFSIZ_TINY);
 
-  // find duplicate devices
+      snprintf (device_name, HCBUFSIZ_TINY, "Native Host CPU (%d threads)", hc_get_processor_count ());
 
-  //if ((cuda_devices_cnt > 0) && (hip_devices_cnt > 0) && (opencl_devices_cnt > 0))
-  //{
-    // using force here enables both devices, which is the worst possible outcome
-    // many users force by default, so this is not a good idea
+      device_param->device_name = device_name;
+
+      // device_processors
+      // one pool thread per logical processor, each runs a share of the work-items of a launch
+
+      device_param->device_processors = hc_get_processor_count ();
+
+      device_param->device_host_unified_memory = 1;
+
+      // device_global_mem, device_maxmem_alloc, device_available_mem
+      // "device" buffers are plain host allocations, so the limit is what the host has free right now
+
+      u64 free_mem = 0;
+
+      if (get_free_memory (&free_mem) == false)
+      {
+        event_log_error (hashcat_ctx, "* Device #%u: Failed to query free host memory.", device_id + 1);
+
+        device_param->skipped = true;
+
+        continue;
+      }
+
+      device_param->device_global_mem    = free_mem;
+      device_param->device_maxmem_alloc  = free_mem / 4;
+      device_param->device_available_mem = (free_mem * (100 - user_options->backend_devices_keepfree)) / 100;
+
+      // work-groups are of size 1, a work-item is a call of the kernel function
+
+      device_param->device_maxworkgroup_size      = 1;
+      device_param->kernel_preferred_wgs_multiple = 1;
+
+      device_param->device_maxclock_frequency = 0;
+
+      device_param->kernel_exec_timeout = 0;
+
+      // local memory is emulated by the kernels as private arrays on the stack
+
+      device_param->device_local_mem_size = 64 * 1024;
+
+      // skipped
+
+      if (backend_ctx->backend_devices_filter[device_id] == 1)
+      {
+        device_param->skipped = true;
+      }
+
+      // CPU burning loop damper
+      // the host thread waits on the pool, no spinning
+
+      device_param->spin_damp = 0;
+
+      // instruction set
+
+      device_param->has_add   = false;
+      device_param->has_addc  = false;
+      device_param->has_sub   = false;
+      device_param->has_subc  = false;
+      device_param->has_bfe   = false;
+      device_param->has_lop3  = false;
+      device_param->has_mov64 = false;
+      device_param->has_prmt  = false;
+      device_param->has_shfw  = false;
+
+      /**
+       * activate device
+       */
+
+      if (device_param->skipped == false)
+      {
+        if (hc_nativePoolCreate (hashcat_ctx, &device_param->native_pool, device_param->device_processors) == -1)
+        {
+          device_param->skipped = true;
+
+          continue;
+        }
+
+        #if defined (__linux__)
+        backend_ctx->need_sysfs_cpu = true;
+        #endif
+
+        device_param->bridge_link_device = (*bridge_link_device)++;
+
+        native_devices_active++;
+      }
+    }
+  }
+
+  backend_ctx->native_devices_cnt     = native_devices_cnt;
+  backend_ctx->native_devices_active  = native_devices_active;
+}
+
+int backend_ctx_devices_init (hashcat_ctx_t *hashcat_ctx, const int comptime)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  if (backend_ctx->enabled == false) return 0;
+
+  user_options_t    *user_options  = hashcat_ctx->user_options;
+  hc_device_param_t *devices_param = backend_ctx->devices_param;
+
+  backend_ctx->need_adl             = false;
+  backend_ctx->need_nvml            = false;
+  backend_ctx->need_nvapi           = false;
+  backend_ctx->need_sysfs_amdgpu    = false;
+  backend_ctx->need_sysfs_intelgpu  = false;
+  backend_ctx->need_sysfs_cpu       = false;
+  backend_ctx->need_iokit           = false;
+
+  int bridge_link_device = 0; // this will only count active device
+
+  int backend_devices_idx = 0; // this will not only count active devices
+
+  int virthost = -1;
+  int virthost_finder = user_options->backend_devices_virthost;
+
+  // CUDA
+
+  backend_ctx_devices_init_cuda (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+
+  // HIP
+
+  backend_ctx_devices_init_hip (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+
+  // Metal
+
+  backend_ctx_devices_init_metal (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+
+  // OCL
+
+  backend_ctx_devices_init_opencl (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+
+  // Native
+
+  backend_ctx_devices_init_native (hashcat_ctx, &virthost, &virthost_finder, &backend_devices_idx, &bridge_link_device);
+
+  // all devices combined go into backend_* variables
+
+  backend_ctx->backend_devices_cnt    = backend_ctx->cuda_devices_cnt    + backend_ctx->hip_devices_cnt    + backend_ctx->metal_devices_cnt    + backend_ctx->opencl_devices_cnt    + backend_ctx->native_devices_cnt;
+  backend_ctx->backend_devices_active = backend_ctx->cuda_devices_active + backend_ctx->hip_devices_active + backend_ctx->metal_devices_active + backend_ctx->opencl_devices_active + backend_ctx->native_devices_active;
+
+  #if defined (__APPLE__)
+  // disable Metal devices if at least one OpenCL device is enabled
+  if (backend_ctx->opencl_devices_active > 0)
+  {
+    if (backend_ctx->mtl)
+    {
+      for (int backend_devices_cnt = 0; backend_devices_cnt < backend_ctx->backend_devices_cnt; backend_devices_cnt++)
+      {
+        hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_cnt];
+
+        if (device_param->is_metal == false) continue;
+
+        // Since we can't match OpenCL with Metal devices (missing PCI ID etc.) and at the same time we have better OpenCL support than Metal support,
+        // we disable all Metal devices by default. The user can reactivate them with -d.
+
+        if (device_param->skipped == false)
+        {
+          if (backend_ctx->backend_devices_filter[device_param->device_id] == 1)
+          {
+            if ((user_options->quiet == false) && (user_options->backend_info == 0))
+            {
+              event_log_warning (hashcat_ctx, "The device #%d has been disabled as it most likely also exists as an OpenCL device, but it is not possible to automatically map it.", device_param->device_id + 1);
+              event_log_warning (hashcat_ctx, "You can use -d %d to use Metal API instead of OpenCL API. In some rare cases this is more stable.", device_param->device_id + 1);
+              event_log_warning (hashcat_ctx, NULL);
+            }
+
+            device_param->skipped = true;
+          }
+          else
+          {
+            if (backend_ctx->backend_devices_filter[device_param->device_id])
+            {
+              // ok
+            }
+            else
+            {
+              device_param->skipped = true;
+            }
+          }
+
+          if (device_param->skipped == true)
+          {
+            backend_ctx->metal_devices_active--;
+            backend_ctx->backend_devices_active--;
+          }
+        }
+      }
+    }
+  }
+  #endif
+
+  // find duplicate devices
+
+  //if ((cuda_devices_cnt > 0) && (hip_devices_cnt > 0) && (opencl_devices_cnt > 0))
+  //{
+    // using force here enables both devices, which is the worst possible outcome
+    // many users force by default, so this is not a good idea
 
     //if (user_options->force == false)
     //{
@@ -9034,6 +10065,25 @@ int backend_ctx_devices_init (hashcat_ctx_t *hashcat_ctx, const int comptime)
     return -1;
   }
 
+  // bridge units are spread over the NUMA nodes, the bridge does the same mapping for its own unit memory
+
+  bridge_ctx_t *bridge_ctx = hashcat_ctx->bridge_ctx;
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    hc_device_param_t *device_param = &devices_param[backend_devices_idx];
+
+    device_param->numa_node = -1;
+
+    if (device_param->skipped == true) continue;
+
+    if ((backend_ctx->numa_enabled == false) || (bridge_ctx->enabled == false)) continue;
+
+    const int units_cnt = bridge_ctx->get_unit_count (bridge_ctx->platform_context);
+
+    device_param->numa_node = numa_node_for_unit (&backend_ctx->numa_topology, device_param->bridge_link_device, units_cnt);
+  }
+
   backend_ctx->target_msec  = TARGET_MSEC_PROFILE[user_options->workload_profile - 1];
 
   backend_ctx->comptime = comptime;
@@ -9111,6 +10161,11 @@ void backend_ctx_devices_destroy (hashcat_ctx_t *hashcat_ctx)
         device_param->opencl_context = NULL;
       }
     }
+
+    if (device_param->is_native == true)
+    {
+      hc_nativePoolDestroy (hashcat_ctx, &device_param->native_pool);
+    }
   }
 
   backend_ctx->backend_devices_cnt    = 0;
@@ -9123,6 +10178,8 @@ void backend_ctx_devices_destroy (hashcat_ctx_t *hashcat_ctx)
   backend_ctx->metal_devices_active   = 0;
   backend_ctx->opencl_devices_cnt     = 0;
   backend_ctx->opencl_devices_active  = 0;
+  backend_ctx->native_devices_cnt     = 0;
+  backend_ctx->native_devices_active  = 0;
 
   backend_ctx->need_adl             = false;
   backend_ctx->need_nvml            = false;
@@ -9441,10 +10498,35 @@ static int get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx_t *hashcat_ctx,
   return 0;
 }
 
+static int get_native_kernel_wgs (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED const native_function_t *function, u32 *result)
+{
+  // a work-group is a single call of the kernel function
+
+  *result = 1;
+
+  return 0;
+}
+
+static int get_native_kernel_preferred_wgs_multiple (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED const native_function_t *function, u32 *result)
+{
+  *result = 1;
+
+  return 0;
+}
+
+static int get_native_kernel_local_mem_size (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED const native_function_t *function, u64 *result)
+{
+  // local memory is on the stack of the pool thread
+
+  *result = 0;
+
+  return 0;
+}
+
 #if defined (__APPLE__)
-static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, mtl_library *metal_library)
+static bool load_kernel_program (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, mtl_library *metal_library, native_module_t *native_module)
 #else
-static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, MAYBE_UNUSED void *metal_library)
+static bool load_kernel_program (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, MAYBE_UNUSED void *metal_library, native_module_t *native_module)
 #endif
 {
   const backend_ctx_t   *backend_ctx   = hashcat_ctx->backend_ctx;
@@ -9901,64 +10983,145 @@ static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_p
     }
     #endif // __APPLE__
 
-    if (device_param->is_opencl == true)
+    if (device_param->is_native == true)
     {
-      size_t build_log_size = 0;
+      // the host compiler writes a shared object, it is built next to the cache file and
+      // renamed afterwards so that a concurrent instance never loads a half written file
 
-      int CL_rc;
+      char *include_file = NULL;
+      char *output_file  = NULL;
 
-      cl_program p1 = NULL;
+      hc_asprintf (&include_file, "%s/inc_native.h", folder_config->cpath_real);
+      hc_asprintf (&output_file,  "%s.%u.tmp", cached_file, (u32) getpid ());
 
-      // workaround opencl issue with Apple Silicon
+      char *build_log = NULL;
 
-      if (strncmp (device_param->device_name, "Apple M", 7) == 0)
-      {
-        if (hc_clCreateProgramWithSource (hashcat_ctx, device_param->opencl_context, 1, (const char **) kernel_sources, NULL, opencl_program) == -1) return false;
+      const int rc_nativeCompile = hc_nativeCompile (hashcat_ctx, source_file, include_file, build_options_buf, output_file, &build_log);
 
-        CL_rc = hc_clBuildProgram (hashcat_ctx, *opencl_program, 1, &device_param->opencl_device, build_options_buf, NULL, NULL);
+      hcfree (include_file);
 
-        hc_clGetProgramBuildInfo (hashcat_ctx, *opencl_program, device_param->opencl_device, CL_PROGRAM_BUILD_LOG, 0, NULL, &build_log_size);
+      #if defined (DEBUG)
+      if ((build_log != NULL) && ((build_log[0] != 0) || (rc_nativeCompile == -1)))
+      #else
+      if ((build_log != NULL) && (rc_nativeCompile == -1))
+      #endif
+      {
+        puts (build_log);
       }
-      else
+
+      hcfree (build_log);
+
+      if (rc_nativeCompile == -1)
       {
-        if (hc_clCreateProgramWithSource (hashcat_ctx, device_param->opencl_context, 1, (const char **) kernel_sources, NULL, &p1) == -1) return false;
+        unlink (output_file);
 
-        CL_rc = hc_clCompileProgram (hashcat_ctx, p1, 1, &device_param->opencl_device, build_options_buf, 0, NULL, NULL, NULL, NULL);
+        hcfree (output_file);
 
-        hc_clGetProgramBuildInfo (hashcat_ctx, p1, device_param->opencl_device, CL_PROGRAM_BUILD_LOG, 0, NULL, &build_log_size);
+        return false;
       }
 
-      #if defined (DEBUG)
-      if ((build_log_size > 1) || (CL_rc == -1))
-      #else
-      if (CL_rc == -1)
-      #endif
+      if (cache_disable == false)
       {
-        char *build_log = (char *) hcmalloc (build_log_size + 1);
+        if (rename (output_file, cached_file) == -1)
+        {
+          event_log_error (hashcat_ctx, "%s: %s", cached_file, strerror (errno));
 
-        int rc_clGetProgramBuildInfo;
+          unlink (output_file);
 
-        if (strncmp (device_param->device_name, "Apple M", 7) == 0)
-        {
-          rc_clGetProgramBuildInfo = hc_clGetProgramBuildInfo (hashcat_ctx, *opencl_program, device_param->opencl_device, CL_PROGRAM_BUILD_LOG, build_log_size, build_log, NULL);
-        }
-        else
-        {
-          rc_clGetProgramBuildInfo = hc_clGetProgramBuildInfo (hashcat_ctx, p1, device_param->opencl_device, CL_PROGRAM_BUILD_LOG, build_log_size, build_log, NULL);
+          hcfree (output_file);
+
+          return false;
         }
 
-        if (rc_clGetProgramBuildInfo == -1)
+        if (hc_nativeModuleLoad (hashcat_ctx, native_module, cached_file) == -1)
         {
-          hcfree (build_log);
+          hcfree (output_file);
 
           return false;
         }
+      }
+      else
+      {
+        // dlopen() keeps the mapping, the file itself is no longer needed
 
-        build_log[build_log_size] = 0;
+        const int rc_nativeModuleLoad = hc_nativeModuleLoad (hashcat_ctx, native_module, output_file);
 
-        puts (build_log);
+        unlink (output_file);
 
-        hcfree (build_log);
+        if (rc_nativeModuleLoad == -1)
+        {
+          hcfree (output_file);
+
+          return false;
+        }
+      }
+
+      hcfree (output_file);
+
+      #if defined (DEBUG)
+      event_log_info (hashcat_ctx, "* Device #%u: Kernel %s load successful.", device_param->device_id + 1, source_file);
+      event_log_info (hashcat_ctx, NULL);
+      #endif
+    }
+
+    if (device_param->is_opencl == true)
+    {
+      size_t build_log_size = 0;
+
+      int CL_rc;
+
+      cl_program p1 = NULL;
+
+      // workaround opencl issue with Apple Silicon
+
+      if (strncmp (device_param->device_name, "Apple M", 7) == 0)
+      {
+        if (hc_clCreateProgramWithSource (hashcat_ctx, device_param->opencl_context, 1, (const char **) kernel_sources, NULL, opencl_program) == -1) return false;
+
+        CL_rc = hc_clBuildProgram (hashcat_ctx, *opencl_program, 1, &device_param->opencl_device, build_options_buf, NULL, NULL);
+
+        hc_clGetProgramBuildInfo (hashcat_ctx, *opencl_program, device_param->opencl_device, CL_PROGRAM_BUILD_LOG, 0, NULL, &build_log_size);
+      }
+      else
+      {
+        if (hc_clCreateProgramWithSource (hashcat_ctx, device_param->opencl_context, 1, (const char **) kernel_sources, NULL, &p1) == -1) return false;
+
+        CL_rc = hc_clCompileProgram (hashcat_ctx, p1, 1, &device_param->opencl_device, build_options_buf, 0, NULL, NULL, NULL, NULL);
+
+        hc_clGetProgramBuildInfo (hashcat_ctx, p1, device_param->opencl_device, CL_PROGRAM_BUILD_LOG, 0, NULL, &build_log_size);
+      }
+
+      #if defined (DEBUG)
+      if ((build_log_size > 1) || (CL_rc == -1))
+      #else
+      if (CL_rc == -1)
+      #endif
+      {
+        char *build_log = (char *) hcmalloc (build_log_size + 1);
+
+        int rc_clGetProgramBuildInfo;
+
+        if (strncmp (device_param->device_name, "Apple M", 7) == 0)
+        {
+          rc_clGetProgramBuildInfo = hc_clGetProgramBuildInfo (hashcat_ctx, *opencl_program, device_param->opencl_device, CL_PROGRAM_BUILD_LOG, build_log_size, build_log, NULL);
+        }
+        else
+        {
+          rc_clGetProgramBuildInfo = hc_clGetProgramBuildInfo (hashcat_ctx, p1, device_param->opencl_device, CL_PROGRAM_BUILD_LOG, build_log_size, build_log, NULL);
+        }
+
+        if (rc_clGetProgramBuildInfo == -1)
+        {
+          hcfree (build_log);
+
+          return false;
+        }
+
+        build_log[build_log_size] = 0;
+
+        puts (build_log);
+
+        hcfree (build_log);
       }
 
       if (CL_rc == -1) return false;
@@ -10125,6 +11288,16 @@ static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_p
     }
     #endif
 
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeModuleLoad (hashcat_ctx, native_module, cached_file) == -1) return false;
+
+      #if defined (DEBUG)
+      event_log_info (hashcat_ctx, "* Device #%u: Kernel %s load successful.", device_param->device_id + 1, source_file);
+      event_log_info (hashcat_ctx, NULL);
+      #endif
+    }
+
     if (device_param->is_opencl == true)
     {
       if (hc_clCreateProgramWithBinary (hashcat_ctx, device_param->opencl_context, 1, &device_param->opencl_device, kernel_lengths, (const unsigned char **) kernel_sources, NULL, opencl_program) == -1) return false;
@@ -10138,6 +11311,84 @@ static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_p
   return true;
 }
 
+#if defined (__APPLE__)
+static void unload_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, char **program_file, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, mtl_library *metal_library, native_module_t *native_module)
+#else
+static void unload_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, char **program_file, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, MAYBE_UNUSED void *metal_library, native_module_t *native_module)
+#endif
+{
+  if (device_param->is_cuda == true)
+  {
+    hc_cuModuleUnloadPtr (hashcat_ctx, cuda_module);
+  }
+
+  if (device_param->is_hip == true)
+  {
+    hc_hipModuleUnloadPtr (hashcat_ctx, hip_module);
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    hc_mtlReleaseLibrary (hashcat_ctx, metal_library);
+  }
+  #endif
+
+  if (device_param->is_opencl == true)
+  {
+    hc_clReleaseProgramPtr (hashcat_ctx, opencl_program);
+  }
+
+  if (device_param->is_native == true)
+  {
+    hc_nativeModuleUnload (hashcat_ctx, native_module);
+  }
+
+  hcfree (*program_file);
+
+  *program_file = NULL;
+}
+
+/**
+ * a daemon keeps the programs between its jobs, see resident.c
+ * the cached kernel filename has a checksum of the build options, so the same name means the same program
+ */
+
+#if defined (__APPLE__)
+static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, char **program_file, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, mtl_library *metal_library, native_module_t *native_module)
+#else
+static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, char **program_file, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, MAYBE_UNUSED void *metal_library, native_module_t *native_module)
+#endif
+{
+  if ((cache_disable == false) && (*program_file != NULL))
+  {
+    if (strcmp (*program_file, cached_file) == 0) return true;
+  }
+
+  unload_kernel (hashcat_ctx, device_param, program_file, opencl_program, cuda_module, hip_module, metal_library, native_module);
+
+  if (load_kernel_program (hashcat_ctx, device_param, kernel_name, source_file, cached_file, build_options_buf, cache_disable, opencl_program, cuda_module, hip_module, metal_library, native_module) == false) return false;
+
+  *program_file = hcstrdup (cached_file);
+
+  return true;
+}
+
+static void unload_kernels (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  #if defined (__APPLE__)
+  unload_kernel (hashcat_ctx, device_param, &device_param->program_file, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, &device_param->metal_library, &device_param->native_module);
+  unload_kernel (hashcat_ctx, device_param, &device_param->program_file_mp, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, &device_param->metal_library_mp, &device_param->native_module_mp);
+  unload_kernel (hashcat_ctx, device_param, &device_param->program_file_amp, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, &device_param->metal_library_amp, &device_param->native_module_amp);
+  unload_kernel (hashcat_ctx, device_param, &device_param->program_file_shared, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, &device_param->metal_library_shared, &device_param->native_module_shared);
+  #else
+  unload_kernel (hashcat_ctx, device_param, &device_param->program_file, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, NULL, &device_param->native_module);
+  unload_kernel (hashcat_ctx, device_param, &device_param->program_file_mp, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, NULL, &device_param->native_module_mp);
+  unload_kernel (hashcat_ctx, device_param, &device_param->program_file_amp, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, NULL, &device_param->native_module_amp);
+  unload_kernel (hashcat_ctx, device_param, &device_param->program_file_shared, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, NULL, &device_param->native_module_shared);
+  #endif
+}
+
 static int backend_session_setup_cuda_kernel_shared (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
   // GPU memset
@@ -10446,6 +11697,106 @@ static int backend_session_setup_metal_kernel_shared (hashcat_ctx_t *hashcat_ctx
 }
 #endif // __APPLE__
 
+static int backend_session_setup_native_kernel_shared (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  // GPU memset
+
+  if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_memset, &device_param->native_module_shared, "gpu_memset") == -1)
+  {
+    event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "gpu_memset");
+
+    device_param->skipped_warning = true;
+
+    return -2; //continue;
+  }
+
+  if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_memset, &device_param->kernel_wgs_memset) == -1) return -1;
+
+  if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_memset, &device_param->kernel_local_mem_size_memset) == -1) return -1;
+
+  if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_memset, &device_param->kernel_preferred_wgs_multiple_memset) == -1) return -1;
+
+  device_param->kernel_dynamic_local_mem_size_memset = 0;
+
+  // GPU bzero
+
+  if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_bzero, &device_param->native_module_shared, "gpu_bzero") == -1)
+  {
+    event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "gpu_bzero");
+
+    device_param->skipped_warning = true;
+
+    return -2; //continue;
+  }
+
+  if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_bzero, &device_param->kernel_wgs_bzero) == -1) return -1;
+
+  if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_bzero, &device_param->kernel_local_mem_size_bzero) == -1) return -1;
+
+  if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_bzero, &device_param->kernel_preferred_wgs_multiple_bzero) == -1) return -1;
+
+  device_param->kernel_dynamic_local_mem_size_bzero = 0;
+
+  // GPU autotune init
+
+  if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_atinit, &device_param->native_module_shared, "gpu_atinit") == -1)
+  {
+    event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "gpu_atinit");
+
+    device_param->skipped_warning = true;
+
+    return -2; //continue;
+  }
+
+  if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_atinit, &device_param->kernel_wgs_atinit) == -1) return -1;
+
+  if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_atinit, &device_param->kernel_local_mem_size_atinit) == -1) return -1;
+
+  if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_atinit, &device_param->kernel_preferred_wgs_multiple_atinit) == -1) return -1;
+
+  device_param->kernel_dynamic_local_mem_size_atinit = 0;
+
+  // GPU decompress
+
+  if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_decompress, &device_param->native_module_shared, "gpu_decompress") == -1)
+  {
+    event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "gpu_decompress");
+
+    device_param->skipped_warning = true;
+
+    return -2; //continue;
+  }
+
+  if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_decompress, &device_param->kernel_wgs_decompress) == -1) return -1;
+
+  if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_decompress, &device_param->kernel_local_mem_size_decompress) == -1) return -1;
+
+  if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_decompress, &device_param->kernel_preferred_wgs_multiple_decompress) == -1) return -1;
+
+  device_param->kernel_dynamic_local_mem_size_decompress = 0;
+
+  // GPU utf8 to utf16le conversion
+
+  if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_utf8toutf16le, &device_param->native_module_shared, "gpu_utf8_to_utf16") == -1)
+  {
+    event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "gpu_utf8_to_utf16");
+
+    device_param->skipped_warning = true;
+
+    return -2; //continue;
+  }
+
+  if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_utf8toutf16le, &device_param->kernel_wgs_utf8toutf16le) == -1) return -1;
+
+  if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_utf8toutf16le, &device_param->kernel_local_mem_size_utf8toutf16le) == -1) return -1;
+
+  if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_utf8toutf16le, &device_param->kernel_preferred_wgs_multiple_utf8toutf16le) == -1) return -1;
+
+  device_param->kernel_dynamic_local_mem_size_utf8toutf16le = 0;
+
+  return 0;
+}
+
 static int backend_session_setup_opencl_kernel_shared (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
   // GPU memset
@@ -10520,37 +11871,750 @@ static int backend_session_setup_opencl_kernel_shared (hashcat_ctx_t *hashcat_ct
     return -2; //continue;
   }
 
-  if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_wgs_decompress) == -1) return -1;
+  if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_wgs_decompress) == -1) return -1;
+
+  if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_local_mem_size_decompress) == -1) return -1;
+
+  if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_dynamic_local_mem_size_decompress) == -1) return -1;
+
+  if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_preferred_wgs_multiple_decompress) == -1) return -1;
+
+  // GPU utf8 to utf16le conversion
+
+  if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_shared, "gpu_utf8_to_utf16", &device_param->opencl_kernel_utf8toutf16le) == -1)
+  {
+    event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "gpu_utf8_to_utf16");
+
+    device_param->skipped_warning = true;
+
+    return -2; //continue;
+  }
+
+  if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_utf8toutf16le, &device_param->kernel_wgs_utf8toutf16le) == -1) return -1;
+
+  if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_utf8toutf16le, &device_param->kernel_local_mem_size_utf8toutf16le) == -1) return -1;
+
+  if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_utf8toutf16le, &device_param->kernel_dynamic_local_mem_size_utf8toutf16le) == -1) return -1;
+
+  if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_utf8toutf16le, &device_param->kernel_preferred_wgs_multiple_utf8toutf16le) == -1) return -1;
+
+  return 0;
+}
+
+static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, int kern_type)
+{
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  char kernel_name[64] = { 0 };
+
+  if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+  {
+    if (hashconfig->opti_type & OPTI_TYPE_SINGLE_HASH)
+    {
+      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+      {
+        // kernel1
+
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 4);
+
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1)
+        {
+          event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+          device_param->skipped_warning = true;
+
+          return -2; // continue;
+        }
+
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+
+        device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
+
+        device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+
+        // kernel2
+
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 8);
+
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1)
+        {
+          event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+          device_param->skipped_warning = true;
+
+          return -2; // continue;
+        }
+
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+
+        device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
+
+        device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+
+        // kernel3
+
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 16);
+
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1)
+        {
+          event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+          device_param->skipped_warning = true;
+
+          return -2; // continue;
+        }
+
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+
+        device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
+
+        device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
+      }
+      else
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_sxx", kern_type);
+
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function4, device_param->cuda_module, kernel_name) == -1)
+        {
+          event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+          device_param->skipped_warning = true;
+
+          return -2; // continue;
+        }
+
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_wgs4) == -1) return -1;
+
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+
+        device_param->kernel_dynamic_local_mem_size4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size4;
+
+        device_param->kernel_preferred_wgs_multiple4 = device_param->cuda_warp_size;
+      }
+    }
+    else
+    {
+      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+      {
+        // kernel1
+
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 4);
+
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1)
+        {
+          event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+          device_param->skipped_warning = true;
+
+          return -2; // continue;
+        }
+
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+
+        device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
+
+        device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+
+        // kernel2
+
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 8);
+
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1)
+        {
+          event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+          device_param->skipped_warning = true;
+
+          return -2; // continue;
+        }
+
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+
+        device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
+
+        device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+
+        // kernel3
+
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 16);
+
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1)
+        {
+          event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+          device_param->skipped_warning = true;
+
+          return -2; // continue;
+        }
+
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+
+        device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
+
+        device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
+      }
+      else
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_mxx", kern_type);
+
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function4, device_param->cuda_module, kernel_name) == -1)
+        {
+          event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+          device_param->skipped_warning = true;
+
+          return -2; // continue;
+        }
+
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_wgs4) == -1) return -1;
+
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+
+        device_param->kernel_dynamic_local_mem_size4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size4;
+
+        device_param->kernel_preferred_wgs_multiple4 = device_param->cuda_warp_size;
+      }
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if (user_options->attack_mode == ATTACK_MODE_BF)
+      {
+        if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
+        {
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_tm", kern_type);
+
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_tm, device_param->cuda_module, kernel_name) == -1)
+          {
+            event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+            device_param->skipped_warning = true;
+
+            return -2; // continue;
+          }
+
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_wgs_tm) == -1) return -1;
+
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
+
+          device_param->kernel_dynamic_local_mem_size_tm = device_param->device_local_mem_size - device_param->kernel_local_mem_size_tm;
+
+          device_param->kernel_preferred_wgs_multiple_tm = device_param->cuda_warp_size;
+        }
+      }
+    }
+  }
+  else
+  {
+    // kernel1
+
+    snprintf (kernel_name, sizeof (kernel_name), "m%05u_init", kern_type);
+
+    if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1)
+    {
+      event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+      device_param->skipped_warning = true;
+
+      return -2; // continue;
+    }
+
+    if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+
+    if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+
+    device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
+
+    device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+
+    // kernel2
+
+    snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop", kern_type);
+
+    if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1)
+    {
+      event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+      device_param->skipped_warning = true;
+
+      return -2; // continue;
+    }
+
+    if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+
+    if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+
+    device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
+
+    device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+
+    // kernel3
+
+    snprintf (kernel_name, sizeof (kernel_name), "m%05u_comp", kern_type);
+
+    if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1)
+    {
+      event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+      device_param->skipped_warning = true;
+
+      return -2; // continue;
+    }
+
+    if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+
+    if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+
+    device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
+
+    device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
+
+    if (hashconfig->opts_type & OPTS_TYPE_LOOP_PREPARE)
+    {
+      // kernel2p
+
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_prepare", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2p, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2p, &device_param->kernel_wgs2p) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2p, &device_param->kernel_local_mem_size2p) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size2p = device_param->device_local_mem_size - device_param->kernel_local_mem_size2p;
+
+      device_param->kernel_preferred_wgs_multiple2p = device_param->cuda_warp_size;
+    }
+
+    if (hashconfig->opts_type & OPTS_TYPE_LOOP_EXTENDED)
+    {
+      // kernel2e
+
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_extended", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2e, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_wgs2e) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size2e = device_param->device_local_mem_size - device_param->kernel_local_mem_size2e;
+
+      device_param->kernel_preferred_wgs_multiple2e = device_param->cuda_warp_size;
+    }
+
+    // kernel12
+
+    if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook12", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function12, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_wgs12) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_local_mem_size12) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size12 = device_param->device_local_mem_size - device_param->kernel_local_mem_size12;
+
+      device_param->kernel_preferred_wgs_multiple12 = device_param->cuda_warp_size;
+    }
+
+    // kernel23
+
+    if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook23", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function23, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_wgs23) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_local_mem_size23) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size23 = device_param->device_local_mem_size - device_param->kernel_local_mem_size23;
+
+      device_param->kernel_preferred_wgs_multiple23 = device_param->cuda_warp_size;
+    }
+
+    // init2
+
+    if (hashconfig->opts_type & OPTS_TYPE_INIT2)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_init2", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_init2, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_wgs_init2) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_init2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_init2;
+
+      device_param->kernel_preferred_wgs_multiple_init2 = device_param->cuda_warp_size;
+    }
+
+    // loop2 prepare
+
+    if (hashconfig->opts_type & OPTS_TYPE_LOOP2_PREPARE)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2_prepare", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_loop2p, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_loop2p, &device_param->kernel_wgs_loop2p) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_loop2p, &device_param->kernel_local_mem_size_loop2p) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_loop2p = device_param->device_local_mem_size - device_param->kernel_local_mem_size_loop2p;
+
+      device_param->kernel_preferred_wgs_multiple_loop2p = device_param->cuda_warp_size;
+    }
+
+    // loop2
+
+    if (hashconfig->opts_type & OPTS_TYPE_LOOP2)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_loop2, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_loop2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_loop2;
+
+      device_param->kernel_preferred_wgs_multiple_loop2 = device_param->cuda_warp_size;
+    }
+
+    // aux1
+
+    if (hashconfig->opts_type & OPTS_TYPE_AUX1)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux1", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux1, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_aux1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux1;
+
+      device_param->kernel_preferred_wgs_multiple_aux1 = device_param->cuda_warp_size;
+    }
+
+    // aux2
+
+    if (hashconfig->opts_type & OPTS_TYPE_AUX2)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux2", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux2, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_aux2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux2;
+
+      device_param->kernel_preferred_wgs_multiple_aux2 = device_param->cuda_warp_size;
+    }
+
+    // aux3
+
+    if (hashconfig->opts_type & OPTS_TYPE_AUX3)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux3", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux3, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_aux3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux3;
+
+      device_param->kernel_preferred_wgs_multiple_aux3 = device_param->cuda_warp_size;
+    }
+
+    // aux4
+
+    if (hashconfig->opts_type & OPTS_TYPE_AUX4)
+    {
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux4", kern_type);
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux4, device_param->cuda_module, kernel_name) == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_aux4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux4;
+
+      device_param->kernel_preferred_wgs_multiple_aux4 = device_param->cuda_warp_size;
+    }
+  }
+
+  //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem),   device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
+  //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem),   device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
+  //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem),   device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
+  //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 3, sizeof (cl_ulong), device_param->kernel_params_decompress[3]); if (CL_rc == -1) return -1;
+
+  // MP start
+
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    if (user_options->attack_mode == ATTACK_MODE_BF)
+    {
+      // mp_l
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp_l, device_param->cuda_module_mp, "l_markov") == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "l_markov");
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_mp_l = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp_l;
+
+      device_param->kernel_preferred_wgs_multiple_mp_l = device_param->cuda_warp_size;
+
+      // mp_r
+
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp_r, device_param->cuda_module_mp, "r_markov") == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "r_markov");
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_mp_r = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp_r;
+
+      device_param->kernel_preferred_wgs_multiple_mp_r = device_param->cuda_warp_size;
+
+      if (user_options->attack_mode == ATTACK_MODE_BF)
+      {
+        if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
+        {
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 0, sizeof (cl_mem), device_param->kernel_params_tm[0]); if (CL_rc == -1) return -1;
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 1, sizeof (cl_mem), device_param->kernel_params_tm[1]); if (CL_rc == -1) return -1;
+        }
+      }
+    }
+    else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+    {
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp, device_param->cuda_module_mp, "C_markov") == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "C_markov");
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_mp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp;
+
+      device_param->kernel_preferred_wgs_multiple_mp = device_param->cuda_warp_size;
+    }
+    else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
+    {
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp, device_param->cuda_module_mp, "C_markov") == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "C_markov");
+
+        device_param->skipped_warning = true;
+
+        return -2; // continue;
+      }
+
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+
+      device_param->kernel_dynamic_local_mem_size_mp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp;
+
+      device_param->kernel_preferred_wgs_multiple_mp = device_param->cuda_warp_size;
+    }
+  }
+
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    {
+      // nothing to do
+    }
+    else
+    {
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_amp, device_param->cuda_module_amp, "amp") == -1)
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "amp");
+
+        device_param->skipped_warning = true;
 
-  if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_local_mem_size_decompress) == -1) return -1;
+        return -2; // continue;
+      }
 
-  if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_dynamic_local_mem_size_decompress) == -1) return -1;
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_wgs_amp) == -1) return -1;
 
-  if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_preferred_wgs_multiple_decompress) == -1) return -1;
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
 
-  // GPU utf8 to utf16le conversion
+      device_param->kernel_dynamic_local_mem_size_amp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_amp;
 
-  if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_shared, "gpu_utf8_to_utf16", &device_param->opencl_kernel_utf8toutf16le) == -1)
-  {
-    event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "gpu_utf8_to_utf16");
+      device_param->kernel_preferred_wgs_multiple_amp = device_param->cuda_warp_size;
+    }
 
-    device_param->skipped_warning = true;
+    /*
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    {
+      // nothing to do
+    }
+    else
+    {
+      for (u32 i = 0; i < 5; i++)
+      {
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_mem), device_param->kernel_params_amp[i]);
 
-    return -2; //continue;
-  }
+        //if (CL_rc == -1) return -1;
+      }
 
-  if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_utf8toutf16le, &device_param->kernel_wgs_utf8toutf16le) == -1) return -1;
+      for (u32 i = 5; i < 6; i++)
+      {
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_uint), device_param->kernel_params_amp[i]);
 
-  if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_utf8toutf16le, &device_param->kernel_local_mem_size_utf8toutf16le) == -1) return -1;
+        //if (CL_rc == -1) return -1;
+      }
 
-  if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_utf8toutf16le, &device_param->kernel_dynamic_local_mem_size_utf8toutf16le) == -1) return -1;
+      for (u32 i = 6; i < 7; i++)
+      {
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_ulong), device_param->kernel_params_amp[i]);
 
-  if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_utf8toutf16le, &device_param->kernel_preferred_wgs_multiple_utf8toutf16le) == -1) return -1;
+        //if (CL_rc == -1) return -1;
+      }
+    }
+    */
+  }
 
   return 0;
 }
 
-static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, int kern_type)
+static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, int kern_type)
 {
   const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
   const user_options_t *user_options = hashcat_ctx->user_options;
@@ -10567,85 +12631,85 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 4);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1)
+        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function1, device_param->hip_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
           device_param->skipped_warning = true;
 
-          return -2; // continue;
+          return -2; //continue;
         }
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
 
-        device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple1 = device_param->hip_warp_size;
 
         // kernel2
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 8);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1)
+        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2, device_param->hip_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
           device_param->skipped_warning = true;
 
-          return -2; // continue;
+          return -2; //continue;
         }
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
 
-        device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple2 = device_param->hip_warp_size;
 
         // kernel3
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 16);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1)
+        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function3, device_param->hip_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
           device_param->skipped_warning = true;
 
-          return -2; // continue;
+          return -2; //continue;
         }
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
 
-        device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple3 = device_param->hip_warp_size;
       }
       else
       {
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_sxx", kern_type);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function4, device_param->cuda_module, kernel_name) == -1)
+        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function4, device_param->hip_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
           device_param->skipped_warning = true;
 
-          return -2; // continue;
+          return -2; //continue;
         }
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_wgs4) == -1) return -1;
+        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function4, &device_param->kernel_wgs4) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size4;
 
-        device_param->kernel_preferred_wgs_multiple4 = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple4 = device_param->hip_warp_size;
       }
     }
     else
@@ -10656,85 +12720,85 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 4);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1)
+        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function1, device_param->hip_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
           device_param->skipped_warning = true;
 
-          return -2; // continue;
+          return -2; //continue;
         }
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
 
-        device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple1 = device_param->hip_warp_size;
 
         // kernel2
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 8);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1)
+        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2, device_param->hip_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
           device_param->skipped_warning = true;
 
-          return -2; // continue;
+          return -2; //continue;
         }
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
 
-        device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple2 = device_param->hip_warp_size;
 
         // kernel3
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 16);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1)
+        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function3, device_param->hip_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
           device_param->skipped_warning = true;
 
-          return -2; // continue;
+          return -2; //continue;
         }
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
 
-        device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple3 = device_param->hip_warp_size;
       }
       else
       {
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_mxx", kern_type);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function4, device_param->cuda_module, kernel_name) == -1)
+        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function4, device_param->hip_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
           device_param->skipped_warning = true;
 
-          return -2; // continue;
+          return -2; //continue;
         }
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_wgs4) == -1) return -1;
+        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function4, &device_param->kernel_wgs4) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size4;
 
-        device_param->kernel_preferred_wgs_multiple4 = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple4 = device_param->hip_warp_size;
       }
     }
 
@@ -10749,22 +12813,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
         {
           snprintf (kernel_name, sizeof (kernel_name), "m%05u_tm", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_tm, device_param->cuda_module, kernel_name) == -1)
+          if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_tm, device_param->hip_module, kernel_name) == -1)
           {
             event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
             device_param->skipped_warning = true;
 
-            return -2; // continue;
+            return -2; //continue;
           }
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_wgs_tm) == -1) return -1;
+          if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_tm, &device_param->kernel_wgs_tm) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
+          if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
 
           device_param->kernel_dynamic_local_mem_size_tm = device_param->device_local_mem_size - device_param->kernel_local_mem_size_tm;
 
-          device_param->kernel_preferred_wgs_multiple_tm = device_param->cuda_warp_size;
+          device_param->kernel_preferred_wgs_multiple_tm = device_param->hip_warp_size;
         }
       }
     }
@@ -10775,64 +12839,64 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_init", kern_type);
 
-    if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1)
+    if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function1, device_param->hip_module, kernel_name) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
       device_param->skipped_warning = true;
 
-      return -2; // continue;
+      return -2; //continue;
     }
 
-    if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+    if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-    if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+    if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
     device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
 
-    device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+    device_param->kernel_preferred_wgs_multiple1 = device_param->hip_warp_size;
 
     // kernel2
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop", kern_type);
 
-    if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1)
+    if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2, device_param->hip_module, kernel_name) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
       device_param->skipped_warning = true;
 
-      return -2; // continue;
+      return -2; //continue;
     }
 
-    if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+    if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-    if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+    if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
     device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
 
-    device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+    device_param->kernel_preferred_wgs_multiple2 = device_param->hip_warp_size;
 
     // kernel3
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_comp", kern_type);
 
-    if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1)
+    if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function3, device_param->hip_module, kernel_name) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
       device_param->skipped_warning = true;
 
-      return -2; // continue;
+      return -2; //continue;
     }
 
-    if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+    if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-    if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+    if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
     device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
 
-    device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
+    device_param->kernel_preferred_wgs_multiple3 = device_param->hip_warp_size;
 
     if (hashconfig->opts_type & OPTS_TYPE_LOOP_PREPARE)
     {
@@ -10840,22 +12904,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_prepare", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2p, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2p, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2p, &device_param->kernel_wgs2p) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2p, &device_param->kernel_wgs2p) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2p, &device_param->kernel_local_mem_size2p) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2p, &device_param->kernel_local_mem_size2p) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size2p = device_param->device_local_mem_size - device_param->kernel_local_mem_size2p;
 
-      device_param->kernel_preferred_wgs_multiple2p = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple2p = device_param->hip_warp_size;
     }
 
     if (hashconfig->opts_type & OPTS_TYPE_LOOP_EXTENDED)
@@ -10864,22 +12928,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_extended", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2e, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2e, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_wgs2e) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2e, &device_param->kernel_wgs2e) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size2e = device_param->device_local_mem_size - device_param->kernel_local_mem_size2e;
 
-      device_param->kernel_preferred_wgs_multiple2e = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple2e = device_param->hip_warp_size;
     }
 
     // kernel12
@@ -10888,22 +12952,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook12", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function12, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function12, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_wgs12) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function12, &device_param->kernel_wgs12) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_local_mem_size12) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function12, &device_param->kernel_local_mem_size12) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size12 = device_param->device_local_mem_size - device_param->kernel_local_mem_size12;
 
-      device_param->kernel_preferred_wgs_multiple12 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple12 = device_param->hip_warp_size;
     }
 
     // kernel23
@@ -10912,22 +12976,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook23", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function23, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function23, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_wgs23) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function23, &device_param->kernel_wgs23) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_local_mem_size23) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function23, &device_param->kernel_local_mem_size23) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size23 = device_param->device_local_mem_size - device_param->kernel_local_mem_size23;
 
-      device_param->kernel_preferred_wgs_multiple23 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple23 = device_param->hip_warp_size;
     }
 
     // init2
@@ -10936,22 +13000,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_init2", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_init2, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_init2, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_wgs_init2) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_init2, &device_param->kernel_wgs_init2) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_init2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_init2;
 
-      device_param->kernel_preferred_wgs_multiple_init2 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_init2 = device_param->hip_warp_size;
     }
 
     // loop2 prepare
@@ -10960,22 +13024,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2_prepare", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_loop2p, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_loop2p, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_loop2p, &device_param->kernel_wgs_loop2p) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_loop2p, &device_param->kernel_wgs_loop2p) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_loop2p, &device_param->kernel_local_mem_size_loop2p) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_loop2p, &device_param->kernel_local_mem_size_loop2p) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_loop2p = device_param->device_local_mem_size - device_param->kernel_local_mem_size_loop2p;
 
-      device_param->kernel_preferred_wgs_multiple_loop2p = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_loop2p = device_param->hip_warp_size;
     }
 
     // loop2
@@ -10984,22 +13048,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_loop2, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_loop2, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_loop2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_loop2;
 
-      device_param->kernel_preferred_wgs_multiple_loop2 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_loop2 = device_param->hip_warp_size;
     }
 
     // aux1
@@ -11008,22 +13072,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux1", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux1, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_aux1, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_aux1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux1;
 
-      device_param->kernel_preferred_wgs_multiple_aux1 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_aux1 = device_param->hip_warp_size;
     }
 
     // aux2
@@ -11032,22 +13096,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux2", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux2, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_aux2, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_aux2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux2;
 
-      device_param->kernel_preferred_wgs_multiple_aux2 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_aux2 = device_param->hip_warp_size;
     }
 
     // aux3
@@ -11056,22 +13120,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux3", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux3, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_aux3, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_aux3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux3;
 
-      device_param->kernel_preferred_wgs_multiple_aux3 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_aux3 = device_param->hip_warp_size;
     }
 
     // aux4
@@ -11080,22 +13144,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux4", kern_type);
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux4, device_param->cuda_module, kernel_name) == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_aux4, device_param->hip_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_aux4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux4;
 
-      device_param->kernel_preferred_wgs_multiple_aux4 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_aux4 = device_param->hip_warp_size;
     }
   }
 
@@ -11115,41 +13179,41 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       // mp_l
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp_l, device_param->cuda_module_mp, "l_markov") == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_mp_l, device_param->hip_module_mp, "l_markov") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "l_markov");
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_mp_l = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp_l;
 
-      device_param->kernel_preferred_wgs_multiple_mp_l = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_mp_l = device_param->hip_warp_size;
 
       // mp_r
 
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp_r, device_param->cuda_module_mp, "r_markov") == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_mp_r, device_param->hip_module_mp, "r_markov") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "r_markov");
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_mp_r = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp_r;
 
-      device_param->kernel_preferred_wgs_multiple_mp_r = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_mp_r = device_param->hip_warp_size;
 
       if (user_options->attack_mode == ATTACK_MODE_BF)
       {
@@ -11162,41 +13226,41 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     }
     else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
     {
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp, device_param->cuda_module_mp, "C_markov") == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_mp, device_param->hip_module_mp, "C_markov") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "C_markov");
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_mp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp;
 
-      device_param->kernel_preferred_wgs_multiple_mp = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_mp = device_param->hip_warp_size;
     }
     else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
     {
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp, device_param->cuda_module_mp, "C_markov") == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_mp, device_param->hip_module_mp, "C_markov") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "C_markov");
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_mp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp;
 
-      device_param->kernel_preferred_wgs_multiple_mp = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_mp = device_param->hip_warp_size;
     }
   }
 
@@ -11211,22 +13275,22 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
     }
     else
     {
-      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_amp, device_param->cuda_module_amp, "amp") == -1)
+      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_amp, device_param->hip_module_amp, "amp") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "amp");
 
         device_param->skipped_warning = true;
 
-        return -2; // continue;
+        return -2; //continue;
       }
 
-      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_wgs_amp) == -1) return -1;
+      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_amp, &device_param->kernel_wgs_amp) == -1) return -1;
 
-      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
+      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_amp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_amp;
 
-      device_param->kernel_preferred_wgs_multiple_amp = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple_amp = device_param->hip_warp_size;
     }
 
     /*
@@ -11263,7 +13327,8 @@ static int backend_session_setup_cuda_kernel_types (hashcat_ctx_t *hashcat_ctx,
   return 0;
 }
 
-static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, int kern_type)
+#if defined (__APPLE__)
+static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, int kern_type)
 {
   const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
   const user_options_t *user_options = hashcat_ctx->user_options;
@@ -11276,11 +13341,11 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
     {
       if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
       {
-        // kernel1
+        // kernel1: m%05u_s%02d
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 4);
 
-        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function1, device_param->hip_module, kernel_name) == -1)
+        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function1, &device_param->metal_pipeline1) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11289,19 +13354,19 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
           return -2; //continue;
         }
 
-        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function1, &device_param->kernel_wgs1) == -1) return -1;
+        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_wgs1) == -1) return -1;
 
-        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-        device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
+        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple1 = device_param->hip_warp_size;
+        device_param->kernel_dynamic_local_mem_size1 = 0;
 
-        // kernel2
+        // kernel2: m%05u_s%02d
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 8);
 
-        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2, device_param->hip_module, kernel_name) == -1)
+        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2, &device_param->metal_pipeline2) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11310,19 +13375,19 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
           return -2; //continue;
         }
 
-        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2, &device_param->kernel_wgs2) == -1) return -1;
+        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_wgs2) == -1) return -1;
 
-        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-        device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
+        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple2 = device_param->hip_warp_size;
+        device_param->kernel_dynamic_local_mem_size2 = 0;
 
-        // kernel3
+        // kernel3: m%05u_s%02d
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 16);
 
-        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function3, device_param->hip_module, kernel_name) == -1)
+        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function3, &device_param->metal_pipeline3) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11331,19 +13396,21 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
           return -2; //continue;
         }
 
-        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function3, &device_param->kernel_wgs3) == -1) return -1;
+        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_wgs3) == -1) return -1;
 
-        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-        device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
+        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple3 = device_param->hip_warp_size;
+        device_param->kernel_dynamic_local_mem_size3 = 0;
       }
       else
       {
+        // kernel4: m%05u_sxx
+
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_sxx", kern_type);
 
-        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function4, device_param->hip_module, kernel_name) == -1)
+        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function4, &device_param->metal_pipeline4) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11352,16 +13419,16 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
           return -2; //continue;
         }
 
-        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function4, &device_param->kernel_wgs4) == -1) return -1;
+        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_wgs4) == -1) return -1;
 
-        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
-        device_param->kernel_dynamic_local_mem_size4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size4;
+        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple4 = device_param->hip_warp_size;
+        device_param->kernel_dynamic_local_mem_size4 = 0;
       }
     }
-    else
+    else // multi
     {
       if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
       {
@@ -11369,7 +13436,7 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 4);
 
-        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function1, device_param->hip_module, kernel_name) == -1)
+        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function1, &device_param->metal_pipeline1) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11378,19 +13445,19 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
           return -2; //continue;
         }
 
-        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function1, &device_param->kernel_wgs1) == -1) return -1;
+        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_wgs1) == -1) return -1;
 
-        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-        device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
+        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple1 = device_param->hip_warp_size;
+        device_param->kernel_dynamic_local_mem_size1 = 0;
 
         // kernel2
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 8);
 
-        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2, device_param->hip_module, kernel_name) == -1)
+        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2, &device_param->metal_pipeline2) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11399,19 +13466,19 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
           return -2; //continue;
         }
 
-        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2, &device_param->kernel_wgs2) == -1) return -1;
+        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_wgs2) == -1) return -1;
 
-        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-        device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
+        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple2 = device_param->hip_warp_size;
+        device_param->kernel_dynamic_local_mem_size2 = 0;
 
         // kernel3
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 16);
 
-        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function3, device_param->hip_module, kernel_name) == -1)
+        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function3, &device_param->metal_pipeline3) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11420,19 +13487,21 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
           return -2; //continue;
         }
 
-        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function3, &device_param->kernel_wgs3) == -1) return -1;
+        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_wgs3) == -1) return -1;
 
-        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-        device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
+        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple3 = device_param->hip_warp_size;
+        device_param->kernel_dynamic_local_mem_size3 = 0;
       }
       else
       {
+        // kernel4
+
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_mxx", kern_type);
 
-        if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function4, device_param->hip_module, kernel_name) == -1)
+        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function4, &device_param->metal_pipeline4) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11441,13 +13510,13 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
           return -2; //continue;
         }
 
-        if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function4, &device_param->kernel_wgs4) == -1) return -1;
+        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_wgs4) == -1) return -1;
 
-        if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
-        device_param->kernel_dynamic_local_mem_size4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size4;
+        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple4 = device_param->hip_warp_size;
+        device_param->kernel_dynamic_local_mem_size4 = 0;
       }
     }
 
@@ -11462,7 +13531,7 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         {
           snprintf (kernel_name, sizeof (kernel_name), "m%05u_tm", kern_type);
 
-          if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_tm, device_param->hip_module, kernel_name) == -1)
+          if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_tm, &device_param->metal_pipeline_tm) == -1)
           {
             event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11471,24 +13540,24 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
             return -2; //continue;
           }
 
-          if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_tm, &device_param->kernel_wgs_tm) == -1) return -1;
+          if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_tm, &device_param->kernel_wgs_tm) == -1) return -1;
 
-          if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
+          if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
 
-          device_param->kernel_dynamic_local_mem_size_tm = device_param->device_local_mem_size - device_param->kernel_local_mem_size_tm;
+          if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_tm, &device_param->kernel_preferred_wgs_multiple_tm) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_tm = device_param->hip_warp_size;
+          device_param->kernel_dynamic_local_mem_size_tm = 0;
         }
       }
     }
   }
   else
   {
-    // kernel1
+    // kernel1: m%05u_init
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_init", kern_type);
 
-    if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function1, device_param->hip_module, kernel_name) == -1)
+    if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function1, &device_param->metal_pipeline1) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11497,19 +13566,19 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
       return -2; //continue;
     }
 
-    if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function1, &device_param->kernel_wgs1) == -1) return -1;
+    if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_wgs1) == -1) return -1;
 
-    if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+    if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-    device_param->kernel_dynamic_local_mem_size1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size1;
+    if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
-    device_param->kernel_preferred_wgs_multiple1 = device_param->hip_warp_size;
+    device_param->kernel_dynamic_local_mem_size1 = 0;
 
-    // kernel2
+    // kernel2: m%05u_loop
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop", kern_type);
 
-    if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2, device_param->hip_module, kernel_name) == -1)
+    if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2, &device_param->metal_pipeline2) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11518,19 +13587,19 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
       return -2; //continue;
     }
 
-    if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2, &device_param->kernel_wgs2) == -1) return -1;
+    if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_wgs2) == -1) return -1;
 
-    if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+    if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-    device_param->kernel_dynamic_local_mem_size2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size2;
+    if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
-    device_param->kernel_preferred_wgs_multiple2 = device_param->hip_warp_size;
+    device_param->kernel_dynamic_local_mem_size2 = 0;
 
-    // kernel3
+    // kernel3: m%05u_comp
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_comp", kern_type);
 
-    if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function3, device_param->hip_module, kernel_name) == -1)
+    if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function3, &device_param->metal_pipeline3) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11539,21 +13608,21 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
       return -2; //continue;
     }
 
-    if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function3, &device_param->kernel_wgs3) == -1) return -1;
+    if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_wgs3) == -1) return -1;
 
-    if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+    if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-    device_param->kernel_dynamic_local_mem_size3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size3;
+    if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
 
-    device_param->kernel_preferred_wgs_multiple3 = device_param->hip_warp_size;
+    device_param->kernel_dynamic_local_mem_size3 = 0;
 
     if (hashconfig->opts_type & OPTS_TYPE_LOOP_PREPARE)
     {
-      // kernel2p
+      // kernel2p: m%05u_loop_prepare
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_prepare", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2p, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2p, &device_param->metal_pipeline2p) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11562,22 +13631,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2p, &device_param->kernel_wgs2p) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2p, &device_param->kernel_wgs2p) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2p, &device_param->kernel_local_mem_size2p) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2p, &device_param->kernel_local_mem_size2p) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size2p = device_param->device_local_mem_size - device_param->kernel_local_mem_size2p;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2p, &device_param->kernel_preferred_wgs_multiple2p) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple2p = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size2p = 0;
     }
 
     if (hashconfig->opts_type & OPTS_TYPE_LOOP_EXTENDED)
     {
-      // kernel2e
+      // kernel2e: m%05u_loop_extended
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_extended", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function2e, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2e, &device_param->metal_pipeline2e) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11586,22 +13655,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function2e, &device_param->kernel_wgs2e) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2e, &device_param->kernel_wgs2e) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size2e = device_param->device_local_mem_size - device_param->kernel_local_mem_size2e;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2e, &device_param->kernel_preferred_wgs_multiple2e) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple2e = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size2e = 0;
     }
 
-    // kernel12
-
     if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
     {
+      // kernel12: m%05u_hook12
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook12", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function12, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function12, &device_param->metal_pipeline12) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11610,22 +13679,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function12, &device_param->kernel_wgs12) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline12, &device_param->kernel_wgs12) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function12, &device_param->kernel_local_mem_size12) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline12, &device_param->kernel_local_mem_size12) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size12 = device_param->device_local_mem_size - device_param->kernel_local_mem_size12;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline12, &device_param->kernel_preferred_wgs_multiple12) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple12 = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size12 = 0;
     }
 
-    // kernel23
-
     if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
     {
+      // kernel23: m%05u_hook23
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook23", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function23, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function23, &device_param->metal_pipeline23) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11634,22 +13703,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function23, &device_param->kernel_wgs23) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline23, &device_param->kernel_wgs23) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function23, &device_param->kernel_local_mem_size23) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline23, &device_param->kernel_local_mem_size23) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size23 = device_param->device_local_mem_size - device_param->kernel_local_mem_size23;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline23, &device_param->kernel_preferred_wgs_multiple23) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple23 = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size23 = 0;
     }
 
-    // init2
-
     if (hashconfig->opts_type & OPTS_TYPE_INIT2)
     {
+      // init2: m%05u_init2
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_init2", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_init2, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_init2, &device_param->metal_pipeline_init2) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11658,22 +13727,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_init2, &device_param->kernel_wgs_init2) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_init2, &device_param->kernel_wgs_init2) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_init2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_init2;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_init2, &device_param->kernel_preferred_wgs_multiple_init2) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_init2 = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_init2 = 0;
     }
 
-    // loop2 prepare
-
     if (hashconfig->opts_type & OPTS_TYPE_LOOP2_PREPARE)
     {
+      // loop2 prepare: m%05u_loop2_prepare
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2_prepare", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_loop2p, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_loop2p, &device_param->metal_pipeline_loop2p) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11682,22 +13751,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_loop2p, &device_param->kernel_wgs_loop2p) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_loop2p, &device_param->kernel_wgs_loop2p) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_loop2p, &device_param->kernel_local_mem_size_loop2p) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_loop2p, &device_param->kernel_local_mem_size_loop2p) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_loop2p = device_param->device_local_mem_size - device_param->kernel_local_mem_size_loop2p;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_loop2p, &device_param->kernel_preferred_wgs_multiple_loop2p) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_loop2p = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_loop2p = 0;
     }
 
-    // loop2
-
     if (hashconfig->opts_type & OPTS_TYPE_LOOP2)
     {
+      // loop2: m%05u_loop2
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_loop2, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_loop2, &device_param->metal_pipeline_loop2) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11706,22 +13775,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_loop2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_loop2;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_loop2, &device_param->kernel_preferred_wgs_multiple_loop2) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_loop2 = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_loop2 = 0;
     }
 
-    // aux1
-
     if (hashconfig->opts_type & OPTS_TYPE_AUX1)
     {
+      // aux1: m%05u_aux1
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux1", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_aux1, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_aux1, &device_param->metal_pipeline_aux1) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11730,22 +13799,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_aux1 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux1;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_aux1, &device_param->kernel_preferred_wgs_multiple_aux1) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_aux1 = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_aux1 = 0;
     }
 
-    // aux2
-
     if (hashconfig->opts_type & OPTS_TYPE_AUX2)
     {
+      // aux2: m%05u_aux2
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux2", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_aux2, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_aux2, &device_param->metal_pipeline_aux2) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11754,22 +13823,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_aux2 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux2;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_aux2, &device_param->kernel_preferred_wgs_multiple_aux2) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_aux2 = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_aux2 = 0;
     }
 
-    // aux3
-
     if (hashconfig->opts_type & OPTS_TYPE_AUX3)
     {
+      // aux3: m%05u_aux3
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux3", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_aux3, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_aux3, &device_param->metal_pipeline_aux3) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11778,22 +13847,22 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_aux3 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux3;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_aux3, &device_param->kernel_preferred_wgs_multiple_aux3) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_aux3 = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_aux3 = 0;
     }
 
-    // aux4
-
     if (hashconfig->opts_type & OPTS_TYPE_AUX4)
     {
+      // aux4: m%05u_aux4
+
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux4", kern_type);
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_aux4, device_param->hip_module, kernel_name) == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_aux4, &device_param->metal_pipeline_aux4) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -11802,21 +13871,16 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_aux4 = device_param->device_local_mem_size - device_param->kernel_local_mem_size_aux4;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_aux4, &device_param->kernel_preferred_wgs_multiple_aux4) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_aux4 = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_aux4 = 0;
     }
   }
 
-  //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem),   device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
-  //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem),   device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
-  //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem),   device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
-  //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 3, sizeof (cl_ulong), device_param->kernel_params_decompress[3]); if (CL_rc == -1) return -1;
-
   // MP start
 
   if (user_options->slow_candidates == true)
@@ -11826,9 +13890,9 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
   {
     if (user_options->attack_mode == ATTACK_MODE_BF)
     {
-      // mp_l
+      // mp_l: l_markov
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_mp_l, device_param->hip_module_mp, "l_markov") == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_mp, "l_markov", &device_param->metal_function_mp_l, &device_param->metal_pipeline_mp_l) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "l_markov");
 
@@ -11837,17 +13901,17 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_mp_l = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp_l;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_mp_l, &device_param->kernel_preferred_wgs_multiple_mp_l) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_mp_l = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_mp_l = 0;
 
-      // mp_r
+      // mp_r: r_markov
 
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_mp_r, device_param->hip_module_mp, "r_markov") == -1)
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_mp, "r_markov", &device_param->metal_function_mp_r, &device_param->metal_pipeline_mp_r) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "r_markov");
 
@@ -11856,26 +13920,19 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
-
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_mp_r = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp_r;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_mp_r = device_param->hip_warp_size;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_mp_r, &device_param->kernel_preferred_wgs_multiple_mp_r) == -1) return -1;
 
-      if (user_options->attack_mode == ATTACK_MODE_BF)
-      {
-        if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
-        {
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 0, sizeof (cl_mem), device_param->kernel_params_tm[0]); if (CL_rc == -1) return -1;
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 1, sizeof (cl_mem), device_param->kernel_params_tm[1]); if (CL_rc == -1) return -1;
-        }
-      }
+      device_param->kernel_dynamic_local_mem_size_mp_r = 0;
     }
     else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
     {
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_mp, device_param->hip_module_mp, "C_markov") == -1)
+      // mp_c: C_markov
+
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_mp, "C_markov", &device_param->metal_function_mp, &device_param->metal_pipeline_mp) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "C_markov");
 
@@ -11884,17 +13941,19 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_mp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_mp = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_mp = 0;
     }
     else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
     {
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_mp, device_param->hip_module_mp, "C_markov") == -1)
+      // mp_c: C_markov
+
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_mp, "C_markov", &device_param->metal_function_mp, &device_param->metal_pipeline_mp) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "C_markov");
 
@@ -11903,13 +13962,13 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
-      device_param->kernel_dynamic_local_mem_size_mp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_mp;
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
 
-      device_param->kernel_preferred_wgs_multiple_mp = device_param->hip_warp_size;
+      device_param->kernel_dynamic_local_mem_size_mp = 0;
     }
   }
 
@@ -11924,7 +13983,9 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
     }
     else
     {
-      if (hc_hipModuleGetFunction (hashcat_ctx, &device_param->hip_function_amp, device_param->hip_module_amp, "amp") == -1)
+      // amp
+
+      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_amp, "amp", &device_param->metal_function_amp, &device_param->metal_pipeline_amp) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "amp");
 
@@ -11933,51 +13994,21 @@ static int backend_session_setup_hip_kernel_types (hashcat_ctx_t *hashcat_ctx, h
         return -2; //continue;
       }
 
-      if (get_hip_kernel_wgs (hashcat_ctx, device_param->hip_function_amp, &device_param->kernel_wgs_amp) == -1) return -1;
-
-      if (get_hip_kernel_local_mem_size (hashcat_ctx, device_param->hip_function_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
-
-      device_param->kernel_dynamic_local_mem_size_amp = device_param->device_local_mem_size - device_param->kernel_local_mem_size_amp;
-
-      device_param->kernel_preferred_wgs_multiple_amp = device_param->hip_warp_size;
-    }
-
-    /*
-    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-    {
-      // nothing to do
-    }
-    else
-    {
-      for (u32 i = 0; i < 5; i++)
-      {
-        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_mem), device_param->kernel_params_amp[i]);
-
-        //if (CL_rc == -1) return -1;
-      }
-
-      for (u32 i = 5; i < 6; i++)
-      {
-        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_uint), device_param->kernel_params_amp[i]);
+      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_amp, &device_param->kernel_wgs_amp) == -1) return -1;
 
-        //if (CL_rc == -1) return -1;
-      }
+      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
 
-      for (u32 i = 6; i < 7; i++)
-      {
-        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_ulong), device_param->kernel_params_amp[i]);
+      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_amp, &device_param->kernel_preferred_wgs_multiple_amp) == -1) return -1;
 
-        //if (CL_rc == -1) return -1;
-      }
+      device_param->kernel_dynamic_local_mem_size_amp = 0;
     }
-    */
   }
 
   return 0;
 }
+#endif // __APPLE__
 
-#if defined (__APPLE__)
-static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, int kern_type)
+static int backend_session_setup_native_kernel_types (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, int kern_type)
 {
   const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
   const user_options_t *user_options = hashcat_ctx->user_options;
@@ -11994,7 +14025,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 4);
 
-        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function1, &device_param->metal_pipeline1) == -1)
+        if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function1, &device_param->native_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12003,11 +14034,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
           return -2; //continue;
         }
 
-        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_wgs1) == -1) return -1;
+        if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_local_mem_size1) == -1) return -1;
+        if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
+        if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size1 = 0;
 
@@ -12015,7 +14046,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 8);
 
-        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2, &device_param->metal_pipeline2) == -1)
+        if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function2, &device_param->native_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12024,11 +14055,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
           return -2; //continue;
         }
 
-        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_wgs2) == -1) return -1;
+        if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_local_mem_size2) == -1) return -1;
+        if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
+        if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size2 = 0;
 
@@ -12036,7 +14067,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 16);
 
-        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function3, &device_param->metal_pipeline3) == -1)
+        if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function3, &device_param->native_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12045,11 +14076,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
           return -2; //continue;
         }
 
-        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_wgs3) == -1) return -1;
+        if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_local_mem_size3) == -1) return -1;
+        if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
+        if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size3 = 0;
       }
@@ -12059,7 +14090,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_sxx", kern_type);
 
-        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function4, &device_param->metal_pipeline4) == -1)
+        if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function4, &device_param->native_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12068,11 +14099,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
           return -2; //continue;
         }
 
-        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_wgs4) == -1) return -1;
+        if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function4, &device_param->kernel_wgs4) == -1) return -1;
 
-        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_local_mem_size4) == -1) return -1;
+        if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
-        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
+        if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size4 = 0;
       }
@@ -12085,7 +14116,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 4);
 
-        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function1, &device_param->metal_pipeline1) == -1)
+        if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function1, &device_param->native_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12094,11 +14125,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
           return -2; //continue;
         }
 
-        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_wgs1) == -1) return -1;
+        if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_local_mem_size1) == -1) return -1;
+        if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
+        if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size1 = 0;
 
@@ -12106,7 +14137,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 8);
 
-        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2, &device_param->metal_pipeline2) == -1)
+        if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function2, &device_param->native_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12115,11 +14146,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
           return -2; //continue;
         }
 
-        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_wgs2) == -1) return -1;
+        if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_local_mem_size2) == -1) return -1;
+        if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
+        if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size2 = 0;
 
@@ -12127,7 +14158,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 16);
 
-        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function3, &device_param->metal_pipeline3) == -1)
+        if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function3, &device_param->native_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12136,11 +14167,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
           return -2; //continue;
         }
 
-        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_wgs3) == -1) return -1;
+        if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_local_mem_size3) == -1) return -1;
+        if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
+        if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size3 = 0;
       }
@@ -12150,7 +14181,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
         snprintf (kernel_name, sizeof (kernel_name), "m%05u_mxx", kern_type);
 
-        if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function4, &device_param->metal_pipeline4) == -1)
+        if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function4, &device_param->native_module, kernel_name) == -1)
         {
           event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12159,11 +14190,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
           return -2; //continue;
         }
 
-        if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_wgs4) == -1) return -1;
+        if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function4, &device_param->kernel_wgs4) == -1) return -1;
 
-        if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_local_mem_size4) == -1) return -1;
+        if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
-        if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
+        if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
 
         device_param->kernel_dynamic_local_mem_size4 = 0;
       }
@@ -12180,7 +14211,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         {
           snprintf (kernel_name, sizeof (kernel_name), "m%05u_tm", kern_type);
 
-          if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_tm, &device_param->metal_pipeline_tm) == -1)
+          if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_tm, &device_param->native_module, kernel_name) == -1)
           {
             event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12189,11 +14220,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
             return -2; //continue;
           }
 
-          if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_tm, &device_param->kernel_wgs_tm) == -1) return -1;
+          if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_tm, &device_param->kernel_wgs_tm) == -1) return -1;
 
-          if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
+          if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
 
-          if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_tm, &device_param->kernel_preferred_wgs_multiple_tm) == -1) return -1;
+          if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_tm, &device_param->kernel_preferred_wgs_multiple_tm) == -1) return -1;
 
           device_param->kernel_dynamic_local_mem_size_tm = 0;
         }
@@ -12206,7 +14237,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_init", kern_type);
 
-    if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function1, &device_param->metal_pipeline1) == -1)
+    if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function1, &device_param->native_module, kernel_name) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12215,11 +14246,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
       return -2; //continue;
     }
 
-    if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_wgs1) == -1) return -1;
+    if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-    if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_local_mem_size1) == -1) return -1;
+    if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-    if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
+    if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
     device_param->kernel_dynamic_local_mem_size1 = 0;
 
@@ -12227,7 +14258,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop", kern_type);
 
-    if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2, &device_param->metal_pipeline2) == -1)
+    if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function2, &device_param->native_module, kernel_name) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12236,11 +14267,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
       return -2; //continue;
     }
 
-    if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_wgs2) == -1) return -1;
+    if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-    if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_local_mem_size2) == -1) return -1;
+    if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-    if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
+    if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
     device_param->kernel_dynamic_local_mem_size2 = 0;
 
@@ -12248,7 +14279,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
     snprintf (kernel_name, sizeof (kernel_name), "m%05u_comp", kern_type);
 
-    if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function3, &device_param->metal_pipeline3) == -1)
+    if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function3, &device_param->native_module, kernel_name) == -1)
     {
       event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12257,11 +14288,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
       return -2; //continue;
     }
 
-    if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_wgs3) == -1) return -1;
+    if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-    if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_local_mem_size3) == -1) return -1;
+    if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-    if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
+    if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
 
     device_param->kernel_dynamic_local_mem_size3 = 0;
 
@@ -12271,7 +14302,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_prepare", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2p, &device_param->metal_pipeline2p) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function2p, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12280,11 +14311,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2p, &device_param->kernel_wgs2p) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function2p, &device_param->kernel_wgs2p) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2p, &device_param->kernel_local_mem_size2p) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function2p, &device_param->kernel_local_mem_size2p) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2p, &device_param->kernel_preferred_wgs_multiple2p) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function2p, &device_param->kernel_preferred_wgs_multiple2p) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size2p = 0;
     }
@@ -12295,7 +14326,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_extended", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function2e, &device_param->metal_pipeline2e) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function2e, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12304,11 +14335,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline2e, &device_param->kernel_wgs2e) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function2e, &device_param->kernel_wgs2e) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline2e, &device_param->kernel_preferred_wgs_multiple2e) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function2e, &device_param->kernel_preferred_wgs_multiple2e) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size2e = 0;
     }
@@ -12319,7 +14350,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook12", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function12, &device_param->metal_pipeline12) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function12, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12328,11 +14359,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline12, &device_param->kernel_wgs12) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function12, &device_param->kernel_wgs12) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline12, &device_param->kernel_local_mem_size12) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function12, &device_param->kernel_local_mem_size12) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline12, &device_param->kernel_preferred_wgs_multiple12) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function12, &device_param->kernel_preferred_wgs_multiple12) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size12 = 0;
     }
@@ -12343,7 +14374,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook23", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function23, &device_param->metal_pipeline23) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function23, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12352,11 +14383,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline23, &device_param->kernel_wgs23) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function23, &device_param->kernel_wgs23) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline23, &device_param->kernel_local_mem_size23) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function23, &device_param->kernel_local_mem_size23) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline23, &device_param->kernel_preferred_wgs_multiple23) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function23, &device_param->kernel_preferred_wgs_multiple23) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size23 = 0;
     }
@@ -12367,7 +14398,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_init2", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_init2, &device_param->metal_pipeline_init2) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_init2, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12376,11 +14407,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_init2, &device_param->kernel_wgs_init2) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_init2, &device_param->kernel_wgs_init2) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_init2, &device_param->kernel_preferred_wgs_multiple_init2) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_init2, &device_param->kernel_preferred_wgs_multiple_init2) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_init2 = 0;
     }
@@ -12391,7 +14422,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2_prepare", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_loop2p, &device_param->metal_pipeline_loop2p) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_loop2p, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12400,11 +14431,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_loop2p, &device_param->kernel_wgs_loop2p) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_loop2p, &device_param->kernel_wgs_loop2p) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_loop2p, &device_param->kernel_local_mem_size_loop2p) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_loop2p, &device_param->kernel_local_mem_size_loop2p) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_loop2p, &device_param->kernel_preferred_wgs_multiple_loop2p) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_loop2p, &device_param->kernel_preferred_wgs_multiple_loop2p) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_loop2p = 0;
     }
@@ -12415,7 +14446,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_loop2, &device_param->metal_pipeline_loop2) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_loop2, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12424,11 +14455,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_loop2, &device_param->kernel_preferred_wgs_multiple_loop2) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_loop2, &device_param->kernel_preferred_wgs_multiple_loop2) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_loop2 = 0;
     }
@@ -12439,7 +14470,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux1", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_aux1, &device_param->metal_pipeline_aux1) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_aux1, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12448,11 +14479,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_aux1, &device_param->kernel_preferred_wgs_multiple_aux1) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_aux1, &device_param->kernel_preferred_wgs_multiple_aux1) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_aux1 = 0;
     }
@@ -12463,7 +14494,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux2", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_aux2, &device_param->metal_pipeline_aux2) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_aux2, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12472,11 +14503,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_aux2, &device_param->kernel_preferred_wgs_multiple_aux2) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_aux2, &device_param->kernel_preferred_wgs_multiple_aux2) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_aux2 = 0;
     }
@@ -12487,7 +14518,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux3", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_aux3, &device_param->metal_pipeline_aux3) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_aux3, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12496,11 +14527,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_aux3, &device_param->kernel_preferred_wgs_multiple_aux3) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_aux3, &device_param->kernel_preferred_wgs_multiple_aux3) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_aux3 = 0;
     }
@@ -12511,7 +14542,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
       snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux4", kern_type);
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library, kernel_name, &device_param->metal_function_aux4, &device_param->metal_pipeline_aux4) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_aux4, &device_param->native_module, kernel_name) == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, kernel_name);
 
@@ -12520,11 +14551,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_aux4, &device_param->kernel_preferred_wgs_multiple_aux4) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_aux4, &device_param->kernel_preferred_wgs_multiple_aux4) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_aux4 = 0;
     }
@@ -12541,7 +14572,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       // mp_l: l_markov
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_mp, "l_markov", &device_param->metal_function_mp_l, &device_param->metal_pipeline_mp_l) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_mp_l, &device_param->native_module_mp, "l_markov") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "l_markov");
 
@@ -12550,17 +14581,17 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_mp_l, &device_param->kernel_preferred_wgs_multiple_mp_l) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_mp_l, &device_param->kernel_preferred_wgs_multiple_mp_l) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_mp_l = 0;
 
       // mp_r: r_markov
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_mp, "r_markov", &device_param->metal_function_mp_r, &device_param->metal_pipeline_mp_r) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_mp_r, &device_param->native_module_mp, "r_markov") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "r_markov");
 
@@ -12569,11 +14600,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_mp_r, &device_param->kernel_preferred_wgs_multiple_mp_r) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_mp_r, &device_param->kernel_preferred_wgs_multiple_mp_r) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_mp_r = 0;
     }
@@ -12581,7 +14612,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       // mp_c: C_markov
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_mp, "C_markov", &device_param->metal_function_mp, &device_param->metal_pipeline_mp) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_mp, &device_param->native_module_mp, "C_markov") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "C_markov");
 
@@ -12590,11 +14621,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_mp = 0;
     }
@@ -12602,7 +14633,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       // mp_c: C_markov
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_mp, "C_markov", &device_param->metal_function_mp, &device_param->metal_pipeline_mp) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_mp, &device_param->native_module_mp, "C_markov") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "C_markov");
 
@@ -12611,11 +14642,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_mp = 0;
     }
@@ -12634,7 +14665,7 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
     {
       // amp
 
-      if (hc_mtlCreateKernel (hashcat_ctx, device_param->metal_device, device_param->metal_library_amp, "amp", &device_param->metal_function_amp, &device_param->metal_pipeline_amp) == -1)
+      if (hc_nativeModuleGetFunction (hashcat_ctx, &device_param->native_function_amp, &device_param->native_module_amp, "amp") == -1)
       {
         event_log_warning (hashcat_ctx, "* Device #%u: Kernel %s create failed.", device_param->device_id + 1, "amp");
 
@@ -12643,11 +14674,11 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
         return -2; //continue;
       }
 
-      if (get_metal_kernel_wgs (hashcat_ctx, device_param->metal_pipeline_amp, &device_param->kernel_wgs_amp) == -1) return -1;
+      if (get_native_kernel_wgs (hashcat_ctx, &device_param->native_function_amp, &device_param->kernel_wgs_amp) == -1) return -1;
 
-      if (get_metal_kernel_local_mem_size (hashcat_ctx, device_param->metal_pipeline_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
+      if (get_native_kernel_local_mem_size (hashcat_ctx, &device_param->native_function_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
 
-      if (get_metal_kernel_preferred_wgs_multiple (hashcat_ctx, device_param->metal_pipeline_amp, &device_param->kernel_preferred_wgs_multiple_amp) == -1) return -1;
+      if (get_native_kernel_preferred_wgs_multiple (hashcat_ctx, &device_param->native_function_amp, &device_param->kernel_preferred_wgs_multiple_amp) == -1) return -1;
 
       device_param->kernel_dynamic_local_mem_size_amp = 0;
     }
@@ -12655,7 +14686,6 @@ static int backend_session_setup_metal_kernel_types (hashcat_ctx_t *hashcat_ctx,
 
   return 0;
 }
-#endif // __APPLE__
 
 static int backend_session_setup_opencl_kernel_types (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, int kern_type)
 {
@@ -13372,39 +15402,40 @@ static int backend_session_setup_opencl_kernel_types (hashcat_ctx_t *hashcat_ctx
   return 0;
 }
 
-int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
+/**
+ * The hashlist independent part of the session setup, mostly the kernel builds.
+ * It can run on a thread of its own while the hashes are loaded, unless the module
+ * hooks it calls need the hashes, see backend_session_build_needs_hashes ()
+ */
+
+bool backend_session_build_needs_hashes (hashcat_ctx_t *hashcat_ctx)
+{
+  const module_ctx_t   *module_ctx   = hashcat_ctx->module_ctx;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (module_ctx->module_extra_tuningdb_block != MODULE_DEFAULT) return true;
+  if (module_ctx->module_jit_build_options    != MODULE_DEFAULT) return true;
+  if (module_ctx->module_jit_cache_disable    != MODULE_DEFAULT) return true;
+
+  if ((module_ctx->module_kern_type_dynamic != MODULE_DEFAULT) && (user_options->benchmark == false)) return true;
+
+  return false;
+}
+
+static int backend_session_build_devices (hashcat_ctx_t *hashcat_ctx)
 {
-  const bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
   const bridge_ctx_t         *bridge_ctx          = hashcat_ctx->bridge_ctx;
   const folder_config_t      *folder_config       = hashcat_ctx->folder_config;
   const hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
   const hashes_t             *hashes              = hashcat_ctx->hashes;
   const module_ctx_t         *module_ctx          = hashcat_ctx->module_ctx;
         backend_ctx_t        *backend_ctx         = hashcat_ctx->backend_ctx;
-  const straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
   const user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
   const user_options_t       *user_options        = hashcat_ctx->user_options;
 
-  if (backend_ctx->enabled == false) return 0;
-
-  u64 size_total_host_all = 0;
-
-  u32 hardware_power_all = 0;
-
-  int backend_memory_hit_warnings    = 0;
   int backend_runtime_skip_warnings  = 0;
   int backend_kernel_build_warnings  = 0;
   int backend_kernel_create_warnings = 0;
-  int backend_kernel_accel_warnings  = 0;
-  int backend_extra_size_warning     = 0;
-
-  backend_ctx->memory_hit_warning    = false;
-  backend_ctx->runtime_skip_warning  = false;
-  backend_ctx->kernel_build_warning  = false;
-  backend_ctx->kernel_create_warning = false;
-  backend_ctx->kernel_accel_warnings = false;
-  backend_ctx->extra_size_warning    = false;
-  backend_ctx->mixed_warnings        = false;
 
   for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
   {
@@ -13416,7 +15447,9 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     if (device_param->skipped == true) continue;
 
-    EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_PRE, &backend_devices_idx, sizeof (int));
+    // the hashes loaded in parallel left nothing to attack, see outer_loop ()
+
+    if (startup_cancelled (hashcat_ctx) == true) return -1;
 
     const int device_id = device_param->device_id;
 
@@ -13454,6 +15487,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         if (device_param->is_metal  == true) memcpy (runtime_name, "Metal", 5);
         #endif
         if (device_param->is_opencl == true) memcpy (runtime_name, "OpenCL", 6);
+        if (device_param->is_native == true) memcpy (runtime_name, "Native", 6);
 
         event_log_warning (hashcat_ctx, "* Device #%u: Skipping (hash-mode %u)", device_id + 1, hashconfig->hash_mode);
         event_log_warning (hashcat_ctx, "             This is due to a known %s runtime and/or device driver issue (not a hashcat issue)", runtime_name);
@@ -13701,6 +15735,13 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       vector_width = 4;
     }
 
+    // the native backend has no vector types, the host compiler does the vectorization
+
+    if (device_param->is_native == true)
+    {
+      vector_width = 1;
+    }
+
     // We can't have SIMD in kernels where we have an unknown final password length
     // It also turns out that pure kernels (that have a higher register pressure)
     // actually run faster on scalar GPU (like 1080) without SIMD
@@ -14024,6 +16065,29 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
     }
     #endif
 
+    if (device_param->is_native == true)
+    {
+      // work-groups are of size 1 and there is no second dimension, so kernels which
+      // need cooperating work-items can not run on the native backend
+
+      const u32 dimy_mask = OPTI_TYPE_SLOW_HASH_DIMY_INIT | OPTI_TYPE_SLOW_HASH_DIMY_LOOP | OPTI_TYPE_SLOW_HASH_DIMY_COMP;
+
+      if ((device_param->kernel_threads_min > 1) || (hashconfig->opti_type & dimy_mask))
+      {
+        event_log_warning (hashcat_ctx, "* Device #%u: Skipping (hash-mode %u)", device_id + 1, hashconfig->hash_mode);
+        event_log_warning (hashcat_ctx, "             This hash-mode needs work-groups larger than one work-item, which the Native backend does not support.");
+        event_log_warning (hashcat_ctx, NULL);
+
+        backend_runtime_skip_warnings++;
+
+        device_param->skipped_warning = true;
+        continue;
+      }
+
+      device_param->kernel_threads_min = 1;
+      device_param->kernel_threads_max = 1;
+    }
+
     // re-using context/command-queue, there is no need to re-initialize them
 
     /**
@@ -14103,150 +16167,26 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
     if (device_param->is_hip == true)
     {
       if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event1, hipEventBlockingSync) == -1)
-      {
-        device_param->skipped = true;
-
-        continue;
-      }
-
-      if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event2, hipEventBlockingSync) == -1)
-      {
-        device_param->skipped = true;
-
-        continue;
-      }
-
-      if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event3, hipEventDisableTiming) == -1)
-      {
-        device_param->skipped = true;
-
-        continue;
-      }
-    }
-
-    /**
-     * create input buffers on device : calculate size of fixed memory buffers
-     */
-
-    u64 size_root_css   = SP_PW_MAX *           sizeof (cs_t);
-    u64 size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
-
-    device_param->size_root_css   = size_root_css;
-    device_param->size_markov_css = size_markov_css;
-
-    u64 size_results = sizeof (u32);
-
-    device_param->size_results = size_results;
-
-    u32 aligned_rules_cnt = MAX (MAX (straight_ctx->kernel_rules_cnt, device_param->kernel_loops_min), KERNEL_RULES);
-
-    u64 size_rules     = (u64) aligned_rules_cnt * sizeof (kernel_rule_t);
-    u64 size_rules_src = (u64) straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);  // size of source rules buffer can be less than aligned_rules_cnt
-    u64 size_rules_c   = (u64) KERNEL_RULES      * sizeof (kernel_rule_t);
-
-    device_param->size_rules    = size_rules;
-    device_param->size_rules_c  = size_rules_c;
-
-    u64 size_plains  = (u64) hashes->digests_cnt * sizeof (plain_t);
-    u64 size_salts   = (u64) hashes->salts_cnt   * sizeof (salt_t);
-    u64 size_esalts  = (u64) hashes->digests_cnt * hashconfig->esalt_size;
-    u64 size_shown   = (u64) hashes->digests_cnt * sizeof (u32);
-    u64 size_digests = (u64) hashes->digests_cnt * (u64) hashconfig->dgst_size;
-
-    device_param->size_plains   = size_plains;
-    device_param->size_digests  = size_digests;
-    device_param->size_shown    = size_shown;
-    device_param->size_salts    = size_salts;
-    device_param->size_esalts   = size_esalts;
-
-    u64 size_combs          = KERNEL_COMBS * sizeof (pw_t);
-    u64 size_bfs            = KERNEL_BFS   * sizeof (bf_t);
-    u64 size_tm             = 32           * sizeof (bs_word_t);
-    u64 size_kernel_params  = 1            * sizeof (kernel_param_t);
-
-    device_param->size_bfs           = size_bfs;
-    device_param->size_combs         = size_combs;
-    device_param->size_tm            = size_tm;
-    device_param->size_kernel_params = size_kernel_params;
-
-    u64 size_st_digests = 1 * hashconfig->dgst_size;
-    u64 size_st_salts   = 1 * sizeof (salt_t);
-    u64 size_st_esalts  = 1 * hashconfig->esalt_size;
-
-    device_param->size_st_digests = size_st_digests;
-    device_param->size_st_salts   = size_st_salts;
-    device_param->size_st_esalts  = size_st_esalts;
-
-    // extra buffer
-
-    u64 size_extra_buffer1 = 4096;
-    u64 size_extra_buffer2 = 4096;
-    u64 size_extra_buffer3 = 4096;
-    u64 size_extra_buffer4 = 4096;
-
-    if (module_ctx->module_extra_buffer_size != MODULE_DEFAULT)
-    {
-      const u64 extra_buffer_size = module_ctx->module_extra_buffer_size (hashconfig, user_options, user_options_extra, hashes, device_param);
-
-      if (extra_buffer_size == (u64) -1)
-      {
-        event_log_error (hashcat_ctx, "Invalid extra buffer size.");
-
-        backend_extra_size_warning++;
-
-        device_param->skipped_warning = true;
-        continue;
-      }
-
-      device_param->extra_buffer_size = extra_buffer_size;
-
-      /**
-       * We use a "4-buffer" strategy for certain hash types (like scrypt)
-       * that require large scratch buffers per work-item.
-       *
-       * The kernel assigns each work-item to one of 4 sub-buffers using:
-       *   buffer index = workitem_id % 4
-       *
-       * This means that each of the 4 sub-buffers must be large enough to hold
-       * all work-items that map to it. However, the total number of work-items
-       * is not always a multiple of 4. If we naively split the total buffer size
-       * evenly into 4 parts, the last chunk may be too small and cause buffer
-       * overflows for configurations where work-items spill into a partially sized chunk.
-       *
-       * Previous versions worked around this by over-allocating a full extra buffer,
-       * but this wasted gpu memory for large hashes like scrypt with high N.
-       *
-       * This improved logic computes the exact number of work-items assigned to
-       * each of the 4 chunks and sizes each chunk precisely:
-       *
-       * - The first 'leftover' chunks get one extra work-item to cover any remainder.
-       * - This guarantees each chunk is large enough for its assigned work-items.
-       */
-
-      const u64 kernel_power_max = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE) ? 1 : device_param->device_processors) * device_param->kernel_accel_max;
-
-      const u64 extra_buffer_size_threads = extra_buffer_size / kernel_power_max;
-
-      const u64 workitems_per_chunk = kernel_power_max / 4;
+      {
+        device_param->skipped = true;
 
-      const u64 base_chunk_size = workitems_per_chunk * extra_buffer_size_threads;
+        continue;
+      }
 
-      size_extra_buffer1 += base_chunk_size;
-      size_extra_buffer2 += base_chunk_size;
-      size_extra_buffer3 += base_chunk_size;
-      size_extra_buffer4 += base_chunk_size;
+      if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event2, hipEventBlockingSync) == -1)
+      {
+        device_param->skipped = true;
 
-      const u64 leftover = kernel_power_max % 4;
+        continue;
+      }
 
-      switch (leftover)
+      if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event3, hipEventDisableTiming) == -1)
       {
-        case 3: size_extra_buffer3 += extra_buffer_size_threads; // fall-through
-        case 2: size_extra_buffer2 += extra_buffer_size_threads; // fall-through
-        case 1: size_extra_buffer1 += extra_buffer_size_threads; // fall-through
-        case 0: break;
+        device_param->skipped = true;
+
+        continue;
       }
     }
-
     // kern type
 
     u32 kern_type = hashconfig->kern_type;
@@ -14279,6 +16219,8 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       return -1;
     }
 
+    device_param->kern_type = kern_type;
+
     // built options
 
     const size_t build_options_sz = 4096;
@@ -14465,9 +16407,9 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       generate_cached_kernel_shared_filename (folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
 
       #if defined (__APPLE__)
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, &device_param->metal_library_shared);
+      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->program_file_shared, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, &device_param->metal_library_shared, &device_param->native_module_shared);
       #else
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, NULL);
+      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->program_file_shared, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, NULL, &device_param->native_module_shared);
       #endif
 
       if (rc_load_kernel == false)
@@ -14501,10 +16443,16 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         rc = backend_session_setup_opencl_kernel_shared (hashcat_ctx, device_param);
       }
 
+      if (device_param->is_native == true)
+      {
+        rc = backend_session_setup_native_kernel_shared (hashcat_ctx, device_param);
+      }
+
       if (rc == -2)
       {
         backend_kernel_create_warnings++;
 
+        device_param->skipped_warning = true;
         continue;
       }
 
@@ -14512,6 +16460,8 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     }
 
+    if (startup_cancelled (hashcat_ctx) == true) return -1;
+
     /**
      * main kernel
      */
@@ -14563,6 +16513,13 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         }
       }
 
+      // --salt-pack selects the per work-item salt macros in inc_types.h, see salt_pack_slots()
+
+      if ((user_options->salt_pack == true) && (hashconfig->attack_exec == ATTACK_EXEC_OUTSIDE_KERNEL) && (device_param->is_metal == false))
+      {
+        build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, " -D SALT_PACK");
+      }
+
       build_options_module_buf[build_options_module_len] = 0;
 
       #if defined (DEBUG)
@@ -14635,9 +16592,9 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
        */
 
       #if defined (__APPLE__)
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, &device_param->metal_library);
+      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->program_file, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, &device_param->metal_library, &device_param->native_module);
       #else
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, NULL);
+      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->program_file, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, NULL, &device_param->native_module);
       #endif
 
       if (rc_load_kernel == false)
@@ -14688,9 +16645,9 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         generate_cached_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
 
         #if defined (__APPLE__)
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, &device_param->metal_library_mp);
+        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->program_file_mp, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, &device_param->metal_library_mp, &device_param->native_module_mp);
         #else
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, NULL);
+        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->program_file_mp, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, NULL, &device_param->native_module_mp);
         #endif
 
         if (rc_load_kernel == false)
@@ -14738,39 +16695,271 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
         char cached_file[256] = { 0 };
 
-        generate_cached_kernel_amp_filename (user_options_extra->attack_kern, folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
+        generate_cached_kernel_amp_filename (user_options_extra->attack_kern, folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
+
+        #if defined (__APPLE__)
+        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->program_file_amp, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, &device_param->metal_library_amp, &device_param->native_module_amp);
+        #else
+        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->program_file_amp, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, NULL, &device_param->native_module_amp);
+        #endif
+
+        if (rc_load_kernel == false)
+        {
+          event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
+
+          return -1;
+        }
+
+        hcfree (build_options_buf);
+      }
+    }
+
+    /**
+     * no more need for the compiler. cuda doesn't offer this function.
+     * from opencl specs:
+     * Calls to clBuildProgram, clCompileProgram or clLinkProgram after clUnloadPlatformCompiler will reload the compiler, if necessary, to build the appropriate program executable.
+     */
+    // Disabled after user reporting weird errors like CL_OUT_OF_HOST_MEMORY after calling
+    /*
+    if (device_param->is_opencl == true)
+    {
+      cl_platform_id platform_id = backend_ctx->opencl_platforms[device_param->opencl_platform_id];
+
+      if (hc_clUnloadPlatformCompiler (hashcat_ctx, platform_id) == -1) return -1;
+    }
+    */
+
+    // context, backend_session_begin () makes it current again on the thread it runs on
+
+    if (device_param->is_cuda == true)
+    {
+      if (hc_cuCtxPopCurrent (hashcat_ctx, &device_param->cuda_context) == -1)
+      {
+        device_param->skipped = true;
+
+        continue;
+      }
+    }
+  }
+
+  backend_ctx->build_runtime_skip_warnings  = backend_runtime_skip_warnings;
+  backend_ctx->build_kernel_build_warnings  = backend_kernel_build_warnings;
+  backend_ctx->build_kernel_create_warnings = backend_kernel_create_warnings;
+
+  return 0;
+}
+
+int backend_session_build (hashcat_ctx_t *hashcat_ctx)
+{
+  backend_ctx_t        *backend_ctx  = hashcat_ctx->backend_ctx;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (backend_ctx->enabled == false) return 0;
+
+  // the workload profile can change between the jobs of a daemon
+
+  backend_ctx->target_msec = TARGET_MSEC_PROFILE[user_options->workload_profile - 1];
+
+  backend_ctx->session_built = true;
+
+  backend_ctx->session_build_rc = backend_session_build_devices (hashcat_ctx);
+
+  return backend_ctx->session_build_rc;
+}
+
+int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
+{
+  const bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
+  const hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  const hashes_t             *hashes              = hashcat_ctx->hashes;
+  const module_ctx_t         *module_ctx          = hashcat_ctx->module_ctx;
+        backend_ctx_t        *backend_ctx         = hashcat_ctx->backend_ctx;
+  const straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
+  const user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
+  const user_options_t       *user_options        = hashcat_ctx->user_options;
+
+  if (backend_ctx->enabled == false) return 0;
+
+  // the kernels are usually built already, see outer_loop ()
+
+  if (backend_ctx->session_built == false) backend_session_build (hashcat_ctx);
+
+  if (backend_ctx->session_build_rc == -1) return -1;
+
+  u64 size_total_host_all = 0;
+
+  u32 hardware_power_all = 0;
+
+  int backend_memory_hit_warnings    = 0;
+  int backend_runtime_skip_warnings  = backend_ctx->build_runtime_skip_warnings;
+  int backend_kernel_build_warnings  = backend_ctx->build_kernel_build_warnings;
+  int backend_kernel_create_warnings = backend_ctx->build_kernel_create_warnings;
+  int backend_kernel_accel_warnings  = 0;
+  int backend_extra_size_warning     = 0;
+
+  backend_ctx->memory_hit_warning    = false;
+  backend_ctx->runtime_skip_warning  = false;
+  backend_ctx->kernel_build_warning  = false;
+  backend_ctx->kernel_create_warning = false;
+  backend_ctx->kernel_accel_warnings = false;
+  backend_ctx->extra_size_warning    = false;
+  backend_ctx->mixed_warnings        = false;
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+    if (device_param->skipped         == true) continue;
+    if (device_param->skipped_warning == true) continue;
+
+    EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_PRE, &backend_devices_idx, sizeof (int));
+
+    const int device_id = device_param->device_id;
+
+    const u32 kern_type = device_param->kern_type;
+
+    if (device_param->is_cuda == true)
+    {
+      if (hc_cuCtxPushCurrent (hashcat_ctx, device_param->cuda_context) == -1)
+      {
+        device_param->skipped = true;
+
+        continue;
+      }
+    }
+
+    if (device_param->is_hip == true)
+    {
+      if (hc_hipSetDevice (hashcat_ctx, device_param->hip_device) == -1)
+      {
+        device_param->skipped = true;
+
+        continue;
+      }
+    }
+
+    /**
+     * create input buffers on device : calculate size of fixed memory buffers
+     */
+
+    u64 size_root_css   = SP_PW_MAX *           sizeof (cs_t);
+    u64 size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
+
+    device_param->size_root_css   = size_root_css;
+    device_param->size_markov_css = size_markov_css;
+
+    u64 size_results = sizeof (u32);
+
+    device_param->size_results = size_results;
+
+    u32 aligned_rules_cnt = MAX (MAX (straight_ctx->kernel_rules_cnt, device_param->kernel_loops_min), KERNEL_RULES);
+
+    u64 size_rules     = (u64) aligned_rules_cnt * sizeof (kernel_rule_t);
+    u64 size_rules_src = (u64) straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);  // size of source rules buffer can be less than aligned_rules_cnt
+    u64 size_rules_c   = (u64) KERNEL_RULES      * sizeof (kernel_rule_t);
+
+    device_param->size_rules    = size_rules;
+    device_param->size_rules_c  = size_rules_c;
+
+    u64 size_plains  = (u64) hashes->digests_cnt * sizeof (plain_t);
+    u64 size_salts   = (u64) hashes->salts_cnt   * sizeof (salt_t);
+    u64 size_esalts  = (u64) hashes->digests_cnt * hashconfig->esalt_size;
+    u64 size_shown   = (u64) hashes->digests_cnt * sizeof (u32);
+    u64 size_digests = (u64) hashes->digests_cnt * (u64) hashconfig->dgst_size;
+
+    device_param->size_plains   = size_plains;
+    device_param->size_digests  = size_digests;
+    device_param->size_shown    = size_shown;
+    device_param->size_salts    = size_salts;
+    device_param->size_esalts   = size_esalts;
+
+    u64 size_combs          = KERNEL_COMBS * sizeof (pw_t);
+    u64 size_bfs            = KERNEL_BFS   * sizeof (bf_t);
+    u64 size_tm             = 32           * sizeof (bs_word_t);
+    u64 size_kernel_params  = 1            * sizeof (kernel_param_t);
+
+    device_param->size_bfs           = size_bfs;
+    device_param->size_combs         = size_combs;
+    device_param->size_tm            = size_tm;
+    device_param->size_kernel_params = size_kernel_params;
+
+    u64 size_st_digests = 1 * hashconfig->dgst_size;
+    u64 size_st_salts   = 1 * sizeof (salt_t);
+    u64 size_st_esalts  = 1 * hashconfig->esalt_size;
+
+    device_param->size_st_digests = size_st_digests;
+    device_param->size_st_salts   = size_st_salts;
+    device_param->size_st_esalts  = size_st_esalts;
+
+    // extra buffer
+
+    u64 size_extra_buffer1 = 4096;
+    u64 size_extra_buffer2 = 4096;
+    u64 size_extra_buffer3 = 4096;
+    u64 size_extra_buffer4 = 4096;
+
+    if (module_ctx->module_extra_buffer_size != MODULE_DEFAULT)
+    {
+      const u64 extra_buffer_size = module_ctx->module_extra_buffer_size (hashconfig, user_options, user_options_extra, hashes, device_param);
+
+      if (extra_buffer_size == (u64) -1)
+      {
+        event_log_error (hashcat_ctx, "Invalid extra buffer size.");
+
+        backend_extra_size_warning++;
+
+        device_param->skipped_warning = true;
+        continue;
+      }
+
+      device_param->extra_buffer_size = extra_buffer_size;
+
+      /**
+       * We use a "4-buffer" strategy for certain hash types (like scrypt)
+       * that require large scratch buffers per work-item.
+       *
+       * The kernel assigns each work-item to one of 4 sub-buffers using:
+       *   buffer index = workitem_id % 4
+       *
+       * This means that each of the 4 sub-buffers must be large enough to hold
+       * all work-items that map to it. However, the total number of work-items
+       * is not always a multiple of 4. If we naively split the total buffer size
+       * evenly into 4 parts, the last chunk may be too small and cause buffer
+       * overflows for configurations where work-items spill into a partially sized chunk.
+       *
+       * Previous versions worked around this by over-allocating a full extra buffer,
+       * but this wasted gpu memory for large hashes like scrypt with high N.
+       *
+       * This improved logic computes the exact number of work-items assigned to
+       * each of the 4 chunks and sizes each chunk precisely:
+       *
+       * - The first 'leftover' chunks get one extra work-item to cover any remainder.
+       * - This guarantees each chunk is large enough for its assigned work-items.
+       */
+
+      const u64 kernel_power_max = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE) ? 1 : device_param->device_processors) * device_param->kernel_accel_max;
 
-        #if defined (__APPLE__)
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, &device_param->metal_library_amp);
-        #else
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, NULL);
-        #endif
+      const u64 extra_buffer_size_threads = extra_buffer_size / kernel_power_max;
 
-        if (rc_load_kernel == false)
-        {
-          event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
+      const u64 workitems_per_chunk = kernel_power_max / 4;
 
-          return -1;
-        }
+      const u64 base_chunk_size = workitems_per_chunk * extra_buffer_size_threads;
 
-        hcfree (build_options_buf);
-      }
-    }
+      size_extra_buffer1 += base_chunk_size;
+      size_extra_buffer2 += base_chunk_size;
+      size_extra_buffer3 += base_chunk_size;
+      size_extra_buffer4 += base_chunk_size;
 
-    /**
-     * no more need for the compiler. cuda doesn't offer this function.
-     * from opencl specs:
-     * Calls to clBuildProgram, clCompileProgram or clLinkProgram after clUnloadPlatformCompiler will reload the compiler, if necessary, to build the appropriate program executable.
-     */
-    // Disabled after user reporting weird errors like CL_OUT_OF_HOST_MEMORY after calling
-    /*
-    if (device_param->is_opencl == true)
-    {
-      cl_platform_id platform_id = backend_ctx->opencl_platforms[device_param->opencl_platform_id];
+      const u64 leftover = kernel_power_max % 4;
 
-      if (hc_clUnloadPlatformCompiler (hashcat_ctx, platform_id) == -1) return -1;
+      switch (leftover)
+      {
+        case 3: size_extra_buffer3 += extra_buffer_size_threads; // fall-through
+        case 2: size_extra_buffer2 += extra_buffer_size_threads; // fall-through
+        case 1: size_extra_buffer1 += extra_buffer_size_threads; // fall-through
+        case 0: break;
+      }
     }
-    */
 
     // some algorithm collide too fast, make that impossible
 
@@ -14786,8 +16975,12 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
      * global buffers
      */
 
+    // the first-level bitmap is stored behind bitmap_s1_a, see BITMAP_L1_BITS
+
+    const u64 size_bitmap_s1_a = bitmap_ctx->bitmap_size + BITMAP_L1_SIZE;
+
     const u64 size_total_fixed
-      = bitmap_ctx->bitmap_size
+      = size_bitmap_s1_a
       + bitmap_ctx->bitmap_size
       + bitmap_ctx->bitmap_size
       + bitmap_ctx->bitmap_size
@@ -14827,7 +17020,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     if (device_param->is_cuda == true)
     {
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_a,    size_bitmap_s1_a) == -1) return -1;
       if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
@@ -14848,7 +17041,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_salts_buf,   size_st_salts)           == -1) return -1;
       if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_kernel_param,   size_kernel_params)      == -1) return -1;
 
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, size_bitmap_s1_a) == -1) return -1;
       if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
@@ -14938,7 +17131,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     if (device_param->is_hip == true)
     {
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_a,    size_bitmap_s1_a) == -1) return -1;
       if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
@@ -14959,7 +17152,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_st_salts_buf,   size_st_salts)           == -1) return -1;
       if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_kernel_param,   size_kernel_params)      == -1) return -1;
 
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, size_bitmap_s1_a) == -1) return -1;
       if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
@@ -15050,7 +17243,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
     #if defined (__APPLE__)
     if (device_param->is_metal == true)
     {
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_a);
+      HC_MTL_CREATEBUFFER(hashcat_ctx, size_bitmap_s1_a,        NULL, bitmap_s1_a);
       HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_b);
       HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_c);
       HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_d);
@@ -15071,7 +17264,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       HC_MTL_CREATEBUFFER(hashcat_ctx, size_st_salts,           NULL, st_salts_buf);
       HC_MTL_CREATEBUFFER(hashcat_ctx, size_kernel_params,      NULL, kernel_param);
 
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_a, 0, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_a, 0, bitmap_ctx->bitmap_s1_a, size_bitmap_s1_a) == -1) return -1;
       if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_b, 0, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_c, 0, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
       if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_d, 0, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
@@ -15140,7 +17333,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     if (device_param->is_opencl == true)
     {
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_a);
+      HC_OCL_CREATEBUFFER(hashcat_ctx, size_bitmap_s1_a,        NULL, bitmap_s1_a);
       HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_b);
       HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_c);
       HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_d);
@@ -15161,7 +17354,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       HC_OCL_CREATEBUFFER(hashcat_ctx, size_st_salts,           NULL, st_salts_buf);
       HC_OCL_CREATEBUFFER(hashcat_ctx, size_kernel_params,      NULL, kernel_param);
 
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_a, 0, NULL, NULL) == -1) return -1;
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_a, CL_TRUE, 0, size_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, 0, NULL, NULL) == -1) return -1;
       if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_b, 0, NULL, NULL) == -1) return -1;
       if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_c, 0, NULL, NULL) == -1) return -1;
       if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_d, 0, NULL, NULL) == -1) return -1;
@@ -15229,6 +17422,97 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
     }
 
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bitmap_s1_a,    size_bitmap_s1_a) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bitmap_s2_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bitmap_s2_b,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bitmap_s2_c,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bitmap_s2_d,    bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_plain_bufs,     size_plains)             == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_digests_buf,    size_digests)            == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_digests_shown,  size_shown)              == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_salt_bufs,      size_salts)              == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_result,         size_results)            == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_extra0_buf,     size_extra_buffer1)      == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_extra1_buf,     size_extra_buffer2)      == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_extra2_buf,     size_extra_buffer3)      == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_extra3_buf,     size_extra_buffer4)      == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_st_digests_buf, size_st_digests)         == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_st_salts_buf,   size_st_salts)           == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_kernel_param,   size_kernel_params)      == -1) return -1;
+
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, size_bitmap_s1_a) == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bitmap_s2_a, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bitmap_s2_b, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bitmap_s2_c, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bitmap_s2_d, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_digests_buf, hashes->digests_buf,     size_digests)            == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_salt_bufs,   hashes->salts_buf,       size_salts)              == -1) return -1;
+
+      /**
+       * special buffers
+       */
+
+      if (user_options->slow_candidates == true)
+      {
+        if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_rules_c, size_rules_c) == -1) return -1;
+      }
+      else
+      {
+        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+        {
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_rules,   size_rules) == -1) return -1;
+
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_rules_c, size_rules_c) == -1) return -1;
+
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_rules, straight_ctx->kernel_rules_buf, size_rules_src) == -1) return -1;
+        }
+        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+        {
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_combs,          size_combs)      == -1) return -1;
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_combs_c,        size_combs)      == -1) return -1;
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_root_css_buf,   size_root_css)   == -1) return -1;
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_markov_css_buf, size_markov_css) == -1) return -1;
+        }
+        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+        {
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bfs,            size_bfs)        == -1) return -1;
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_root_css_buf,   size_root_css)   == -1) return -1;
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_markov_css_buf, size_markov_css) == -1) return -1;
+
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_bfs_c,          size_bfs)        == -1) return -1;
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_tm_c,           size_tm)         == -1) return -1;
+        }
+      }
+
+      if (size_esalts)
+      {
+        if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_esalt_bufs, size_esalts) == -1) return -1;
+
+        if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_esalt_bufs, hashes->esalts_buf, size_esalts) == -1) return -1;
+      }
+
+      if (hashconfig->st_hash != NULL)
+      {
+        if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_st_digests_buf, hashes->st_digests_buf, size_st_digests) == -1) return -1;
+        if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_st_salts_buf,   hashes->st_salts_buf,   size_st_salts) == -1) return -1;
+
+        if (size_esalts)
+        {
+          if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_st_esalts_buf, size_st_esalts) == -1) return -1;
+
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_st_esalts_buf, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
+        }
+      }
+    }
+
     /**
      * kernel args
      */
@@ -15236,6 +17520,8 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
     device_param->kernel_param.bitmap_mask         = bitmap_ctx->bitmap_mask;
     device_param->kernel_param.bitmap_shift1       = bitmap_ctx->bitmap_shift1;
     device_param->kernel_param.bitmap_shift2       = bitmap_ctx->bitmap_shift2;
+    device_param->kernel_param.bitmap_l1_enabled   = (bitmap_ctx->bitmap_l1_enabled == true) ? 1 : 0;
+    device_param->kernel_param.association_width   = user_options->association_width;
     device_param->kernel_param.salt_pos_host       = 0;
     device_param->kernel_param.loop_pos            = 0;
     device_param->kernel_param.loop_cnt            = 0;
@@ -15367,6 +17653,35 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       device_param->kernel_params[24] = &device_param->opencl_d_kernel_param;
     }
 
+    if (device_param->is_native == true)
+    {
+      device_param->kernel_params[ 0] = NULL; // &device_param->native_d_pws_buf;
+      device_param->kernel_params[ 1] = &device_param->native_d_rules_c;
+      device_param->kernel_params[ 2] = &device_param->native_d_combs_c;
+      device_param->kernel_params[ 3] = &device_param->native_d_bfs_c;
+      device_param->kernel_params[ 4] = NULL; // &device_param->native_d_tmps;
+      device_param->kernel_params[ 5] = NULL; // &device_param->native_d_hooks;
+      device_param->kernel_params[ 6] = &device_param->native_d_bitmap_s1_a;
+      device_param->kernel_params[ 7] = &device_param->native_d_bitmap_s1_b;
+      device_param->kernel_params[ 8] = &device_param->native_d_bitmap_s1_c;
+      device_param->kernel_params[ 9] = &device_param->native_d_bitmap_s1_d;
+      device_param->kernel_params[10] = &device_param->native_d_bitmap_s2_a;
+      device_param->kernel_params[11] = &device_param->native_d_bitmap_s2_b;
+      device_param->kernel_params[12] = &device_param->native_d_bitmap_s2_c;
+      device_param->kernel_params[13] = &device_param->native_d_bitmap_s2_d;
+      device_param->kernel_params[14] = &device_param->native_d_plain_bufs;
+      device_param->kernel_params[15] = &device_param->native_d_digests_buf;
+      device_param->kernel_params[16] = &device_param->native_d_digests_shown;
+      device_param->kernel_params[17] = &device_param->native_d_salt_bufs;
+      device_param->kernel_params[18] = &device_param->native_d_esalt_bufs;
+      device_param->kernel_params[19] = &device_param->native_d_result;
+      device_param->kernel_params[20] = &device_param->native_d_extra0_buf;
+      device_param->kernel_params[21] = &device_param->native_d_extra1_buf;
+      device_param->kernel_params[22] = &device_param->native_d_extra2_buf;
+      device_param->kernel_params[23] = &device_param->native_d_extra3_buf;
+      device_param->kernel_params[24] = &device_param->native_d_kernel_param;
+    }
+
     if (user_options->slow_candidates == true)
     {
     }
@@ -15402,6 +17717,11 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         {
           device_param->kernel_params_mp[0] = &device_param->opencl_d_combs;
         }
+
+        if (device_param->is_native == true)
+        {
+          device_param->kernel_params_mp[0] = &device_param->native_d_combs;
+        }
       }
       else
       {
@@ -15428,6 +17748,11 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
           {
             device_param->kernel_params_mp[0] = &device_param->opencl_d_combs;
           }
+
+          if (device_param->is_native == true)
+          {
+            device_param->kernel_params_mp[0] = &device_param->native_d_combs;
+          }
         }
         else
         {
@@ -15463,6 +17788,12 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         device_param->kernel_params_mp[2] = &device_param->opencl_d_markov_css_buf;
       }
 
+      if (device_param->is_native == true)
+      {
+        device_param->kernel_params_mp[1] = &device_param->native_d_root_css_buf;
+        device_param->kernel_params_mp[2] = &device_param->native_d_markov_css_buf;
+      }
+
       device_param->kernel_params_mp[3] = &device_param->kernel_params_mp_buf64[3];
       device_param->kernel_params_mp[4] = &device_param->kernel_params_mp_buf32[4];
       device_param->kernel_params_mp[5] = &device_param->kernel_params_mp_buf32[5];
@@ -15508,6 +17839,12 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         device_param->kernel_params_mp_l[2] = &device_param->opencl_d_markov_css_buf;
       }
 
+      if (device_param->is_native == true)
+      {
+        device_param->kernel_params_mp_l[1] = &device_param->native_d_root_css_buf;
+        device_param->kernel_params_mp_l[2] = &device_param->native_d_markov_css_buf;
+      }
+
       device_param->kernel_params_mp_l[3] = &device_param->kernel_params_mp_l_buf64[3];
       device_param->kernel_params_mp_l[4] = &device_param->kernel_params_mp_l_buf32[4];
       device_param->kernel_params_mp_l[5] = &device_param->kernel_params_mp_l_buf32[5];
@@ -15553,6 +17890,13 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         device_param->kernel_params_mp_r[2] = &device_param->opencl_d_markov_css_buf;
       }
 
+      if (device_param->is_native == true)
+      {
+        device_param->kernel_params_mp_r[0] = &device_param->native_d_bfs;
+        device_param->kernel_params_mp_r[1] = &device_param->native_d_root_css_buf;
+        device_param->kernel_params_mp_r[2] = &device_param->native_d_markov_css_buf;
+      }
+
       device_param->kernel_params_mp_r[3] = &device_param->kernel_params_mp_r_buf64[3];
       device_param->kernel_params_mp_r[4] = &device_param->kernel_params_mp_r_buf32[4];
       device_param->kernel_params_mp_r[5] = &device_param->kernel_params_mp_r_buf32[5];
@@ -15601,6 +17945,15 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         device_param->kernel_params_amp[4] = &device_param->opencl_d_bfs_c;
       }
 
+      if (device_param->is_native == true)
+      {
+        device_param->kernel_params_amp[0] = NULL; // &device_param->native_d_pws_buf;
+        device_param->kernel_params_amp[1] = NULL; // &device_param->native_d_pws_amp_buf;
+        device_param->kernel_params_amp[2] = &device_param->native_d_rules_c;
+        device_param->kernel_params_amp[3] = &device_param->native_d_combs_c;
+        device_param->kernel_params_amp[4] = &device_param->native_d_bfs_c;
+      }
+
       device_param->kernel_params_amp[5] = &device_param->kernel_params_amp_buf32[5];
       device_param->kernel_params_amp[6] = &device_param->kernel_params_amp_buf64[6];
 
@@ -15629,6 +17982,12 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         device_param->kernel_params_tm[0] = &device_param->opencl_d_bfs_c;
         device_param->kernel_params_tm[1] = &device_param->opencl_d_tm_c;
       }
+
+      if (device_param->is_native == true)
+      {
+        device_param->kernel_params_tm[0] = &device_param->native_d_bfs_c;
+        device_param->kernel_params_tm[1] = &device_param->native_d_tm_c;
+      }
     }
 
     device_param->kernel_params_memset_buf32[1] = 0; // value
@@ -15693,6 +18052,15 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
                                                         // : &device_param->opencl_d_pws_amp_buf;
     }
 
+    if (device_param->is_native == true)
+    {
+      device_param->kernel_params_decompress[0] = NULL; // &device_param->native_d_pws_idx;
+      device_param->kernel_params_decompress[1] = NULL; // &device_param->native_d_pws_comp_buf;
+      device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                        // ? &device_param->native_d_pws_buf
+                                                        // : &device_param->native_d_pws_amp_buf;
+    }
+
     device_param->kernel_params_decompress[3] = &device_param->kernel_params_decompress_buf64[3];
 
     /**
@@ -15723,6 +18091,11 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       rc = backend_session_setup_opencl_kernel_types (hashcat_ctx, device_param, kern_type);
     }
 
+    if (device_param->is_native == true)
+    {
+      rc = backend_session_setup_native_kernel_types (hashcat_ctx, device_param, kern_type);
+    }
+
     if (rc == -2)
     {
       backend_kernel_create_warnings++;
@@ -16077,6 +18450,93 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       }
     }
 
+    if (device_param->is_native == true)
+    {
+      // zero some data buffers
+
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_digests_shown, device_param->size_shown)   == -1) return -1;
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_result,        device_param->size_results) == -1) return -1;
+
+      // special buffers
+
+      if (user_options->slow_candidates == true)
+      {
+        if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_rules_c, size_rules_c) == -1) return -1;
+      }
+      else
+      {
+        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+        {
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_rules_c, size_rules_c) == -1) return -1;
+        }
+        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+        {
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_combs,          size_combs)       == -1) return -1;
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_combs_c,        size_combs)       == -1) return -1;
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_root_css_buf,   size_root_css)    == -1) return -1;
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_markov_css_buf, size_markov_css)  == -1) return -1;
+        }
+        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+        {
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_bfs,            size_bfs)         == -1) return -1;
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_bfs_c,          size_bfs)         == -1) return -1;
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_tm_c,           size_tm)          == -1) return -1;
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_root_css_buf,   size_root_css)    == -1) return -1;
+          if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_markov_css_buf, size_markov_css)  == -1) return -1;
+        }
+      }
+
+      if (user_options->slow_candidates == true)
+      {
+      }
+      else
+      {
+        if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
+        {
+          // prepare mp
+
+          if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+          {
+            device_param->kernel_params_mp_buf32[5] = 0;
+            device_param->kernel_params_mp_buf32[6] = 0;
+            device_param->kernel_params_mp_buf32[7] = 0;
+
+            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
+            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
+            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
+            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
+            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
+          }
+          else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
+          {
+            device_param->kernel_params_mp_buf32[5] = 0;
+            device_param->kernel_params_mp_buf32[6] = 0;
+            device_param->kernel_params_mp_buf32[7] = 0;
+          }
+
+          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
+        }
+        else if (user_options->attack_mode == ATTACK_MODE_BF)
+        {
+          // prepare mp_r and mp_l
+
+          device_param->kernel_params_mp_l_buf32[6] = 0;
+          device_param->kernel_params_mp_l_buf32[7] = 0;
+          device_param->kernel_params_mp_l_buf32[8] = 0;
+
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
+
+          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]); if (CL_rc == -1) return -1; }
+          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]); if (CL_rc == -1) return -1; }
+        }
+      }
+    }
+
     u32 threads_per_block = 32;
 
     if (device_param->is_cuda == true)
@@ -16145,6 +18605,10 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
     {
       threads_per_block = device_param->kernel_preferred_wgs_multiple;
     }
+    else if (device_param->is_native == true)
+    {
+      threads_per_block = 1;
+    }
 
     if (user_options->kernel_threads_chgd == true)
     {
@@ -16259,6 +18723,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
     u64 size_pws_idx  = 4;
     u64 size_pws_pre  = 4;
     u64 size_pws_base = 4;
+    u64 size_dedup    = 4;
     u64 size_tmps     = 4;
     u64 size_hooks    = 4;
     #ifdef WITH_BRAIN
@@ -16289,6 +18754,8 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     int memory_limit_hit = 0;
 
+    u64 size_total_fit = 0;
+
     const u32 kernel_accel_max_sav = kernel_accel_max;
 
     while ((kernel_accel_max >= kernel_accel_min) || (kernel_threads_max >= kernel_threads_min))
@@ -16342,6 +18809,13 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         size_pws_base = kernel_power_max * sizeof (pw_pre_t);
       }
 
+      if (user_options->dedup == true)
+      {
+        // size_dedup, batch hashes plus the open addressing set over them
+
+        size_dedup = kernel_power_max * sizeof (u64) * 5;
+      }
+
       // now check if all device-memory sizes which depend on the kernel_accel_max amplifier are within its boundaries
       // if not, decrease amplifier and try again
 
@@ -16447,6 +18921,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
         #endif
         + size_pws_pre
         + size_pws_base
+        + size_dedup
         + size_host_extra;
 
       if (size_total_host > accel_limit_host) memory_limit_hit = 1;
@@ -16478,6 +18953,8 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
       size_total_host_all += size_total_host;
 
+      size_total_fit = size_total;
+
       break;
     }
 
@@ -16493,15 +18970,17 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
     }
 
     // similar process for association attack
-    // there's no need to have a device_power > salts_cnt since salt_pos is set to GID in kernel
+    // there's no need to have a device_power > salts_cnt * association_width since salt_pos is derived from GID in kernel
 
     if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
     {
+      const u64 association_cnt = (u64) hashes->salts_cnt * user_options->association_width;
+
       while (kernel_accel_max > kernel_accel_min)
       {
         const u64 kernel_power_max = device_param->device_processors * kernel_accel_max;
 
-        if (kernel_power_max > hashes->salts_cnt)
+        if (kernel_power_max > association_cnt)
         {
           kernel_accel_max--;
 
@@ -16529,6 +19008,7 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
     device_param->size_pws_base = size_pws_base;
     device_param->size_tmps     = size_tmps;
     device_param->size_hooks    = size_hooks;
+    device_param->size_total    = size_total_fit;
     #ifdef WITH_BRAIN
     device_param->size_brain_link_in  = size_brain_link_in;
     device_param->size_brain_link_out = size_brain_link_out;
@@ -16604,13 +19084,30 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_hooks,         device_param->size_hooks)    == -1) return -1;
     }
 
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_pws_buf,      size_pws)      == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_pws_amp_buf,  size_pws_amp)  == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_pws_comp_buf, size_pws_comp) == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_pws_idx,      size_pws_idx)  == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_tmps,         size_tmps)     == -1) return -1;
+      if (hc_nativeMemAlloc (hashcat_ctx, &device_param->native_d_hooks,        size_hooks)    == -1) return -1;
+
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_pws_buf,       device_param->size_pws)      == -1) return -1;
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_tmps,          device_param->size_tmps)     == -1) return -1;
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_hooks,         device_param->size_hooks)    == -1) return -1;
+    }
+
     /**
      * main host data
      */
 
     if (hashconfig->bridge_type)
     {
-      void *h_tmps = hcmalloc_bridge_aligned (device_param->size_tmps, 64);
+      void *h_tmps = hcmalloc_numa (&backend_ctx->numa_topology, device_param->size_tmps, device_param->numa_node, user_options->numa_hugepages);
 
       device_param->h_tmps = h_tmps;
     }
@@ -16635,6 +19132,10 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     device_param->scratch_buf = scratch_buf;
 
+    u8 *cracked_buf = (u8 *) hcmalloc (HCBUFSIZ_LARGE);
+
+    device_param->cracked_buf = cracked_buf;
+
     #ifdef WITH_BRAIN
     u8 *brain_link_in_buf = (u8 *) hcmalloc (size_brain_link_in);
 
@@ -16653,6 +19154,8 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     device_param->pws_base_buf = pws_base_buf;
 
+    if (dedup_device_init (hashcat_ctx, device_param) == -1) return -1;
+
     /**
      * kernel args
      */
@@ -16687,6 +19190,13 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       device_param->kernel_params[ 5] = &device_param->opencl_d_hooks;
     }
 
+    if (device_param->is_native == true)
+    {
+      device_param->kernel_params[ 0] = &device_param->native_d_pws_buf;
+      device_param->kernel_params[ 4] = &device_param->native_d_tmps;
+      device_param->kernel_params[ 5] = &device_param->native_d_hooks;
+    }
+
     if (user_options->slow_candidates == true)
     {
     }
@@ -16735,6 +19245,15 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
             if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]) == -1) return -1;
           }
+
+          if (device_param->is_native == true)
+          {
+            device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                              ? &device_param->native_d_pws_buf
+                                              : &device_param->native_d_pws_amp_buf;
+
+            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]); if (CL_rc == -1) return -1;
+          }
         }
       }
 
@@ -16775,6 +19294,15 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
           if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]) == -1) return -1;
         }
+
+        if (device_param->is_native == true)
+        {
+          device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                              ? &device_param->native_d_pws_buf
+                                              : &device_param->native_d_pws_amp_buf;
+
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]); if (CL_rc == -1) return -1;
+        }
       }
 
       if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
@@ -16817,6 +19345,15 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
           if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]) == -1) return -1;
           if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]) == -1) return -1;
         }
+
+        if (device_param->is_native == true)
+        {
+          device_param->kernel_params_amp[0] = &device_param->native_d_pws_buf;
+          device_param->kernel_params_amp[1] = &device_param->native_d_pws_amp_buf;
+
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]); if (CL_rc == -1) return -1;
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]); if (CL_rc == -1) return -1;
+        }
       }
     }
 
@@ -16870,6 +19407,19 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]) == -1) return -1;
     }
 
+    if (device_param->is_native == true)
+    {
+      device_param->kernel_params_decompress[0] = &device_param->native_d_pws_idx;
+      device_param->kernel_params_decompress[1] = &device_param->native_d_pws_comp_buf;
+      device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                ? &device_param->native_d_pws_buf
+                                                : &device_param->native_d_pws_amp_buf;
+
+      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
+      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
+      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
+    }
+
     // context
 
     if (device_param->is_cuda == true)
@@ -16929,24 +19479,34 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
 void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
 {
-  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+  backend_ctx_t  *backend_ctx  = hashcat_ctx->backend_ctx;
+  resident_ctx_t *resident_ctx = hashcat_ctx->resident_ctx;
 
   if (backend_ctx->enabled == false) return;
 
+  backend_ctx->session_built    = false;
+  backend_ctx->session_build_rc = 0;
+
   for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
   {
     hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
 
     if (device_param->skipped == true) continue;
 
-    hcfree_bridge_aligned (device_param->h_tmps);
+    hcfree_numa (device_param->h_tmps);
     hcfree (device_param->pws_comp);
     hcfree (device_param->pws_idx);
     hcfree (device_param->pws_pre_buf);
     hcfree (device_param->pws_base_buf);
+    dedup_device_destroy (device_param);
+    combs_cache_release (hashcat_ctx, device_param);
+
+    device_param->combs_cache_gen = 0;
+
     hcfree (device_param->combs_buf);
     hcfree (device_param->hooks_buf);
     hcfree (device_param->scratch_buf);
+    hcfree (device_param->cracked_buf);
     #ifdef WITH_BRAIN
     hcfree (device_param->brain_link_in_buf);
     hcfree (device_param->brain_link_out_buf);
@@ -16998,11 +19558,6 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
 
       hc_cuStreamDestroyPtr     (hashcat_ctx, &device_param->cuda_stream);
 
-      hc_cuModuleUnloadPtr      (hashcat_ctx, &device_param->cuda_module);
-      hc_cuModuleUnloadPtr      (hashcat_ctx, &device_param->cuda_module_mp);
-      hc_cuModuleUnloadPtr      (hashcat_ctx, &device_param->cuda_module_amp);
-      hc_cuModuleUnloadPtr      (hashcat_ctx, &device_param->cuda_module_shared);
-
       device_param->cuda_d_rules_c              = 0;
       device_param->cuda_d_bfs_c                = 0;
 
@@ -17082,11 +19637,6 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
 
       hc_hipStreamDestroyPtr    (hashcat_ctx, &device_param->hip_stream);
 
-      hc_hipModuleUnloadPtr     (hashcat_ctx, &device_param->hip_module);
-      hc_hipModuleUnloadPtr     (hashcat_ctx, &device_param->hip_module_mp);
-      hc_hipModuleUnloadPtr     (hashcat_ctx, &device_param->hip_module_amp);
-      hc_hipModuleUnloadPtr     (hashcat_ctx, &device_param->hip_module_shared);
-
       device_param->hip_d_rules_c              = 0;
       device_param->hip_d_bfs_c                = 0;
 
@@ -17184,11 +19734,6 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       hc_mtlReleaseFunction  (hashcat_ctx, &device_param->metal_function_aux3);
       hc_mtlReleaseFunction  (hashcat_ctx, &device_param->metal_function_aux4);
 
-      hc_mtlReleaseLibrary   (hashcat_ctx, &device_param->metal_library);
-      hc_mtlReleaseLibrary   (hashcat_ctx, &device_param->metal_library_mp);
-      hc_mtlReleaseLibrary   (hashcat_ctx, &device_param->metal_library_amp);
-      hc_mtlReleaseLibrary   (hashcat_ctx, &device_param->metal_library_shared);
-
       //if (device_param->metal_command_queue) hc_mtlReleaseCommandQueue (hashcat_ctx, device_param->metal_command_queue);
       //if (device_param->metal_device)    hc_mtlReleaseDevice (hashcat_ctx, device_param->metal_device);
 
@@ -17263,11 +19808,6 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       hc_clReleaseKernelPtr     (hashcat_ctx, &device_param->opencl_kernel_aux3);
       hc_clReleaseKernelPtr     (hashcat_ctx, &device_param->opencl_kernel_aux4);
 
-      hc_clReleaseProgramPtr    (hashcat_ctx, &device_param->opencl_program);
-      hc_clReleaseProgramPtr    (hashcat_ctx, &device_param->opencl_program_mp);
-      hc_clReleaseProgramPtr    (hashcat_ctx, &device_param->opencl_program_amp);
-      hc_clReleaseProgramPtr    (hashcat_ctx, &device_param->opencl_program_shared);
-
       //if (device_param->opencl_command_queue) hc_clReleaseCommandQueue (hashcat_ctx, device_param->opencl_command_queue);
       //if (device_param->opencl_context)  hc_clReleaseContext (hashcat_ctx, device_param->opencl_context);
 
@@ -17275,6 +19815,77 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       //device_param->opencl_context       = NULL;
     }
 
+    if (device_param->is_native == true)
+    {
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_pws_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_pws_amp_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_pws_comp_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_pws_idx);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_rules);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_rules_c);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_combs);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_combs_c);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bfs);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bfs_c);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bitmap_s1_a);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bitmap_s1_b);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bitmap_s1_c);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bitmap_s1_d);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bitmap_s2_a);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bitmap_s2_b);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bitmap_s2_c);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_bitmap_s2_d);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_plain_bufs);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_digests_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_digests_shown);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_salt_bufs);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_esalt_bufs);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_tmps);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_hooks);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_result);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_extra0_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_extra1_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_extra2_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_extra3_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_root_css_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_markov_css_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_tm_c);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_st_digests_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_st_salts_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_st_esalts_buf);
+      hc_nativeMemFreePtr   (hashcat_ctx, &device_param->native_d_kernel_param);
+
+      device_param->native_function1.kernel                = NULL;
+      device_param->native_function12.kernel               = NULL;
+      device_param->native_function2p.kernel               = NULL;
+      device_param->native_function2.kernel                = NULL;
+      device_param->native_function2e.kernel               = NULL;
+      device_param->native_function23.kernel               = NULL;
+      device_param->native_function3.kernel                = NULL;
+      device_param->native_function4.kernel                = NULL;
+      device_param->native_function_init2.kernel           = NULL;
+      device_param->native_function_loop2p.kernel          = NULL;
+      device_param->native_function_loop2.kernel           = NULL;
+      device_param->native_function_mp.kernel              = NULL;
+      device_param->native_function_mp_l.kernel            = NULL;
+      device_param->native_function_mp_r.kernel            = NULL;
+      device_param->native_function_tm.kernel              = NULL;
+      device_param->native_function_amp.kernel             = NULL;
+      device_param->native_function_memset.kernel          = NULL;
+      device_param->native_function_bzero.kernel           = NULL;
+      device_param->native_function_atinit.kernel          = NULL;
+      device_param->native_function_utf8toutf16le.kernel   = NULL;
+      device_param->native_function_decompress.kernel      = NULL;
+      device_param->native_function_aux1.kernel            = NULL;
+      device_param->native_function_aux2.kernel            = NULL;
+      device_param->native_function_aux3.kernel            = NULL;
+      device_param->native_function_aux4.kernel            = NULL;
+    }
+
+    // a daemon keeps the programs for its next job, see load_kernel ()
+
+    if (resident_ctx->enabled == false) unload_kernels (hashcat_ctx, device_param);
+
     device_param->h_tmps              = NULL;
     device_param->pws_comp            = NULL;
     device_param->pws_idx             = NULL;
@@ -17283,6 +19894,7 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
     device_param->combs_buf           = NULL;
     device_param->hooks_buf           = NULL;
     device_param->scratch_buf         = NULL;
+    device_param->cracked_buf         = NULL;
     #ifdef WITH_BRAIN
     device_param->brain_link_in_buf   = NULL;
     device_param->brain_link_out_buf  = NULL;
@@ -17290,6 +19902,20 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
   }
 }
 
+void backend_session_programs_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  if (backend_ctx->enabled == false) return;
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+    unload_kernels (hashcat_ctx, device_param);
+  }
+}
+
 void backend_session_reset (hashcat_ctx_t *hashcat_ctx)
 {
   backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
@@ -17434,6 +20060,12 @@ int backend_session_update_mp (hashcat_ctx_t *hashcat_ctx)
 
       if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
     }
+
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_root_css_buf,   mask_ctx->root_css_buf,   device_param->size_root_css)   == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_markov_css_buf, mask_ctx->markov_css_buf, device_param->size_markov_css) == -1) return -1;
+    }
   }
 
   return 0;
@@ -17490,6 +20122,12 @@ int backend_session_update_mp_rl (hashcat_ctx_t *hashcat_ctx, const u32 css_cnt_
 
       if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
     }
+
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_root_css_buf,   mask_ctx->root_css_buf,   device_param->size_root_css)   == -1) return -1;
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_markov_css_buf, mask_ctx->markov_css_buf, device_param->size_markov_css) == -1) return -1;
+    }
   }
 
   return 0;
@@ -141,25 +141,17 @@ int benchmark_next (hashcat_ctx_t *hashcat_ctx)
     return hash_mode;
   }
 
-  char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
-
   for (int i = cur; i < MODULE_HASH_MODES_MAXIMUM; i++)
   {
-    module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
-
-    if (hc_path_exist (modulefile) == true)
+    if (module_exists (folder_config, i) == true)
     {
       const int hash_mode = i;
 
       cur = hash_mode + 1;
 
-      hcfree (modulefile);
-
       return hash_mode;
     }
   }
 
-  hcfree (modulefile);
-
   return -1;
 }
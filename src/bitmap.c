@@ -70,6 +70,47 @@ static bool generate_bitmaps (const u32 digests_cnt, const u32 dgst_size, const
   return false;
 }
 
+static void digest_to_bitmap_l1 (const u32 *digest_ptr, const u32 dgst_pos0, const u32 dgst_pos1, const u32 dgst_pos2, const u32 dgst_pos3, u32 *bitmap_l1)
+{
+  // same bits as check_l1() in OpenCL/inc_common.cl
+
+  const u32 bit0 = digest_ptr[dgst_pos0] >> (32 - BITMAP_L1_BITS);
+  const u32 bit1 = digest_ptr[dgst_pos1] >> (32 - BITMAP_L1_BITS);
+  const u32 bit2 = digest_ptr[dgst_pos2] >> (32 - BITMAP_L1_BITS);
+  const u32 bit3 = digest_ptr[dgst_pos3] >> (32 - BITMAP_L1_BITS);
+
+  bitmap_l1[bit0 >> 5] |= 1U << (bit0 & 0x1f);
+  bitmap_l1[bit1 >> 5] |= 1U << (bit1 & 0x1f);
+  bitmap_l1[bit2 >> 5] |= 1U << (bit2 & 0x1f);
+  bitmap_l1[bit3 >> 5] |= 1U << (bit3 & 0x1f);
+}
+
+static double generate_bitmap_l1 (const u32 digests_cnt, const u32 dgst_size, char *digests_buf_ptr, char *st_digests_buf_ptr, const u32 dgst_pos0, const u32 dgst_pos1, const u32 dgst_pos2, const u32 dgst_pos3, u32 *bitmap_l1)
+{
+  memset (bitmap_l1, 0, BITMAP_L1_SIZE);
+
+  for (u32 i = 0; i < digests_cnt; i++)
+  {
+    digest_to_bitmap_l1 ((u32 *) digests_buf_ptr, dgst_pos0, dgst_pos1, dgst_pos2, dgst_pos3, bitmap_l1);
+
+    digests_buf_ptr += dgst_size;
+  }
+
+  if (st_digests_buf_ptr != NULL)
+  {
+    digest_to_bitmap_l1 ((u32 *) st_digests_buf_ptr, dgst_pos0, dgst_pos1, dgst_pos2, dgst_pos3, bitmap_l1);
+  }
+
+  u32 bits_set = 0;
+
+  for (u32 i = 0; i < BITMAP_L1_NUMS; i++)
+  {
+    bits_set += __builtin_popcount (bitmap_l1[i]);
+  }
+
+  return (double) bits_set / (BITMAP_L1_NUMS * 32);
+}
+
 int bitmap_ctx_init (hashcat_ctx_t *hashcat_ctx)
 {
   hashes_t       *hashes       = hashcat_ctx->hashes;
@@ -101,7 +142,9 @@ int bitmap_ctx_init (hashcat_ctx_t *hashcat_ctx)
   const u32 bitmap_min = user_options->bitmap_min;
   const u32 bitmap_max = user_options->bitmap_max;
 
-  u32 *bitmap_s1_a = (u32 *) hcmalloc ((1U << bitmap_max) * sizeof (u32));
+  // bitmap_s1_a has the first-level bitmap behind it, see BITMAP_L1_BITS
+
+  u32 *bitmap_s1_a = (u32 *) hcmalloc ((1U << bitmap_max) * sizeof (u32) + BITMAP_L1_SIZE);
   u32 *bitmap_s1_b = (u32 *) hcmalloc ((1U << bitmap_max) * sizeof (u32));
   u32 *bitmap_s1_c = (u32 *) hcmalloc ((1U << bitmap_max) * sizeof (u32));
   u32 *bitmap_s1_d = (u32 *) hcmalloc ((1U << bitmap_max) * sizeof (u32));
@@ -149,6 +192,22 @@ int bitmap_ctx_init (hashcat_ctx_t *hashcat_ctx)
     selftest_to_bitmap (bitmap_shift2, (char *) hashes->st_digests_buf, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, bitmap_mask, bitmap_s2_a, bitmap_s2_b, bitmap_s2_c, bitmap_s2_d);
   }
 
+  /**
+   * first-level bitmap, the kernels which support it check it from local memory before they go to the ones above
+   * with a large hashlist it is full of ones and rejects nothing, in that case it is not used at all
+   */
+
+  u32 *bitmap_l1 = bitmap_s1_a + bitmap_nums;
+
+  const double bitmap_l1_fill = generate_bitmap_l1 (hashes->digests_cnt, hashconfig->dgst_size, (char *) hashes->digests_buf, (hashconfig->st_hash != NULL) ? (char *) hashes->st_digests_buf : NULL, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, bitmap_l1);
+
+  // a candidate passes it if all four of its bits are set
+
+  const double bitmap_l1_pass = bitmap_l1_fill * bitmap_l1_fill * bitmap_l1_fill * bitmap_l1_fill;
+
+  bitmap_ctx->bitmap_l1_fill    = bitmap_l1_fill;
+  bitmap_ctx->bitmap_l1_enabled = (user_options->bitmap_l1 == true) && (bitmap_l1_pass <= BITMAP_L1_PASS_MAX);
+
   bitmap_ctx->bitmap_bits   = bitmap_bits;
   bitmap_ctx->bitmap_nums   = bitmap_nums;
   bitmap_ctx->bitmap_size   = bitmap_size;
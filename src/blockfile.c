@@ -0,0 +1,1353 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "shared.h"
+#include "thread.h"
+#include "dynloader.h"
+#include "folder.h"
+#include "filehandling.h"
+#include "ext_zstd.h"
+#include "blockfile.h"
+
+#include <Alloc.h>
+#include <7zCrc.h>
+#include <7zFile.h>
+#include <Xz.h>
+#include <XzCrc64.h>
+
+/**
+ * A blockfile is a compressed wordlist made of independently decodable blocks:
+ * BGZF style gzip members, xz blocks or zstd frames. The block layout is kept in
+ * an index which is persisted next to the dictstat cache, a seek jumps straight
+ * to the block holding the offset and a pool of workers decodes the next blocks
+ * while the wordlist engine consumes the current one.
+ */
+
+typedef struct blockfile_block
+{
+  u64 in_off;
+  u64 in_len;
+  u64 out_off;
+  u64 out_len;
+  u32 flags; // xz stream flags
+  u32 pad;
+
+} blockfile_block_t;
+
+typedef struct blockfile_job
+{
+  u64 block_first;
+  u64 block_last;
+  u64 in_off;
+  u64 in_len;
+  u64 out_off;
+  u64 out_len;
+
+} blockfile_job_t;
+
+typedef struct blockfile_word_mark
+{
+  u64 words;
+  u64 offset;
+
+} blockfile_word_mark_t;
+
+typedef struct blockfile_index_hdr
+{
+  u32 magic;
+  u32 version;
+  u32 kind;
+  u32 flags;
+  u64 file_size;
+  u64 file_mtime;
+  u64 blocks_cnt;
+  u64 marks_cnt;
+  u64 marks_sig;
+
+} blockfile_index_hdr_t;
+
+typedef struct blockfile_slot
+{
+  blockfile_t          *bfp;
+
+  hc_thread_t           thread;
+  hc_thread_semaphore_t sem_work;
+  hc_thread_semaphore_t sem_done;
+
+  int                   fd;
+  u8                   *in_buf;
+  u8                   *out_buf;
+
+  u64                   job;
+  bool                  pending;
+  int                   rc;
+
+  ZSTD_DCtx            *dctx;
+  z_stream              zs;
+  bool                  zs_init;
+  CXzUnpacker           xz;
+  bool                  xz_init;
+
+} blockfile_slot_t;
+
+struct blockfile
+{
+  int                    kind;
+  char                  *path;
+  int                    fd;
+
+  u64                    file_size;
+  u64                    file_mtime;
+  u64                    size;
+
+  blockfile_block_t     *blocks;
+  u64                    blocks_cnt;
+  u64                    blocks_avail;
+
+  blockfile_job_t       *jobs;
+  u64                    jobs_cnt;
+
+  blockfile_word_mark_t *marks;
+  u64                    marks_cnt;
+  u64                    marks_avail;
+  u64                    marks_sig;
+
+  bool                   index_dirty;
+
+  blockfile_slot_t      *slots;
+  int                    slots_cnt;
+  bool                   shutdown;
+
+  u64                    job_cur;
+  u64                    job_pos;
+  u64                    job_next;
+  bool                   job_ready;
+
+  u64                    tell;
+
+  // zstd frames without content size are decoded as a single stream
+
+  bool                   streaming;
+  ZSTD_DStream          *zds;
+  u8                    *st_in;
+  size_t                 st_in_len;
+  size_t                 st_in_pos;
+  bool                   st_in_eof;
+  u8                    *st_out;
+  size_t                 st_out_len;
+  size_t                 st_out_pos;
+  bool                   st_eof;
+};
+
+static char *blockfile_cache_dir = NULL;
+
+static bool blockfile_initialized = false;
+
+static const ISzAlloc blockfile_xz_alloc = { hc_lzma_alloc, hc_lzma_free };
+
+static hc_zstd_lib_t *blockfile_zstd = NULL;
+
+static hc_zstd_lib_t *blockfile_zstd_load (void)
+{
+  hc_zstd_lib_t *zstd = (hc_zstd_lib_t *) hcmalloc (sizeof (hc_zstd_lib_t));
+
+  #if defined (_WIN)
+  zstd->lib = hc_dlopen ("libzstd.dll");
+  #elif defined (__APPLE__)
+  zstd->lib = hc_dlopen ("libzstd.1.dylib");
+  if (zstd->lib == NULL) zstd->lib = hc_dlopen ("libzstd.dylib");
+  #else
+  zstd->lib = hc_dlopen ("libzstd.so.1");
+  if (zstd->lib == NULL) zstd->lib = hc_dlopen ("libzstd.so");
+  #endif
+
+  if (zstd->lib == NULL)
+  {
+    hcfree (zstd);
+
+    return NULL;
+  }
+
+  zstd->ZSTD_createDCtx       = (ZSTD_CREATEDCTX)       hc_dlsym (zstd->lib, "ZSTD_createDCtx");
+  zstd->ZSTD_freeDCtx         = (ZSTD_FREEDCTX)         hc_dlsym (zstd->lib, "ZSTD_freeDCtx");
+  zstd->ZSTD_decompressDCtx   = (ZSTD_DECOMPRESSDCTX)   hc_dlsym (zstd->lib, "ZSTD_decompressDCtx");
+  zstd->ZSTD_initDStream      = (ZSTD_INITDSTREAM)      hc_dlsym (zstd->lib, "ZSTD_initDStream");
+  zstd->ZSTD_decompressStream = (ZSTD_DECOMPRESSSTREAM) hc_dlsym (zstd->lib, "ZSTD_decompressStream");
+  zstd->ZSTD_isError          = (ZSTD_ISERROR)          hc_dlsym (zstd->lib, "ZSTD_isError");
+
+  if ((zstd->ZSTD_createDCtx       == NULL)
+   || (zstd->ZSTD_freeDCtx         == NULL)
+   || (zstd->ZSTD_decompressDCtx   == NULL)
+   || (zstd->ZSTD_initDStream      == NULL)
+   || (zstd->ZSTD_decompressStream == NULL)
+   || (zstd->ZSTD_isError          == NULL))
+  {
+    hc_dlclose (zstd->lib);
+
+    hcfree (zstd);
+
+    return NULL;
+  }
+
+  return zstd;
+}
+
+void blockfile_init (void)
+{
+  // a second hashcat_ctx in the same process keeps the tables and library of the first
+
+  if (blockfile_initialized == true) return;
+
+  blockfile_initialized = true;
+
+  CrcGenerateTable ();
+  Crc64GenerateTable ();
+  Sha256Prepare ();
+
+  blockfile_zstd = blockfile_zstd_load ();
+}
+
+void blockfile_set_cache_dir (const char *cache_dir)
+{
+  hcfree (blockfile_cache_dir);
+
+  blockfile_cache_dir = (cache_dir == NULL) ? NULL : hcstrdup (cache_dir);
+}
+
+static int blockfile_open_fd (const char *path)
+{
+  #if defined (_WIN)
+  return open (path, O_RDONLY | O_BINARY);
+  #else
+  return open (path, O_RDONLY);
+  #endif
+}
+
+static bool blockfile_pread (const int fd, u8 *buf, const u64 len, const u64 off)
+{
+  if (lseek (fd, (off_t) off, SEEK_SET) == (off_t) -1) return false;
+
+  u64 done = 0;
+
+  while (done < len)
+  {
+    const ssize_t nread = read (fd, buf + done, (size_t) (len - done));
+
+    if (nread <= 0) return false;
+
+    done += (u64) nread;
+  }
+
+  return true;
+}
+
+static u32 blockfile_le16 (const u8 *buf)
+{
+  return ((u32) buf[0] << 0)
+       | ((u32) buf[1] << 8);
+}
+
+static u32 blockfile_le32 (const u8 *buf)
+{
+  return ((u32) buf[0] <<  0)
+       | ((u32) buf[1] <<  8)
+       | ((u32) buf[2] << 16)
+       | ((u32) buf[3] << 24);
+}
+
+static void blockfile_add_block (blockfile_t *bfp, const u64 in_off, const u64 in_len, const u64 out_len, const u32 flags)
+{
+  if (out_len == 0) return;
+
+  if (bfp->blocks_cnt == bfp->blocks_avail)
+  {
+    bfp->blocks = (blockfile_block_t *) hcrealloc (bfp->blocks, bfp->blocks_avail * sizeof (blockfile_block_t), BLOCKFILE_INDEX_INCR * sizeof (blockfile_block_t));
+
+    bfp->blocks_avail += BLOCKFILE_INDEX_INCR;
+  }
+
+  blockfile_block_t *block = &bfp->blocks[bfp->blocks_cnt];
+
+  block->in_off  = in_off;
+  block->in_len  = in_len;
+  block->out_off = bfp->size;
+  block->out_len = out_len;
+  block->flags   = flags;
+  block->pad     = 0;
+
+  bfp->blocks_cnt++;
+
+  bfp->size += out_len;
+}
+
+static void blockfile_reset_blocks (blockfile_t *bfp)
+{
+  bfp->blocks_cnt = 0;
+  bfp->size       = 0;
+}
+
+/**
+ * index builders, return 0 on success and -1 if the file has no usable block layout
+ */
+
+static int blockfile_index_gzip (blockfile_t *bfp)
+{
+  // BGZF: every member carries its compressed size in a 'BC' extra subfield
+
+  u64 pos = 0;
+
+  while (pos < bfp->file_size)
+  {
+    u8 hdr[18];
+
+    if ((bfp->file_size - pos) < sizeof (hdr)) return -1;
+
+    if (blockfile_pread (bfp->fd, hdr, sizeof (hdr), pos) == false) return -1;
+
+    if (hdr[0] != 0x1f || hdr[1] != 0x8b || hdr[2] != 0x08 || hdr[3] != 0x04) return -1;
+
+    const u32 xlen = blockfile_le16 (hdr + 10);
+
+    if (xlen < 6) return -1;
+
+    if (hdr[12] != 'B' || hdr[13] != 'C' || blockfile_le16 (hdr + 14) != 2) return -1;
+
+    const u64 bsize = (u64) blockfile_le16 (hdr + 16) + 1;
+
+    if ((pos + bsize) > bfp->file_size) return -1;
+
+    u8 isize[4];
+
+    if (blockfile_pread (bfp->fd, isize, sizeof (isize), pos + bsize - 4) == false) return -1;
+
+    blockfile_add_block (bfp, pos, bsize, blockfile_le32 (isize), 0);
+
+    pos += bsize;
+  }
+
+  return 0;
+}
+
+static int blockfile_index_xz (blockfile_t *bfp)
+{
+  ISzAllocPtr alloc = &blockfile_xz_alloc;
+
+  CFileInStream inStream;
+
+  FileInStream_CreateVTable (&inStream);
+
+  File_Construct (&inStream.file);
+
+  if (InFile_Open (&inStream.file, bfp->path) != SZ_OK) return -1;
+
+  Byte *lookBuf = (Byte *) hcmalloc (BLOCKFILE_STREAM_SIZE);
+
+  CLookToRead2 lookStream;
+
+  LookToRead2_CreateVTable (&lookStream, false);
+
+  lookStream.buf        = lookBuf;
+  lookStream.bufSize    = BLOCKFILE_STREAM_SIZE;
+  lookStream.realStream = &inStream.vt;
+
+  LookToRead2_INIT (&lookStream);
+
+  CXzs streams;
+
+  Xzs_Construct (&streams);
+
+  Int64 offset = 0;
+
+  const SRes res = Xzs_ReadBackward (&streams, &lookStream.vt, &offset, NULL, alloc);
+
+  int rc = -1;
+
+  if (res == SZ_OK && offset == 0)
+  {
+    rc = 0;
+
+    // streams are stored from the last to the first
+
+    for (size_t i = streams.num; i > 0; i--)
+    {
+      const CXzStream *stream = &streams.streams[i - 1];
+
+      u64 block_off = stream->startOffset + XZ_STREAM_HEADER_SIZE;
+
+      for (size_t j = 0; j < stream->numBlocks; j++)
+      {
+        const CXzBlockSizes *sizes = &stream->blocks[j];
+
+        if (sizes->unpackSize == XZ_SIZE_OVERFLOW)
+        {
+          rc = -1;
+
+          break;
+        }
+
+        const u64 block_len = (sizes->totalSize + 3) & ~(u64) 3;
+
+        blockfile_add_block (bfp, block_off, block_len, sizes->unpackSize, stream->flags);
+
+        block_off += block_len;
+      }
+
+      if (rc == -1) break;
+    }
+  }
+
+  Xzs_Free (&streams, alloc);
+
+  File_Close (&inStream.file);
+
+  hcfree (lookBuf);
+
+  return rc;
+}
+
+static int blockfile_index_zstd (blockfile_t *bfp)
+{
+  // walk the frame headers, every frame needs a known content size (RFC 8878)
+
+  static const u32 did_sizes[4] = { 0, 1, 2, 4 };
+
+  u64 pos = 0;
+
+  while (pos < bfp->file_size)
+  {
+    u8 hdr[18] = { 0 };
+
+    const u64 hdr_max = MIN (sizeof (hdr), bfp->file_size - pos);
+
+    if (hdr_max < 8) return -1;
+
+    if (blockfile_pread (bfp->fd, hdr, hdr_max, pos) == false) return -1;
+
+    const u32 magic = blockfile_le32 (hdr);
+
+    if ((magic & ZSTD_MAGIC_SKIPPABLE_MASK) == ZSTD_MAGIC_SKIPPABLE_START)
+    {
+      pos += 8 + (u64) blockfile_le32 (hdr + 4);
+
+      continue;
+    }
+
+    if (magic != ZSTD_MAGICNUMBER) return -1;
+
+    const u32 fhd = hdr[4];
+
+    if (fhd & 0x08) return -1;
+
+    const u32 fcs_flag     = (fhd >> 6) & 3;
+    const u32 single_seg   = (fhd >> 5) & 1;
+    const u32 has_checksum = (fhd >> 2) & 1;
+    const u32 did_size     = did_sizes[fhd & 3];
+    const u32 fcs_size     = (fcs_flag == 0) ? single_seg : (1u << fcs_flag);
+
+    if (fcs_size == 0) return -1;
+
+    const u32 fcs_pos = 5 + (1 - single_seg) + did_size;
+    const u32 hdr_len = fcs_pos + fcs_size;
+
+    if (hdr_len > hdr_max) return -1;
+
+    u64 fcs = 0;
+
+    for (u32 i = 0; i < fcs_size; i++) fcs |= (u64) hdr[fcs_pos + i] << (i * 8);
+
+    if (fcs_size == 2) fcs += 256;
+
+    u64 block_pos = pos + hdr_len;
+
+    while (true)
+    {
+      u8 bh[3];
+
+      if ((block_pos + sizeof (bh)) > bfp->file_size) return -1;
+
+      if (blockfile_pread (bfp->fd, bh, sizeof (bh), block_pos) == false) return -1;
+
+      const u32 v = bh[0] | ((u32) bh[1] << 8) | ((u32) bh[2] << 16);
+
+      const u32 last  = v & 1;
+      const u32 type  = (v >> 1) & 3;
+      const u32 bsize = v >> 3;
+
+      if (type == 3) return -1;
+
+      block_pos += sizeof (bh) + ((type == 1) ? 1 : bsize);
+
+      if (last) break;
+    }
+
+    if (has_checksum) block_pos += 4;
+
+    if (block_pos > bfp->file_size) return -1;
+
+    blockfile_add_block (bfp, pos, block_pos - pos, fcs, 0);
+
+    pos = block_pos;
+  }
+
+  return 0;
+}
+
+/**
+ * persisted index
+ */
+
+static char *blockfile_index_path (const blockfile_t *bfp)
+{
+  if (blockfile_cache_dir == NULL) return NULL;
+
+  u64 hash = 0xcbf29ce484222325;
+
+  for (const char *p = bfp->path; *p; p++)
+  {
+    hash ^= (u8) *p;
+    hash *= 0x100000001b3;
+  }
+
+  char *index_path = NULL;
+
+  hc_asprintf (&index_path, "%s/%016" PRIx64 ".blocks", blockfile_cache_dir, hash);
+
+  return index_path;
+}
+
+static int blockfile_index_load (blockfile_t *bfp)
+{
+  char *index_path = blockfile_index_path (bfp);
+
+  if (index_path == NULL) return -1;
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, index_path, "rb") == false)
+  {
+    hcfree (index_path);
+
+    return -1;
+  }
+
+  hcfree (index_path);
+
+  blockfile_index_hdr_t hdr;
+
+  int rc = -1;
+
+  if (hc_fread (&hdr, sizeof (hdr), 1, &fp) == 1
+   && hdr.magic      == BLOCKFILE_INDEX_MAGIC
+   && hdr.version    == BLOCKFILE_INDEX_VERSION
+   && hdr.kind       == (u32) bfp->kind
+   && hdr.file_size  == bfp->file_size
+   && hdr.file_mtime == bfp->file_mtime)
+  {
+    rc = 0;
+
+    for (u64 i = 0; i < hdr.blocks_cnt; i++)
+    {
+      blockfile_block_t block;
+
+      if (hc_fread (&block, sizeof (block), 1, &fp) != 1)
+      {
+        rc = -1;
+
+        break;
+      }
+
+      blockfile_add_block (bfp, block.in_off, block.in_len, block.out_len, block.flags);
+    }
+
+    if (rc == 0)
+    {
+      bfp->marks       = (blockfile_word_mark_t *) hccalloc (hdr.marks_cnt + 1, sizeof (blockfile_word_mark_t));
+      bfp->marks_avail = hdr.marks_cnt + 1;
+      bfp->marks_sig   = hdr.marks_sig;
+
+      if (hdr.marks_cnt > 0)
+      {
+        if (hc_fread (bfp->marks, sizeof (blockfile_word_mark_t), hdr.marks_cnt, &fp) == hdr.marks_cnt)
+        {
+          bfp->marks_cnt = hdr.marks_cnt;
+        }
+      }
+
+      bfp->streaming = (hdr.flags & BLOCKFILE_INDEX_STREAM) ? true : false;
+    }
+    else
+    {
+      blockfile_reset_blocks (bfp);
+    }
+  }
+
+  hc_fclose (&fp);
+
+  return rc;
+}
+
+static void blockfile_index_save (const blockfile_t *bfp)
+{
+  char *index_path = blockfile_index_path (bfp);
+
+  if (index_path == NULL) return;
+
+  hc_mkdir (blockfile_cache_dir, 0700);
+
+  // other sessions may be reading the index, so the new one replaces it only once it is complete
+
+  char *tmp_path = NULL;
+
+  hc_asprintf (&tmp_path, "%s.%u", index_path, (u32) getpid ());
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, tmp_path, "wb") == false)
+  {
+    hcfree (tmp_path);
+    hcfree (index_path);
+
+    return;
+  }
+
+  blockfile_index_hdr_t hdr;
+
+  memset (&hdr, 0, sizeof (hdr));
+
+  hdr.magic      = BLOCKFILE_INDEX_MAGIC;
+  hdr.version    = BLOCKFILE_INDEX_VERSION;
+  hdr.kind       = (u32) bfp->kind;
+  hdr.flags      = (bfp->streaming == true) ? BLOCKFILE_INDEX_STREAM : 0;
+  hdr.file_size  = bfp->file_size;
+  hdr.file_mtime = bfp->file_mtime;
+  hdr.blocks_cnt = (bfp->streaming == true) ? 0 : bfp->blocks_cnt;
+  hdr.marks_cnt  = bfp->marks_cnt;
+  hdr.marks_sig  = bfp->marks_sig;
+
+  bool ok = (hc_fwrite (&hdr, sizeof (hdr), 1, &fp) == 1);
+
+  if ((ok == true) && (hdr.blocks_cnt > 0)) ok = (hc_fwrite (bfp->blocks, sizeof (blockfile_block_t),     hdr.blocks_cnt, &fp) == hdr.blocks_cnt);
+  if ((ok == true) && (hdr.marks_cnt  > 0)) ok = (hc_fwrite (bfp->marks,  sizeof (blockfile_word_mark_t), hdr.marks_cnt,  &fp) == hdr.marks_cnt);
+
+  hc_fclose (&fp);
+
+  if ((ok == false) || (rename (tmp_path, index_path) == -1)) unlink (tmp_path);
+
+  hcfree (tmp_path);
+  hcfree (index_path);
+}
+
+/**
+ * workers
+ */
+
+static int blockfile_decode_block (blockfile_t *bfp, blockfile_slot_t *slot, const blockfile_block_t *block, const u8 *in, u8 *out)
+{
+  if (bfp->kind == BLOCKFILE_KIND_GZIP)
+  {
+    z_stream *zs = &slot->zs;
+
+    if (slot->zs_init == false)
+    {
+      memset (zs, 0, sizeof (z_stream));
+
+      if (inflateInit2 (zs, 15 + 16) != Z_OK) return -1;
+
+      slot->zs_init = true;
+    }
+    else
+    {
+      if (inflateReset (zs) != Z_OK) return -1;
+    }
+
+    zs->next_in   = (Bytef *) in;
+    zs->avail_in  = (uInt) block->in_len;
+    zs->next_out  = (Bytef *) out;
+    zs->avail_out = (uInt) block->out_len;
+
+    if (inflate (zs, Z_FINISH) != Z_STREAM_END) return -1;
+
+    if (zs->total_out != block->out_len) return -1;
+  }
+  else if (bfp->kind == BLOCKFILE_KIND_XZ)
+  {
+    CXzUnpacker *xz = &slot->xz;
+
+    if (slot->xz_init == false)
+    {
+      XzUnpacker_Construct (xz, &blockfile_xz_alloc);
+
+      slot->xz_init = true;
+    }
+
+    XzUnpacker_Init (xz);
+
+    xz->streamFlags = (CXzStreamFlags) block->flags;
+
+    XzUnpacker_PrepareToRandomBlockDecoding (xz);
+
+    SizeT in_pos  = 0;
+    SizeT out_pos = 0;
+
+    // the unpacker is at a block header until the first call, so test after decoding
+    // out_len is exact, FINISH_END lets it read the block padding and check once the output is full
+
+    do
+    {
+      SizeT in_left  = (SizeT) block->in_len  - in_pos;
+      SizeT out_left = (SizeT) block->out_len - out_pos;
+
+      ECoderStatus status;
+
+      const SRes res = XzUnpacker_Code (xz, out + out_pos, &out_left, in + in_pos, &in_left, false, CODER_FINISH_END, &status);
+
+      if (res != SZ_OK) return -1;
+
+      if (in_left == 0 && out_left == 0) return -1;
+
+      in_pos  += in_left;
+      out_pos += out_left;
+
+    } while (XzUnpacker_IsBlockFinished (xz) == false);
+
+    if (out_pos != block->out_len) return -1;
+  }
+  else if (bfp->kind == BLOCKFILE_KIND_ZSTD)
+  {
+    if (slot->dctx == NULL)
+    {
+      slot->dctx = blockfile_zstd->ZSTD_createDCtx ();
+
+      if (slot->dctx == NULL) return -1;
+    }
+
+    const size_t out_len = blockfile_zstd->ZSTD_decompressDCtx (slot->dctx, out, (size_t) block->out_len, in, (size_t) block->in_len);
+
+    if (blockfile_zstd->ZSTD_isError (out_len)) return -1;
+
+    if (out_len != block->out_len) return -1;
+  }
+
+  return 0;
+}
+
+static int blockfile_decode_job (blockfile_t *bfp, blockfile_slot_t *slot)
+{
+  const blockfile_job_t *job = &bfp->jobs[slot->job];
+
+  if (blockfile_pread (slot->fd, slot->in_buf, job->in_len, job->in_off) == false) return -1;
+
+  for (u64 i = job->block_first; i < job->block_last; i++)
+  {
+    const blockfile_block_t *block = &bfp->blocks[i];
+
+    const u8 *in  = slot->in_buf  + (block->in_off  - job->in_off);
+          u8 *out = slot->out_buf + (block->out_off - job->out_off);
+
+    if (blockfile_decode_block (bfp, slot, block, in, out) == -1) return -1;
+  }
+
+  return 0;
+}
+
+static HC_API_CALL void *thread_blockfile (void *p)
+{
+  blockfile_slot_t *slot = (blockfile_slot_t *) p;
+
+  blockfile_t *bfp = slot->bfp;
+
+  while (true)
+  {
+    hc_thread_sem_wait (slot->sem_work);
+
+    if (bfp->shutdown == true) break;
+
+    slot->rc = blockfile_decode_job (bfp, slot);
+
+    hc_thread_sem_post (slot->sem_done);
+  }
+
+  return NULL;
+}
+
+static void blockfile_submit (blockfile_t *bfp, const u64 job)
+{
+  if (job >= bfp->jobs_cnt) return;
+
+  blockfile_slot_t *slot = &bfp->slots[job % bfp->slots_cnt];
+
+  slot->job     = job;
+  slot->pending = true;
+
+  hc_thread_sem_post (slot->sem_work);
+}
+
+static void blockfile_drain (blockfile_t *bfp)
+{
+  for (int i = 0; i < bfp->slots_cnt; i++)
+  {
+    blockfile_slot_t *slot = &bfp->slots[i];
+
+    if (slot->pending == false) continue;
+
+    hc_thread_sem_wait (slot->sem_done);
+
+    slot->pending = false;
+  }
+
+  bfp->job_ready = false;
+}
+
+static void blockfile_start (blockfile_t *bfp, const u64 job)
+{
+  bfp->job_cur   = job;
+  bfp->job_pos   = 0;
+  bfp->job_next  = job + bfp->slots_cnt;
+  bfp->job_ready = false;
+
+  for (int i = 0; i < bfp->slots_cnt; i++) blockfile_submit (bfp, job + i);
+
+  bfp->tell = (job < bfp->jobs_cnt) ? bfp->jobs[job].out_off : bfp->size;
+}
+
+static bool blockfile_init_jobs (blockfile_t *bfp)
+{
+  bfp->jobs     = (blockfile_job_t *) hccalloc (bfp->blocks_cnt + 1, sizeof (blockfile_job_t));
+  bfp->jobs_cnt = 0;
+
+  u64 in_max  = 0;
+  u64 out_max = 0;
+
+  for (u64 i = 0; i < bfp->blocks_cnt; i++)
+  {
+    const blockfile_block_t *block = &bfp->blocks[i];
+
+    if (block->in_len > BLOCKFILE_BLOCK_MAX || block->out_len > BLOCKFILE_BLOCK_MAX) return false;
+
+    blockfile_job_t *job = &bfp->jobs[bfp->jobs_cnt];
+
+    if (bfp->jobs_cnt > 0)
+    {
+      blockfile_job_t *prev = &bfp->jobs[bfp->jobs_cnt - 1];
+
+      // blocks are contiguous unless skippable frames sit in between, those are read and ignored
+
+      if (prev->out_len < BLOCKFILE_JOB_SIZE && (prev->out_len + block->out_len) <= BLOCKFILE_BLOCK_MAX)
+      {
+        prev->block_last = i + 1;
+        prev->in_len     = block->in_off + block->in_len - prev->in_off;
+        prev->out_len   += block->out_len;
+
+        in_max  = MAX (in_max,  prev->in_len);
+        out_max = MAX (out_max, prev->out_len);
+
+        continue;
+      }
+    }
+
+    job->block_first = i;
+    job->block_last  = i + 1;
+    job->in_off      = block->in_off;
+    job->in_len      = block->in_len;
+    job->out_off     = block->out_off;
+    job->out_len     = block->out_len;
+
+    in_max  = MAX (in_max,  job->in_len);
+    out_max = MAX (out_max, job->out_len);
+
+    bfp->jobs_cnt++;
+  }
+
+  if (in_max > (2 * BLOCKFILE_BLOCK_MAX)) return false;
+
+  int slots_cnt = MIN (hc_get_processor_count (), BLOCKFILE_THREADS_MAX);
+
+  if ((u64) slots_cnt > bfp->jobs_cnt) slots_cnt = (int) bfp->jobs_cnt;
+
+  if (slots_cnt < 1) slots_cnt = 1;
+
+  bfp->slots     = (blockfile_slot_t *) hccalloc (slots_cnt, sizeof (blockfile_slot_t));
+  bfp->slots_cnt = 0;
+
+  for (int i = 0; i < slots_cnt; i++)
+  {
+    blockfile_slot_t *slot = &bfp->slots[i];
+
+    slot->bfp = bfp;
+    slot->fd  = blockfile_open_fd (bfp->path);
+
+    if (slot->fd == -1) return false;
+
+    slot->in_buf  = (u8 *) hcmalloc (in_max  + 1);
+    slot->out_buf = (u8 *) hcmalloc (out_max + 1);
+
+    hc_thread_sem_init (slot->sem_work);
+    hc_thread_sem_init (slot->sem_done);
+
+    hc_thread_create (slot->thread, thread_blockfile, slot);
+
+    bfp->slots_cnt++;
+  }
+
+  blockfile_start (bfp, 0);
+
+  return true;
+}
+
+/**
+ * zstd stream fallback
+ */
+
+static bool blockfile_stream_reset (blockfile_t *bfp)
+{
+  if (bfp->zds == NULL)
+  {
+    bfp->zds = blockfile_zstd->ZSTD_createDCtx ();
+
+    if (bfp->zds == NULL) return false;
+
+    bfp->st_in  = (u8 *) hcmalloc (BLOCKFILE_STREAM_SIZE);
+    bfp->st_out = (u8 *) hcmalloc (BLOCKFILE_STREAM_SIZE);
+  }
+
+  if (blockfile_zstd->ZSTD_isError (blockfile_zstd->ZSTD_initDStream (bfp->zds))) return false;
+
+  if (lseek (bfp->fd, 0, SEEK_SET) == (off_t) -1) return false;
+
+  bfp->st_in_len  = 0;
+  bfp->st_in_pos  = 0;
+  bfp->st_in_eof  = false;
+  bfp->st_out_len = 0;
+  bfp->st_out_pos = 0;
+  bfp->st_eof     = false;
+
+  bfp->tell = 0;
+
+  return true;
+}
+
+static int blockfile_stream_fill (blockfile_t *bfp)
+{
+  while (true)
+  {
+    if (bfp->st_in_pos == bfp->st_in_len && bfp->st_in_eof == false)
+    {
+      const ssize_t nread = read (bfp->fd, bfp->st_in, BLOCKFILE_STREAM_SIZE);
+
+      if (nread < 0) return -1;
+
+      if (nread == 0) bfp->st_in_eof = true;
+
+      bfp->st_in_len = (size_t) MAX (nread, 0);
+      bfp->st_in_pos = 0;
+    }
+
+    ZSTD_inBuffer  in  = { bfp->st_in,  bfp->st_in_len, bfp->st_in_pos };
+    ZSTD_outBuffer out = { bfp->st_out, BLOCKFILE_STREAM_SIZE, 0 };
+
+    const size_t rc = blockfile_zstd->ZSTD_decompressStream (bfp->zds, &out, &in);
+
+    if (blockfile_zstd->ZSTD_isError (rc)) return -1;
+
+    bfp->st_in_pos = in.pos;
+
+    if (out.pos > 0)
+    {
+      bfp->st_out_len = out.pos;
+      bfp->st_out_pos = 0;
+
+      return 1;
+    }
+
+    if (bfp->st_in_eof == true && bfp->st_in_pos == bfp->st_in_len)
+    {
+      bfp->st_eof = true;
+
+      return 0;
+    }
+  }
+}
+
+static size_t blockfile_stream_read (blockfile_t *bfp, u8 *out, const size_t len)
+{
+  size_t done = 0;
+
+  while (done < len)
+  {
+    if (bfp->st_out_pos == bfp->st_out_len)
+    {
+      if (bfp->st_eof == true) break;
+
+      const int rc = blockfile_stream_fill (bfp);
+
+      if (rc == -1) return (size_t) -1;
+
+      if (rc ==  0) break;
+    }
+
+    const size_t n = MIN (bfp->st_out_len - bfp->st_out_pos, len - done);
+
+    if (out != NULL) memcpy (out + done, bfp->st_out + bfp->st_out_pos, n);
+
+    bfp->st_out_pos += n;
+
+    done += n;
+  }
+
+  bfp->tell += done;
+
+  return done;
+}
+
+/**
+ * public interface
+ */
+
+blockfile_t *blockfile_open (const char *path, const int kind)
+{
+  if (kind == BLOCKFILE_KIND_ZSTD)
+  {
+    if (blockfile_zstd == NULL)
+    {
+      errno = ENOTSUP;
+
+      return NULL;
+    }
+  }
+
+  struct stat st;
+
+  if (stat (path, &st) == -1) return NULL;
+
+  blockfile_t *bfp = (blockfile_t *) hccalloc (1, sizeof (blockfile_t));
+
+  bfp->kind       = kind;
+  bfp->path       = hcstrdup (path);
+  bfp->file_size  = (u64) st.st_size;
+  bfp->file_mtime = (u64) st.st_mtime;
+  bfp->fd         = blockfile_open_fd (path);
+
+  if (bfp->fd == -1)
+  {
+    blockfile_close (bfp);
+
+    return NULL;
+  }
+
+  if (blockfile_index_load (bfp) == -1)
+  {
+    int rc = -1;
+
+    if (kind == BLOCKFILE_KIND_GZIP) rc = blockfile_index_gzip (bfp);
+    if (kind == BLOCKFILE_KIND_XZ)   rc = blockfile_index_xz   (bfp);
+    if (kind == BLOCKFILE_KIND_ZSTD) rc = blockfile_index_zstd (bfp);
+
+    if (rc == -1)
+    {
+      blockfile_reset_blocks (bfp);
+
+      bfp->streaming = true;
+    }
+
+    bfp->index_dirty = true;
+  }
+
+  // gzip and xz without a useful block layout are left to their single threaded readers
+
+  if (kind != BLOCKFILE_KIND_ZSTD)
+  {
+    if (bfp->streaming == true || bfp->blocks_cnt < 2)
+    {
+      bfp->index_dirty = false;
+
+      blockfile_close (bfp);
+
+      return NULL;
+    }
+  }
+
+  if (bfp->streaming == false)
+  {
+    if (blockfile_init_jobs (bfp) == false)
+    {
+      if (kind != BLOCKFILE_KIND_ZSTD)
+      {
+        bfp->index_dirty = false;
+
+        blockfile_close (bfp);
+
+        return NULL;
+      }
+
+      blockfile_drain (bfp);
+
+      blockfile_reset_blocks (bfp);
+
+      bfp->streaming   = true;
+      bfp->index_dirty = true;
+    }
+  }
+
+  if (bfp->streaming == true)
+  {
+    if (blockfile_stream_reset (bfp) == false)
+    {
+      blockfile_close (bfp);
+
+      errno = EINVAL;
+
+      return NULL;
+    }
+  }
+
+  return bfp;
+}
+
+void blockfile_close (blockfile_t *bfp)
+{
+  if (bfp == NULL) return;
+
+  blockfile_drain (bfp);
+
+  bfp->shutdown = true;
+
+  for (int i = 0; i < bfp->slots_cnt; i++)
+  {
+    blockfile_slot_t *slot = &bfp->slots[i];
+
+    hc_thread_sem_post (slot->sem_work);
+
+    hc_thread_wait (1, &slot->thread);
+
+    hc_thread_sem_close (slot->sem_work);
+    hc_thread_sem_close (slot->sem_done);
+
+    if (slot->dctx)          blockfile_zstd->ZSTD_freeDCtx (slot->dctx);
+    if (slot->zs_init)       inflateEnd (&slot->zs);
+    if (slot->xz_init)       XzUnpacker_Free (&slot->xz);
+
+    close (slot->fd);
+
+    hcfree (slot->in_buf);
+    hcfree (slot->out_buf);
+  }
+
+  if (bfp->index_dirty == true) blockfile_index_save (bfp);
+
+  if (bfp->zds) blockfile_zstd->ZSTD_freeDCtx (bfp->zds);
+
+  if (bfp->fd != -1) close (bfp->fd);
+
+  hcfree (bfp->st_in);
+  hcfree (bfp->st_out);
+  hcfree (bfp->slots);
+  hcfree (bfp->jobs);
+  hcfree (bfp->marks);
+  hcfree (bfp->blocks);
+  hcfree (bfp->path);
+  hcfree (bfp);
+}
+
+size_t blockfile_read (blockfile_t *bfp, void *ptr, const size_t len)
+{
+  if (bfp->streaming == true) return blockfile_stream_read (bfp, (u8 *) ptr, len);
+
+  u8 *out = (u8 *) ptr;
+
+  size_t done = 0;
+
+  while (done < len)
+  {
+    if (bfp->job_cur >= bfp->jobs_cnt) break;
+
+    blockfile_slot_t *slot = &bfp->slots[bfp->job_cur % bfp->slots_cnt];
+
+    if (bfp->job_ready == false)
+    {
+      hc_thread_sem_wait (slot->sem_done);
+
+      slot->pending = false;
+
+      if (slot->rc == -1) return (size_t) -1;
+
+      bfp->job_ready = true;
+    }
+
+    const blockfile_job_t *job = &bfp->jobs[bfp->job_cur];
+
+    const size_t n = (size_t) MIN (job->out_len - bfp->job_pos, (u64) (len - done));
+
+    memcpy (out + done, slot->out_buf + bfp->job_pos, n);
+
+    bfp->job_pos += n;
+    bfp->tell    += n;
+
+    done += n;
+
+    if (bfp->job_pos == job->out_len)
+    {
+      // hand the slot over to the next job in the pipeline
+
+      bfp->job_cur++;
+      bfp->job_pos   = 0;
+      bfp->job_ready = false;
+
+      blockfile_submit (bfp, bfp->job_next);
+
+      bfp->job_next++;
+    }
+  }
+
+  return done;
+}
+
+int blockfile_getc (blockfile_t *bfp)
+{
+  u8 c;
+
+  if (blockfile_read (bfp, &c, 1) != 1) return EOF;
+
+  return (int) c;
+}
+
+bool blockfile_eof (const blockfile_t *bfp)
+{
+  if (bfp->streaming == true) return (bfp->st_eof == true && bfp->st_out_pos == bfp->st_out_len);
+
+  return (bfp->tell >= bfp->size);
+}
+
+int blockfile_seek (blockfile_t *bfp, const u64 offset)
+{
+  if (bfp->streaming == true)
+  {
+    // no block layout, decode and discard
+
+    if (offset < bfp->tell)
+    {
+      if (blockfile_stream_reset (bfp) == false) return -1;
+    }
+
+    while (bfp->tell < offset)
+    {
+      const size_t n = blockfile_stream_read (bfp, NULL, (size_t) MIN (offset - bfp->tell, (u64) BLOCKFILE_STREAM_SIZE));
+
+      if (n == 0 || n == (size_t) -1) return -1;
+    }
+
+    return 0;
+  }
+
+  blockfile_drain (bfp);
+
+  if (offset >= bfp->size)
+  {
+    bfp->job_cur  = bfp->jobs_cnt;
+    bfp->job_pos  = 0;
+    bfp->job_next = bfp->jobs_cnt;
+    bfp->tell     = bfp->size;
+
+    return (offset == bfp->size) ? 0 : -1;
+  }
+
+  u64 lo = 0;
+  u64 hi = bfp->jobs_cnt;
+
+  while ((hi - lo) > 1)
+  {
+    const u64 mid = lo + ((hi - lo) / 2);
+
+    if (bfp->jobs[mid].out_off <= offset) lo = mid; else hi = mid;
+  }
+
+  blockfile_start (bfp, lo);
+
+  bfp->job_pos = offset - bfp->jobs[lo].out_off;
+  bfp->tell    = offset;
+
+  return 0;
+}
+
+void blockfile_rewind (blockfile_t *bfp)
+{
+  blockfile_seek (bfp, 0);
+}
+
+u64 blockfile_tell (const blockfile_t *bfp)
+{
+  return bfp->tell;
+}
+
+u64 blockfile_size (const blockfile_t *bfp)
+{
+  // unknown for the zstd stream fallback
+
+  if (bfp->streaming == true) return 0;
+
+  return bfp->size;
+}
+
+void blockfile_mark (blockfile_t *bfp, const u64 sig, const u64 words, const u64 offset)
+{
+  if (bfp->marks_sig != sig)
+  {
+    bfp->marks_cnt = 0;
+    bfp->marks_sig = sig;
+  }
+
+  if (bfp->marks_cnt > 0)
+  {
+    const blockfile_word_mark_t *last = &bfp->marks[bfp->marks_cnt - 1];
+
+    if (words <= last->words) return;
+
+    if (offset < (last->offset + BLOCKFILE_MARK_DISTANCE)) return;
+  }
+  else
+  {
+    if (offset < BLOCKFILE_MARK_DISTANCE) return;
+  }
+
+  if (bfp->marks_cnt == bfp->marks_avail)
+  {
+    bfp->marks = (blockfile_word_mark_t *) hcrealloc (bfp->marks, bfp->marks_avail * sizeof (blockfile_word_mark_t), BLOCKFILE_INDEX_INCR * sizeof (blockfile_word_mark_t));
+
+    bfp->marks_avail += BLOCKFILE_INDEX_INCR;
+  }
+
+  bfp->marks[bfp->marks_cnt].words  = words;
+  bfp->marks[bfp->marks_cnt].offset = offset;
+
+  bfp->marks_cnt++;
+
+  bfp->index_dirty = true;
+}
+
+bool blockfile_find_mark (const blockfile_t *bfp, const u64 sig, const u64 words, u64 *mark_words, u64 *mark_offset)
+{
+  if (bfp->marks_sig != sig) return false;
+
+  if (bfp->marks_cnt == 0) return false;
+
+  if (bfp->marks[0].words > words) return false;
+
+  u64 lo = 0;
+  u64 hi = bfp->marks_cnt;
+
+  while ((hi - lo) > 1)
+  {
+    const u64 mid = lo + ((hi - lo) / 2);
+
+    if (bfp->marks[mid].words <= words) lo = mid; else hi = mid;
+  }
+
+  *mark_words  = bfp->marks[lo].words;
+  *mark_offset = bfp->marks[lo].offset;
+
+  return true;
+}
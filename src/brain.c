@@ -605,6 +605,10 @@ u32 brain_compute_attack (hashcat_ctx_t *hashcat_ctx)
       XXH64_update (state, &wordlist_hash, sizeof (wordlist_hash));
     }
 
+    const u32 association_width = user_options->association_width;
+
+    XXH64_update (state, &association_width, sizeof (association_width));
+
     const int hex_wordlist = user_options->hex_wordlist;
 
     XXH64_update (state, &hex_wordlist, sizeof (hex_wordlist));
@@ -1122,6 +1126,8 @@ bool brain_client_connect (hc_device_param_t *device_param, const status_ctx_t *
     return false;
   }
 
+  device_param->brain_link_version = brain_link_version_ok;
+
   u32 challenge = 0;
 
   if (brain_recv (brain_link_client_fd, &challenge, sizeof (challenge), 0, NULL, NULL) == false)
@@ -1211,6 +1217,7 @@ void brain_client_disconnect (hc_device_param_t *device_param)
   }
 
   device_param->brain_link_client_fd = -1;
+  device_param->brain_link_version   = 0;
 }
 
 bool brain_client_reserve (hc_device_param_t *device_param, const status_ctx_t *status_ctx, u64 words_off, u64 work, u64 *overlap)
@@ -1230,6 +1237,40 @@ bool brain_client_reserve (hc_device_param_t *device_param, const status_ctx_t *
   return true;
 }
 
+bool brain_client_claim (hc_device_param_t *device_param, const status_ctx_t *status_ctx, u64 words_base, u64 work, u64 *claim_off, u64 *claim_len)
+{
+  const int brain_link_client_fd = device_param->brain_link_client_fd;
+
+  if (brain_link_client_fd == -1) return false;
+
+  // the server uses the reported speed to size the chunks near the end of the keyspace
+
+  u64    speed_cnt  = 0;
+  double speed_msec = 0;
+
+  const u32 speed_pos = MAX (device_param->speed_pos, 1);
+
+  for (u32 i = 0; i < speed_pos; i++)
+  {
+    speed_cnt  += device_param->speed_cnt[i];
+    speed_msec += device_param->speed_msec[i];
+  }
+
+  u64 speed = (speed_msec > 0) ? (u64) (((double) speed_cnt * 1000) / speed_msec) : 0;
+
+  u8 operation = BRAIN_OPERATION_ATTACK_CLAIM;
+
+  if (brain_send (brain_link_client_fd, &operation,   sizeof (operation), SEND_FLAGS, device_param, status_ctx) == false) return false;
+  if (brain_send (brain_link_client_fd, &speed,           sizeof (speed),          0, device_param, status_ctx) == false) return false;
+  if (brain_send (brain_link_client_fd, &words_base, sizeof (words_base),          0, device_param, status_ctx) == false) return false;
+  if (brain_send (brain_link_client_fd, &work,             sizeof (work),          0, device_param, status_ctx) == false) return false;
+
+  if (brain_recv (brain_link_client_fd, claim_off,          sizeof (u64),          0, device_param, status_ctx) == false) return false;
+  if (brain_recv (brain_link_client_fd, claim_len,          sizeof (u64),          0, device_param, status_ctx) == false) return false;
+
+  return true;
+}
+
 bool brain_client_commit (hc_device_param_t *device_param, const status_ctx_t *status_ctx)
 {
   if (device_param->pws_cnt == 0) return true;
@@ -1515,6 +1556,121 @@ u64 brain_server_find_attack_short (const brain_server_attack_short_t *buf, cons
   return overlap;
 }
 
+u64 brain_server_find_attack_gap (const brain_server_db_attack_t *buf, const u64 limit, u64 *gap_len)
+{
+  const brain_server_attack_long_t  *long_buf  = buf->long_buf;
+  const brain_server_attack_short_t *short_buf = buf->short_buf;
+
+  const i64 long_cnt  = buf->long_cnt;
+  const i64 short_cnt = buf->short_cnt;
+
+  i64 long_idx  = 0;
+  i64 short_idx = 0;
+
+  u64 gap_off = 0;
+
+  // both lists are sorted, so walking them in merged order finds the lowest position which is neither committed nor reserved
+
+  while (gap_off < limit)
+  {
+    while ((long_idx  < long_cnt)  && (long_buf[long_idx].length   == 0)) long_idx++;
+    while ((short_idx < short_cnt) && (short_buf[short_idx].length == 0)) short_idx++;
+
+    const bool has_long  = (long_idx  < long_cnt);
+    const bool has_short = (short_idx < short_cnt);
+
+    if ((has_long == false) && (has_short == false)) break;
+
+    u64 element_start  = 0;
+    u64 element_length = 0;
+
+    if ((has_short == false) || ((has_long == true) && (long_buf[long_idx].offset <= short_buf[short_idx].offset)))
+    {
+      element_start  = long_buf[long_idx].offset;
+      element_length = long_buf[long_idx].length;
+
+      long_idx++;
+    }
+    else
+    {
+      element_start  = short_buf[short_idx].offset;
+      element_length = short_buf[short_idx].length;
+
+      short_idx++;
+    }
+
+    if (element_start > gap_off)
+    {
+      *gap_len = MIN (element_start, limit) - gap_off;
+
+      return gap_off;
+    }
+
+    gap_off = MAX (gap_off, element_start + element_length);
+  }
+
+  if (gap_off >= limit)
+  {
+    *gap_len = 0;
+
+    return limit;
+  }
+
+  *gap_len = limit - gap_off;
+
+  return gap_off;
+}
+
+u64 brain_server_find_attack_pending (const brain_server_db_attack_t *buf, const int client_idx, const u64 limit)
+{
+  // lowest position below limit which another client has reserved but not yet committed
+
+  u64 pending = limit;
+
+  for (i64 idx = 0; idx < buf->short_cnt; idx++)
+  {
+    const brain_server_attack_short_t *element = &buf->short_buf[idx];
+
+    if (element->length == 0) continue;
+
+    if (element->client_idx == client_idx) continue;
+
+    pending = MIN (pending, element->offset);
+  }
+
+  return pending;
+}
+
+i64 brain_server_reclaim_attack (brain_server_db_attack_t *buf, const brain_server_client_state_t *client_state, const int client_idx, const u32 lease_timeout)
+{
+  if (lease_timeout == 0) return 0;
+
+  const time_t now = time (NULL);
+
+  i64 reclaimed = 0;
+
+  for (i64 idx = 0; idx < buf->short_cnt; idx++)
+  {
+    brain_server_attack_short_t *element = &buf->short_buf[idx];
+
+    if (element->length == 0) continue;
+
+    if (element->client_idx == client_idx) continue;
+
+    // a client which did not talk to us for longer than the lease is considered dead, even if its socket is still open
+
+    if ((now - client_state[element->client_idx].seen) < (time_t) lease_timeout) continue;
+
+    element->offset     = 0;
+    element->length     = 0;
+    element->client_idx = 0;
+
+    reclaimed++;
+  }
+
+  return reclaimed;
+}
+
 int brain_server_sort_db_hash (const void *v1, const void *v2)
 {
   const brain_server_db_hash_t *d1 = (const brain_server_db_hash_t *) v1;
@@ -2104,6 +2260,7 @@ HC_API_CALL void *brain_server_handle_client (void *p)
   const char *auth_password         = brain_server_client_options->auth_password;
   const u32  *session_whitelist_buf = brain_server_client_options->session_whitelist_buf;
   const int   session_whitelist_cnt = brain_server_client_options->session_whitelist_cnt;
+  const u32   lease_timeout         = brain_server_client_options->lease_timeout;
 
   brain_server_dbs_t *brain_server_dbs = brain_server_client_options->brain_server_dbs;
 
@@ -2139,7 +2296,9 @@ HC_API_CALL void *brain_server_handle_client (void *p)
     return NULL;
   }
 
-  u32 brain_link_version_ok = (brain_link_version >= (u32) BRAIN_LINK_VERSION_MIN) ? 1 : 0;
+  // answer with our own version instead of 1, clients only check for 0 and newer ones use it to find out which operations we know
+
+  u32 brain_link_version_ok = (brain_link_version >= (u32) BRAIN_LINK_VERSION_MIN) ? (u32) BRAIN_LINK_VERSION_CUR : 0;
 
   if (brain_send (client_fd, &brain_link_version_ok, sizeof (brain_link_version_ok), 0, NULL, NULL) == false)
   {
@@ -2369,6 +2528,16 @@ HC_API_CALL void *brain_server_handle_client (void *p)
     brain_server_dbs->attack_cnt++;
   }
 
+  // the other clients of the attack read the state of this one under mux_ag, see brain_server_reclaim_attack ()
+
+  hc_thread_mutex_lock (brain_server_db_attack->mux_ag);
+
+  brain_server_dbs->client_state[client_idx].brain_attack = brain_attack;
+  brain_server_dbs->client_state[client_idx].speed        = 0;
+  brain_server_dbs->client_state[client_idx].seen         = time (NULL);
+
+  hc_thread_mutex_unlock (brain_server_db_attack->mux_ag);
+
   hc_thread_mutex_unlock (brain_server_dbs->mux_dbs);
 
   // highest position of that attack
@@ -2471,6 +2640,12 @@ HC_API_CALL void *brain_server_handle_client (void *p)
 
     if (brain_recv (client_fd, &operation, sizeof (operation), 0, NULL, NULL) == false) break;
 
+    hc_thread_mutex_lock (brain_server_db_attack->mux_ag);
+
+    brain_server_dbs->client_state[client_idx].seen = time (NULL);
+
+    hc_thread_mutex_unlock (brain_server_db_attack->mux_ag);
+
     // U = update
     // R = request
     // C = commit
@@ -2576,6 +2751,95 @@ HC_API_CALL void *brain_server_handle_client (void *p)
 
       brain_logging (stdout, client_idx, "R | %8.2f ms | Offset: %" PRIu64 ", Length: %" PRIu64 ", Overlap: %" PRIu64 "\n", ms, offset, length, overlap);
     }
+    else if (operation == BRAIN_OPERATION_ATTACK_CLAIM)
+    {
+      u64 speed  = 0;
+      u64 limit  = 0;
+      u64 length = 0;
+
+      if (brain_recv (client_fd, &speed,  sizeof (speed),  0, NULL, NULL) == false) break;
+      if (brain_recv (client_fd, &limit,  sizeof (limit),  0, NULL, NULL) == false) break;
+      if (brain_recv (client_fd, &length, sizeof (length), 0, NULL, NULL) == false) break;
+
+      // time the lookups for debugging
+
+      hc_timer_t timer_claimed;
+
+      hc_timer_set (&timer_claimed);
+
+      hc_thread_mutex_lock (brain_server_db_attack->mux_ag);
+
+      brain_server_dbs->client_state[client_idx].speed = speed;
+
+      const i64 reclaimed = brain_server_reclaim_attack (brain_server_db_attack, brain_server_dbs->client_state, client_idx, lease_timeout);
+
+      u64 gap_len = 0;
+
+      u64 offset = brain_server_find_attack_gap (brain_server_db_attack, limit, &gap_len);
+
+      length = MIN (length, gap_len);
+
+      // nothing is free, but if other clients still hold uncommitted reservations, point at the lowest one
+      // the client then knows it has to ask again later instead of finishing, an offset of limit means everything is committed
+
+      if (gap_len == 0) offset = brain_server_find_attack_pending (brain_server_db_attack, client_idx, limit);
+
+      // toward the end of the keyspace, hand out no more than the client's share by speed, so slow clients do not delay the finish
+
+      if ((length > 0) && (speed > 0))
+      {
+        u64 speed_all = 0;
+
+        for (int idx = 0; idx < BRAIN_SERVER_CLIENTS_MAX; idx++)
+        {
+          if (brain_server_dbs->client_slots[idx] == 0) continue;
+
+          if (brain_server_dbs->client_state[idx].brain_attack != brain_attack) continue;
+
+          if ((lease_timeout > 0) && ((time (NULL) - brain_server_dbs->client_state[idx].seen) >= (time_t) lease_timeout)) continue;
+
+          speed_all += brain_server_dbs->client_state[idx].speed;
+        }
+
+        const u64 share = (u64) ((double) (limit - offset) * ((double) speed / (double) speed_all));
+
+        length = MIN (length, MAX (share, 1));
+      }
+
+      if (length > 0)
+      {
+        if (brain_server_db_attack_realloc (brain_server_db_attack, 0, 1) == true)
+        {
+          brain_server_db_attack->short_buf[brain_server_db_attack->short_cnt].offset     = offset;
+          brain_server_db_attack->short_buf[brain_server_db_attack->short_cnt].length     = length;
+          brain_server_db_attack->short_buf[brain_server_db_attack->short_cnt].client_idx = client_idx;
+
+          brain_server_db_attack->short_cnt++;
+
+          qsort (brain_server_db_attack->short_buf, brain_server_db_attack->short_cnt, sizeof (brain_server_attack_short_t), brain_server_sort_attack_short);
+        }
+        else
+        {
+          brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
+
+          length = 0;
+        }
+      }
+
+      hc_thread_mutex_unlock (brain_server_db_attack->mux_ag);
+
+      if (brain_send (client_fd, &offset, sizeof (offset), SEND_FLAGS, NULL, NULL) == false) break;
+      if (brain_send (client_fd, &length, sizeof (length), SEND_FLAGS, NULL, NULL) == false) break;
+
+      const double ms = hc_timer_get (timer_claimed);
+
+      if (reclaimed)
+      {
+        brain_logging (stdout, client_idx, "X | Reclaimed: %" PRIi64 " expired reservations\n", reclaimed);
+      }
+
+      brain_logging (stdout, client_idx, "W | %8.2f ms | Offset: %" PRIu64 ", Length: %" PRIu64 ", Speed: %" PRIu64 "\n", ms, offset, length, speed);
+    }
     else if (operation == BRAIN_OPERATION_COMMIT)
     {
       // time the lookups for debugging
@@ -3032,6 +3296,8 @@ HC_API_CALL void *brain_server_handle_client (void *p)
     }
   }
 
+  memset (&brain_server_dbs->client_state[client_idx], 0, sizeof (brain_server_client_state_t));
+
   hc_thread_mutex_unlock (brain_server_db_attack->mux_ag);
 
   // short free
@@ -3054,7 +3320,7 @@ HC_API_CALL void *brain_server_handle_client (void *p)
   return NULL;
 }
 
-int brain_server (const char *listen_host, const int listen_port, const char *brain_password, const char *brain_session_whitelist, const u32 brain_server_timer)
+int brain_server (const char *listen_host, const int listen_port, const char *brain_password, const char *brain_session_whitelist, const u32 brain_server_timer, const u32 brain_server_lease)
 {
   #if defined (_WIN)
   WSADATA wsaData;
@@ -3260,6 +3526,17 @@ int brain_server (const char *listen_host, const int listen_port, const char *br
     return -1;
   }
 
+  brain_server_dbs->client_state = (brain_server_client_state_t *) hccalloc (BRAIN_SERVER_CLIENTS_MAX, sizeof (brain_server_client_state_t));
+
+  if (brain_server_dbs->client_state == NULL)
+  {
+    brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
+
+    if (brain_password == NULL) hcfree (auth_password);
+
+    return -1;
+  }
+
   // session whitelists
 
   u32 *session_whitelist_buf = (u32 *) hccalloc (BRAIN_SERVER_SESSIONS_MAX, sizeof (u32));
@@ -3317,6 +3594,7 @@ int brain_server (const char *listen_host, const int listen_port, const char *br
     brain_server_client_options[client_idx].brain_server_dbs      = brain_server_dbs;
     brain_server_client_options[client_idx].session_whitelist_buf = session_whitelist_buf;
     brain_server_client_options[client_idx].session_whitelist_cnt = session_whitelist_cnt;
+    brain_server_client_options[client_idx].lease_timeout         = brain_server_lease;
   }
 
   // ready to serve
@@ -3431,6 +3709,7 @@ int brain_server (const char *listen_host, const int listen_port, const char *br
 
   hcfree (brain_server_dbs->hash_buf);
   hcfree (brain_server_dbs->attack_buf);
+  hcfree (brain_server_dbs->client_state);
   hcfree (brain_server_dbs);
   hcfree (brain_server_client_options);
 
@@ -9,6 +9,7 @@
 #include "memory.h"
 #include "shared.h"
 #include "cpu_features.h"
+#include "affinity.h"
 
 // argon2 reference
 
@@ -69,6 +70,8 @@ typedef struct
   u64     workitem_count;
   size_t  workitem_size;
 
+  int     numa_node;  // -1 if not placed
+
   // implementation specific
 
   void   *memory;
@@ -80,6 +83,9 @@ typedef struct
   unit_t *units_buf;
   int     units_cnt;
 
+  numa_topology_t numa_topology;
+  bool            numa_hugepages;
+
 } bridge_argon2id_t;
 
 static bool units_init (bridge_argon2id_t *bridge_argon2id)
@@ -138,7 +144,7 @@ static void units_term (bridge_argon2id_t *bridge_argon2id)
   }
 }
 
-void *platform_init ()
+void *platform_init (user_options_t *user_options)
 {
   // Verify CPU features
 
@@ -155,6 +161,19 @@ void *platform_init ()
     return NULL;
   }
 
+  // spread the units over the NUMA nodes, the backend maps their host threads the same way
+
+  numa_topology_init (&bridge_argon2id->numa_topology);
+
+  const bool numa_enabled = (user_options->numa == true) && (user_options->cpu_affinity == NULL) && (bridge_argon2id->numa_topology.nodes_cnt > 1);
+
+  for (int unit_idx = 0; unit_idx < bridge_argon2id->units_cnt; unit_idx++)
+  {
+    bridge_argon2id->units_buf[unit_idx].numa_node = (numa_enabled == true) ? numa_node_for_unit (&bridge_argon2id->numa_topology, unit_idx, bridge_argon2id->units_cnt) : -1;
+  }
+
+  bridge_argon2id->numa_hugepages = user_options->numa_hugepages;
+
   return bridge_argon2id;
 }
 
@@ -166,6 +185,8 @@ void platform_term (void *platform_context)
   {
     units_term (bridge_argon2id);
 
+    numa_topology_destroy (&bridge_argon2id->numa_topology);
+
     hcfree (bridge_argon2id);
   }
 }
@@ -220,7 +241,7 @@ bool salt_prepare (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig
   {
     unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
 
-    unit_buf->memory = hcmalloc_bridge_aligned ((largest_m * 1024), 32); // because AVX2
+    unit_buf->memory = hcmalloc_numa (&bridge_argon2id->numa_topology, (largest_m * 1024), unit_buf->numa_node, bridge_argon2id->numa_hugepages); // 64 byte aligned, AVX2 needs 32
   }
 
   return true;
@@ -234,7 +255,7 @@ void salt_destroy (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig
   {
     unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
 
-    hcfree_bridge_aligned (unit_buf->memory);
+    hcfree_numa (unit_buf->memory);
   }
 }
 
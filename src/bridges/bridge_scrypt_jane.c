@@ -9,6 +9,7 @@
 #include "memory.h"
 #include "shared.h"
 #include "cpu_features.h"
+#include "affinity.h"
 
 #include "code/scrypt-jane-portable.h"
 #include "code/scrypt-jane-hash.h"
@@ -48,6 +49,8 @@ typedef struct
   u64     workitem_count;
   size_t  workitem_size;
 
+  int     numa_node;  // -1 if not placed
+
 } unit_t;
 
 typedef struct
@@ -55,6 +58,9 @@ typedef struct
   unit_t *units_buf;
   int     units_cnt;
 
+  numa_topology_t numa_topology;
+  bool            numa_hugepages;
+
 } bridge_scrypt_jane_t;
 
 static bool units_init (bridge_scrypt_jane_t *bridge_scrypt_jane)
@@ -106,7 +112,7 @@ static void units_term (bridge_scrypt_jane_t *bridge_scrypt_jane)
   }
 }
 
-void *platform_init ()
+void *platform_init (user_options_t *user_options)
 {
   // Verify CPU features
 
@@ -123,6 +129,19 @@ void *platform_init ()
     return NULL;
   }
 
+  // spread the units over the NUMA nodes, the backend maps their host threads the same way
+
+  numa_topology_init (&bridge_scrypt_jane->numa_topology);
+
+  const bool numa_enabled = (user_options->numa == true) && (user_options->cpu_affinity == NULL) && (bridge_scrypt_jane->numa_topology.nodes_cnt > 1);
+
+  for (int unit_idx = 0; unit_idx < bridge_scrypt_jane->units_cnt; unit_idx++)
+  {
+    bridge_scrypt_jane->units_buf[unit_idx].numa_node = (numa_enabled == true) ? numa_node_for_unit (&bridge_scrypt_jane->numa_topology, unit_idx, bridge_scrypt_jane->units_cnt) : -1;
+  }
+
+  bridge_scrypt_jane->numa_hugepages = user_options->numa_hugepages;
+
   return bridge_scrypt_jane;
 }
 
@@ -134,6 +153,8 @@ void platform_term (void *platform_context)
   {
     units_term (bridge_scrypt_jane);
 
+    numa_topology_destroy (&bridge_scrypt_jane->numa_topology);
+
     hcfree (bridge_scrypt_jane);
   }
 }
@@ -200,9 +221,9 @@ bool salt_prepare (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig
   {
     unit_t *unit_buf = &bridge_scrypt_jane->units_buf[unit_idx];
 
-    unit_buf->V = hcmalloc_bridge_aligned (largest_V, 64);
-    //unit_buf->X = hcmalloc_bridge_aligned (largest_X, 64);
-    unit_buf->Y = hcmalloc_bridge_aligned (largest_Y, 64);
+    unit_buf->V = hcmalloc_numa (&bridge_scrypt_jane->numa_topology, largest_V, unit_buf->numa_node, bridge_scrypt_jane->numa_hugepages);
+    //unit_buf->X = hcmalloc_numa (&bridge_scrypt_jane->numa_topology, largest_X, unit_buf->numa_node, bridge_scrypt_jane->numa_hugepages);
+    unit_buf->Y = hcmalloc_numa (&bridge_scrypt_jane->numa_topology, largest_Y, unit_buf->numa_node, bridge_scrypt_jane->numa_hugepages);
   }
 
   return true;
@@ -216,9 +237,9 @@ void salt_destroy (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig
   {
     unit_t *unit_buf = &bridge_scrypt_jane->units_buf[unit_idx];
 
-    hcfree_bridge_aligned (unit_buf->V);
-    //hcfree_bridge_aligned (unit_buf->X);
-    hcfree_bridge_aligned (unit_buf->Y);
+    hcfree_numa (unit_buf->V);
+    //hcfree_numa (unit_buf->X);
+    hcfree_numa (unit_buf->Y);
   }
 }
 
@@ -9,6 +9,7 @@
 #include "memory.h"
 #include "shared.h"
 #include "cpu_features.h"
+#include "affinity.h"
 
 #include "yescrypt.h"
 
@@ -50,6 +51,8 @@ typedef struct
   u64     workitem_count;
   size_t  workitem_size;
 
+  int     numa_node;  // -1 if not placed
+
 } unit_t;
 
 typedef struct
@@ -57,6 +60,9 @@ typedef struct
   unit_t *units_buf;
   int     units_cnt;
 
+  numa_topology_t numa_topology;
+  bool            numa_hugepages;
+
 } bridge_scrypt_yescrypt_t;
 
 static bool units_init (bridge_scrypt_yescrypt_t *bridge_scrypt_yescrypt)
@@ -108,7 +114,7 @@ static void units_term (bridge_scrypt_yescrypt_t *bridge_scrypt_yescrypt)
   }
 }
 
-void *platform_init ()
+void *platform_init (user_options_t *user_options)
 {
   // Verify CPU features
 
@@ -125,6 +131,19 @@ void *platform_init ()
     return NULL;
   }
 
+  // spread the units over the NUMA nodes, the backend maps their host threads the same way
+
+  numa_topology_init (&bridge_scrypt_yescrypt->numa_topology);
+
+  const bool numa_enabled = (user_options->numa == true) && (user_options->cpu_affinity == NULL) && (bridge_scrypt_yescrypt->numa_topology.nodes_cnt > 1);
+
+  for (int unit_idx = 0; unit_idx < bridge_scrypt_yescrypt->units_cnt; unit_idx++)
+  {
+    bridge_scrypt_yescrypt->units_buf[unit_idx].numa_node = (numa_enabled == true) ? numa_node_for_unit (&bridge_scrypt_yescrypt->numa_topology, unit_idx, bridge_scrypt_yescrypt->units_cnt) : -1;
+  }
+
+  bridge_scrypt_yescrypt->numa_hugepages = user_options->numa_hugepages;
+
   return bridge_scrypt_yescrypt;
 }
 
@@ -136,6 +155,8 @@ void platform_term (void *platform_context)
   {
     units_term (bridge_scrypt_yescrypt);
 
+    numa_topology_destroy (&bridge_scrypt_yescrypt->numa_topology);
+
     hcfree (bridge_scrypt_yescrypt);
   }
 }
@@ -195,8 +216,8 @@ bool salt_prepare (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig
   {
     unit_t *unit_buf = &bridge_scrypt_yescrypt->units_buf[unit_idx];
 
-    unit_buf->V  = hcmalloc_bridge_aligned (largest_V,  64);
-    unit_buf->XY = hcmalloc_bridge_aligned (largest_XY, 64);
+    unit_buf->V  = hcmalloc_numa (&bridge_scrypt_yescrypt->numa_topology, largest_V,  unit_buf->numa_node, bridge_scrypt_yescrypt->numa_hugepages);
+    unit_buf->XY = hcmalloc_numa (&bridge_scrypt_yescrypt->numa_topology, largest_XY, unit_buf->numa_node, bridge_scrypt_yescrypt->numa_hugepages);
   }
 
   return true;
@@ -210,8 +231,8 @@ void salt_destroy (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig
   {
     unit_t *unit_buf = &bridge_scrypt_yescrypt->units_buf[unit_idx];
 
-    hcfree_bridge_aligned (unit_buf->V);
-    hcfree_bridge_aligned (unit_buf->XY);
+    hcfree_numa (unit_buf->V);
+    hcfree_numa (unit_buf->XY);
   }
 }
 
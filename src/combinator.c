@@ -5,9 +5,13 @@
 
 #include "common.h"
 #include "types.h"
+#include "memory.h"
 #include "event.h"
 #include "shared.h"
 #include "wordlist.h"
+#include "convert.h"
+#include "rp.h"
+#include "rp_cpu.h"
 #include "combinator.h"
 
 int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
@@ -479,11 +483,262 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
+static void combinator_cache_free (combinator_ctx_t *combinator_ctx)
+{
+  hcfree (combinator_ctx->cache_file);
+  hcfree (combinator_ctx->cache_buf);
+  hcfree (combinator_ctx->cache_off);
+  hcfree (combinator_ctx->cache_rej);
+
+  combinator_ctx->cache_enabled = false;
+  combinator_ctx->cache_file    = NULL;
+  combinator_ctx->cache_buf     = NULL;
+  combinator_ctx->cache_off     = NULL;
+  combinator_ctx->cache_rej     = NULL;
+  combinator_ctx->cache_cnt     = 0;
+}
+
+int combinator_ctx_update_loop (hashcat_ctx_t *hashcat_ctx)
+{
+  combinator_ctx_t     *combinator_ctx      = hashcat_ctx->combinator_ctx;
+  hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
+  user_options_t       *user_options        = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
+
+  if (combinator_ctx->enabled == false) return 0;
+
+  if (user_options->slow_candidates == true) return 0;
+  if (user_options->stdout_flag     == true) return 0;
+
+  // the file which run_cracker() would otherwise re-read for each batch and each salt
+
+  const char *combs_file = NULL;
+
+  if (user_options->attack_mode == ATTACK_MODE_COMBI)
+  {
+    combs_file = (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT) ? combinator_ctx->dict2 : combinator_ctx->dict1;
+  }
+  else if (((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0) && (user_options->attack_mode == ATTACK_MODE_HYBRID2))
+  {
+    combs_file = straight_ctx->dict;
+  }
+
+  if (combs_file == NULL) return 0;
+
+  if ((combinator_ctx->cache_file != NULL) && (strcmp (combinator_ctx->cache_file, combs_file) == 0)) return 0;
+
+  combinator_cache_free (combinator_ctx);
+
+  combinator_ctx->cache_gen++;
+
+  combinator_ctx->cache_file = hcstrdup (combs_file);
+
+  bool iconv_enabled = false;
+
+  iconv_t iconv_ctx = NULL;
+
+  char *iconv_tmp = NULL;
+
+  if (strcmp (user_options->encoding_from, user_options->encoding_to) != 0)
+  {
+    iconv_enabled = true;
+
+    iconv_ctx = iconv_open (user_options->encoding_to, user_options->encoding_from);
+
+    if (iconv_ctx == (iconv_t) -1) return -1;
+
+    iconv_tmp = (char *) hcmalloc (HCBUFSIZ_TINY);
+  }
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, combs_file, "rb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", combs_file, strerror (errno));
+
+    if (iconv_enabled == true)
+    {
+      iconv_close (iconv_ctx);
+
+      hcfree (iconv_tmp);
+    }
+
+    return -1;
+  }
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  u64 buf_len = 0;
+  u64 buf_max = 0;
+  u64 cnt     = 0;
+  u64 cnt_max = 0;
+  u64 rej     = 0;
+
+  u8  *buf     = NULL;
+  u64 *off_buf = NULL;
+  u64 *rej_buf = NULL;
+
+  bool fits = true;
+
+  while (!hc_feof (&fp))
+  {
+    size_t line_len = fgetl (&fp, line_buf, HCBUFSIZ_LARGE);
+
+    line_len = convert_from_hex (hashcat_ctx, line_buf, line_len);
+
+    if (line_len > PW_MAX) continue;
+
+    char *line_buf_new = line_buf;
+
+    char rule_buf_out[RP_PASSWORD_SIZE];
+
+    if (run_rule_engine (user_options_extra->rule_len_r, user_options->rule_buf_r))
+    {
+      if (line_len >= RP_PASSWORD_SIZE) continue;
+
+      memset (rule_buf_out, 0, sizeof (rule_buf_out));
+
+      const int rule_len_out = _old_apply_rule (user_options->rule_buf_r, user_options_extra->rule_len_r, line_buf, (u32) line_len, rule_buf_out);
+
+      if (rule_len_out < 0)
+      {
+        rej++;
+
+        continue;
+      }
+
+      line_len = rule_len_out;
+
+      line_buf_new = rule_buf_out;
+    }
+
+    if (iconv_enabled == true)
+    {
+      char  *iconv_ptr = iconv_tmp;
+      size_t iconv_sz  = HCBUFSIZ_TINY;
+
+      if (iconv (iconv_ctx, &line_buf_new, &line_len, &iconv_ptr, &iconv_sz) == (size_t) -1) continue;
+
+      line_buf_new = iconv_tmp;
+      line_len     = HCBUFSIZ_TINY - iconv_sz;
+    }
+
+    line_len = MIN (line_len, PW_MAX);
+
+    if ((buf_len + line_len + ((cnt + 2) * 2 * sizeof (u64))) > COMBS_CACHE_SIZE_MAX)
+    {
+      fits = false;
+
+      break;
+    }
+
+    if ((buf_len + line_len) > buf_max)
+    {
+      buf = (u8 *) hcrealloc (buf, buf_max, COMBS_CACHE_BUF_INC);
+
+      buf_max += COMBS_CACHE_BUF_INC;
+    }
+
+    if ((cnt + 1) >= cnt_max)
+    {
+      off_buf = (u64 *) hcrealloc (off_buf, cnt_max * sizeof (u64), COMBS_CACHE_CNT_INC * sizeof (u64));
+      rej_buf = (u64 *) hcrealloc (rej_buf, cnt_max * sizeof (u64), COMBS_CACHE_CNT_INC * sizeof (u64));
+
+      cnt_max += COMBS_CACHE_CNT_INC;
+    }
+
+    memcpy (buf + buf_len, line_buf_new, line_len);
+
+    if (hashconfig->opts_type & OPTS_TYPE_PT_UPPER)
+    {
+      uppercase (buf + buf_len, line_len);
+    }
+
+    off_buf[cnt] = buf_len;
+    rej_buf[cnt] = rej;
+
+    buf_len += line_len;
+
+    cnt++;
+  }
+
+  hc_fclose (&fp);
+
+  hcfree (line_buf);
+
+  if (iconv_enabled == true)
+  {
+    iconv_close (iconv_ctx);
+
+    hcfree (iconv_tmp);
+  }
+
+  // too big, run_cracker() falls back to reading the file
+
+  if (fits == false)
+  {
+    hcfree (buf);
+    hcfree (off_buf);
+    hcfree (rej_buf);
+
+    return 0;
+  }
+
+  if (cnt == 0)
+  {
+    off_buf = (u64 *) hccalloc (1, sizeof (u64));
+    rej_buf = (u64 *) hccalloc (1, sizeof (u64));
+  }
+
+  off_buf[cnt] = buf_len;
+  rej_buf[cnt] = rej;
+
+  u8 cache_pad = 0;
+
+  if ((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) && (user_options->attack_mode == ATTACK_MODE_COMBI) && (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT))
+  {
+    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80) cache_pad = 0x80;
+    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06) cache_pad = 0x06;
+    if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01) cache_pad = 0x01;
+  }
+
+  combinator_ctx->cache_enabled = true;
+  combinator_ctx->cache_pad     = cache_pad;
+  combinator_ctx->cache_buf     = buf;
+  combinator_ctx->cache_off     = off_buf;
+  combinator_ctx->cache_rej     = rej_buf;
+  combinator_ctx->cache_cnt     = cnt;
+
+  return 0;
+}
+
+void combinator_cache_to_pw (const combinator_ctx_t *combinator_ctx, const u64 idx, pw_t *pw)
+{
+  const u64 off = combinator_ctx->cache_off[idx];
+  const u32 len = (u32) (combinator_ctx->cache_off[idx + 1] - off);
+
+  u8 *ptr = (u8 *) pw->i;
+
+  memcpy (ptr, combinator_ctx->cache_buf + off, len);
+
+  memset (ptr + len, 0, PW_MAX - len);
+
+  if (combinator_ctx->cache_pad)
+  {
+    ptr[len] = combinator_ctx->cache_pad;
+  }
+
+  pw->pw_len = len;
+}
+
 void combinator_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
 {
   combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
 
   if (combinator_ctx->enabled == false) return;
 
+  combinator_cache_free (combinator_ctx);
+
   memset (combinator_ctx, 0, sizeof (combinator_ctx_t));
 }
@@ -0,0 +1,920 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "convert.h"
+#include "shared.h"
+#include "thread.h"
+#include "status.h"
+#include "terminal.h"
+#include "interface.h"
+#include "user_options.h"
+#include "hashcat.h"
+#include "resident.h"
+#include "daemon.h"
+
+#if defined (_WIN)
+
+int daemon_run (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED int argc, MAYBE_UNUSED char **argv)
+{
+  event_log_error (hashcat_ctx, "Daemon mode is not supported on Windows.");
+
+  return -1;
+}
+
+#else
+
+static volatile bool daemon_running = true;
+
+static void daemon_handle_signal (int signo)
+{
+  if ((signo == SIGINT) || (signo == SIGTERM))
+  {
+    daemon_running = false;
+  }
+}
+
+/**
+ * protocol: one JSON object per line in both directions
+ *
+ *   {"cmd": "run", "argv": ["-m", "0", "-a", "3", "hash.txt", "?d?d?d?d"]}
+ *   {"cmd": "status"}   while a job is running, otherwise reports the daemon state
+ *   {"cmd": "pause"}, {"cmd": "resume"}, {"cmd": "bypass"}, {"cmd": "checkpoint"}, {"cmd": "finish"}, {"cmd": "quit"}
+ *   {"cmd": "shutdown"}
+ */
+
+static bool daemon_send (const int fd, const char *fmt, ...)
+{
+  char *buf = NULL;
+
+  va_list args;
+
+  va_start (args, fmt);
+
+  const int len = vasprintf (&buf, fmt, args);
+
+  va_end (args);
+
+  if (len == -1) return false;
+
+  int pos = 0;
+
+  while (pos < len)
+  {
+    const ssize_t nsent = send (fd, buf + pos, len - pos, 0);
+
+    if (nsent == -1)
+    {
+      if (errno == EINTR) continue;
+
+      break;
+    }
+
+    pos += (int) nsent;
+  }
+
+  hcfree (buf);
+
+  return (pos == len);
+}
+
+static char *daemon_json_encode (const char *text)
+{
+  if (text == NULL) text = "";
+
+  char *escaped = (char *) hcmalloc ((strlen (text) * 2) + 1);
+
+  json_encode (text, escaped);
+
+  return escaped;
+}
+
+static bool daemon_send_error (const int fd, const char *message)
+{
+  char *message_json = daemon_json_encode (message);
+
+  const bool rc = daemon_send (fd, "{\"event\": \"error\", \"message\": \"%s\"}\n", message_json);
+
+  hcfree (message_json);
+
+  return rc;
+}
+
+static char *daemon_json_skip (char *p)
+{
+  while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+
+  return p;
+}
+
+// decodes the string in place, escape sequences are never shorter than their result
+
+static char *daemon_json_string (char *p, char **out)
+{
+  if (*p != '"') return NULL;
+
+  p++;
+
+  char *w = p;
+
+  *out = p;
+
+  while (*p != '"')
+  {
+    if (*p == 0) return NULL;
+
+    if (*p != '\\')
+    {
+      *w++ = *p++;
+
+      continue;
+    }
+
+    p++;
+
+    switch (*p)
+    {
+      case '"':  *w++ = '"';  break;
+      case '\\': *w++ = '\\'; break;
+      case '/':  *w++ = '/';  break;
+      case 'b':  *w++ = '\b'; break;
+      case 'f':  *w++ = '\f'; break;
+      case 'n':  *w++ = '\n'; break;
+      case 'r':  *w++ = '\r'; break;
+      case 't':  *w++ = '\t'; break;
+      case 'u':
+      {
+        if (is_valid_hex_string ((const u8 *) p + 1, 4) == false) return NULL;
+
+        const u32 c = ((u32) hex_to_u8 ((const u8 *) p + 1) << 8) | hex_to_u8 ((const u8 *) p + 3);
+
+        if (c == 0) return NULL;
+
+        if ((c >= 0xd800) && (c <= 0xdfff)) return NULL;
+
+        if (c < 0x80)
+        {
+          *w++ = (char) c;
+        }
+        else if (c < 0x800)
+        {
+          *w++ = (char) (0xc0 | (c >> 6));
+          *w++ = (char) (0x80 | (c & 0x3f));
+        }
+        else
+        {
+          *w++ = (char) (0xe0 | (c >> 12));
+          *w++ = (char) (0x80 | ((c >> 6) & 0x3f));
+          *w++ = (char) (0x80 | (c & 0x3f));
+        }
+
+        p += 4;
+
+        break;
+      }
+      default:   return NULL;
+    }
+
+    p++;
+  }
+
+  *w = 0;
+
+  return p + 1;
+}
+
+static void daemon_request_destroy (daemon_request_t *request)
+{
+  hcfree (request->argv);
+  hcfree (request->line);
+
+  memset (request, 0, sizeof (daemon_request_t));
+}
+
+static int daemon_request_parse (char *line, daemon_request_t *request)
+{
+  memset (request, 0, sizeof (daemon_request_t));
+
+  request->line = line;
+
+  request->argv = (char **) hccalloc (DAEMON_ARGV_MAX + 1, sizeof (char *));
+
+  request->argv[request->argc++] = (char *) PROGNAME;
+
+  char *p = daemon_json_skip (line);
+
+  if (*p != '{') return -1;
+
+  p = daemon_json_skip (p + 1);
+
+  if (*p == '}') return -1;
+
+  while (true)
+  {
+    char *key = NULL;
+
+    p = daemon_json_string (p, &key);
+
+    if (p == NULL) return -1;
+
+    p = daemon_json_skip (p);
+
+    if (*p != ':') return -1;
+
+    p = daemon_json_skip (p + 1);
+
+    if (strcmp (key, "argv") == 0)
+    {
+      if (*p != '[') return -1;
+
+      p = daemon_json_skip (p + 1);
+
+      if (*p == ']')
+      {
+        p++;
+      }
+      else
+      {
+        while (true)
+        {
+          if (request->argc == DAEMON_ARGV_MAX) return -1;
+
+          p = daemon_json_string (p, &request->argv[request->argc]);
+
+          if (p == NULL) return -1;
+
+          request->argc++;
+
+          p = daemon_json_skip (p);
+
+          if (*p == ']') break;
+
+          if (*p != ',') return -1;
+
+          p = daemon_json_skip (p + 1);
+        }
+
+        p++;
+      }
+    }
+    else
+    {
+      char *value = NULL;
+
+      p = daemon_json_string (p, &value);
+
+      if (p == NULL) return -1;
+
+      if (strcmp (key, "cmd") == 0)
+      {
+        if (strlen (value) >= sizeof (request->cmd)) return -1;
+
+        strncpy (request->cmd, value, sizeof (request->cmd) - 1);
+      }
+    }
+
+    p = daemon_json_skip (p);
+
+    if (*p == '}') break;
+
+    if (*p != ',') return -1;
+
+    p = daemon_json_skip (p + 1);
+  }
+
+  if (strlen (request->cmd) == 0) return -1;
+
+  return 0;
+}
+
+// returns 1 with a newly allocated line, 0 if no full line arrived within timeout_msec, -1 if the client is gone
+
+static int daemon_recv_line (const int fd, char *recv_buf, size_t *recv_len, char **line, const int timeout_msec)
+{
+  char *eol = (char *) memchr (recv_buf, '\n', *recv_len);
+
+  if (eol == NULL)
+  {
+    struct pollfd pfd;
+
+    pfd.fd      = fd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    const int rc_poll = poll (&pfd, 1, timeout_msec);
+
+    if (rc_poll == -1) return (errno == EINTR) ? 0 : -1;
+
+    if (rc_poll == 0) return 0;
+
+    if (*recv_len == DAEMON_REQUEST_SIZE - 1) return -1; // no newline in a full buffer, that is not our protocol
+
+    const ssize_t nrecv = recv (fd, recv_buf + *recv_len, DAEMON_REQUEST_SIZE - 1 - *recv_len, 0);
+
+    if (nrecv <= 0) return -1;
+
+    *recv_len += nrecv;
+
+    eol = (char *) memchr (recv_buf, '\n', *recv_len);
+
+    if (eol == NULL) return 0;
+  }
+
+  const size_t line_len = eol - recv_buf;
+
+  *line = (char *) hcmalloc (line_len + 1);
+
+  memcpy (*line, recv_buf, line_len);
+
+  *recv_len -= line_len + 1;
+
+  memmove (recv_buf, eol + 1, *recv_len);
+
+  return 1;
+}
+
+static bool daemon_send_status (hashcat_ctx_t *hashcat_ctx, const int fd, const u32 job_id)
+{
+  hashcat_status_t *hashcat_status = (hashcat_status_t *) hcmalloc (sizeof (hashcat_status_t));
+
+  if (hashcat_get_status (hashcat_ctx, hashcat_status) == -1)
+  {
+    hcfree (hashcat_status);
+
+    return true; // too early, nothing to report yet
+  }
+
+  char *target_json = daemon_json_encode (hashcat_status->hash_target);
+
+  const bool rc = daemon_send (fd, "{\"event\": \"status\", \"job\": %u, \"status\": \"%s\", \"status_number\": %d, \"target\": \"%s\", \"progress\": [%" PRIu64 ", %" PRIu64 "], \"recovered_hashes\": [%u, %u], \"recovered_salts\": [%u, %u], \"rejected\": %" PRIu64 ", \"speed\": %" PRIu64 ", \"msec_running\": %" PRIu64 "}\n",
+    job_id,
+    hashcat_status->status_string,
+    hashcat_status->status_number,
+    target_json,
+    hashcat_status->progress_cur_relative_skip,
+    hashcat_status->progress_end_relative_skip,
+    hashcat_status->digests_done,
+    hashcat_status->digests_cnt,
+    hashcat_status->salts_done,
+    hashcat_status->salts_cnt,
+    hashcat_status->progress_rejected,
+    (u64) (hashcat_status->hashes_msec_all * 1000),
+    (u64) hashcat_status->msec_running);
+
+  hcfree (target_json);
+
+  status_status_destroy (hashcat_ctx, hashcat_status);
+
+  hcfree (hashcat_status);
+
+  return rc;
+}
+
+static bool daemon_str_equal (const char *s1, const char *s2)
+{
+  if ((s1 == NULL) && (s2 == NULL)) return true;
+  if ((s1 == NULL) || (s2 == NULL)) return false;
+
+  return (strcmp (s1, s2) == 0);
+}
+
+static int daemon_job_options (hashcat_ctx_t *hashcat_ctx, daemon_request_t *request, const user_options_t *user_options_daemon)
+{
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (user_options_init (hashcat_ctx) == -1) return -1;
+
+  if (user_options_getopt (hashcat_ctx, request->argc, request->argv) == -1) return -1;
+
+  if (user_options_sanity (hashcat_ctx) == -1) return -1;
+
+  // devices are initialized once by the daemon, a job can only run on them
+
+  if ((user_options->daemon        == true)
+   || (user_options->identify      == true)
+   || (user_options->keyspace      == true)
+   || (user_options->left          == true)
+   || (user_options->show          == true)
+   || (user_options->stdout_flag   == true)
+   || (user_options->version       == true)
+   || (user_options->backend_info   > 0)
+   || (user_options->hash_info      > 0)
+   || (user_options->usage          > 0))
+  {
+    event_log_error (hashcat_ctx, "Informational and special modes are not supported in daemon jobs.");
+
+    return -1;
+  }
+
+  #ifdef WITH_BRAIN
+  if (user_options->brain_server == true)
+  {
+    event_log_error (hashcat_ctx, "Brain server is not supported in daemon jobs.");
+
+    return -1;
+  }
+  #endif
+
+  if ((daemon_str_equal (user_options->backend_devices,     user_options_daemon->backend_devices)     == false)
+   || (daemon_str_equal (user_options->opencl_device_types, user_options_daemon->opencl_device_types) == false)
+   || (user_options->backend_devices_virtmulti != user_options_daemon->backend_devices_virtmulti)
+   || (user_options->backend_devices_virthost  != user_options_daemon->backend_devices_virthost)
+   || (user_options->backend_devices_keepfree  != user_options_daemon->backend_devices_keepfree)
+   || (user_options->backend_ignore_cuda       != user_options_daemon->backend_ignore_cuda)
+   || (user_options->backend_ignore_hip        != user_options_daemon->backend_ignore_hip)
+   || (user_options->backend_ignore_metal      != user_options_daemon->backend_ignore_metal)
+   || (user_options->backend_ignore_opencl     != user_options_daemon->backend_ignore_opencl)
+   || (user_options->backend_native            != user_options_daemon->backend_native)
+   || (user_options->hwmon                     != user_options_daemon->hwmon))
+  {
+    event_log_error (hashcat_ctx, "Device selection and hardware monitoring options are fixed when the daemon starts.");
+
+    return -1;
+  }
+
+  // resolved by backend_ctx_devices_init () of the daemon
+
+  if (user_options->hook_threads == HOOK_THREADS) user_options->hook_threads = user_options_daemon->hook_threads;
+
+  // the metrics endpoint of the daemon is served by each job, unless the job brings its own
+
+  if ((user_options->metrics_port == METRICS_PORT) && (user_options->metrics_socket == NULL))
+  {
+    user_options->metrics_port   = user_options_daemon->metrics_port;
+    user_options->metrics_socket = user_options_daemon->metrics_socket;
+  }
+
+  return 0;
+}
+
+static int daemon_job_bridge_check (hashcat_ctx_t *hashcat_ctx)
+{
+  hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (user_options->autodetect == true) return 0;
+
+  if (hashconfig_init (hashcat_ctx) == -1)
+  {
+    hashconfig_destroy (hashcat_ctx);
+
+    return -1;
+  }
+
+  const bool has_bridge = (hashconfig->bridge_type != BRIDGE_TYPE_NONE);
+
+  hashconfig_destroy (hashcat_ctx);
+
+  if (has_bridge == true)
+  {
+    event_log_error (hashcat_ctx, "Hash-mode %u uses an assimilation bridge, which is not supported in daemon jobs.", user_options->hash_mode);
+
+    return -1;
+  }
+
+  return 0;
+}
+
+static HC_API_CALL void *thread_daemon_job (void *p)
+{
+  daemon_job_t *daemon_job = (daemon_job_t *) p;
+
+  const int rc = hashcat_session_execute (daemon_job->hashcat_ctx);
+
+  hc_thread_mutex_lock (daemon_job->mux);
+
+  daemon_job->rc       = rc;
+  daemon_job->finished = true;
+
+  hc_thread_mutex_unlock (daemon_job->mux);
+
+  return NULL;
+}
+
+static bool daemon_job_finished (daemon_job_t *daemon_job)
+{
+  hc_thread_mutex_lock (daemon_job->mux);
+
+  const bool finished = daemon_job->finished;
+
+  hc_thread_mutex_unlock (daemon_job->mux);
+
+  return finished;
+}
+
+// returns -1 if the client is gone
+
+static int daemon_job_control (hashcat_ctx_t *hashcat_ctx, const int fd, const u32 job_id, char *line, bool *shutdown)
+{
+  daemon_request_t request;
+
+  if (daemon_request_parse (line, &request) == -1)
+  {
+    daemon_request_destroy (&request);
+
+    return (daemon_send_error (fd, "Invalid request.") == true) ? 0 : -1;
+  }
+
+  bool rc_send = true;
+
+  int rc = 0;
+
+  if (strcmp (request.cmd, "status") == 0)
+  {
+    rc_send = daemon_send_status (hashcat_ctx, fd, job_id);
+  }
+  else if (strcmp (request.cmd, "pause")      == 0) rc = hashcat_session_pause      (hashcat_ctx);
+  else if (strcmp (request.cmd, "resume")     == 0) rc = hashcat_session_resume     (hashcat_ctx);
+  else if (strcmp (request.cmd, "bypass")     == 0) rc = hashcat_session_bypass     (hashcat_ctx);
+  else if (strcmp (request.cmd, "checkpoint") == 0) rc = hashcat_session_checkpoint (hashcat_ctx);
+  else if (strcmp (request.cmd, "finish")     == 0) rc = hashcat_session_finish     (hashcat_ctx);
+  else if (strcmp (request.cmd, "quit")       == 0) rc = hashcat_session_quit       (hashcat_ctx);
+  else if (strcmp (request.cmd, "shutdown")   == 0)
+  {
+    rc = hashcat_session_quit (hashcat_ctx);
+
+    *shutdown = true;
+  }
+  else
+  {
+    rc_send = daemon_send_error (fd, "Unsupported command while a job is running.");
+  }
+
+  if (rc == -1)
+  {
+    rc_send = daemon_send_error (fd, "Command not possible in the current job state.");
+  }
+
+  daemon_request_destroy (&request);
+
+  return (rc_send == true) ? 0 : -1;
+}
+
+static int daemon_job (hashcat_ctx_t *hashcat_ctx, const int fd, char *recv_buf, size_t *recv_len, daemon_request_t *request, const user_options_t *user_options_daemon, const u32 job_id, bool *shutdown)
+{
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  int rc_job = -1;
+
+  bool client_gone = false;
+
+  if (daemon_job_options (hashcat_ctx, request, user_options_daemon) == 0)
+  {
+    if ((hashcat_session_job_init (hashcat_ctx, request->argc, request->argv) == 0) && (daemon_job_bridge_check (hashcat_ctx) == 0))
+    {
+      if (daemon_send (fd, "{\"event\": \"started\", \"job\": %u}\n", job_id) == false) client_gone = true;
+
+      daemon_job_t daemon_job;
+
+      daemon_job.hashcat_ctx = hashcat_ctx;
+      daemon_job.rc          = -1;
+      daemon_job.finished    = false;
+
+      hc_thread_mutex_init (daemon_job.mux);
+
+      hc_thread_t job_thread;
+
+      hc_thread_create (job_thread, thread_daemon_job, &daemon_job);
+
+      const u32 status_timer = user_options->status_timer;
+
+      time_t status_last = time (NULL);
+
+      bool quit_sent = false;
+
+      while (daemon_job_finished (&daemon_job) == false)
+      {
+        if ((daemon_running == false) && (quit_sent == false))
+        {
+          hashcat_session_quit (hashcat_ctx);
+
+          quit_sent = true;
+        }
+
+        if (client_gone == true)
+        {
+          poll (NULL, 0, DAEMON_POLL_MSEC);
+
+          continue;
+        }
+
+        char *line = NULL;
+
+        const int rc_line = daemon_recv_line (fd, recv_buf, recv_len, &line, DAEMON_POLL_MSEC);
+
+        if (rc_line == -1) client_gone = true;
+
+        if (rc_line ==  1)
+        {
+          if (daemon_job_control (hashcat_ctx, fd, job_id, line, shutdown) == -1) client_gone = true;
+        }
+
+        // nobody is left to collect the results
+
+        if ((client_gone == true) && (quit_sent == false))
+        {
+          hashcat_session_quit (hashcat_ctx);
+
+          quit_sent = true;
+
+          continue;
+        }
+
+        if (status_timer == 0) continue;
+
+        const time_t now = time (NULL);
+
+        if ((now - status_last) < (time_t) status_timer) continue;
+
+        status_last = now;
+
+        if (daemon_send_status (hashcat_ctx, fd, job_id) == false) client_gone = true;
+      }
+
+      hc_thread_wait (1, &job_thread);
+
+      hc_thread_mutex_delete (daemon_job.mux);
+
+      rc_job = daemon_job.rc;
+
+      if (client_gone == false) daemon_send_status (hashcat_ctx, fd, job_id);
+    }
+
+    hashcat_session_job_destroy (hashcat_ctx);
+  }
+
+  if (client_gone == false)
+  {
+    if (rc_job == -1)
+    {
+      char *message_json = daemon_json_encode (hashcat_get_log (hashcat_ctx));
+
+      if (daemon_send (fd, "{\"event\": \"finished\", \"job\": %u, \"rc\": %d, \"message\": \"%s\"}\n", job_id, rc_job, message_json) == false) client_gone = true;
+
+      hcfree (message_json);
+    }
+    else
+    {
+      if (daemon_send (fd, "{\"event\": \"finished\", \"job\": %u, \"rc\": %d}\n", job_id, rc_job) == false) client_gone = true;
+    }
+  }
+
+  // back to the options the daemon was started with
+
+  user_options_destroy (hashcat_ctx);
+
+  memcpy (user_options, user_options_daemon, sizeof (user_options_t));
+
+  return (client_gone == true) ? -1 : 0;
+}
+
+static void daemon_client (hashcat_ctx_t *hashcat_ctx, const int fd, const user_options_t *user_options_daemon, u32 *jobs_cnt, bool *shutdown)
+{
+  char *recv_buf = (char *) hcmalloc (DAEMON_REQUEST_SIZE);
+
+  size_t recv_len = 0;
+
+  while ((daemon_running == true) && (*shutdown == false))
+  {
+    char *line = NULL;
+
+    const int rc_line = daemon_recv_line (fd, recv_buf, &recv_len, &line, DAEMON_POLL_MSEC);
+
+    if (rc_line == -1) break;
+
+    if (rc_line ==  0) continue;
+
+    daemon_request_t request;
+
+    if (daemon_request_parse (line, &request) == -1)
+    {
+      daemon_request_destroy (&request);
+
+      if (daemon_send_error (fd, "Invalid request.") == false) break;
+
+      continue;
+    }
+
+    int rc = 0;
+
+    if (strcmp (request.cmd, "run") == 0)
+    {
+      *jobs_cnt += 1;
+
+      rc = daemon_job (hashcat_ctx, fd, recv_buf, &recv_len, &request, user_options_daemon, *jobs_cnt, shutdown);
+    }
+    else if (strcmp (request.cmd, "status") == 0)
+    {
+      rc = (daemon_send (fd, "{\"event\": \"idle\", \"jobs\": %u}\n", *jobs_cnt) == true) ? 0 : -1;
+    }
+    else if (strcmp (request.cmd, "shutdown") == 0)
+    {
+      *shutdown = true;
+    }
+    else
+    {
+      rc = (daemon_send_error (fd, "Unsupported command.") == true) ? 0 : -1;
+    }
+
+    daemon_request_destroy (&request);
+
+    if (rc == -1) break;
+  }
+
+  if (*shutdown == true) daemon_send (fd, "{\"event\": \"shutdown\"}\n");
+
+  hcfree (recv_buf);
+}
+
+static int daemon_socket_open (hashcat_ctx_t *hashcat_ctx, const char *socket_path)
+{
+  struct sockaddr_un addr;
+
+  memset (&addr, 0, sizeof (addr));
+
+  addr.sun_family = AF_UNIX;
+
+  if (strlen (socket_path) >= sizeof (addr.sun_path))
+  {
+    event_log_error (hashcat_ctx, "%s: Socket path is too long.", socket_path);
+
+    return -1;
+  }
+
+  strncpy (addr.sun_path, socket_path, sizeof (addr.sun_path) - 1);
+
+  const int fd = socket (AF_UNIX, SOCK_STREAM, 0);
+
+  if (fd == -1)
+  {
+    event_log_error (hashcat_ctx, "socket: %s", strerror (errno));
+
+    return -1;
+  }
+
+  // a left-over socket of a daemon which did not shut down cleanly is replaced, a live one is not
+
+  struct stat s;
+
+  if (lstat (socket_path, &s) == 0)
+  {
+    if (S_ISSOCK (s.st_mode) == 0)
+    {
+      event_log_error (hashcat_ctx, "%s: Not a socket.", socket_path);
+
+      close (fd);
+
+      return -1;
+    }
+
+    if (connect (fd, (struct sockaddr *) &addr, sizeof (addr)) == 0)
+    {
+      event_log_error (hashcat_ctx, "%s: Another daemon is already listening.", socket_path);
+
+      close (fd);
+
+      return -1;
+    }
+
+    unlink (socket_path);
+  }
+
+  if (bind (fd, (struct sockaddr *) &addr, sizeof (addr)) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", socket_path, strerror (errno));
+
+    close (fd);
+
+    return -1;
+  }
+
+  // jobs can read and write any file the daemon user can, so nobody else gets to submit them
+
+  if (chmod (socket_path, S_IRUSR | S_IWUSR) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", socket_path, strerror (errno));
+
+    close (fd);
+
+    unlink (socket_path);
+
+    return -1;
+  }
+
+  if (listen (fd, 8) == -1)
+  {
+    event_log_error (hashcat_ctx, "listen: %s", strerror (errno));
+
+    close (fd);
+
+    unlink (socket_path);
+
+    return -1;
+  }
+
+  return fd;
+}
+
+int daemon_run (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
+{
+  const bridge_ctx_t    *bridge_ctx    = hashcat_ctx->bridge_ctx;
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+        user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  if (bridge_ctx->enabled == true)
+  {
+    event_log_error (hashcat_ctx, "Daemon mode does not support hash-modes with an assimilation bridge.");
+
+    return -1;
+  }
+
+  char *socket_path = NULL;
+
+  if (user_options->daemon_socket == NULL)
+  {
+    hc_asprintf (&socket_path, "%s/%s.sock", folder_config->session_dir, user_options->session);
+  }
+  else
+  {
+    socket_path = hcstrdup (user_options->daemon_socket);
+  }
+
+  const int server_fd = daemon_socket_open (hashcat_ctx, socket_path);
+
+  if (server_fd == -1)
+  {
+    hcfree (socket_path);
+
+    return -1;
+  }
+
+  daemon_running = true;
+
+  signal (SIGINT,  daemon_handle_signal);
+  signal (SIGTERM, daemon_handle_signal);
+  signal (SIGPIPE, SIG_IGN);
+
+  // the daemon's own session state is replaced by the one of each job
+
+  user_options_t *user_options_daemon = (user_options_t *) hcmalloc (sizeof (user_options_t));
+
+  memcpy (user_options_daemon, user_options, sizeof (user_options_t));
+
+  hashcat_session_job_destroy (hashcat_ctx);
+
+  // the jobs share their kernel programs, hashlist and autotune results where they can, see resident.c
+
+  resident_ctx_init (hashcat_ctx);
+
+  event_log_info (hashcat_ctx, "Daemon listening on %s", socket_path);
+  event_log_info (hashcat_ctx, NULL);
+
+  u32 jobs_cnt = 0;
+
+  bool shutdown = false;
+
+  while ((daemon_running == true) && (shutdown == false))
+  {
+    struct pollfd pfd;
+
+    pfd.fd      = server_fd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    const int rc_poll = poll (&pfd, 1, DAEMON_POLL_MSEC);
+
+    if (rc_poll <= 0) continue;
+
+    const int client_fd = accept (server_fd, NULL, NULL);
+
+    if (client_fd == -1) continue;
+
+    daemon_client (hashcat_ctx, client_fd, user_options_daemon, &jobs_cnt, &shutdown);
+
+    close (client_fd);
+  }
+
+  close (server_fd);
+
+  unlink (socket_path);
+
+  event_log_info (hashcat_ctx, "Daemon stopped after %u jobs", jobs_cnt);
+  event_log_info (hashcat_ctx, NULL);
+
+  resident_ctx_destroy (hashcat_ctx);
+
+  hcfree (socket_path);
+
+  hcfree (user_options_daemon);
+
+  // hashcat_session_destroy () expects the daemon's own session state
+
+  return hashcat_session_job_init (hashcat_ctx, argc, argv);
+}
+
+#endif
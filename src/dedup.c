@@ -0,0 +1,450 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "shared.h"
+#include "thread.h"
+#include "dedup.h"
+
+/**
+ * --dedup keeps the hashes of all candidates already tested in a cuckoo filter, so a candidate coming
+ * again from a later rule, wordlist or wordlist line is skipped like a --brain-client would do it.
+ * a false positive skips a candidate that was not tested, with 32 bit fingerprints that is about 1 in 2^29.
+ * a lost fingerprint (full filter) only means a candidate is tested twice.
+ */
+
+static u64 dedup_hash (const u8 *pw_buf, const u32 pw_len)
+{
+  // FNV-1a with a final avalanche, bucket index and fingerprint come from different bits
+
+  u64 hash = 0xcbf29ce484222325;
+
+  for (u32 i = 0; i < pw_len; i++)
+  {
+    hash ^= pw_buf[i];
+    hash *= 0x100000001b3;
+  }
+
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccd;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53;
+  hash ^= hash >> 33;
+
+  // 0 marks an empty slot in dedup_seen
+
+  if (hash == 0) hash = 1;
+
+  return hash;
+}
+
+static u32 dedup_fingerprint (const u64 hash)
+{
+  const u32 fp = (u32) (hash >> 32);
+
+  return (fp == 0) ? 1 : fp;
+}
+
+static u64 dedup_bucket_alt (const dedup_ctx_t *dedup_ctx, const u64 bucket, const u32 fp)
+{
+  // partial-key cuckoo hashing, the alternate bucket can be computed from either bucket and the fingerprint
+
+  return (bucket ^ ((u64) fp * 0x5bd1e995)) & (dedup_ctx->buckets_cnt - 1);
+}
+
+static bool dedup_bucket_find (const dedup_ctx_t *dedup_ctx, const u64 bucket, const u32 fp)
+{
+  const u32 *slots = dedup_ctx->buckets_buf + (bucket * DEDUP_BUCKET_SLOTS);
+
+  for (int i = 0; i < DEDUP_BUCKET_SLOTS; i++)
+  {
+    if (slots[i] == fp) return true;
+  }
+
+  return false;
+}
+
+static bool dedup_bucket_put (dedup_ctx_t *dedup_ctx, const u64 bucket, const u32 fp)
+{
+  u32 *slots = dedup_ctx->buckets_buf + (bucket * DEDUP_BUCKET_SLOTS);
+
+  for (int i = 0; i < DEDUP_BUCKET_SLOTS; i++)
+  {
+    if (slots[i] != 0) continue;
+
+    slots[i] = fp;
+
+    return true;
+  }
+
+  return false;
+}
+
+static bool dedup_filter_find (const dedup_ctx_t *dedup_ctx, const u64 hash)
+{
+  const u32 fp = dedup_fingerprint (hash);
+
+  const u64 bucket1 = hash & (dedup_ctx->buckets_cnt - 1);
+  const u64 bucket2 = dedup_bucket_alt (dedup_ctx, bucket1, fp);
+
+  if (dedup_bucket_find (dedup_ctx, bucket1, fp) == true) return true;
+  if (dedup_bucket_find (dedup_ctx, bucket2, fp) == true) return true;
+
+  return false;
+}
+
+static void dedup_filter_add (dedup_ctx_t *dedup_ctx, const u64 hash)
+{
+  u32 fp = dedup_fingerprint (hash);
+
+  const u64 bucket1 = hash & (dedup_ctx->buckets_cnt - 1);
+  const u64 bucket2 = dedup_bucket_alt (dedup_ctx, bucket1, fp);
+
+  if (dedup_bucket_find (dedup_ctx, bucket1, fp) == true) return;
+  if (dedup_bucket_find (dedup_ctx, bucket2, fp) == true) return;
+
+  dedup_ctx->items++;
+
+  if (dedup_bucket_put (dedup_ctx, bucket1, fp) == true) return;
+  if (dedup_bucket_put (dedup_ctx, bucket2, fp) == true) return;
+
+  // both buckets full, move fingerprints to their alternate bucket until one finds a free slot
+
+  u64 bucket = (dedup_ctx->kick_pos & 1) ? bucket1 : bucket2;
+
+  for (int kicks = 0; kicks < DEDUP_KICKS_MAX; kicks++)
+  {
+    u32 *slots = dedup_ctx->buckets_buf + (bucket * DEDUP_BUCKET_SLOTS);
+
+    const u32 slot = dedup_ctx->kick_pos++ % DEDUP_BUCKET_SLOTS;
+
+    const u32 fp_kicked = slots[slot];
+
+    slots[slot] = fp;
+
+    fp = fp_kicked;
+
+    bucket = dedup_bucket_alt (dedup_ctx, bucket, fp);
+
+    if (dedup_bucket_put (dedup_ctx, bucket, fp) == true) return;
+  }
+
+  dedup_ctx->items--;
+  dedup_ctx->dropped++;
+}
+
+static int dedup_read (hashcat_ctx_t *hashcat_ctx)
+{
+  dedup_ctx_t    *dedup_ctx    = hashcat_ctx->dedup_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, dedup_ctx->filename, "rb") == false) return -1;
+
+  u64 header[6];
+
+  const size_t nread = hc_fread (header, sizeof (u64), 6, &fp);
+
+  if (nread != 6)
+  {
+    event_log_warning (hashcat_ctx, "%s: Invalid header, ignoring content", dedup_ctx->filename);
+
+    hc_fclose (&fp);
+
+    return -1;
+  }
+
+  const u64 buckets_cnt = header[3];
+
+  if ((header[0] != DEDUP_VERSION)
+   || (header[1] != (u64) user_options->hash_mode)
+   || (header[2] != ((u64) user_options->attack_mode | ((u64) user_options->slow_candidates << 32)))
+   || (buckets_cnt == 0)
+   || (buckets_cnt & (buckets_cnt - 1))
+   || (buckets_cnt > (DEDUP_MEMORY_MAX / (DEDUP_BUCKET_SLOTS * sizeof (u32)))))
+  {
+    event_log_warning (hashcat_ctx, "%s: Header does not match the session, ignoring content", dedup_ctx->filename);
+
+    hc_fclose (&fp);
+
+    return -1;
+  }
+
+  u32 *buckets_buf = (u32 *) hcmalloc (buckets_cnt * DEDUP_BUCKET_SLOTS * sizeof (u32));
+
+  if (hc_fread (buckets_buf, DEDUP_BUCKET_SLOTS * sizeof (u32), buckets_cnt, &fp) != buckets_cnt)
+  {
+    event_log_warning (hashcat_ctx, "%s: Truncated file, ignoring content", dedup_ctx->filename);
+
+    hcfree (buckets_buf);
+
+    hc_fclose (&fp);
+
+    return -1;
+  }
+
+  hc_fclose (&fp);
+
+  dedup_ctx->buckets_buf = buckets_buf;
+  dedup_ctx->buckets_cnt = buckets_cnt;
+  dedup_ctx->items       = header[4];
+  dedup_ctx->skipped     = header[5];
+
+  return 0;
+}
+
+int dedup_init (hashcat_ctx_t *hashcat_ctx)
+{
+  dedup_ctx_t     *dedup_ctx     = hashcat_ctx->dedup_ctx;
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+  restore_ctx_t   *restore_ctx   = hashcat_ctx->restore_ctx;
+  user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  memset (dedup_ctx, 0, sizeof (dedup_ctx_t));
+
+  dedup_ctx->enabled = false;
+
+  if (user_options->usage          > 0)    return 0;
+  if (user_options->backend_info   > 0)    return 0;
+  if (user_options->hash_info      > 0)    return 0;
+
+  if (user_options->benchmark     == true) return 0;
+  if (user_options->keyspace      == true) return 0;
+  if (user_options->left          == true) return 0;
+  if (user_options->show          == true) return 0;
+  if (user_options->speed_only    == true) return 0;
+  if (user_options->progress_only == true) return 0;
+  if (user_options->version       == true) return 0;
+  if (user_options->identify      == true) return 0;
+
+  if (user_options->dedup         == false) return 0;
+
+  hc_asprintf (&dedup_ctx->filename, "%s/%s.dedup", folder_config->session_dir, user_options->session);
+
+  hc_thread_mutex_init (dedup_ctx->mux);
+
+  dedup_ctx->enabled = true;
+
+  // a restored session continues with the filter of the interrupted one
+
+  if (restore_ctx->restore_execute == true)
+  {
+    if (dedup_read (hashcat_ctx) == 0) return 0;
+  }
+
+  // sized once from the free host memory, the filter does not grow
+
+  u64 free_mem = 0;
+
+  if (get_free_memory (&free_mem) == false) free_mem = 0;
+
+  u64 size_filter = free_mem / DEDUP_MEMORY_SHARE;
+
+  size_filter = MIN (size_filter, DEDUP_MEMORY_MAX);
+  size_filter = MAX (size_filter, DEDUP_MEMORY_MIN);
+
+  u64 buckets_cnt = 1;
+
+  while ((buckets_cnt * 2 * DEDUP_BUCKET_SLOTS * sizeof (u32)) <= size_filter) buckets_cnt *= 2;
+
+  dedup_ctx->buckets_buf = (u32 *) hccalloc (buckets_cnt * DEDUP_BUCKET_SLOTS, sizeof (u32));
+  dedup_ctx->buckets_cnt = buckets_cnt;
+
+  return 0;
+}
+
+void dedup_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return;
+
+  hc_thread_mutex_delete (dedup_ctx->mux);
+
+  hcfree (dedup_ctx->filename);
+  hcfree (dedup_ctx->buckets_buf);
+
+  memset (dedup_ctx, 0, sizeof (dedup_ctx_t));
+}
+
+int dedup_write (hashcat_ctx_t *hashcat_ctx)
+{
+  dedup_ctx_t    *dedup_ctx    = hashcat_ctx->dedup_ctx;
+  restore_ctx_t  *restore_ctx  = hashcat_ctx->restore_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (dedup_ctx->enabled == false) return 0;
+
+  if (restore_ctx->enabled == false) return 0;
+
+  // the filter is only of use together with the restore file
+
+  if (hc_path_exist (restore_ctx->eff_restore_file) == false)
+  {
+    unlink (dedup_ctx->filename);
+
+    return 0;
+  }
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, dedup_ctx->filename, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", dedup_ctx->filename, strerror (errno));
+
+    return -1;
+  }
+
+  hc_thread_mutex_lock (dedup_ctx->mux);
+
+  u64 header[6];
+
+  header[0] = DEDUP_VERSION;
+  header[1] = (u64) user_options->hash_mode;
+  header[2] = (u64) user_options->attack_mode | ((u64) user_options->slow_candidates << 32);
+  header[3] = dedup_ctx->buckets_cnt;
+  header[4] = dedup_ctx->items;
+  header[5] = dedup_ctx->skipped;
+
+  hc_fwrite (header, sizeof (u64), 6, &fp);
+
+  hc_fwrite (dedup_ctx->buckets_buf, DEDUP_BUCKET_SLOTS * sizeof (u32), dedup_ctx->buckets_cnt, &fp);
+
+  hc_thread_mutex_unlock (dedup_ctx->mux);
+
+  hc_fclose (&fp);
+
+  return 0;
+}
+
+int dedup_device_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return 0;
+
+  // pws_idx has one entry per candidate of the largest batch, plus one
+
+  const u64 pws_max = (device_param->size_pws_idx / sizeof (pw_idx_t)) - 1;
+
+  u64 seen_size = 1;
+
+  while (seen_size < (pws_max * 2)) seen_size *= 2;
+
+  device_param->dedup_buf       = (u64 *) hccalloc (pws_max,   sizeof (u64));
+  device_param->dedup_cnt       = 0;
+  device_param->dedup_avail     = pws_max;
+  device_param->dedup_seen      = (u64 *) hccalloc (seen_size, sizeof (u64));
+  device_param->dedup_seen_size = seen_size;
+
+  return 0;
+}
+
+void dedup_device_destroy (hc_device_param_t *device_param)
+{
+  hcfree (device_param->dedup_buf);
+  hcfree (device_param->dedup_seen);
+
+  device_param->dedup_buf       = NULL;
+  device_param->dedup_cnt       = 0;
+  device_param->dedup_avail     = 0;
+  device_param->dedup_seen      = NULL;
+  device_param->dedup_seen_size = 0;
+}
+
+bool dedup_lookup (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u8 *pw_buf, const u32 pw_len)
+{
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return false;
+
+  if (device_param->dedup_avail == 0) return false;
+
+  const u64 hash = dedup_hash (pw_buf, pw_len);
+
+  // the batch in flight is not in the filter yet
+
+  const u64 seen_mask = device_param->dedup_seen_size - 1;
+
+  u64 slot = hash & seen_mask;
+
+  bool found = false;
+
+  while (device_param->dedup_seen[slot] != 0)
+  {
+    if (device_param->dedup_seen[slot] == hash)
+    {
+      found = true;
+
+      break;
+    }
+
+    slot = (slot + 1) & seen_mask;
+  }
+
+  hc_thread_mutex_lock (dedup_ctx->mux);
+
+  if (found == false) found = dedup_filter_find (dedup_ctx, hash);
+
+  if (found == true) dedup_ctx->skipped++;
+
+  hc_thread_mutex_unlock (dedup_ctx->mux);
+
+  if (found == true) return true;
+
+  if (device_param->dedup_cnt < device_param->dedup_avail)
+  {
+    device_param->dedup_seen[slot] = hash;
+
+    device_param->dedup_buf[device_param->dedup_cnt++] = hash;
+  }
+
+  return false;
+}
+
+void dedup_commit (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  dedup_ctx_t  *dedup_ctx  = hashcat_ctx->dedup_ctx;
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  if (dedup_ctx->enabled == false) return;
+
+  // an interrupted batch was not tested completely, its candidates must come again after a restore
+
+  if ((status_ctx->devices_status != STATUS_ABORTED)
+   && (status_ctx->devices_status != STATUS_ABORTED_RUNTIME)
+   && (status_ctx->devices_status != STATUS_QUIT)
+   && (status_ctx->devices_status != STATUS_BYPASS)
+   && (status_ctx->devices_status != STATUS_ERROR))
+  {
+    hc_thread_mutex_lock (dedup_ctx->mux);
+
+    for (u64 i = 0; i < device_param->dedup_cnt; i++)
+    {
+      dedup_filter_add (dedup_ctx, device_param->dedup_buf[i]);
+    }
+
+    hc_thread_mutex_unlock (dedup_ctx->mux);
+  }
+
+  dedup_discard (hashcat_ctx, device_param);
+}
+
+void dedup_discard (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return;
+
+  if (device_param->dedup_cnt == 0) return;
+
+  memset (device_param->dedup_seen, 0, device_param->dedup_seen_size * sizeof (u64));
+
+  device_param->dedup_cnt = 0;
+}
@@ -10,6 +10,7 @@
 #include "event.h"
 #include "locking.h"
 #include "shared.h"
+#include "blockfile.h"
 #include "dictstat.h"
 
 int sort_by_dictstat (const void *s1, const void *s2)
@@ -76,6 +77,16 @@ int dictstat_init (hashcat_ctx_t *hashcat_ctx)
 
   hc_asprintf (&dictstat_ctx->filename, "%s/%s", folder_config->profile_dir, DICTSTAT_FILENAME);
 
+  // block index and word marks of compressed wordlists
+
+  char *indexdir = NULL;
+
+  hc_asprintf (&indexdir, "%s/%s", folder_config->profile_dir, DICTSTAT_INDEXDIR);
+
+  blockfile_set_cache_dir (indexdir);
+
+  hcfree (indexdir);
+
   return 0;
 }
 
@@ -85,6 +96,8 @@ void dictstat_destroy (hashcat_ctx_t *hashcat_ctx)
 
   if (dictstat_ctx->enabled == false) return;
 
+  blockfile_set_cache_dir (NULL);
+
   hcfree (dictstat_ctx->filename);
   hcfree (dictstat_ctx->base);
 
@@ -11,13 +11,18 @@
 #include "wordlist.h"
 #include "shared.h"
 #include "thread.h"
+#include "timer.h"
 #include "filehandling.h"
 #include "rp.h"
 #include "rp_cpu.h"
+#include "rp_simd.h"
 #include "slow_candidates.h"
 #include "dispatch.h"
 #include "generic.h"
 #include "convert.h"
+#include "dedup.h"
+#include "affinity.h"
+#include "loopback.h"
 
 #ifdef WITH_BRAIN
 #include "brain.h"
@@ -107,13 +112,26 @@ static u64 get_power (backend_ctx_t *backend_ctx, hc_device_param_t *device_para
   return device_param->kernel_power;
 }
 
+static void dispatcher_lock (status_ctx_t *status_ctx, hc_device_param_t *device_param)
+{
+  // account the time spent waiting for other devices, exported as dispatcher wait by --metrics-port
+
+  hc_timer_t timer_wait;
+
+  hc_timer_set (&timer_wait);
+
+  hc_thread_mutex_lock (status_ctx->mux_dispatcher);
+
+  device_param->dispatcher_wait_msec += hc_timer_get (timer_wait);
+}
+
 static u64 get_work (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 max)
 {
   backend_ctx_t  *backend_ctx  = hashcat_ctx->backend_ctx;
   status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
   user_options_t *user_options = hashcat_ctx->user_options;
 
-  hc_thread_mutex_lock (status_ctx->mux_dispatcher);
+  dispatcher_lock (status_ctx, device_param);
 
   const u64 words_off  = status_ctx->words_off;
   const u64 words_base = (user_options->limit == 0) ? status_ctx->words_base : MIN (user_options->limit, status_ctx->words_base);
@@ -145,6 +163,119 @@ static u64 get_work (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
   return work;
 }
 
+#ifdef WITH_BRAIN
+static bool get_work_claim (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 words_cur, u64 *words_off, u64 *work, u64 *words_extra, u64 *words_extra_total)
+{
+  status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  // replaces the range of get_work () with the chunk the brain server hands out
+  // returns true if the chunk starts behind words_cur, the caller then has to rewind its candidate generator
+
+  if ((device_param->brain_link_client_fd != -1) && (device_param->brain_link_version < (u32) BRAIN_LINK_VERSION_CLAIM))
+  {
+    // the server predates claims, stay on our own range and reserve it like --brain-client-features 2 does
+
+    u64 overlap = 0;
+
+    if (brain_client_reserve (device_param, status_ctx, *words_off, *work, &overlap) == false)
+    {
+      brain_client_disconnect (device_param);
+    }
+
+    *words_extra        = overlap;
+    *words_extra_total += overlap;
+    *words_off         += overlap;
+    *work              -= overlap;
+
+    return false;
+  }
+
+  const u64 words_base = (user_options->limit == 0) ? status_ctx->words_base : MIN (user_options->limit, status_ctx->words_base);
+
+  u64 claim_off = 0;
+  u64 claim_len = 0;
+
+  while (true)
+  {
+    if (brain_client_claim (device_param, status_ctx, words_base, *work, &claim_off, &claim_len) == false)
+    {
+      brain_client_disconnect (device_param);
+
+      claim_off = *words_off;
+      claim_len = *work;
+    }
+
+    if (claim_len > 0) break;
+
+    // an offset below words_base means other clients still hold uncommitted reservations
+    // they can fail or expire, so we are not done before the server says everything is committed
+
+    if (claim_off >= words_base) break;
+
+    if (status_ctx->run_thread_level1 == false) break;
+
+    if ((device_param->pws_cnt > 0) || (device_param->pws_pre_cnt > 0))
+    {
+      // our own reservations are not committed yet either, run and commit them first
+      // otherwise two clients could wait for each other until their leases expire, which never happens as long as they poll
+      // hand the range back to get_work (), the caller asks again with the next batch
+
+      dispatcher_lock (status_ctx, device_param);
+
+      status_ctx->words_off -= *work;
+
+      hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+
+      *words_extra = 0;
+      *words_off   = words_cur;
+      *work        = 0;
+
+      return false;
+    }
+
+    sleep (1);
+  }
+
+  if (claim_len == 0)
+  {
+    // the server says everything is committed, the rest of the keyspace was done by other clients
+
+    dispatcher_lock (status_ctx, device_param);
+
+    if (status_ctx->words_off < words_base)
+    {
+      *words_extra_total += words_base - status_ctx->words_off;
+
+      status_ctx->words_off = words_base;
+    }
+
+    hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+
+    *words_extra_total += *work;
+
+    claim_off = words_cur;
+  }
+  else if (claim_len < *work)
+  {
+    // only the positions the server hands out count against words_base
+    // otherwise get_work () runs dry while the server still has uncommitted or reclaimed ranges for us
+
+    dispatcher_lock (status_ctx, device_param);
+
+    status_ctx->words_off -= *work - claim_len;
+
+    hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+  }
+
+  *words_extra = *work - claim_len;
+  *words_off   = claim_off;
+  *work        = claim_len;
+
+  return (claim_off < words_cur);
+}
+#endif
+
 static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
   user_options_t       *user_options       = hashcat_ctx->user_options;
@@ -183,7 +314,7 @@ static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
 
   while (status_ctx->run_thread_level1 == true)
   {
-    hc_thread_mutex_lock (status_ctx->mux_dispatcher);
+    dispatcher_lock (status_ctx, device_param);
 
     if (feof (stdin) != 0)
     {
@@ -370,6 +501,10 @@ HC_API_CALL void *thread_calc_stdin (void *p)
 
   if (bridge_ctx->enabled == true)
   {
+    // keep the host thread of the bridge unit on the node its memory lives on
+
+    if (device_param->numa_node != -1) numa_bind_thread (&backend_ctx->numa_topology, device_param->numa_node);
+
     if (bridge_ctx->thread_init != BRIDGE_DEFAULT)
     {
       if (bridge_ctx->thread_init (bridge_ctx->platform_context, device_param, hashconfig, hashes) == false) return NULL;
@@ -424,6 +559,10 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
   const u32 attack_mode = user_options->attack_mode;
   const u32 attack_kern = user_options_extra->attack_kern;
 
+  // candidates of a batch that was left before its commit were never tested
+
+  dedup_discard (hashcat_ctx, device_param);
+
   if (user_options->slow_candidates == true)
   {
     #ifdef WITH_BRAIN
@@ -445,7 +584,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
       if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_ATTACKS)
       {
-        hc_thread_mutex_lock (status_ctx->mux_dispatcher);
+        dispatcher_lock (status_ctx, device_param);
 
         if (status_ctx->words_off == 0)
         {
@@ -559,6 +698,17 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
                 words_off         += overlap;
                 work              -= overlap;
               }
+              else if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_CLAIMS)
+              {
+                if (get_work_claim (hashcat_ctx, device_param, words_cur, &words_off, &work, &words_extra, &words_extra_total) == true)
+                {
+                  // the server handed out a gap behind our current position
+
+                  slow_candidates_rewind (hashcat_ctx_tmp, &extra_info_straight);
+
+                  words_cur = 0;
+                }
+              }
             }
             #endif
 
@@ -583,6 +733,13 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
                 continue;
               }
 
+              if (dedup_lookup (hashcat_ctx, device_param, extra_info_straight.out_buf, extra_info_straight.out_len) == true)
+              {
+                pre_rejects++;
+
+                continue;
+              }
+
               #ifdef WITH_BRAIN
               if (user_options->brain_client == true)
               {
@@ -726,6 +883,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           }
           #endif
 
+          dedup_commit (hashcat_ctx, device_param);
+
           device_param->pws_cnt      = 0;
           device_param->pws_base_cnt = 0;
         }
@@ -873,6 +1032,17 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
                 words_off         += overlap;
                 work              -= overlap;
               }
+              else if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_CLAIMS)
+              {
+                if (get_work_claim (hashcat_ctx, device_param, words_cur, &words_off, &work, &words_extra, &words_extra_total) == true)
+                {
+                  // the server handed out a gap behind our current position
+
+                  slow_candidates_rewind (hashcat_ctx_tmp, &extra_info_combi);
+
+                  words_cur = 0;
+                }
+              }
             }
             #endif
 
@@ -895,6 +1065,13 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
                 continue;
               }
 
+              if (dedup_lookup (hashcat_ctx, device_param, extra_info_combi.out_buf, extra_info_combi.out_len) == true)
+              {
+                pre_rejects++;
+
+                continue;
+              }
+
               #ifdef WITH_BRAIN
               if (user_options->brain_client == true)
               {
@@ -1040,6 +1217,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           }
           #endif
 
+          dedup_commit (hashcat_ctx, device_param);
+
           device_param->pws_cnt      = 0;
           device_param->pws_base_cnt = 0;
         }
@@ -1138,6 +1317,12 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
                 words_off         += overlap;
                 work              -= overlap;
               }
+              else if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_CLAIMS)
+              {
+                // masks are generated by position, there is nothing to rewind
+
+                get_work_claim (hashcat_ctx, device_param, words_cur, &words_off, &work, &words_extra, &words_extra_total);
+              }
             }
             #endif
 
@@ -1514,6 +1699,26 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         return -1;
       }
 
+      // post-process rule engine, the words run through -j / -k a batch at a time
+
+      int         rule_jk_len = (int) user_options_extra->rule_len_l;
+      const char *rule_jk_buf = user_options->rule_buf_l;
+
+      if (attack_mode == ATTACK_MODE_HYBRID2)
+      {
+        rule_jk_len = (int) user_options_extra->rule_len_r;
+        rule_jk_buf = user_options->rule_buf_r;
+      }
+
+      rp_simd_t *rp_simd = NULL;
+
+      if (run_rule_engine (rule_jk_len, rule_jk_buf))
+      {
+        rp_simd = (rp_simd_t *) hcmalloc (sizeof (rp_simd_t));
+
+        rp_simd_init (rp_simd, rule_jk_buf, rule_jk_len);
+      }
+
       u64 words_cur = 0;
 
       while (status_ctx->run_thread_level1 == true)
@@ -1526,6 +1731,12 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         memset (device_param->pws_comp, 0, device_param->size_pws_comp);
         memset (device_param->pws_idx,  0, device_param->size_pws_idx);
 
+        // leave room in the batch for new plains waiting in the loopback queue
+
+        const u64 loopback_reserve = (attack_mode == ATTACK_MODE_STRAIGHT) ? loopback_queue_reserve (hashcat_ctx, device_param) : 0;
+
+        if (loopback_reserve > 0) words_extra = device_param->kernel_power - loopback_reserve;
+
         while (words_extra)
         {
           const u64 work = get_work (hashcat_ctx, device_param, words_extra);
@@ -1540,37 +1751,44 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           char *line_buf;
           u32   line_len;
 
-          char rule_buf_out[RP_PASSWORD_SIZE];
+          wordlist_seek (hashcat_ctx_tmp, &fp, &words_cur, words_off);
 
           for ( ; words_cur < words_off; words_cur++) get_next_word (hashcat_ctx_tmp, &fp, &line_buf, &line_len);
 
+          if (rp_simd) rp_simd_reset (rp_simd);
+
           for ( ; words_cur < words_fin; words_cur++)
           {
-            get_next_word (hashcat_ctx_tmp, &fp, &line_buf, &line_len);
+            if (rp_simd)
+            {
+              // a batch never reaches past words_fin, so it is used up before the next get_work ()
 
-            // post-process rule engine
+              if (rp_simd->pos == rp_simd->cnt)
+              {
+                rp_simd_reset (rp_simd);
 
-            int   rule_jk_len = (int)    user_options_extra->rule_len_l;
-            const char *rule_jk_buf = user_options->rule_buf_l;
+                const u64 batch_cnt = MIN (words_fin - words_cur, RP_SIMD_LANES);
 
-            if (attack_mode == ATTACK_MODE_HYBRID2)
-            {
-              rule_jk_len = (int)    user_options_extra->rule_len_r;
-              rule_jk_buf = user_options->rule_buf_r;
-            }
+                for (u64 batch_pos = 0; batch_pos < batch_cnt; batch_pos++)
+                {
+                  get_next_word (hashcat_ctx_tmp, &fp, &line_buf, &line_len);
 
-            if (run_rule_engine (rule_jk_len, rule_jk_buf))
-            {
-              if (line_len >= RP_PASSWORD_SIZE) continue;
+                  rp_simd_add (rp_simd, line_buf, (int) line_len);
+                }
 
-              memset (rule_buf_out, 0, sizeof (rule_buf_out));
+                rp_simd_apply (rp_simd);
+              }
 
-              const int rule_len_out = _old_apply_rule (rule_jk_buf, rule_jk_len, line_buf, (int) line_len, rule_buf_out);
+              const int rp_simd_pos = rp_simd->pos++;
 
-              if (rule_len_out < 0) continue;
+              if (rp_simd->out_len[rp_simd_pos] < 0) continue;
 
-              line_buf = rule_buf_out;
-              line_len = (u32) rule_len_out;
+              line_buf = rp_simd->out_buf[rp_simd_pos];
+              line_len = (u32) rp_simd->out_len[rp_simd_pos];
+            }
+            else
+            {
+              get_next_word (hashcat_ctx_tmp, &fp, &line_buf, &line_len);
             }
 
             /*
@@ -1629,6 +1847,15 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
               }
             }
 
+            // the base word goes through the same rules every time, so a repeated one is a repeated candidate for each rule
+
+            if (dedup_lookup (hashcat_ctx, device_param, (const u8 *) line_buf, line_len) == true)
+            {
+              words_extra++;
+
+              continue;
+            }
+
             pw_add (device_param, (const u8 *) line_buf, (const int) line_len);
 
             if (status_ctx->run_thread_level1 == false) break;
@@ -1660,6 +1887,13 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           hc_thread_mutex_unlock (status_ctx->mux_counter);
         }
 
+        // plains from the loopback queue ride along with the active rules, they are not part of the keyspace
+
+        if (attack_mode == ATTACK_MODE_STRAIGHT)
+        {
+          device_param->pws_loopback_cnt = loopback_queue_fill (hashcat_ctx, device_param);
+        }
+
         //
         // flush
         //
@@ -1677,6 +1911,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
             hcfree (hashcat_ctx_tmp->wl_data);
             hcfree (hashcat_ctx_tmp);
 
+            hcfree (rp_simd);
+
             return -1;
           }
 
@@ -1689,11 +1925,17 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
             hcfree (hashcat_ctx_tmp->wl_data);
             hcfree (hashcat_ctx_tmp);
 
+            hcfree (rp_simd);
+
             return -1;
           }
 
+          dedup_commit (hashcat_ctx, device_param);
+
           device_param->pws_cnt = 0;
 
+          device_param->pws_loopback_cnt = 0;
+
           /*
           still required?
           if (attack_kern == ATTACK_KERN_STRAIGHT)
@@ -1745,6 +1987,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
       hcfree (hashcat_ctx_tmp->wl_data);
       hcfree (hashcat_ctx_tmp);
+
+      hcfree (rp_simd);
     }
   }
 
@@ -1778,6 +2022,10 @@ HC_API_CALL void *thread_calc (void *p)
 
   if (bridge_ctx->enabled == true)
   {
+    // keep the host thread of the bridge unit on the node its memory lives on
+
+    if (device_param->numa_node != -1) numa_bind_thread (&backend_ctx->numa_topology, device_param->numa_node);
+
     if (bridge_ctx->thread_init != BRIDGE_DEFAULT)
     {
       if (bridge_ctx->thread_init (bridge_ctx->platform_context, device_param, hashconfig, hashes) == false) return NULL;
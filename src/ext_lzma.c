@@ -41,3 +41,38 @@ int hc_lzma2_decompress (const unsigned char *in, SizeT *in_len, unsigned char *
 
   return Lzma2Decode (out, out_len, in, in_len, (Byte) props[0], LZMA_FINISH_ANY, &status, &hc_lzma_mem_alloc);
 }
+
+int hc_lzma2_compress (const unsigned char *in, const SizeT in_len, unsigned char *out, SizeT *out_len, char *props, const int threads)
+{
+  ISzAlloc hc_lzma_mem_alloc = {hc_lzma_alloc, hc_lzma_free};
+
+  CLzma2EncHandle enc = Lzma2Enc_Create (&hc_lzma_mem_alloc, &hc_lzma_mem_alloc);
+
+  if (enc == NULL) return SZ_ERROR_MEM;
+
+  CLzma2EncProps enc_props;
+
+  Lzma2EncProps_Init (&enc_props);
+
+  enc_props.lzmaProps.level = 5;
+
+  enc_props.numTotalThreads = (threads > 0) ? threads : 1;
+
+  Lzma2EncProps_Normalize (&enc_props);
+
+  SRes res = Lzma2Enc_SetProps (enc, &enc_props);
+
+  if (res == SZ_OK)
+  {
+    props[0] = (char) Lzma2Enc_WriteProperties (enc);
+
+    // parameters to Lzma2Enc_Encode2 (): CLzma2EncHandle p, ISeqOutStreamPtr outStream, Byte *outBuf, size_t *outBufSize,
+    // ISeqInStreamPtr inStream, const Byte *inData, size_t inDataSize, ICompressProgressPtr progress
+
+    res = Lzma2Enc_Encode2 (enc, NULL, out, out_len, NULL, in, in_len, NULL);
+  }
+
+  Lzma2Enc_Destroy (enc);
+
+  return res;
+}
@@ -0,0 +1,553 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "thread.h"
+#include "shared.h"
+#include "ext_native.h"
+#include "affinity.h"
+
+#include "dynloader.h"
+
+#if !defined (_WIN)
+#include <sys/wait.h>
+#endif
+
+// runs argv[0] with its stdout and stderr captured into *output
+// returns the exit status of the child, or -1 if it could not be started
+
+static int native_exec (hashcat_ctx_t *hashcat_ctx, char **argv, char **output)
+{
+  *output = NULL;
+
+  #if defined (_WIN)
+
+  event_log_error (hashcat_ctx, "%s: The native backend is not supported on this platform.", argv[0]);
+
+  return -1;
+
+  #else
+
+  int fds[2];
+
+  if (pipe (fds) == -1)
+  {
+    event_log_error (hashcat_ctx, "pipe(): %s", strerror (errno));
+
+    return -1;
+  }
+
+  const pid_t pid = fork ();
+
+  if (pid == -1)
+  {
+    event_log_error (hashcat_ctx, "fork(): %s", strerror (errno));
+
+    close (fds[0]);
+    close (fds[1]);
+
+    return -1;
+  }
+
+  if (pid == 0)
+  {
+    dup2 (fds[1], STDOUT_FILENO);
+    dup2 (fds[1], STDERR_FILENO);
+
+    close (fds[0]);
+    close (fds[1]);
+
+    execvp (argv[0], argv);
+
+    _exit (127);
+  }
+
+  close (fds[1]);
+
+  char  *buf     = (char *) hcmalloc (NATIVE_LOG_SIZE + 1);
+  size_t buf_len = 0;
+
+  while (true)
+  {
+    char tmp[4096];
+
+    const ssize_t nread = read (fds[0], tmp, sizeof (tmp));
+
+    if (nread == -1)
+    {
+      if (errno == EINTR) continue;
+
+      break;
+    }
+
+    if (nread == 0) break;
+
+    // keep draining the pipe even if the log is full, otherwise the compiler blocks
+
+    const size_t copy_len = MIN ((size_t) nread, NATIVE_LOG_SIZE - buf_len);
+
+    memcpy (buf + buf_len, tmp, copy_len);
+
+    buf_len += copy_len;
+  }
+
+  close (fds[0]);
+
+  buf[buf_len] = 0;
+
+  *output = buf;
+
+  int status = 0;
+
+  while (waitpid (pid, &status, 0) == -1)
+  {
+    if (errno != EINTR) return -1;
+  }
+
+  if (WIFEXITED (status) == 0) return -1;
+
+  return WEXITSTATUS (status);
+
+  #endif
+}
+
+int native_init (void *hashcat_ctx)
+{
+  backend_ctx_t *backend_ctx = ((hashcat_ctx_t *) hashcat_ctx)->backend_ctx;
+
+  NATIVE_PTR *native = (NATIVE_PTR *) backend_ctx->native;
+
+  memset (native, 0, sizeof (NATIVE_PTR));
+
+  #if defined (_WIN)
+
+  return -1;
+
+  #else
+
+  // $CC may hold a wrapper like "ccache gcc", split it into words
+
+  const char *cc = getenv ("CC");
+
+  if ((cc == NULL) || (cc[0] == 0)) cc = "cc";
+
+  char *cc_buf = hcstrdup (cc);
+
+  char *saveptr = NULL;
+
+  for (char *word = strtok_r (cc_buf, " \t", &saveptr); word != NULL; word = strtok_r (NULL, " \t", &saveptr))
+  {
+    if (native->compiler_cnt == NATIVE_PREFIX_MAX - 1) break;
+
+    native->compiler[native->compiler_cnt++] = hcstrdup (word);
+  }
+
+  hcfree (cc_buf);
+
+  if (native->compiler_cnt == 0) return -1;
+
+  // the version check doubles as availability check
+
+  char *argv[NATIVE_PREFIX_MAX + 2] = { 0 };
+
+  int argc = 0;
+
+  for (int i = 0; i < native->compiler_cnt; i++) argv[argc++] = native->compiler[i];
+
+  argv[argc++] = "--version";
+
+  char *output = NULL;
+
+  const int rc = native_exec (hashcat_ctx, argv, &output);
+
+  if (rc != 0)
+  {
+    hcfree (output);
+
+    return -1;
+  }
+
+  char *eol = strchr (output, '\n');
+
+  if (eol) *eol = 0;
+
+  hc_string_trim_trailing (output);
+
+  native->version = output;
+
+  return 0;
+
+  #endif
+}
+
+void native_close (void *hashcat_ctx)
+{
+  backend_ctx_t *backend_ctx = ((hashcat_ctx_t *) hashcat_ctx)->backend_ctx;
+
+  NATIVE_PTR *native = (NATIVE_PTR *) backend_ctx->native;
+
+  if (native)
+  {
+    for (int i = 0; i < native->compiler_cnt; i++) hcfree (native->compiler[i]);
+
+    hcfree (native->version);
+
+    hcfree (backend_ctx->native);
+
+    backend_ctx->native = NULL;
+  }
+}
+
+int hc_nativeCompile (void *hashcat_ctx, const char *source_file, const char *include_file, const char *build_options, const char *output_file, char **build_log)
+{
+  backend_ctx_t *backend_ctx = ((hashcat_ctx_t *) hashcat_ctx)->backend_ctx;
+
+  NATIVE_PTR *native = (NATIVE_PTR *) backend_ctx->native;
+
+  // build options are in the OpenCL format, a double quote protects a path with spaces
+
+  char *options = hcstrdup (build_options);
+
+  const size_t options_len = strlen (options);
+
+  char **argv = (char **) hccalloc (NATIVE_PREFIX_MAX + 32 + options_len, sizeof (char *));
+
+  int argc = 0;
+
+  for (int i = 0; i < native->compiler_cnt; i++) argv[argc++] = native->compiler[i];
+
+  argv[argc++] = "-std=gnu99";
+  argv[argc++] = "-O2";
+  #if defined (__x86_64__) || defined (__i386__)
+  argv[argc++] = "-march=native";
+  #endif
+  argv[argc++] = "-fPIC";
+  argv[argc++] = "-shared";
+  argv[argc++] = "-fvisibility=hidden";
+  argv[argc++] = "-x";
+  argv[argc++] = "c";
+  argv[argc++] = "-include";
+  argv[argc++] = (char *) include_file;
+
+  char *out = options;
+
+  for (size_t pos = 0; pos < options_len;)
+  {
+    while ((pos < options_len) && (options[pos] == ' ')) pos++;
+
+    if (pos == options_len) break;
+
+    argv[argc++] = out;
+
+    bool quoted = false;
+
+    for (; pos < options_len; pos++)
+    {
+      const char c = options[pos];
+
+      if (c == '"')         { quoted = !quoted; continue; }
+      if ((c == ' ') && (quoted == false)) break;
+
+      *out++ = c;
+    }
+
+    // step over the separator first, the terminator may overwrite it
+
+    if (pos < options_len) pos++;
+
+    *out++ = 0;
+  }
+
+  argv[argc++] = "-o";
+  argv[argc++] = (char *) output_file;
+  argv[argc++] = (char *) source_file;
+  argv[argc++] = "-lm";
+
+  const int rc = native_exec (hashcat_ctx, argv, build_log);
+
+  hcfree (argv);
+  hcfree (options);
+
+  return (rc == 0) ? 0 : -1;
+}
+
+int hc_nativeModuleLoad (void *hashcat_ctx, native_module_t *module, const char *filename)
+{
+  module->lib = hc_dlopen (filename);
+
+  if (module->lib == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", filename, hc_dlerror ());
+
+    return -1;
+  }
+
+  module->launch = (NATIVE_LAUNCH) hc_dlsym (module->lib, "hc_native_launch");
+
+  if (module->launch == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: hc_native_launch is missing, the kernel was not built with inc_native.h.", filename);
+
+    hc_dlclose (module->lib);
+
+    module->lib = NULL;
+
+    return -1;
+  }
+
+  return 0;
+}
+
+int hc_nativeModuleUnload (MAYBE_UNUSED void *hashcat_ctx, native_module_t *module)
+{
+  if (module->lib == NULL) return 0;
+
+  hc_dlclose (module->lib);
+
+  module->lib    = NULL;
+  module->launch = NULL;
+
+  return 0;
+}
+
+int hc_nativeModuleGetFunction (void *hashcat_ctx, native_function_t *function, const native_module_t *module, const char *name)
+{
+  function->launch = module->launch;
+  function->kernel = (void *) hc_dlsym (module->lib, name);
+
+  if (function->kernel == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: kernel function not found in native module.", name);
+
+    return -1;
+  }
+
+  return 0;
+}
+
+int hc_nativeMemAlloc (void *hashcat_ctx, void **dptr, const size_t bytesize)
+{
+  *dptr = hc_alloc_aligned (NATIVE_MEM_ALIGN, MAX (bytesize, 1));
+
+  if (*dptr == NULL)
+  {
+    event_log_error (hashcat_ctx, "hc_nativeMemAlloc(): %s", MSG_ENOMEM);
+
+    return -1;
+  }
+
+  return 0;
+}
+
+int hc_nativeMemFreePtr (MAYBE_UNUSED void *hashcat_ctx, void **dptr)
+{
+  hc_free_aligned (dptr);
+
+  return 0;
+}
+
+int hc_nativeMemcpyDtoD (MAYBE_UNUSED void *hashcat_ctx, void *dst, const void *src, const size_t bytes)
+{
+  if (bytes) memmove (dst, src, bytes);
+
+  return 0;
+}
+
+int hc_nativeMemcpyDtoH (MAYBE_UNUSED void *hashcat_ctx, void *dst, const void *src, const size_t bytes)
+{
+  if (bytes) memcpy (dst, src, bytes);
+
+  return 0;
+}
+
+int hc_nativeMemcpyHtoD (MAYBE_UNUSED void *hashcat_ctx, void *dst, const void *src, const size_t bytes)
+{
+  if (bytes) memcpy (dst, src, bytes);
+
+  return 0;
+}
+
+int hc_nativeMemsetD8 (MAYBE_UNUSED void *hashcat_ctx, void *dst, const u8 value, const size_t N)
+{
+  if (N) memset (dst, value, N);
+
+  return 0;
+}
+
+int hc_nativeMemsetD32 (MAYBE_UNUSED void *hashcat_ctx, void *dst, const u32 value, const size_t N)
+{
+  u32 *ptr = (u32 *) dst;
+
+  for (size_t i = 0; i < N; i++) ptr[i] = value;
+
+  return 0;
+}
+
+/**
+ * thread pool, one per native device
+ * each launch is split into chunks of work-items which the workers pick up until none are left
+ */
+
+static HC_API_CALL void *native_pool_worker (void *p)
+{
+  native_worker_t *worker = (native_worker_t *) p;
+
+  native_pool_t *pool = worker->pool;
+
+  if (worker->numa_node != -1) numa_bind_thread (worker->numa_topology, worker->numa_node);
+
+  while (true)
+  {
+    hc_thread_sem_wait (worker->sem_work);
+
+    if (pool->shutdown == true) break;
+
+    while (true)
+    {
+      hc_thread_mutex_lock (pool->mux);
+
+      const u64 gid_start = pool->gid_pos;
+      const u64 gid_end   = MIN (gid_start + pool->gid_chunk, pool->gid_max);
+
+      pool->gid_pos = gid_end;
+
+      hc_thread_mutex_unlock (pool->mux);
+
+      if (gid_start >= gid_end) break;
+
+      pool->function->launch (pool->function->kernel, pool->args, gid_start, gid_end);
+    }
+
+    hc_thread_sem_post (pool->sem_done);
+  }
+
+  return NULL;
+}
+
+int hc_nativePoolCreate (void *hashcat_ctx, native_pool_t **pool, const int threads_cnt)
+{
+  backend_ctx_t *backend_ctx = ((hashcat_ctx_t *) hashcat_ctx)->backend_ctx;
+
+  native_pool_t *p = (native_pool_t *) hcmalloc (sizeof (native_pool_t));
+
+  p->workers_cnt = MAX (threads_cnt, 1);
+  p->workers     = (native_worker_t *) hccalloc (p->workers_cnt, sizeof (native_worker_t));
+
+  hc_thread_mutex_init (p->mux);
+  hc_thread_sem_init   (p->sem_done);
+
+  for (int i = 0; i < p->workers_cnt; i++)
+  {
+    native_worker_t *worker = &p->workers[i];
+
+    worker->pool = p;
+
+    // with several nodes, the workers are spread like the cpus they run on
+
+    worker->numa_topology = &backend_ctx->numa_topology;
+    worker->numa_node     = (backend_ctx->numa_enabled == true) ? numa_node_for_unit (&backend_ctx->numa_topology, i, p->workers_cnt) : -1;
+
+    hc_thread_sem_init (worker->sem_work);
+
+    hc_thread_create (worker->thread, native_pool_worker, worker);
+  }
+
+  *pool = p;
+
+  return 0;
+}
+
+void hc_nativePoolDestroy (MAYBE_UNUSED void *hashcat_ctx, native_pool_t **pool)
+{
+  native_pool_t *p = *pool;
+
+  if (p == NULL) return;
+
+  p->shutdown = true;
+
+  for (int i = 0; i < p->workers_cnt; i++)
+  {
+    hc_thread_sem_post (p->workers[i].sem_work);
+  }
+
+  for (int i = 0; i < p->workers_cnt; i++)
+  {
+    hc_thread_wait (1, &p->workers[i].thread);
+
+    hc_thread_sem_close (p->workers[i].sem_work);
+  }
+
+  hc_thread_sem_close    (p->sem_done);
+  hc_thread_mutex_delete (p->mux);
+
+  hcfree (p->workers);
+  hcfree (p);
+
+  *pool = NULL;
+}
+
+int hc_nativeSetKernelArg (void *hashcat_ctx, u64 *args, const u32 arg_index, const size_t arg_size, const void *arg_value)
+{
+  if (arg_index >= NATIVE_ARGS_MAX)
+  {
+    event_log_error (hashcat_ctx, "hc_nativeSetKernelArg(): argument index %u out of range.", arg_index);
+
+    return -1;
+  }
+
+  // a kernel which does not use a buffer may get a NULL for it
+
+  if (arg_value == NULL)
+  {
+    args[arg_index] = 0;
+
+    return 0;
+  }
+
+  switch (arg_size)
+  {
+    case 4:  args[arg_index] = *((const u32 *) arg_value); break;
+    case 8:  args[arg_index] = *((const u64 *) arg_value); break;
+    default:
+      event_log_error (hashcat_ctx, "hc_nativeSetKernelArg(): invalid argument size %u.", (u32) arg_size);
+      return -1;
+  }
+
+  return 0;
+}
+
+int hc_nativeLaunchKernel (MAYBE_UNUSED void *hashcat_ctx, native_pool_t *pool, const native_function_t *function, const u64 *args, const u64 gid_max)
+{
+  if (gid_max == 0) return 0;
+
+  const int workers_use = (pool->workers_active > 0) ? MIN (pool->workers_active, pool->workers_cnt) : pool->workers_cnt;
+
+  const u64 chunks = (u64) workers_use * NATIVE_CHUNKS;
+
+  pool->function  = function;
+  pool->args      = args;
+  pool->gid_pos   = 0;
+  pool->gid_max   = gid_max;
+  pool->gid_chunk = MAX (CEILDIV (gid_max, chunks), 1);
+
+  // don't wake up workers which would find nothing left
+
+  const int workers_cnt = (int) MIN ((u64) workers_use, CEILDIV (gid_max, pool->gid_chunk));
+
+  for (int i = 0; i < workers_cnt; i++)
+  {
+    hc_thread_sem_post (pool->workers[i].sem_work);
+  }
+
+  for (int i = 0; i < workers_cnt; i++)
+  {
+    hc_thread_sem_wait (pool->sem_done);
+  }
+
+  return 0;
+}
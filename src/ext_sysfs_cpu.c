@@ -9,25 +9,117 @@
 #include "shared.h"
 #include "event.h"
 #include "folder.h"
+#include "timer.h"
 #include "ext_sysfs_cpu.h"
 
+static bool sysfs_cpu_read_u64 (const char *path, u64 *val)
+{
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, path, "rb") == false) return false;
+
+  unsigned long long tmp = 0;
+
+  const int rc = hc_fscanf (&fp, "%llu", &tmp);
+
+  hc_fclose (&fp);
+
+  if (rc != 1) return false;
+
+  *val = (u64) tmp;
+
+  return true;
+}
+
+static void sysfs_cpu_rapl_init (SYSFS_CPU_PTR *sysfs_cpu)
+{
+  // the top-level zones are intel-rapl:N, AMD uses the same driver name
+
+  for (int i = 0; i < SYSFS_CPU_RAPL_ZONES_MAX; i++)
+  {
+    char *path = NULL;
+
+    hc_asprintf (&path, "%s/%s/intel-rapl:%d/name", sysfs_cpu->sysfs_root, SYSFS_POWERCAP, i);
+
+    HCFILE fp;
+
+    if (hc_fopen_raw (&fp, path, "rb") == false)
+    {
+      hcfree (path);
+
+      continue;
+    }
+
+    hcfree (path);
+
+    char buf[64] = { 0 };
+
+    const size_t line_len = fgetl (&fp, buf, sizeof (buf));
+
+    hc_fclose (&fp);
+
+    if (line_len == 0) continue;
+
+    if (strncmp (buf, RAPL_ZONE_PACKAGE, strlen (RAPL_ZONE_PACKAGE)) != 0) continue;
+
+    hm_sysfs_cpu_rapl_zone_t *zone = &sysfs_cpu->rapl_zones[sysfs_cpu->rapl_zones_cnt];
+
+    hc_asprintf (&path, "%s/%s/intel-rapl:%d/max_energy_range_uj", sysfs_cpu->sysfs_root, SYSFS_POWERCAP, i);
+
+    const bool has_range = sysfs_cpu_read_u64 (path, &zone->max_energy_range_uj);
+
+    hcfree (path);
+
+    hc_asprintf (&zone->energy_path, "%s/%s/intel-rapl:%d/energy_uj", sysfs_cpu->sysfs_root, SYSFS_POWERCAP, i);
+
+    // energy_uj is readable by root only on most distributions
+
+    if ((has_range == false) || (sysfs_cpu_read_u64 (zone->energy_path, &zone->energy_uj_prev) == false))
+    {
+      hcfree (zone->energy_path);
+
+      memset (zone, 0, sizeof (hm_sysfs_cpu_rapl_zone_t));
+
+      continue;
+    }
+
+    sysfs_cpu->rapl_zones_cnt++;
+  }
+}
+
 bool sysfs_cpu_init (void *hashcat_ctx)
 {
-  hwmon_ctx_t *hwmon_ctx = ((hashcat_ctx_t *) hashcat_ctx)->hwmon_ctx;
+  hwmon_ctx_t    *hwmon_ctx    = ((hashcat_ctx_t *) hashcat_ctx)->hwmon_ctx;
+  user_options_t *user_options = ((hashcat_ctx_t *) hashcat_ctx)->user_options;
 
   SYSFS_CPU_PTR *sysfs_cpu = (SYSFS_CPU_PTR *) hwmon_ctx->hm_sysfs_cpu;
 
   memset (sysfs_cpu, 0, sizeof (SYSFS_CPU_PTR));
 
+  sysfs_cpu->sysfs_root = hcstrdup ((user_options->hwmon_sysfs_root != NULL) ? user_options->hwmon_sysfs_root : SYSFS_ROOT);
+
   char *path;
 
-  hc_asprintf (&path, "%s/hwmon0", SYSFS_HWMON);
+  hc_asprintf (&path, "%s/%s/hwmon0", sysfs_cpu->sysfs_root, SYSFS_HWMON);
 
   const bool r = hc_path_read (path);
 
   hcfree (path);
 
-  return r;
+  sysfs_cpu_rapl_init (sysfs_cpu);
+
+  hc_timer_set (&sysfs_cpu->power_timer);
+
+  sysfs_cpu->power_mw = -1;
+
+  if ((r == false) && (sysfs_cpu->rapl_zones_cnt == 0))
+  {
+    hcfree (sysfs_cpu->sysfs_root);
+
+    return false;
+  }
+
+  return true;
 }
 
 void sysfs_cpu_close (void *hashcat_ctx)
@@ -38,12 +130,23 @@ void sysfs_cpu_close (void *hashcat_ctx)
 
   if (sysfs_cpu)
   {
+    for (int i = 0; i < sysfs_cpu->rapl_zones_cnt; i++)
+    {
+      hcfree (sysfs_cpu->rapl_zones[i].energy_path);
+    }
+
+    hcfree (sysfs_cpu->sysfs_root);
+
     hcfree (sysfs_cpu);
   }
 }
 
-char *hm_SYSFS_CPU_get_syspath_hwmon (void)
+char *hm_SYSFS_CPU_get_syspath_hwmon (void *hashcat_ctx)
 {
+  hwmon_ctx_t *hwmon_ctx = ((hashcat_ctx_t *) hashcat_ctx)->hwmon_ctx;
+
+  SYSFS_CPU_PTR *sysfs_cpu = (SYSFS_CPU_PTR *) hwmon_ctx->hm_sysfs_cpu;
+
   char *found = NULL;
 
   int best = 4;
@@ -54,7 +157,7 @@ char *hm_SYSFS_CPU_get_syspath_hwmon (void)
   {
     char *path = NULL;
 
-    hc_asprintf (&path, "%s/hwmon%d/name", SYSFS_HWMON, i);
+    hc_asprintf (&path, "%s/%s/hwmon%d/name", sysfs_cpu->sysfs_root, SYSFS_HWMON, i);
 
     HCFILE fp;
 
@@ -88,7 +191,7 @@ char *hm_SYSFS_CPU_get_syspath_hwmon (void)
 
       best = tmp_best;
 
-      hc_asprintf (&found, "%s/hwmon%d", SYSFS_HWMON, i);
+      hc_asprintf (&found, "%s/%s/hwmon%d", sysfs_cpu->sysfs_root, SYSFS_HWMON, i);
 
       if (best == 0) break;
     }
@@ -99,7 +202,7 @@ char *hm_SYSFS_CPU_get_syspath_hwmon (void)
 
 int hm_SYSFS_CPU_get_temperature_current (void *hashcat_ctx, int *val)
 {
-  char *syspath = hm_SYSFS_CPU_get_syspath_hwmon ();
+  char *syspath = hm_SYSFS_CPU_get_syspath_hwmon (hashcat_ctx);
 
   if (syspath == NULL) return -1;
 
@@ -219,3 +322,73 @@ int hm_SYSFS_CPU_get_utilization_current (void *hashcat_ctx, int *val)
 
   return false;
 }
+
+int hm_SYSFS_CPU_get_energy_current (void *hashcat_ctx, u64 *val)
+{
+  hwmon_ctx_t *hwmon_ctx = ((hashcat_ctx_t *) hashcat_ctx)->hwmon_ctx;
+
+  SYSFS_CPU_PTR *sysfs_cpu = (SYSFS_CPU_PTR *) hwmon_ctx->hm_sysfs_cpu;
+
+  if (sysfs_cpu->rapl_zones_cnt == 0) return -1;
+
+  for (int i = 0; i < sysfs_cpu->rapl_zones_cnt; i++)
+  {
+    hm_sysfs_cpu_rapl_zone_t *zone = &sysfs_cpu->rapl_zones[i];
+
+    u64 energy_uj = 0;
+
+    if (sysfs_cpu_read_u64 (zone->energy_path, &energy_uj) == false)
+    {
+      event_log_error (hashcat_ctx, "%s: unexpected data.", zone->energy_path);
+
+      return -1;
+    }
+
+    // the counter is only 32 bit wide on some cpus, so it wraps every few minutes under load
+
+    if (energy_uj >= zone->energy_uj_prev)
+    {
+      sysfs_cpu->energy_uj += energy_uj - zone->energy_uj_prev;
+    }
+    else
+    {
+      sysfs_cpu->energy_uj += (zone->max_energy_range_uj - zone->energy_uj_prev) + energy_uj;
+    }
+
+    zone->energy_uj_prev = energy_uj;
+  }
+
+  *val = sysfs_cpu->energy_uj;
+
+  return 0;
+}
+
+int hm_SYSFS_CPU_get_power_current (void *hashcat_ctx, int64_t *val)
+{
+  hwmon_ctx_t *hwmon_ctx = ((hashcat_ctx_t *) hashcat_ctx)->hwmon_ctx;
+
+  SYSFS_CPU_PTR *sysfs_cpu = (SYSFS_CPU_PTR *) hwmon_ctx->hm_sysfs_cpu;
+
+  u64 energy_uj = 0;
+
+  if (hm_SYSFS_CPU_get_energy_current (hashcat_ctx, &energy_uj) == -1) return -1;
+
+  const double msec = hc_timer_get (sysfs_cpu->power_timer);
+
+  // the counters update about once per millisecond, too short windows give noise, not power
+
+  if ((msec >= 100) || (sysfs_cpu->power_mw == -1))
+  {
+    // uJ per ms is mW
+
+    sysfs_cpu->power_mw = (msec > 0) ? (int64_t) ((double) (energy_uj - sysfs_cpu->power_energy_uj_prev) / msec) : 0;
+
+    sysfs_cpu->power_energy_uj_prev = energy_uj;
+
+    hc_timer_set (&sysfs_cpu->power_timer);
+  }
+
+  *val = sysfs_cpu->power_mw;
+
+  return 0;
+}
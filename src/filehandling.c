@@ -9,6 +9,7 @@
 #include "memory.h"
 #include "shared.h"
 #include "filehandling.h"
+#include "blockfile.h"
 
 #include <Alloc.h>
 #include <7zCrc.h>
@@ -72,6 +73,7 @@ bool hc_fopen (HCFILE *fp, const char *path, const char *mode)
   fp->gfp      = NULL;
   fp->ufp      = NULL;
   fp->xfp      = NULL;
+  fp->bfp      = NULL;
   fp->bom_size = 0;
   fp->path     = NULL;
   fp->mode     = NULL;
@@ -118,6 +120,7 @@ bool hc_fopen (HCFILE *fp, const char *path, const char *mode)
   bool is_gzip = false;
   bool is_zip  = false;
   bool is_xz   = false;
+  bool is_zstd = false;
   bool is_fifo = hc_path_is_fifo (path);
 
   if (is_fifo == false)
@@ -133,10 +136,11 @@ bool hc_fopen (HCFILE *fp, const char *path, const char *mode)
         if (check[0] == 0x1f && check[1] == 0x8b && check[2] == 0x08)                     is_gzip = true;
         if (check[0] == 0x50 && check[1] == 0x4b && check[2] == 0x03 && check[3] == 0x04) is_zip  = true;
         if (memcmp (check, XZ_SIG, XZ_SIG_SIZE) == 0)                                     is_xz   = true;
+        if (check[0] == 0x28 && check[1] == 0xb5 && check[2] == 0x2f && check[3] == 0xfd) is_zstd = true;
 
         // compressed files with BOM will be undetected!
 
-        if (is_gzip == false && is_zip == false && is_xz == false)
+        if (is_gzip == false && is_zip == false && is_xz == false && is_zstd == false)
         {
           fp->bom_size = hc_string_bom_size (check);
         }
@@ -157,7 +161,35 @@ bool hc_fopen (HCFILE *fp, const char *path, const char *mode)
 
   if (fp->fd == -1) return false;
 
-  if (is_gzip)
+  // block based compressed files are decoded by a pool of threads, otherwise use the single threaded readers below
+
+  if ((is_gzip || is_xz || is_zstd) && (strncmp (mode, "r", 1) == 0))
+  {
+    int kind = BLOCKFILE_KIND_ZSTD;
+
+    if (is_gzip) kind = BLOCKFILE_KIND_GZIP;
+    if (is_xz)   kind = BLOCKFILE_KIND_XZ;
+
+    fp->bfp = blockfile_open (path, kind);
+  }
+
+  if (fp->bfp)
+  {
+    // decoded by the blockfile workers, fd stays open for hc_fstat ()
+  }
+  else if (is_zstd)
+  {
+    const int errno_tmp = errno;
+
+    close (fp->fd);
+
+    fp->fd = -1;
+
+    errno = errno_tmp;
+
+    return false;
+  }
+  else if (is_gzip)
   {
     if ((fp->gfp = gzdopen (fp->fd, mode)) == NULL) return false;
 
@@ -303,6 +335,7 @@ bool hc_fopen_raw (HCFILE *fp, const char *path, const char *mode)
   fp->gfp      = NULL;
   fp->ufp      = NULL;
   fp->xfp      = NULL;
+  fp->bfp      = NULL;
   fp->bom_size = 0;
   fp->path     = NULL;
   fp->mode     = NULL;
@@ -499,6 +532,14 @@ size_t hc_fread (void *ptr, size_t size, size_t nmemb, HCFILE *fp)
       xfp->outProcessed += outLeft;
     } while (outPos < outLen);
   }
+  else if (fp->bfp)
+  {
+    const size_t bytes = blockfile_read (fp->bfp, ptr, size * nmemb);
+
+    if (bytes == (size_t) -1) return bytes;
+
+    n = bytes / size;
+  }
 
   return n;
 }
@@ -601,12 +642,47 @@ int hc_fseek (HCFILE *fp, off_t offset, int whence)
       hc_rewind(fp);
       r = 0;
     }
+    else if (whence == SEEK_SET && offset > 0)
+    {
+      /* decode and discard, single block files have no seek points */
+      xzfile_t *xfp = fp->xfp;
+
+      if ((Int64) offset < xfp->outProcessed) hc_rewind (fp);
+
+      char discard[BUFSIZ];
+
+      r = 0;
+
+      while (xfp->outProcessed < (Int64) offset)
+      {
+        const size_t left = (size_t) MIN ((Int64) sizeof (discard), (Int64) offset - xfp->outProcessed);
+
+        if (hc_fread (discard, 1, left, fp) != left)
+        {
+          r = -1;
+
+          break;
+        }
+      }
+    }
     else
     {
       /* Arbitrary seeking not supported for compressed XZ files */
       r = -1;
     }
   }
+  else if (fp->bfp)
+  {
+    u64 base = 0;
+
+    if (whence == SEEK_CUR) base = blockfile_tell (fp->bfp);
+    if (whence == SEEK_END) base = blockfile_size (fp->bfp);
+
+    if (((i64) base + (i64) offset) >= 0)
+    {
+      r = blockfile_seek (fp->bfp, base + offset);
+    }
+  }
 
   return r;
 }
@@ -660,6 +736,10 @@ void hc_rewind (HCFILE *fp)
     xfp->inPos = inLen;
     xfp->inProcessed = inLen;
   }
+  else if (fp->bfp)
+  {
+    blockfile_rewind (fp->bfp);
+  }
 }
 
 int hc_fstat (HCFILE *fp, struct stat *buf)
@@ -697,6 +777,16 @@ int hc_fstat (HCFILE *fp, struct stat *buf)
       buf->st_size = (off_t) xfp->outSize;
     }
   }
+  else if (fp->bfp)
+  {
+    /* zero if the uncompressed size is unknown */
+    const u64 size = blockfile_size (fp->bfp);
+
+    if (size > 0)
+    {
+      buf->st_size = (off_t) size;
+    }
+  }
 
   return r;
 }
@@ -725,6 +815,11 @@ off_t hc_ftell (HCFILE *fp)
     const xzfile_t *xfp = fp->xfp;
     n = (off_t) xfp->outProcessed;
   }
+  else if (fp->bfp)
+  {
+    /* uncompressed bytes */
+    n = (off_t) blockfile_tell (fp->bfp);
+  }
 
   return n;
 }
@@ -794,6 +889,10 @@ int hc_fgetc (HCFILE *fp)
     xfp->outProcessed++;
     r = (int) out;
   }
+  else if (fp->bfp)
+  {
+    r = blockfile_getc (fp->bfp);
+  }
 
   return r;
 }
@@ -857,6 +956,25 @@ char *hc_fgets (char *buf, int len, HCFILE *fp)
     /* always NULL terminate */
     *outBuf = 0;
   }
+  else if (fp->bfp)
+  {
+    int pos = 0;
+
+    while (pos < (len - 1))
+    {
+      const int c = blockfile_getc (fp->bfp);
+
+      if (c == EOF) break;
+
+      buf[pos++] = (char) c;
+
+      if (c == '\n') break;
+    }
+
+    buf[pos] = 0;
+
+    if (pos > 0) r = buf;
+  }
 
   return r;
 }
@@ -944,6 +1062,10 @@ int hc_feof (HCFILE *fp)
     const xzfile_t *xfp = fp->xfp;
     r = (xfp->inEof && xfp->inPos == xfp->inLen);
   }
+  else if (fp->bfp)
+  {
+    r = (blockfile_eof (fp->bfp) == true) ? 1 : 0;
+  }
 
   return r;
 }
@@ -1009,17 +1131,54 @@ void hc_fclose (HCFILE *fp)
     hcfree (xfp);
     close (fp->fd);
   }
+  else if (fp->bfp)
+  {
+    blockfile_close (fp->bfp);
+
+    close (fp->fd);
+  }
 
   fp->fd = -1;
   fp->pfp = NULL;
   fp->gfp = NULL;
   fp->ufp = NULL;
   fp->xfp = NULL;
+  fp->bfp = NULL;
 
   fp->path = NULL;
   fp->mode = NULL;
 }
 
+void hc_fmark (HCFILE *fp, const u64 sig, const u64 words)
+{
+  if (fp == NULL) return;
+
+  /* remember that the word at the current uncompressed offset has index words */
+  if (fp->bfp)
+  {
+    blockfile_mark (fp->bfp, sig, words, blockfile_tell (fp->bfp));
+  }
+}
+
+bool hc_fseek_mark (HCFILE *fp, const u64 sig, const u64 words_cur, const u64 words_off, u64 *mark_words)
+{
+  if (fp == NULL) return false;
+
+  /* jump to the closest mark after words_cur but not beyond words_off */
+  if (fp->bfp)
+  {
+    u64 mark_offset = 0;
+
+    if (blockfile_find_mark (fp->bfp, sig, words_off, mark_words, &mark_offset) == false) return false;
+
+    if (*mark_words <= words_cur) return false;
+
+    return (blockfile_seek (fp->bfp, mark_offset) == 0);
+  }
+
+  return false;
+}
+
 size_t fgetl (HCFILE *fp, char *line_buf, const size_t line_sz)
 {
   int c;
@@ -584,6 +584,18 @@ int folder_config_init (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED const char *ins
 
   hcfree (kernels_folder);
 
+  /**
+   * same for the decoded hcstat2 table cache
+   */
+
+  char *hcstat2_folder = NULL;
+
+  hc_asprintf (&hcstat2_folder, "%s/hcstat2", cache_dir);
+
+  hc_mkdir (hcstat2_folder, 0700);
+
+  hcfree (hcstat2_folder);
+
   /**
    * store for later use
    */
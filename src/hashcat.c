@@ -20,20 +20,25 @@
 #include "autotune.h"
 #include "benchmark.h"
 #include "bitmap.h"
+#include "blockfile.h"
 #include "bridges.h"
 #include "combinator.h"
 #include "cpt.h"
 #include "debugfile.h"
+#include "dedup.h"
 #include "dictstat.h"
 #include "dispatch.h"
 #include "event.h"
 #include "hashes.h"
 #include "hwmon.h"
 #include "hlfmt.h"
+#include "identify.h"
 #include "induct.h"
 #include "interface.h"
 #include "logfile.h"
 #include "loopback.h"
+#include "manifest.h"
+#include "metrics.h"
 #include "monitor.h"
 #include "mpsp.h"
 #include "backend.h"
@@ -41,8 +46,10 @@
 #include "outfile.h"
 #include "pidfile.h"
 #include "potfile.h"
+#include "resident.h"
 #include "restore.h"
 #include "selftest.h"
+#include "startup.h"
 #include "status.h"
 #include "generic.h"
 #include "straight.h"
@@ -142,6 +149,12 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
     return 0;
   }
 
+  /**
+   * Parse the right-hand wordlist of combinator based attacks once
+   */
+
+  if (combinator_ctx_update_loop (hashcat_ctx) == -1) return -1;
+
   // restore stuff
 
   if (status_ctx->words_off > status_ctx->words_base)
@@ -155,9 +168,16 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
   {
     const u64 progress_restored = 1 * amplifier_cnt;
 
-    for (u32 i = 0; i < status_ctx->words_off; i++)
+    const u32 association_width = user_options->association_width;
+
+    for (u32 i = 0; i < hashes->salts_cnt; i++)
     {
-      status_ctx->words_progress_restored[i] = progress_restored;
+      status_ctx->words_progress_restored[i] = 0;
+    }
+
+    for (u64 i = 0; i < status_ctx->words_off; i++)
+    {
+      status_ctx->words_progress_restored[i / association_width] += progress_restored;
     }
   }
   else
@@ -200,6 +220,8 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   EVENT (EVENT_AUTOTUNE_STARTING);
 
+  const double autotune_start = startup_stage_begin (hashcat_ctx);
+
   status_ctx->devices_status = STATUS_AUTOTUNE;
 
   for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
@@ -214,6 +236,8 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   hc_thread_wait (backend_ctx->backend_devices_cnt, c_threads);
 
+  startup_stage_end (hashcat_ctx, "autotune", autotune_start);
+
   // check for any autotune failures
   // by default, skipping device on error
   // using --force, accel/loops/threads min values are used instead of skipping
@@ -307,18 +331,36 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
     status_ctx->bypass_digests_done_new = hashcat_ctx->hashes->digests_done_new;
   }
 
+  /**
+   * the first cracker threads are about to start, log the startup stages of this hash-mode
+   */
+
+  startup_finish (hashcat_ctx);
+
   /**
    * Prepare cracking stats
    */
 
   hc_timer_set (&status_ctx->timer_running);
 
+  status_ctx->energy_running = status_get_energy (hashcat_ctx);
+
   time_t runtime_start;
 
   time (&runtime_start);
 
   status_ctx->runtime_start = runtime_start;
 
+  /**
+   * create result thread, it writes cracked hashes to outfile/potfile while the cracker threads keep running
+   */
+
+  cracked_queue_init (hashcat_ctx);
+
+  hc_thread_t cracked_thread;
+
+  hc_thread_create (cracked_thread, thread_cracked, hashcat_ctx);
+
   /**
    * create cracker threads
    */
@@ -352,6 +394,20 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   hcfree (threads_param);
 
+  // flush all pending results before anything looks at the potfile or the outfile
+
+  hc_thread_mutex_lock (hashes->mux_cracked);
+
+  hashes->cracked_shutdown = true;
+
+  hc_thread_mutex_unlock (hashes->mux_cracked);
+
+  hc_thread_sem_post (hashes->sem_cracked);
+
+  hc_thread_wait (1, &cracked_thread);
+
+  cracked_queue_destroy (hashcat_ctx);
+
   if ((status_ctx->devices_status == STATUS_RUNNING) && (status_ctx->checkpoint_shutdown == true))
   {
     myabort_checkpoint (hashcat_ctx);
@@ -514,11 +570,209 @@ static int inner1_loop (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
+/**
+ * startup tasks, outer_loop() runs them on their own threads, see startup.c
+ */
+
+static int startup_task_hashes (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t *hashconfig   = hashcat_ctx->hashconfig;
+  hashes_t           *hashes       = hashcat_ctx->hashes;
+  const status_ctx_t *status_ctx   = hashcat_ctx->status_ctx;
+  user_options_t     *user_options = hashcat_ctx->user_options;
+
+  /**
+   * generate hashlist filename for later use
+   */
+
+  if (hashes_init_filename (hashcat_ctx) == -1) return -1;
+
+  /**
+   * a daemon job reuses the hashlist of its previous job if the hashfile did not change, see resident.c
+   */
+
+  if (resident_hashes_load (hashcat_ctx) == false)
+  {
+    /**
+     * load hashes, stage 1
+     */
+
+    if (hashes_init_stage1 (hashcat_ctx) == -1) return -1;
+
+    if ((user_options->keyspace == false) && (user_options->stdout_flag == false))
+    {
+      if (hashes->hashes_cnt == 0)
+      {
+        event_log_error (hashcat_ctx, "No hashes loaded.");
+
+        return -1;
+      }
+    }
+
+    /**
+     * load hashes, stage 2, remove duplicates, build base structure
+     */
+
+    hashes->hashes_cnt_orig = hashes->hashes_cnt;
+
+    if (hashes_init_stage2 (hashcat_ctx) == -1) return -1;
+
+    resident_hashes_store (hashcat_ctx);
+  }
+
+  /**
+   * potfile removes
+   */
+
+  if (user_options->potfile == true)
+  {
+    EVENT (EVENT_POTFILE_REMOVE_PARSE_PRE);
+
+    if (user_options->loopback == true)
+    {
+      loopback_write_open (hashcat_ctx);
+    }
+
+    potfile_remove_parse (hashcat_ctx);
+
+    if (user_options->loopback == true)
+    {
+      loopback_write_close (hashcat_ctx);
+    }
+
+    EVENT (EVENT_POTFILE_REMOVE_PARSE_POST);
+  }
+
+  /**
+   * zero hash removes
+   */
+
+  if (hashes_init_zerohash (hashcat_ctx) == -1) return -1;
+
+  /**
+   * load hashes, stage 3, update cracked results from potfile
+   */
+
+  if (hashes_init_stage3 (hashcat_ctx) == -1) return -1;
+
+  /**
+   * outer_loop () stops after this run if there is nothing left to attack, the kernels built meanwhile are not needed
+   */
+
+  if ((user_options->show == true)
+   || (user_options->left == true)
+   || (hashes->digests_cnt < hashconfig->hashes_count_min)
+   || (hashes->digests_cnt > hashconfig->hashes_count_max)
+   || (status_ctx->devices_status == STATUS_CRACKED))
+  {
+    startup_cancel (hashcat_ctx);
+  }
+
+  return 0;
+}
+
+static int startup_task_kernels (hashcat_ctx_t *hashcat_ctx)
+{
+  // a failed build is handled by backend_session_begin(), it knows what to do with it in benchmark mode
+
+  backend_session_build (hashcat_ctx);
+
+  return 0;
+}
+
+static int startup_task_hashes_post (hashcat_ctx_t *hashcat_ctx)
+{
+  /**
+   * load hashes, stage 4, automatic Optimizers
+   */
+
+  if (hashes_init_stage4 (hashcat_ctx) == -1) return -1;
+
+  /**
+   * load hashes, selftest
+   */
+
+  if (hashes_init_selftest (hashcat_ctx) == -1) return -1;
+
+  /**
+   * load hashes, post automatisation
+   */
+
+  if (hashes_init_stage5 (hashcat_ctx) == -1) return -1;
+
+  /**
+   * load hashes, benchmark
+   */
+
+  if (hashes_init_benchmark (hashcat_ctx) == -1) return -1;
+
+  /**
+   * Done loading hashes, log results
+   */
+
+  hashes_logger (hashcat_ctx);
+
+  return 0;
+}
+
+static int startup_task_bitmaps (hashcat_ctx_t *hashcat_ctx)
+{
+  EVENT (EVENT_BITMAP_INIT_PRE);
+
+  if (bitmap_ctx_init (hashcat_ctx) == -1) return -1;
+
+  EVENT (EVENT_BITMAP_INIT_POST);
+
+  return 0;
+}
+
+static int startup_task_attack (hashcat_ctx_t *hashcat_ctx)
+{
+  /**
+   * cracks-per-time allocate buffer
+   */
+
+  cpt_ctx_init (hashcat_ctx);
+
+  /**
+   * Wordlist allocate buffer
+   */
+
+  if (wl_data_init (hashcat_ctx) == -1) return -1;
+
+  /**
+   * straight mode init
+   */
+
+  if (straight_ctx_init (hashcat_ctx) == -1) return -1;
+
+  /**
+   * combinator mode init
+   */
+
+  if (combinator_ctx_init (hashcat_ctx) == -1) return -1;
+
+  /**
+   * charsets : keep them together for more easy maintenance, needs OPTI_TYPE_SINGLE_HASH from stage 4
+   */
+
+  if (mask_ctx_init (hashcat_ctx) == -1) return -1;
+
+  /**
+   * generic mode init
+   */
+
+  if (generic_ctx_init (hashcat_ctx) == -1) return -1;
+
+  return 0;
+}
+
 // outer_loop iterates through hash_modes (in benchmark mode)
 // also initializes stuff that depend on hash mode
 
 static int outer_loop (hashcat_ctx_t *hashcat_ctx)
 {
+  bridge_ctx_t         *bridge_ctx          = hashcat_ctx->bridge_ctx;
   hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
   hashes_t             *hashes              = hashcat_ctx->hashes;
   mask_ctx_t           *mask_ctx            = hashcat_ctx->mask_ctx;
@@ -539,6 +793,12 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
   status_ctx->run_thread_level1 = true;
   status_ctx->run_thread_level2 = true;
 
+  startup_ctx_reset (hashcat_ctx);
+
+  // kernels of a previous hash-mode or job which failed before its session began
+
+  if (backend_ctx->session_built == true) backend_session_destroy (hashcat_ctx);
+
   /**
    * setup variables and buffers depending on hash_mode
    */
@@ -595,69 +855,22 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
   }
 
   /**
-   * generate hashlist filename for later use
+   * the hashes are loaded while the kernels are built, see the startup tasks above
+   * the build only waits for the hashes if a module hook it calls needs them
    */
 
-  if (hashes_init_filename (hashcat_ctx) == -1) return -1;
+  const bool build_async = (backend_ctx->enabled == true) && (bridge_ctx->enabled == false);
 
-  /**
-   * load hashes, stage 1
-   */
+  const bool build_needs_hashes = (build_async == true) && (backend_session_build_needs_hashes (hashcat_ctx) == true);
 
-  if (hashes_init_stage1 (hashcat_ctx) == -1) return -1;
+  startup_task_add (hashcat_ctx, "hashes", startup_task_hashes, 0);
 
-  if ((user_options->keyspace == false) && (user_options->stdout_flag == false))
+  if ((build_async == true) && (build_needs_hashes == false))
   {
-    if (hashes->hashes_cnt == 0)
-    {
-      event_log_error (hashcat_ctx, "No hashes loaded.");
-
-      return -1;
-    }
+    startup_task_add (hashcat_ctx, "kernels", startup_task_kernels, 0);
   }
 
-  /**
-   * load hashes, stage 2, remove duplicates, build base structure
-   */
-
-  hashes->hashes_cnt_orig = hashes->hashes_cnt;
-
-  if (hashes_init_stage2 (hashcat_ctx) == -1) return -1;
-
-  /**
-   * potfile removes
-   */
-
-  if (user_options->potfile == true)
-  {
-    EVENT (EVENT_POTFILE_REMOVE_PARSE_PRE);
-
-    if (user_options->loopback == true)
-    {
-      loopback_write_open (hashcat_ctx);
-    }
-
-    potfile_remove_parse (hashcat_ctx);
-
-    if (user_options->loopback == true)
-    {
-      loopback_write_close (hashcat_ctx);
-    }
-
-    EVENT (EVENT_POTFILE_REMOVE_PARSE_POST);
-  }
-
-  /**
-   * zero hash removes
-   */
-
-  if (hashes_init_zerohash (hashcat_ctx) == -1) return -1;
-
-  /**
-   * load hashes, stage 3, update cracked results from potfile
-   */
-
-  if (hashes_init_stage3 (hashcat_ctx) == -1) return -1;
+  if (startup_run (hashcat_ctx) == -1) return -1;
 
   /**
    * potfile show/left handling
@@ -725,84 +938,30 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
 
     EVENT (EVENT_POTFILE_ALL_CRACKED);
 
-    return 0;
-  }
-
-  /**
-   * load hashes, stage 4, automatic Optimizers
-   */
-
-  if (hashes_init_stage4 (hashcat_ctx) == -1) return -1;
-
-  /**
-   * load hashes, selftest
-   */
-
-  if (hashes_init_selftest (hashcat_ctx) == -1) return -1;
-
-  /**
-   * load hashes, post automatisation
-   */
+    // the next outer loop or daemon job loads its own hash-mode, so release this one
 
-  if (hashes_init_stage5 (hashcat_ctx) == -1) return -1;
-
-  /**
-   * load hashes, benchmark
-   */
-
-  if (hashes_init_benchmark (hashcat_ctx) == -1) return -1;
-
-  /**
-   * Done loading hashes, log results
-   */
-
-  hashes_logger (hashcat_ctx);
-
-  /**
-   * bitmaps
-   */
-
-  EVENT (EVENT_BITMAP_INIT_PRE);
-
-  if (bitmap_ctx_init (hashcat_ctx) == -1) return -1;
-
-  EVENT (EVENT_BITMAP_INIT_POST);
-
-  /**
-   * cracks-per-time allocate buffer
-   */
-
-  cpt_ctx_init (hashcat_ctx);
-
-  /**
-   * Wordlist allocate buffer
-   */
-
-  if (wl_data_init (hashcat_ctx) == -1) return -1;
-
-  /**
-   * straight mode init
-   */
+    backend_session_destroy (hashcat_ctx);
+    hashconfig_destroy      (hashcat_ctx);
+    hashes_destroy          (hashcat_ctx);
 
-  if (straight_ctx_init (hashcat_ctx) == -1) return -1;
+    return 0;
+  }
 
   /**
-   * combinator mode init
+   * the rest of the hash-mode setup, bitmaps and attack buffers only need the final hashlist
    */
 
-  if (combinator_ctx_init (hashcat_ctx) == -1) return -1;
+  const int task_hashes_post = startup_task_add (hashcat_ctx, "hashes_post", startup_task_hashes_post, 0);
 
-  /**
-   * charsets : keep them together for more easy maintenance
-   */
-
-  if (mask_ctx_init (hashcat_ctx) == -1) return -1;
+  startup_task_add (hashcat_ctx, "bitmaps", startup_task_bitmaps, 1u << task_hashes_post);
+  startup_task_add (hashcat_ctx, "attack",  startup_task_attack,  1u << task_hashes_post);
 
-  /**
-   * generic mode init
-   */
+  if ((build_async == true) && (build_needs_hashes == true))
+  {
+    startup_task_add (hashcat_ctx, "kernels", startup_task_kernels, 1u << task_hashes_post);
+  }
 
-  if (generic_ctx_init (hashcat_ctx) == -1) return -1;
+  if (startup_run (hashcat_ctx) == -1) return -1;
 
   /**
    * prevent the user from using --skip/--limit together with maskfile and/or multiple word lists
@@ -882,6 +1041,8 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
 
   EVENT (EVENT_BACKEND_SESSION_PRE);
 
+  const double backend_session_start = startup_stage_begin (hashcat_ctx);
+
   if (backend_session_begin (hashcat_ctx) == -1)
   {
     if (user_options->benchmark == true)
@@ -918,6 +1079,8 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
+  startup_stage_end (hashcat_ctx, "backend_session", backend_session_start);
+
   EVENT (EVENT_BACKEND_SESSION_POST);
 
   /**
@@ -928,6 +1091,8 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
   {
     EVENT (EVENT_SELFTEST_STARTING);
 
+    const double selftest_start = startup_stage_begin (hashcat_ctx);
+
     thread_param_t *threads_param = (thread_param_t *) hccalloc (backend_ctx->backend_devices_cnt, sizeof (thread_param_t));
 
     hc_thread_t *selftest_threads = (hc_thread_t *) hccalloc (backend_ctx->backend_devices_cnt, sizeof (hc_thread_t));
@@ -946,6 +1111,8 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
 
     hc_thread_wait (backend_ctx->backend_devices_cnt, selftest_threads);
 
+    startup_stage_end (hashcat_ctx, "selftest", selftest_start);
+
     hcfree (threads_param);
 
     hcfree (selftest_threads);
@@ -1115,6 +1282,7 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->combinator_ctx     = (combinator_ctx_t *)      hcmalloc (sizeof (combinator_ctx_t));
   hashcat_ctx->cpt_ctx            = (cpt_ctx_t *)             hcmalloc (sizeof (cpt_ctx_t));
   hashcat_ctx->debugfile_ctx      = (debugfile_ctx_t *)       hcmalloc (sizeof (debugfile_ctx_t));
+  hashcat_ctx->dedup_ctx          = (dedup_ctx_t *)           hcmalloc (sizeof (dedup_ctx_t));
   hashcat_ctx->dictstat_ctx       = (dictstat_ctx_t *)        hcmalloc (sizeof (dictstat_ctx_t));
   hashcat_ctx->event_ctx          = (event_ctx_t *)           hcmalloc (sizeof (event_ctx_t));
   hashcat_ctx->folder_config      = (folder_config_t *)       hcmalloc (sizeof (folder_config_t));
@@ -1127,13 +1295,16 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->logfile_ctx        = (logfile_ctx_t *)         hcmalloc (sizeof (logfile_ctx_t));
   hashcat_ctx->loopback_ctx       = (loopback_ctx_t *)        hcmalloc (sizeof (loopback_ctx_t));
   hashcat_ctx->mask_ctx           = (mask_ctx_t *)            hcmalloc (sizeof (mask_ctx_t));
+  hashcat_ctx->metrics_ctx        = (metrics_ctx_t *)         hcmalloc (sizeof (metrics_ctx_t));
   hashcat_ctx->module_ctx         = (module_ctx_t *)          hcmalloc (sizeof (module_ctx_t));
   hashcat_ctx->backend_ctx        = (backend_ctx_t *)         hcmalloc (sizeof (backend_ctx_t));
   hashcat_ctx->outcheck_ctx       = (outcheck_ctx_t *)        hcmalloc (sizeof (outcheck_ctx_t));
   hashcat_ctx->outfile_ctx        = (outfile_ctx_t *)         hcmalloc (sizeof (outfile_ctx_t));
   hashcat_ctx->pidfile_ctx        = (pidfile_ctx_t *)         hcmalloc (sizeof (pidfile_ctx_t));
   hashcat_ctx->potfile_ctx        = (potfile_ctx_t *)         hcmalloc (sizeof (potfile_ctx_t));
+  hashcat_ctx->resident_ctx       = (resident_ctx_t *)        hcmalloc (sizeof (resident_ctx_t));
   hashcat_ctx->restore_ctx        = (restore_ctx_t *)         hcmalloc (sizeof (restore_ctx_t));
+  hashcat_ctx->startup_ctx        = (startup_ctx_t *)         hcmalloc (sizeof (startup_ctx_t));
   hashcat_ctx->status_ctx         = (status_ctx_t *)          hcmalloc (sizeof (status_ctx_t));
   hashcat_ctx->straight_ctx       = (straight_ctx_t *)        hcmalloc (sizeof (straight_ctx_t));
   hashcat_ctx->tuning_db          = (tuning_db_t *)           hcmalloc (sizeof (tuning_db_t));
@@ -1141,6 +1312,10 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->user_options       = (user_options_t *)        hcmalloc (sizeof (user_options_t));
   hashcat_ctx->wl_data            = (wl_data_t *)             hcmalloc (sizeof (wl_data_t));
 
+  // decoder tables and libzstd for compressed wordlists, loaded before any thread opens one
+
+  blockfile_init ();
+
   return 0;
 }
 
@@ -1152,6 +1327,7 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->combinator_ctx);
   hcfree (hashcat_ctx->cpt_ctx);
   hcfree (hashcat_ctx->debugfile_ctx);
+  hcfree (hashcat_ctx->dedup_ctx);
   hcfree (hashcat_ctx->dictstat_ctx);
   hcfree (hashcat_ctx->event_ctx);
   hcfree (hashcat_ctx->folder_config);
@@ -1164,13 +1340,16 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->logfile_ctx);
   hcfree (hashcat_ctx->loopback_ctx);
   hcfree (hashcat_ctx->mask_ctx);
+  hcfree (hashcat_ctx->metrics_ctx);
   hcfree (hashcat_ctx->module_ctx);
   hcfree (hashcat_ctx->backend_ctx);
   hcfree (hashcat_ctx->outcheck_ctx);
   hcfree (hashcat_ctx->outfile_ctx);
   hcfree (hashcat_ctx->pidfile_ctx);
   hcfree (hashcat_ctx->potfile_ctx);
+  hcfree (hashcat_ctx->resident_ctx);
   hcfree (hashcat_ctx->restore_ctx);
+  hcfree (hashcat_ctx->startup_ctx);
   hcfree (hashcat_ctx->status_ctx);
   hcfree (hashcat_ctx->straight_ctx);
   hcfree (hashcat_ctx->tuning_db);
@@ -1181,7 +1360,7 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   memset (hashcat_ctx, 0, sizeof (hashcat_ctx_t));
 }
 
-int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, const char *install_folder, const char *shared_folder, int argc, char **argv, const int comptime)
+int hashcat_session_job_init (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
 {
   user_options_t *user_options = hashcat_ctx->user_options;
 
@@ -1191,12 +1370,6 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, const char *install_folder
 
   user_options_session_auto (hashcat_ctx);
 
-  /**
-   * event init (needed for logging so should be first)
-   */
-
-  if (event_ctx_init (hashcat_ctx) == -1) return -1;
-
   /**
    * status init
    */
@@ -1204,10 +1377,10 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, const char *install_folder
   if (status_ctx_init (hashcat_ctx) == -1) return -1;
 
   /**
-   * folder
+   * startup stage timing
    */
 
-  if (folder_config_init (hashcat_ctx, install_folder, shared_folder) == -1) return -1;
+  if (startup_ctx_init (hashcat_ctx) == -1) return -1;
 
   /**
    * pidfile
@@ -1285,12 +1458,6 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, const char *install_folder
 
   setup_umask ();
 
-  /**
-   * tuning db
-   */
-
-  if (tuning_db_init (hashcat_ctx) == -1) return -1;
-
   /**
    * induction directory
    */
@@ -1329,18 +1496,61 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, const char *install_folder
 
   if (loopback_init (hashcat_ctx) == -1) return -1;
 
+  /**
+   * candidate dedup filter, reloaded on --restore
+   */
+
+  if (dedup_init (hashcat_ctx) == -1) return -1;
+
   /**
    * debugfile init
    */
 
   if (debugfile_init (hashcat_ctx) == -1) return -1;
 
+  /**
+   * metrics endpoint, rendered by the monitor thread
+   */
+
+  if (metrics_init (hashcat_ctx) == -1) return -1;
+
   /**
    * Try to detect if all the files we're going to use are accessible in the mode we want them
    */
 
   if (user_options_check_files (hashcat_ctx) == -1) return -1;
 
+  return 0;
+}
+
+int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, const char *install_folder, const char *shared_folder, int argc, char **argv, const int comptime)
+{
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  /**
+   * event init (needed for logging so should be first)
+   */
+
+  if (event_ctx_init (hashcat_ctx) == -1) return -1;
+
+  /**
+   * folder
+   */
+
+  if (folder_config_init (hashcat_ctx, install_folder, shared_folder) == -1) return -1;
+
+  /**
+   * everything depending on the user options of a single job, the daemon redoes this for each of its jobs
+   */
+
+  if (hashcat_session_job_init (hashcat_ctx, argc, argv) == -1) return -1;
+
+  /**
+   * tuning db
+   */
+
+  if (tuning_db_init (hashcat_ctx) == -1) return -1;
+
   /**
    * Load bridge a bit too early actually, but we need to know the unit count so we can automatically configure virtualization for the user
    */
@@ -1619,6 +1829,60 @@ bool autodetect_hashmode_test (hashcat_ctx_t *hashcat_ctx)
   return success;
 }
 
+static HC_API_CALL void *thread_autodetect (void *p)
+{
+  autodetect_thread_param_t *autodetect_thread_param = (autodetect_thread_param_t *) p;
+
+  hashcat_ctx_t *hashcat_ctx = autodetect_thread_param->hashcat_ctx;
+
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  while (true)
+  {
+    hc_thread_mutex_lock (*autodetect_thread_param->mux_pos);
+
+    const int modes_idx = *autodetect_thread_param->modes_pos;
+
+    *autodetect_thread_param->modes_pos = modes_idx + 1;
+
+    hc_thread_mutex_unlock (*autodetect_thread_param->mux_pos);
+
+    if (modes_idx >= autodetect_thread_param->modes_cnt) break;
+
+    user_options->hash_mode = autodetect_thread_param->modes_buf[modes_idx];
+
+    // loading and unloading modules is serialized, this also keeps their event messages intact
+    // the expensive part is the parser test, which runs in parallel
+
+    hc_thread_mutex_lock (*autodetect_thread_param->mux_module);
+
+    const int hashconfig_init_rc = hashconfig_init (hashcat_ctx);
+
+    hc_thread_mutex_unlock (*autodetect_thread_param->mux_module);
+
+    if (hashconfig_init_rc == 0)
+    {
+      const bool test_rc = autodetect_hashmode_test (hashcat_ctx);
+
+      if (test_rc == true)
+      {
+        autodetect_thread_param->hash_name_buf[modes_idx]     = hcstrdup (hashcat_ctx->hashconfig->hash_name);
+        autodetect_thread_param->hash_category_buf[modes_idx] = hashcat_ctx->hashconfig->hash_category;
+      }
+    }
+
+    // clean up
+
+    hc_thread_mutex_lock (*autodetect_thread_param->mux_module);
+
+    hashconfig_destroy (hashcat_ctx);
+
+    hc_thread_mutex_unlock (*autodetect_thread_param->mux_module);
+  }
+
+  return NULL;
+}
+
 int autodetect_hashmodes (hashcat_ctx_t *hashcat_ctx, usage_sort_t *usage_sort_buf)
 {
   folder_config_t *folder_config = hashcat_ctx->folder_config;
@@ -1634,46 +1898,120 @@ int autodetect_hashmodes (hashcat_ctx_t *hashcat_ctx, usage_sort_t *usage_sort_b
 
   user_options->quiet = true;
 
-  char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
+  // the module manifest tells us which hash-modes exist and which of them can not match the input at all
+
+  u32 *modes_buf = (u32 *) hccalloc (MODULE_HASH_MODES_MAXIMUM, sizeof (u32));
+  int  modes_cnt = 0;
 
-  if (modulefile == NULL) return -1;
+  int manifest_cnt = 0;
 
-  // brute force all the modes
+  module_manifest_entry_t *manifest_buf = module_manifest_read (hashcat_ctx, &manifest_cnt);
 
-  for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
+  if (manifest_buf != NULL)
   {
-    user_options->hash_mode = i;
+    modes_cnt = module_manifest_filter (hashcat_ctx, manifest_buf, manifest_cnt, modes_buf);
 
-    // this is just to find out of that hash-mode exists or not
+    hcfree (manifest_buf);
+  }
+  else
+  {
+    // no manifest, brute force all the modes
 
-    module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
+    for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
+    {
+      // this is just to find out of that hash-mode exists or not
 
-    if (hc_path_exist (modulefile) == false) continue;
+      if (module_exists (folder_config, i) == false) continue;
 
-    // we know it exists, so load the plugin
+      modes_buf[modes_cnt] = i;
 
-    const int hashconfig_init_rc = hashconfig_init (hashcat_ctx);
+      modes_cnt++;
+    }
+  }
 
-    if (hashconfig_init_rc == 0)
-    {
-      const bool test_rc = autodetect_hashmode_test (hashcat_ctx);
+  // verify the remaining candidates in parallel, each thread with its own copy of the context parts the test modifies
 
-      if (test_rc == true)
-      {
-        usage_sort_buf[usage_sort_cnt].hash_mode     = hashcat_ctx->hashconfig->hash_mode;
-        usage_sort_buf[usage_sort_cnt].hash_name     = hcstrdup (hashcat_ctx->hashconfig->hash_name);
-        usage_sort_buf[usage_sort_cnt].hash_category = hashcat_ctx->hashconfig->hash_category;
+  int threads_cnt = MIN (hc_get_processor_count (), modes_cnt);
 
-        usage_sort_cnt++;
-      }
-    }
+  if (threads_cnt < 1) threads_cnt = 1;
 
-    // clean up
+  char **hash_name_buf     = (char **) hccalloc (MAX (modes_cnt, 1), sizeof (char *));
+  u32   *hash_category_buf = (u32 *)   hccalloc (MAX (modes_cnt, 1), sizeof (u32));
 
-    hashconfig_destroy (hashcat_ctx);
+  int modes_pos = 0;
+
+  hc_thread_mutex_t mux_pos;
+  hc_thread_mutex_t mux_module;
+
+  hc_thread_mutex_init (mux_pos);
+  hc_thread_mutex_init (mux_module);
+
+  hashcat_ctx_t *thread_ctxs = (hashcat_ctx_t *) hccalloc (threads_cnt, sizeof (hashcat_ctx_t));
+
+  autodetect_thread_param_t *autodetect_thread_params = (autodetect_thread_param_t *) hccalloc (threads_cnt, sizeof (autodetect_thread_param_t));
+
+  hc_thread_t *autodetect_threads = (hc_thread_t *) hccalloc (threads_cnt, sizeof (hc_thread_t));
+
+  for (int thread_idx = 0; thread_idx < threads_cnt; thread_idx++)
+  {
+    hashcat_ctx_t *thread_ctx = &thread_ctxs[thread_idx];
+
+    memcpy (thread_ctx, hashcat_ctx, sizeof (hashcat_ctx_t));
+
+    thread_ctx->hashconfig   = (hashconfig_t *)   hcmalloc (sizeof (hashconfig_t));
+    thread_ctx->hashes       = (hashes_t *)       hcmalloc (sizeof (hashes_t));
+    thread_ctx->module_ctx   = (module_ctx_t *)   hcmalloc (sizeof (module_ctx_t));
+    thread_ctx->user_options = (user_options_t *) hcmalloc (sizeof (user_options_t));
+
+    memcpy (thread_ctx->user_options, user_options, sizeof (user_options_t));
+
+    autodetect_thread_param_t *autodetect_thread_param = &autodetect_thread_params[thread_idx];
+
+    autodetect_thread_param->hashcat_ctx       = thread_ctx;
+    autodetect_thread_param->modes_buf         = modes_buf;
+    autodetect_thread_param->modes_cnt         = modes_cnt;
+    autodetect_thread_param->modes_pos         = &modes_pos;
+    autodetect_thread_param->hash_name_buf     = hash_name_buf;
+    autodetect_thread_param->hash_category_buf = hash_category_buf;
+    autodetect_thread_param->mux_pos           = &mux_pos;
+    autodetect_thread_param->mux_module        = &mux_module;
+
+    hc_thread_create (autodetect_threads[thread_idx], thread_autodetect, autodetect_thread_param);
   }
 
-  hcfree (modulefile);
+  hc_thread_wait (threads_cnt, autodetect_threads);
+
+  for (int thread_idx = 0; thread_idx < threads_cnt; thread_idx++)
+  {
+    hashcat_ctx_t *thread_ctx = &thread_ctxs[thread_idx];
+
+    hcfree (thread_ctx->hashconfig);
+    hcfree (thread_ctx->hashes);
+    hcfree (thread_ctx->module_ctx);
+    hcfree (thread_ctx->user_options);
+  }
+
+  hcfree (autodetect_threads);
+  hcfree (autodetect_thread_params);
+  hcfree (thread_ctxs);
+
+  hc_thread_mutex_delete (mux_pos);
+  hc_thread_mutex_delete (mux_module);
+
+  for (int i = 0; i < modes_cnt; i++)
+  {
+    if (hash_name_buf[i] == NULL) continue;
+
+    usage_sort_buf[usage_sort_cnt].hash_mode     = modes_buf[i];
+    usage_sort_buf[usage_sort_cnt].hash_name     = hash_name_buf[i];
+    usage_sort_buf[usage_sort_cnt].hash_category = hash_category_buf[i];
+
+    usage_sort_cnt++;
+  }
+
+  hcfree (hash_name_buf);
+  hcfree (hash_category_buf);
+  hcfree (modes_buf);
 
   qsort (usage_sort_buf, usage_sort_cnt, sizeof (usage_sort_t), sort_by_usage);
 
@@ -1723,6 +2061,8 @@ int hashcat_session_execute (hashcat_ctx_t *hashcat_ctx)
   {
     status_ctx->devices_status = STATUS_AUTODETECT;
 
+    if (user_options->identify_all == true) return identify_all (hashcat_ctx);
+
     usage_sort_t *usage_sort_buf = (usage_sort_t *) hccalloc (MODULE_HASH_MODES_MAXIMUM, sizeof (usage_sort_t));
 
     if (usage_sort_buf == NULL) return -1;
@@ -1880,6 +2220,10 @@ int hashcat_session_execute (hashcat_ctx_t *hashcat_ctx)
 
   unlink_restore (hashcat_ctx);
 
+  // the candidate dedup filter lives as long as the restore file
+
+  dedup_write (hashcat_ctx);
+
   // final update dictionary cache
 
   dictstat_write (hashcat_ctx);
@@ -1965,7 +2309,7 @@ int hashcat_session_quit (hashcat_ctx_t *hashcat_ctx)
   return myabort (hashcat_ctx);
 }
 
-int hashcat_session_destroy (hashcat_ctx_t *hashcat_ctx)
+int hashcat_session_job_destroy (hashcat_ctx_t *hashcat_ctx)
 {
   #ifdef WITH_BRAIN
   #if defined (_WIN)
@@ -1979,23 +2323,34 @@ int hashcat_session_destroy (hashcat_ctx_t *hashcat_ctx)
   #endif
 
   debugfile_destroy           (hashcat_ctx);
+  dedup_destroy               (hashcat_ctx);
   dictstat_destroy            (hashcat_ctx);
-  folder_config_destroy       (hashcat_ctx);
-  hwmon_ctx_destroy           (hashcat_ctx);
   induct_ctx_destroy          (hashcat_ctx);
   logfile_destroy             (hashcat_ctx);
   loopback_destroy            (hashcat_ctx);
-  backend_ctx_devices_destroy (hashcat_ctx);
-  backend_ctx_destroy         (hashcat_ctx);
+  metrics_destroy             (hashcat_ctx);
   outcheck_ctx_destroy        (hashcat_ctx);
   outfile_destroy             (hashcat_ctx);
   pidfile_ctx_destroy         (hashcat_ctx);
   potfile_destroy             (hashcat_ctx);
   restore_ctx_destroy         (hashcat_ctx);
-  tuning_db_destroy           (hashcat_ctx);
-  user_options_destroy        (hashcat_ctx);
   user_options_extra_destroy  (hashcat_ctx);
+  startup_ctx_destroy         (hashcat_ctx);
   status_ctx_destroy          (hashcat_ctx);
+
+  return 0;
+}
+
+int hashcat_session_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  hashcat_session_job_destroy (hashcat_ctx);
+
+  folder_config_destroy       (hashcat_ctx);
+  hwmon_ctx_destroy           (hashcat_ctx);
+  backend_ctx_devices_destroy (hashcat_ctx);
+  backend_ctx_destroy         (hashcat_ctx);
+  tuning_db_destroy           (hashcat_ctx);
+  user_options_destroy        (hashcat_ctx);
   event_ctx_destroy           (hashcat_ctx);
 
   return 0;
@@ -2061,6 +2416,10 @@ int hashcat_get_status (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_st
   hashcat_status->progress_ignore             = status_get_progress_ignore            (hashcat_ctx);
   hashcat_status->progress_rejected           = status_get_progress_rejected          (hashcat_ctx);
   hashcat_status->progress_rejected_percent   = status_get_progress_rejected_percent  (hashcat_ctx);
+  hashcat_status->progress_dedup              = status_get_progress_dedup             (hashcat_ctx);
+  hashcat_status->dedup_fill_percent          = status_get_dedup_fill_percent         (hashcat_ctx);
+  hashcat_status->energy_joules               = status_get_energy_joules              (hashcat_ctx);
+  hashcat_status->hashes_per_joule            = status_get_hashes_per_joule           (hashcat_ctx);
   hashcat_status->progress_restored           = status_get_progress_restored          (hashcat_ctx);
   hashcat_status->progress_skip               = status_get_progress_skip              (hashcat_ctx);
   hashcat_status->restore_point               = status_get_restore_point              (hashcat_ctx);
@@ -2118,6 +2477,7 @@ int hashcat_get_status (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_st
     device_info->kernel_loops_dev               = status_get_kernel_loops_dev               (hashcat_ctx, device_id);
     device_info->kernel_threads_dev             = status_get_kernel_threads_dev             (hashcat_ctx, device_id);
     device_info->vector_width_dev               = status_get_vector_width_dev               (hashcat_ctx, device_id);
+    device_info->numa_node_dev                  = status_get_numa_node_dev                  (hashcat_ctx, device_id);
     device_info->salt_pos_dev                   = status_get_salt_pos_dev                   (hashcat_ctx, device_id);
     device_info->innerloop_pos_dev              = status_get_innerloop_pos_dev              (hashcat_ctx, device_id);
     device_info->innerloop_left_dev             = status_get_innerloop_left_dev             (hashcat_ctx, device_id);
@@ -2139,5 +2499,9 @@ int hashcat_get_status (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_st
   hashcat_status->exec_msec_all   = status_get_exec_msec_all   (hashcat_ctx);
   hashcat_status->speed_sec_all   = status_get_speed_sec_all   (hashcat_ctx);
 
+  // startup stages of the current hash-mode
+
+  hashcat_status->startup_stages_cnt = status_get_startup_stages (hashcat_ctx, hashcat_status->startup_stages_buf);
+
   return 0;
 }
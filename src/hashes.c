@@ -311,12 +311,242 @@ int save_hash (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
-int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain)
+static u64 cracked_entry_size (const cracked_entry_t *cracked_entry)
+{
+  u64 entry_size = sizeof (cracked_entry_t);
+
+  entry_size += cracked_entry->out_len;
+  entry_size += cracked_entry->pot_len;
+  entry_size += cracked_entry->plain_len;
+  entry_size += MAX (cracked_entry->debug_rule_len,  0);
+  entry_size += MAX (cracked_entry->debug_plain_len, 0);
+
+  // keep the next record header aligned
+
+  return (entry_size + 7) & ~7;
+}
+
+static void cracked_batch_append (cracked_batch_t *cracked_batch, const cracked_entry_t *cracked_entry, const u8 *out_ptr, const u8 *pot_ptr, const u8 *plain_ptr, const u8 *debug_rule_ptr, const u8 *debug_plain_ptr)
+{
+  const u64 entry_size = cracked_entry_size (cracked_entry);
+
+  if ((cracked_batch->buf_len + entry_size) > cracked_batch->buf_size)
+  {
+    const u64 buf_inc = MAX (entry_size, INCR_CRACKED);
+
+    cracked_batch->buf = (u8 *) hcrealloc (cracked_batch->buf, cracked_batch->buf_size, buf_inc);
+
+    cracked_batch->buf_size += buf_inc;
+  }
+
+  u8 *ptr = cracked_batch->buf + cracked_batch->buf_len;
+
+  memcpy (ptr, cracked_entry, sizeof (cracked_entry_t)); ptr += sizeof (cracked_entry_t);
+
+  memcpy (ptr, out_ptr,   cracked_entry->out_len);   ptr += cracked_entry->out_len;
+  memcpy (ptr, pot_ptr,   cracked_entry->pot_len);   ptr += cracked_entry->pot_len;
+  memcpy (ptr, plain_ptr, cracked_entry->plain_len); ptr += cracked_entry->plain_len;
+
+  if (cracked_entry->debug_rule_len  > 0) { memcpy (ptr, debug_rule_ptr,  cracked_entry->debug_rule_len); ptr += cracked_entry->debug_rule_len; }
+  if (cracked_entry->debug_plain_len > 0) { memcpy (ptr, debug_plain_ptr, cracked_entry->debug_plain_len); }
+
+  cracked_batch->buf_len += entry_size;
+
+  cracked_batch->entries_cnt++;
+}
+
+static void cracked_batch_write (hashcat_ctx_t *hashcat_ctx, const cracked_batch_t *cracked_batch)
 {
   const debugfile_ctx_t *debugfile_ctx = hashcat_ctx->debugfile_ctx;
   const hashes_t        *hashes        = hashcat_ctx->hashes;
-  const hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
   const loopback_ctx_t  *loopback_ctx  = hashcat_ctx->loopback_ctx;
+  status_ctx_t          *status_ctx    = hashcat_ctx->status_ctx;
+
+  if (cracked_batch->entries_cnt == 0) return;
+
+  // outfile, can be either to file or stdout
+  // if an error occurs opening the file, send to stdout as fallback
+  // the fp gets opened for each batch so that the user can modify (move) the outfile while hashcat runs
+
+  outfile_write_open (hashcat_ctx);
+
+  potfile_write_lock (hashcat_ctx);
+
+  // the files are only written by this thread, mux_display is taken for the terminal output alone
+  // so that check_cracked () in the cracker threads never waits for disk I/O
+
+  u8 *tmp_buf = hashes->tmp_buf;
+
+  for (u64 buf_pos = 0; buf_pos < cracked_batch->buf_len; )
+  {
+    const cracked_entry_t *cracked_entry = (const cracked_entry_t *) (cracked_batch->buf + buf_pos);
+
+    const u8 *out_ptr         = (const u8 *) (cracked_entry + 1);
+    const u8 *pot_ptr         = out_ptr        + cracked_entry->out_len;
+    const u8 *plain_ptr       = pot_ptr        + cracked_entry->pot_len;
+    const u8 *debug_rule_ptr  = plain_ptr      + cracked_entry->plain_len;
+    const u8 *debug_plain_ptr = debug_rule_ptr + MAX (cracked_entry->debug_rule_len, 0);
+
+    tmp_buf[0] = 0;
+
+    const int tmp_len = outfile_write (hashcat_ctx, (const char *) out_ptr, (int) cracked_entry->out_len, plain_ptr, cracked_entry->plain_len, cracked_entry->crackpos, NULL, 0, true, (char *) tmp_buf);
+
+    hc_thread_mutex_lock (status_ctx->mux_display);
+
+    EVENT_DATA (EVENT_CRACKER_HASH_CRACKED, tmp_buf, tmp_len);
+
+    hc_thread_mutex_unlock (status_ctx->mux_display);
+
+    // potfile, flushed and unlocked once for the whole batch
+
+    potfile_write_line (hashcat_ctx, (const char *) pot_ptr, (int) cracked_entry->pot_len, (u8 *) plain_ptr, cracked_entry->plain_len);
+
+    // if enabled, update also the loopback file
+
+    if (loopback_ctx->fp.pfp != NULL)
+    {
+      loopback_write_append (hashcat_ctx, plain_ptr, cracked_entry->plain_len);
+    }
+
+    // if enabled, update also the (rule) debug file
+
+    if (debugfile_ctx->fp.pfp != NULL)
+    {
+      // the next check implies that:
+      // - (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
+      // - debug_mode > 0
+
+      if ((cracked_entry->debug_plain_len > 0) || (cracked_entry->debug_rule_len > 0))
+      {
+        debugfile_write_append (hashcat_ctx, debug_rule_ptr, cracked_entry->debug_rule_len, plain_ptr, cracked_entry->plain_len, debug_plain_ptr, cracked_entry->debug_plain_len);
+      }
+    }
+
+    buf_pos += cracked_entry_size (cracked_entry);
+  }
+
+  potfile_write_unlock (hashcat_ctx);
+
+  outfile_write_close (hashcat_ctx);
+}
+
+static void cracked_batch_free (cracked_batch_t *cracked_batch)
+{
+  hcfree (cracked_batch->buf);
+  hcfree (cracked_batch);
+}
+
+static void cracked_batch_push (hashcat_ctx_t *hashcat_ctx, cracked_batch_t *cracked_batch)
+{
+  hashes_t *hashes = hashcat_ctx->hashes;
+
+  if (cracked_batch->entries_cnt == 0)
+  {
+    cracked_batch_free (cracked_batch);
+
+    return;
+  }
+
+  // no result thread running, write it ourself
+
+  if (hashes->cracked_active == false)
+  {
+    cracked_batch_write (hashcat_ctx, cracked_batch);
+
+    cracked_batch_free (cracked_batch);
+
+    return;
+  }
+
+  hc_thread_mutex_lock (hashes->mux_cracked);
+
+  if (hashes->cracked_tail == NULL)
+  {
+    hashes->cracked_head = cracked_batch;
+  }
+  else
+  {
+    hashes->cracked_tail->next = cracked_batch;
+  }
+
+  hashes->cracked_tail = cracked_batch;
+
+  hc_thread_mutex_unlock (hashes->mux_cracked);
+
+  hc_thread_sem_post (hashes->sem_cracked);
+}
+
+void cracked_queue_init (hashcat_ctx_t *hashcat_ctx)
+{
+  hashes_t *hashes = hashcat_ctx->hashes;
+
+  hc_thread_mutex_init (hashes->mux_cracked);
+  hc_thread_sem_init   (hashes->sem_cracked);
+
+  hashes->cracked_head     = NULL;
+  hashes->cracked_tail     = NULL;
+  hashes->cracked_shutdown = false;
+  hashes->cracked_active   = true;
+}
+
+void cracked_queue_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  hashes_t *hashes = hashcat_ctx->hashes;
+
+  if (hashes->cracked_active == false) return;
+
+  hashes->cracked_active = false;
+
+  hc_thread_mutex_delete (hashes->mux_cracked);
+  hc_thread_sem_close    (hashes->sem_cracked);
+}
+
+HC_API_CALL void *thread_cracked (void *p)
+{
+  hashcat_ctx_t *hashcat_ctx = (hashcat_ctx_t *) p;
+
+  hashes_t *hashes = hashcat_ctx->hashes;
+
+  while (true)
+  {
+    // one post per batch, a wakeup can find the list empty if an earlier one took the batch along
+
+    hc_thread_sem_wait (hashes->sem_cracked);
+
+    hc_thread_mutex_lock (hashes->mux_cracked);
+
+    // all batches pushed before the shutdown request are in this list
+
+    const bool shutdown = hashes->cracked_shutdown;
+
+    cracked_batch_t *cracked_batch = hashes->cracked_head;
+
+    hashes->cracked_head = NULL;
+    hashes->cracked_tail = NULL;
+
+    hc_thread_mutex_unlock (hashes->mux_cracked);
+
+    while (cracked_batch != NULL)
+    {
+      cracked_batch_t *next = cracked_batch->next;
+
+      cracked_batch_write (hashcat_ctx, cracked_batch);
+
+      cracked_batch_free (cracked_batch);
+
+      cracked_batch = next;
+    }
+
+    if (shutdown == true) break;
+  }
+
+  return NULL;
+}
+
+int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain, cracked_batch_t *cracked_batch)
+{
+  const hashes_t        *hashes        = hashcat_ctx->hashes;
+  const hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
   const module_ctx_t    *module_ctx    = hashcat_ctx->module_ctx;
 
   const u32 salt_pos    = plain->salt_pos;
@@ -396,13 +626,26 @@ int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pla
         return -1;
       }
     }
+
+    if (device_param->is_native == true)
+    {
+      rc = hc_nativeMemcpyDtoH (hashcat_ctx, tmps, device_param->native_d_tmps + (plain->gidvid * hashconfig->tmp_size), hashconfig->tmp_size);
+
+      if (rc == -1)
+      {
+        hcfree (tmps);
+
+        return -1;
+      }
+    }
   }
 
-  // hash
+  // hash, this runs outside of any lock, so use the device local buffer
 
-  u8 *out_buf = hashes->out_buf;
+  u8 *out_buf = device_param->cracked_buf;
+  u8 *pot_buf = device_param->cracked_buf + (HCBUFSIZ_LARGE / 2);
 
-  int out_len = hash_encode (hashconfig, hashes, module_ctx, (char *) out_buf, HCBUFSIZ_LARGE, salt_pos, digest_pos);
+  int out_len = hash_encode (hashconfig, hashes, module_ctx, (char *) out_buf, HCBUFSIZ_LARGE / 2, salt_pos, digest_pos);
 
   out_buf[out_len] = 0;
 
@@ -458,25 +701,12 @@ int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pla
 
   build_debugdata (hashcat_ctx, device_param, plain, debug_rule_buf, &debug_rule_len, debug_plain_ptr, &debug_plain_len);
 
-  // outfile, can be either to file or stdout
-  // if an error occurs opening the file, send to stdout as fallback
-  // the fp gets opened for each cracked hash so that the user can modify (move) the outfile while hashcat runs
-
-  outfile_write_open (hashcat_ctx);
-
-  u8 *tmp_buf = hashes->tmp_buf;
-
-  tmp_buf[0] = 0;
-
-  const int tmp_len = outfile_write (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len, crackpos, NULL, 0, true, (char *) tmp_buf);
-
-  EVENT_DATA (EVENT_CRACKER_HASH_CRACKED, tmp_buf, tmp_len);
-
-  outfile_write_close (hashcat_ctx);
-
   // potfile
   // we can have either used-defined hooks or reuse the same format as input format
-  // no need for locking, we're in a mutex protected function
+
+  u8 *pot_ptr = out_buf;
+
+  int pot_len = out_len;
 
   if (module_ctx->module_hash_encode_potfile != MODULE_DEFAULT)
   {
@@ -520,7 +750,7 @@ int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pla
 
     if (hash_info) hash_info_ptr = hash_info[digest_cur];
 
-    out_len = module_ctx->module_hash_encode_potfile
+    pot_len = module_ctx->module_hash_encode_potfile
     (
       hashconfig,
       digests_buf_ptr,
@@ -528,36 +758,28 @@ int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pla
       esalts_buf_ptr,
       hook_salts_buf_ptr,
       hash_info_ptr,
-      (char *) out_buf,
-      HCBUFSIZ_LARGE,
+      (char *) pot_buf,
+      HCBUFSIZ_LARGE / 2,
       tmps
     );
 
-    out_buf[out_len] = 0;
-  }
-
-  potfile_write_append (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len);
-
-  // if enabled, update also the loopback file
+    pot_buf[pot_len] = 0;
 
-  if (loopback_ctx->fp.pfp != NULL)
-  {
-    loopback_write_append (hashcat_ctx, plain_ptr, plain_len);
+    pot_ptr = pot_buf;
   }
 
-  // if enabled, update also the (rule) debug file
+  // outfile, potfile, loopback and debugfile are written later in one go, see cracked_batch_write()
 
-  if (debugfile_ctx->fp.pfp != NULL)
-  {
-    // the next check implies that:
-    // - (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
-    // - debug_mode > 0
+  cracked_entry_t cracked_entry;
 
-    if ((debug_plain_len > 0) || (debug_rule_len > 0))
-    {
-      debugfile_write_append (hashcat_ctx, debug_rule_buf, debug_rule_len, plain_ptr, plain_len, debug_plain_ptr, debug_plain_len);
-    }
-  }
+  cracked_entry.crackpos        = crackpos;
+  cracked_entry.out_len         = (u32) out_len;
+  cracked_entry.pot_len         = (u32) pot_len;
+  cracked_entry.plain_len       = (u32) plain_len;
+  cracked_entry.debug_rule_len  = debug_rule_len;
+  cracked_entry.debug_plain_len = debug_plain_len;
+
+  cracked_batch_append (cracked_batch, &cracked_entry, out_buf, pot_ptr, plain_ptr, debug_rule_buf, debug_plain_ptr);
 
   if (hashconfig->opts_type & OPTS_TYPE_COPY_TMPS)
   {
@@ -612,6 +834,11 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
     if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_result, CL_TRUE, 0, sizeof (u32), &num_cracked, 0, NULL, NULL) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    if (hc_nativeMemcpyDtoH (hashcat_ctx, &num_cracked, device_param->native_d_result, sizeof (u32)) == -1) return -1;
+  }
+
   if (num_cracked == 0 || user_options->speed_only == true)
   {
     // we want to get the num_cracked in benchmark mode because it has an influence in performance
@@ -683,8 +910,25 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
     }
   }
 
+  if (device_param->is_native == true)
+  {
+    rc = hc_nativeMemcpyDtoH (hashcat_ctx, cracked, device_param->native_d_plain_bufs, num_cracked * sizeof (plain_t));
+
+    if (rc == -1)
+    {
+      hcfree (cracked);
+
+      return -1;
+    }
+  }
+
   u32 cpt_cracked = 0;
 
+  // first pass, bookkeeping only, so the display mutex is held as short as possible
+  // entries which are not new are dropped by compacting the array in place
+
+  u32 decode_cnt = 0;
+
   hc_thread_mutex_lock (status_ctx->mux_display);
 
   for (u32 i = 0; i < num_cracked; i++)
@@ -718,7 +962,29 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
     if (hashes->salts_done == hashes->salts_cnt) mycracked (hashcat_ctx);
 
-    rc = check_hash (hashcat_ctx, device_param, &cracked[i]);
+    // with --salt-pack the gid covers all salts of the launch, the candidate is at the same position in each slot
+
+    cracked[i].gidvid = salt_pack_gidvid (device_param, cracked[i].gidvid);
+
+    if (decode_cnt != i) cracked[decode_cnt] = cracked[i];
+
+    decode_cnt++;
+  }
+
+  hc_thread_mutex_unlock (status_ctx->mux_display);
+
+  // second pass, decode all plains of this kernel run into a single batch
+
+  cracked_batch_t *cracked_batch = (cracked_batch_t *) hcmalloc (sizeof (cracked_batch_t));
+
+  rc = 0;
+
+  for (u32 i = 0; i < decode_cnt; i++)
+  {
+    const u32 salt_pos = cracked[i].salt_pos;
+    salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+
+    rc = check_hash (hashcat_ctx, device_param, &cracked[i], cracked_batch);
 
     if (rc == -1)
     {
@@ -773,13 +1039,25 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           break;
         }
       }
+
+      if (device_param->is_native == true)
+      {
+        rc = run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_digests_shown + (salt_buf->digests_offset * sizeof (u32)), salt_buf->digests_cnt * sizeof (u32));
+
+        if (rc == -1)
+        {
+          break;
+        }
+      }
     }
   }
 
-  hc_thread_mutex_unlock (status_ctx->mux_display);
-
   hcfree (cracked);
 
+  // whatever got decoded is handed over, even on error, the hashes are already marked as shown
+
+  cracked_batch_push (hashcat_ctx, cracked_batch);
+
   if (rc == -1)
   {
     return -1;
@@ -825,6 +1103,11 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
     if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_result, sizeof (u32)) == -1) return -1;
+  }
+
   return 0;
 }
 
@@ -2244,12 +2527,6 @@ int hashes_init_stage4 (hashcat_ctx_t *hashcat_ctx)
   if (hashes->digests_cnt == 1)
     hashconfig->opti_type |= OPTI_TYPE_SINGLE_HASH;
 
-  if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-    hashconfig->opti_type |= OPTI_TYPE_NOT_ITERATED;
-
-  if (user_options->attack_mode == ATTACK_MODE_BF)
-    hashconfig->opti_type |= OPTI_TYPE_BRUTE_FORCE;
-
   if (hashconfig->opti_type & OPTI_TYPE_BRUTE_FORCE)
   {
     if (hashconfig->opti_type & OPTI_TYPE_SINGLE_HASH)
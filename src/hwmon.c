@@ -233,7 +233,7 @@ int hm_get_temperature_with_devices_idx (hashcat_ctx_t *hashcat_ctx, const int b
     }
   }
 
-  if ((backend_ctx->devices_param[backend_device_idx].is_opencl == true) || (backend_ctx->devices_param[backend_device_idx].is_hip == true))
+  if ((backend_ctx->devices_param[backend_device_idx].is_opencl == true) || (backend_ctx->devices_param[backend_device_idx].is_hip == true) || (backend_ctx->devices_param[backend_device_idx].is_native == true))
   {
     if (backend_ctx->devices_param[backend_device_idx].opencl_device_type & CL_DEVICE_TYPE_CPU)
     {
@@ -823,7 +823,7 @@ int hm_get_utilization_with_devices_idx (hashcat_ctx_t *hashcat_ctx, const int b
   }
   #endif
 
-  if ((backend_ctx->devices_param[backend_device_idx].is_opencl == true) || (backend_ctx->devices_param[backend_device_idx].is_hip == true))
+  if ((backend_ctx->devices_param[backend_device_idx].is_opencl == true) || (backend_ctx->devices_param[backend_device_idx].is_hip == true) || (backend_ctx->devices_param[backend_device_idx].is_native == true))
   {
     if (backend_ctx->devices_param[backend_device_idx].opencl_device_type & CL_DEVICE_TYPE_GPU)
     {
@@ -1251,13 +1251,13 @@ int hm_get_throttle_with_devices_idx (hashcat_ctx_t *hashcat_ctx, const int back
 int64_t hm_get_power_with_devices_idx (hashcat_ctx_t *hashcat_ctx, const int backend_device_idx)
 {
   hwmon_ctx_t   *hwmon_ctx   = hashcat_ctx->hwmon_ctx;
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
 
   if (hwmon_ctx->enabled == false) return -1;
 
   if (hwmon_ctx->hm_device[backend_device_idx].power_get_supported == false) return -1;
 
   #if defined (__APPLE__)
-  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
 
   if ((backend_ctx->devices_param[backend_device_idx].is_opencl == true) || (backend_ctx->devices_param[backend_device_idx].is_metal == true))
   {
@@ -1277,11 +1277,61 @@ int64_t hm_get_power_with_devices_idx (hashcat_ctx_t *hashcat_ctx, const int bac
   }
   #endif
 
+  if (backend_ctx->devices_param[backend_device_idx].opencl_device_type & CL_DEVICE_TYPE_CPU)
+  {
+    if (hwmon_ctx->hm_sysfs_cpu)
+    {
+      int64_t power = 0;
+
+      if (hm_SYSFS_CPU_get_power_current (hashcat_ctx, &power) == -1)
+      {
+        hwmon_ctx->hm_device[backend_device_idx].power_get_supported = false;
+
+        return -1;
+      }
+
+      return power;
+    }
+  }
+
   hwmon_ctx->hm_device[backend_device_idx].power_get_supported = false;
 
   return -1;
 }
 
+int64_t hm_get_energy_with_devices_idx (hashcat_ctx_t *hashcat_ctx, const int backend_device_idx)
+{
+  hwmon_ctx_t   *hwmon_ctx   = hashcat_ctx->hwmon_ctx;
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  if (hwmon_ctx->enabled == false) return -1;
+
+  if (hwmon_ctx->hm_device[backend_device_idx].energy_get_supported == false) return -1;
+
+  // energy of all cpu packages since hwmon init, in uJ
+
+  if (backend_ctx->devices_param[backend_device_idx].opencl_device_type & CL_DEVICE_TYPE_CPU)
+  {
+    if (hwmon_ctx->hm_sysfs_cpu)
+    {
+      u64 energy = 0;
+
+      if (hm_SYSFS_CPU_get_energy_current (hashcat_ctx, &energy) == -1)
+      {
+        hwmon_ctx->hm_device[backend_device_idx].energy_get_supported = false;
+
+        return -1;
+      }
+
+      return (int64_t) energy;
+    }
+  }
+
+  hwmon_ctx->hm_device[backend_device_idx].energy_get_supported = false;
+
+  return -1;
+}
+
 u64 hm_get_memoryused_with_devices_idx (hashcat_ctx_t *hashcat_ctx, const int backend_device_idx)
 {
   hwmon_ctx_t   *hwmon_ctx   = hashcat_ctx->hwmon_ctx;
@@ -1709,7 +1759,7 @@ static void hwmon_ctx_init_sysfs_cpu (hashcat_ctx_t *hashcat_ctx, hm_attrs_t *hm
           // nothing to do
       }
 
-      if ((device_param->is_opencl == true) || (device_param->is_hip == true))
+      if ((device_param->is_opencl == true) || (device_param->is_hip == true) || (device_param->is_native == true))
       {
         const u32 device_id = device_param->device_id;
 
@@ -1717,6 +1767,8 @@ static void hwmon_ctx_init_sysfs_cpu (hashcat_ctx_t *hashcat_ctx, hm_attrs_t *hm
 
         if (hwmon_ctx->hm_sysfs_cpu)
         {
+          const SYSFS_CPU_PTR *sysfs_cpu = (const SYSFS_CPU_PTR *) hwmon_ctx->hm_sysfs_cpu;
+
           hm_adapters_sysfs_cpu[device_id].buslanes_get_supported    = false;
           hm_adapters_sysfs_cpu[device_id].corespeed_get_supported   = false;
           hm_adapters_sysfs_cpu[device_id].fanspeed_get_supported    = false;
@@ -1724,7 +1776,8 @@ static void hwmon_ctx_init_sysfs_cpu (hashcat_ctx_t *hashcat_ctx, hm_attrs_t *hm
           hm_adapters_sysfs_cpu[device_id].memoryspeed_get_supported = false;
           hm_adapters_sysfs_cpu[device_id].temperature_get_supported = true;
           hm_adapters_sysfs_cpu[device_id].utilization_get_supported = true;
-          hm_adapters_sysfs_cpu[device_id].power_get_supported       = false;
+          hm_adapters_sysfs_cpu[device_id].power_get_supported       = (sysfs_cpu->rapl_zones_cnt > 0);
+          hm_adapters_sysfs_cpu[device_id].energy_get_supported      = (sysfs_cpu->rapl_zones_cnt > 0);
         }
       }
     }
@@ -1998,7 +2051,7 @@ int hwmon_ctx_init (hashcat_ctx_t *hashcat_ctx)
       }
     }
 
-    if ((device_param->is_opencl == true) || (device_param->is_hip == true))
+    if ((device_param->is_opencl == true) || (device_param->is_hip == true) || (device_param->is_native == true))
     {
       if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
       {
@@ -2036,6 +2089,7 @@ int hwmon_ctx_init (hashcat_ctx_t *hashcat_ctx)
           hwmon_ctx->hm_device[backend_devices_idx].throttle_get_supported            |= hm_adapters_sysfs_cpu[device_id].throttle_get_supported;
           hwmon_ctx->hm_device[backend_devices_idx].utilization_get_supported         |= hm_adapters_sysfs_cpu[device_id].utilization_get_supported;
           hwmon_ctx->hm_device[backend_devices_idx].power_get_supported               |= hm_adapters_sysfs_cpu[device_id].power_get_supported;
+          hwmon_ctx->hm_device[backend_devices_idx].energy_get_supported              |= hm_adapters_sysfs_cpu[device_id].energy_get_supported;
         }
       }
 
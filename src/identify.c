@@ -0,0 +1,592 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "shared.h"
+#include "thread.h"
+#include "folder.h"
+#include "filehandling.h"
+#include "hlfmt.h"
+#include "interface.h"
+#include "manifest.h"
+#include "identify.h"
+
+static int sort_by_identify_mode (const void *p1, const void *p2)
+{
+  const identify_mode_t *m1 = *((const identify_mode_t * const *) p1);
+  const identify_mode_t *m2 = *((const identify_mode_t * const *) p2);
+
+  if (m1->lines_cnt < m2->lines_cnt) return  1;
+  if (m1->lines_cnt > m2->lines_cnt) return -1;
+
+  if (m1->hashconfig.hash_mode > m2->hashconfig.hash_mode) return  1;
+  if (m1->hashconfig.hash_mode < m2->hashconfig.hash_mode) return -1;
+
+  return 0;
+}
+
+static void identify_match_add (identify_thread_param_t *identify_thread_param, const u32 line_idx, const u32 mode_idx)
+{
+  if (identify_thread_param->match_cnt == identify_thread_param->match_avail)
+  {
+    identify_thread_param->match_buf = (u32 *) hcrealloc (identify_thread_param->match_buf, identify_thread_param->match_avail * 2 * sizeof (u32), IDENTIFY_MATCH_INCR * 2 * sizeof (u32));
+
+    identify_thread_param->match_avail += IDENTIFY_MATCH_INCR;
+  }
+
+  u32 *match = identify_thread_param->match_buf + (identify_thread_param->match_cnt * 2);
+
+  match[0] = line_idx;
+  match[1] = mode_idx;
+
+  identify_thread_param->match_cnt++;
+}
+
+static HC_API_CALL void *thread_identify (void *p)
+{
+  identify_thread_param_t *identify_thread_param = (identify_thread_param_t *) p;
+
+  char *hash_pos[IDENTIFY_HLFMTS_MAX];
+  int   hash_len[IDENTIFY_HLFMTS_MAX];
+
+  for (u32 line_idx = identify_thread_param->lines_start; line_idx < identify_thread_param->lines_end; line_idx++)
+  {
+    char *line_buf = identify_thread_param->chunk_buf + identify_thread_param->lines_off[line_idx];
+
+    const int line_len = (int) identify_thread_param->lines_len[line_idx];
+
+    // the hash position only depends on the hashlist format, not on the hash-mode
+
+    for (int hlfmt_idx = 0; hlfmt_idx < identify_thread_param->hlfmts_cnt; hlfmt_idx++)
+    {
+      identify_mode_t *identify_mode = identify_thread_param->hlfmts_buf[hlfmt_idx];
+
+      hash_pos[hlfmt_idx] = NULL;
+      hash_len[hlfmt_idx] = 0;
+
+      hlfmt_hash (&identify_mode->hashcat_ctx, identify_mode->hlfmt, line_buf, line_len, &hash_pos[hlfmt_idx], &hash_len[hlfmt_idx]);
+    }
+
+    bool matched = false;
+
+    for (int mode_idx = 0; mode_idx < identify_thread_param->modes_cnt; mode_idx++)
+    {
+      identify_mode_t *identify_mode = &identify_thread_param->modes_buf[mode_idx];
+
+      const char *hash_buf = hash_pos[identify_mode->hlfmt_idx];
+      const int   hash_sz  = hash_len[identify_mode->hlfmt_idx];
+
+      if (hash_buf == NULL) continue;
+
+      // cheap check first, most lines can only match a few hash-modes
+
+      if (module_manifest_match (identify_mode->manifest_entry, hash_buf, hash_sz) == false) continue;
+
+      const int parser_status = identify_mode->module_ctx.module_hash_decode (&identify_mode->hashconfig, identify_thread_param->digest, identify_thread_param->salt, identify_thread_param->esalt, identify_thread_param->hook_salt, identify_thread_param->hash_info, hash_buf, hash_sz);
+
+      if (parser_status != PARSER_OK) continue;
+
+      identify_match_add (identify_thread_param, line_idx, (u32) mode_idx);
+
+      matched = true;
+    }
+
+    if (matched == false) identify_match_add (identify_thread_param, line_idx, IDENTIFY_NONE);
+  }
+
+  return NULL;
+}
+
+static bool identify_split_write (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, bool *fp_open, const char *filename, const char *line_buf, const u32 line_len)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (*fp_open == false)
+  {
+    char *split_file = NULL;
+
+    hc_asprintf (&split_file, "%s/%s", user_options->identify_split_dir, filename);
+
+    if (hc_fopen (fp, split_file, "wb") == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", split_file, strerror (errno));
+
+      hcfree (split_file);
+
+      return false;
+    }
+
+    hcfree (split_file);
+
+    *fp_open = true;
+  }
+
+  hc_fwrite (line_buf, line_len, 1, fp);
+
+  hc_fwrite (EOL, strlen (EOL), 1, fp);
+
+  return true;
+}
+
+int identify_all (hashcat_ctx_t *hashcat_ctx)
+{
+  user_options_t             *user_options       = hashcat_ctx->user_options;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  const char *hc_hash = user_options_extra->hc_hash;
+
+  if (hc_hash == NULL) return -1;
+
+  if (user_options->identify_split_dir != NULL)
+  {
+    if (hc_path_exist (user_options->identify_split_dir) == false)
+    {
+      if (hc_mkdir (user_options->identify_split_dir, 0700) == -1)
+      {
+        event_log_error (hashcat_ctx, "%s: %s", user_options->identify_split_dir, strerror (errno));
+
+        return -1;
+      }
+    }
+    else if (hc_path_is_directory (user_options->identify_split_dir) == false)
+    {
+      event_log_error (hashcat_ctx, "%s: Not a directory.", user_options->identify_split_dir);
+
+      return -1;
+    }
+  }
+
+  EVENT (EVENT_AUTODETECT_STARTING);
+
+  const bool quiet_sav = user_options->quiet;
+
+  user_options->quiet = true;
+
+  int manifest_cnt = 0;
+
+  module_manifest_entry_t *manifest_buf = module_manifest_read (hashcat_ctx, &manifest_cnt);
+
+  if (manifest_buf == NULL)
+  {
+    user_options->quiet = quiet_sav;
+
+    event_log_error (hashcat_ctx, "No hash-mode modules found.");
+
+    return -1;
+  }
+
+  /**
+   * load all hash-modes which can parse text lines, they stay loaded for the whole file
+   */
+
+  identify_mode_t *modes_buf = (identify_mode_t *) hccalloc (manifest_cnt, sizeof (identify_mode_t));
+
+  int modes_cnt = 0;
+
+  u64 digest_size    = 0;
+  u64 esalt_size     = 0;
+  u64 hook_salt_size = 0;
+
+  for (int i = 0; i < manifest_cnt; i++)
+  {
+    const module_manifest_entry_t *manifest_entry = &manifest_buf[i];
+
+    if (manifest_entry->opts_type & OPTS_TYPE_AUTODETECT_DISABLE) continue;
+
+    if ((manifest_entry->opts_type & OPTS_TYPE_BINARY_HASHFILE) && ((manifest_entry->opts_type & OPTS_TYPE_BINARY_HASHFILE_OPTIONAL) == 0)) continue;
+
+    identify_mode_t *identify_mode = &modes_buf[modes_cnt];
+
+    memcpy (&identify_mode->hashcat_ctx,  hashcat_ctx,  sizeof (hashcat_ctx_t));
+    memcpy (&identify_mode->user_options, user_options, sizeof (user_options_t));
+
+    identify_mode->hashcat_ctx.hashconfig   = &identify_mode->hashconfig;
+    identify_mode->hashcat_ctx.module_ctx   = &identify_mode->module_ctx;
+    identify_mode->hashcat_ctx.user_options = &identify_mode->user_options;
+
+    identify_mode->user_options.hash_mode = manifest_entry->hash_mode;
+
+    if (hashconfig_init (&identify_mode->hashcat_ctx) == -1)
+    {
+      hashconfig_destroy (&identify_mode->hashcat_ctx);
+
+      continue;
+    }
+
+    identify_mode->manifest_entry = manifest_entry;
+
+    digest_size    = MAX (digest_size,    identify_mode->hashconfig.dgst_size);
+    esalt_size     = MAX (esalt_size,     identify_mode->hashconfig.esalt_size);
+    hook_salt_size = MAX (hook_salt_size, identify_mode->hashconfig.hook_salt_size);
+
+    modes_cnt++;
+  }
+
+  /**
+   * hashlist format, detected once for the whole file
+   */
+
+  const bool hash_is_file = hc_path_exist (hc_hash);
+
+  u32 hlfmt_detected = HLFMT_HASHCAT;
+
+  HCFILE fp;
+
+  if (hash_is_file == true)
+  {
+    if (hc_fopen (&fp, hc_hash, "rb") == true)
+    {
+      hlfmt_detected = hlfmt_detect (hashcat_ctx, &fp, 100);
+
+      hc_fclose (&fp);
+    }
+  }
+
+  identify_mode_t *hlfmts_buf[IDENTIFY_HLFMTS_MAX];
+  u32              hlfmts_key[IDENTIFY_HLFMTS_MAX];
+
+  int hlfmts_cnt = 0;
+
+  for (int mode_idx = 0; mode_idx < modes_cnt; mode_idx++)
+  {
+    identify_mode_t *identify_mode = &modes_buf[mode_idx];
+
+    identify_mode->hlfmt = (identify_mode->hashconfig.hlfmt_disable == true) ? HLFMT_HASHCAT : hlfmt_detected;
+
+    // pwdump is the only format where the hash position depends on the hash-mode
+
+    const u32 key = (identify_mode->hlfmt << 4) | ((identify_mode->hlfmt == HLFMT_PWDUMP) ? identify_mode->hashconfig.pwdump_column : 0);
+
+    int hlfmt_idx;
+
+    for (hlfmt_idx = 0; hlfmt_idx < hlfmts_cnt; hlfmt_idx++)
+    {
+      if (hlfmts_key[hlfmt_idx] == key) break;
+    }
+
+    if ((hlfmt_idx == hlfmts_cnt) && (hlfmts_cnt < IDENTIFY_HLFMTS_MAX))
+    {
+      hlfmts_buf[hlfmts_cnt] = identify_mode;
+      hlfmts_key[hlfmts_cnt] = key;
+
+      hlfmts_cnt++;
+    }
+
+    identify_mode->hlfmt_idx = MIN (hlfmt_idx, IDENTIFY_HLFMTS_MAX - 1);
+  }
+
+  /**
+   * worker threads, each with its own parser buffers
+   */
+
+  const int threads_cnt = MAX (hc_get_processor_count (), 1);
+
+  identify_thread_param_t *identify_thread_params = (identify_thread_param_t *) hccalloc (threads_cnt, sizeof (identify_thread_param_t));
+
+  hc_thread_t *identify_threads = (hc_thread_t *) hccalloc (threads_cnt, sizeof (hc_thread_t));
+
+  char *chunk_buf = (char *) hcmalloc (IDENTIFY_CHUNK_SIZE);
+  u64  *lines_off = (u64 *)  hccalloc (IDENTIFY_CHUNK_LINES, sizeof (u64));
+  u32  *lines_len = (u32 *)  hccalloc (IDENTIFY_CHUNK_LINES, sizeof (u32));
+
+  for (int thread_idx = 0; thread_idx < threads_cnt; thread_idx++)
+  {
+    identify_thread_param_t *identify_thread_param = &identify_thread_params[thread_idx];
+
+    identify_thread_param->modes_buf  = modes_buf;
+    identify_thread_param->modes_cnt  = modes_cnt;
+    identify_thread_param->hlfmts_buf = hlfmts_buf;
+    identify_thread_param->hlfmts_cnt = hlfmts_cnt;
+    identify_thread_param->chunk_buf  = chunk_buf;
+    identify_thread_param->lines_off  = lines_off;
+    identify_thread_param->lines_len  = lines_len;
+
+    identify_thread_param->digest    = hcmalloc (MAX (digest_size, 1));
+    identify_thread_param->salt      = (salt_t *) hcmalloc (sizeof (salt_t));
+    identify_thread_param->esalt     = hcmalloc (MAX (esalt_size, 1));
+    identify_thread_param->hook_salt = hcmalloc (MAX (hook_salt_size, 1));
+
+    hashinfo_t *hash_info = (hashinfo_t *) hcmalloc (sizeof (hashinfo_t));
+
+    hash_info->dynamicx = (dynamicx_t *) hcmalloc (sizeof (dynamicx_t));
+    hash_info->user     = (user_t *)     hcmalloc (sizeof (user_t));
+    hash_info->orighash = (char *)       hcmalloc (256);
+    hash_info->split    = (split_t *)    hcmalloc (sizeof (split_t));
+
+    identify_thread_param->hash_info = hash_info;
+  }
+
+  /**
+   * classify the file chunk by chunk
+   */
+
+  int rc = 0;
+
+  u64 lines_total        = 0;
+  u64 lines_unidentified = 0;
+
+  HCFILE fp_unidentified;
+
+  bool fp_unidentified_open = false;
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  size_t line_len = 0;
+
+  bool line_pending = false;
+
+  bool eof = false;
+
+  if (hash_is_file == true)
+  {
+    if (hc_fopen (&fp, hc_hash, "rb") == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", hc_hash, strerror (errno));
+
+      rc = -1;
+
+      eof = true;
+    }
+  }
+
+  while (eof == false)
+  {
+    u32 lines_cnt = 0;
+    u64 chunk_len = 0;
+
+    if (hash_is_file == true)
+    {
+      while (lines_cnt < IDENTIFY_CHUNK_LINES)
+      {
+        if (line_pending == false)
+        {
+          if (hc_feof (&fp))
+          {
+            eof = true;
+
+            break;
+          }
+
+          line_len = fgetl (&fp, line_buf, HCBUFSIZ_LARGE);
+
+          if (line_len == 0) continue;
+
+          line_pending = true;
+        }
+
+        // a line which does not fit anymore starts the next chunk
+
+        if ((chunk_len + line_len + 1) > IDENTIFY_CHUNK_SIZE) break;
+
+        memcpy (chunk_buf + chunk_len, line_buf, line_len);
+
+        chunk_buf[chunk_len + line_len] = 0;
+
+        lines_off[lines_cnt] = chunk_len;
+        lines_len[lines_cnt] = (u32) line_len;
+
+        lines_cnt++;
+
+        chunk_len += line_len + 1;
+
+        line_pending = false;
+      }
+    }
+    else
+    {
+      line_len = MIN (strlen (hc_hash), HCBUFSIZ_LARGE - 1);
+
+      memcpy (chunk_buf, hc_hash, line_len);
+
+      chunk_buf[line_len] = 0;
+
+      lines_off[0] = 0;
+      lines_len[0] = (u32) line_len;
+
+      lines_cnt = (line_len > 0) ? 1 : 0;
+
+      eof = true;
+    }
+
+    if (lines_cnt == 0) break;
+
+    const u32 lines_per_thread = (lines_cnt + threads_cnt - 1) / threads_cnt;
+
+    for (int thread_idx = 0; thread_idx < threads_cnt; thread_idx++)
+    {
+      identify_thread_param_t *identify_thread_param = &identify_thread_params[thread_idx];
+
+      identify_thread_param->lines_start = MIN (lines_cnt, thread_idx * lines_per_thread);
+      identify_thread_param->lines_end   = MIN (lines_cnt, identify_thread_param->lines_start + lines_per_thread);
+      identify_thread_param->match_cnt   = 0;
+
+      hc_thread_create (identify_threads[thread_idx], thread_identify, identify_thread_param);
+    }
+
+    hc_thread_wait (threads_cnt, identify_threads);
+
+    // threads got consecutive line ranges, so this keeps the order of the input file
+
+    for (int thread_idx = 0; (thread_idx < threads_cnt) && (rc == 0); thread_idx++)
+    {
+      const identify_thread_param_t *identify_thread_param = &identify_thread_params[thread_idx];
+
+      for (u64 match_idx = 0; match_idx < identify_thread_param->match_cnt; match_idx++)
+      {
+        const u32 line_idx = identify_thread_param->match_buf[(match_idx * 2) + 0];
+        const u32 mode_idx = identify_thread_param->match_buf[(match_idx * 2) + 1];
+
+        const char *split_line = chunk_buf + lines_off[line_idx];
+
+        if (mode_idx == IDENTIFY_NONE)
+        {
+          lines_unidentified++;
+
+          if (user_options->identify_split_dir == NULL) continue;
+
+          if (identify_split_write (hashcat_ctx, &fp_unidentified, &fp_unidentified_open, IDENTIFY_SPLIT_UNIDENTIFIED, split_line, lines_len[line_idx]) == false) rc = -1;
+        }
+        else
+        {
+          identify_mode_t *identify_mode = &modes_buf[mode_idx];
+
+          identify_mode->lines_cnt++;
+
+          if (user_options->identify_split_dir == NULL) continue;
+
+          char split_name[32];
+
+          snprintf (split_name, sizeof (split_name), "%u.hash", identify_mode->hashconfig.hash_mode);
+
+          if (identify_split_write (hashcat_ctx, &identify_mode->fp, &identify_mode->fp_open, split_name, split_line, lines_len[line_idx]) == false) rc = -1;
+        }
+
+        if (rc == -1) break;
+      }
+    }
+
+    lines_total += lines_cnt;
+
+    if (rc == -1) break;
+  }
+
+  if (hash_is_file == true) hc_fclose (&fp);
+
+  hcfree (line_buf);
+  hcfree (chunk_buf);
+  hcfree (lines_off);
+  hcfree (lines_len);
+
+  for (int thread_idx = 0; thread_idx < threads_cnt; thread_idx++)
+  {
+    identify_thread_param_t *identify_thread_param = &identify_thread_params[thread_idx];
+
+    hcfree (identify_thread_param->match_buf);
+    hcfree (identify_thread_param->digest);
+    hcfree (identify_thread_param->salt);
+    hcfree (identify_thread_param->esalt);
+    hcfree (identify_thread_param->hook_salt);
+
+    hcfree (identify_thread_param->hash_info->dynamicx);
+    hcfree (identify_thread_param->hash_info->user);
+    hcfree (identify_thread_param->hash_info->orighash);
+    hcfree (identify_thread_param->hash_info->split);
+    hcfree (identify_thread_param->hash_info);
+  }
+
+  hcfree (identify_threads);
+  hcfree (identify_thread_params);
+
+  if (fp_unidentified_open == true) hc_fclose (&fp_unidentified);
+
+  user_options->quiet = quiet_sav;
+
+  EVENT (EVENT_AUTODETECT_FINISHED);
+
+  /**
+   * report, most frequent hash-modes first
+   */
+
+  identify_mode_t **sorted_buf = (identify_mode_t **) hccalloc (MAX (modes_cnt, 1), sizeof (identify_mode_t *));
+
+  for (int mode_idx = 0; mode_idx < modes_cnt; mode_idx++)
+  {
+    sorted_buf[mode_idx] = &modes_buf[mode_idx];
+  }
+
+  qsort (sorted_buf, modes_cnt, sizeof (identify_mode_t *), sort_by_identify_mode);
+
+  const u64 lines_identified = lines_total - lines_unidentified;
+
+  if ((rc == 0) && (lines_identified == 0))
+  {
+    event_log_error (hashcat_ctx, "No hash-mode matches the structure of the input hashes.");
+
+    rc = -1;
+  }
+
+  if (rc == 0)
+  {
+    if (user_options->machine_readable == false)
+    {
+      event_log_info (hashcat_ctx, "Identified %" PRIu64 " of %" PRIu64 " lines, the following hash-modes match:", lines_identified, lines_total);
+      event_log_info (hashcat_ctx, NULL);
+      event_log_info (hashcat_ctx, "      # | Name                                                       | Category                             |      Lines");
+      event_log_info (hashcat_ctx, "  ======+============================================================+======================================+===========");
+    }
+
+    for (int i = 0; i < modes_cnt; i++)
+    {
+      const identify_mode_t *identify_mode = sorted_buf[i];
+
+      if (identify_mode->lines_cnt == 0) break;
+
+      if (user_options->machine_readable == false)
+      {
+        event_log_info (hashcat_ctx, "%7u | %-58s | %-36s | %10" PRIu64, identify_mode->hashconfig.hash_mode, identify_mode->hashconfig.hash_name, strhashcategory (identify_mode->hashconfig.hash_category), identify_mode->lines_cnt);
+      }
+      else
+      {
+        event_log_info (hashcat_ctx, "%u:%" PRIu64, identify_mode->hashconfig.hash_mode, identify_mode->lines_cnt);
+      }
+    }
+
+    if (user_options->machine_readable == false)
+    {
+      event_log_info (hashcat_ctx, NULL);
+
+      if (lines_unidentified > 0)
+      {
+        event_log_info (hashcat_ctx, "%" PRIu64 " lines did not match any hash-mode.", lines_unidentified);
+      }
+
+      if (user_options->identify_split_dir != NULL)
+      {
+        event_log_info (hashcat_ctx, "The lines of each hash-mode were written to %s/<hash-mode>.hash", user_options->identify_split_dir);
+      }
+
+      event_log_info (hashcat_ctx, NULL);
+    }
+  }
+
+  hcfree (sorted_buf);
+
+  for (int mode_idx = 0; mode_idx < modes_cnt; mode_idx++)
+  {
+    identify_mode_t *identify_mode = &modes_buf[mode_idx];
+
+    if (identify_mode->fp_open == true) hc_fclose (&identify_mode->fp);
+
+    hashconfig_destroy (&identify_mode->hashcat_ctx);
+  }
+
+  hcfree (modes_buf);
+  hcfree (manifest_buf);
+
+  return rc;
+}
@@ -13,6 +13,57 @@
 #include "dynloader.h"
 #include "interface.h"
 
+/**
+ * modules linked into the binary, see the "static" Makefile target
+ */
+
+static const module_static_t *modules_static_buf   = NULL;
+static int                    modules_static_cnt   = 0;
+static u64                    modules_static_stamp = 0;
+
+void module_static_register (const module_static_t *modules_buf, const int modules_cnt, const u64 modules_stamp)
+{
+  modules_static_buf   = modules_buf;
+  modules_static_cnt   = modules_cnt;
+  modules_static_stamp = modules_stamp;
+}
+
+const module_static_t *module_static_list (int *modules_cnt, u64 *modules_stamp)
+{
+  *modules_cnt   = modules_static_cnt;
+  *modules_stamp = modules_static_stamp;
+
+  return modules_static_buf;
+}
+
+static const module_static_t *module_static_find (const u32 hash_mode)
+{
+  // the generated table is sorted by hash-mode
+
+  int l = 0;
+  int r = modules_static_cnt - 1;
+
+  while (l <= r)
+  {
+    const int m = l + ((r - l) / 2);
+
+    const module_static_t *module_static = &modules_static_buf[m];
+
+    if (module_static->hash_mode == hash_mode) return module_static;
+
+    if (module_static->hash_mode < hash_mode)
+    {
+      l = m + 1;
+    }
+    else
+    {
+      r = m - 1;
+    }
+  }
+
+  return NULL;
+}
+
 /**
  * parsing
  */
@@ -27,12 +78,38 @@ int module_filename (const folder_config_t *folder_config, const int hash_mode,
   #endif
 }
 
+bool module_exists (const folder_config_t *folder_config, const int hash_mode)
+{
+  if (module_static_find ((u32) hash_mode) != NULL) return true;
+
+  char *module_file = (char *) hcmalloc (HCBUFSIZ_TINY);
+
+  module_filename (folder_config, hash_mode, module_file, HCBUFSIZ_TINY);
+
+  const bool rc = hc_path_exist (module_file);
+
+  hcfree (module_file);
+
+  return rc;
+}
+
 bool module_load (hashcat_ctx_t *hashcat_ctx, module_ctx_t *module_ctx, const u32 hash_mode)
 {
   const folder_config_t *folder_config = hashcat_ctx->folder_config;
 
   memset (module_ctx, 0, sizeof (module_ctx_t));
 
+  // linked in modules win, the modules folder is only an overlay for hash-modes the binary does not know
+
+  const module_static_t *module_static = module_static_find (hash_mode);
+
+  if (module_static != NULL)
+  {
+    module_ctx->module_init = module_static->module_init;
+
+    return true;
+  }
+
   char *module_file = (char *) hcmalloc (HCBUFSIZ_TINY);
 
   module_filename (folder_config, hash_mode, module_file, HCBUFSIZ_TINY);
@@ -428,6 +505,14 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
     hashconfig->opti_type &= ~OPTI_TYPE_APPENDED_SALT;
   }
 
+  // these do not depend on the hashlist, the kernels can be built before it is loaded
+
+  if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    hashconfig->opti_type |= OPTI_TYPE_NOT_ITERATED;
+
+  if (user_options->attack_mode == ATTACK_MODE_BF)
+    hashconfig->opti_type |= OPTI_TYPE_BRUTE_FORCE;
+
   const bool is_salted = ((hashconfig->salt_type == SALT_TYPE_GENERIC)
                        |  (hashconfig->salt_type == SALT_TYPE_EMBEDDED)
                        |  (hashconfig->salt_type == SALT_TYPE_VIRTUAL));
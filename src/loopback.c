@@ -9,6 +9,10 @@
 #include "event.h"
 #include "shared.h"
 #include "locking.h"
+#include "thread.h"
+#include "wordlist.h"
+#include "rp.h"
+#include "rp_cpu.h"
 #include "loopback.h"
 
 static void loopback_format_plain (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, const unsigned int plain_len)
@@ -53,6 +57,78 @@ static void loopback_format_plain (hashcat_ctx_t *hashcat_ctx, const u8 *plain_p
   }
 }
 
+static bool loopback_seen_add (loopback_ctx_t *loopback_ctx, const u8 *plain_ptr, const unsigned int plain_len)
+{
+  // FNV-1a, 0 marks an empty slot
+
+  u64 hash = 0xcbf29ce484222325;
+
+  for (u32 i = 0; i < plain_len; i++)
+  {
+    hash ^= plain_ptr[i];
+    hash *= 0x100000001b3;
+  }
+
+  if (hash == 0) hash = 1;
+
+  if ((loopback_ctx->seen_cnt * 2) >= loopback_ctx->seen_size)
+  {
+    const u64 seen_size_new = loopback_ctx->seen_size * 2;
+
+    u64 *seen_buf_new = (u64 *) hccalloc (seen_size_new, sizeof (u64));
+
+    for (u64 i = 0; i < loopback_ctx->seen_size; i++)
+    {
+      const u64 seen = loopback_ctx->seen_buf[i];
+
+      if (seen == 0) continue;
+
+      u64 slot = seen & (seen_size_new - 1);
+
+      while (seen_buf_new[slot] != 0) slot = (slot + 1) & (seen_size_new - 1);
+
+      seen_buf_new[slot] = seen;
+    }
+
+    hcfree (loopback_ctx->seen_buf);
+
+    loopback_ctx->seen_buf  = seen_buf_new;
+    loopback_ctx->seen_size = seen_size_new;
+  }
+
+  u64 slot = hash & (loopback_ctx->seen_size - 1);
+
+  while (loopback_ctx->seen_buf[slot] != 0)
+  {
+    if (loopback_ctx->seen_buf[slot] == hash) return false;
+
+    slot = (slot + 1) & (loopback_ctx->seen_size - 1);
+  }
+
+  loopback_ctx->seen_buf[slot] = hash;
+
+  loopback_ctx->seen_cnt++;
+
+  return true;
+}
+
+static void loopback_write_plain (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, const unsigned int plain_len)
+{
+  loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
+
+  loopback_format_plain (hashcat_ctx, plain_ptr, plain_len);
+
+  hc_lockfile (&loopback_ctx->fp);
+
+  hc_fwrite (EOL, strlen (EOL), 1, &loopback_ctx->fp);
+
+  hc_fflush (&loopback_ctx->fp);
+
+  hc_unlockfile (&loopback_ctx->fp);
+
+  loopback_ctx->unused = false;
+}
+
 int loopback_init (hashcat_ctx_t *hashcat_ctx)
 {
   loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
@@ -78,6 +154,25 @@ int loopback_init (hashcat_ctx_t *hashcat_ctx)
   loopback_ctx->fp.pfp   = NULL;
   loopback_ctx->filename = (char *) hcmalloc (HCBUFSIZ_TINY);
 
+  loopback_ctx->queue = false;
+
+  if (user_options->loopback_queue == true)
+  {
+    loopback_ctx->queue = true;
+
+    hc_thread_mutex_init (loopback_ctx->mux_queue);
+
+    loopback_ctx->queue_buf   = NULL;
+    loopback_ctx->queue_pos   = 0;
+    loopback_ctx->queue_cnt   = 0;
+    loopback_ctx->queue_avail = 0;
+    loopback_ctx->queue_done  = 0;
+
+    loopback_ctx->seen_buf  = (u64 *) hccalloc (LOOPBACK_SEEN_SIZE, sizeof (u64));
+    loopback_ctx->seen_cnt  = 0;
+    loopback_ctx->seen_size = LOOPBACK_SEEN_SIZE;
+  }
+
   return 0;
 }
 
@@ -87,6 +182,14 @@ void loopback_destroy (hashcat_ctx_t *hashcat_ctx)
 
   if (loopback_ctx->enabled == false) return;
 
+  if (loopback_ctx->queue == true)
+  {
+    hc_thread_mutex_delete (loopback_ctx->mux_queue);
+
+    hcfree (loopback_ctx->queue_buf);
+    hcfree (loopback_ctx->seen_buf);
+  }
+
   memset (loopback_ctx, 0, sizeof (loopback_ctx_t));
 }
 
@@ -138,6 +241,25 @@ void loopback_write_close (hashcat_ctx_t *hashcat_ctx)
 
   if (loopback_ctx->fp.pfp == NULL) return;
 
+  if (loopback_ctx->queue == true)
+  {
+    // plains which did not make it into the attack anymore are left to the induction pass
+
+    hc_thread_mutex_lock (loopback_ctx->mux_queue);
+
+    for (u64 queue_pos = loopback_ctx->queue_pos; queue_pos < loopback_ctx->queue_cnt; queue_pos++)
+    {
+      const loopback_entry_t *entry = loopback_ctx->queue_buf + queue_pos;
+
+      loopback_write_plain (hashcat_ctx, entry->pw_buf, entry->pw_len);
+    }
+
+    loopback_ctx->queue_pos = 0;
+    loopback_ctx->queue_cnt = 0;
+
+    hc_thread_mutex_unlock (loopback_ctx->mux_queue);
+  }
+
   hc_fclose (&loopback_ctx->fp);
 
   if (loopback_ctx->unused == true)
@@ -152,15 +274,126 @@ void loopback_write_append (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, con
 
   if (loopback_ctx->enabled == false) return;
 
-  loopback_format_plain (hashcat_ctx, plain_ptr, plain_len);
+  if (loopback_ctx->queue == false)
+  {
+    loopback_write_plain (hashcat_ctx, plain_ptr, plain_len);
 
-  hc_lockfile (&loopback_ctx->fp);
+    return;
+  }
 
-  hc_fwrite (EOL, strlen (EOL), 1, &loopback_ctx->fp);
+  hc_thread_mutex_lock (loopback_ctx->mux_queue);
 
-  hc_fflush (&loopback_ctx->fp);
+  if (loopback_seen_add (loopback_ctx, plain_ptr, plain_len) == true)
+  {
+    if ((plain_len > PW_MAX) || ((loopback_ctx->queue_cnt - loopback_ctx->queue_pos) >= LOOPBACK_QUEUE_MAX))
+    {
+      loopback_write_plain (hashcat_ctx, plain_ptr, plain_len);
+    }
+    else
+    {
+      if (loopback_ctx->queue_cnt == loopback_ctx->queue_avail)
+      {
+        loopback_ctx->queue_buf = (loopback_entry_t *) hcrealloc (loopback_ctx->queue_buf, loopback_ctx->queue_avail * sizeof (loopback_entry_t), LOOPBACK_QUEUE_INCR * sizeof (loopback_entry_t));
 
-  hc_unlockfile (&loopback_ctx->fp);
+        loopback_ctx->queue_avail += LOOPBACK_QUEUE_INCR;
+      }
 
-  loopback_ctx->unused = false;
+      loopback_entry_t *entry = loopback_ctx->queue_buf + loopback_ctx->queue_cnt;
+
+      memcpy (entry->pw_buf, plain_ptr, plain_len);
+
+      entry->pw_len = plain_len;
+
+      loopback_ctx->queue_cnt++;
+    }
+  }
+
+  hc_thread_mutex_unlock (loopback_ctx->mux_queue);
+}
+
+u64 loopback_queue_reserve (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param)
+{
+  loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
+
+  if (loopback_ctx->enabled == false) return 0;
+
+  if (loopback_ctx->queue == false) return 0;
+
+  if (loopback_ctx->fp.pfp == NULL) return 0;
+
+  hc_thread_mutex_lock (loopback_ctx->mux_queue);
+
+  const u64 pending = loopback_ctx->queue_cnt - loopback_ctx->queue_pos;
+
+  hc_thread_mutex_unlock (loopback_ctx->mux_queue);
+
+  return MIN (pending, device_param->kernel_power / LOOPBACK_QUEUE_SHARE);
+}
+
+u64 loopback_queue_fill (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  const hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  loopback_ctx_t             *loopback_ctx       = hashcat_ctx->loopback_ctx;
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  if (loopback_ctx->enabled == false) return 0;
+
+  if (loopback_ctx->queue == false) return 0;
+
+  if (loopback_ctx->fp.pfp == NULL) return 0;
+
+  const u64 pws_cnt = device_param->pws_cnt;
+
+  char rule_buf_out[RP_PASSWORD_SIZE];
+
+  hc_thread_mutex_lock (loopback_ctx->mux_queue);
+
+  while ((loopback_ctx->queue_pos < loopback_ctx->queue_cnt) && (device_param->pws_cnt < device_param->kernel_power))
+  {
+    const loopback_entry_t *entry = loopback_ctx->queue_buf + loopback_ctx->queue_pos;
+
+    loopback_ctx->queue_pos++;
+
+    const char *line_buf = (const char *) entry->pw_buf;
+    int         line_len = (int) entry->pw_len;
+
+    // same treatment as a word read from the dictionary, the kernel applies the -r rules
+
+    if (run_rule_engine ((int) user_options_extra->rule_len_l, user_options->rule_buf_l))
+    {
+      if (line_len >= RP_PASSWORD_SIZE) continue;
+
+      char line_tmp[RP_PASSWORD_SIZE];
+
+      memset (line_tmp,     0, sizeof (line_tmp));
+      memset (rule_buf_out, 0, sizeof (rule_buf_out));
+
+      memcpy (line_tmp, line_buf, line_len);
+
+      line_len = _old_apply_rule (user_options->rule_buf_l, (int) user_options_extra->rule_len_l, line_tmp, line_len, rule_buf_out);
+
+      if (line_len < 0) continue;
+
+      line_buf = rule_buf_out;
+    }
+
+    if ((line_len < (int) hashconfig->pw_min) || (line_len > (int) hashconfig->pw_max)) continue;
+
+    pw_add (device_param, (const u8 *) line_buf, line_len);
+  }
+
+  if (loopback_ctx->queue_pos == loopback_ctx->queue_cnt)
+  {
+    loopback_ctx->queue_pos = 0;
+    loopback_ctx->queue_cnt = 0;
+  }
+
+  const u64 fill_cnt = device_param->pws_cnt - pws_cnt;
+
+  loopback_ctx->queue_done += fill_cnt;
+
+  hc_thread_mutex_unlock (loopback_ctx->mux_queue);
+
+  return fill_cnt;
 }
@@ -19,11 +19,25 @@
 #include "status.h"
 #include "shared.h"
 #include "event.h"
+#include "mpsp.h"
+#include "rp.h"
+#include "rp_fuzz.h"
+#include "daemon.h"
+#include "folder.h"
+#include "potfile.h"
+#include "interface.h"
 
 #ifdef WITH_BRAIN
 #include "brain.h"
 #endif
 
+#if defined (WITH_MODULES_STATIC)
+// generated by the "static" Makefile target
+extern const module_static_t MODULES_STATIC_BUF[];
+extern const int             MODULES_STATIC_CNT;
+extern const u64             MODULES_STATIC_STAMP;
+#endif
+
 #if defined (__MINGW64__) || defined (__MINGW32__)
 int _dowildcard = -1;
 #endif
@@ -543,6 +557,7 @@ static void main_outerloop_mainscreen (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx,
 
   event_log_info (hashcat_ctx, "Hashes: %u digests; %u unique digests, %u unique salts", hashes->hashes_cnt_orig, hashes->digests_cnt, hashes->salts_cnt);
   event_log_info (hashcat_ctx, "Bitmaps: %u bits, %u entries, 0x%08x mask, %u bytes, %u/%u rotates", bitmap_ctx->bitmap_bits, bitmap_ctx->bitmap_nums, bitmap_ctx->bitmap_mask, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_shift1, bitmap_ctx->bitmap_shift2);
+  event_log_info (hashcat_ctx, "Bitmaps L1: %u bits, %u bytes, %.2f%% fill, %s", BITMAP_L1_BITS, BITMAP_L1_SIZE, bitmap_ctx->bitmap_l1_fill * 100, (bitmap_ctx->bitmap_l1_enabled == true) ? "enabled" : "disabled");
 
   if ((user_options->attack_mode == ATTACK_MODE_STRAIGHT) || (user_options->attack_mode == ATTACK_MODE_GENERIC) || (user_options->attack_mode == ATTACK_MODE_ASSOCIATION))
   {
@@ -1349,6 +1364,10 @@ int main (int argc, char **argv)
 
   const time_t proc_start = time (NULL);
 
+  #if defined (WITH_MODULES_STATIC)
+  module_static_register (MODULES_STATIC_BUF, MODULES_STATIC_CNT, MODULES_STATIC_STAMP);
+  #endif
+
   // hashcat main context
 
   hashcat_ctx_t *hashcat_ctx = (hashcat_ctx_t *) hcmalloc (sizeof (hashcat_ctx_t));
@@ -1414,7 +1433,7 @@ int main (int argc, char **argv)
   #ifdef WITH_BRAIN
   if (user_options->brain_server == true)
   {
-    const int rc = brain_server (user_options->brain_host, user_options->brain_port, user_options->brain_password, user_options->brain_session_whitelist, user_options->brain_server_timer);
+    const int rc = brain_server (user_options->brain_host, user_options->brain_port, user_options->brain_password, user_options->brain_session_whitelist, user_options->brain_server_timer, user_options->brain_server_lease);
 
     hcfree (hashcat_ctx);
 
@@ -1422,6 +1441,65 @@ int main (int argc, char **argv)
   }
   #endif
 
+  if (user_options->markov_hcstat2_create != NULL)
+  {
+    const int rc = sp_hcstat2_create (hashcat_ctx);
+
+    user_options_destroy (hashcat_ctx);
+
+    hashcat_destroy (hashcat_ctx);
+
+    hcfree (hashcat_ctx);
+
+    return rc;
+  }
+
+  if (user_options->rules_fuzz > 0)
+  {
+    const int rc = rules_fuzz (hashcat_ctx);
+
+    user_options_destroy (hashcat_ctx);
+
+    hashcat_destroy (hashcat_ctx);
+
+    hcfree (hashcat_ctx);
+
+    return rc;
+  }
+
+  if (user_options->rules_optimize_out != NULL)
+  {
+    const int rc = kernel_rules_optimize_out (hashcat_ctx);
+
+    user_options_destroy (hashcat_ctx);
+
+    hashcat_destroy (hashcat_ctx);
+
+    hcfree (hashcat_ctx);
+
+    return rc;
+  }
+
+  if (user_options->potfile_compact == true)
+  {
+    int rc = folder_config_init (hashcat_ctx, install_folder, shared_folder);
+
+    if (rc == 0)
+    {
+      rc = potfile_compact (hashcat_ctx);
+
+      folder_config_destroy (hashcat_ctx);
+    }
+
+    user_options_destroy (hashcat_ctx);
+
+    hashcat_destroy (hashcat_ctx);
+
+    hcfree (hashcat_ctx);
+
+    return rc;
+  }
+
   if (user_options->version == true)
   {
     printf ("%s\n", VERSION_TAG);
@@ -1463,6 +1541,14 @@ int main (int argc, char **argv)
 
       rc_final = 0;
     }
+    else if (user_options->daemon == true)
+    {
+      // keep the devices initialized and run jobs submitted over the daemon socket
+
+      backend_info_compact (hashcat_ctx);
+
+      rc_final = daemon_run (hashcat_ctx, argc, argv);
+    }
     else
     {
       // now execute hashcat
@@ -0,0 +1,601 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "shared.h"
+#include "convert.h"
+#include "cpu_crc32.h"
+#include "filehandling.h"
+#include "modules.h"
+#include "interface.h"
+#include "manifest.h"
+
+#if defined (_WIN) || defined (__CYGWIN__)
+#define MODULE_MANIFEST_SUFFIX ".dll"
+#else
+#define MODULE_MANIFEST_SUFFIX ".so"
+#endif
+
+int sort_by_manifest_entry (const void *p1, const void *p2)
+{
+  const module_manifest_entry_t *e1 = (const module_manifest_entry_t *) p1;
+  const module_manifest_entry_t *e2 = (const module_manifest_entry_t *) p2;
+
+  if (e1->hash_mode > e2->hash_mode) return  1;
+  if (e1->hash_mode < e2->hash_mode) return -1;
+
+  return 0;
+}
+
+static bool module_manifest_parse_filename (const char *file, u32 *hash_mode)
+{
+  // see module_filename ()
+
+  const size_t suffix_len = strlen (MODULE_MANIFEST_SUFFIX);
+
+  if (strlen (file) != (12 + suffix_len)) return false;
+
+  if (memcmp (file, "module_", 7) != 0) return false;
+
+  if (strcmp (file + 12, MODULE_MANIFEST_SUFFIX) != 0) return false;
+
+  u32 mode = 0;
+
+  for (int i = 7; i < 12; i++)
+  {
+    if ((file[i] < '0') || (file[i] > '9')) return false;
+
+    mode = (mode * 10) + (file[i] - '0');
+  }
+
+  *hash_mode = mode;
+
+  return true;
+}
+
+static module_manifest_entry_t *module_manifest_scan (hashcat_ctx_t *hashcat_ctx, int *entries_cnt)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+
+  module_manifest_entry_t *entries_buf = NULL;
+
+  int entries_avail = 0;
+  int entries_pos   = 0;
+
+  // linked in modules change only with the binary, its build time stands in for the file time
+
+  int modules_static_cnt   = 0;
+  u64 modules_static_stamp = 0;
+
+  const module_static_t *modules_static_buf = module_static_list (&modules_static_cnt, &modules_static_stamp);
+
+  if (modules_static_cnt > 0)
+  {
+    entries_buf = (module_manifest_entry_t *) hccalloc (modules_static_cnt, sizeof (module_manifest_entry_t));
+
+    entries_avail = modules_static_cnt;
+
+    for (int i = 0; i < modules_static_cnt; i++)
+    {
+      module_manifest_entry_t *manifest_entry = &entries_buf[entries_pos];
+
+      manifest_entry->hash_mode  = modules_static_buf[i].hash_mode;
+      manifest_entry->file_size  = 0;
+      manifest_entry->file_mtime = modules_static_stamp;
+
+      entries_pos++;
+    }
+  }
+
+  char *modules_folder = NULL;
+
+  hc_asprintf (&modules_folder, "%s/modules", folder_config->shared_dir);
+
+  DIR *dirp = opendir (modules_folder);
+
+  if (dirp == NULL)
+  {
+    hcfree (modules_folder);
+
+    if (entries_pos == 0) return NULL;
+
+    *entries_cnt = entries_pos;
+
+    return entries_buf;
+  }
+
+  char *module_file = (char *) hcmalloc (HCBUFSIZ_TINY);
+
+  struct dirent *entry;
+
+  while ((entry = readdir (dirp)) != NULL)
+  {
+    u32 hash_mode = 0;
+
+    if (module_manifest_parse_filename (entry->d_name, &hash_mode) == false) continue;
+
+    if (hash_mode >= (u32) MODULE_HASH_MODES_MAXIMUM) continue;
+
+    // an overlay file for a linked in hash-mode is never loaded, see module_load ()
+
+    bool is_static = false;
+
+    for (int i = 0; i < modules_static_cnt; i++)
+    {
+      if (modules_static_buf[i].hash_mode == hash_mode) is_static = true;
+    }
+
+    if (is_static == true) continue;
+
+    module_filename (folder_config, (int) hash_mode, module_file, HCBUFSIZ_TINY);
+
+    struct stat s;
+
+    if (stat (module_file, &s) == -1) continue;
+
+    if (entries_pos == entries_avail)
+    {
+      entries_buf = (module_manifest_entry_t *) hcrealloc (entries_buf, entries_avail * sizeof (module_manifest_entry_t), MODULE_MANIFEST_INCR * sizeof (module_manifest_entry_t));
+
+      entries_avail += MODULE_MANIFEST_INCR;
+    }
+
+    module_manifest_entry_t *manifest_entry = &entries_buf[entries_pos];
+
+    manifest_entry->hash_mode  = hash_mode;
+    manifest_entry->file_size  = (u64) s.st_size;
+    manifest_entry->file_mtime = (u64) s.st_mtime;
+
+    entries_pos++;
+  }
+
+  closedir (dirp);
+
+  hcfree (module_file);
+  hcfree (modules_folder);
+
+  if (entries_pos == 0)
+  {
+    hcfree (entries_buf);
+
+    return NULL;
+  }
+
+  qsort (entries_buf, entries_pos, sizeof (module_manifest_entry_t), sort_by_manifest_entry);
+
+  *entries_cnt = entries_pos;
+
+  return entries_buf;
+}
+
+static bool module_manifest_load (const char *manifest_file, module_manifest_entry_t *entries_buf, const int entries_cnt)
+{
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, manifest_file, "rb") == false) return false;
+
+  module_manifest_header_t header;
+
+  const size_t nread_header = hc_fread (&header, sizeof (module_manifest_header_t), 1, &fp);
+
+  bool valid = (nread_header == 1)
+            && (header.magic       == MODULE_MANIFEST_MAGIC)
+            && (header.version     == MODULE_MANIFEST_VERSION)
+            && (header.entries_cnt == (u32) entries_cnt);
+
+  module_manifest_entry_t *cached_buf = NULL;
+
+  if (valid == true)
+  {
+    cached_buf = (module_manifest_entry_t *) hccalloc (entries_cnt, sizeof (module_manifest_entry_t));
+
+    const size_t nread_entries = hc_fread (cached_buf, sizeof (module_manifest_entry_t), entries_cnt, &fp);
+
+    if (nread_entries != (size_t) entries_cnt) valid = false;
+  }
+
+  hc_fclose (&fp);
+
+  // a module added, removed or rebuilt invalidates the whole manifest
+
+  for (int i = 0; (valid == true) && (i < entries_cnt); i++)
+  {
+    if (cached_buf[i].hash_mode  != entries_buf[i].hash_mode)  valid = false;
+    if (cached_buf[i].file_size  != entries_buf[i].file_size)  valid = false;
+    if (cached_buf[i].file_mtime != entries_buf[i].file_mtime) valid = false;
+
+    cached_buf[i].hash_name[sizeof (cached_buf[i].hash_name) - 1] = 0;
+  }
+
+  if (valid == true)
+  {
+    memcpy (entries_buf, cached_buf, entries_cnt * sizeof (module_manifest_entry_t));
+  }
+
+  hcfree (cached_buf);
+
+  return valid;
+}
+
+static void module_manifest_store (hashcat_ctx_t *hashcat_ctx, const char *manifest_file, const module_manifest_entry_t *entries_buf, const int entries_cnt)
+{
+  // write to a temporary file first so that concurrent sessions never read a partially written manifest
+
+  char *manifest_file_tmp = NULL;
+
+  hc_asprintf (&manifest_file_tmp, "%s.tmp", manifest_file);
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, manifest_file_tmp, "wb") == false)
+  {
+    event_log_warning (hashcat_ctx, "%s: %s", manifest_file_tmp, strerror (errno));
+
+    hcfree (manifest_file_tmp);
+
+    return;
+  }
+
+  module_manifest_header_t header;
+
+  memset (&header, 0, sizeof (module_manifest_header_t));
+
+  header.magic       = MODULE_MANIFEST_MAGIC;
+  header.version     = MODULE_MANIFEST_VERSION;
+  header.entries_cnt = (u32) entries_cnt;
+
+  size_t nwritten = 0;
+
+  nwritten += hc_fwrite (&header, sizeof (module_manifest_header_t), 1, &fp);
+  nwritten += hc_fwrite (entries_buf, sizeof (module_manifest_entry_t), entries_cnt, &fp);
+
+  hc_fclose (&fp);
+
+  if (nwritten != (size_t) (1 + entries_cnt))
+  {
+    event_log_warning (hashcat_ctx, "%s: Could not write data.", manifest_file_tmp);
+
+    unlink (manifest_file_tmp);
+  }
+  else if (rename (manifest_file_tmp, manifest_file) != 0)
+  {
+    unlink (manifest_file_tmp);
+  }
+
+  hcfree (manifest_file_tmp);
+}
+
+static void module_manifest_signature (module_manifest_entry_t *manifest_entry, const char *st_hash)
+{
+  manifest_entry->sig_type = MODULE_MANIFEST_SIG_NONE;
+  manifest_entry->sig_char = 0;
+  manifest_entry->sig_len  = 0;
+
+  // for binary hashes the example hash is a filename or some encoded blob
+
+  if (manifest_entry->opts_type & OPTS_TYPE_BINARY_HASHFILE) return;
+
+  if (st_hash == NULL) return;
+
+  const size_t st_len = strlen (st_hash);
+
+  if (st_len == 0) return;
+
+  const u8 c = (const u8) st_hash[0];
+
+  const bool is_alnum = ((c >= '0') && (c <= '9'))
+                     || ((c >= 'a') && (c <= 'z'))
+                     || ((c >= 'A') && (c <= 'Z'));
+
+  if (is_alnum == false)
+  {
+    // leading signature like "$2a$", "{SSHA}" or "*"
+
+    manifest_entry->sig_type = MODULE_MANIFEST_SIG_CHAR;
+    manifest_entry->sig_char = c;
+  }
+  else if (is_valid_hex_string ((const u8 *) st_hash, st_len) == true)
+  {
+    // plain digest, like raw hashes
+
+    manifest_entry->sig_type = MODULE_MANIFEST_SIG_HEX;
+    manifest_entry->sig_len  = (u32) st_len;
+  }
+}
+
+static bool module_manifest_describe (hashcat_ctx_t *hashcat_ctx, module_manifest_entry_t *manifest_entry)
+{
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  // no hashconfig_init () here, the manifest has to be independent of the user options
+
+  module_ctx_t *module_ctx = (module_ctx_t *) hcmalloc (sizeof (module_ctx_t));
+
+  if (module_load (hashcat_ctx, module_ctx, manifest_entry->hash_mode) == false)
+  {
+    hcfree (module_ctx);
+
+    return false;
+  }
+
+  module_ctx->module_init (module_ctx);
+
+  bool valid = (module_ctx->module_context_size      == MODULE_CONTEXT_SIZE_CURRENT)
+            && (module_ctx->module_interface_version >= MODULE_INTERFACE_VERSION_MINIMUM);
+
+  #define MANIFEST_MANDATORY(func) \
+    if ((module_ctx->func == NULL) || (module_ctx->func == MODULE_DEFAULT)) valid = false;
+
+  if (valid == true)
+  {
+    MANIFEST_MANDATORY (module_hash_category);
+    MANIFEST_MANDATORY (module_hash_name);
+    MANIFEST_MANDATORY (module_opts_type);
+    MANIFEST_MANDATORY (module_salt_type);
+    MANIFEST_MANDATORY (module_st_hash);
+  }
+
+  #undef MANIFEST_MANDATORY
+
+  if (valid == true)
+  {
+    hashconfig_t *hashconfig = (hashconfig_t *) hcmalloc (sizeof (hashconfig_t));
+
+    manifest_entry->hash_category = module_ctx->module_hash_category (hashconfig, user_options, user_options_extra);
+    manifest_entry->opts_type     = module_ctx->module_opts_type     (hashconfig, user_options, user_options_extra);
+    manifest_entry->salt_type     = module_ctx->module_salt_type     (hashconfig, user_options, user_options_extra);
+
+    strncpy (manifest_entry->hash_name, module_ctx->module_hash_name (hashconfig, user_options, user_options_extra), sizeof (manifest_entry->hash_name) - 1);
+
+    // bridges can replace the example hash at runtime
+
+    const bool has_bridge = (module_ctx->module_bridge_name != NULL) && (module_ctx->module_bridge_name != MODULE_DEFAULT);
+
+    module_manifest_signature (manifest_entry, (has_bridge == true) ? NULL : module_ctx->module_st_hash (hashconfig, user_options, user_options_extra));
+
+    hcfree (hashconfig);
+  }
+
+  module_unload (module_ctx);
+
+  hcfree (module_ctx);
+
+  return valid;
+}
+
+module_manifest_entry_t *module_manifest_read (hashcat_ctx_t *hashcat_ctx, int *entries_cnt)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+
+  int scan_cnt = 0;
+
+  module_manifest_entry_t *entries_buf = module_manifest_scan (hashcat_ctx, &scan_cnt);
+
+  if (entries_buf == NULL) return NULL;
+
+  // one manifest per installation, the cache folder can be shared by several of them
+
+  const u32 shared_dir_crc32 = cpu_crc32_buffer ((const u8 *) folder_config->shared_dir, strlen (folder_config->shared_dir));
+
+  char *manifest_file = NULL;
+
+  hc_asprintf (&manifest_file, "%s/modules_%08x.manifest", folder_config->cache_dir, shared_dir_crc32);
+
+  bool loaded = false;
+
+  if (hc_path_exist (manifest_file) == true)
+  {
+    loaded = module_manifest_load (manifest_file, entries_buf, scan_cnt);
+  }
+
+  if (loaded == false)
+  {
+    // modules which fail to load keep an empty name, so they are skipped without loading them again on the next run
+
+    for (int i = 0; i < scan_cnt; i++)
+    {
+      if (module_manifest_describe (hashcat_ctx, &entries_buf[i]) == true) continue;
+
+      memset (entries_buf[i].hash_name, 0, sizeof (entries_buf[i].hash_name));
+    }
+
+    module_manifest_store (hashcat_ctx, manifest_file, entries_buf, scan_cnt);
+  }
+
+  hcfree (manifest_file);
+
+  int valid_cnt = 0;
+
+  for (int i = 0; i < scan_cnt; i++)
+  {
+    if (entries_buf[i].hash_name[0] == 0) continue;
+
+    if (valid_cnt != i) entries_buf[valid_cnt] = entries_buf[i];
+
+    valid_cnt++;
+  }
+
+  *entries_cnt = valid_cnt;
+
+  return entries_buf;
+}
+
+bool module_manifest_match (const module_manifest_entry_t *manifest_entry, const char *hash_buf, const int hash_len)
+{
+  if (hash_len < 1) return false;
+
+  if (manifest_entry->sig_type == MODULE_MANIFEST_SIG_CHAR)
+  {
+    return ((u8) hash_buf[0] == manifest_entry->sig_char);
+  }
+
+  if (manifest_entry->sig_type == MODULE_MANIFEST_SIG_HEX)
+  {
+    if ((u32) hash_len == manifest_entry->sig_len) return true;
+
+    return (is_valid_hex_string ((const u8 *) hash_buf, hash_len) == false);
+  }
+
+  return true;
+}
+
+static void module_manifest_summarize (const char *line_buf, const size_t line_len, const char separator, bool *first_chars, bool *any_not_hex, u32 *hex_lens_buf, int *hex_lens_cnt)
+{
+  // the hash can start at the beginning of the line or after any separator, depending on
+  // --username, --separator and the hashlist format, so we look at all of those positions
+
+  int last_not_hex = -1;
+
+  for (size_t i = 0; i < line_len; i++)
+  {
+    if (is_valid_hex_char ((const u8) line_buf[i]) == false) last_not_hex = (int) i;
+  }
+
+  for (size_t pos = 0; pos < line_len; pos++)
+  {
+    if ((pos > 0) && (line_buf[pos - 1] != ':') && (line_buf[pos - 1] != separator)) continue;
+
+    first_chars[(u8) line_buf[pos]] = true;
+
+    if ((int) pos <= last_not_hex)
+    {
+      *any_not_hex = true;
+
+      continue;
+    }
+
+    const u32 hex_len = (u32) (line_len - pos);
+
+    bool known = false;
+
+    for (int i = 0; i < *hex_lens_cnt; i++)
+    {
+      if (hex_lens_buf[i] == hex_len) known = true;
+    }
+
+    if (known == true) continue;
+
+    if (*hex_lens_cnt == MODULE_MANIFEST_SIG_LENS)
+    {
+      *any_not_hex = true; // too many different lengths, disable the length check
+
+      continue;
+    }
+
+    hex_lens_buf[*hex_lens_cnt] = hex_len;
+
+    *hex_lens_cnt = *hex_lens_cnt + 1;
+  }
+}
+
+int module_manifest_filter (hashcat_ctx_t *hashcat_ctx, const module_manifest_entry_t *entries_buf, const int entries_cnt, u32 *modes_buf)
+{
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  const char *hc_hash = user_options_extra->hc_hash;
+
+  bool *first_chars = (bool *) hccalloc (256, sizeof (bool));
+
+  bool any_not_hex = false;
+
+  u32 *hex_lens_buf = (u32 *) hccalloc (MODULE_MANIFEST_SIG_LENS, sizeof (u32));
+  int  hex_lens_cnt = 0;
+
+  // --dynamic-x extracts the hash from the middle of the line
+
+  bool use_signature = (hc_hash != NULL) && (user_options->dynamic_x == false);
+
+  const bool hash_is_file     = (hc_hash != NULL) && (hc_path_exist (hc_hash) == true);
+  const bool hash_is_readable = (hc_hash != NULL) && (hc_path_read  (hc_hash) == true);
+
+  if (hash_is_file == true)
+  {
+    // autodetect_hashmode_test () gives up after 100 parser errors, so the head of the file is enough
+
+    HCFILE fp;
+
+    if (hc_fopen (&fp, hc_hash, "rb") == true)
+    {
+      char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+      int lines_cnt = 0;
+
+      while (!hc_feof (&fp))
+      {
+        const size_t line_len = fgetl (&fp, line_buf, HCBUFSIZ_LARGE);
+
+        if (line_len == 0) continue;
+
+        module_manifest_summarize (line_buf, line_len, user_options_extra->separator, first_chars, &any_not_hex, hex_lens_buf, &hex_lens_cnt);
+
+        if (++lines_cnt == MODULE_MANIFEST_SIG_LINES) break;
+      }
+
+      hcfree (line_buf);
+
+      hc_fclose (&fp);
+    }
+    else
+    {
+      use_signature = false;
+    }
+  }
+  else if (hc_hash != NULL)
+  {
+    module_manifest_summarize (hc_hash, strlen (hc_hash), user_options_extra->separator, first_chars, &any_not_hex, hex_lens_buf, &hex_lens_cnt);
+  }
+
+  int modes_cnt = 0;
+
+  for (int i = 0; i < entries_cnt; i++)
+  {
+    const module_manifest_entry_t *manifest_entry = &entries_buf[i];
+
+    if (manifest_entry->opts_type & OPTS_TYPE_AUTODETECT_DISABLE) continue;
+
+    if (manifest_entry->opts_type & OPTS_TYPE_BINARY_HASHFILE)
+    {
+      if ((manifest_entry->opts_type & OPTS_TYPE_BINARY_HASHFILE_OPTIONAL) == 0)
+      {
+        if (hash_is_readable == false) continue;
+      }
+    }
+    else if (use_signature == true)
+    {
+      if (manifest_entry->sig_type == MODULE_MANIFEST_SIG_CHAR)
+      {
+        if (first_chars[manifest_entry->sig_char & 0xff] == false) continue;
+      }
+      else if (manifest_entry->sig_type == MODULE_MANIFEST_SIG_HEX)
+      {
+        if (any_not_hex == false)
+        {
+          bool found = false;
+
+          for (int j = 0; j < hex_lens_cnt; j++)
+          {
+            if (hex_lens_buf[j] == manifest_entry->sig_len) found = true;
+          }
+
+          if (found == false) continue;
+        }
+      }
+    }
+
+    modes_buf[modes_cnt] = manifest_entry->hash_mode;
+
+    modes_cnt++;
+  }
+
+  hcfree (first_chars);
+  hcfree (hex_lens_buf);
+
+  return modes_cnt;
+}
@@ -0,0 +1,627 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "shared.h"
+#include "thread.h"
+#include "timer.h"
+#include "status.h"
+#include "metrics.h"
+
+#if defined (_WIN)
+
+int metrics_init (hashcat_ctx_t *hashcat_ctx)
+{
+  metrics_ctx_t  *metrics_ctx  = hashcat_ctx->metrics_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  metrics_ctx->enabled = false;
+
+  if ((user_options->metrics_port == 0) && (user_options->metrics_socket == NULL)) return 0;
+
+  event_log_error (hashcat_ctx, "Metrics export is not supported on Windows.");
+
+  return -1;
+}
+
+void metrics_destroy (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+}
+
+void metrics_update (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+}
+
+#else
+
+/**
+ * The page is rendered once per second by the monitor thread and kept in metrics_ctx->page_buf.
+ * The server thread only copies it under mux_page, so a scrape never reads device state,
+ * never takes a lock of the compute threads and never waits for a kernel to finish.
+ */
+
+static void metrics_printf (char **buf, size_t *len, size_t *size, const char *fmt, ...)
+{
+  va_list args;
+
+  while (true)
+  {
+    va_start (args, fmt);
+
+    const int need = vsnprintf (*buf + *len, *size - *len, fmt, args);
+
+    va_end (args);
+
+    if (need < 0) return;
+
+    if ((size_t) need < *size - *len)
+    {
+      *len += need;
+
+      return;
+    }
+
+    *buf = (char *) hcrealloc (*buf, *size, METRICS_PAGE_SIZE + need);
+
+    *size += METRICS_PAGE_SIZE + need;
+  }
+}
+
+static void metrics_family (char **buf, size_t *len, size_t *size, const char *name, const char *type, const char *help)
+{
+  metrics_printf (buf, len, size, "# TYPE %s %s\n", name, type);
+  metrics_printf (buf, len, size, "# HELP %s %s\n", name, help);
+}
+
+static bool metrics_device_active (const hc_device_param_t *device_param)
+{
+  if (device_param->skipped         == true) return false;
+  if (device_param->skipped_warning == true) return false;
+
+  return true;
+}
+
+#ifdef WITH_BRAIN
+static u64 metrics_link_bytes_sec (const link_speed_t *link_speed)
+{
+  u64 bytes = 0;
+
+  for (int idx = 0; idx < LINK_SPEED_COUNT; idx++)
+  {
+    const double ms = hc_timer_get (link_speed->timer[idx]);
+
+    if (ms >= 1000) continue;
+
+    bytes += link_speed->bytes[idx];
+  }
+
+  return bytes;
+}
+#endif
+
+void metrics_update (hashcat_ctx_t *hashcat_ctx)
+{
+  const backend_ctx_t  *backend_ctx  = hashcat_ctx->backend_ctx;
+        metrics_ctx_t  *metrics_ctx  = hashcat_ctx->metrics_ctx;
+  const status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
+
+  if (metrics_ctx->enabled == false) return;
+
+  if (status_ctx->accessible == false) return;
+
+  // the progress of status.c starts over with each queue entry, add the finished entries so the counters never go down
+
+  hc_thread_mutex_lock (hashcat_ctx->status_ctx->mux_counter);
+
+  const u64 candidates_total          = status_ctx->words_progress_done_session     + status_get_progress_done     (hashcat_ctx);
+  const u64 candidates_rejected_total = status_ctx->words_progress_rejected_session + status_get_progress_rejected (hashcat_ctx);
+
+  hc_thread_mutex_unlock (hashcat_ctx->status_ctx->mux_counter);
+
+  size_t size = METRICS_PAGE_SIZE;
+  size_t len  = 0;
+
+  char *buf = (char *) hcmalloc (size);
+
+  // session
+
+  metrics_family (&buf, &len, &size, "hashcat_status", "gauge", "Session status number, as reported by --status-json");
+  metrics_printf (&buf, &len, &size, "hashcat_status %d\n", status_get_status_number (hashcat_ctx));
+
+  metrics_family (&buf, &len, &size, "hashcat_digests", "gauge", "Number of unique digests loaded");
+  metrics_printf (&buf, &len, &size, "hashcat_digests %d\n", status_get_digests_cnt (hashcat_ctx));
+
+  metrics_family (&buf, &len, &size, "hashcat_digests_cracked", "counter", "Number of digests cracked, including potfile hits");
+  metrics_printf (&buf, &len, &size, "hashcat_digests_cracked_total %d\n", status_get_digests_done (hashcat_ctx));
+
+  metrics_family (&buf, &len, &size, "hashcat_salts", "gauge", "Number of unique salts loaded");
+  metrics_printf (&buf, &len, &size, "hashcat_salts %d\n", status_get_salts_cnt (hashcat_ctx));
+
+  metrics_family (&buf, &len, &size, "hashcat_salts_done", "gauge", "Number of salts with all digests cracked");
+  metrics_printf (&buf, &len, &size, "hashcat_salts_done %d\n", status_get_salts_done (hashcat_ctx));
+
+  metrics_family (&buf, &len, &size, "hashcat_candidates", "counter", "Candidates processed in all queue entries of the session, multiplied by salts");
+  metrics_printf (&buf, &len, &size, "hashcat_candidates_total %" PRIu64 "\n", candidates_total);
+
+  metrics_family (&buf, &len, &size, "hashcat_candidates_rejected", "counter", "Candidates rejected by length or rules in all queue entries of the session, multiplied by salts");
+  metrics_printf (&buf, &len, &size, "hashcat_candidates_rejected_total %" PRIu64 "\n", candidates_rejected_total);
+
+  metrics_family (&buf, &len, &size, "hashcat_queue_position", "gauge", "Position of the current wordlist or mask in the queue");
+  metrics_printf (&buf, &len, &size, "hashcat_queue_position %d\n", status_get_guess_base_offset (hashcat_ctx));
+
+  metrics_family (&buf, &len, &size, "hashcat_queue_length", "gauge", "Number of wordlists or masks in the queue");
+  metrics_printf (&buf, &len, &size, "hashcat_queue_length %d\n", status_get_guess_base_count (hashcat_ctx));
+
+  metrics_family (&buf, &len, &size, "hashcat_speed_hashes_per_second", "gauge", "Combined speed of all devices");
+  metrics_printf (&buf, &len, &size, "hashcat_speed_hashes_per_second %.3f\n", status_get_hashes_msec_all (hashcat_ctx) * 1000);
+
+  // devices
+
+  metrics_family (&buf, &len, &size, "hashcat_device_speed_hashes_per_second", "gauge", "Speed of the device");
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    if (metrics_device_active (&backend_ctx->devices_param[backend_devices_idx]) == false) continue;
+
+    metrics_printf (&buf, &len, &size, "hashcat_device_speed_hashes_per_second{device=\"%d\"} %.3f\n", backend_devices_idx + 1, status_get_hashes_msec_dev (hashcat_ctx, backend_devices_idx) * 1000);
+  }
+
+  metrics_family (&buf, &len, &size, "hashcat_device_exec_seconds", "gauge", "Average kernel execution time of the device");
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    if (metrics_device_active (&backend_ctx->devices_param[backend_devices_idx]) == false) continue;
+
+    metrics_printf (&buf, &len, &size, "hashcat_device_exec_seconds{device=\"%d\"} %.6f\n", backend_devices_idx + 1, status_get_exec_msec_dev (hashcat_ctx, backend_devices_idx) / 1000);
+  }
+
+  metrics_family (&buf, &len, &size, "hashcat_device_kernel_accel", "gauge", "Kernel accel of the device");
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    if (metrics_device_active (&backend_ctx->devices_param[backend_devices_idx]) == false) continue;
+
+    metrics_printf (&buf, &len, &size, "hashcat_device_kernel_accel{device=\"%d\"} %d\n", backend_devices_idx + 1, status_get_kernel_accel_dev (hashcat_ctx, backend_devices_idx));
+  }
+
+  metrics_family (&buf, &len, &size, "hashcat_device_kernel_loops", "gauge", "Kernel loops of the device");
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    if (metrics_device_active (&backend_ctx->devices_param[backend_devices_idx]) == false) continue;
+
+    metrics_printf (&buf, &len, &size, "hashcat_device_kernel_loops{device=\"%d\"} %d\n", backend_devices_idx + 1, status_get_kernel_loops_dev (hashcat_ctx, backend_devices_idx));
+  }
+
+  metrics_family (&buf, &len, &size, "hashcat_device_kernel_threads", "gauge", "Kernel threads of the device");
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    if (metrics_device_active (&backend_ctx->devices_param[backend_devices_idx]) == false) continue;
+
+    metrics_printf (&buf, &len, &size, "hashcat_device_kernel_threads{device=\"%d\"} %d\n", backend_devices_idx + 1, status_get_kernel_threads_dev (hashcat_ctx, backend_devices_idx));
+  }
+
+  metrics_family (&buf, &len, &size, "hashcat_device_vector_width", "gauge", "Vector width of the device");
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    if (metrics_device_active (&backend_ctx->devices_param[backend_devices_idx]) == false) continue;
+
+    metrics_printf (&buf, &len, &size, "hashcat_device_vector_width{device=\"%d\"} %d\n", backend_devices_idx + 1, status_get_vector_width_dev (hashcat_ctx, backend_devices_idx));
+  }
+
+  metrics_family (&buf, &len, &size, "hashcat_device_dispatcher_wait_seconds", "counter", "Time the device spent waiting for the dispatcher to hand out work");
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    const hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+    if (metrics_device_active (device_param) == false) continue;
+
+    metrics_printf (&buf, &len, &size, "hashcat_device_dispatcher_wait_seconds_total{device=\"%d\"} %.6f\n", backend_devices_idx + 1, device_param->dispatcher_wait_msec / 1000);
+  }
+
+  #ifdef WITH_BRAIN
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (user_options->brain_client == true)
+  {
+    metrics_family (&buf, &len, &size, "hashcat_device_brain_link_recv_bytes", "counter", "Bytes received from the brain server");
+
+    for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+    {
+      const hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+      if (metrics_device_active (device_param) == false) continue;
+
+      metrics_printf (&buf, &len, &size, "hashcat_device_brain_link_recv_bytes_total{device=\"%d\"} %" PRIu64 "\n", backend_devices_idx + 1, device_param->brain_link_recv_bytes);
+    }
+
+    metrics_family (&buf, &len, &size, "hashcat_device_brain_link_send_bytes", "counter", "Bytes sent to the brain server");
+
+    for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+    {
+      const hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+      if (metrics_device_active (device_param) == false) continue;
+
+      metrics_printf (&buf, &len, &size, "hashcat_device_brain_link_send_bytes_total{device=\"%d\"} %" PRIu64 "\n", backend_devices_idx + 1, device_param->brain_link_send_bytes);
+    }
+
+    metrics_family (&buf, &len, &size, "hashcat_device_brain_link_recv_bytes_per_second", "gauge", "Receive rate of the brain link over the last second");
+
+    for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+    {
+      const hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+      if (metrics_device_active (device_param) == false) continue;
+
+      metrics_printf (&buf, &len, &size, "hashcat_device_brain_link_recv_bytes_per_second{device=\"%d\"} %" PRIu64 "\n", backend_devices_idx + 1, metrics_link_bytes_sec (&device_param->brain_link_recv_speed));
+    }
+
+    metrics_family (&buf, &len, &size, "hashcat_device_brain_link_send_bytes_per_second", "gauge", "Send rate of the brain link over the last second");
+
+    for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+    {
+      const hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+      if (metrics_device_active (device_param) == false) continue;
+
+      metrics_printf (&buf, &len, &size, "hashcat_device_brain_link_send_bytes_per_second{device=\"%d\"} %" PRIu64 "\n", backend_devices_idx + 1, metrics_link_bytes_sec (&device_param->brain_link_send_speed));
+    }
+  }
+  #endif
+
+  metrics_printf (&buf, &len, &size, "# EOF\n");
+
+  hc_thread_mutex_lock (metrics_ctx->mux_page);
+
+  char *page_old = metrics_ctx->page_buf;
+
+  metrics_ctx->page_buf = buf;
+  metrics_ctx->page_len = len;
+
+  hc_thread_mutex_unlock (metrics_ctx->mux_page);
+
+  hcfree (page_old);
+}
+
+static bool metrics_send_all (const int fd, const char *buf, const size_t len)
+{
+  size_t sent = 0;
+
+  while (sent < len)
+  {
+    const ssize_t rc = send (fd, buf + sent, len - sent, METRICS_SEND_FLAGS);
+
+    if (rc <= 0) return false;
+
+    sent += rc;
+  }
+
+  return true;
+}
+
+static void metrics_client (metrics_ctx_t *metrics_ctx, const int fd)
+{
+  // a stuck client must not keep the server thread from noticing the shutdown
+
+  struct timeval tv;
+
+  tv.tv_sec  = METRICS_RECV_MSEC / 1000;
+  tv.tv_usec = (METRICS_RECV_MSEC % 1000) * 1000;
+
+  setsockopt (fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof (tv));
+  setsockopt (fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof (tv));
+
+  #if defined (__APPLE__)
+  int one = 1;
+
+  setsockopt (fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof (one));
+  #endif
+
+  char request[METRICS_REQUEST_SIZE];
+
+  size_t request_len = 0;
+
+  while (request_len < sizeof (request) - 1)
+  {
+    const ssize_t rc = recv (fd, request + request_len, sizeof (request) - 1 - request_len, 0);
+
+    if (rc <= 0) break;
+
+    request_len += rc;
+
+    request[request_len] = 0;
+
+    if (strstr (request, "\r\n\r\n") != NULL) break;
+    if (strstr (request, "\n\n")     != NULL) break;
+  }
+
+  if (request_len == 0) return;
+
+  request[request_len] = 0;
+
+  // only the request line matters, everything but GET /metrics (or /) is not found
+
+  bool found = false;
+
+  if (strncmp (request, "GET ", 4) == 0)
+  {
+    const char *path = request + 4;
+
+    const size_t path_len = strcspn (path, " ?\r\n");
+
+    if ((path_len == 1) && (path[0] == '/'))                         found = true;
+    if ((path_len == 8) && (strncmp (path, "/metrics", 8) == 0))     found = true;
+  }
+
+  if (found == false)
+  {
+    const char *response = "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 10\r\nConnection: close\r\n\r\nNot Found\n";
+
+    metrics_send_all (fd, response, strlen (response));
+
+    return;
+  }
+
+  hc_thread_mutex_lock (metrics_ctx->mux_page);
+
+  size_t page_len = metrics_ctx->page_len;
+
+  char *page_buf = (char *) hcmalloc (page_len + 1);
+
+  if (page_len) memcpy (page_buf, metrics_ctx->page_buf, page_len);
+
+  hc_thread_mutex_unlock (metrics_ctx->mux_page);
+
+  // nothing rendered yet, the session is still starting up
+
+  if (page_len == 0)
+  {
+    hcfree (page_buf);
+
+    page_buf = hcstrdup ("# EOF\n");
+    page_len = strlen (page_buf);
+  }
+
+  char header[256];
+
+  const int header_len = snprintf (header, sizeof (header), "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n", METRICS_CONTENT_TYPE, page_len);
+
+  if (metrics_send_all (fd, header, header_len) == true)
+  {
+    metrics_send_all (fd, page_buf, page_len);
+  }
+
+  hcfree (page_buf);
+}
+
+static HC_API_CALL void *thread_metrics (void *p)
+{
+  metrics_ctx_t *metrics_ctx = (metrics_ctx_t *) p;
+
+  while (metrics_ctx->shutdown == false)
+  {
+    struct pollfd pfd;
+
+    pfd.fd      = metrics_ctx->server_fd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    const int rc_poll = poll (&pfd, 1, METRICS_POLL_MSEC);
+
+    if (rc_poll <= 0) continue;
+
+    const int client_fd = accept (metrics_ctx->server_fd, NULL, NULL);
+
+    if (client_fd == -1) continue;
+
+    metrics_client (metrics_ctx, client_fd);
+
+    close (client_fd);
+  }
+
+  return NULL;
+}
+
+static int metrics_socket_tcp (hashcat_ctx_t *hashcat_ctx, const u32 port)
+{
+  const int fd = socket (AF_INET, SOCK_STREAM, 0);
+
+  if (fd == -1)
+  {
+    event_log_error (hashcat_ctx, "socket: %s", strerror (errno));
+
+    return -1;
+  }
+
+  int one = 1;
+
+  if (setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof (one)) == -1)
+  {
+    event_log_error (hashcat_ctx, "setsockopt: %s", strerror (errno));
+
+    close (fd);
+
+    return -1;
+  }
+
+  // the endpoint is unauthenticated, so it is never reachable from outside the host
+
+  struct sockaddr_in addr;
+
+  memset (&addr, 0, sizeof (addr));
+
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons ((u16) port);
+  addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+
+  if (bind (fd, (struct sockaddr *) &addr, sizeof (addr)) == -1)
+  {
+    event_log_error (hashcat_ctx, "Metrics port %u: %s", port, strerror (errno));
+
+    close (fd);
+
+    return -1;
+  }
+
+  return fd;
+}
+
+static int metrics_socket_unix (hashcat_ctx_t *hashcat_ctx, const char *socket_path)
+{
+  struct sockaddr_un addr;
+
+  memset (&addr, 0, sizeof (addr));
+
+  addr.sun_family = AF_UNIX;
+
+  if (strlen (socket_path) >= sizeof (addr.sun_path))
+  {
+    event_log_error (hashcat_ctx, "%s: Socket path is too long.", socket_path);
+
+    return -1;
+  }
+
+  strncpy (addr.sun_path, socket_path, sizeof (addr.sun_path) - 1);
+
+  const int fd = socket (AF_UNIX, SOCK_STREAM, 0);
+
+  if (fd == -1)
+  {
+    event_log_error (hashcat_ctx, "socket: %s", strerror (errno));
+
+    return -1;
+  }
+
+  // a left-over socket of a session which did not shut down cleanly is replaced, a live one is not
+
+  struct stat s;
+
+  if (lstat (socket_path, &s) == 0)
+  {
+    if (S_ISSOCK (s.st_mode) == 0)
+    {
+      event_log_error (hashcat_ctx, "%s: Not a socket.", socket_path);
+
+      close (fd);
+
+      return -1;
+    }
+
+    if (connect (fd, (struct sockaddr *) &addr, sizeof (addr)) == 0)
+    {
+      event_log_error (hashcat_ctx, "%s: Another session is already listening.", socket_path);
+
+      close (fd);
+
+      return -1;
+    }
+
+    unlink (socket_path);
+  }
+
+  if (bind (fd, (struct sockaddr *) &addr, sizeof (addr)) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", socket_path, strerror (errno));
+
+    close (fd);
+
+    return -1;
+  }
+
+  return fd;
+}
+
+int metrics_init (hashcat_ctx_t *hashcat_ctx)
+{
+  metrics_ctx_t  *metrics_ctx  = hashcat_ctx->metrics_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  metrics_ctx->enabled = false;
+
+  if (user_options->backend_info   > 0)    return 0;
+  if (user_options->hash_info      > 0)    return 0;
+  if (user_options->usage          > 0)    return 0;
+  if (user_options->version       == true) return 0;
+  if (user_options->identify      == true) return 0;
+
+  // the daemon itself is idle, each of its jobs serves the endpoint
+
+  if (user_options->daemon        == true) return 0;
+
+  if ((user_options->metrics_port == 0) && (user_options->metrics_socket == NULL)) return 0;
+
+  int fd = -1;
+
+  if (user_options->metrics_socket == NULL)
+  {
+    fd = metrics_socket_tcp (hashcat_ctx, user_options->metrics_port);
+  }
+  else
+  {
+    fd = metrics_socket_unix (hashcat_ctx, user_options->metrics_socket);
+  }
+
+  if (fd == -1) return -1;
+
+  if (listen (fd, 8) == -1)
+  {
+    event_log_error (hashcat_ctx, "listen: %s", strerror (errno));
+
+    close (fd);
+
+    if (user_options->metrics_socket != NULL) unlink (user_options->metrics_socket);
+
+    return -1;
+  }
+
+  metrics_ctx->server_fd   = fd;
+  metrics_ctx->socket_path = (user_options->metrics_socket == NULL) ? NULL : hcstrdup (user_options->metrics_socket);
+  metrics_ctx->shutdown    = false;
+  metrics_ctx->page_buf    = NULL;
+  metrics_ctx->page_len    = 0;
+
+  hc_thread_mutex_init (metrics_ctx->mux_page);
+
+  hc_thread_create (metrics_ctx->thread, thread_metrics, metrics_ctx);
+
+  metrics_ctx->enabled = true;
+
+  return 0;
+}
+
+void metrics_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  metrics_ctx_t *metrics_ctx = hashcat_ctx->metrics_ctx;
+
+  if (metrics_ctx->enabled == false) return;
+
+  metrics_ctx->shutdown = true;
+
+  hc_thread_wait (1, &metrics_ctx->thread);
+
+  close (metrics_ctx->server_fd);
+
+  if (metrics_ctx->socket_path != NULL)
+  {
+    unlink (metrics_ctx->socket_path);
+
+    hcfree (metrics_ctx->socket_path);
+  }
+
+  hc_thread_mutex_delete (metrics_ctx->mux_page);
+
+  hcfree (metrics_ctx->page_buf);
+
+  memset (metrics_ctx, 0, sizeof (metrics_ctx_t));
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include "thread.h"
 #include "restore.h"
 #include "status.h"
+#include "metrics.h"
 #include "monitor.h"
 
 int get_runtime_left (const hashcat_ctx_t *hashcat_ctx)
@@ -45,6 +46,7 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
   bridge_ctx_t   *bridge_ctx    = hashcat_ctx->bridge_ctx;
   hashes_t       *hashes        = hashcat_ctx->hashes;
   hwmon_ctx_t    *hwmon_ctx     = hashcat_ctx->hwmon_ctx;
+  metrics_ctx_t  *metrics_ctx   = hashcat_ctx->metrics_ctx;
   backend_ctx_t  *backend_ctx   = hashcat_ctx->backend_ctx;
   restore_ctx_t  *restore_ctx   = hashcat_ctx->restore_ctx;
   status_ctx_t   *status_ctx    = hashcat_ctx->status_ctx;
@@ -55,6 +57,7 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
   bool status_check       = false;
   bool restore_check      = false;
   bool hwmon_check        = false;
+  bool metrics_check      = false;
   bool performance_check  = false;
   bool performance_warned = false;
 
@@ -95,7 +98,12 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
-  if ((runtime_check == false) && (remove_check == false) && (status_check == false) && (restore_check == false) && (hwmon_check == false) && (performance_check == false))
+  if (metrics_ctx->enabled == true)
+  {
+    metrics_check = true;
+  }
+
+  if ((runtime_check == false) && (remove_check == false) && (status_check == false) && (restore_check == false) && (hwmon_check == false) && (performance_check == false) && (metrics_check == false))
   {
     return 0;
   }
@@ -250,6 +258,11 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
       }
     }
 
+    if (metrics_check == true)
+    {
+      metrics_update (hashcat_ctx);
+    }
+
     if (performance_check == true && status_ctx->devices_status == STATUS_RUNNING && performance_warned == false)
     {
       int exec_cnt = 0;
@@ -392,6 +405,13 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  // final round of metrics, so a last scrape sees the final counters
+
+  if (metrics_check == true)
+  {
+    metrics_update (hashcat_ctx);
+  }
+
   // final round of cycle_restore
 
   if (restore_check == true)
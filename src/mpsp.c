@@ -13,9 +13,16 @@
 #include "filehandling.h"
 #include "backend.h"
 #include "shared.h"
+#include "thread.h"
 #include "ext_lzma.h"
+#include "cpu_crc32.h"
 #include "mpsp.h"
 
+#if defined (_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
 static const char *const DEF_MASK = "?1?2?2?2?2?2?2?3?3?3?3?d?d?d?d";
 
 #define MAX_MFS 9 // 8*charset, 1*mask
@@ -672,55 +679,164 @@ static void mp_reset_usr (cs_t *mp_usr, const u32 userindex)
   memset (mp_usr[userindex].cs_buf, 0, sizeof (mp_usr[userindex].cs_buf));
 }
 
-static int sp_setup_tbl (hashcat_ctx_t *hashcat_ctx)
+static void sp_stats_to_tbl (const u64 *stats_buf, u8 *tbl_buf)
 {
-  folder_config_t *folder_config = hashcat_ctx->folder_config;
-  mask_ctx_t      *mask_ctx      = hashcat_ctx->mask_ctx;
-  user_options_t  *user_options  = hashcat_ctx->user_options;
+  hcstat_table_t tmp_buf[CHARSIZ];
 
-  char *shared_dir = folder_config->shared_dir;
+  for (int i = 0; i < CHARSIZ; i++)
+  {
+    tmp_buf[i].key = i;
+    tmp_buf[i].val = stats_buf[i];
+  }
 
-  char *hcstat  = user_options->markov_hcstat2;
-  u32   markov  = user_options->markov;
-  u32   classic = user_options->markov_classic;
-  bool  inverse = user_options->markov_inverse;
+  qsort (tmp_buf, CHARSIZ, sizeof (hcstat_table_t), sp_comp_val);
 
-  hcstat_table_t *root_table_buf   = mask_ctx->root_table_buf;
-  hcstat_table_t *markov_table_buf = mask_ctx->markov_table_buf;
+  for (int i = 0; i < CHARSIZ; i++)
+  {
+    tbl_buf[i] = (u8) tmp_buf[i].key;
+  }
+}
 
-  /**
-   * Initialize hcstats
-   */
+static void sp_tbl_unmap (mask_ctx_t *mask_ctx)
+{
+  if (mask_ctx->tbl_buf == NULL) return;
 
-  u64 *root_stats_buf = (u64 *) hccalloc (SP_ROOT_CNT, sizeof (u64));
+  #if defined (_POSIX)
+  if (mask_ctx->tbl_mapped == true)
+  {
+    munmap (mask_ctx->tbl_buf, SP_CACHE_FILESZ);
+  }
+  else
+  #endif
+  {
+    hcfree (mask_ctx->tbl_buf);
+  }
 
-  u64 *root_stats_ptr = root_stats_buf;
+  mask_ctx->tbl_buf    = NULL;
+  mask_ctx->tbl_mapped = false;
 
-  u64 *root_stats_buf_by_pos[SP_PW_MAX];
+  mask_ctx->root_table_buf   = NULL;
+  mask_ctx->markov_table_buf = NULL;
+}
 
-  for (int i = 0; i < SP_PW_MAX; i++)
+static void sp_tbl_assign (mask_ctx_t *mask_ctx, u8 *tbl_buf, const bool tbl_mapped)
+{
+  mask_ctx->tbl_buf    = tbl_buf;
+  mask_ctx->tbl_mapped = tbl_mapped;
+
+  mask_ctx->root_table_buf   = tbl_buf + sizeof (sp_cache_header_t);
+  mask_ctx->markov_table_buf = tbl_buf + sizeof (sp_cache_header_t) + SP_ROOT_CNT;
+}
+
+static int sp_cache_load (hashcat_ctx_t *hashcat_ctx, const char *cache_file, const sp_cache_header_t *header)
+{
+  mask_ctx_t *mask_ctx = hashcat_ctx->mask_ctx;
+
+  struct stat st;
+
+  if (stat (cache_file, &st) == -1) return -1;
+
+  if ((size_t) st.st_size != SP_CACHE_FILESZ) return -1;
+
+  #if defined (_POSIX)
+
+  const int fd = open (cache_file, O_RDONLY);
+
+  if (fd == -1) return -1;
+
+  void *map = mmap (NULL, SP_CACHE_FILESZ, PROT_READ, MAP_SHARED, fd, 0);
+
+  close (fd);
+
+  if (map == MAP_FAILED) return -1;
+
+  if (memcmp (map, header, sizeof (sp_cache_header_t)) != 0)
   {
-    root_stats_buf_by_pos[i] = root_stats_ptr;
+    munmap (map, SP_CACHE_FILESZ);
 
-    root_stats_ptr += CHARSIZ;
+    return -1;
   }
 
-  u64 *markov_stats_buf = (u64 *) hccalloc (SP_MARKOV_CNT, sizeof (u64));
+  sp_tbl_assign (mask_ctx, (u8 *) map, true);
 
-  u64 *markov_stats_ptr = markov_stats_buf;
+  #else
 
-  u64 *markov_stats_buf_by_key[SP_PW_MAX][CHARSIZ];
+  HCFILE fp;
 
-  for (int i = 0; i < SP_PW_MAX; i++)
+  if (hc_fopen_raw (&fp, cache_file, "rb") == false) return -1;
+
+  u8 *tbl_buf = (u8 *) hcmalloc (SP_CACHE_FILESZ);
+
+  const size_t nread = hc_fread (tbl_buf, 1, SP_CACHE_FILESZ, &fp);
+
+  hc_fclose (&fp);
+
+  if ((nread != SP_CACHE_FILESZ) || (memcmp (tbl_buf, header, sizeof (sp_cache_header_t)) != 0))
   {
-    for (int j = 0; j < CHARSIZ; j++)
-    {
-      markov_stats_buf_by_key[i][j] = markov_stats_ptr;
+    hcfree (tbl_buf);
 
-      markov_stats_ptr += CHARSIZ;
-    }
+    return -1;
+  }
+
+  sp_tbl_assign (mask_ctx, tbl_buf, false);
+
+  #endif
+
+  return 0;
+}
+
+static void sp_cache_store (hashcat_ctx_t *hashcat_ctx, const char *cache_file)
+{
+  const mask_ctx_t *mask_ctx = hashcat_ctx->mask_ctx;
+
+  // write to a temporary file first so that concurrent sessions never map a partially written cache
+
+  char *cache_file_tmp = NULL;
+
+  hc_asprintf (&cache_file_tmp, "%s.tmp", cache_file);
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, cache_file_tmp, "wb") == false)
+  {
+    event_log_warning (hashcat_ctx, "%s: %s", cache_file_tmp, strerror (errno));
+
+    hcfree (cache_file_tmp);
+
+    return;
+  }
+
+  const size_t nwritten = hc_fwrite (mask_ctx->tbl_buf, 1, SP_CACHE_FILESZ, &fp);
+
+  hc_fclose (&fp);
+
+  if (nwritten != SP_CACHE_FILESZ)
+  {
+    event_log_warning (hashcat_ctx, "%s: Could not write data.", cache_file_tmp);
+
+    unlink (cache_file_tmp);
+  }
+  else if (rename (cache_file_tmp, cache_file) != 0)
+  {
+    unlink (cache_file_tmp);
   }
 
+  hcfree (cache_file_tmp);
+}
+
+static int sp_setup_tbl (hashcat_ctx_t *hashcat_ctx)
+{
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+  mask_ctx_t      *mask_ctx      = hashcat_ctx->mask_ctx;
+  user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  char *shared_dir = folder_config->shared_dir;
+
+  char *hcstat  = user_options->markov_hcstat2;
+  u32   markov  = user_options->markov;
+  u32   classic = user_options->markov_classic;
+  bool  inverse = user_options->markov_inverse;
+
   /**
    * Load hcstats File
    */
@@ -769,29 +885,53 @@ static int sp_setup_tbl (hashcat_ctx_t *hashcat_ctx)
 
   hc_fclose (&fp);
 
-  u8 *outbuf = (u8 *) hcmalloc (SP_FILESZ);
+  /**
+   * The sorted tables only depend on the hcstat2 content and the markov modifiers.
+   * The threshold is applied later in sp_tbl_to_css(), so the cache can be shared across thresholds.
+   */
 
-  SizeT outlen = SP_FILESZ;
+  sp_cache_header_t header;
 
-  const char props = 0x1c; // lzma properties constant, retrieved with 7z2hashcat
+  memset (&header, 0, sizeof (header));
 
-  const SRes res = hc_lzma2_decompress (inbuf, &inlen, outbuf, &outlen, &props);
+  header.version      = SP_CACHE_VERSION;
+  header.hcstat_crc32 = cpu_crc32_buffer (inbuf, inlen);
+  header.hcstat_size  = (u32) inlen;
+  header.markov       = (markov  == true) ? 1 : 0;
+  header.classic      = (classic == true) ? 1 : 0;
+  header.inverse      = (inverse == true) ? 1 : 0;
 
-  if (res != SZ_OK)
-  {
-    event_log_error (hashcat_ctx, "%s: Could not uncompress data.", hcstat);
+  char *cache_file = NULL;
+
+  hc_asprintf (&cache_file, "%s/%s/%08x_%u%u%u.hctbl", folder_config->cache_dir, SP_CACHE_FOLDER, header.hcstat_crc32, header.markov, header.classic, header.inverse);
 
+  if (sp_cache_load (hashcat_ctx, cache_file, &header) == 0)
+  {
+    hcfree (cache_file);
     hcfree (inbuf);
-    hcfree (outbuf);
 
-    return -1;
+    return 0;
   }
 
-  if (outlen != SP_FILESZ)
+  /**
+   * Cache miss, decompress hcstats
+   */
+
+  u8 *outbuf = (u8 *) hcmalloc (SP_FILESZ);
+
+  SizeT outlen = SP_FILESZ;
+
+  const char props = 0x1c; // lzma properties constant, retrieved with 7z2hashcat
+
+  const SRes res = hc_lzma2_decompress (inbuf, &inlen, outbuf, &outlen, &props);
+
+  hcfree (inbuf);
+
+  if ((res != SZ_OK) || (outlen != SP_FILESZ))
   {
     event_log_error (hashcat_ctx, "%s: Could not uncompress data.", hcstat);
 
-    hcfree (inbuf);
+    hcfree (cache_file);
     hcfree (outbuf);
 
     return -1;
@@ -802,31 +942,34 @@ static int sp_setup_tbl (hashcat_ctx_t *hashcat_ctx)
   u64 v = *ptr++;
   u64 z = *ptr++;
 
-  memcpy (root_stats_buf,   ptr, sizeof (u64) * SP_ROOT_CNT);   ptr += SP_ROOT_CNT;
-  memcpy (markov_stats_buf, ptr, sizeof (u64) * SP_MARKOV_CNT); // ptr += SP_MARKOV_CNT;
+  // decompress in-place, the stats buffers are simply views into outbuf
 
-  hcfree (inbuf);
-  hcfree (outbuf);
+  u64 *root_stats_buf   = ptr; ptr += SP_ROOT_CNT;
+  u64 *markov_stats_buf = ptr; // ptr += SP_MARKOV_CNT;
 
-  /**
-   * switch endianess
-   */
+  u64 *root_stats_buf_by_pos[SP_PW_MAX];
 
-  v = byte_swap_64 (v);
-  z = byte_swap_64 (z);
+  for (int i = 0; i < SP_PW_MAX; i++)
+  {
+    root_stats_buf_by_pos[i] = root_stats_buf + (i * CHARSIZ);
+  }
 
-  for (int i = 0; i < SP_ROOT_CNT; i++)   root_stats_buf[i]   = byte_swap_64 (root_stats_buf[i]);
-  for (int i = 0; i < SP_MARKOV_CNT; i++) markov_stats_buf[i] = byte_swap_64 (markov_stats_buf[i]);
+  u64 *markov_stats_buf_by_key[SP_PW_MAX][CHARSIZ];
+
+  for (int i = 0; i < SP_PW_MAX; i++)
+  {
+    for (int j = 0; j < CHARSIZ; j++)
+    {
+      markov_stats_buf_by_key[i][j] = markov_stats_buf + (((i * CHARSIZ) + j) * CHARSIZ);
+    }
+  }
 
   /**
-   * markov inverse: https://github.com/hashcat/hashcat/issues/1058
+   * switch endianess
    */
 
-  if (inverse == true)
-  {
-    for (int i = 0; i < SP_ROOT_CNT; i++)   root_stats_buf[i]   = 0 - (1 + root_stats_buf[i]);
-    for (int i = 0; i < SP_MARKOV_CNT; i++) markov_stats_buf[i] = 0 - (1 + markov_stats_buf[i]);
-  }
+  v = byte_swap_64 (v);
+  z = byte_swap_64 (z);
 
   /**
    * verify header
@@ -836,6 +979,9 @@ static int sp_setup_tbl (hashcat_ctx_t *hashcat_ctx)
   {
     event_log_error (hashcat_ctx, "%s: Invalid header", hcstat);
 
+    hcfree (cache_file);
+    hcfree (outbuf);
+
     return -1;
   }
 
@@ -843,9 +989,25 @@ static int sp_setup_tbl (hashcat_ctx_t *hashcat_ctx)
   {
     event_log_error (hashcat_ctx, "%s: Invalid header", hcstat);
 
+    hcfree (cache_file);
+    hcfree (outbuf);
+
     return -1;
   }
 
+  for (int i = 0; i < SP_ROOT_CNT; i++)   root_stats_buf[i]   = byte_swap_64 (root_stats_buf[i]);
+  for (int i = 0; i < SP_MARKOV_CNT; i++) markov_stats_buf[i] = byte_swap_64 (markov_stats_buf[i]);
+
+  /**
+   * markov inverse: https://github.com/hashcat/hashcat/issues/1058
+   */
+
+  if (inverse == true)
+  {
+    for (int i = 0; i < SP_ROOT_CNT; i++)   root_stats_buf[i]   = 0 - (1 + root_stats_buf[i]);
+    for (int i = 0; i < SP_MARKOV_CNT; i++) markov_stats_buf[i] = 0 - (1 + markov_stats_buf[i]);
+  }
+
   /**
    * Markov modifier of hcstat_table on user request
    */
@@ -899,73 +1061,33 @@ static int sp_setup_tbl (hashcat_ctx_t *hashcat_ctx)
   }
 
   /**
-   * Initialize tables
+   * Convert hcstat to tables, we only keep the sorted keys
    */
 
-  hcstat_table_t *root_table_ptr = root_table_buf;
+  u8 *tbl_buf = (u8 *) hcmalloc (SP_CACHE_FILESZ);
 
-  hcstat_table_t *root_table_buf_by_pos[SP_PW_MAX];
+  memcpy (tbl_buf, &header, sizeof (sp_cache_header_t));
+
+  sp_tbl_assign (mask_ctx, tbl_buf, false);
 
   for (int i = 0; i < SP_PW_MAX; i++)
   {
-    root_table_buf_by_pos[i] = root_table_ptr;
-
-    root_table_ptr += CHARSIZ;
+    sp_stats_to_tbl (root_stats_buf_by_pos[i], mask_ctx->root_table_buf + (i * CHARSIZ));
   }
 
-  hcstat_table_t *markov_table_ptr = markov_table_buf;
-
-  hcstat_table_t *markov_table_buf_by_key[SP_PW_MAX][CHARSIZ];
-
   for (int i = 0; i < SP_PW_MAX; i++)
   {
     for (int j = 0; j < CHARSIZ; j++)
     {
-      markov_table_buf_by_key[i][j] = markov_table_ptr;
-
-      markov_table_ptr += CHARSIZ;
+      sp_stats_to_tbl (markov_stats_buf_by_key[i][j], mask_ctx->markov_table_buf + (((i * CHARSIZ) + j) * CHARSIZ));
     }
   }
 
-  /**
-   * Convert hcstat to tables
-   */
-
-  for (int i = 0; i < SP_ROOT_CNT; i++)
-  {
-    u32 key = i % CHARSIZ;
-
-    root_table_buf[i].key = key;
-    root_table_buf[i].val = root_stats_buf[i];
-  }
-
-  for (int i = 0; i < SP_MARKOV_CNT; i++)
-  {
-    u32 key = i % CHARSIZ;
-
-    markov_table_buf[i].key = key;
-    markov_table_buf[i].val = markov_stats_buf[i];
-  }
-
-  hcfree (root_stats_buf);
-  hcfree (markov_stats_buf);
-
-  /**
-   * Finally sort them
-   */
+  hcfree (outbuf);
 
-  for (int i = 0; i < SP_PW_MAX; i++)
-  {
-    qsort (root_table_buf_by_pos[i], CHARSIZ, sizeof (hcstat_table_t), sp_comp_val);
-  }
+  sp_cache_store (hashcat_ctx, cache_file);
 
-  for (int i = 0; i < SP_PW_MAX; i++)
-  {
-    for (int j = 0; j < CHARSIZ; j++)
-    {
-      qsort (markov_table_buf_by_key[i][j], CHARSIZ, sizeof (hcstat_table_t), sp_comp_val);
-    }
-  }
+  hcfree (cache_file);
 
   return 0;
 }
@@ -988,7 +1110,7 @@ static int sp_get_sum (u32 start, u32 stop, cs_t *root_css_buf, u64 *result)
   return 0;
 }
 
-static void sp_tbl_to_css (hcstat_table_t *root_table_buf, hcstat_table_t *markov_table_buf, cs_t *root_css_buf, cs_t *markov_css_buf, u32 threshold, u32 uniq_tbls[SP_PW_MAX][CHARSIZ])
+static void sp_tbl_to_css (const u8 *root_table_buf, const u8 *markov_table_buf, cs_t *root_css_buf, cs_t *markov_css_buf, u32 threshold, u32 uniq_tbls[SP_PW_MAX][CHARSIZ])
 {
   memset (root_css_buf,   0, SP_PW_MAX *           sizeof (cs_t));
   memset (markov_css_buf, 0, SP_PW_MAX * CHARSIZ * sizeof (cs_t));
@@ -1005,7 +1127,7 @@ static void sp_tbl_to_css (hcstat_table_t *root_table_buf, hcstat_table_t *marko
 
     if (cs->cs_len == threshold) continue;
 
-    u32 key = root_table_buf[i].key;
+    u32 key = root_table_buf[i];
 
     if (uniq_tbls[pw_pos][key] == 0) continue;
 
@@ -1028,7 +1150,7 @@ static void sp_tbl_to_css (hcstat_table_t *root_table_buf, hcstat_table_t *marko
 
     u32 pw_pos = c / CHARSIZ;
 
-    u32 key = markov_table_buf[i].key;
+    u32 key = markov_table_buf[i];
 
     if ((pw_pos + 1) < SP_PW_MAX) if (uniq_tbls[pw_pos + 1][key] == 0) continue;
 
@@ -1474,67 +1596,492 @@ int mask_ctx_update_loop (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
-int mask_ctx_init (hashcat_ctx_t *hashcat_ctx)
+/**
+ * mask fusion
+ */
+
+static const char mask_fuse_sys[8] = { 'l', 'u', 'd', 's', 'a', 'b', 'h', 'H' };
+
+static bool mask_fuse_parse (mask_fuse_t *mf)
 {
-  const hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
-  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
-  const user_options_t       *user_options       = hashcat_ctx->user_options;
-  mask_ctx_t                 *mask_ctx           = hashcat_ctx->mask_ctx;
+  // maskfile escapes are resolved first, an unescaped ',' means the line has custom charsets
 
-  mask_ctx->enabled = false;
+  const char *mask = mf->mask;
 
-  if (user_options->usage         > 0)    return 0;
-  if (user_options->backend_info  > 0)    return 0;
-  if (user_options->hash_info     > 0)    return 0;
+  const size_t mask_len = strlen (mask);
 
-  if (user_options->left         == true) return 0;
-  if (user_options->show         == true) return 0;
-  if (user_options->version      == true) return 0;
+  u32 toks[SP_PW_MAX];
 
-  if (user_options->attack_mode  == ATTACK_MODE_STRAIGHT)    return 0;
-  if (user_options->attack_mode  == ATTACK_MODE_COMBI)       return 0;
-  if (user_options->attack_mode  == ATTACK_MODE_GENERIC)     return 0;
-  if (user_options->attack_mode  == ATTACK_MODE_ASSOCIATION) return 0;
+  u32 toks_cnt = 0;
 
-  mask_ctx->enabled = true;
+  bool escaped = false;
+  bool question = false;
 
-  mask_ctx->mp_sys  = (cs_t *) hccalloc (8, sizeof (cs_t));
-  mask_ctx->mp_usr  = (cs_t *) hccalloc (8, sizeof (cs_t));
+  for (size_t i = 0; i < mask_len; i++)
+  {
+    const u32 c = mask[i] & 0xff;
 
-  mask_ctx->css_buf = (cs_t *) hccalloc (256, sizeof (cs_t));
-  mask_ctx->css_cnt = 0;
+    if ((escaped == false) && (c == '\\'))
+    {
+      escaped = true;
 
-  mask_ctx->root_table_buf   = (hcstat_table_t *) hccalloc (SP_ROOT_CNT,   sizeof (hcstat_table_t));
-  mask_ctx->markov_table_buf = (hcstat_table_t *) hccalloc (SP_MARKOV_CNT, sizeof (hcstat_table_t));
+      continue;
+    }
 
-  if (sp_setup_tbl (hashcat_ctx) == -1) return -1;
+    if ((escaped == false) && (c == ',')) return false;
 
-  mask_ctx->root_css_buf   = (cs_t *) hccalloc (SP_PW_MAX,           sizeof (cs_t));
-  mask_ctx->markov_css_buf = (cs_t *) hccalloc (SP_PW_MAX * CHARSIZ, sizeof (cs_t));
+    escaped = false;
 
-  mask_ctx->mask_from_file = false;
+    if (question == true)
+    {
+      question = false;
 
-  mask_ctx->masks     = NULL;
-  mask_ctx->masks_pos = 0;
-  mask_ctx->masks_cnt = 0;
+      if (c == '?')
+      {
+        toks[toks_cnt++] = c;
 
-  mask_ctx->mfs = (mf_t *) hccalloc (MAX_MFS, sizeof (mf_t));
+        continue;
+      }
 
-  mp_setup_sys (mask_ctx->mp_sys);
+      u32 sys_pos;
 
-  if (user_options->custom_charset_1) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_1, 0) == -1) return -1; }
-  if (user_options->custom_charset_2) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_2, 1) == -1) return -1; }
-  if (user_options->custom_charset_3) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_3, 2) == -1) return -1; }
-  if (user_options->custom_charset_4) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_4, 3) == -1) return -1; }
-  if (user_options->custom_charset_5) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_5, 4) == -1) return -1; }
-  if (user_options->custom_charset_6) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_6, 5) == -1) return -1; }
-  if (user_options->custom_charset_7) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_7, 6) == -1) return -1; }
-  if (user_options->custom_charset_8) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_8, 7) == -1) return -1; }
+      for (sys_pos = 0; sys_pos < 8; sys_pos++)
+      {
+        if (mask_fuse_sys[sys_pos] == (char) c) break;
+      }
 
-  if (user_options->benchmark == true)
-  {
-    if (hashconfig->benchmark_charset != NULL)
-    {
+      // ?1 .. ?8 or a syntax error, leave it to the regular mask parser
+
+      if (sys_pos == 8) return false;
+
+      toks[toks_cnt++] = CHARSIZ + sys_pos;
+
+      continue;
+    }
+
+    if (toks_cnt == SP_PW_MAX) return false;
+
+    if (c == '?')
+    {
+      question = true;
+
+      continue;
+    }
+
+    toks[toks_cnt++] = c;
+  }
+
+  if ((escaped == true) || (question == true)) return false;
+
+  if (toks_cnt == 0) return false;
+
+  mf->len  = toks_cnt;
+  mf->sets = (u32 *) hccalloc (toks_cnt * MASK_FUSE_SET_WORDS, sizeof (u32));
+
+  for (u32 pos = 0; pos < toks_cnt; pos++)
+  {
+    u32 *set = mf->sets + (pos * MASK_FUSE_SET_WORDS);
+
+    set[toks[pos] / 32] |= 1u << (toks[pos] % 32);
+  }
+
+  return true;
+}
+
+static bool mask_fuse_set_is_single (const u32 *set)
+{
+  u32 bits = 0;
+
+  for (u32 i = 0; i < MASK_FUSE_SET_WORDS; i++)
+  {
+    if (set[i] == 0) continue;
+
+    if (set[i] & (set[i] - 1)) return false;
+
+    bits++;
+  }
+
+  return (bits == 1);
+}
+
+static u32 mask_fuse_cs_cnt (const mask_fuse_t *mf, const u32 set_pos, const u32 *set_new)
+{
+  const u32 *uniq[SP_PW_MAX];
+
+  u32 uniq_cnt = 0;
+
+  for (u32 pos = 0; pos < mf->len; pos++)
+  {
+    const u32 *set = (pos == set_pos) ? set_new : mf->sets + (pos * MASK_FUSE_SET_WORDS);
+
+    if (mask_fuse_set_is_single (set) == true) continue;
+
+    u32 uniq_pos;
+
+    for (uniq_pos = 0; uniq_pos < uniq_cnt; uniq_pos++)
+    {
+      if (memcmp (uniq[uniq_pos], set, MASK_FUSE_SET_WORDS * sizeof (u32)) == 0) break;
+    }
+
+    if (uniq_pos == uniq_cnt) uniq[uniq_cnt++] = set;
+  }
+
+  return uniq_cnt;
+}
+
+static u64 mask_fuse_hash (const mask_fuse_t *mf, const u32 skip_pos)
+{
+  // FNV-1a over all positions except the one being fused
+
+  u64 hash = 0xcbf29ce484222325;
+
+  for (u32 pos = 0; pos < mf->len; pos++)
+  {
+    if (pos == skip_pos) continue;
+
+    const u32 *set = mf->sets + (pos * MASK_FUSE_SET_WORDS);
+
+    for (u32 i = 0; i < MASK_FUSE_SET_WORDS; i++)
+    {
+      hash ^= set[i];
+      hash *= 0x100000001b3;
+    }
+  }
+
+  return hash;
+}
+
+static bool mask_fuse_equal_except (const mask_fuse_t *mf1, const mask_fuse_t *mf2, const u32 skip_pos)
+{
+  if (mf1->len != mf2->len) return false;
+
+  for (u32 pos = 0; pos < mf1->len; pos++)
+  {
+    if (pos == skip_pos) continue;
+
+    if (memcmp (mf1->sets + (pos * MASK_FUSE_SET_WORDS), mf2->sets + (pos * MASK_FUSE_SET_WORDS), MASK_FUSE_SET_WORDS * sizeof (u32)) != 0) return false;
+  }
+
+  return true;
+}
+
+static int sort_by_mask_fuse (const void *p1, const void *p2)
+{
+  const mask_fuse_t *mf1 = *((const mask_fuse_t * const *) p1);
+  const mask_fuse_t *mf2 = *((const mask_fuse_t * const *) p2);
+
+  if (mf1->len   != mf2->len)   return (mf1->len   < mf2->len)   ? -1 : 1;
+  if (mf1->hash  != mf2->hash)  return (mf1->hash  < mf2->hash)  ? -1 : 1;
+  if (mf1->first != mf2->first) return (mf1->first < mf2->first) ? -1 : 1;
+
+  return 0;
+}
+
+static size_t mask_fuse_write_token (char *buf, const u32 tok)
+{
+  if (tok >= CHARSIZ)
+  {
+    buf[0] = '?';
+    buf[1] = mask_fuse_sys[tok - CHARSIZ];
+
+    return 2;
+  }
+
+  if (tok == '?')
+  {
+    buf[0] = '?';
+    buf[1] = '?';
+
+    return 2;
+  }
+
+  if ((tok == ',') || (tok == '\\'))
+  {
+    buf[0] = '\\';
+    buf[1] = (char) tok;
+
+    return 2;
+  }
+
+  buf[0] = (char) tok;
+
+  return 1;
+}
+
+static size_t mask_fuse_write_set (char *buf, const u32 *set)
+{
+  size_t len = 0;
+
+  for (u32 tok = 0; tok < MASK_FUSE_TOKENS; tok++)
+  {
+    if ((set[tok / 32] & (1u << (tok % 32))) == 0) continue;
+
+    len += mask_fuse_write_token (buf + len, tok);
+  }
+
+  return len;
+}
+
+static char *mask_fuse_render (const mask_fuse_t *mf)
+{
+  // custom charsets first, one per distinct multi-token position, followed by the mask itself
+
+  char *line_buf = (char *) hcmalloc ((MASK_FUSE_CS_MAX * ((MASK_FUSE_TOKENS * 2) + 1)) + (SP_PW_MAX * 2) + 1);
+
+  size_t line_len = 0;
+
+  const u32 *uniq[MASK_FUSE_CS_MAX];
+
+  u32 uniq_cnt = 0;
+
+  u32 cs_pos[SP_PW_MAX];
+
+  for (u32 pos = 0; pos < mf->len; pos++)
+  {
+    const u32 *set = mf->sets + (pos * MASK_FUSE_SET_WORDS);
+
+    cs_pos[pos] = MASK_FUSE_CS_MAX;
+
+    if (mask_fuse_set_is_single (set) == true) continue;
+
+    u32 uniq_pos;
+
+    for (uniq_pos = 0; uniq_pos < uniq_cnt; uniq_pos++)
+    {
+      if (memcmp (uniq[uniq_pos], set, MASK_FUSE_SET_WORDS * sizeof (u32)) == 0) break;
+    }
+
+    if (uniq_pos == uniq_cnt)
+    {
+      uniq[uniq_cnt++] = set;
+
+      line_len += mask_fuse_write_set (line_buf + line_len, set);
+
+      line_buf[line_len++] = ',';
+    }
+
+    cs_pos[pos] = uniq_pos;
+  }
+
+  for (u32 pos = 0; pos < mf->len; pos++)
+  {
+    if (cs_pos[pos] < MASK_FUSE_CS_MAX)
+    {
+      line_buf[line_len++] = '?';
+      line_buf[line_len++] = (char) ('1' + cs_pos[pos]);
+
+      continue;
+    }
+
+    const u32 *set = mf->sets + (pos * MASK_FUSE_SET_WORDS);
+
+    line_len += mask_fuse_write_set (line_buf + line_len, set);
+  }
+
+  line_buf[line_len] = 0;
+
+  return line_buf;
+}
+
+static int mask_ctx_fuse (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+  mask_ctx_t           *mask_ctx     = hashcat_ctx->mask_ctx;
+
+  if (user_options->mask_fusion == false) return 0;
+
+  if (mask_ctx->mask_from_file == false) return 0;
+
+  if (mask_ctx->masks_cnt < 2) return 0;
+
+  if (hashconfig->opts_type & OPTS_TYPE_MT_HEX) return 0;
+
+  const u32 masks_cnt = mask_ctx->masks_cnt;
+
+  mask_fuse_t *mfs = (mask_fuse_t *) hccalloc (masks_cnt, sizeof (mask_fuse_t));
+
+  mask_fuse_t **mfs_sorted = (mask_fuse_t **) hccalloc (masks_cnt, sizeof (mask_fuse_t *));
+
+  u32 len_max = 0;
+
+  for (u32 masks_pos = 0; masks_pos < masks_cnt; masks_pos++)
+  {
+    mask_fuse_t *mf = mfs + masks_pos;
+
+    mf->mask  = mask_ctx->masks[masks_pos];
+    mf->first = masks_pos;
+    mf->alive = true;
+
+    if (mask_fuse_parse (mf) == false) continue;
+
+    len_max = MAX (len_max, mf->len);
+  }
+
+  // two masks of the same length which differ in a single position are fused by joining the charsets at that position,
+  // the fused keyspace is exactly the union of both. repeat for all positions until nothing changes anymore
+
+  u32 set_new[MASK_FUSE_SET_WORDS];
+
+  bool changed = true;
+
+  while (changed == true)
+  {
+    changed = false;
+
+    for (u32 pos = 0; pos < len_max; pos++)
+    {
+      u32 sorted_cnt = 0;
+
+      for (u32 masks_pos = 0; masks_pos < masks_cnt; masks_pos++)
+      {
+        mask_fuse_t *mf = mfs + masks_pos;
+
+        if (mf->alive == false) continue;
+        if (mf->sets  == NULL)  continue;
+        if (mf->len   <= pos)   continue;
+
+        mf->hash = mask_fuse_hash (mf, pos);
+
+        mfs_sorted[sorted_cnt++] = mf;
+      }
+
+      qsort (mfs_sorted, sorted_cnt, sizeof (mask_fuse_t *), sort_by_mask_fuse);
+
+      for (u32 i = 0; i < sorted_cnt; i++)
+      {
+        mask_fuse_t *mf_dst = mfs_sorted[i];
+
+        if (mf_dst->alive == false) continue;
+
+        u32 *set_dst = mf_dst->sets + (pos * MASK_FUSE_SET_WORDS);
+
+        for (u32 j = i + 1; j < sorted_cnt; j++)
+        {
+          mask_fuse_t *mf_src = mfs_sorted[j];
+
+          if (mf_src->len  != mf_dst->len)  break;
+          if (mf_src->hash != mf_dst->hash) break;
+
+          if (mf_src->alive == false) continue;
+
+          if (mask_fuse_equal_except (mf_dst, mf_src, pos) == false) continue;
+
+          const u32 *set_src = mf_src->sets + (pos * MASK_FUSE_SET_WORDS);
+
+          for (u32 k = 0; k < MASK_FUSE_SET_WORDS; k++) set_new[k] = set_dst[k] | set_src[k];
+
+          if (mask_fuse_cs_cnt (mf_dst, pos, set_new) > MASK_FUSE_CS_MAX) continue;
+
+          memcpy (set_dst, set_new, sizeof (set_new));
+
+          mf_dst->fused = true;
+          mf_src->alive = false;
+
+          changed = true;
+        }
+      }
+    }
+  }
+
+  // rebuild the mask list, each fused mask takes the place of the first maskfile line it contains
+
+  u32 fused_cnt = 0;
+
+  for (u32 masks_pos = 0; masks_pos < masks_cnt; masks_pos++)
+  {
+    mask_fuse_t *mf = mfs + masks_pos;
+
+    if (mf->alive == false)
+    {
+      hcfree (mf->mask);
+    }
+    else if (mf->fused == true)
+    {
+      hcfree (mf->mask);
+
+      mask_ctx->masks[fused_cnt++] = mask_fuse_render (mf);
+    }
+    else
+    {
+      mask_ctx->masks[fused_cnt++] = mf->mask;
+    }
+
+    hcfree (mf->sets);
+  }
+
+  mask_ctx->masks_cnt = fused_cnt;
+
+  hcfree (mfs_sorted);
+  hcfree (mfs);
+
+  if (user_options->quiet == false)
+  {
+    event_log_info (hashcat_ctx, "Mask fusion: %u masks fused into %u masks.", masks_cnt, fused_cnt);
+    event_log_info (hashcat_ctx, NULL);
+  }
+
+  return 0;
+}
+
+int mask_ctx_init (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+  mask_ctx_t                 *mask_ctx           = hashcat_ctx->mask_ctx;
+
+  mask_ctx->enabled = false;
+
+  if (user_options->usage         > 0)    return 0;
+  if (user_options->backend_info  > 0)    return 0;
+  if (user_options->hash_info     > 0)    return 0;
+
+  if (user_options->left         == true) return 0;
+  if (user_options->show         == true) return 0;
+  if (user_options->version      == true) return 0;
+
+  if (user_options->attack_mode  == ATTACK_MODE_STRAIGHT)    return 0;
+  if (user_options->attack_mode  == ATTACK_MODE_COMBI)       return 0;
+  if (user_options->attack_mode  == ATTACK_MODE_GENERIC)     return 0;
+  if (user_options->attack_mode  == ATTACK_MODE_ASSOCIATION) return 0;
+
+  mask_ctx->enabled = true;
+
+  mask_ctx->mp_sys  = (cs_t *) hccalloc (8, sizeof (cs_t));
+  mask_ctx->mp_usr  = (cs_t *) hccalloc (8, sizeof (cs_t));
+
+  mask_ctx->css_buf = (cs_t *) hccalloc (256, sizeof (cs_t));
+  mask_ctx->css_cnt = 0;
+
+  if (sp_setup_tbl (hashcat_ctx) == -1) return -1;
+
+  mask_ctx->root_css_buf   = (cs_t *) hccalloc (SP_PW_MAX,           sizeof (cs_t));
+  mask_ctx->markov_css_buf = (cs_t *) hccalloc (SP_PW_MAX * CHARSIZ, sizeof (cs_t));
+
+  mask_ctx->mask_from_file = false;
+
+  mask_ctx->masks     = NULL;
+  mask_ctx->masks_pos = 0;
+  mask_ctx->masks_cnt = 0;
+
+  mask_ctx->mfs = (mf_t *) hccalloc (MAX_MFS, sizeof (mf_t));
+
+  mp_setup_sys (mask_ctx->mp_sys);
+
+  if (user_options->custom_charset_1) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_1, 0) == -1) return -1; }
+  if (user_options->custom_charset_2) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_2, 1) == -1) return -1; }
+  if (user_options->custom_charset_3) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_3, 2) == -1) return -1; }
+  if (user_options->custom_charset_4) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_4, 3) == -1) return -1; }
+  if (user_options->custom_charset_5) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_5, 4) == -1) return -1; }
+  if (user_options->custom_charset_6) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_6, 5) == -1) return -1; }
+  if (user_options->custom_charset_7) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_7, 6) == -1) return -1; }
+  if (user_options->custom_charset_8) { if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, user_options->custom_charset_8, 7) == -1) return -1; }
+
+  if (user_options->benchmark == true)
+  {
+    if (hashconfig->benchmark_charset != NULL)
+    {
       if (mp_setup_usr (hashcat_ctx, mask_ctx->mp_sys, mask_ctx->mp_usr, hashconfig->benchmark_charset, 0) == -1) return -1;
     }
   }
@@ -1776,6 +2323,8 @@ int mask_ctx_init (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
+  if (mask_ctx_fuse (hashcat_ctx) == -1) return -1;
+
   mask_ctx->mask = mask_ctx->masks[0];
 
   return 0;
@@ -1795,8 +2344,7 @@ void mask_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (mask_ctx->root_css_buf);
   hcfree (mask_ctx->markov_css_buf);
 
-  hcfree (mask_ctx->root_table_buf);
-  hcfree (mask_ctx->markov_table_buf);
+  sp_tbl_unmap (mask_ctx);
 
   for (u32 mask_pos = 0; mask_pos < mask_ctx->masks_cnt; mask_pos++)
   {
@@ -1950,3 +2498,296 @@ int mask_ctx_parse_maskfile (hashcat_ctx_t *hashcat_ctx)
 
   return 0;
 }
+
+/**
+ * hcstat2 generator
+ */
+
+static void sp_gen_count (const u8 *line_buf, const size_t line_len, u32 *root_local_buf, u32 *markov_local_buf, u64 *root_stats_buf, u64 *markov_stats_buf, hc_thread_mutex_t *mux_stats)
+{
+  const size_t pw_len = MIN (line_len, SP_PW_MAX);
+
+  const size_t local_len = MIN (pw_len, SP_GEN_LOCAL_POS);
+
+  for (size_t i = 0; i < local_len; i++)
+  {
+    root_local_buf[(i * CHARSIZ) + line_buf[i]]++;
+  }
+
+  for (size_t i = 1; i < local_len; i++)
+  {
+    markov_local_buf[((((i - 1) * CHARSIZ) + line_buf[i - 1]) * CHARSIZ) + line_buf[i]]++;
+  }
+
+  if (pw_len == local_len) return;
+
+  // long words are rare, not worth a thread local copy of the full tables
+
+  hc_thread_mutex_lock (*mux_stats);
+
+  for (size_t i = local_len; i < pw_len; i++)
+  {
+    root_stats_buf[(i * CHARSIZ) + line_buf[i]]++;
+
+    markov_stats_buf[((((i - 1) * CHARSIZ) + line_buf[i - 1]) * CHARSIZ) + line_buf[i]]++;
+  }
+
+  hc_thread_mutex_unlock (*mux_stats);
+}
+
+HC_API_CALL void *sp_gen_thread (void *p)
+{
+  sp_gen_thread_param_t *thread_param = (sp_gen_thread_param_t *) p;
+
+  const u8 *buf     = thread_param->buf;
+  const u8 *buf_end = thread_param->buf + thread_param->buf_len;
+
+  while (buf < buf_end)
+  {
+    const u8 *next = (const u8 *) memchr (buf, '\n', buf_end - buf);
+
+    if (next == NULL) next = buf_end;
+
+    size_t line_len = next - buf;
+
+    if ((line_len > 0) && (buf[line_len - 1] == '\r')) line_len--;
+
+    if (line_len > 0)
+    {
+      sp_gen_count (buf, line_len, thread_param->root_local_buf, thread_param->markov_local_buf, thread_param->root_stats_buf, thread_param->markov_stats_buf, thread_param->mux_stats);
+
+      thread_param->words_cnt++;
+    }
+
+    if (next == buf_end) break;
+
+    buf = next + 1;
+  }
+
+  return NULL;
+}
+
+static void sp_gen_block (sp_gen_thread_param_t *threads_param, hc_thread_t *c_threads, const u32 threads_cnt, const u8 *buf, const size_t buf_len)
+{
+  // split the block at line boundaries, one slice per thread
+
+  size_t off = 0;
+
+  for (u32 tid = 0; tid < threads_cnt; tid++)
+  {
+    size_t end = (tid == (threads_cnt - 1)) ? buf_len : ((buf_len / threads_cnt) * (tid + 1));
+
+    if (end < off) end = off;
+
+    while ((end < buf_len) && (end > 0) && (buf[end - 1] != '\n')) end++;
+
+    threads_param[tid].buf     = buf + off;
+    threads_param[tid].buf_len = end - off;
+
+    off = end;
+  }
+
+  for (u32 tid = 0; tid < threads_cnt; tid++)
+  {
+    hc_thread_create (c_threads[tid], sp_gen_thread, &threads_param[tid]);
+  }
+
+  hc_thread_wait ((int) threads_cnt, c_threads);
+
+  // fold the thread local counters into the final tables, u32 is safe as a block is smaller than 4GB
+
+  for (u32 tid = 0; tid < threads_cnt; tid++)
+  {
+    sp_gen_thread_param_t *thread_param = &threads_param[tid];
+
+    for (int i = 0; i < SP_GEN_LOCAL_POS * CHARSIZ; i++)
+    {
+      thread_param->root_stats_buf[i] += thread_param->root_local_buf[i];
+    }
+
+    for (int i = 0; i < SP_GEN_LOCAL_POS * CHARSIZ * CHARSIZ; i++)
+    {
+      thread_param->markov_stats_buf[i] += thread_param->markov_local_buf[i];
+    }
+
+    memset (thread_param->root_local_buf,   0, SP_GEN_LOCAL_POS * CHARSIZ * sizeof (u32));
+    memset (thread_param->markov_local_buf, 0, SP_GEN_LOCAL_POS * CHARSIZ * CHARSIZ * sizeof (u32));
+  }
+}
+
+int sp_hcstat2_create (hashcat_ctx_t *hashcat_ctx)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  const char *hcstat = user_options->markov_hcstat2_create;
+
+  if (user_options->hc_argc < 1)
+  {
+    event_log_error (hashcat_ctx, "Option --markov-hcstat2-create requires at least one wordlist.");
+
+    return -1;
+  }
+
+  const int processor_count = hc_get_processor_count ();
+
+  const u32 threads_cnt = (processor_count > 0) ? (u32) processor_count : 1;
+
+  u64 *stats_buf = (u64 *) hccalloc (SP_FILESZ, 1);
+
+  u64 *root_stats_buf   = stats_buf + 2;
+  u64 *markov_stats_buf = stats_buf + 2 + SP_ROOT_CNT;
+
+  hc_thread_mutex_t mux_stats;
+
+  hc_thread_mutex_init (mux_stats);
+
+  sp_gen_thread_param_t *threads_param = (sp_gen_thread_param_t *) hccalloc (threads_cnt, sizeof (sp_gen_thread_param_t));
+  hc_thread_t           *c_threads     = (hc_thread_t *)           hccalloc (threads_cnt, sizeof (hc_thread_t));
+
+  for (u32 tid = 0; tid < threads_cnt; tid++)
+  {
+    sp_gen_thread_param_t *thread_param = &threads_param[tid];
+
+    thread_param->tid = tid;
+
+    thread_param->root_local_buf   = (u32 *) hccalloc (SP_GEN_LOCAL_POS * CHARSIZ,           sizeof (u32));
+    thread_param->markov_local_buf = (u32 *) hccalloc (SP_GEN_LOCAL_POS * CHARSIZ * CHARSIZ, sizeof (u32));
+
+    thread_param->root_stats_buf   = root_stats_buf;
+    thread_param->markov_stats_buf = markov_stats_buf;
+
+    thread_param->mux_stats = &mux_stats;
+  }
+
+  u8 *buf = (u8 *) hcmalloc (SP_GEN_BLOCK_SZ);
+
+  int rc = 0;
+
+  for (int argv_idx = 0; argv_idx < user_options->hc_argc; argv_idx++)
+  {
+    const char *dictfile = user_options->hc_argv[argv_idx];
+
+    HCFILE fp;
+
+    if (hc_fopen (&fp, dictfile, "rb") == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", dictfile, strerror (errno));
+
+      rc = -1;
+
+      break;
+    }
+
+    size_t carry = 0;
+
+    while (true)
+    {
+      const size_t nread = hc_fread (buf + carry, 1, SP_GEN_BLOCK_SZ - carry, &fp);
+
+      const size_t used = carry + nread;
+
+      if (used == 0) break;
+
+      // keep an incomplete last line for the next block, unless this is the end of the file
+
+      size_t cut = used;
+
+      if (nread > 0)
+      {
+        while ((cut > 0) && (buf[cut - 1] != '\n')) cut--;
+
+        if (cut == 0) cut = used;
+      }
+
+      sp_gen_block (threads_param, c_threads, threads_cnt, buf, cut);
+
+      carry = used - cut;
+
+      if (carry) memmove (buf, buf + cut, carry);
+
+      if (nread == 0) break;
+    }
+
+    hc_fclose (&fp);
+  }
+
+  hcfree (buf);
+
+  u64 words_cnt = 0;
+
+  for (u32 tid = 0; tid < threads_cnt; tid++)
+  {
+    words_cnt += threads_param[tid].words_cnt;
+
+    hcfree (threads_param[tid].root_local_buf);
+    hcfree (threads_param[tid].markov_local_buf);
+  }
+
+  hcfree (threads_param);
+  hcfree (c_threads);
+
+  hc_thread_mutex_delete (mux_stats);
+
+  if (rc == -1)
+  {
+    hcfree (stats_buf);
+
+    return -1;
+  }
+
+  /**
+   * hcstat2 is stored big-endian and lzma2 compressed, see sp_setup_tbl()
+   */
+
+  stats_buf[0] = SP_VERSION;
+  stats_buf[1] = 0;
+
+  for (size_t i = 0; i < SP_FILESZ / sizeof (u64); i++) stats_buf[i] = byte_swap_64 (stats_buf[i]);
+
+  SizeT outlen = SP_FILESZ + (SP_FILESZ / 16) + 0x10000;
+
+  u8 *outbuf = (u8 *) hcmalloc (outlen);
+
+  char props = 0;
+
+  const SRes res = hc_lzma2_compress ((const u8 *) stats_buf, SP_FILESZ, outbuf, &outlen, &props, (int) threads_cnt);
+
+  hcfree (stats_buf);
+
+  if (res != SZ_OK)
+  {
+    event_log_error (hashcat_ctx, "%s: Could not compress data.", hcstat);
+
+    hcfree (outbuf);
+
+    return -1;
+  }
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, hcstat, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", hcstat, strerror (errno));
+
+    hcfree (outbuf);
+
+    return -1;
+  }
+
+  const size_t nwritten = hc_fwrite (outbuf, 1, outlen, &fp);
+
+  hc_fclose (&fp);
+
+  hcfree (outbuf);
+
+  if (nwritten != outlen)
+  {
+    event_log_error (hashcat_ctx, "%s: Could not write data.", hcstat);
+
+    return -1;
+  }
+
+  event_log_info (hashcat_ctx, "%s: %" PRIu64 " words processed using %u threads.", hcstat, words_cnt, threads_cnt);
+
+  return 0;
+}
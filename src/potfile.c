@@ -13,6 +13,7 @@
 #include "loopback.h"
 #include "outfile.h"
 #include "locking.h"
+#include "folder.h"
 #include "shared.h"
 #include "potfile.h"
 
@@ -104,6 +105,36 @@ void pot_tree_destroy (pot_tree_entry_t *tree)
   }
 }
 
+static char *potfile_shard_dir (const hashcat_ctx_t *hashcat_ctx)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+  const user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  char *shard_dir = NULL;
+
+  if (user_options->potfile_path == NULL)
+  {
+    hc_asprintf (&shard_dir, "%s/%s", folder_config->profile_dir, POTFILE_SHARD_DIR);
+  }
+  else
+  {
+    hc_asprintf (&shard_dir, "%s.d", user_options->potfile_path);
+  }
+
+  return shard_dir;
+}
+
+static void potfile_shard_select (hashcat_ctx_t *hashcat_ctx, const u32 hash_mode)
+{
+  potfile_ctx_t *potfile_ctx = hashcat_ctx->potfile_ctx;
+
+  if (potfile_ctx->shard_dir == NULL) return;
+
+  hcfree (potfile_ctx->filename);
+
+  hc_asprintf (&potfile_ctx->filename, "%s/%u%s", potfile_ctx->shard_dir, hash_mode, POTFILE_SHARD_SUFFIX);
+}
+
 int potfile_init (hashcat_ctx_t *hashcat_ctx)
 {
   const folder_config_t *folder_config = hashcat_ctx->folder_config;
@@ -130,7 +161,23 @@ int potfile_init (hashcat_ctx_t *hashcat_ctx)
 
   potfile_ctx->enabled = true;
 
-  if (user_options->potfile_path == NULL)
+  if (user_options->potfile_shard == true)
+  {
+    // one potfile per hash-mode, sessions only parse the shard of the hash-mode they attack
+
+    potfile_ctx->shard_dir = potfile_shard_dir (hashcat_ctx);
+    potfile_ctx->fp.pfp    = NULL;
+
+    if (hc_mkdir_rec (potfile_ctx->shard_dir, 0700) == -1)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", potfile_ctx->shard_dir, strerror (errno));
+
+      return -1;
+    }
+
+    potfile_shard_select (hashcat_ctx, user_options->hash_mode);
+  }
+  else if (user_options->potfile_path == NULL)
   {
     hc_asprintf (&potfile_ctx->filename, "%s/hashcat.potfile", folder_config->profile_dir);
     potfile_ctx->fp.pfp   = NULL;
@@ -183,6 +230,7 @@ void potfile_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (potfile_ctx->tmp_buf);
   hcfree (potfile_ctx->out_buf);
   hcfree (potfile_ctx->filename);
+  hcfree (potfile_ctx->shard_dir);
 
   memset (potfile_ctx, 0, sizeof (potfile_ctx_t));
 }
@@ -227,6 +275,8 @@ int potfile_write_open (hashcat_ctx_t *hashcat_ctx)
 
   if (hashconfig->potfile_disable == true) return 0;
 
+  potfile_shard_select (hashcat_ctx, hashconfig->hash_mode);
+
   if (hc_fopen (&potfile_ctx->fp, potfile_ctx->filename, "ab") == false)
   {
     event_log_error (hashcat_ctx, "%s: %s", potfile_ctx->filename, strerror (errno));
@@ -249,7 +299,61 @@ void potfile_write_close (hashcat_ctx_t *hashcat_ctx)
   hc_fclose (&potfile_ctx->fp);
 }
 
-void potfile_write_append (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len)
+void potfile_write_lock (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t  *hashconfig  = hashcat_ctx->hashconfig;
+        potfile_ctx_t *potfile_ctx = hashcat_ctx->potfile_ctx;
+
+  if (potfile_ctx->enabled == false) return;
+
+  if (hashconfig->potfile_disable == true) return;
+
+  // --potfile-compact renames a new file over the potfile while it holds the lock, reopen it once we got the lock on the old one
+
+  while (true)
+  {
+    hc_lockfile (&potfile_ctx->fp);
+
+    struct stat st_fd;
+    struct stat st_path;
+
+    if (hc_fstat (&potfile_ctx->fp, &st_fd) == -1) break;
+
+    if (stat (potfile_ctx->filename, &st_path) == -1) break;
+
+    if ((st_fd.st_dev == st_path.st_dev) && (st_fd.st_ino == st_path.st_ino)) break;
+
+    hc_unlockfile (&potfile_ctx->fp);
+
+    hc_fclose (&potfile_ctx->fp);
+
+    if (hc_fopen (&potfile_ctx->fp, potfile_ctx->filename, "ab") == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", potfile_ctx->filename, strerror (errno));
+
+      return;
+    }
+  }
+}
+
+void potfile_write_unlock (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t  *hashconfig  = hashcat_ctx->hashconfig;
+        potfile_ctx_t *potfile_ctx = hashcat_ctx->potfile_ctx;
+
+  if (potfile_ctx->enabled == false) return;
+
+  if (hashconfig->potfile_disable == true) return;
+
+  hc_fflush (&potfile_ctx->fp);
+
+  if (hc_unlockfile (&potfile_ctx->fp))
+  {
+    event_log_error (hashcat_ctx, "%s: Failed to unlock file.", potfile_ctx->filename);
+  }
+}
+
+void potfile_write_line (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len)
 {
   const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
         potfile_ctx_t  *potfile_ctx  = hashcat_ctx->potfile_ctx;
@@ -301,16 +405,16 @@ void potfile_write_append (hashcat_ctx_t *hashcat_ctx, const char *out_buf, cons
 
   tmp_buf[tmp_len] = 0;
 
-  hc_lockfile (&potfile_ctx->fp);
-
   hc_fprintf (&potfile_ctx->fp, "%s" EOL, tmp_buf);
+}
 
-  hc_fflush (&potfile_ctx->fp);
+void potfile_write_append (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len)
+{
+  potfile_write_lock (hashcat_ctx);
 
-  if (hc_unlockfile (&potfile_ctx->fp))
-  {
-    event_log_error (hashcat_ctx, "%s: Failed to unlock file.", potfile_ctx->filename);
-  }
+  potfile_write_line (hashcat_ctx, out_buf, out_len, plain_ptr, plain_len);
+
+  potfile_write_unlock (hashcat_ctx);
 }
 
 void potfile_update_hash (hashcat_ctx_t *hashcat_ctx, hash_t *found, char *line_pw_buf, int line_pw_len)
@@ -392,6 +496,8 @@ int potfile_remove_parse (hashcat_ctx_t *hashcat_ctx)
 
   if (hashconfig->opts_type & OPTS_TYPE_PT_NEVERCRACK) return 0;
 
+  potfile_shard_select (hashcat_ctx, hashconfig->hash_mode);
+
   // if no potfile exists yet we don't need to do anything here
 
   if (hc_path_exist (potfile_ctx->filename) == false) return 0;
@@ -1187,3 +1293,507 @@ int potfile_handle_left (hashcat_ctx_t *hashcat_ctx)
 
   return 0;
 }
+
+/**
+ * --potfile-compact sorts and deduplicates a potfile of any size in bounded memory:
+ * sorted runs of up to POTFILE_COMPACT_RUN_SIZE bytes go to temporary files next to the potfile,
+ * then at most POTFILE_COMPACT_MERGE_WAY of them at a time are merged, dropping duplicate lines.
+ * A run stores each line as its u32 length followed by the bytes of the line.
+ */
+
+typedef struct potfile_compact_run
+{
+  HCFILE fp;
+
+  char  *buf;
+  u32    len;
+  u32    size;
+
+} potfile_compact_run_t;
+
+static int potfile_compact_cmp (const char *buf1, const u32 len1, const char *buf2, const u32 len2)
+{
+  const int rc = memcmp (buf1, buf2, MIN (len1, len2));
+
+  if (rc != 0) return rc;
+
+  if (len1 < len2) return -1;
+  if (len1 > len2) return  1;
+
+  return 0;
+}
+
+static int sort_by_compact_record (const void *p1, const void *p2)
+{
+  const char *r1 = *((const char * const *) p1);
+  const char *r2 = *((const char * const *) p2);
+
+  u32 len1;
+  u32 len2;
+
+  memcpy (&len1, r1, sizeof (u32));
+  memcpy (&len2, r2, sizeof (u32));
+
+  return potfile_compact_cmp (r1 + sizeof (u32), len1, r2 + sizeof (u32), len2);
+}
+
+static bool potfile_compact_run_write (const char *run_path, char **records, const u64 records_cnt)
+{
+  HCFILE fp;
+
+  if (hc_fopen (&fp, run_path, "wb") == false) return false;
+
+  bool rc = true;
+
+  const char *prev = NULL;
+
+  for (u64 i = 0; i < records_cnt; i++)
+  {
+    if ((prev != NULL) && (sort_by_compact_record (&prev, &records[i]) == 0)) continue;
+
+    u32 len;
+
+    memcpy (&len, records[i], sizeof (u32));
+
+    if (hc_fwrite (records[i], 1, sizeof (u32) + len, &fp) != sizeof (u32) + len)
+    {
+      rc = false;
+
+      break;
+    }
+
+    prev = records[i];
+  }
+
+  hc_fclose (&fp);
+
+  return rc;
+}
+
+// 1 for the next line of the run, 0 at the end of the run, -1 for a short read
+
+static int potfile_compact_run_next (potfile_compact_run_t *run)
+{
+  u32 len = 0;
+
+  const size_t nread = hc_fread (&len, 1, sizeof (u32), &run->fp);
+
+  if (nread == 0) return 0;
+
+  if (nread != sizeof (u32)) return -1;
+
+  if (len > run->size)
+  {
+    run->buf  = (char *) hcrealloc (run->buf, run->size, len - run->size);
+    run->size = len;
+  }
+
+  if (hc_fread (run->buf, 1, len, &run->fp) != len) return -1;
+
+  run->len = len;
+
+  return 1;
+}
+
+static void potfile_compact_heap_down (const potfile_compact_run_t *runs, int *heap, const int heap_cnt, int pos)
+{
+  while (true)
+  {
+    const int l = (pos * 2) + 1;
+    const int r = (pos * 2) + 2;
+
+    int min = pos;
+
+    if ((l < heap_cnt) && (potfile_compact_cmp (runs[heap[l]].buf, runs[heap[l]].len, runs[heap[min]].buf, runs[heap[min]].len) < 0)) min = l;
+    if ((r < heap_cnt) && (potfile_compact_cmp (runs[heap[r]].buf, runs[heap[r]].len, runs[heap[min]].buf, runs[heap[min]].len) < 0)) min = r;
+
+    if (min == pos) return;
+
+    const int tmp = heap[pos];
+
+    heap[pos] = heap[min];
+    heap[min] = tmp;
+
+    pos = min;
+  }
+}
+
+// merges the runs into one more run or, with final set, into the lines of the new potfile
+
+static bool potfile_compact_merge (char **run_paths, const int runs_cnt, const char *out_path, const bool final, u64 *lines_out)
+{
+  potfile_compact_run_t *runs = (potfile_compact_run_t *) hccalloc (MAX (runs_cnt, 1), sizeof (potfile_compact_run_t));
+
+  int *heap = (int *) hccalloc (MAX (runs_cnt, 1), sizeof (int));
+
+  int heap_cnt = 0;
+
+  int runs_open = 0;
+
+  bool rc = true;
+
+  for (int i = 0; i < runs_cnt; i++)
+  {
+    if (hc_fopen (&runs[i].fp, run_paths[i], "rb") == false)
+    {
+      rc = false;
+
+      break;
+    }
+
+    runs_open++;
+
+    const int rc_next = potfile_compact_run_next (&runs[i]);
+
+    if (rc_next == -1) rc = false;
+
+    if (rc_next ==  1) heap[heap_cnt++] = i;
+  }
+
+  for (int pos = (heap_cnt / 2) - 1; pos >= 0; pos--)
+  {
+    potfile_compact_heap_down (runs, heap, heap_cnt, pos);
+  }
+
+  HCFILE fp;
+
+  if ((rc == true) && (hc_fopen (&fp, out_path, "wb") == true))
+  {
+    char *prev_buf  = NULL;
+    u32   prev_len  = 0;
+    u32   prev_size = 0;
+
+    bool  prev_set  = false;
+
+    while ((rc == true) && (heap_cnt > 0))
+    {
+      potfile_compact_run_t *run = &runs[heap[0]];
+
+      if ((prev_set == false) || (potfile_compact_cmp (prev_buf, prev_len, run->buf, run->len) != 0))
+      {
+        size_t nwritten = 0;
+
+        if (final == true)
+        {
+          nwritten += hc_fwrite (run->buf, 1, run->len, &fp);
+          nwritten += hc_fwrite (EOL, 1, strlen (EOL), &fp);
+
+          if (nwritten != run->len + strlen (EOL)) rc = false;
+        }
+        else
+        {
+          nwritten += hc_fwrite (&run->len, 1, sizeof (u32), &fp);
+          nwritten += hc_fwrite (run->buf,  1, run->len,     &fp);
+
+          if (nwritten != sizeof (u32) + run->len) rc = false;
+        }
+
+        if (run->len > prev_size)
+        {
+          prev_buf  = (char *) hcrealloc (prev_buf, prev_size, run->len - prev_size);
+          prev_size = run->len;
+        }
+
+        memcpy (prev_buf, run->buf, run->len);
+
+        prev_len = run->len;
+        prev_set = true;
+
+        *lines_out += 1;
+      }
+
+      const int rc_next = potfile_compact_run_next (run);
+
+      if (rc_next == -1) rc = false;
+
+      if (rc_next ==  0) heap[0] = heap[--heap_cnt];
+
+      potfile_compact_heap_down (runs, heap, heap_cnt, 0);
+    }
+
+    if (final == true)
+    {
+      hc_fflush (&fp);
+
+      hc_fsync (&fp);
+    }
+
+    hc_fclose (&fp);
+
+    hcfree (prev_buf);
+  }
+  else
+  {
+    rc = false;
+  }
+
+  for (int i = 0; i < runs_open; i++)
+  {
+    hc_fclose (&runs[i].fp);
+
+    hcfree (runs[i].buf);
+  }
+
+  hcfree (heap);
+  hcfree (runs);
+
+  return rc;
+}
+
+static int potfile_compact_file (hashcat_ctx_t *hashcat_ctx, const char *path)
+{
+  // the append handle shares the lock with running sessions, they wait until the new file is in place
+  // and reopen the potfile once they notice it was replaced, see potfile_write_lock ()
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, path, "ab") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", path, strerror (errno));
+
+    return -1;
+  }
+
+  if (hc_lockfile (&fp) == -1)
+  {
+    hc_fclose (&fp);
+
+    event_log_error (hashcat_ctx, "%s: %s", path, strerror (errno));
+
+    return -1;
+  }
+
+  HCFILE fp_in;
+
+  if (hc_fopen (&fp_in, path, "rb") == false)
+  {
+    hc_unlockfile (&fp);
+
+    hc_fclose (&fp);
+
+    event_log_error (hashcat_ctx, "%s: %s", path, strerror (errno));
+
+    return -1;
+  }
+
+  // sorted runs, empty lines are dropped
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE + 1);
+
+  char *run_buf = (char *) hcmalloc (POTFILE_COMPACT_RUN_SIZE);
+
+  u64 records_avail = INCR_POT;
+
+  char **records = (char **) hccalloc (records_avail, sizeof (char *));
+
+  int    run_paths_cnt = 0;
+  char **run_paths     = NULL;
+
+  u32 run_id = 0;
+
+  u64 lines_in  = 0;
+  u64 lines_out = 0;
+
+  bool ok = true;
+
+  while ((ok == true) && (hc_feof (&fp_in) == false))
+  {
+    size_t run_len = 0;
+
+    u64 records_cnt = 0;
+
+    // stop early enough that the longest line fgetl () can return still fits
+
+    while ((hc_feof (&fp_in) == false) && ((run_len + sizeof (u32) + HCBUFSIZ_LARGE) <= POTFILE_COMPACT_RUN_SIZE))
+    {
+      const u32 line_len = (u32) fgetl (&fp_in, line_buf, HCBUFSIZ_LARGE);
+
+      if (line_len == 0) continue;
+
+      lines_in++;
+
+      if (records_cnt == records_avail)
+      {
+        records = (char **) hcrealloc (records, records_avail * sizeof (char *), records_avail * sizeof (char *));
+
+        records_avail *= 2;
+      }
+
+      char *record = run_buf + run_len;
+
+      memcpy (record, &line_len, sizeof (u32));
+
+      memcpy (record + sizeof (u32), line_buf, line_len);
+
+      records[records_cnt++] = record;
+
+      run_len += sizeof (u32) + line_len;
+    }
+
+    if (records_cnt == 0) continue;
+
+    qsort (records, records_cnt, sizeof (char *), sort_by_compact_record);
+
+    run_paths = (char **) hcrealloc (run_paths, run_paths_cnt * sizeof (char *), sizeof (char *));
+
+    hc_asprintf (&run_paths[run_paths_cnt], "%s.compact.%u", path, run_id++);
+
+    if (potfile_compact_run_write (run_paths[run_paths_cnt], records, records_cnt) == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", run_paths[run_paths_cnt], strerror (errno));
+
+      ok = false;
+    }
+
+    run_paths_cnt++;
+  }
+
+  hc_fclose (&fp_in);
+
+  hcfree (records);
+  hcfree (run_buf);
+  hcfree (line_buf);
+
+  // merge until a single pass can write the new potfile
+
+  while ((ok == true) && (run_paths_cnt > POTFILE_COMPACT_MERGE_WAY))
+  {
+    int    merged_paths_cnt = 0;
+    char **merged_paths     = NULL;
+
+    for (int i = 0; i < run_paths_cnt; i += POTFILE_COMPACT_MERGE_WAY)
+    {
+      const int merge_cnt = MIN (POTFILE_COMPACT_MERGE_WAY, run_paths_cnt - i);
+
+      merged_paths = (char **) hcrealloc (merged_paths, merged_paths_cnt * sizeof (char *), sizeof (char *));
+
+      hc_asprintf (&merged_paths[merged_paths_cnt], "%s.compact.%u", path, run_id++);
+
+      u64 merged_lines = 0;
+
+      if ((ok == true) && (potfile_compact_merge (run_paths + i, merge_cnt, merged_paths[merged_paths_cnt], false, &merged_lines) == false))
+      {
+        event_log_error (hashcat_ctx, "%s: %s", merged_paths[merged_paths_cnt], strerror (errno));
+
+        ok = false;
+      }
+
+      merged_paths_cnt++;
+    }
+
+    for (int i = 0; i < run_paths_cnt; i++)
+    {
+      unlink (run_paths[i]);
+
+      hcfree (run_paths[i]);
+    }
+
+    hcfree (run_paths);
+
+    run_paths     = merged_paths;
+    run_paths_cnt = merged_paths_cnt;
+  }
+
+  // the new potfile replaces the old one only once it is complete and on disk, an interrupted run leaves the old one untouched
+
+  char *tmp_path = NULL;
+
+  hc_asprintf (&tmp_path, "%s.compact", path);
+
+  if (ok == true)
+  {
+    if (potfile_compact_merge (run_paths, run_paths_cnt, tmp_path, true, &lines_out) == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", tmp_path, strerror (errno));
+
+      ok = false;
+    }
+    else if (rename (tmp_path, path) == -1)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", path, strerror (errno));
+
+      ok = false;
+    }
+  }
+
+  if (ok == false) unlink (tmp_path);
+
+  for (int i = 0; i < run_paths_cnt; i++)
+  {
+    unlink (run_paths[i]);
+
+    hcfree (run_paths[i]);
+  }
+
+  hcfree (run_paths);
+  hcfree (tmp_path);
+
+  hc_unlockfile (&fp);
+
+  hc_fclose (&fp);
+
+  if (ok == false) return -1;
+
+  event_log_info (hashcat_ctx, "%s: %" PRIu64 " lines, %" PRIu64 " after compaction", path, lines_in, lines_out);
+
+  return 0;
+}
+
+int potfile_compact (hashcat_ctx_t *hashcat_ctx)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+  const user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  if (user_options->potfile_shard == false)
+  {
+    char *potfile_path = NULL;
+
+    if (user_options->potfile_path == NULL)
+    {
+      hc_asprintf (&potfile_path, "%s/hashcat.potfile", folder_config->profile_dir);
+    }
+    else
+    {
+      potfile_path = hcstrdup (user_options->potfile_path);
+    }
+
+    int rc = 0;
+
+    if (hc_path_exist (potfile_path) == true)
+    {
+      rc = potfile_compact_file (hashcat_ctx, potfile_path);
+    }
+
+    hcfree (potfile_path);
+
+    return rc;
+  }
+
+  char *shard_dir = potfile_shard_dir (hashcat_ctx);
+
+  char **shards = scan_directory (shard_dir);
+
+  hcfree (shard_dir);
+
+  if (shards == NULL) return 0;
+
+  int rc = 0;
+
+  const size_t suffix_len = strlen (POTFILE_SHARD_SUFFIX);
+
+  for (int i = 0; shards[i] != NULL; i++)
+  {
+    const size_t shard_len = strlen (shards[i]);
+
+    if ((rc == 0) && (shard_len > suffix_len) && (strcmp (shards[i] + shard_len - suffix_len, POTFILE_SHARD_SUFFIX) == 0))
+    {
+      rc = potfile_compact_file (hashcat_ctx, shards[i]);
+    }
+
+    hcfree (shards[i]);
+  }
+
+  hcfree (shards);
+
+  return rc;
+}
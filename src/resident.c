@@ -0,0 +1,448 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "backend.h"
+#include "resident.h"
+
+/**
+ * state a daemon keeps from one job to the next, see daemon.c:
+ *
+ * - the kernel programs, load_kernel () in backend.c skips a rebuild if the cached kernel file is the same
+ * - the hashlist after hashes_init_stage2 (), reused if the hash-mode, the parser options and the hashfile did not change
+ * - the autotune result of each device, reused if nothing autotune () depends on changed
+ *
+ * the potfile, the zero hash and everything after hashes_init_stage2 () is still applied per job
+ */
+
+static hashinfo_t *resident_hash_info_copy (const hashinfo_t *src)
+{
+  if (src == NULL) return NULL;
+
+  hashinfo_t *dst = (hashinfo_t *) hcmalloc (sizeof (hashinfo_t));
+
+  if (src->dynamicx != NULL)
+  {
+    dst->dynamicx = (dynamicx_t *) hcmalloc (sizeof (dynamicx_t));
+
+    dst->dynamicx->dynamicx_len = src->dynamicx->dynamicx_len;
+
+    if (src->dynamicx->dynamicx_buf != NULL)
+    {
+      dst->dynamicx->dynamicx_buf = (char *) hcmalloc (src->dynamicx->dynamicx_len + 1);
+
+      memcpy (dst->dynamicx->dynamicx_buf, src->dynamicx->dynamicx_buf, src->dynamicx->dynamicx_len);
+    }
+  }
+
+  if (src->user != NULL)
+  {
+    dst->user = (user_t *) hcmalloc (sizeof (user_t));
+
+    dst->user->user_len = src->user->user_len;
+
+    if (src->user->user_name != NULL)
+    {
+      dst->user->user_name = hcstrdup (src->user->user_name);
+    }
+  }
+
+  if (src->orighash != NULL)
+  {
+    dst->orighash = hcstrdup (src->orighash);
+  }
+
+  if (src->split != NULL)
+  {
+    dst->split = (split_t *) hcmalloc (sizeof (split_t));
+
+    memcpy (dst->split, src->split, sizeof (split_t));
+  }
+
+  return dst;
+}
+
+static void resident_hash_info_free (hashinfo_t *hash_info)
+{
+  if (hash_info == NULL) return;
+
+  if (hash_info->dynamicx != NULL)
+  {
+    hcfree (hash_info->dynamicx->dynamicx_buf);
+    hcfree (hash_info->dynamicx);
+  }
+
+  if (hash_info->user != NULL)
+  {
+    hcfree (hash_info->user->user_name);
+    hcfree (hash_info->user);
+  }
+
+  hcfree (hash_info->orighash);
+  hcfree (hash_info->split);
+
+  hcfree (hash_info);
+}
+
+static void *resident_rebase (const void *ptr, const void *src_buf, const size_t src_size, void *dst_buf)
+{
+  if ((ptr == NULL) || (src_buf == NULL) || (dst_buf == NULL)) return NULL;
+
+  const uintptr_t ptr_addr = (uintptr_t) ptr;
+  const uintptr_t src_addr = (uintptr_t) src_buf;
+
+  // stage2 leaves pointers into freed stage1 buffers in hashes it did not need to touch
+
+  if ((ptr_addr < src_addr) || (ptr_addr > src_addr + src_size)) return NULL;
+
+  return ((char *) dst_buf) + (ptr_addr - src_addr);
+}
+
+static void resident_hashes_copy (const hashconfig_t *hashconfig, hashes_t *dst, const hashes_t *src)
+{
+  const u32 hashes_cnt = src->hashes_cnt;
+
+  const size_t digests_size    = (size_t) hashes_cnt * hashconfig->dgst_size;
+  const size_t salts_size      = (size_t) ((hashconfig->is_salted == true) ? hashes_cnt : 1) * sizeof (salt_t);
+  const size_t esalts_size     = (size_t) hashes_cnt * hashconfig->esalt_size;
+  const size_t hook_salts_size = (size_t) hashes_cnt * hashconfig->hook_salt_size;
+
+  dst->hashlist_format         = src->hashlist_format;
+  dst->parser_token_length_cnt = src->parser_token_length_cnt;
+
+  dst->hashes_cnt_orig = src->hashes_cnt_orig;
+  dst->hashes_cnt      = hashes_cnt;
+  dst->digests_cnt     = src->digests_cnt;
+  dst->salts_cnt       = src->salts_cnt;
+
+  dst->hashes_buf = (hash_t *) hcmalloc (hashes_cnt * sizeof (hash_t));
+
+  memcpy (dst->hashes_buf, src->hashes_buf, hashes_cnt * sizeof (hash_t));
+
+  dst->digests_buf = hcmalloc (digests_size);
+
+  memcpy (dst->digests_buf, src->digests_buf, digests_size);
+
+  dst->salts_buf = (salt_t *) hcmalloc (salts_size);
+
+  memcpy (dst->salts_buf, src->salts_buf, salts_size);
+
+  if (hashconfig->esalt_size > 0)
+  {
+    dst->esalts_buf = hcmalloc (esalts_size);
+
+    memcpy (dst->esalts_buf, src->esalts_buf, esalts_size);
+  }
+
+  if (hashconfig->hook_salt_size > 0)
+  {
+    dst->hook_salts_buf = hcmalloc (hook_salts_size);
+
+    memcpy (dst->hook_salts_buf, src->hook_salts_buf, hook_salts_size);
+  }
+
+  if (src->hash_info != NULL)
+  {
+    dst->hash_info = (hashinfo_t **) hccalloc (hashes_cnt, sizeof (hashinfo_t *));
+  }
+
+  for (u32 hashes_pos = 0; hashes_pos < hashes_cnt; hashes_pos++)
+  {
+    const hash_t *hash_src = src->hashes_buf + hashes_pos;
+
+    hash_t *hash = dst->hashes_buf + hashes_pos;
+
+    hash->digest    = resident_rebase (hash_src->digest,    src->digests_buf,    digests_size,    dst->digests_buf);
+    hash->salt      = resident_rebase (hash_src->salt,      src->salts_buf,      salts_size,      dst->salts_buf);
+    hash->esalt     = resident_rebase (hash_src->esalt,     src->esalts_buf,     esalts_size,     dst->esalts_buf);
+    hash->hook_salt = resident_rebase (hash_src->hook_salt, src->hook_salts_buf, hook_salts_size, dst->hook_salts_buf);
+
+    if ((hashconfig->is_salted == false) || (hash->salt == NULL))
+    {
+      hash->salt = dst->salts_buf;
+    }
+
+    hash->hash_info = resident_hash_info_copy (hash_src->hash_info);
+
+    if ((dst->hash_info != NULL) && (src->hash_info[hashes_pos] != NULL))
+    {
+      dst->hash_info[hashes_pos] = hash->hash_info;
+    }
+  }
+}
+
+static void resident_hashes_free (resident_ctx_t *resident_ctx)
+{
+  hashes_t *hashes = resident_ctx->hashes;
+
+  if (hashes != NULL)
+  {
+    for (u32 hashes_pos = 0; hashes_pos < hashes->hashes_cnt; hashes_pos++)
+    {
+      resident_hash_info_free (hashes->hashes_buf[hashes_pos].hash_info);
+    }
+
+    hcfree (hashes->hashes_buf);
+    hcfree (hashes->digests_buf);
+    hcfree (hashes->salts_buf);
+    hcfree (hashes->esalts_buf);
+    hcfree (hashes->hook_salts_buf);
+    hcfree (hashes->hash_info);
+
+    hcfree (hashes);
+  }
+
+  hcfree (resident_ctx->hashes_file);
+
+  resident_ctx->hashes      = NULL;
+  resident_ctx->hashes_file = NULL;
+
+  memset (&resident_ctx->hashes_key, 0, sizeof (resident_hashes_key_t));
+}
+
+static bool resident_hashes_key (hashcat_ctx_t *hashcat_ctx, resident_hashes_key_t *key)
+{
+  const hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  const hashes_t             *hashes             = hashcat_ctx->hashes;
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+
+  // only a hashfile can be checked for changes, and --remove rewrites it at the end of the job
+
+  if (hashes->hashfile == NULL) return false;
+
+  if (hashes->hashlist_mode == HL_MODE_ARG) return false;
+
+  if (user_options->benchmark   == true) return false;
+  if (user_options->keyspace    == true) return false;
+  if (user_options->stdout_flag == true) return false;
+  if (user_options->remove      == true) return false;
+
+  // the parsers read these files themselves, changes to them are not tracked
+
+  if (user_options->truecrypt_keyfiles      != NULL) return false;
+  if (user_options->veracrypt_keyfiles      != NULL) return false;
+  if (user_options->keyboard_layout_mapping != NULL) return false;
+
+  struct stat st;
+
+  if (stat (hashes->hashfile, &st) == -1) return false;
+
+  memset (key, 0, sizeof (resident_hashes_key_t));
+
+  key->hash_mode                    = (u32) hashconfig->hash_mode;
+  key->hashlist_mode                = hashes->hashlist_mode;
+  key->salt_type                    = hashconfig->salt_type;
+  key->dgst_size                    = hashconfig->dgst_size;
+  key->opti_type                    = hashconfig->opti_type;
+  key->opts_type                    = hashconfig->opts_type;
+  key->esalt_size                   = hashconfig->esalt_size;
+  key->hook_salt_size               = hashconfig->hook_salt_size;
+  key->is_salted                    = hashconfig->is_salted;
+  key->potfile_keep_all_hashes      = hashconfig->potfile_keep_all_hashes;
+  key->separator                    = hashconfig->separator;     // default, module or --separator
+  key->hlfmt_disable                = hashconfig->hlfmt_disable;
+  key->pwdump_column                = hashconfig->pwdump_column;
+  key->pw_max                       = hashconfig->pw_max;        // some decoders check the length of an embedded plain
+  key->salt_max                     = hashconfig->salt_max;      // depends on -O
+
+  key->association                  = (user_options->attack_mode == ATTACK_MODE_ASSOCIATION);
+  key->dynamic_x                    = user_options->dynamic_x;
+  key->hex_salt                     = user_options->hex_salt;
+  key->username                     = user_options->username;
+  key->hccapx_message_pair_chgd     = user_options->hccapx_message_pair_chgd;
+  key->hccapx_message_pair          = user_options->hccapx_message_pair;
+  key->nonce_error_corrections_chgd = user_options->nonce_error_corrections_chgd;
+  key->nonce_error_corrections      = user_options->nonce_error_corrections;
+
+  key->file_dev                     = (u64) st.st_dev;
+  key->file_ino                     = (u64) st.st_ino;
+  key->file_size                    = (u64) st.st_size;
+  key->file_mtime                   = (u64) st.st_mtime;
+
+  return true;
+}
+
+bool resident_hashes_load (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t *hashconfig   = hashcat_ctx->hashconfig;
+  hashes_t           *hashes       = hashcat_ctx->hashes;
+  resident_ctx_t     *resident_ctx = hashcat_ctx->resident_ctx;
+
+  if (resident_ctx->enabled == false) return false;
+
+  if (resident_ctx->hashes == NULL) return false;
+
+  resident_hashes_key_t key;
+
+  if (resident_hashes_key (hashcat_ctx, &key) == false) return false;
+
+  if (strcmp (resident_ctx->hashes_file, hashes->hashfile) != 0) return false;
+
+  if (memcmp (&resident_ctx->hashes_key, &key, sizeof (resident_hashes_key_t)) != 0) return false;
+
+  resident_hashes_copy (hashconfig, hashes, resident_ctx->hashes);
+
+  hashes->digests_shown = (u32 *) hccalloc (hashes->digests_cnt, sizeof (u32));
+  hashes->salts_shown   = (u32 *) hccalloc (hashes->digests_cnt, sizeof (u32));
+
+  return true;
+}
+
+void resident_hashes_store (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t *hashconfig   = hashcat_ctx->hashconfig;
+  const hashes_t     *hashes       = hashcat_ctx->hashes;
+  resident_ctx_t     *resident_ctx = hashcat_ctx->resident_ctx;
+
+  if (resident_ctx->enabled == false) return;
+
+  if (hashes->hashes_cnt == 0) return;
+
+  resident_hashes_key_t key;
+
+  if (resident_hashes_key (hashcat_ctx, &key) == false) return;
+
+  // keep only the hashlist of the last job, it costs as much memory as the job itself
+
+  resident_hashes_free (resident_ctx);
+
+  hashes_t *snapshot = (hashes_t *) hcmalloc (sizeof (hashes_t));
+
+  resident_hashes_copy (hashconfig, snapshot, hashes);
+
+  resident_ctx->hashes      = snapshot;
+  resident_ctx->hashes_file = hcstrdup (hashes->hashfile);
+
+  memcpy (&resident_ctx->hashes_key, &key, sizeof (resident_hashes_key_t));
+}
+
+static resident_tune_t *resident_tune_slot (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param)
+{
+  const backend_ctx_t  *backend_ctx  = hashcat_ctx->backend_ctx;
+  const resident_ctx_t *resident_ctx = hashcat_ctx->resident_ctx;
+
+  if (resident_ctx->enabled == false) return NULL;
+
+  const int backend_devices_idx = (int) (device_param - backend_ctx->devices_param);
+
+  if ((backend_devices_idx < 0) || (backend_devices_idx >= resident_ctx->tunes_cnt)) return NULL;
+
+  return resident_ctx->tunes_buf + backend_devices_idx;
+}
+
+static void resident_tune_key (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, resident_tune_key_t *key)
+{
+  const backend_ctx_t        *backend_ctx        = hashcat_ctx->backend_ctx;
+  const hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  const hashes_t             *hashes             = hashcat_ctx->hashes;
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  memset (key, 0, sizeof (resident_tune_key_t));
+
+  key->hash_mode          = (u32) hashconfig->hash_mode;
+  key->kern_type          = device_param->kern_type;
+  key->attack_exec        = hashconfig->attack_exec;
+  key->attack_kern        = user_options_extra->attack_kern;
+  key->attack_mode        = user_options->attack_mode;
+  key->opti_type          = hashconfig->opti_type;
+  key->opts_type          = hashconfig->opts_type;
+
+  key->salts_cnt          = hashes->salts_cnt;
+  key->digests_cnt        = hashes->digests_cnt;
+  key->salt_iter          = hashes->salts_buf[0].salt_iter;
+
+  key->target_msec        = backend_ctx->target_msec;
+  key->tune_energy        = user_options->tune_energy;
+  key->association_width  = user_options->association_width;
+
+  key->vector_width       = device_param->vector_width;
+  key->kernel_accel_min   = device_param->kernel_accel_min;
+  key->kernel_accel_max   = device_param->kernel_accel_max;
+  key->kernel_loops_min   = device_param->kernel_loops_min;
+  key->kernel_loops_max   = device_param->kernel_loops_max;
+  key->kernel_threads_min = device_param->kernel_threads_min;
+  key->kernel_threads_max = device_param->kernel_threads_max;
+}
+
+bool resident_tune_load (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, u32 *kernel_accel, u32 *kernel_loops, u32 *kernel_threads)
+{
+  const resident_tune_t *tune = resident_tune_slot (hashcat_ctx, device_param);
+
+  if (tune == NULL) return false;
+
+  if (tune->valid == false) return false;
+
+  resident_tune_key_t key;
+
+  resident_tune_key (hashcat_ctx, device_param, &key);
+
+  if (memcmp (&tune->key, &key, sizeof (resident_tune_key_t)) != 0) return false;
+
+  *kernel_accel   = tune->kernel_accel;
+  *kernel_loops   = tune->kernel_loops;
+  *kernel_threads = tune->kernel_threads;
+
+  if ((device_param->is_native == true) && (device_param->native_pool != NULL))
+  {
+    device_param->native_pool->workers_active = tune->workers_active;
+  }
+
+  return true;
+}
+
+void resident_tune_store (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param)
+{
+  resident_tune_t *tune = resident_tune_slot (hashcat_ctx, device_param);
+
+  if (tune == NULL) return;
+
+  resident_tune_key (hashcat_ctx, device_param, &tune->key);
+
+  tune->kernel_accel   = device_param->kernel_accel;
+  tune->kernel_loops   = device_param->kernel_loops;
+  tune->kernel_threads = device_param->kernel_threads;
+
+  tune->workers_active = ((device_param->is_native == true) && (device_param->native_pool != NULL)) ? device_param->native_pool->workers_active : 0;
+
+  tune->valid = true;
+}
+
+int resident_ctx_init (hashcat_ctx_t *hashcat_ctx)
+{
+  const backend_ctx_t *backend_ctx  = hashcat_ctx->backend_ctx;
+  resident_ctx_t      *resident_ctx = hashcat_ctx->resident_ctx;
+
+  memset (resident_ctx, 0, sizeof (resident_ctx_t));
+
+  resident_ctx->tunes_cnt = backend_ctx->backend_devices_cnt;
+  resident_ctx->tunes_buf = (resident_tune_t *) hccalloc (resident_ctx->tunes_cnt, sizeof (resident_tune_t));
+
+  resident_ctx->enabled = true;
+
+  return 0;
+}
+
+void resident_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  resident_ctx_t *resident_ctx = hashcat_ctx->resident_ctx;
+
+  if (resident_ctx->enabled == false) return;
+
+  resident_hashes_free (resident_ctx);
+
+  hcfree (resident_ctx->tunes_buf);
+
+  // the programs are the last thing left of the jobs, release them before a regular session takes over
+
+  resident_ctx->enabled = false;
+
+  backend_session_programs_destroy (hashcat_ctx);
+
+  memset (resident_ctx, 0, sizeof (resident_ctx_t));
+}
@@ -10,6 +10,7 @@
 #include "event.h"
 #include "shared.h"
 #include "filehandling.h"
+#include "emu_inc_hash_md5.h"
 #include "rp.h"
 #include "rp_cpu.h"
 
@@ -144,7 +145,9 @@ int conv_itoc (const u8 c)
 
 int generate_random_rule (char rule_buf[RP_RULE_SIZE], const u32 rp_gen_func_min, const u32 rp_gen_func_max, const rp_gen_ops_t *rp_gen_ops)
 {
-  // generate them
+  // get_random_num() includes max, the indices below therefore stop at cnt - 1
+
+  if (rp_gen_ops->grp_op_alias_cnt == 0) return 0;
 
   const u32 rp_gen_num = get_random_num (rp_gen_func_min, rp_gen_func_max);
 
@@ -156,40 +159,40 @@ int generate_random_rule (char rule_buf[RP_RULE_SIZE], const u32 rp_gen_func_min
     u32 p1 = 0;
     u32 p2 = 0;
 
-    const int group_num = get_random_num (0, rp_gen_ops->grp_op_alias_cnt);
+    const int group_num = get_random_num (0, rp_gen_ops->grp_op_alias_cnt - 1);
 
     const int group_num_alias = rp_gen_ops->grp_op_alias_buf[group_num];
 
     switch (group_num_alias)
     {
       case 0:
-        r = get_random_num (0, rp_gen_ops->grp_op_nop_cnt);
+        r = get_random_num (0, rp_gen_ops->grp_op_nop_cnt - 1);
         rule_buf[rule_pos++] = rp_gen_ops->grp_op_nop_selection[r];
         break;
 
       case 1:
-        r = get_random_num (0, rp_gen_ops->grp_op_pos_p0_cnt);
+        r = get_random_num (0, rp_gen_ops->grp_op_pos_p0_cnt - 1);
         rule_buf[rule_pos++] = rp_gen_ops->grp_op_pos_p0_selection[r];
-        p1 = get_random_num (0, sizeof (grp_pos));
+        p1 = get_random_num (0, sizeof (grp_pos) - 1);
         rule_buf[rule_pos++] = grp_pos[p1];
         break;
 
       case 2:
-        r = get_random_num (0, rp_gen_ops->grp_op_pos_p1_cnt);
+        r = get_random_num (0, rp_gen_ops->grp_op_pos_p1_cnt - 1);
         rule_buf[rule_pos++] = rp_gen_ops->grp_op_pos_p1_selection[r];
         p1 = get_random_num (1, 6);
         rule_buf[rule_pos++] = grp_pos[p1];
         break;
 
       case 3:
-        r = get_random_num (0, rp_gen_ops->grp_op_chr_cnt);
+        r = get_random_num (0, rp_gen_ops->grp_op_chr_cnt - 1);
         rule_buf[rule_pos++] = rp_gen_ops->grp_op_chr_selection[r];
         p1 = get_random_num (0x20, 0x7e);
         rule_buf[rule_pos++] = (char) p1;
         break;
 
       case 4:
-        r = get_random_num (0, rp_gen_ops->grp_op_chr_chr_cnt);
+        r = get_random_num (0, rp_gen_ops->grp_op_chr_chr_cnt - 1);
         rule_buf[rule_pos++] = rp_gen_ops->grp_op_chr_chr_selection[r];
         p1 = get_random_num (0x20, 0x7e);
         rule_buf[rule_pos++] = (char) p1;
@@ -200,33 +203,33 @@ int generate_random_rule (char rule_buf[RP_RULE_SIZE], const u32 rp_gen_func_min
         break;
 
       case 5:
-        r = get_random_num (0, rp_gen_ops->grp_op_pos_chr_cnt);
+        r = get_random_num (0, rp_gen_ops->grp_op_pos_chr_cnt - 1);
         rule_buf[rule_pos++] = rp_gen_ops->grp_op_pos_chr_selection[r];
-        p1 = get_random_num (0, sizeof (grp_pos));
+        p1 = get_random_num (0, sizeof (grp_pos) - 1);
         rule_buf[rule_pos++] = grp_pos[p1];
         p2 = get_random_num (0x20, 0x7e);
         rule_buf[rule_pos++] = (char) p2;
         break;
 
       case 6:
-        r = get_random_num (0, rp_gen_ops->grp_op_pos_pos0_cnt);
+        r = get_random_num (0, rp_gen_ops->grp_op_pos_pos0_cnt - 1);
         rule_buf[rule_pos++] = rp_gen_ops->grp_op_pos_pos0_selection[r];
-        p1 = get_random_num (0, sizeof (grp_pos));
+        p1 = get_random_num (0, sizeof (grp_pos) - 1);
         rule_buf[rule_pos++] = grp_pos[p1];
-        p2 = get_random_num (0, sizeof (grp_pos));
+        p2 = get_random_num (0, sizeof (grp_pos) - 1);
         while (p1 == p2)
-        p2 = get_random_num (0, sizeof (grp_pos));
+        p2 = get_random_num (0, sizeof (grp_pos) - 1);
         rule_buf[rule_pos++] = grp_pos[p2];
         break;
 
       case 7:
-        r = get_random_num (0, rp_gen_ops->grp_op_pos_pos1_cnt);
+        r = get_random_num (0, rp_gen_ops->grp_op_pos_pos1_cnt - 1);
         rule_buf[rule_pos++] = rp_gen_ops->grp_op_pos_pos1_selection[r];
-        p1 = get_random_num (0, sizeof (grp_pos));
+        p1 = get_random_num (0, sizeof (grp_pos) - 1);
         rule_buf[rule_pos++] = grp_pos[p1];
-        p2 = get_random_num (1, sizeof (grp_pos));
+        p2 = get_random_num (1, sizeof (grp_pos) - 1);
         while (p1 == p2)
-        p2 = get_random_num (1, sizeof (grp_pos));
+        p2 = get_random_num (1, sizeof (grp_pos) - 1);
         rule_buf[rule_pos++] = grp_pos[p2];
         break;
     }
@@ -825,6 +828,256 @@ bool kernel_rules_has_noop (const kernel_rule_t *kernel_rules_buf, const u32 ker
   return false;
 }
 
+static const char *const rp_probe_words[] =
+{
+  "a",
+  "A",
+  "1",
+  "!",
+  "ab",
+  "abc",
+  "aaaa",
+  "aAaA",
+  "zzz",
+  "123456",
+  "abc123",
+  "qwerty",
+  "monkey",
+  "dragon",
+  "letmein1",
+  "iloveyou",
+  "password",
+  "Password",
+  "PASSWORD",
+  "p@ssw0rd",
+  "Passw0rd!",
+  "Admin2024",
+  "Summer2019!",
+  "hello world",
+  "correct horse battery staple",
+};
+
+static int rp_probe_init (char ***out_buf, u32 *out_cnt)
+{
+  static const char alnum[] = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+  const u32 words_cnt = sizeof (rp_probe_words) / sizeof (char *);
+
+  const u32 probes_cnt = 1 + RP_PROBE_LEN_MAX + (0x7f - 0x20) + RP_PROBE_LEN_ROT + 1 + words_cnt;
+
+  char **probes = (char **) hccalloc (probes_cnt, sizeof (char *));
+
+  u32 cnt = 0;
+
+  // empty word
+
+  probes[cnt++] = (char *) hccalloc (1, 1);
+
+  // every length with a distinct character on each position, this catches positional and length based rules
+
+  for (u32 len = 1; len <= RP_PROBE_LEN_MAX; len++)
+  {
+    char *probe = (char *) hccalloc (len + 1, 1);
+
+    for (u32 i = 0; i < len; i++)
+    {
+      probe[i] = alnum[((i * 7) + len) % (sizeof (alnum) - 1)];
+    }
+
+    probes[cnt++] = probe;
+  }
+
+  // all printable characters on every position up to RP_PROBE_LEN_ROT, and all remaining bytes, this catches character based rules
+
+  const u32 printable_cnt = 0x7f - 0x20;
+
+  for (u32 rot = 0; rot < printable_cnt; rot++)
+  {
+    char *probe = (char *) hccalloc (RP_PROBE_LEN_ROT + 1, 1);
+
+    for (u32 i = 0; i < RP_PROBE_LEN_ROT; i++)
+    {
+      probe[i] = (char) (0x20 + ((rot + i) % printable_cnt));
+    }
+
+    probes[cnt++] = probe;
+  }
+
+  // a space in front of a letter on every position, this catches word separator based rules
+
+  for (u32 pos = 0; pos < RP_PROBE_LEN_ROT; pos++)
+  {
+    char *probe = (char *) hccalloc (RP_PROBE_LEN_ROT + 1, 1);
+
+    for (u32 i = 0; i < RP_PROBE_LEN_ROT; i++)
+    {
+      probe[i] = (i == pos) ? ' ' : alnum[i % 26];
+    }
+
+    probes[cnt++] = probe;
+  }
+
+  char *binary = (char *) hccalloc (0x20 - 0x01 + 0x100 - 0x7f + 1, 1);
+
+  u32 binary_len = 0;
+
+  for (u32 c = 0x01; c < 0x20;  c++) binary[binary_len++] = (char) c;
+  for (u32 c = 0x7f; c < 0x100; c++) binary[binary_len++] = (char) c;
+
+  probes[cnt++] = binary;
+
+  // some real-world words
+
+  for (u32 i = 0; i < words_cnt; i++)
+  {
+    probes[cnt++] = hcstrdup (rp_probe_words[i]);
+  }
+
+  *out_buf = probes;
+  *out_cnt = cnt;
+
+  return 0;
+}
+
+static int sort_by_kernel_rule_fp (const void *p1, const void *p2)
+{
+  const kernel_rule_fp_t *r1 = (const kernel_rule_fp_t *) p1;
+  const kernel_rule_fp_t *r2 = (const kernel_rule_fp_t *) p2;
+
+  for (int i = 0; i < 4; i++)
+  {
+    if (r1->fp[i] > r2->fp[i]) return  1;
+    if (r1->fp[i] < r2->fp[i]) return -1;
+  }
+
+  if (r1->pos > r2->pos) return  1;
+  if (r1->pos < r2->pos) return -1;
+
+  return 0;
+}
+
+int kernel_rules_optimize (hashcat_ctx_t *hashcat_ctx, kernel_rule_t *kernel_rules_buf, u32 *kernel_rules_cnt)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  const u32 rules_cnt = *kernel_rules_cnt;
+
+  if (rules_cnt < 2) return 0;
+
+  char **probes = NULL;
+
+  u32 probes_cnt = 0;
+
+  rp_probe_init (&probes, &probes_cnt);
+
+  u32 *probes_len = (u32 *) hccalloc (probes_cnt, sizeof (u32));
+
+  for (u32 i = 0; i < probes_cnt; i++)
+  {
+    probes_len[i] = (u32) strlen (probes[i]);
+  }
+
+  kernel_rule_fp_t *fps = (kernel_rule_fp_t *) hccalloc (rules_cnt, sizeof (kernel_rule_fp_t));
+
+  char *rule_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  // fingerprint each rule by its output (or rejection) on all probe words
+  // rules with the same fingerprint produce the same candidates and only the first one is kept
+  // this includes all rules which behave like ':'
+  // a rule which rejects every probe word says nothing about its output, it is always kept
+
+  for (u32 rules_pos = 0; rules_pos < rules_cnt; rules_pos++)
+  {
+    const int rule_len = kernel_rule_to_cpu_rule (rule_buf, &kernel_rules_buf[rules_pos]);
+
+    md5_ctx_t md5_ctx;
+
+    md5_init (&md5_ctx);
+
+    for (u32 i = 0; i < probes_cnt; i++)
+    {
+      // md5_update() expects the buffer to be zero padded to the next 64 byte block
+
+      char in[RP_PASSWORD_SIZE];
+      u32  out[1 + (RP_PASSWORD_SIZE / 4) + 16];
+
+      memset (in,  0, sizeof (in));
+      memset (out, 0, sizeof (out));
+
+      memcpy (in, probes[i], probes_len[i]);
+
+      char *out_ptr = (char *) (out + 1);
+
+      const int out_len = (rule_len == -1) ? -1 : _old_apply_rule (rule_buf, rule_len, in, (int) probes_len[i], out_ptr);
+
+      if (out_len >= 0) memset (out_ptr + out_len, 0, RP_PASSWORD_SIZE - out_len);
+
+      out[0] = (u32) out_len;
+
+      if (out_len >= 0) fps[rules_pos].accepted = true;
+
+      md5_update (&md5_ctx, out, 4 + MAX (out_len, 0));
+    }
+
+    md5_final (&md5_ctx);
+
+    fps[rules_pos].fp[0] = md5_ctx.h[0];
+    fps[rules_pos].fp[1] = md5_ctx.h[1];
+    fps[rules_pos].fp[2] = md5_ctx.h[2];
+    fps[rules_pos].fp[3] = md5_ctx.h[3];
+    fps[rules_pos].pos   = rules_pos;
+  }
+
+  hcfree (rule_buf);
+
+  for (u32 i = 0; i < probes_cnt; i++) hcfree (probes[i]);
+
+  hcfree (probes);
+  hcfree (probes_len);
+
+  qsort (fps, rules_cnt, sizeof (kernel_rule_fp_t), sort_by_kernel_rule_fp);
+
+  bool *keep = (bool *) hccalloc (rules_cnt, sizeof (bool));
+
+  for (u32 i = 0; i < rules_cnt; i++)
+  {
+    if ((i > 0) && (fps[i].accepted == true) && (memcmp (fps[i].fp, fps[i - 1].fp, sizeof (fps[i].fp)) == 0)) continue;
+
+    keep[fps[i].pos] = true;
+  }
+
+  hcfree (fps);
+
+  // compact, the order of the rules stays the same
+
+  u32 kept_cnt = 0;
+
+  for (u32 rules_pos = 0; rules_pos < rules_cnt; rules_pos++)
+  {
+    if (keep[rules_pos] == false) continue;
+
+    if (kept_cnt != rules_pos) memcpy (&kernel_rules_buf[kept_cnt], &kernel_rules_buf[rules_pos], sizeof (kernel_rule_t));
+
+    kept_cnt++;
+  }
+
+  memset (&kernel_rules_buf[kept_cnt], 0, (rules_cnt - kept_cnt) * sizeof (kernel_rule_t));
+
+  hcfree (keep);
+
+  if (user_options->quiet == false)
+  {
+    const u32 removed_cnt = rules_cnt - kept_cnt;
+
+    event_log_info (hashcat_ctx, "Rules optimizer: removed %u of %u rules as redundant, keyspace reduced by %.2f%%.", removed_cnt, rules_cnt, ((double) removed_cnt * 100) / rules_cnt);
+    event_log_info (hashcat_ctx, NULL);
+  }
+
+  *kernel_rules_cnt = kept_cnt;
+
+  return 0;
+}
+
 int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt)
 {
   const user_options_t *user_options = hashcat_ctx->user_options;
@@ -1065,6 +1318,11 @@ int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32
   hcfree (all_kernel_rules_cnt);
   hcfree (all_kernel_rules_buf);
 
+  if ((user_options->rules_optimize == true) || (user_options->rules_optimize_out != NULL))
+  {
+    kernel_rules_optimize (hashcat_ctx, kernel_rules_buf, &kernel_rules_cnt);
+  }
+
   if (kernel_rules_cnt == 0)
   {
     event_log_error (hashcat_ctx, "No valid rules left.");
@@ -1080,52 +1338,86 @@ int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32
   return 0;
 }
 
-int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt, const char *rp_gen_func_selection)
+int kernel_rules_optimize_out (hashcat_ctx_t *hashcat_ctx)
 {
   const user_options_t *user_options = hashcat_ctx->user_options;
 
-  u32            kernel_rules_cnt = 0;
-  kernel_rule_t *kernel_rules_buf = (kernel_rule_t *) hccalloc (user_options->rp_gen, sizeof (kernel_rule_t));
+  kernel_rule_t *kernel_rules_buf = NULL;
 
-  // operator selection
+  u32 kernel_rules_cnt = 0;
 
-  rp_gen_ops_t rp_gen_ops;
+  if (kernel_rules_load (hashcat_ctx, &kernel_rules_buf, &kernel_rules_cnt) == -1) return -1;
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, user_options->rules_optimize_out, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", user_options->rules_optimize_out, strerror (errno));
+
+    hcfree (kernel_rules_buf);
+
+    return -1;
+  }
+
+  char *rule_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  for (u32 i = 0; i < kernel_rules_cnt; i++)
+  {
+    const int rule_len = kernel_rule_to_cpu_rule (rule_buf, &kernel_rules_buf[i]);
+
+    if (rule_len == -1) continue;
+
+    rule_buf[rule_len] = 0;
+
+    hc_fprintf (&fp, "%s\n", rule_buf);
+  }
+
+  hc_fclose (&fp);
 
-  rp_gen_ops.grp_op_nop_selection      = hcmalloc (sizeof (grp_op_nop));
-  rp_gen_ops.grp_op_pos_p0_selection   = hcmalloc (sizeof (grp_op_pos_p0));
-  rp_gen_ops.grp_op_pos_p1_selection   = hcmalloc (sizeof (grp_op_pos_p1));
-  rp_gen_ops.grp_op_chr_selection      = hcmalloc (sizeof (grp_op_chr));
-  rp_gen_ops.grp_op_chr_chr_selection  = hcmalloc (sizeof (grp_op_chr_chr));
-  rp_gen_ops.grp_op_pos_chr_selection  = hcmalloc (sizeof (grp_op_pos_chr));
-  rp_gen_ops.grp_op_pos_pos0_selection = hcmalloc (sizeof (grp_op_pos_pos0));
-  rp_gen_ops.grp_op_pos_pos1_selection = hcmalloc (sizeof (grp_op_pos_pos1));
-
-  rp_gen_ops.grp_op_nop_cnt      = 0;
-  rp_gen_ops.grp_op_pos_p0_cnt   = 0;
-  rp_gen_ops.grp_op_pos_p1_cnt   = 0;
-  rp_gen_ops.grp_op_chr_cnt      = 0;
-  rp_gen_ops.grp_op_chr_chr_cnt  = 0;
-  rp_gen_ops.grp_op_pos_chr_cnt  = 0;
-  rp_gen_ops.grp_op_pos_pos0_cnt = 0;
-  rp_gen_ops.grp_op_pos_pos1_cnt = 0;
-
-  rp_gen_ops.grp_op_alias_cnt = 0;
+  hcfree (rule_buf);
+
+  hcfree (kernel_rules_buf);
+
+  return 0;
+}
+
+void rp_gen_ops_init (rp_gen_ops_t *rp_gen_ops, const char *rp_gen_func_selection)
+{
+  rp_gen_ops->grp_op_nop_selection      = hcmalloc (sizeof (grp_op_nop));
+  rp_gen_ops->grp_op_pos_p0_selection   = hcmalloc (sizeof (grp_op_pos_p0));
+  rp_gen_ops->grp_op_pos_p1_selection   = hcmalloc (sizeof (grp_op_pos_p1));
+  rp_gen_ops->grp_op_chr_selection      = hcmalloc (sizeof (grp_op_chr));
+  rp_gen_ops->grp_op_chr_chr_selection  = hcmalloc (sizeof (grp_op_chr_chr));
+  rp_gen_ops->grp_op_pos_chr_selection  = hcmalloc (sizeof (grp_op_pos_chr));
+  rp_gen_ops->grp_op_pos_pos0_selection = hcmalloc (sizeof (grp_op_pos_pos0));
+  rp_gen_ops->grp_op_pos_pos1_selection = hcmalloc (sizeof (grp_op_pos_pos1));
+
+  rp_gen_ops->grp_op_nop_cnt      = 0;
+  rp_gen_ops->grp_op_pos_p0_cnt   = 0;
+  rp_gen_ops->grp_op_pos_p1_cnt   = 0;
+  rp_gen_ops->grp_op_chr_cnt      = 0;
+  rp_gen_ops->grp_op_chr_chr_cnt  = 0;
+  rp_gen_ops->grp_op_pos_chr_cnt  = 0;
+  rp_gen_ops->grp_op_pos_pos0_cnt = 0;
+  rp_gen_ops->grp_op_pos_pos1_cnt = 0;
+
+  rp_gen_ops->grp_op_alias_cnt = 0;
 
   for (size_t i = 0; i < sizeof (grp_op_nop); i++)
   {
     if (rp_gen_func_selection == NULL)
     {
-      rp_gen_ops.grp_op_nop_selection[rp_gen_ops.grp_op_nop_cnt] = grp_op_nop[i];
+      rp_gen_ops->grp_op_nop_selection[rp_gen_ops->grp_op_nop_cnt] = grp_op_nop[i];
 
-      rp_gen_ops.grp_op_nop_cnt++;
+      rp_gen_ops->grp_op_nop_cnt++;
     }
     else
     {
       if (strchr (rp_gen_func_selection, grp_op_nop[i]) == NULL) continue;
 
-      rp_gen_ops.grp_op_nop_selection[rp_gen_ops.grp_op_nop_cnt] = grp_op_nop[i];
+      rp_gen_ops->grp_op_nop_selection[rp_gen_ops->grp_op_nop_cnt] = grp_op_nop[i];
 
-      rp_gen_ops.grp_op_nop_cnt++;
+      rp_gen_ops->grp_op_nop_cnt++;
     }
   }
 
@@ -1133,17 +1425,17 @@ int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf,
   {
     if (rp_gen_func_selection == NULL)
     {
-      rp_gen_ops.grp_op_pos_p0_selection[rp_gen_ops.grp_op_pos_p0_cnt] = grp_op_nop[i];
+      rp_gen_ops->grp_op_pos_p0_selection[rp_gen_ops->grp_op_pos_p0_cnt] = grp_op_pos_p0[i];
 
-      rp_gen_ops.grp_op_pos_p0_cnt++;
+      rp_gen_ops->grp_op_pos_p0_cnt++;
     }
     else
     {
       if (strchr (rp_gen_func_selection, grp_op_pos_p0[i]) == NULL) continue;
 
-      rp_gen_ops.grp_op_pos_p0_selection[rp_gen_ops.grp_op_pos_p0_cnt] = grp_op_pos_p0[i];
+      rp_gen_ops->grp_op_pos_p0_selection[rp_gen_ops->grp_op_pos_p0_cnt] = grp_op_pos_p0[i];
 
-      rp_gen_ops.grp_op_pos_p0_cnt++;
+      rp_gen_ops->grp_op_pos_p0_cnt++;
     }
   }
 
@@ -1151,17 +1443,17 @@ int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf,
   {
     if (rp_gen_func_selection == NULL)
     {
-      rp_gen_ops.grp_op_pos_p1_selection[rp_gen_ops.grp_op_pos_p1_cnt] = grp_op_pos_p1[i];
+      rp_gen_ops->grp_op_pos_p1_selection[rp_gen_ops->grp_op_pos_p1_cnt] = grp_op_pos_p1[i];
 
-      rp_gen_ops.grp_op_pos_p1_cnt++;
+      rp_gen_ops->grp_op_pos_p1_cnt++;
     }
     else
     {
       if (strchr (rp_gen_func_selection, grp_op_pos_p1[i]) == NULL) continue;
 
-      rp_gen_ops.grp_op_pos_p1_selection[rp_gen_ops.grp_op_pos_p1_cnt] = grp_op_pos_p1[i];
+      rp_gen_ops->grp_op_pos_p1_selection[rp_gen_ops->grp_op_pos_p1_cnt] = grp_op_pos_p1[i];
 
-      rp_gen_ops.grp_op_pos_p1_cnt++;
+      rp_gen_ops->grp_op_pos_p1_cnt++;
     }
   }
 
@@ -1169,17 +1461,17 @@ int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf,
   {
     if (rp_gen_func_selection == NULL)
     {
-      rp_gen_ops.grp_op_chr_selection[rp_gen_ops.grp_op_chr_cnt] = grp_op_chr[i];
+      rp_gen_ops->grp_op_chr_selection[rp_gen_ops->grp_op_chr_cnt] = grp_op_chr[i];
 
-      rp_gen_ops.grp_op_chr_cnt++;
+      rp_gen_ops->grp_op_chr_cnt++;
     }
     else
     {
       if (strchr (rp_gen_func_selection, grp_op_chr[i]) == NULL) continue;
 
-      rp_gen_ops.grp_op_chr_selection[rp_gen_ops.grp_op_chr_cnt] = grp_op_chr[i];
+      rp_gen_ops->grp_op_chr_selection[rp_gen_ops->grp_op_chr_cnt] = grp_op_chr[i];
 
-      rp_gen_ops.grp_op_chr_cnt++;
+      rp_gen_ops->grp_op_chr_cnt++;
     }
   }
 
@@ -1187,17 +1479,17 @@ int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf,
   {
     if (rp_gen_func_selection == NULL)
     {
-      rp_gen_ops.grp_op_chr_chr_selection[rp_gen_ops.grp_op_chr_chr_cnt] = grp_op_chr_chr[i];
+      rp_gen_ops->grp_op_chr_chr_selection[rp_gen_ops->grp_op_chr_chr_cnt] = grp_op_chr_chr[i];
 
-      rp_gen_ops.grp_op_chr_chr_cnt++;
+      rp_gen_ops->grp_op_chr_chr_cnt++;
     }
     else
     {
       if (strchr (rp_gen_func_selection, grp_op_chr_chr[i]) == NULL) continue;
 
-      rp_gen_ops.grp_op_chr_chr_selection[rp_gen_ops.grp_op_chr_chr_cnt] = grp_op_chr_chr[i];
+      rp_gen_ops->grp_op_chr_chr_selection[rp_gen_ops->grp_op_chr_chr_cnt] = grp_op_chr_chr[i];
 
-      rp_gen_ops.grp_op_chr_chr_cnt++;
+      rp_gen_ops->grp_op_chr_chr_cnt++;
     }
   }
 
@@ -1205,17 +1497,17 @@ int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf,
   {
     if (rp_gen_func_selection == NULL)
     {
-      rp_gen_ops.grp_op_pos_chr_selection[rp_gen_ops.grp_op_pos_chr_cnt] = grp_op_pos_chr[i];
+      rp_gen_ops->grp_op_pos_chr_selection[rp_gen_ops->grp_op_pos_chr_cnt] = grp_op_pos_chr[i];
 
-      rp_gen_ops.grp_op_pos_chr_cnt++;
+      rp_gen_ops->grp_op_pos_chr_cnt++;
     }
     else
     {
       if (strchr (rp_gen_func_selection, grp_op_pos_chr[i]) == NULL) continue;
 
-      rp_gen_ops.grp_op_pos_chr_selection[rp_gen_ops.grp_op_pos_chr_cnt] = grp_op_pos_chr[i];
+      rp_gen_ops->grp_op_pos_chr_selection[rp_gen_ops->grp_op_pos_chr_cnt] = grp_op_pos_chr[i];
 
-      rp_gen_ops.grp_op_pos_chr_cnt++;
+      rp_gen_ops->grp_op_pos_chr_cnt++;
     }
   }
 
@@ -1223,17 +1515,17 @@ int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf,
   {
     if (rp_gen_func_selection == NULL)
     {
-      rp_gen_ops.grp_op_pos_pos0_selection[rp_gen_ops.grp_op_pos_pos0_cnt] = grp_op_pos_pos0[i];
+      rp_gen_ops->grp_op_pos_pos0_selection[rp_gen_ops->grp_op_pos_pos0_cnt] = grp_op_pos_pos0[i];
 
-      rp_gen_ops.grp_op_pos_pos0_cnt++;
+      rp_gen_ops->grp_op_pos_pos0_cnt++;
     }
     else
     {
       if (strchr (rp_gen_func_selection, grp_op_pos_pos0[i]) == NULL) continue;
 
-      rp_gen_ops.grp_op_pos_pos0_selection[rp_gen_ops.grp_op_pos_pos0_cnt] = grp_op_pos_pos0[i];
+      rp_gen_ops->grp_op_pos_pos0_selection[rp_gen_ops->grp_op_pos_pos0_cnt] = grp_op_pos_pos0[i];
 
-      rp_gen_ops.grp_op_pos_pos0_cnt++;
+      rp_gen_ops->grp_op_pos_pos0_cnt++;
     }
   }
 
@@ -1241,28 +1533,52 @@ int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf,
   {
     if (rp_gen_func_selection == NULL)
     {
-      rp_gen_ops.grp_op_pos_pos1_selection[rp_gen_ops.grp_op_pos_pos1_cnt] = grp_op_pos_pos1[i];
+      rp_gen_ops->grp_op_pos_pos1_selection[rp_gen_ops->grp_op_pos_pos1_cnt] = grp_op_pos_pos1[i];
 
-      rp_gen_ops.grp_op_pos_pos1_cnt++;
+      rp_gen_ops->grp_op_pos_pos1_cnt++;
     }
     else
     {
       if (strchr (rp_gen_func_selection, grp_op_pos_pos1[i]) == NULL) continue;
 
-      rp_gen_ops.grp_op_pos_pos1_selection[rp_gen_ops.grp_op_pos_pos1_cnt] = grp_op_pos_pos1[i];
+      rp_gen_ops->grp_op_pos_pos1_selection[rp_gen_ops->grp_op_pos_pos1_cnt] = grp_op_pos_pos1[i];
 
-      rp_gen_ops.grp_op_pos_pos1_cnt++;
+      rp_gen_ops->grp_op_pos_pos1_cnt++;
     }
   }
 
-  if (rp_gen_ops.grp_op_nop_cnt)      { rp_gen_ops.grp_op_alias_buf[rp_gen_ops.grp_op_alias_cnt++] = 0; };
-  if (rp_gen_ops.grp_op_pos_p0_cnt)   { rp_gen_ops.grp_op_alias_buf[rp_gen_ops.grp_op_alias_cnt++] = 1; };
-  if (rp_gen_ops.grp_op_pos_p1_cnt)   { rp_gen_ops.grp_op_alias_buf[rp_gen_ops.grp_op_alias_cnt++] = 2; };
-  if (rp_gen_ops.grp_op_chr_cnt)      { rp_gen_ops.grp_op_alias_buf[rp_gen_ops.grp_op_alias_cnt++] = 3; };
-  if (rp_gen_ops.grp_op_chr_chr_cnt)  { rp_gen_ops.grp_op_alias_buf[rp_gen_ops.grp_op_alias_cnt++] = 4; };
-  if (rp_gen_ops.grp_op_pos_chr_cnt)  { rp_gen_ops.grp_op_alias_buf[rp_gen_ops.grp_op_alias_cnt++] = 5; };
-  if (rp_gen_ops.grp_op_pos_pos0_cnt) { rp_gen_ops.grp_op_alias_buf[rp_gen_ops.grp_op_alias_cnt++] = 6; };
-  if (rp_gen_ops.grp_op_pos_pos1_cnt) { rp_gen_ops.grp_op_alias_buf[rp_gen_ops.grp_op_alias_cnt++] = 7; };
+  if (rp_gen_ops->grp_op_nop_cnt)      { rp_gen_ops->grp_op_alias_buf[rp_gen_ops->grp_op_alias_cnt++] = 0; };
+  if (rp_gen_ops->grp_op_pos_p0_cnt)   { rp_gen_ops->grp_op_alias_buf[rp_gen_ops->grp_op_alias_cnt++] = 1; };
+  if (rp_gen_ops->grp_op_pos_p1_cnt)   { rp_gen_ops->grp_op_alias_buf[rp_gen_ops->grp_op_alias_cnt++] = 2; };
+  if (rp_gen_ops->grp_op_chr_cnt)      { rp_gen_ops->grp_op_alias_buf[rp_gen_ops->grp_op_alias_cnt++] = 3; };
+  if (rp_gen_ops->grp_op_chr_chr_cnt)  { rp_gen_ops->grp_op_alias_buf[rp_gen_ops->grp_op_alias_cnt++] = 4; };
+  if (rp_gen_ops->grp_op_pos_chr_cnt)  { rp_gen_ops->grp_op_alias_buf[rp_gen_ops->grp_op_alias_cnt++] = 5; };
+  if (rp_gen_ops->grp_op_pos_pos0_cnt) { rp_gen_ops->grp_op_alias_buf[rp_gen_ops->grp_op_alias_cnt++] = 6; };
+  if (rp_gen_ops->grp_op_pos_pos1_cnt) { rp_gen_ops->grp_op_alias_buf[rp_gen_ops->grp_op_alias_cnt++] = 7; };
+}
+
+void rp_gen_ops_destroy (rp_gen_ops_t *rp_gen_ops)
+{
+  hcfree (rp_gen_ops->grp_op_nop_selection);
+  hcfree (rp_gen_ops->grp_op_pos_p0_selection);
+  hcfree (rp_gen_ops->grp_op_pos_p1_selection);
+  hcfree (rp_gen_ops->grp_op_chr_selection);
+  hcfree (rp_gen_ops->grp_op_chr_chr_selection);
+  hcfree (rp_gen_ops->grp_op_pos_chr_selection);
+  hcfree (rp_gen_ops->grp_op_pos_pos0_selection);
+  hcfree (rp_gen_ops->grp_op_pos_pos1_selection);
+}
+
+int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt, const char *rp_gen_func_selection)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  u32            kernel_rules_cnt = 0;
+  kernel_rule_t *kernel_rules_buf = (kernel_rule_t *) hccalloc (user_options->rp_gen, sizeof (kernel_rule_t));
+
+  rp_gen_ops_t rp_gen_ops;
+
+  rp_gen_ops_init (&rp_gen_ops, rp_gen_func_selection);
 
   char *rule_buf = (char *) hcmalloc (RP_RULE_SIZE);
 
@@ -1277,14 +1593,7 @@ int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf,
 
   hcfree (rule_buf);
 
-  hcfree (rp_gen_ops.grp_op_nop_selection);
-  hcfree (rp_gen_ops.grp_op_pos_p0_selection);
-  hcfree (rp_gen_ops.grp_op_pos_p1_selection);
-  hcfree (rp_gen_ops.grp_op_chr_selection);
-  hcfree (rp_gen_ops.grp_op_chr_chr_selection);
-  hcfree (rp_gen_ops.grp_op_pos_chr_selection);
-  hcfree (rp_gen_ops.grp_op_pos_pos0_selection);
-  hcfree (rp_gen_ops.grp_op_pos_pos1_selection);
+  rp_gen_ops_destroy (&rp_gen_ops);
 
   *out_cnt = kernel_rules_cnt;
   *out_buf = kernel_rules_buf;
@@ -1776,3 +1776,35 @@ int run_rule_engine (const int rule_len, const char *rule_buf)
 
   return 1;
 }
+
+bool run_rule_engine_rejects (const int rule_len, const char *rule_buf)
+{
+  // a rule that fits a kernel rule has no memory functions and only the class based reject functions
+  // without those, _old_apply_rule () does not reject a word shorter than RP_PASSWORD_SIZE
+
+  kernel_rule_t kernel_rule;
+
+  memset (&kernel_rule, 0, sizeof (kernel_rule));
+
+  if (cpu_rule_to_kernel_rule ((char *) rule_buf, (u32) rule_len, &kernel_rule) == -1) return true;
+
+  for (int i = 0; i < MAX_KERNEL_RULES; i++)
+  {
+    const u8 name = (u8) kernel_rule.cmds[i];
+
+    if (name == 0) break;
+
+    switch (name)
+    {
+      case RULE_OP_REJECT_CONTAIN_CLASS:
+      case RULE_OP_REJECT_NOT_CONTAIN_CLASS:
+      case RULE_OP_REJECT_EQUAL_FIRST_CLASS:
+      case RULE_OP_REJECT_EQUAL_LAST_CLASS:
+      case RULE_OP_REJECT_EQUAL_AT_CLASS:
+      case RULE_OP_REJECT_CONTAINS_CLASS:
+        return true;
+    }
+  }
+
+  return false;
+}
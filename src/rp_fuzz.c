@@ -0,0 +1,368 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "shared.h"
+#include "timer.h"
+#include "convert.h"
+#include "rp.h"
+#include "rp_cpu.h"
+#include "emu_inc_rp.h"
+#include "emu_inc_rp_optimized.h"
+#include "rp_simd.h"
+#include "rp_fuzz.h"
+
+// the rule engines, each one is handed the same rule and words and writes its results to out
+
+static void rp_fuzz_apply_cpu (const rp_fuzz_rule_t *rule, const rp_fuzz_word_t *words, const int words_cnt, rp_fuzz_word_t *out)
+{
+  for (int i = 0; i < words_cnt; i++)
+  {
+    out[i].len = _old_apply_rule (rule->rule_buf, rule->rule_len, (char *) words[i].buf, words[i].len, out[i].buf);
+  }
+}
+
+static void rp_fuzz_apply_pure (const rp_fuzz_rule_t *rule, const rp_fuzz_word_t *words, const int words_cnt, rp_fuzz_word_t *out)
+{
+  for (int i = 0; i < words_cnt; i++)
+  {
+    u32 buf[64] = { 0 };
+
+    memcpy (buf, words[i].buf, words[i].len);
+
+    const int out_len = apply_rules (rule->kernel_rule.cmds, buf, words[i].len);
+
+    memcpy (out[i].buf, buf, MIN (out_len, (int) sizeof (buf)));
+
+    out[i].len = out_len;
+  }
+}
+
+static void rp_fuzz_apply_optimized (const rp_fuzz_rule_t *rule, const rp_fuzz_word_t *words, const int words_cnt, rp_fuzz_word_t *out)
+{
+  for (int i = 0; i < words_cnt; i++)
+  {
+    u32 buf[8] = { 0 };
+
+    const int in_len = MIN (words[i].len, RP_FUZZ_OPTI_LEN_MAX);
+
+    memcpy (buf, words[i].buf, in_len);
+
+    const int out_len = (int) apply_rules_optimized (rule->kernel_rule.cmds, buf + 0, buf + 4, (u32) in_len);
+
+    memcpy (out[i].buf, buf, MIN (out_len, (int) sizeof (buf)));
+
+    out[i].len = out_len;
+  }
+}
+
+static void rp_fuzz_apply_simd (const rp_fuzz_rule_t *rule, const rp_fuzz_word_t *words, const int words_cnt, rp_fuzz_word_t *out)
+{
+  rp_simd_t *rp_simd = (rp_simd_t *) hcmalloc (sizeof (rp_simd_t));
+
+  rp_simd_init (rp_simd, rule->rule_buf, rule->rule_len);
+
+  for (int i = 0; i < words_cnt; i += RP_SIMD_LANES)
+  {
+    const int batch_cnt = MIN (words_cnt - i, RP_SIMD_LANES);
+
+    rp_simd_reset (rp_simd);
+
+    for (int j = 0; j < batch_cnt; j++) rp_simd_add (rp_simd, words[i + j].buf, words[i + j].len);
+
+    rp_simd_apply (rp_simd);
+
+    for (int j = 0; j < batch_cnt; j++)
+    {
+      const int out_len = rp_simd->out_len[j];
+
+      memcpy (out[i + j].buf, rp_simd->out_buf[j], MAX (out_len, 0));
+
+      out[i + j].len = out_len;
+    }
+  }
+
+  hcfree (rp_simd);
+}
+
+static const rp_fuzz_engine_t RP_FUZZ_ENGINES[] =
+{
+  { "_old_apply_rule (rp_cpu.c)",                   rp_fuzz_apply_cpu,       RP_FUZZ_PURE_LEN_MAX, 0, 0, 0 },
+  { "apply_rules (inc_rp.cl)",                      rp_fuzz_apply_pure,      RP_FUZZ_PURE_LEN_MAX, 0, 0, 0 },
+  { "apply_rules_optimized (inc_rp_optimized.cl)",  rp_fuzz_apply_optimized, RP_FUZZ_OPTI_LEN_MAX, 0, 0, 0 },
+  { "rp_simd_apply (rp_simd.c)",                    rp_fuzz_apply_simd,      RP_FUZZ_PURE_LEN_MAX, 0, 0, 0 },
+};
+
+#define RP_FUZZ_ENGINES_CNT (sizeof (RP_FUZZ_ENGINES) / sizeof (RP_FUZZ_ENGINES[0]))
+
+// the longest intermediate result of the reference engine, after each function of the rule
+// an engine is only compared if all of them fit into it, the ones which don't are reported as skipped
+
+static int rp_fuzz_len_max (const rp_fuzz_rule_t *rule, const rp_fuzz_word_t *word)
+{
+  int len_max = word->len;
+
+  kernel_rule_t prefix;
+
+  memset (&prefix, 0, sizeof (prefix));
+
+  char rule_buf[RP_RULE_SIZE];
+  char out_buf[RP_PASSWORD_SIZE];
+
+  for (int i = 0; i < MAX_KERNEL_RULES; i++)
+  {
+    if (rule->kernel_rule.cmds[i] == 0) break;
+
+    prefix.cmds[i] = rule->kernel_rule.cmds[i];
+
+    const int rule_len = kernel_rule_to_cpu_rule (rule_buf, &prefix);
+
+    if (rule_len <= 0) break;
+
+    const int out_len = _old_apply_rule (rule_buf, rule_len, (char *) word->buf, word->len, out_buf);
+
+    len_max = MAX (len_max, out_len);
+  }
+
+  return len_max;
+}
+
+static void rp_fuzz_report (hashcat_ctx_t *hashcat_ctx, const rp_fuzz_engine_t *engine, const rp_fuzz_rule_t *rule, const rp_fuzz_word_t *word, const u8 *exp_buf, const int exp_len, const u8 *got_buf, const int got_len)
+{
+  u8 word_hex[(RP_PASSWORD_SIZE * 2) + 1];
+  u8 exp_hex[(RP_PASSWORD_SIZE * 2) + 1];
+  u8 got_hex[(RP_PASSWORD_SIZE * 2) + 1];
+
+  exec_hexify ((const u8 *) word->buf, word->len, word_hex);
+
+  exec_hexify (exp_buf, MAX (exp_len, 0), exp_hex);
+  exec_hexify (got_buf, MAX (got_len, 0), got_hex);
+
+  event_log_warning (hashcat_ctx, "Mismatch in %s", engine->name);
+  event_log_warning (hashcat_ctx, "  Rule.....: %s", rule->rule_buf);
+  event_log_warning (hashcat_ctx, "  Word.....: $HEX[%s]", word_hex);
+  event_log_warning (hashcat_ctx, "  Expected.: $HEX[%s] (%d)", exp_hex, exp_len);
+  event_log_warning (hashcat_ctx, "  Got......: $HEX[%s] (%d)", got_hex, got_len);
+  event_log_warning (hashcat_ctx, NULL);
+}
+
+int rules_fuzz (hashcat_ctx_t *hashcat_ctx)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  // print the seed, so a mismatch can be reproduced with --generate-rules-seed
+
+  const u32 seed = (user_options->rp_gen_seed_chgd == true) ? user_options->rp_gen_seed : (u32) time (NULL);
+
+  setup_seeding (true, seed);
+
+  // random rules, from the same generator as -g
+
+  const u32 rules_cnt = user_options->rules_fuzz;
+
+  rp_fuzz_rule_t *rules_buf = (rp_fuzz_rule_t *) hccalloc (rules_cnt, sizeof (rp_fuzz_rule_t));
+
+  rp_gen_ops_t rp_gen_ops;
+
+  rp_gen_ops_init (&rp_gen_ops, user_options->rp_gen_func_sel);
+
+  if (rp_gen_ops.grp_op_alias_cnt == 0)
+  {
+    event_log_error (hashcat_ctx, "No rule functions left to fuzz, check --generate-rules-func-sel.");
+
+    rp_gen_ops_destroy (&rp_gen_ops);
+
+    hcfree (rules_buf);
+
+    return -1;
+  }
+
+  for (u32 i = 0; i < rules_cnt; i++)
+  {
+    rp_fuzz_rule_t *rule = &rules_buf[i];
+
+    do
+    {
+      memset (rule, 0, sizeof (rp_fuzz_rule_t));
+
+      rule->rule_len = generate_random_rule (rule->rule_buf, user_options->rp_gen_func_min, user_options->rp_gen_func_max, &rp_gen_ops);
+
+    } while ((rule->rule_len == 0) || (cpu_rule_to_kernel_rule (rule->rule_buf, rule->rule_len, &rule->kernel_rule) == -1));
+  }
+
+  rp_gen_ops_destroy (&rp_gen_ops);
+
+  // the rules with a function rp_simd.c does not implement fall back to _old_apply_rule () in its engine
+
+  u32 vectorized_cnt = 0;
+
+  rp_simd_t *rp_simd = (rp_simd_t *) hcmalloc (sizeof (rp_simd_t));
+
+  for (u32 i = 0; i < rules_cnt; i++)
+  {
+    rp_simd_init (rp_simd, rules_buf[i].rule_buf, rules_buf[i].rule_len);
+
+    if (rp_simd->vectorized == true) vectorized_cnt++;
+  }
+
+  hcfree (rp_simd);
+
+  // random words, printable ascii, short enough for all engines
+
+  rp_fuzz_word_t *words_buf = (rp_fuzz_word_t *) hccalloc (RP_FUZZ_WORDS, sizeof (rp_fuzz_word_t));
+
+  for (u32 i = 0; i < RP_FUZZ_WORDS; i++)
+  {
+    rp_fuzz_word_t *word = &words_buf[i];
+
+    word->len = (int) get_random_num (0, RP_FUZZ_WORD_LEN_MAX);
+
+    for (int j = 0; j < word->len; j++)
+    {
+      word->buf[j] = (char) get_random_num (0x20, 0x7e);
+    }
+  }
+
+  rp_fuzz_engine_t engines[RP_FUZZ_ENGINES_CNT];
+
+  memcpy (engines, RP_FUZZ_ENGINES, sizeof (engines));
+
+  if ((user_options->quiet == false) && (user_options->machine_readable == false))
+  {
+    event_log_info (hashcat_ctx, "Rules......: %u, functions per rule %u-%u", rules_cnt, user_options->rp_gen_func_min, user_options->rp_gen_func_max);
+    event_log_info (hashcat_ctx, "Words......: %u, length 0-%u", RP_FUZZ_WORDS, RP_FUZZ_WORD_LEN_MAX);
+    event_log_info (hashcat_ctx, "Seed.......: %u", seed);
+    event_log_info (hashcat_ctx, "Vectorized.: %u of %u rules", vectorized_cnt, rules_cnt);
+    event_log_info (hashcat_ctx, NULL);
+  }
+
+  /**
+   * differential part, the first engine is the reference
+   */
+
+  rp_fuzz_word_t *exp_buf = (rp_fuzz_word_t *) hccalloc (RP_FUZZ_WORDS, sizeof (rp_fuzz_word_t));
+  rp_fuzz_word_t *got_buf = (rp_fuzz_word_t *) hccalloc (RP_FUZZ_WORDS, sizeof (rp_fuzz_word_t));
+
+  u64 mismatches = 0;
+
+  for (u32 i = 0; i < rules_cnt; i++)
+  {
+    const rp_fuzz_rule_t *rule = &rules_buf[i];
+
+    engines[0].apply (rule, words_buf, RP_FUZZ_WORDS, exp_buf);
+
+    for (u32 k = 1; k < RP_FUZZ_ENGINES_CNT; k++)
+    {
+      rp_fuzz_engine_t *engine = &engines[k];
+
+      engine->apply (rule, words_buf, RP_FUZZ_WORDS, got_buf);
+
+      for (u32 j = 0; j < RP_FUZZ_WORDS; j++)
+      {
+        const rp_fuzz_word_t *word = &words_buf[j];
+
+        const rp_fuzz_word_t *exp = &exp_buf[j];
+        const rp_fuzz_word_t *got = &got_buf[j];
+
+        if (rp_fuzz_len_max (rule, word) > engine->len_max)
+        {
+          engine->skipped++;
+
+          continue;
+        }
+
+        engine->compared++;
+
+        if ((got->len == exp->len) && ((exp->len < 0) || (memcmp (got->buf, exp->buf, exp->len) == 0))) continue;
+
+        engine->mismatches++;
+
+        if (mismatches++ < RP_FUZZ_REPORT_MAX)
+        {
+          rp_fuzz_report (hashcat_ctx, engine, rule, word, (const u8 *) exp->buf, exp->len, (const u8 *) got->buf, got->len);
+        }
+      }
+    }
+  }
+
+  /**
+   * throughput part, each engine runs all rules against all words
+   */
+
+  const u64 applied_cnt = (u64) rules_cnt * RP_FUZZ_WORDS;
+
+  double rates[RP_FUZZ_ENGINES_CNT];
+
+  for (u32 k = 0; k < RP_FUZZ_ENGINES_CNT; k++)
+  {
+    const rp_fuzz_engine_t *engine = &engines[k];
+
+    hc_timer_t timer;
+
+    hc_timer_set (&timer);
+
+    for (u32 i = 0; i < rules_cnt; i++)
+    {
+      engine->apply (&rules_buf[i], words_buf, RP_FUZZ_WORDS, got_buf);
+    }
+
+    const double msec = hc_timer_get (timer);
+
+    rates[k] = (msec > 0) ? ((double) applied_cnt * 1000) / msec : 0;
+  }
+
+  hcfree (exp_buf);
+  hcfree (got_buf);
+
+  /**
+   * report
+   */
+
+  if (user_options->machine_readable == true)
+  {
+    for (u32 k = 0; k < RP_FUZZ_ENGINES_CNT; k++)
+    {
+      const rp_fuzz_engine_t *engine = &engines[k];
+
+      event_log_info (hashcat_ctx, "%u:%.0f:%" PRIu64 ":%" PRIu64 ":%" PRIu64, k, rates[k], engine->compared, engine->skipped, engine->mismatches);
+    }
+  }
+  else
+  {
+    event_log_info (hashcat_ctx, " # | Engine                                       | Rules x Words/s |   Compared |    Skipped | Mismatches");
+    event_log_info (hashcat_ctx, "===+==============================================+=================+============+============+===========");
+
+    for (u32 k = 0; k < RP_FUZZ_ENGINES_CNT; k++)
+    {
+      const rp_fuzz_engine_t *engine = &engines[k];
+
+      if (k == 0)
+      {
+        event_log_info (hashcat_ctx, "%2u | %-44s | %15.0f | %10s | %10s | %10s", k, engine->name, rates[k], "reference", "-", "-");
+      }
+      else
+      {
+        event_log_info (hashcat_ctx, "%2u | %-44s | %15.0f | %10" PRIu64 " | %10" PRIu64 " | %10" PRIu64, k, engine->name, rates[k], engine->compared, engine->skipped, engine->mismatches);
+      }
+    }
+
+    event_log_info (hashcat_ctx, NULL);
+  }
+
+  hcfree (words_buf);
+  hcfree (rules_buf);
+
+  if (mismatches > 0)
+  {
+    event_log_error (hashcat_ctx, "Found %" PRIu64 " mismatches between the rule engines (seed %u).", mismatches, seed);
+
+    return -1;
+  }
+
+  return 0;
+}
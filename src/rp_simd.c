@@ -0,0 +1,190 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "rp.h"
+#include "rp_cpu.h"
+#include "rp_simd.h"
+
+// the batch is transposed into a structure of arrays, row[p] holds the byte at position p of all words
+// so each vector operation on a row runs on all words of a pass, the results match _old_apply_rule ()
+//
+// rows at or above the length of a word are kept zero in its lane, which makes row[len_max] zero in all lanes
+
+// the vector types are declared in rp_simd_run.h, per vector size
+
+#define SIMD_SPLAT(c)           ((rp_simd_vec_t) { 0 } + (u8) (c))
+#define SIMD_MASK(x)            ((rp_simd_vec_t) (x))
+#define SIMD_BLEND(m,a,b)       (((m) & (a)) | (~(m) & (b)))
+#define SIMD_RANGE(v,lo,hi)     SIMD_MASK (((v) >= SIMD_SPLAT (lo)) & ((v) <= SIMD_SPLAT (hi)))
+
+#define SIMD_LOWER(v)           SIMD_RANGE ((v), 'a', 'z')
+#define SIMD_UPPER(v)           SIMD_RANGE ((v), 'A', 'Z')
+#define SIMD_NUM(v)             SIMD_RANGE ((v), '0', '9')
+#define SIMD_ALPHA(v)           (SIMD_LOWER (v) | SIMD_UPPER (v))
+#define SIMD_LOWER_HEX(v)       (SIMD_NUM (v) | SIMD_RANGE ((v), 'a', 'f'))
+#define SIMD_UPPER_HEX(v)       (SIMD_NUM (v) | SIMD_RANGE ((v), 'A', 'F'))
+#define SIMD_SYM(v)             (SIMD_RANGE ((v), ' ', '~') & ~(SIMD_ALPHA (v) | SIMD_NUM (v)))
+
+// the functions the SoA engine implements, a rule with any other function runs through _old_apply_rule ()
+
+static bool rp_simd_supported (const kernel_rule_t *kernel_rule)
+{
+  for (int i = 0; i < MAX_KERNEL_RULES; i++)
+  {
+    const u32 cmd = kernel_rule->cmds[i];
+
+    if (cmd == 0) break;
+
+    const u8 name = (u8) (cmd >>  0);
+    const u8 p0   = (u8) (cmd >>  8);
+    const u8 p1   = (u8) (cmd >> 16);
+
+    switch (name)
+    {
+      case RULE_OP_MANGLE_NOOP:
+      case RULE_OP_MANGLE_LREST:
+      case RULE_OP_MANGLE_UREST:
+      case RULE_OP_MANGLE_LREST_UFIRST:
+      case RULE_OP_MANGLE_UREST_LFIRST:
+      case RULE_OP_MANGLE_TREST:
+      case RULE_OP_MANGLE_REVERSE:
+      case RULE_OP_MANGLE_ROTATE_LEFT:
+      case RULE_OP_MANGLE_ROTATE_RIGHT:
+      case RULE_OP_MANGLE_APPEND:
+      case RULE_OP_MANGLE_PREPEND:
+      case RULE_OP_MANGLE_DELETE_FIRST:
+      case RULE_OP_MANGLE_DELETE_LAST:
+      case RULE_OP_MANGLE_REPLACE:
+      case RULE_OP_MANGLE_SWITCH_FIRST:
+        break;
+
+      // a position cpu_rule_to_kernel_rule () could not convert, like p for the last rejected position
+
+      case RULE_OP_MANGLE_TOGGLE_AT:
+      case RULE_OP_MANGLE_DELETE_AT:
+      case RULE_OP_MANGLE_INSERT:
+      case RULE_OP_MANGLE_OVERSTRIKE:
+      case RULE_OP_MANGLE_TRUNCATE_AT:
+      case RULE_OP_MANGLE_CHR_SHIFTL:
+      case RULE_OP_MANGLE_CHR_SHIFTR:
+      case RULE_OP_MANGLE_CHR_INCR:
+      case RULE_OP_MANGLE_CHR_DECR:
+      case RULE_OP_MANGLE_REPLACE_NP1:
+      case RULE_OP_MANGLE_REPLACE_NM1:
+        if (p0 >= RP_PASSWORD_SIZE - 1) return false;
+        break;
+
+      case RULE_OP_MANGLE_SWITCH_AT:
+        if (p0 >= RP_PASSWORD_SIZE - 1) return false;
+        if (p1 >= RP_PASSWORD_SIZE - 1) return false;
+        break;
+
+      case RULE_OP_MANGLE_REPLACE_CLASS:
+        if ((p0 != '?') && (p0 != 'l') && (p0 != 'u') && (p0 != 'd') && (p0 != 'h') && (p0 != 'H') && (p0 != 's')) return false;
+        break;
+
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+// the same code, with 128 bit vectors for the baseline of the target and with 256 bit vectors for AVX2, chosen at runtime
+// 256 bit vectors without AVX2 would be split by the compiler into scalar code for compares
+
+#define RP_SIMD_VEC_SIZE 16
+#define RP_SIMD_RUN      rp_simd_run_16
+#define RP_SIMD_TARGET
+
+#include "rp_simd_run.h"
+
+#undef RP_SIMD_VEC_SIZE
+#undef RP_SIMD_RUN
+#undef RP_SIMD_TARGET
+
+#if defined (__x86_64__) || defined (__i386__)
+#define RP_SIMD_AVX2
+
+#define RP_SIMD_VEC_SIZE 32
+#define RP_SIMD_RUN      rp_simd_run_32
+#define RP_SIMD_TARGET   __attribute__ ((target ("avx2")))
+
+#include "rp_simd_run.h"
+
+#undef RP_SIMD_VEC_SIZE
+#undef RP_SIMD_RUN
+#undef RP_SIMD_TARGET
+#endif
+
+void rp_simd_init (rp_simd_t *rp_simd, const char *rule_buf, const int rule_len)
+{
+  memset (rp_simd, 0, sizeof (rp_simd_t));
+
+  rp_simd->rule_buf = rule_buf;
+  rp_simd->rule_len = rule_len;
+
+  if (rule_len < 1) return;
+
+  if (cpu_rule_to_kernel_rule ((char *) rule_buf, (u32) rule_len, &rp_simd->kernel_rule) == -1) return;
+
+  rp_simd->vectorized = rp_simd_supported (&rp_simd->kernel_rule);
+}
+
+void rp_simd_reset (rp_simd_t *rp_simd)
+{
+  rp_simd->cnt = 0;
+  rp_simd->pos = 0;
+}
+
+void rp_simd_add (rp_simd_t *rp_simd, const char *buf, const int len)
+{
+  const int idx = rp_simd->cnt++;
+
+  if ((len < 0) || (len >= RP_PASSWORD_SIZE))
+  {
+    rp_simd->in_len[idx] = RULE_RC_REJECT_ERROR;
+
+    return;
+  }
+
+  memcpy (rp_simd->in_buf[idx], buf, len);
+
+  rp_simd->in_len[idx] = len;
+}
+
+void rp_simd_apply (rp_simd_t *rp_simd)
+{
+  if (rp_simd->vectorized == false)
+  {
+    for (int i = 0; i < rp_simd->cnt; i++)
+    {
+      if (rp_simd->in_len[i] < 0)
+      {
+        rp_simd->out_len[i] = RULE_RC_REJECT_ERROR;
+
+        continue;
+      }
+
+      rp_simd->out_len[i] = _old_apply_rule (rp_simd->rule_buf, rp_simd->rule_len, rp_simd->in_buf[i], rp_simd->in_len[i], rp_simd->out_buf[i]);
+    }
+
+    return;
+  }
+
+  #if defined (RP_SIMD_AVX2)
+  if (__builtin_cpu_supports ("avx2"))
+  {
+    rp_simd_run_32 (rp_simd);
+
+    return;
+  }
+  #endif
+
+  rp_simd_run_16 (rp_simd);
+}
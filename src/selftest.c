@@ -52,6 +52,13 @@ static int selftest_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_
     device_param->kernel_params[18] = &device_param->opencl_d_st_esalts_buf;
   }
 
+  if (device_param->is_native == true)
+  {
+    device_param->kernel_params[15] = &device_param->native_d_st_digests_buf;
+    device_param->kernel_params[17] = &device_param->native_d_st_salts_buf;
+    device_param->kernel_params[18] = &device_param->native_d_st_esalts_buf;
+  }
+
   device_param->kernel_param.digests_cnt = 1;
   device_param->kernel_param.digests_offset_host = 0;
 
@@ -122,6 +129,11 @@ static int selftest_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_
     {
       if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_buf, CL_TRUE, 0, 1 * sizeof (pw_t), &pw, 0, NULL, &opencl_event) == -1) return -1;
     }
+
+    if (device_param->is_native == true)
+    {
+      if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_buf, &pw, 1 * sizeof (pw_t)) == -1) return -1;
+    }
   }
   else
   {
@@ -167,6 +179,11 @@ static int selftest_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_
         {
           if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_buf, CL_TRUE, 0, 1 * sizeof (pw_t), &pw, 0, NULL, &opencl_event) == -1) return -1;
         }
+
+        if (device_param->is_native == true)
+        {
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_buf, &pw, 1 * sizeof (pw_t)) == -1) return -1;
+        }
       }
       else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
@@ -245,6 +262,13 @@ static int selftest_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_
 
           if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_buf, CL_TRUE, 0, 1 * sizeof (pw_t), &pw, 0, NULL, &opencl_event) == -1) return -1;
         }
+
+        if (device_param->is_native == true)
+        {
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_combs_c, &comb, 1 * sizeof (pw_t)) == -1) return -1;
+
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_buf, &pw, 1 * sizeof (pw_t)) == -1) return -1;
+        }
       }
       else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
@@ -288,6 +312,11 @@ static int selftest_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_
           {
             if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_buf, CL_TRUE, 0, 1 * sizeof (pw_t), &pw, 0, NULL, &opencl_event) == -1) return -1;
           }
+
+          if (device_param->is_native == true)
+          {
+            if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_buf, &pw, 1 * sizeof (pw_t)) == -1) return -1;
+          }
         }
         else
         {
@@ -350,6 +379,11 @@ static int selftest_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_
             if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bfs_c, CL_TRUE, 0, 1 * sizeof (bf_t), &bf, 0, NULL, &opencl_event) == -1) return -1;
           }
 
+          if (device_param->is_native == true)
+          {
+            if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_bfs_c, &bf, 1 * sizeof (bf_t)) == -1) return -1;
+          }
+
           memset (&pw, 0, sizeof (pw));
 
           char *pw_ptr = (char *) &pw.i;
@@ -456,6 +490,11 @@ static int selftest_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_
             if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_buf, CL_TRUE, 0, 1 * sizeof (pw_t), &pw, 0, NULL, &opencl_event) == -1) return -1;
           }
 
+          if (device_param->is_native == true)
+          {
+            if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_buf, &pw, 1 * sizeof (pw_t)) == -1) return -1;
+          }
+
           *highest_pw_len = pw.pw_len;
         }
       }
@@ -493,6 +532,11 @@ static int selftest_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_
       {
         if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_buf, CL_TRUE, 0, 1 * sizeof (pw_t), &pw, 0, NULL, &opencl_event) == -1) return -1;
       }
+
+      if (device_param->is_native == true)
+      {
+        if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_pws_buf, &pw, 1 * sizeof (pw_t)) == -1) return -1;
+      }
     }
   }
 
@@ -574,6 +618,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
       {
         if (run_opencl_kernel_utf8toutf16le (hashcat_ctx, device_param, device_param->opencl_d_pws_buf, 1) == -1) return -1;
       }
+
+      if (device_param->is_native == true)
+      {
+        if (run_native_kernel_utf8toutf16le (hashcat_ctx, device_param, device_param->native_d_pws_buf, 1) == -1) return -1;
+      }
     }
 
     if (hashconfig->opts_type & OPTS_TYPE_INIT)
@@ -612,6 +661,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
         if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, device_param->size_hooks, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
       }
 
+      if (device_param->is_native == true)
+      {
+        if (hc_nativeMemcpyDtoH (hashcat_ctx, device_param->hooks_buf, device_param->native_d_hooks, device_param->size_hooks) == -1) return -1;
+      }
+
       module_ctx->module_hook12 (device_param, module_ctx->hook_extra_params[0], hashes->st_hook_salts_buf, 0, 0);
 
       if (device_param->is_cuda == true)
@@ -635,6 +689,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
       {
         if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, device_param->size_hooks, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
       }
+
+      if (device_param->is_native == true)
+      {
+        if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_hooks, device_param->hooks_buf, device_param->size_hooks) == -1) return -1;
+      }
     }
 
     const u32 loop_step = hashconfig->kernel_loops_min + ((hashconfig->kernel_loops_max - hashconfig->kernel_loops_min) / 32);
@@ -707,6 +766,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
               /* blocking */
               if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
             }
+
+            if (device_param->is_native == true)
+            {
+              if (hc_nativeMemcpyDtoH (hashcat_ctx, device_param->h_tmps, device_param->native_d_tmps, hashconfig->tmp_size) == -1) return -1;
+            }
           }
 
           hashes_t st_hashes;
@@ -748,6 +812,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
               /* blocking */
               if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
             }
+
+            if (device_param->is_native == true)
+            {
+              if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_tmps, device_param->h_tmps, hashconfig->tmp_size) == -1) return -1;
+            }
           }
         }
       }
@@ -783,6 +852,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
           if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, device_param->size_hooks, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
         }
 
+        if (device_param->is_native == true)
+        {
+          if (hc_nativeMemcpyDtoH (hashcat_ctx, device_param->hooks_buf, device_param->native_d_hooks, device_param->size_hooks) == -1) return -1;
+        }
+
         module_ctx->module_hook23 (device_param, module_ctx->hook_extra_params[0], hashes->st_hook_salts_buf, 0, 0);
 
         if (device_param->is_cuda == true)
@@ -806,6 +880,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
         {
           if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, device_param->size_hooks, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
         }
+
+        if (device_param->is_native == true)
+        {
+          if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_hooks, device_param->hooks_buf, device_param->size_hooks) == -1) return -1;
+        }
       }
     }
 
@@ -870,6 +949,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
                 /* blocking */
                 if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
               }
+
+              if (device_param->is_native == true)
+              {
+                if (hc_nativeMemcpyDtoH (hashcat_ctx, device_param->h_tmps, device_param->native_d_tmps, hashconfig->tmp_size) == -1) return -1;
+              }
             }
 
             hashes_t st_hashes;
@@ -906,6 +990,11 @@ static int selftest_run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *d
               {
                 if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
               }
+
+              if (device_param->is_native == true)
+              {
+                if (hc_nativeMemcpyHtoD (hashcat_ctx, device_param->native_d_tmps, device_param->h_tmps, hashconfig->tmp_size) == -1) return -1;
+              }
             }
           }
         }
@@ -988,6 +1077,11 @@ static int selftest_cleanup (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
     if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    if (hc_nativeMemcpyDtoH (hashcat_ctx, num_cracked, device_param->native_d_result, sizeof (u32)) == -1) return -1;
+  }
+
   // finish : cleanup and restore
 
   // ??? bug because not set ??? device_param->kernel_param.salt_pos_host        = 0;
@@ -1057,6 +1151,20 @@ static int selftest_cleanup (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
     if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_result,        device_param->size_results) == -1) return -1;
   }
 
+  if (device_param->is_native == true)
+  {
+    device_param->kernel_params[15] = &device_param->native_d_digests_buf;
+    device_param->kernel_params[17] = &device_param->native_d_salt_bufs;
+    device_param->kernel_params[18] = &device_param->native_d_esalt_bufs;
+
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_pws_buf,       device_param->size_pws)     == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_tmps,          device_param->size_tmps)    == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_hooks,         device_param->size_hooks)   == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_digests_shown, device_param->size_shown)   == -1) return -1;
+    if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_result,        device_param->size_results) == -1) return -1;
+  }
+
   if (user_options->slow_candidates == true)
   {
     if (device_param->is_cuda == true)
@@ -1080,6 +1188,11 @@ static int selftest_cleanup (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
     {
       if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_rules_c, device_param->size_rules_c) == -1) return -1;
     }
+
+    if (device_param->is_native == true)
+    {
+      if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_rules_c, device_param->size_rules_c) == -1) return -1;
+    }
   }
   else
   {
@@ -1106,6 +1219,11 @@ static int selftest_cleanup (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
       {
         if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_rules_c, device_param->size_rules_c) == -1) return -1;
       }
+
+      if (device_param->is_native == true)
+      {
+        if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_rules_c, device_param->size_rules_c) == -1) return -1;
+      }
     }
     else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
     {
@@ -1130,6 +1248,11 @@ static int selftest_cleanup (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
       {
         if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs_c, device_param->size_combs) == -1) return -1;
       }
+
+      if (device_param->is_native == true)
+      {
+        if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_combs_c, device_param->size_combs) == -1) return -1;
+      }
     }
     else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
     {
@@ -1154,6 +1277,11 @@ static int selftest_cleanup (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
       {
         if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs_c, device_param->size_bfs) == -1) return -1;
       }
+
+      if (device_param->is_native == true)
+      {
+        if (run_native_kernel_bzero (hashcat_ctx, device_param, device_param->native_d_bfs_c, device_param->size_bfs) == -1) return -1;
+      }
     }
   }
 
@@ -1220,6 +1348,11 @@ static int process_selftest (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *devi
       event_log_error (hashcat_ctx, "* Device #%u: ATTENTION! OpenCL kernel self-test failed.", device_param->device_id + 1);
     }
 
+    if (device_param->is_native == true)
+    {
+      event_log_error (hashcat_ctx, "* Device #%u: ATTENTION! Native kernel self-test failed.", device_param->device_id + 1);
+    }
+
     if (device_param->is_metal == false)
     {
       event_log_warning (hashcat_ctx, "Your device driver installation is probably broken.");
@@ -156,6 +156,45 @@ void slow_candidates_seek (hashcat_ctx_t *hashcat_ctx, void *extra_info, const u
   }
 }
 
+void slow_candidates_rewind (hashcat_ctx_t *hashcat_ctx, void *extra_info)
+{
+  user_options_t *user_options = hashcat_ctx->user_options;
+  wl_data_t      *wl_data      = hashcat_ctx->wl_data;
+
+  const u32 attack_mode = user_options->attack_mode;
+
+  if (attack_mode == ATTACK_MODE_STRAIGHT)
+  {
+    extra_info_straight_t *extra_info_straight = (extra_info_straight_t *) extra_info;
+
+    hc_rewind (&extra_info_straight->fp);
+
+    extra_info_straight->rule_pos_prev = 0;
+    extra_info_straight->rule_pos      = 0;
+    extra_info_straight->base_len      = 0;
+  }
+  else if (attack_mode == ATTACK_MODE_COMBI)
+  {
+    extra_info_combi_t *extra_info_combi = (extra_info_combi_t *) extra_info;
+
+    hc_rewind (&extra_info_combi->base_fp);
+    hc_rewind (&extra_info_combi->combs_fp);
+
+    extra_info_combi->comb_pos_prev = 0;
+    extra_info_combi->comb_pos      = 0;
+    extra_info_combi->base_len      = 0;
+  }
+  else if (attack_mode == ATTACK_MODE_BF)
+  {
+    // nothing to do
+  }
+
+  // drop whatever get_next_word() still has buffered from the old position
+
+  wl_data->pos = 0;
+  wl_data->cnt = 0;
+}
+
 void slow_candidates_next (hashcat_ctx_t *hashcat_ctx, void *extra_info)
 {
   hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
@@ -0,0 +1,249 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "thread.h"
+#include "timer.h"
+#include "startup.h"
+#include "logfile.h"
+
+int startup_ctx_init (hashcat_ctx_t *hashcat_ctx)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  memset (startup_ctx, 0, sizeof (startup_ctx_t));
+
+  hc_thread_mutex_init (startup_ctx->mux_stages);
+
+  hc_timer_set (&startup_ctx->timer);
+
+  return 0;
+}
+
+void startup_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  hc_thread_mutex_delete (startup_ctx->mux_stages);
+
+  memset (startup_ctx, 0, sizeof (startup_ctx_t));
+}
+
+void startup_ctx_reset (hashcat_ctx_t *hashcat_ctx)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  hc_thread_mutex_lock (startup_ctx->mux_stages);
+
+  hc_timer_set (&startup_ctx->timer);
+
+  startup_ctx->finished   = false;
+  startup_ctx->cancelled  = false;
+  startup_ctx->tasks_cnt  = 0;
+  startup_ctx->stages_cnt = 0;
+
+  hc_thread_mutex_unlock (startup_ctx->mux_stages);
+}
+
+double startup_stage_begin (hashcat_ctx_t *hashcat_ctx)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  return hc_timer_get (startup_ctx->timer);
+}
+
+void startup_stage_end (hashcat_ctx_t *hashcat_ctx, const char *name, const double start_ms)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  const double stop_ms = hc_timer_get (startup_ctx->timer);
+
+  hc_thread_mutex_lock (startup_ctx->mux_stages);
+
+  if ((startup_ctx->finished == false) && (startup_ctx->stages_cnt < STARTUP_STAGES_MAX))
+  {
+    startup_stage_t *stage = &startup_ctx->stages_buf[startup_ctx->stages_cnt];
+
+    stage->name     = name;
+    stage->start_ms = start_ms;
+    stage->ms       = stop_ms - start_ms;
+
+    startup_ctx->stages_cnt++;
+  }
+
+  hc_thread_mutex_unlock (startup_ctx->mux_stages);
+}
+
+void startup_finish (hashcat_ctx_t *hashcat_ctx)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+  logfile_ctx_t *logfile_ctx = hashcat_ctx->logfile_ctx;
+
+  if (startup_ctx->finished == true) return;
+
+  // the wall time until the first cracker thread starts, the stages above overlap
+
+  startup_stage_end (hashcat_ctx, "total", 0);
+
+  hc_thread_mutex_lock (startup_ctx->mux_stages);
+
+  startup_ctx->finished = true;
+
+  hc_thread_mutex_unlock (startup_ctx->mux_stages);
+
+  for (int stages_idx = 0; stages_idx < startup_ctx->stages_cnt; stages_idx++)
+  {
+    const startup_stage_t *stage = &startup_ctx->stages_buf[stages_idx];
+
+    char var[64];
+
+    snprintf (var, sizeof (var), "startup_%s", stage->name);
+
+    logfile_top_var_uint64 (var, stage->ms);
+  }
+}
+
+/**
+ * tasks are added in dependency order, so a task can only depend on tasks with a lower index
+ * and the graph can not have cycles. each task runs on its own thread and waits for its dependencies first.
+ */
+
+int startup_task_add (hashcat_ctx_t *hashcat_ctx, const char *name, STARTUP_TASK func, const u32 deps)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  if (startup_ctx->tasks_cnt == STARTUP_TASKS_MAX) return -1;
+
+  const int task_idx = startup_ctx->tasks_cnt;
+
+  if (deps >> task_idx) return -1;
+
+  startup_task_t *task = &startup_ctx->tasks_buf[task_idx];
+
+  task->name        = name;
+  task->func        = func;
+  task->deps        = deps;
+  task->rc          = 0;
+  task->hashcat_ctx = hashcat_ctx;
+
+  startup_ctx->tasks_cnt++;
+
+  return task_idx;
+}
+
+static HC_API_CALL void *thread_startup_task (void *p)
+{
+  startup_task_t *task = (startup_task_t *) p;
+
+  hashcat_ctx_t *hashcat_ctx = task->hashcat_ctx;
+
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  bool deps_ok = true;
+
+  for (int task_idx = 0; task_idx < startup_ctx->tasks_cnt; task_idx++)
+  {
+    if ((task->deps & (1u << task_idx)) == 0) continue;
+
+    startup_task_t *dep = &startup_ctx->tasks_buf[task_idx];
+
+    hc_thread_sem_wait (dep->sem_done);
+    hc_thread_sem_post (dep->sem_done);
+
+    if (dep->rc != 0) deps_ok = false;
+  }
+
+  if (deps_ok == true)
+  {
+    const double start_ms = startup_stage_begin (hashcat_ctx);
+
+    task->rc = task->func (hashcat_ctx);
+
+    startup_stage_end (hashcat_ctx, task->name, start_ms);
+  }
+  else
+  {
+    task->rc = -1;
+  }
+
+  // outer_loop () returns as soon as startup_run () reports the failure, no need to finish the other tasks
+
+  if (task->rc != 0) startup_cancel (hashcat_ctx);
+
+  hc_thread_sem_post (task->sem_done);
+
+  return NULL;
+}
+
+/**
+ * a long task such as the kernel build polls startup_cancelled () and gives up early,
+ * startup_run () still waits for it because it shares the hash-mode setup with outer_loop ()
+ */
+
+void startup_cancel (hashcat_ctx_t *hashcat_ctx)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  hc_thread_mutex_lock (startup_ctx->mux_stages);
+
+  startup_ctx->cancelled = true;
+
+  hc_thread_mutex_unlock (startup_ctx->mux_stages);
+}
+
+bool startup_cancelled (hashcat_ctx_t *hashcat_ctx)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  hc_thread_mutex_lock (startup_ctx->mux_stages);
+
+  const bool cancelled = startup_ctx->cancelled;
+
+  hc_thread_mutex_unlock (startup_ctx->mux_stages);
+
+  return cancelled;
+}
+
+int startup_run (hashcat_ctx_t *hashcat_ctx)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  const int tasks_cnt = startup_ctx->tasks_cnt;
+
+  if (tasks_cnt == 0) return 0;
+
+  hc_thread_t *threads = (hc_thread_t *) hccalloc (tasks_cnt, sizeof (hc_thread_t));
+
+  for (int task_idx = 0; task_idx < tasks_cnt; task_idx++)
+  {
+    hc_thread_sem_init (startup_ctx->tasks_buf[task_idx].sem_done);
+  }
+
+  for (int task_idx = 0; task_idx < tasks_cnt; task_idx++)
+  {
+    hc_thread_create (threads[task_idx], thread_startup_task, &startup_ctx->tasks_buf[task_idx]);
+  }
+
+  hc_thread_wait (tasks_cnt, threads);
+
+  hcfree (threads);
+
+  int rc = 0;
+
+  for (int task_idx = 0; task_idx < tasks_cnt; task_idx++)
+  {
+    startup_task_t *task = &startup_ctx->tasks_buf[task_idx];
+
+    hc_thread_sem_close (task->sem_done);
+
+    if (task->rc != 0) rc = -1;
+  }
+
+  startup_ctx->tasks_cnt = 0;
+
+  return rc;
+}
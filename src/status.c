@@ -16,6 +16,7 @@
 #include "mpsp.h"
 #include "terminal.h"
 #include "shared.h"
+#include "dedup.h"
 #include "status.h"
 
 static const char *const  ST_0000 = "Initializing";
@@ -1339,6 +1340,79 @@ double status_get_progress_rejected_percent (const hashcat_ctx_t *hashcat_ctx)
   return percent_rejected;
 }
 
+u64 status_get_progress_dedup (const hashcat_ctx_t *hashcat_ctx)
+{
+  const dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return 0;
+
+  return dedup_ctx->skipped;
+}
+
+double status_get_dedup_fill_percent (const hashcat_ctx_t *hashcat_ctx)
+{
+  const dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return 0;
+
+  return ((double) dedup_ctx->items / (double) (dedup_ctx->buckets_cnt * DEDUP_BUCKET_SLOTS)) * 100;
+}
+
+int64_t status_get_energy (const hashcat_ctx_t *hashcat_ctx)
+{
+  const backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+  const hwmon_ctx_t   *hwmon_ctx   = hashcat_ctx->hwmon_ctx;
+  status_ctx_t        *status_ctx  = hashcat_ctx->status_ctx;
+
+  if (hwmon_ctx->enabled == false) return -1;
+
+  // all cpu devices share the same package counters, so the first one which has them is enough
+
+  int64_t energy = -1;
+
+  hc_thread_mutex_lock (status_ctx->mux_hwmon);
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    const hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+    if (device_param->skipped == true) continue;
+    if (device_param->skipped_warning == true) continue;
+
+    energy = hm_get_energy_with_devices_idx ((hashcat_ctx_t *) hashcat_ctx, backend_devices_idx);
+
+    if (energy != -1) break;
+  }
+
+  hc_thread_mutex_unlock (status_ctx->mux_hwmon);
+
+  return energy;
+}
+
+double status_get_energy_joules (const hashcat_ctx_t *hashcat_ctx)
+{
+  const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  if (status_ctx->energy_running == -1) return -1;
+
+  const int64_t energy = status_get_energy (hashcat_ctx);
+
+  if (energy == -1) return -1;
+
+  return (double) (energy - status_ctx->energy_running) / 1000000;
+}
+
+double status_get_hashes_per_joule (const hashcat_ctx_t *hashcat_ctx)
+{
+  const double energy_joules = status_get_energy_joules (hashcat_ctx);
+
+  if (energy_joules <= 0) return -1;
+
+  const u64 progress_done = status_get_progress_done (hashcat_ctx);
+
+  return (double) progress_done / energy_joules;
+}
+
 u64 status_get_progress_restored (const hashcat_ctx_t *hashcat_ctx)
 {
   const hashes_t     *hashes     = hashcat_ctx->hashes;
@@ -2338,6 +2412,35 @@ int status_get_vector_width_dev (const hashcat_ctx_t *hashcat_ctx, const int bac
   return device_param->vector_width;
 }
 
+int status_get_numa_node_dev (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx)
+{
+  const backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+  if (device_param->skipped == true) return -1;
+  if (device_param->skipped_warning == true) return -1;
+
+  if (device_param->numa_node == -1) return -1;
+
+  return backend_ctx->numa_topology.nodes_buf[device_param->numa_node].node_id;
+}
+
+int status_get_startup_stages (const hashcat_ctx_t *hashcat_ctx, startup_stage_t *stages_buf)
+{
+  startup_ctx_t *startup_ctx = hashcat_ctx->startup_ctx;
+
+  hc_thread_mutex_lock (startup_ctx->mux_stages);
+
+  const int stages_cnt = startup_ctx->stages_cnt;
+
+  memcpy (stages_buf, startup_ctx->stages_buf, stages_cnt * sizeof (startup_stage_t));
+
+  hc_thread_mutex_unlock (startup_ctx->mux_stages);
+
+  return stages_cnt;
+}
+
 int status_progress_init (hashcat_ctx_t *hashcat_ctx)
 {
   status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
@@ -2350,10 +2453,29 @@ int status_progress_init (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
+static void status_progress_session_add (hashcat_ctx_t *hashcat_ctx)
+{
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  // the progress of a queue entry is about to be cleared, keep it in the session totals
+
+  hc_thread_mutex_lock (status_ctx->mux_counter);
+
+  status_ctx->words_progress_done_session     += status_get_progress_done     (hashcat_ctx);
+  status_ctx->words_progress_rejected_session += status_get_progress_rejected (hashcat_ctx);
+
+  memset (status_ctx->words_progress_done,     0, hashcat_ctx->hashes->salts_cnt * sizeof (u64));
+  memset (status_ctx->words_progress_rejected, 0, hashcat_ctx->hashes->salts_cnt * sizeof (u64));
+
+  hc_thread_mutex_unlock (status_ctx->mux_counter);
+}
+
 void status_progress_destroy (hashcat_ctx_t *hashcat_ctx)
 {
   status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
 
+  status_progress_session_add (hashcat_ctx);
+
   hcfree (status_ctx->words_progress_done);
   hcfree (status_ctx->words_progress_rejected);
   hcfree (status_ctx->words_progress_restored);
@@ -2368,8 +2490,8 @@ void status_progress_reset (hashcat_ctx_t *hashcat_ctx)
   status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
   hashes_t     *hashes     = hashcat_ctx->hashes;
 
-  memset (status_ctx->words_progress_done,     0, hashes->salts_cnt * sizeof (u64));
-  memset (status_ctx->words_progress_rejected, 0, hashes->salts_cnt * sizeof (u64));
+  status_progress_session_add (hashcat_ctx);
+
   memset (status_ctx->words_progress_restored, 0, hashes->salts_cnt * sizeof (u64));
 }
 
@@ -2391,6 +2513,11 @@ int status_ctx_init (hashcat_ctx_t *hashcat_ctx)
   status_ctx->checkpoint_shutdown = false;
   status_ctx->finish_shutdown     = false;
 
+  status_ctx->energy_running      = -1;
+
+  status_ctx->words_progress_done_session     = 0;
+  status_ctx->words_progress_rejected_session = 0;
+
   status_ctx->hashcat_status_final = (hashcat_status_t *) hcmalloc (sizeof (hashcat_status_t));
 
   hc_thread_mutex_init (status_ctx->mux_dispatcher);
@@ -273,10 +273,12 @@ int straight_ctx_update_loop (hashcat_ctx_t *hashcat_ctx)
         return -1;
       }
 
-      if ((status_ctx->words_cnt / straight_ctx->kernel_rules_cnt) != hashes->salts_cnt)
+      // each salt owns association_width consecutive words, see ASSOCIATION_SLOT() in the kernels
+
+      if ((status_ctx->words_cnt / straight_ctx->kernel_rules_cnt) != (u64) hashes->salts_cnt * user_options->association_width)
       {
         event_log_error (hashcat_ctx, "Number of words in wordlist '%s' is not in sync with number of unique salts", straight_ctx->dict);
-        event_log_error (hashcat_ctx, "Words: %" PRIu64 ", salts: %d", status_ctx->words_cnt / straight_ctx->kernel_rules_cnt, hashes->salts_cnt);
+        event_log_error (hashcat_ctx, "Words: %" PRIu64 ", salts: %d, association width: %u", status_ctx->words_cnt / straight_ctx->kernel_rules_cnt, hashes->salts_cnt, user_options->association_width);
 
         return -1;
       }
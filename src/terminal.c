@@ -1201,17 +1201,13 @@ void hash_info (hashcat_ctx_t *hashcat_ctx)
   }
   else
   {
-    char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
-
     if (user_options->machine_readable == true) printf ("{ ");
 
     for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
     {
       user_options->hash_mode = i;
 
-      module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
-
-      if (hc_path_exist (modulefile) == false) continue;
+      if (module_exists (folder_config, i) == false) continue;
 
       if (user_options->machine_readable == true)
       {
@@ -1229,8 +1225,6 @@ void hash_info (hashcat_ctx_t *hashcat_ctx)
     }
 
     if (user_options->machine_readable == true) printf (" }");
-
-    hcfree (modulefile);
   }
 }
 
@@ -1552,7 +1546,7 @@ void backend_info (hashcat_ctx_t *hashcat_ctx)
 
     if (user_options->machine_readable == true)
     {
-      if (backend_ctx->hip || backend_ctx->mtl || backend_ctx->ocl)
+      if (backend_ctx->hip || backend_ctx->mtl || backend_ctx->ocl || backend_ctx->native)
       {
         printf ("] }, ");
       }
@@ -1703,7 +1697,7 @@ void backend_info (hashcat_ctx_t *hashcat_ctx)
 
     if (user_options->machine_readable == true)
     {
-      if (backend_ctx->mtl || backend_ctx->ocl)
+      if (backend_ctx->mtl || backend_ctx->ocl || backend_ctx->native)
       {
         printf ("] }, ");
       }
@@ -1956,7 +1950,7 @@ void backend_info (hashcat_ctx_t *hashcat_ctx)
 
     if (user_options->machine_readable == true)
     {
-      if (backend_ctx->ocl)
+      if (backend_ctx->ocl || backend_ctx->native)
       {
         printf ("] }, ");
       }
@@ -2170,6 +2164,96 @@ void backend_info (hashcat_ctx_t *hashcat_ctx)
       }
     }
 
+    if (user_options->machine_readable == true)
+    {
+      if (backend_ctx->native)
+      {
+        printf ("] }, ");
+      }
+      else
+      {
+        printf ("] } ");
+      }
+    }
+  }
+
+  if (backend_ctx->native)
+  {
+    if (user_options->machine_readable == false)
+    {
+      event_log_info (hashcat_ctx, "Native Info:");
+      event_log_info (hashcat_ctx, "============");
+      event_log_info (hashcat_ctx, NULL);
+    }
+    else
+    {
+      printf ("\"NativeInfo\": { ");
+    }
+
+    int native_devices_cnt = backend_ctx->native_devices_cnt;
+
+    const NATIVE_PTR *native = (const NATIVE_PTR *) backend_ctx->native;
+
+    if (user_options->machine_readable == false)
+    {
+      event_log_info (hashcat_ctx, "Compiler.Version.: %s", native->version);
+      event_log_info (hashcat_ctx, NULL);
+    }
+    else
+    {
+      printf ("\"CompilerVersion\": \"%s\", ", native->version);
+      printf ("\"BackendDevices\": [ ");
+    }
+
+    for (int native_devices_idx = 0; native_devices_idx < native_devices_cnt; native_devices_idx++)
+    {
+      if (user_options->machine_readable == true)
+      {
+        printf ("{ ");
+      }
+
+      const int backend_devices_idx = backend_ctx->backend_device_from_native[native_devices_idx];
+
+      const hc_device_param_t *device_param = backend_ctx->devices_param + backend_devices_idx;
+
+      int   device_id            = device_param->device_id;
+      char *device_name          = device_param->device_name;
+      u32   device_processors    = device_param->device_processors;
+      u64   device_global_mem    = device_param->device_global_mem;
+      u64   device_maxmem_alloc  = device_param->device_maxmem_alloc;
+      u64   device_available_mem = device_param->device_available_mem;
+
+      if (user_options->machine_readable == false)
+      {
+        event_log_info (hashcat_ctx, "Backend Device ID #%02u", device_id + 1);
+        event_log_info (hashcat_ctx, "  Type...........: CPU");
+        event_log_info (hashcat_ctx, "  Name...........: %s", device_name);
+        event_log_info (hashcat_ctx, "  Processor(s)...: %u", device_processors);
+        event_log_info (hashcat_ctx, "  Memory.Total...: %" PRIu64 " MB (limited to %" PRIu64 " MB allocatable in one block)", device_global_mem / 1024 / 1024, device_maxmem_alloc / 1024 / 1024);
+        event_log_info (hashcat_ctx, "  Memory.Free....: %" PRIu64 " MB", device_available_mem / 1024 / 1024);
+        event_log_info (hashcat_ctx, NULL);
+      }
+      else
+      {
+        printf ("\"DeviceID\": \"%02u\", ", device_id + 1);
+        printf ("\"Type\": \"CPU\", ");
+        printf ("\"Name\": \"%s\", ", device_name);
+        printf ("\"Processors\": \"%u\", ", device_processors);
+        printf ("\"MemoryTotal\": \"%" PRIu64 " MB\", ", device_global_mem / 1024 / 1024);
+        printf ("\"MemoryAllocPerBlock\": \"%" PRIu64 " MB\", ", device_maxmem_alloc / 1024 / 1024);
+        printf ("\"MemoryFree\": \"%" PRIu64 " MB\" ", device_available_mem / 1024 / 1024);
+
+        if ((native_devices_idx + 1) < native_devices_cnt)
+        {
+          printf ("}, ");
+        }
+        else
+        {
+          printf ("} ");
+        }
+      }
+    }
+
     if (user_options->machine_readable == true)
     {
       printf ("] } ");
@@ -2660,6 +2744,61 @@ void backend_info_compact (hashcat_ctx_t *hashcat_ctx)
       event_log_info (hashcat_ctx, NULL);
     }
   }
+
+  /**
+   * Native
+   */
+
+  if (backend_ctx->native)
+  {
+    int native_devices_cnt = backend_ctx->native_devices_cnt;
+
+    if (native_devices_cnt)
+    {
+      const NATIVE_PTR *native = (const NATIVE_PTR *) backend_ctx->native;
+
+      const size_t len = event_log_info (hashcat_ctx, "Native API (%s)", native->version);
+
+      char line[HCBUFSIZ_TINY] = { 0 };
+
+      memset (line, '=', len);
+
+      line[len] = 0;
+
+      event_log_info (hashcat_ctx, "%s", line);
+
+      for (int native_devices_idx = 0; native_devices_idx < native_devices_cnt; native_devices_idx++)
+      {
+        const int backend_devices_idx = backend_ctx->backend_device_from_native[native_devices_idx];
+
+        const hc_device_param_t *device_param = backend_ctx->devices_param + backend_devices_idx;
+
+        int   device_id            = device_param->device_id;
+        char *device_name          = device_param->device_name;
+        u64   device_maxmem_alloc  = device_param->device_maxmem_alloc;
+        u64   device_global_mem    = device_param->device_global_mem;
+        u64   device_available_mem = device_param->device_available_mem;
+
+        if ((device_param->skipped == false) && (device_param->skipped_warning == false))
+        {
+          event_log_info (hashcat_ctx, "* Device #%02u: %s, %" PRIu64 "/%" PRIu64 " MB (%" PRIu64 " MB allocatable)",
+                    device_id + 1,
+                    device_name,
+                    device_available_mem / 1024 / 1024,
+                    device_global_mem    / 1024 / 1024,
+                    device_maxmem_alloc  / 1024 / 1024);
+        }
+        else
+        {
+          event_log_info (hashcat_ctx, "* Device #%02u: %s, skipped",
+                    device_id + 1,
+                    device_name);
+        }
+      }
+
+      event_log_info (hashcat_ctx, NULL);
+    }
+  }
 }
 
 void status_display_machine_readable (hashcat_ctx_t *hashcat_ctx)
@@ -2916,6 +3055,9 @@ void status_display_status_json (hashcat_ctx_t *hashcat_ctx)
   printf (" \"recovered_hashes\": [%u, %u],", hashcat_status->digests_done, hashcat_status->digests_cnt);
   printf (" \"recovered_salts\": [%u, %u],", hashcat_status->salts_done, hashcat_status->salts_cnt);
   printf (" \"rejected\": %" PRIu64 ",", hashcat_status->progress_rejected);
+  printf (" \"dedup\": %" PRIu64 ",", hashcat_status->progress_dedup);
+  printf (" \"energy\": %.02f,", hashcat_status->energy_joules);
+  printf (" \"hashes_per_joule\": %.02f,", hashcat_status->hashes_per_joule);
   printf (" \"devices\": [");
 
   if (bridge_ctx->enabled == true)
@@ -2959,6 +3101,7 @@ void status_display_status_json (hashcat_ctx_t *hashcat_ctx)
       printf (" \"device_type\": \"%s\",", device_type_desc);
 
       printf (" \"speed\": %" PRIu64 ",", (u64) (device_info->hashes_msec_dev * 1000));
+      printf (" \"numa_node\": %d,", device_info->numa_node_dev);
 
       const int temp        = hm_get_temperature_with_devices_idx (hashcat_ctx, device_id);
       const int util        = hm_get_utilization_with_devices_idx (hashcat_ctx, device_id);
@@ -2978,6 +3121,19 @@ void status_display_status_json (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  printf (" ],");
+
+  printf (" \"startup\": [");
+
+  for (int stages_idx = 0; stages_idx < hashcat_status->startup_stages_cnt; stages_idx++)
+  {
+    const startup_stage_t *stage = hashcat_status->startup_stages_buf + stages_idx;
+
+    if (stages_idx > 0) printf (",");
+
+    printf (" { \"stage\": \"%s\", \"start_ms\": %" PRIu64 ", \"ms\": %" PRIu64 " }", stage->name, (u64) stage->start_ms, (u64) stage->ms);
+  }
+
   printf (" ],");
   printf (" \"time_start\": %" PRIu64 ",", (u64) status_ctx->runtime_start);
   printf (" \"estimated_stop\": %" PRIu64 " }", (u64) end);
@@ -3472,6 +3628,51 @@ void status_display (hashcat_ctx_t *hashcat_ctx)
       hashcat_status->speed_sec_all);
   }
 
+  // runs of consecutive devices placed on the same NUMA node, e.g. "node0 #01-#16, node1 #17-#32"
+
+  char numa_placement[256] = { 0 };
+
+  int numa_placement_len = 0;
+
+  for (int device_id = 0; device_id < hashcat_status->device_info_cnt; device_id++)
+  {
+    const device_info_t *device_info = hashcat_status->device_info_buf + device_id;
+
+    if (device_info->numa_node_dev == -1) continue;
+
+    int device_last = device_id;
+
+    while ((device_last + 1) < hashcat_status->device_info_cnt)
+    {
+      if (hashcat_status->device_info_buf[device_last + 1].numa_node_dev != device_info->numa_node_dev) break;
+
+      device_last++;
+    }
+
+    if (numa_placement_len >= (int) sizeof (numa_placement) - 1) break;
+
+    const char *sep = (numa_placement_len > 0) ? ", " : "";
+
+    if (device_last > device_id)
+    {
+      numa_placement_len += snprintf (numa_placement + numa_placement_len, sizeof (numa_placement) - numa_placement_len, "%snode%d #%02d-#%02d", sep, device_info->numa_node_dev, device_id + 1, device_last + 1);
+    }
+    else
+    {
+      numa_placement_len += snprintf (numa_placement + numa_placement_len, sizeof (numa_placement) - numa_placement_len, "%snode%d #%02d", sep, device_info->numa_node_dev, device_id + 1);
+    }
+
+    device_id = device_last;
+  }
+
+  if (numa_placement_len > 0)
+  {
+    event_log_info (hashcat_ctx,
+      "NUMA.Placement...: %s%s",
+      numa_placement,
+      (user_options->numa_hugepages == true) ? " (hugepages)" : "");
+  }
+
   if (hashcat_status->salts_cnt > 1)
   {
     event_log_info (hashcat_ctx,
@@ -3554,6 +3755,29 @@ void status_display (hashcat_ctx_t *hashcat_ctx)
       break;
   }
 
+  if (hashcat_status->energy_joules >= 0)
+  {
+    char hashes_per_joule[HCBUFSIZ_TINY] = { 0 };
+
+    format_speed_display (hashcat_status->hashes_per_joule, hashes_per_joule, sizeof (hashes_per_joule));
+
+    const double power_avg = (hashcat_status->msec_running > 0) ? hashcat_status->energy_joules / (hashcat_status->msec_running / 1000) : 0;
+
+    event_log_info (hashcat_ctx,
+      "Energy...........: %.02f J, %.02f W avg, %sH/J",
+      hashcat_status->energy_joules,
+      power_avg,
+      hashes_per_joule);
+  }
+
+  if (user_options->dedup == true)
+  {
+    event_log_info (hashcat_ctx,
+      "Dedup............: %" PRIu64 " skipped, filter %.02f%% full",
+      hashcat_status->progress_dedup,
+      hashcat_status->dedup_fill_percent);
+  }
+
   #ifdef WITH_BRAIN
   if (user_options->brain_client == true)
   {
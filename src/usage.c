@@ -44,7 +44,9 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --keep-guessing            |      | Keep guessing the hash after it has been cracked     |",
   "     --self-test-disable        |      | Disable self-test functionality on startup           |",
   "     --loopback                 |      | Add new plains to induct directory                   |",
+  "     --loopback-queue           |      | Feed new plains back into the running attack         |",
   "     --markov-hcstat2           | File | Specify hcstat2 file to use                          | --markov-hcstat2=my.hcstat2",
+  "     --markov-hcstat2-create    | File | Train a new hcstat2 file from the given wordlists    | --markov-hcstat2-create=my.hcstat2",
   "     --markov-disable           |      | Disables markov-chains, emulates classic brute-force |",
   "     --markov-classic           |      | Enables classic markov-chains, no per-position       |",
   "     --markov-inverse           |      | Enables inverse markov-chains, no per-position       |",
@@ -71,6 +73,8 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --remove-timer             | Num  | Update input hash file each X seconds                | --remove-timer=30",
   "     --potfile-disable          |      | Do not write potfile                                 |",
   "     --potfile-path             | File | Specific path to potfile                             | --potfile-path=my.pot",
+  "     --potfile-shard            |      | Keep one potfile per hash-mode in <potfile>.d        |",
+  "     --potfile-compact          |      | Sort and deduplicate the potfile or its shards, exit |",
   "     --encoding-from            | Code | Force internal wordlist encoding from X              | --encoding-from=iso-8859-15",
   "     --encoding-to              | Code | Force internal wordlist encoding to X                | --encoding-to=utf-32le",
   "     --debug-mode               | Num  | Defines the debug mode (hybrid only by using rules)  | --debug-mode=4",
@@ -94,11 +98,14 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   " -c, --segment-size             | Num  | Sets size in MB to cache from the wordfile to X      | -c 32",
   "     --bitmap-min               | Num  | Sets minimum bits allowed for bitmaps to X           | --bitmap-min=24",
   "     --bitmap-max               | Num  | Sets maximum bits allowed for bitmaps to X           | --bitmap-max=24",
+  "     --bitmap-l1-disable        |      | Disable the first-level bitmap in local memory       |",
   "     --bridge-parameter1        | Str  | Sets the generic parameter 1 for a Bridge            |",
   "     --bridge-parameter2        | Str  | Sets the generic parameter 2 for a Bridge            |",
   "     --bridge-parameter3        | Str  | Sets the generic parameter 3 for a Bridge            |",
   "     --bridge-parameter4        | Str  | Sets the generic parameter 4 for a Bridge            |",
   "     --cpu-affinity             | Str  | Locks to CPU devices, separated with commas          | --cpu-affinity=1,2,3",
+  "     --numa-disable             |      | Do not place Bridge units on NUMA nodes              |",
+  "     --numa-hugepages           |      | Back Bridge memory with transparent huge pages       |",
   "     --hook-threads             | Num  | Sets number of threads for a hook (per compute unit) | --hook-threads=8",
   " -H, --hash-info                |      | Show information for each hash-mode                  | -H or -HH",
   "     --example-hashes           |      | Alias of --hash-info                                 |",
@@ -106,6 +113,7 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --backend-ignore-hip       |      | Do not try to open HIP interface on startup          |",
   "     --backend-ignore-metal     |      | Do not try to open Metal interface on startup        |",
   "     --backend-ignore-opencl    |      | Do not try to open OpenCL interface on startup       |",
+  "     --backend-native           |      | Add the host CPU as device, kernels built with $CC   |",
   " -I, --backend-info             |      | Show system/environment/backend API info             | -I or -II",
   " -d, --backend-devices          | Str  | Backend devices to use, separated with commas        | -d 1",
   " -Y, --backend-devices-virtmulti| Num  | Spawn X virtual instances on a real device           | -Y 8",
@@ -114,6 +122,8 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   " -D, --opencl-device-types      | Str  | OpenCL device-types to use, separated with commas    | -D 1",
   " -O, --optimized-kernel-enable  |      | Enable optimized kernels (limits password length)    |",
   " -M, --multiply-accel-disable   |      | Disable multiply kernel-accel with processor count   |",
+  "     --salt-pack                |      | Pack multiple salts into one slow-hash kernel launch |",
+  "     --association-width        | Num  | Number of consecutive words per hash in -a 9         | --association-width=4",
   " -w, --workload-profile         | Num  | Enable a specific workload profile, see pool below   | -w 3",
   " -n, --kernel-accel             | Num  | Manual workload tuning, set outerloop step size to X | -n 64",
   " -u, --kernel-loops             | Num  | Manual workload tuning, set innerloop step size to X | -u 256",
@@ -122,6 +132,8 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --spin-damp                | Num  | Use CPU for device synchronization, in percent       | --spin-damp=10",
   "     --hwmon-disable            |      | Disable temperature and fanspeed reads and triggers  |",
   "     --hwmon-temp-abort         | Num  | Abort if temperature reaches X degrees Celsius       | --hwmon-temp-abort=100",
+  "     --hwmon-sysfs-root         | Str  | Sets the sysfs root for the CPU sensors              | --hwmon-sysfs-root=/sys",
+  "     --tune-energy              |      | Autotune CPU devices for hashes per joule            |",
   "     --scrypt-tmto              | Num  | Manually override TMTO value for scrypt to X         | --scrypt-tmto=3",
   " -s, --skip                     | Num  | Skip X words from the start                          | -s 1000000",
   " -l, --limit                    | Num  | Limit X words from the start + skipped words         | -l 1000000",
@@ -130,11 +142,14 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   " -j, --rule-left                | Rule | Single rule applied to each word from left wordlist  | -j 'c'",
   " -k, --rule-right               | Rule | Single rule applied to each word from right wordlist | -k '^-'",
   " -r, --rules-file               | File | Multiple rules applied to each word from wordlists   | -r rules/best66.rule",
+  "     --rules-optimize           |      | Remove rules which produce the same candidates       |",
+  "     --rules-optimize-out       | File | Write the optimized -r rules to file and exit        | --rules-optimize-out=opt.rule",
   " -g, --generate-rules           | Num  | Generate X random rules                              | -g 10000",
   "     --generate-rules-func-min  | Num  | Force min X functions per rule                       |",
   "     --generate-rules-func-max  | Num  | Force max X functions per rule                       |",
   "     --generate-rules-func-sel  | Str  | Pool of rule operators valid for random rule engine  | --generate-rules-func-sel=ioTlc",
   "     --generate-rules-seed      | Num  | Force RNG seed set to X                              |",
+  "     --rules-fuzz               | Num  | Cross-check and benchmark the rule engines, X rules  | --rules-fuzz=10000",
   " -1, --custom-charset1          | CS   | User-defined charset ?1                              | -1 ?l?d?u",
   " -2, --custom-charset2          | CS   | User-defined charset ?2                              | -2 ?l?d?s",
   " -3, --custom-charset3          | CS   | User-defined charset ?3                              |",
@@ -144,16 +159,21 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   " -7, --custom-charset7          | CS   | User-defined charset ?7                              |",
   " -8, --custom-charset8          | CS   | User-defined charset ?8                              |",
   "     --identify                 |      | Shows all supported algorithms for input hashes      | --identify my.hash",
+  "     --identify-all             |      | Identify every line of the hashfile, count per mode  | --identify --identify-all leak.txt",
+  "     --identify-split-dir       | Dir  | Write the lines of each identified mode to Dir       | --identify-split-dir=split",
   " -i, --increment                |      | Enable mask increment mode                           |",
   " -ii,--increment-inverse        |      | Increment from right-to-left                         |",
   "     --increment-min            | Num  | Start mask incrementing at X                         | --increment-min=4",
   "     --increment-max            | Num  | Stop mask incrementing at X                          | --increment-max=8",
+  "     --mask-fusion              |      | Fuse maskfile masks differing in a single position   |",
   " -S, --slow-candidates          |      | Enable slower (but advanced) candidate generators    |",
+  "     --dedup                    |      | Skip candidates already tested in this session       |",
   "     --bypass-delay             | Num  | Seconds delay between checking bypass threshold      | --bypass-delay=5",
   "     --bypass-threshold         | Num  | Minimum amount of founds to avoid being bypassed     | --bypass-threshold=5",
   #ifdef WITH_BRAIN
   "     --brain-server             |      | Enable brain server                                  |",
   "     --brain-server-timer       | Num  | Update the brain server dump each X seconds (min:60) | --brain-server-timer=300",
+  "     --brain-server-lease       | Num  | Reclaim positions of clients idle for X seconds      | --brain-server-lease=600",
   " -z, --brain-client             |      | Enable brain client, activates -S                    |",
   "     --brain-client-features    | Num  | Define brain client features, see below              | --brain-client-features=3",
   "     --brain-host               | Str  | Brain server host (IP or domain)                     | --brain-host=127.0.0.1",
@@ -162,6 +182,10 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --brain-session            | Hex  | Overrides automatically calculated brain session     | --brain-session=0x2ae611db",
   "     --brain-session-whitelist  | Hex  | Allow given sessions only, separated with commas     | --brain-session-whitelist=0x2ae611db",
   #endif
+  "     --daemon                   |      | Run as daemon, accept jobs on a local UNIX socket    |",
+  "     --daemon-socket            | File | UNIX socket to accept daemon jobs on                 | --daemon-socket=hashcat.sock",
+  "     --metrics-port             | Port | Serve OpenMetrics on 127.0.0.1 at the given port     | --metrics-port=9109",
+  "     --metrics-socket           | File | Serve OpenMetrics on the given UNIX socket           | --metrics-socket=metrics.sock",
   "     --color-cracked            |      | Enables color output for cracked hashes              |",
   "",
   NULL
@@ -196,6 +220,8 @@ static const char *const USAGE_BIG_POST_HASHMODES[] =
   "  1 | Send hashed passwords",
   "  2 | Send attack positions",
   "  3 | Send hashed passwords and attack positions",
+  "  4 | Pull attack positions from server",
+  "  5 | Send hashed passwords and pull attack positions",
   "",
   #endif
   "- [ Outfile Formats ] -",
@@ -346,17 +372,13 @@ void usage_big_print (hashcat_ctx_t *hashcat_ctx)
 
   if (user_options->usage > 1)
   {
-    char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
-
     usage_sort_buf = (usage_sort_t *) hccalloc (MODULE_HASH_MODES_MAXIMUM, sizeof (usage_sort_t));
 
     for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
     {
       user_options->hash_mode = i;
 
-      module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
-
-      if (hc_path_exist (modulefile) == false) continue;
+      if (module_exists (folder_config, i) == false) continue;
 
       const int rc = hashconfig_init (hashcat_ctx);
 
@@ -372,8 +394,6 @@ void usage_big_print (hashcat_ctx_t *hashcat_ctx)
       hashconfig_destroy (hashcat_ctx);
     }
 
-    hcfree (modulefile);
-
     qsort (usage_sort_buf, usage_sort_cnt, sizeof (usage_sort_t), sort_by_usage);
   }
 
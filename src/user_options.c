@@ -33,6 +33,7 @@ static char *const SEPARATOR = ":";
 static const struct option long_options[] =
 {
   {"advice-disable",            no_argument,       NULL, IDX_ADVICE_DISABLE},
+  {"association-width",         required_argument, NULL, IDX_ASSOCIATION_WIDTH},
   {"attack-mode",               required_argument, NULL, IDX_ATTACK_MODE},
   {"backend-devices",           required_argument, NULL, IDX_BACKEND_DEVICES},
   {"backend-devices-virtmulti", required_argument, NULL, IDX_BACKEND_DEVICES_VIRTMULTI},
@@ -45,6 +46,7 @@ static const struct option long_options[] =
   #endif
   {"backend-ignore-opencl",     no_argument,       NULL, IDX_BACKEND_IGNORE_OPENCL},
   {"backend-info",              no_argument,       NULL, IDX_BACKEND_INFO},
+  {"backend-native",            no_argument,       NULL, IDX_BACKEND_NATIVE},
   {"backend-vector-width",      required_argument, NULL, IDX_BACKEND_VECTOR_WIDTH},
   {"bypass-delay",              required_argument, NULL, IDX_BYPASS_DELAY},
   {"bypass-threshold",          required_argument, NULL, IDX_BYPASS_THRESHOLD},
@@ -52,6 +54,7 @@ static const struct option long_options[] =
   {"benchmark-max",             required_argument, NULL, IDX_BENCHMARK_MAX},
   {"benchmark-min",             required_argument, NULL, IDX_BENCHMARK_MIN},
   {"benchmark",                 no_argument,       NULL, IDX_BENCHMARK},
+  {"bitmap-l1-disable",         no_argument,       NULL, IDX_BITMAP_L1_DISABLE},
   {"bitmap-max",                required_argument, NULL, IDX_BITMAP_MAX},
   {"bitmap-min",                required_argument, NULL, IDX_BITMAP_MIN},
   {"bridge-parameter1",         required_argument, NULL, IDX_BRIDGE_PARAMETER1},
@@ -67,8 +70,11 @@ static const struct option long_options[] =
   {"custom-charset6",           required_argument, NULL, IDX_CUSTOM_CHARSET_6},
   {"custom-charset7",           required_argument, NULL, IDX_CUSTOM_CHARSET_7},
   {"custom-charset8",           required_argument, NULL, IDX_CUSTOM_CHARSET_8},
+  {"daemon",                    no_argument,       NULL, IDX_DAEMON},
+  {"daemon-socket",             required_argument, NULL, IDX_DAEMON_SOCKET},
   {"debug-file",                required_argument, NULL, IDX_DEBUG_FILE},
   {"debug-mode",                required_argument, NULL, IDX_DEBUG_MODE},
+  {"dedup",                     no_argument,       NULL, IDX_DEDUP},
   {"deprecated-check-disable",  no_argument,       NULL, IDX_DEPRECATED_CHECK_DISABLE},
   {"dynamic-x",                 no_argument,       NULL, IDX_DYNAMIC_X},
   {"encoding-from",             required_argument, NULL, IDX_ENCODING_FROM},
@@ -81,6 +87,7 @@ static const struct option long_options[] =
   {"generate-rules",            required_argument, NULL, IDX_RP_GEN},
   {"generate-rules-seed",       required_argument, NULL, IDX_RP_GEN_SEED},
   {"hwmon-disable",             no_argument,       NULL, IDX_HWMON_DISABLE},
+  {"hwmon-sysfs-root",          required_argument, NULL, IDX_HWMON_SYSFS_ROOT},
   {"hwmon-temp-abort",          required_argument, NULL, IDX_HWMON_TEMP_ABORT},
   {"hash-info",                 no_argument,       NULL, IDX_HASH_INFO},
   {"hash-type",                 required_argument, NULL, IDX_HASH_MODE},
@@ -91,6 +98,8 @@ static const struct option long_options[] =
   {"hex-wordlist",              no_argument,       NULL, IDX_HEX_WORDLIST},
   {"hook-threads",              required_argument, NULL, IDX_HOOK_THREADS},
   {"identify",                  no_argument,       NULL, IDX_IDENTIFY},
+  {"identify-all",              no_argument,       NULL, IDX_IDENTIFY_ALL},
+  {"identify-split-dir",        required_argument, NULL, IDX_IDENTIFY_SPLIT_DIR},
   {"increment-max",             required_argument, NULL, IDX_INCREMENT_MAX},
   {"increment-min",             required_argument, NULL, IDX_INCREMENT_MIN},
   {"increment",                 no_argument,       NULL, IDX_INCREMENT},
@@ -107,14 +116,21 @@ static const struct option long_options[] =
   {"limit",                     required_argument, NULL, IDX_LIMIT},
   {"logfile-disable",           no_argument,       NULL, IDX_LOGFILE_DISABLE},
   {"loopback",                  no_argument,       NULL, IDX_LOOPBACK},
+  {"loopback-queue",            no_argument,       NULL, IDX_LOOPBACK_QUEUE},
   {"machine-readable",          no_argument,       NULL, IDX_MACHINE_READABLE},
+  {"mask-fusion",               no_argument,       NULL, IDX_MASK_FUSION},
   {"markov-classic",            no_argument,       NULL, IDX_MARKOV_CLASSIC},
   {"markov-disable",            no_argument,       NULL, IDX_MARKOV_DISABLE},
   {"markov-hcstat2",            required_argument, NULL, IDX_MARKOV_HCSTAT2},
+  {"markov-hcstat2-create",     required_argument, NULL, IDX_MARKOV_HCSTAT2_CREATE},
   {"markov-inverse",            no_argument,       NULL, IDX_MARKOV_INVERSE},
   {"markov-threshold",          required_argument, NULL, IDX_MARKOV_THRESHOLD},
   {"metal-compiler-runtime",    required_argument, NULL, IDX_METAL_COMPILER_RUNTIME},
+  {"metrics-port",              required_argument, NULL, IDX_METRICS_PORT},
+  {"metrics-socket",            required_argument, NULL, IDX_METRICS_SOCKET},
   {"nonce-error-corrections",   required_argument, NULL, IDX_NONCE_ERROR_CORRECTIONS},
+  {"numa-disable",              no_argument,       NULL, IDX_NUMA_DISABLE},
+  {"numa-hugepages",            no_argument,       NULL, IDX_NUMA_HUGEPAGES},
   {"opencl-device-types",       required_argument, NULL, IDX_OPENCL_DEVICE_TYPES},
   {"optimized-kernel-enable",   no_argument,       NULL, IDX_OPTIMIZED_KERNEL_ENABLE},
   {"multiply-accel-disable",    no_argument,       NULL, IDX_MULTIPLY_ACCEL_DISABLE},
@@ -126,6 +142,8 @@ static const struct option long_options[] =
   {"outfile",                   required_argument, NULL, IDX_OUTFILE},
   {"potfile-disable",           no_argument,       NULL, IDX_POTFILE_DISABLE},
   {"potfile-path",              required_argument, NULL, IDX_POTFILE_PATH},
+  {"potfile-shard",             no_argument,       NULL, IDX_POTFILE_SHARD},
+  {"potfile-compact",           no_argument,       NULL, IDX_POTFILE_COMPACT},
   {"progress-only",             no_argument,       NULL, IDX_PROGRESS_ONLY},
   {"quiet",                     no_argument,       NULL, IDX_QUIET},
   {"remove",                    no_argument,       NULL, IDX_REMOVE},
@@ -136,7 +154,11 @@ static const struct option long_options[] =
   {"rule-left",                 required_argument, NULL, IDX_RULE_BUF_L},
   {"rule-right",                required_argument, NULL, IDX_RULE_BUF_R},
   {"rules-file",                required_argument, NULL, IDX_RP_FILE},
+  {"rules-fuzz",                required_argument, NULL, IDX_RULES_FUZZ},
+  {"rules-optimize",            no_argument,       NULL, IDX_RULES_OPTIMIZE},
+  {"rules-optimize-out",        required_argument, NULL, IDX_RULES_OPTIMIZE_OUT},
   {"runtime",                   required_argument, NULL, IDX_RUNTIME},
+  {"salt-pack",                 no_argument,       NULL, IDX_SALT_PACK},
   {"scrypt-tmto",               required_argument, NULL, IDX_SCRYPT_TMTO},
   {"segment-size",              required_argument, NULL, IDX_SEGMENT_SIZE},
   {"self-test-disable",         no_argument,       NULL, IDX_SELF_TEST_DISABLE},
@@ -154,6 +176,7 @@ static const struct option long_options[] =
   {"stdout",                    no_argument,       NULL, IDX_STDOUT_FLAG},
   {"stdin-timeout-abort",       required_argument, NULL, IDX_STDIN_TIMEOUT_ABORT},
   {"truecrypt-keyfiles",        required_argument, NULL, IDX_TRUECRYPT_KEYFILES},
+  {"tune-energy",               no_argument,       NULL, IDX_TUNE_ENERGY},
   {"username",                  no_argument,       NULL, IDX_USERNAME},
   {"veracrypt-keyfiles",        required_argument, NULL, IDX_VERACRYPT_KEYFILES},
   {"veracrypt-pim-start",       required_argument, NULL, IDX_VERACRYPT_PIM_START},
@@ -166,6 +189,7 @@ static const struct option long_options[] =
   {"brain-client-features",     required_argument, NULL, IDX_BRAIN_CLIENT_FEATURES},
   {"brain-server",              no_argument,       NULL, IDX_BRAIN_SERVER},
   {"brain-server-timer",        required_argument, NULL, IDX_BRAIN_SERVER_TIMER},
+  {"brain-server-lease",        required_argument, NULL, IDX_BRAIN_SERVER_LEASE},
   {"brain-host",                required_argument, NULL, IDX_BRAIN_HOST},
   {"brain-port",                required_argument, NULL, IDX_BRAIN_PORT},
   {"brain-password",            required_argument, NULL, IDX_BRAIN_PASSWORD},
@@ -191,6 +215,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options_t *user_options = hashcat_ctx->user_options;
 
   user_options->advice                    = ADVICE;
+  user_options->association_width         = ASSOCIATION_WIDTH;
   user_options->attack_mode               = ATTACK_MODE;
   user_options->autodetect                = AUTODETECT;
   user_options->backend_devices           = NULL;
@@ -204,11 +229,13 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   #endif
   user_options->backend_ignore_opencl     = BACKEND_IGNORE_OPENCL;
   user_options->backend_info              = BACKEND_INFO;
+  user_options->backend_native            = BACKEND_NATIVE;
   user_options->backend_vector_width      = BACKEND_VECTOR_WIDTH;
   user_options->benchmark_all             = BENCHMARK_ALL;
   user_options->benchmark_max             = BENCHMARK_MAX;
   user_options->benchmark_min             = BENCHMARK_MIN;
   user_options->benchmark                 = BENCHMARK;
+  user_options->bitmap_l1                 = BITMAP_L1;
   user_options->bitmap_max                = BITMAP_MAX;
   user_options->bitmap_min                = BITMAP_MIN;
   #ifdef WITH_BRAIN
@@ -218,6 +245,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->brain_port                = BRAIN_PORT;
   user_options->brain_server              = BRAIN_SERVER;
   user_options->brain_server_timer        = BRAIN_SERVER_TIMER;
+  user_options->brain_server_lease        = BRAIN_SERVER_LEASE;
   user_options->brain_session             = BRAIN_SESSION;
   user_options->brain_session_whitelist   = NULL;
   #endif
@@ -235,14 +263,18 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->custom_charset_6          = NULL;
   user_options->custom_charset_7          = NULL;
   user_options->custom_charset_8          = NULL;
+  user_options->daemon                    = DAEMON;
+  user_options->daemon_socket             = NULL;
   user_options->debug_file                = NULL;
   user_options->debug_mode                = DEBUG_MODE;
+  user_options->dedup                     = DEDUP;
   user_options->deprecated_check          = DEPRECATED_CHECK;
   user_options->dynamic_x                 = DYNAMIC_X;
   user_options->encoding_from             = ENCODING_FROM;
   user_options->encoding_to               = ENCODING_TO;
   user_options->force                     = FORCE;
   user_options->hwmon                     = HWMON;
+  user_options->hwmon_sysfs_root          = NULL;
   user_options->hwmon_temp_abort          = HWMON_TEMP_ABORT;
   user_options->hash_info                 = HASH_INFO;
   user_options->hash_mode                 = HASH_MODE;
@@ -252,6 +284,8 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->hex_wordlist              = HEX_WORDLIST;
   user_options->hook_threads              = HOOK_THREADS;
   user_options->identify                  = IDENTIFY;
+  user_options->identify_all              = IDENTIFY_ALL;
+  user_options->identify_split_dir        = NULL;
   user_options->increment                 = (increment_t) INCREMENT;
   user_options->increment_max             = INCREMENT_MAX;
   user_options->increment_min             = INCREMENT_MIN;
@@ -267,17 +301,24 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->limit                     = LIMIT;
   user_options->logfile                   = LOGFILE;
   user_options->loopback                  = LOOPBACK;
+  user_options->loopback_queue            = LOOPBACK_QUEUE;
   user_options->machine_readable          = MACHINE_READABLE;
+  user_options->mask_fusion               = MASK_FUSION;
   user_options->markov_classic            = MARKOV_CLASSIC;
   user_options->markov                    = MARKOV;
   user_options->markov_hcstat2            = NULL;
+  user_options->markov_hcstat2_create     = NULL;
   user_options->markov_inverse            = MARKOV_INVERSE;
   user_options->markov_threshold          = MARKOV_THRESHOLD;
   user_options->metal_compiler_runtime    = METAL_COMPILER_RUNTIME;
+  user_options->metrics_port              = METRICS_PORT;
+  user_options->metrics_socket            = NULL;
   user_options->nonce_error_corrections   = NONCE_ERROR_CORRECTIONS;
   user_options->opencl_device_types       = NULL;
   user_options->optimized_kernel          = OPTIMIZED_KERNEL;
   user_options->multiply_accel            = MULTIPLY_ACCEL;
+  user_options->numa                      = NUMA;
+  user_options->numa_hugepages            = NUMA_HUGEPAGES;
   user_options->outfile_autohex           = OUTFILE_AUTOHEX;
   user_options->outfile_check_dir         = NULL;
   user_options->outfile_check_timer       = OUTFILE_CHECK_TIMER;
@@ -286,6 +327,8 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->outfile                   = NULL;
   user_options->potfile                   = POTFILE;
   user_options->potfile_path              = NULL;
+  user_options->potfile_shard             = POTFILE_SHARD;
+  user_options->potfile_compact           = POTFILE_COMPACT;
   user_options->progress_only             = PROGRESS_ONLY;
   user_options->quiet                     = QUIET;
   user_options->remove                    = REMOVE;
@@ -301,8 +344,12 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->rp_gen_seed               = RP_GEN_SEED;
   user_options->rule_buf_l                = RULE_BUF_L;
   user_options->rule_buf_r                = RULE_BUF_R;
+  user_options->rules_fuzz                = RULES_FUZZ;
+  user_options->rules_optimize            = RULES_OPTIMIZE;
+  user_options->rules_optimize_out        = NULL;
   user_options->runtime                   = RUNTIME;
   user_options->scrypt_tmto               = SCRYPT_TMTO;
+  user_options->salt_pack                 = SALT_PACK;
   user_options->segment_size              = SEGMENT_SIZE;
   user_options->self_test                 = SELF_TEST;
   user_options->separator                 = SEPARATOR;
@@ -317,6 +364,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->status_timer              = STATUS_TIMER;
   user_options->stdin_timeout_abort       = STDIN_TIMEOUT_ABORT;
   user_options->stdout_flag               = STDOUT_FLAG;
+  user_options->tune_energy               = TUNE_ENERGY;
   user_options->truecrypt_keyfiles        = NULL;
   user_options->usage                     = USAGE;
   user_options->username                  = USERNAME;
@@ -375,7 +423,10 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_HASH_MODE:
       case IDX_RUNTIME:
       case IDX_METAL_COMPILER_RUNTIME:
+      case IDX_METRICS_PORT:
       case IDX_ATTACK_MODE:
+      case IDX_ASSOCIATION_WIDTH:
+      case IDX_RULES_FUZZ:
       case IDX_RP_GEN:
       case IDX_RP_GEN_FUNC_MIN:
       case IDX_RP_GEN_FUNC_MAX:
@@ -453,8 +504,13 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
                                           user_options->remove_timer_chgd         = true;                            break;
       case IDX_POTFILE_DISABLE:           user_options->potfile                   = false;                           break;
       case IDX_POTFILE_PATH:              user_options->potfile_path              = optarg;                          break;
+      case IDX_POTFILE_SHARD:             user_options->potfile_shard             = true;                            break;
+      case IDX_POTFILE_COMPACT:           user_options->potfile_compact           = true;                            break;
       case IDX_DEBUG_MODE:                user_options->debug_mode                = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_DEBUG_FILE:                user_options->debug_file                = optarg;                          break;
+      case IDX_DEDUP:                     user_options->dedup                     = true;                            break;
+      case IDX_DAEMON:                    user_options->daemon                    = true;                            break;
+      case IDX_DAEMON_SOCKET:             user_options->daemon_socket             = optarg;                          break;
       case IDX_ENCODING_FROM:             user_options->encoding_from             = optarg;                          break;
       case IDX_ENCODING_TO:               user_options->encoding_to               = optarg;                          break;
       case IDX_INDUCTION_DIR:             user_options->induction_dir             = optarg;                          break;
@@ -474,9 +530,12 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_BENCHMARK_MAX:             user_options->benchmark_max             = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_BENCHMARK_MIN:             user_options->benchmark_min             = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_STDOUT_FLAG:               user_options->stdout_flag               = true;                            break;
+      case IDX_TUNE_ENERGY:               user_options->tune_energy               = true;                            break;
       case IDX_STDIN_TIMEOUT_ABORT:       user_options->stdin_timeout_abort       = hc_strtoul (optarg, NULL, 10);
                                           user_options->stdin_timeout_abort_chgd  = true;                            break;
       case IDX_IDENTIFY:                  user_options->identify                  = true;                            break;
+      case IDX_IDENTIFY_ALL:              user_options->identify_all              = true;                            break;
+      case IDX_IDENTIFY_SPLIT_DIR:        user_options->identify_split_dir        = optarg;                          break;
       case IDX_SPEED_ONLY:                user_options->speed_only                = true;                            break;
       case IDX_PROGRESS_ONLY:             user_options->progress_only             = true;                            break;
       case IDX_RESTORE_DISABLE:           user_options->restore_enable            = false;                           break;
@@ -486,6 +545,8 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_STATUS_TIMER:              user_options->status_timer              = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_MACHINE_READABLE:          user_options->machine_readable          = true;                            break;
       case IDX_LOOPBACK:                  user_options->loopback                  = true;                            break;
+      case IDX_LOOPBACK_QUEUE:            user_options->loopback_queue            = true;                            break;
+      case IDX_MASK_FUSION:               user_options->mask_fusion               = true;                            break;
       case IDX_SESSION:                   user_options->session                   = optarg;
                                           user_options->session_chgd              = true;                            break;
       case IDX_HASH_MODE:                 user_options->hash_mode                 = hc_strtoul (optarg, NULL, 10);
@@ -496,6 +557,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
                                           user_options->metal_compiler_runtime_chgd = true;                          break;
       case IDX_ATTACK_MODE:               user_options->attack_mode               = hc_strtoul (optarg, NULL, 10);
                                           user_options->attack_mode_chgd          = true;                            break;
+      case IDX_ASSOCIATION_WIDTH:         user_options->association_width         = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_RP_FILE:                   user_options->rp_files[user_options->rp_files_cnt++] = optarg;             break;
       case IDX_RP_GEN:                    user_options->rp_gen                    = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_RP_GEN_FUNC_MIN:           user_options->rp_gen_func_min           = hc_strtoul (optarg, NULL, 10);   break;
@@ -507,11 +569,17 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
                                           user_options->rule_buf_l_chgd           = true;                            break;
       case IDX_RULE_BUF_R:                user_options->rule_buf_r                = optarg;
                                           user_options->rule_buf_r_chgd           = true;                            break;
+      case IDX_RULES_FUZZ:                user_options->rules_fuzz                = hc_strtoul (optarg, NULL, 10);   break;
+      case IDX_RULES_OPTIMIZE:            user_options->rules_optimize            = true;                            break;
+      case IDX_RULES_OPTIMIZE_OUT:        user_options->rules_optimize_out        = optarg;                          break;
       case IDX_MARKOV_DISABLE:            user_options->markov                    = false;                           break;
       case IDX_MARKOV_CLASSIC:            user_options->markov_classic            = true;                            break;
       case IDX_MARKOV_INVERSE:            user_options->markov_inverse            = true;                            break;
       case IDX_MARKOV_THRESHOLD:          user_options->markov_threshold          = hc_strtoul (optarg, NULL, 10);   break;
+      case IDX_METRICS_PORT:              user_options->metrics_port              = hc_strtoul (optarg, NULL, 10);   break;
+      case IDX_METRICS_SOCKET:            user_options->metrics_socket            = optarg;                          break;
       case IDX_MARKOV_HCSTAT2:            user_options->markov_hcstat2            = optarg;                          break;
+      case IDX_MARKOV_HCSTAT2_CREATE:     user_options->markov_hcstat2_create     = optarg;                          break;
       case IDX_OUTFILE:                   user_options->outfile                   = optarg;
                                           user_options->outfile_chgd              = true;                            break;
       case IDX_OUTFILE_FORMAT:            user_options->outfile_format            = outfile_format_parse (optarg);
@@ -535,6 +603,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       #endif
       case IDX_BACKEND_IGNORE_OPENCL:     user_options->backend_ignore_opencl     = true;                            break;
       case IDX_BACKEND_INFO:              user_options->backend_info++;                                              break;
+      case IDX_BACKEND_NATIVE:            user_options->backend_native            = true;                            break;
       case IDX_BACKEND_DEVICES:           user_options->backend_devices           = optarg;                          break;
       case IDX_BACKEND_DEVICES_VIRTMULTI: user_options->backend_devices_virtmulti = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_BACKEND_DEVICES_VIRTHOST:  user_options->backend_devices_virthost  = hc_strtoul (optarg, NULL, 10);   break;
@@ -548,6 +617,8 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_OPENCL_DEVICE_TYPES:       user_options->opencl_device_types       = optarg;                          break;
       case IDX_OPTIMIZED_KERNEL_ENABLE:   user_options->optimized_kernel          = true;                            break;
       case IDX_MULTIPLY_ACCEL_DISABLE:    user_options->multiply_accel            = false;                           break;
+      case IDX_NUMA_DISABLE:              user_options->numa                      = false;                           break;
+      case IDX_NUMA_HUGEPAGES:            user_options->numa_hugepages            = true;                            break;
       case IDX_WORKLOAD_PROFILE:          user_options->workload_profile          = hc_strtoul (optarg, NULL, 10);
                                           user_options->workload_profile_chgd     = true;                            break;
       case IDX_KERNEL_ACCEL:              user_options->kernel_accel              = hc_strtoul (optarg, NULL, 10);
@@ -559,6 +630,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_SPIN_DAMP:                 user_options->spin_damp                 = hc_strtoul (optarg, NULL, 10);
                                           user_options->spin_damp_chgd            = true;                            break;
       case IDX_HWMON_DISABLE:             user_options->hwmon                     = false;                           break;
+      case IDX_HWMON_SYSFS_ROOT:          user_options->hwmon_sysfs_root          = optarg;                          break;
       case IDX_HWMON_TEMP_ABORT:          user_options->hwmon_temp_abort          = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_LOGFILE_DISABLE:           user_options->logfile                   = false;                           break;
       case IDX_HCCAPX_MESSAGE_PAIR:       user_options->hccapx_message_pair       = hc_strtoul (optarg, NULL, 10);
@@ -580,6 +652,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
                                           user_options->separator_chgd            = true;                            break;
       case IDX_BITMAP_MIN:                user_options->bitmap_min                = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_BITMAP_MAX:                user_options->bitmap_max                = hc_strtoul (optarg, NULL, 10);   break;
+      case IDX_BITMAP_L1_DISABLE:         user_options->bitmap_l1                 = false;                           break;
       case IDX_HOOK_THREADS:              user_options->hook_threads              = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_INCREMENT:                 user_options->increment++;                                                 break;
       case IDX_INCREMENT_INVERSE:         user_options->increment                 = INCREMENT_INVERSED;              break;
@@ -596,12 +669,15 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_CUSTOM_CHARSET_7:          user_options->custom_charset_7          = optarg;                          break;
       case IDX_CUSTOM_CHARSET_8:          user_options->custom_charset_8          = optarg;                          break;
       case IDX_SLOW_CANDIDATES:           user_options->slow_candidates           = true;                            break;
+      case IDX_SALT_PACK:                 user_options->salt_pack                 = true;                            break;
       #ifdef WITH_BRAIN
       case IDX_BRAIN_CLIENT:              user_options->brain_client              = true;                            break;
       case IDX_BRAIN_CLIENT_FEATURES:     user_options->brain_client_features     = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_BRAIN_SERVER:              user_options->brain_server              = true;                            break;
       case IDX_BRAIN_SERVER_TIMER:        user_options->brain_server_timer        = hc_strtoul (optarg, NULL, 10);
                                           user_options->brain_server_timer_chgd   = true;                            break;
+      case IDX_BRAIN_SERVER_LEASE:        user_options->brain_server_lease        = hc_strtoul (optarg, NULL, 10);
+                                          user_options->brain_server_lease_chgd   = true;                            break;
       case IDX_BRAIN_PASSWORD:            user_options->brain_password            = optarg;
                                           user_options->brain_password_chgd       = true;                            break;
       case IDX_BRAIN_HOST:                user_options->brain_host                = optarg;
@@ -656,7 +732,7 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
-  if ((user_options->brain_client_features < 1) || (user_options->brain_client_features > 3))
+  if ((user_options->brain_client_features < 1) || (user_options->brain_client_features > 5))
   {
     event_log_error (hashcat_ctx, "Invalid --brain-client-feature argument.");
 
@@ -696,6 +772,26 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
       }
     }
   }
+
+  if (user_options->brain_server_lease_chgd)
+  {
+    if (user_options->brain_server == false)
+    {
+      event_log_error (hashcat_ctx, "The --brain-server-lease flag requires --brain-server.");
+
+      return -1;
+    }
+
+    if (user_options->brain_server_lease != 0) // special case (reservations never expire)
+    {
+      if (user_options->brain_server_lease < 60)
+      {
+        event_log_error (hashcat_ctx, "Brain server lease timeout must be at least 60 seconds.");
+
+        return -1;
+      }
+    }
+  }
   #endif
 
   if (user_options->separator_chgd == true)
@@ -993,6 +1089,20 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
+  if (user_options->association_width == 0)
+  {
+    event_log_error (hashcat_ctx, "Invalid --association-width value - must be greater than 0.");
+
+    return -1;
+  }
+
+  if ((user_options->association_width != ASSOCIATION_WIDTH) && (user_options->attack_mode != ATTACK_MODE_ASSOCIATION))
+  {
+    event_log_error (hashcat_ctx, "Use of --association-width requires attack mode 9 (association).");
+
+    return -1;
+  }
+
   if ((user_options->increment == INCREMENT_NONE) && (user_options->increment_min_chgd == true))
   {
     event_log_error (hashcat_ctx, "Increment-min is only supported when combined with -i/--increment.");
@@ -1022,6 +1132,26 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
+  if ((user_options->rules_optimize == true) || (user_options->rules_optimize_out != NULL))
+  {
+    if (user_options->rp_files_cnt == 0)
+    {
+      event_log_error (hashcat_ctx, "Use of --rules-optimize and --rules-optimize-out requires -r/--rules-file.");
+
+      return -1;
+    }
+  }
+
+  if (user_options->rules_optimize_out != NULL)
+  {
+    if (strlen (user_options->rules_optimize_out) == 0)
+    {
+      event_log_error (hashcat_ctx, "Invalid --rules-optimize-out value - must not be empty.");
+
+      return -1;
+    }
+  }
+
   if ((user_options->rp_files_cnt > 0) || (user_options->rp_gen > 0))
   {
     if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT) && (user_options->attack_mode != ATTACK_MODE_GENERIC) && (user_options->attack_mode != ATTACK_MODE_ASSOCIATION))
@@ -1288,6 +1418,88 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->loopback_queue == true)
+  {
+    if (user_options->loopback == false)
+    {
+      event_log_error (hashcat_ctx, "Parameter --loopback-queue requires --loopback.");
+
+      return -1;
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+      event_log_error (hashcat_ctx, "Combining --loopback-queue with --slow-candidates is not allowed.");
+
+      return -1;
+    }
+  }
+
+  if (user_options->tune_energy == true)
+  {
+    if (user_options->hwmon == false)
+    {
+      event_log_error (hashcat_ctx, "Combining --tune-energy with --hwmon-disable is not allowed.");
+
+      return -1;
+    }
+  }
+
+  if (user_options->dedup == true)
+  {
+    if (user_options->slow_candidates == true)
+    {
+      if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT) && (user_options->attack_mode != ATTACK_MODE_COMBI) && (user_options->attack_mode != ATTACK_MODE_HYBRID1) && (user_options->attack_mode != ATTACK_MODE_HYBRID2))
+      {
+        event_log_error (hashcat_ctx, "Parameter --dedup with --slow-candidates is only allowed in attack modes 0, 1, 6 and 7.");
+
+        return -1;
+      }
+    }
+    else if (user_options->attack_mode != ATTACK_MODE_STRAIGHT)
+    {
+      event_log_error (hashcat_ctx, "Parameter --dedup is only allowed in attack mode 0 (straight), or with --slow-candidates.");
+
+      return -1;
+    }
+
+    #ifdef WITH_BRAIN
+    if (user_options->brain_client == true)
+    {
+      event_log_error (hashcat_ctx, "Combining --dedup with --brain-client is not allowed.");
+
+      return -1;
+    }
+    #endif
+  }
+
+  if ((user_options->potfile_shard == true) || (user_options->potfile_compact == true))
+  {
+    if (user_options->potfile == false)
+    {
+      event_log_error (hashcat_ctx, "Combining --potfile-shard or --potfile-compact with --potfile-disable is not allowed.");
+
+      return -1;
+    }
+  }
+
+  if (user_options->mask_fusion == true)
+  {
+    if ((user_options->attack_mode != ATTACK_MODE_BF) && (user_options->attack_mode != ATTACK_MODE_HYBRID1) && (user_options->attack_mode != ATTACK_MODE_HYBRID2))
+    {
+      event_log_error (hashcat_ctx, "Parameter --mask-fusion is only allowed in attack modes 3, 6 and 7.");
+
+      return -1;
+    }
+
+    if (user_options->hex_charset == true)
+    {
+      event_log_error (hashcat_ctx, "Combining --mask-fusion with --hex-charset is not allowed.");
+
+      return -1;
+    }
+  }
+
   if (user_options->debug_mode > 0)
   {
     if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT) && (user_options->attack_mode != ATTACK_MODE_GENERIC) && (user_options->attack_mode != ATTACK_MODE_ASSOCIATION))
@@ -1346,6 +1558,33 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->identify_all == true)
+  {
+    if (user_options->identify == false)
+    {
+      event_log_error (hashcat_ctx, "Use of --identify-all requires --identify.");
+
+      return -1;
+    }
+  }
+
+  if (user_options->identify_split_dir != NULL)
+  {
+    if (user_options->identify_all == false)
+    {
+      event_log_error (hashcat_ctx, "Use of --identify-split-dir requires --identify-all.");
+
+      return -1;
+    }
+
+    if (strlen (user_options->identify_split_dir) == 0)
+    {
+      event_log_error (hashcat_ctx, "Invalid --identify-split-dir value - must not be empty.");
+
+      return -1;
+    }
+  }
+
   if (user_options->benchmark_all == true)
   {
     user_options->benchmark = true;
@@ -1532,6 +1771,16 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->markov_hcstat2_create != NULL)
+  {
+    if (strlen (user_options->markov_hcstat2_create) == 0)
+    {
+      event_log_error (hashcat_ctx, "Invalid --markov-hcstat2-create value - must not be empty.");
+
+      return -1;
+    }
+  }
+
   if (user_options->markov_threshold != 0) // is 0 by default
   {
     if ((user_options->attack_mode == ATTACK_MODE_STRAIGHT) || (user_options->attack_mode == ATTACK_MODE_COMBI) || (user_options->attack_mode == ATTACK_MODE_GENERIC) || (user_options->attack_mode == ATTACK_MODE_ASSOCIATION))
@@ -1572,6 +1821,73 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->daemon == true)
+  {
+    if ((user_options->benchmark    == true)
+     || (user_options->identify     == true)
+     || (user_options->keyspace     == true)
+     || (user_options->left         == true)
+     || (user_options->show         == true)
+     || (user_options->stdout_flag  == true)
+     || (user_options->backend_info  > 0)
+     || (user_options->hash_info     > 0))
+    {
+      event_log_error (hashcat_ctx, "Daemon mode can not be combined with an informational or special mode.");
+
+      return -1;
+    }
+
+    #ifdef WITH_BRAIN
+    if (user_options->brain_server == true)
+    {
+      event_log_error (hashcat_ctx, "Can not have --daemon and --brain-server at the same time.");
+
+      return -1;
+    }
+    #endif
+  }
+
+  if (user_options->daemon_socket != NULL)
+  {
+    if (user_options->daemon == false)
+    {
+      event_log_error (hashcat_ctx, "Use of --daemon-socket requires --daemon.");
+
+      return -1;
+    }
+
+    if (strlen (user_options->daemon_socket) == 0)
+    {
+      event_log_error (hashcat_ctx, "Invalid --daemon-socket value - must not be empty.");
+
+      return -1;
+    }
+  }
+
+  if (user_options->metrics_port > 65535)
+  {
+    event_log_error (hashcat_ctx, "Invalid --metrics-port value specified (greater than 65535).");
+
+    return -1;
+  }
+
+  if (user_options->metrics_socket != NULL)
+  {
+    if (user_options->metrics_port > 0)
+    {
+      event_log_error (hashcat_ctx, "Can not have --metrics-port and --metrics-socket at the same time.");
+
+      return -1;
+    }
+
+    if (strlen (user_options->metrics_socket) == 0)
+    {
+      event_log_error (hashcat_ctx, "Invalid --metrics-socket value - must not be empty.");
+
+      return -1;
+    }
+  }
+
   if (user_options->session != NULL)
   {
     if (strlen (user_options->session) == 0)
@@ -1800,6 +2116,13 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     show_error = false;
   }
   #endif
+  else if (user_options->daemon == true)
+  {
+    if (user_options->hc_argc == 0)
+    {
+      show_error = false;
+    }
+  }
   else if (user_options->benchmark == true)
   {
     if (user_options->hc_argc == 0)
@@ -1807,6 +2130,27 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
       show_error = false;
     }
   }
+  else if (user_options->rules_optimize_out != NULL)
+  {
+    if (user_options->hc_argc == 0)
+    {
+      show_error = false;
+    }
+  }
+  else if (user_options->rules_fuzz > 0)
+  {
+    if (user_options->hc_argc == 0)
+    {
+      show_error = false;
+    }
+  }
+  else if (user_options->potfile_compact == true)
+  {
+    if (user_options->hc_argc == 0)
+    {
+      show_error = false;
+    }
+  }
   else if (user_options->hash_info > 0)
   {
     if (user_options->hc_argc == 0)
@@ -2026,6 +2370,11 @@ void user_options_session_auto (hashcat_ctx_t *hashcat_ctx)
       user_options->session = "benchmark";
     }
 
+    if (user_options->daemon == true)
+    {
+      user_options->session = "daemon";
+    }
+
     if (user_options->hash_info > 0)
     {
       user_options->session = "hash_info";
@@ -3418,7 +3767,7 @@ int user_options_check_files (hashcat_ctx_t *hashcat_ctx)
 
   module_filename (folder_config, 0, modulefile, HCBUFSIZ_TINY);
 
-  if (hc_path_exist (modulefile) == false)
+  if (module_exists (folder_config, 0) == false)
   {
     event_log_error (hashcat_ctx, "%s: %s", modulefile, strerror (errno));
 
@@ -3655,12 +4004,18 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_string (user_options->custom_charset_6);
   logfile_top_string (user_options->custom_charset_7);
   logfile_top_string (user_options->custom_charset_8);
+  logfile_top_string (user_options->daemon_socket);
   logfile_top_string (user_options->debug_file);
+  logfile_top_string (user_options->hwmon_sysfs_root);
   logfile_top_string (user_options->encoding_from);
   logfile_top_string (user_options->encoding_to);
+  logfile_top_string (user_options->identify_split_dir);
   logfile_top_string (user_options->induction_dir);
   logfile_top_string (user_options->keyboard_layout_mapping);
   logfile_top_string (user_options->markov_hcstat2);
+  logfile_top_string (user_options->markov_hcstat2_create);
+  logfile_top_string (user_options->metrics_socket);
+  logfile_top_string (user_options->rules_optimize_out);
   logfile_top_string (user_options->backend_devices);
   logfile_top_string (user_options->opencl_device_types);
   logfile_top_string (user_options->outfile);
@@ -3680,6 +4035,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   #endif
   logfile_top_uint64 (user_options->limit);
   logfile_top_uint64 (user_options->skip);
+  logfile_top_uint   (user_options->association_width);
   logfile_top_uint   (user_options->attack_mode);
   logfile_top_uint   (user_options->backend_devices_virtmulti);
   logfile_top_uint   (user_options->backend_devices_virthost);
@@ -3688,9 +4044,12 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->benchmark_all);
   logfile_top_uint   (user_options->benchmark_max);
   logfile_top_uint   (user_options->benchmark_min);
+  logfile_top_uint   (user_options->bitmap_l1);
   logfile_top_uint   (user_options->bitmap_max);
   logfile_top_uint   (user_options->bitmap_min);
+  logfile_top_uint   (user_options->daemon);
   logfile_top_uint   (user_options->debug_mode);
+  logfile_top_uint   (user_options->dedup);
   logfile_top_uint   (user_options->dynamic_x);
   logfile_top_uint   (user_options->hash_info);
   logfile_top_uint   (user_options->force);
@@ -3702,6 +4061,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->hex_wordlist);
   logfile_top_uint   (user_options->hook_threads);
   logfile_top_uint   (user_options->identify);
+  logfile_top_uint   (user_options->identify_all);
   logfile_top_uint   (user_options->increment);
   logfile_top_uint   (user_options->increment_max);
   logfile_top_uint   (user_options->increment_min);
@@ -3714,14 +4074,20 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->left);
   logfile_top_uint   (user_options->logfile);
   logfile_top_uint   (user_options->loopback);
+  logfile_top_uint   (user_options->loopback_queue);
   logfile_top_uint   (user_options->machine_readable);
+  logfile_top_uint   (user_options->mask_fusion);
   logfile_top_uint   (user_options->markov_classic);
   logfile_top_uint   (user_options->markov);
   logfile_top_uint   (user_options->markov_inverse);
   logfile_top_uint   (user_options->markov_threshold);
   logfile_top_uint   (user_options->metal_compiler_runtime);
+  logfile_top_uint   (user_options->metrics_port);
   logfile_top_uint   (user_options->multiply_accel);
+  logfile_top_uint   (user_options->numa);
+  logfile_top_uint   (user_options->numa_hugepages);
   logfile_top_uint   (user_options->backend_info);
+  logfile_top_uint   (user_options->backend_native);
   logfile_top_uint   (user_options->backend_vector_width);
   logfile_top_uint   (user_options->optimized_kernel);
   logfile_top_uint   (user_options->outfile_autohex);
@@ -3730,6 +4096,8 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->outfile_json);
   logfile_top_uint   (user_options->wordlist_autohex);
   logfile_top_uint   (user_options->potfile);
+  logfile_top_uint   (user_options->potfile_compact);
+  logfile_top_uint   (user_options->potfile_shard);
   logfile_top_uint   (user_options->progress_only);
   logfile_top_uint   (user_options->quiet);
   logfile_top_uint   (user_options->remove);
@@ -3742,7 +4110,10 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->rp_gen_func_max);
   logfile_top_uint   (user_options->rp_gen_func_min);
   logfile_top_uint   (user_options->rp_gen_seed);
+  logfile_top_uint   (user_options->rules_fuzz);
+  logfile_top_uint   (user_options->rules_optimize);
   logfile_top_uint   (user_options->runtime);
+  logfile_top_uint   (user_options->salt_pack);
   logfile_top_uint   (user_options->scrypt_tmto);
   logfile_top_uint   (user_options->segment_size);
   logfile_top_uint   (user_options->self_test);
@@ -3755,6 +4126,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->status_timer);
   logfile_top_uint   (user_options->stdout_flag);
   logfile_top_uint   (user_options->usage);
+  logfile_top_uint   (user_options->tune_energy);
   logfile_top_uint   (user_options->username);
   logfile_top_uint   (user_options->veracrypt_pim_start);
   logfile_top_uint   (user_options->veracrypt_pim_stop);
@@ -3765,6 +4137,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->brain_client_features);
   logfile_top_uint   (user_options->brain_server);
   logfile_top_uint   (user_options->brain_server_timer);
+  logfile_top_uint   (user_options->brain_server_lease);
   logfile_top_uint   (user_options->brain_port);
   logfile_top_uint   (user_options->brain_session);
   #endif
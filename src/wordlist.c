@@ -320,13 +320,16 @@ void get_next_word (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, char **out_buf, u32
     {
       if (len >= RP_PASSWORD_SIZE) continue;
 
-      char rule_buf_out[RP_PASSWORD_SIZE];
+      if (wl_data->rule_l_rejects == true)
+      {
+        char rule_buf_out[RP_PASSWORD_SIZE];
 
-      memset (rule_buf_out, 0, sizeof (rule_buf_out));
+        memset (rule_buf_out, 0, sizeof (rule_buf_out));
 
-      const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, user_options_extra->rule_len_l, ptr, (u32) len, rule_buf_out);
+        const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, user_options_extra->rule_len_l, ptr, (u32) len, rule_buf_out);
 
-      if (rule_len_out < 0) continue;
+        if (rule_len_out < 0) continue;
+      }
     }
 
     if (len > PW_MAX) continue;
@@ -434,6 +437,44 @@ void pw_add (hc_device_param_t *device_param, const u8 *pw_buf, const int pw_len
   }
 }
 
+static u64 wordlist_mark_sig (hashcat_ctx_t *hashcat_ctx)
+{
+  // everything that changes which lines count as a word, word marks recorded under a different signature are dropped
+
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  u64 sig = 0xcbf29ce484222325;
+
+  #define MARK_SIG_ADD(buf,len) for (size_t k = 0; k < (size_t) (len); k++) { sig ^= ((const u8 *) (buf))[k]; sig *= 0x100000001b3; }
+
+  MARK_SIG_ADD (&hashconfig->opts_type, sizeof (hashconfig->opts_type));
+  MARK_SIG_ADD (&user_options->wordlist_autohex, sizeof (user_options->wordlist_autohex));
+  MARK_SIG_ADD (user_options->encoding_from, strlen (user_options->encoding_from) + 1);
+  MARK_SIG_ADD (user_options->encoding_to,   strlen (user_options->encoding_to)   + 1);
+  MARK_SIG_ADD (user_options->rule_buf_l,    strlen (user_options->rule_buf_l)    + 1);
+
+  #undef MARK_SIG_ADD
+
+  return sig;
+}
+
+void wordlist_seek (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, u64 *words_cur, const u64 words_off)
+{
+  wl_data_t *wl_data = hashcat_ctx->wl_data;
+
+  u64 mark_words = 0;
+
+  if (hc_fseek_mark (fp, wordlist_mark_sig (hashcat_ctx), *words_cur, words_off, &mark_words) == false) return;
+
+  *words_cur = mark_words;
+
+  // the buffered segment belongs to the old position
+
+  wl_data->pos = 0;
+  wl_data->cnt = 0;
+}
+
 int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u64 *result)
 {
   combinator_ctx_t     *combinator_ctx     = hashcat_ctx->combinator_ctx;
@@ -568,8 +609,14 @@ int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u
   u64 cnt  = 0;
   u64 cnt2 = 0;
 
+  const u64 mark_sig = wordlist_mark_sig (hashcat_ctx);
+
   while (!hc_feof (fp))
   {
+    // segments start at a line boundary, remember where for restore and --skip
+
+    hc_fmark (fp, mark_sig, d.cnt);
+
     if (load_segment (hashcat_ctx, fp) == -1)
     {
       return -2;
@@ -616,13 +663,16 @@ int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u
       {
         if (len >= RP_PASSWORD_SIZE) continue;
 
-        char rule_buf_out[RP_PASSWORD_SIZE];
+        if (wl_data->rule_l_rejects == true)
+        {
+          char rule_buf_out[RP_PASSWORD_SIZE];
 
-        memset (rule_buf_out, 0, sizeof (rule_buf_out));
+          memset (rule_buf_out, 0, sizeof (rule_buf_out));
 
-        const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, user_options_extra->rule_len_l, ptr, (u32) len, rule_buf_out);
+          const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, user_options_extra->rule_len_l, ptr, (u32) len, rule_buf_out);
 
-        if (rule_len_out < 0) continue;
+          if (rule_len_out < 0) continue;
+        }
       }
 
       cnt2++;
@@ -702,9 +752,10 @@ int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u
 
 int wl_data_init (hashcat_ctx_t *hashcat_ctx)
 {
-  wl_data_t      *wl_data      = hashcat_ctx->wl_data;
-  hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
-  user_options_t *user_options = hashcat_ctx->user_options;
+  wl_data_t            *wl_data            = hashcat_ctx->wl_data;
+  hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
 
   wl_data->enabled = false;
 
@@ -724,6 +775,13 @@ int wl_data_init (hashcat_ctx_t *hashcat_ctx)
   wl_data->cnt     = 0;
   wl_data->pos     = 0;
 
+  wl_data->rule_l_rejects = false;
+
+  if (run_rule_engine (user_options_extra->rule_len_l, user_options->rule_buf_l))
+  {
+    wl_data->rule_l_rejects = run_rule_engine_rejects (user_options_extra->rule_len_l, user_options->rule_buf_l);
+  }
+
   /**
    * choose dictionary parser
    */
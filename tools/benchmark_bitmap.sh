@@ -0,0 +1,125 @@
+#!/usr/bin/env bash
+
+##
+## Author......: See docs/credits.txt
+## License.....: MIT
+##
+
+## compares the speed of a fast unsalted multi-hash attack with and without
+## the first-level bitmap (--bitmap-l1-disable) for hashlists of random digests
+##
+## the first-level bitmap is only used while it rejects most candidates, with
+## random digests that is up to about 30k of them, above it both runs should
+## show the same speed
+##
+## the lists are generated once into the work directory and reused, the 50M
+## one needs about 1.7 GB of disk and a lot more of host memory to load
+
+VERSION="1.0"
+
+BIN="./hashcat"
+HASH_MODE=0
+MASK="?a?a?a?a?a?a?a"
+SIZES="1000000 10000000 50000000"
+WORKDIR="test_benchmarkBitmap"
+EXTRA=""
+
+function usage()
+{
+  echo "> Bitmap Benchmark, version ${VERSION}"
+  echo ""
+  echo "> Usage: $0 [<OPTIONS>]"
+  echo ""
+  echo "<OPTIONS>:"
+  echo ""
+  echo "-b / --binary <arg>                : set hashcat binary (default: ${BIN})"
+  echo "-m / --hash-type <arg>             : set unsalted hash-mode with 128 bit digests (default: ${HASH_MODE})"
+  echo "-n / --sizes <arg>                 : set digest counts, quoted and separated by spaces (default: \"${SIZES}\")"
+  echo "-w / --workdir <arg>               : set directory for the generated hashlists (default: ${WORKDIR})"
+  echo "-x / --extra <arg>                 : set extra hashcat options, quoted, e.g. \"-d 1 -O\" (default: none)"
+  echo ""
+  echo "-h / --help                        : show this help, then exit"
+  echo ""
+
+  exit 1
+}
+
+while [ $# -gt 0 ]; do
+  case "${1}" in
+    -b|--binary)    BIN="${2}";       shift ;;
+    -m|--hash-type) HASH_MODE="${2}"; shift ;;
+    -n|--sizes)     SIZES="${2}";     shift ;;
+    -w|--workdir)   WORKDIR="${2}";   shift ;;
+    -x|--extra)     EXTRA="${2}";     shift ;;
+    -h|--help)      usage ;;
+    *)              usage ;;
+  esac
+
+  shift
+done
+
+if [ ! -x "${BIN}" ]; then
+  echo "! ${BIN}: not found, build it first"
+
+  exit 1
+fi
+
+mkdir -p "${WORKDIR}"
+
+# random 128 bit digests, as hex, one per line
+
+function generate()
+{
+  local cnt="${1}"
+  local out="${2}"
+
+  if [ -f "${out}" ] && [ "$(wc -l < "${out}")" -eq "${cnt}" ]; then
+    return
+  fi
+
+  echo "> Generating ${cnt} digests into ${out}"
+
+  head -c $(( cnt * 16 )) /dev/urandom | od -An -v -tx1 -w16 | tr -d ' ' > "${out}"
+}
+
+# prints the speed in H/s, summed over all devices
+
+function measure()
+{
+  local hashfile="${1}"
+  local opts="${2}"
+
+  local log=$(${BIN} -m ${HASH_MODE} -a 3 "${hashfile}" "${MASK}" --speed-only --potfile-disable --session benchmark_bitmap ${EXTRA} ${opts} 2>&1)
+
+  local speed=$(echo "${log}" | awk '
+    /^Speed\.#/ {
+      total = ($1 == "Speed.#*.........:");
+
+      v = $2; u = $3;
+
+      if      (u == "kH/s") v *= 1e3;
+      else if (u == "MH/s") v *= 1e6;
+      else if (u == "GH/s") v *= 1e9;
+      else if (u == "TH/s") v *= 1e12;
+
+      if (total) { sum = v; done = 1 } else if (!done) { sum += v }
+    }
+    END { printf ("%.0f", sum) }')
+
+  echo "${speed}"
+}
+
+printf "%-12s %16s %16s %8s\n" "Digests" "With L1 H/s" "Without L1 H/s" "Speedup"
+
+for cnt in ${SIZES}; do
+  hashfile="${WORKDIR}/digests_${cnt}.txt"
+
+  generate "${cnt}" "${hashfile}"
+
+  with_l1=$(measure "${hashfile}" "")
+  without_l1=$(measure "${hashfile}" "--bitmap-l1-disable")
+
+  speedup=$(awk -v a="${with_l1}" -v b="${without_l1}" 'BEGIN { if (b > 0) printf ("%.3fx", a / b); else printf ("n/a"); }')
+
+  printf "%-12s %16s %16s %8s\n" "${cnt}" "${with_l1}" "${without_l1}" "${speedup}"
+done
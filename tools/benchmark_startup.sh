@@ -0,0 +1,113 @@
+#!/usr/bin/env bash
+
+##
+## Author......: See docs/credits.txt
+## License.....: MIT
+##
+
+## compares the startup time of the default build, which loads one shared
+## object per hash-mode, with the "make static" build that links them all in
+##
+## build both first:
+##   make && make static
+
+VERSION="1.0"
+
+BIN_DYNAMIC="./hashcat"
+BIN_STATIC="./hashcat.static"
+RUNS=5
+
+function usage()
+{
+  echo "> Startup Benchmark, version ${VERSION}"
+  echo ""
+  echo "> Usage: $0 [<OPTIONS>]"
+  echo ""
+  echo "<OPTIONS>:"
+  echo ""
+  echo "-d / --dynamic <arg>               : set binary which loads the modules folder (default: ${BIN_DYNAMIC})"
+  echo "-s / --static <arg>                : set binary with linked in modules (default: ${BIN_STATIC})"
+  echo "-r / --runs <arg>                  : set number of runs per command (default: ${RUNS})"
+  echo ""
+  echo "-h / --help                        : show this help, then exit"
+  echo ""
+
+  exit 1
+}
+
+while [ $# -gt 0 ]; do
+  case "${1}" in
+    -d|--dynamic) BIN_DYNAMIC="${2}"; shift ;;
+    -s|--static)  BIN_STATIC="${2}";  shift ;;
+    -r|--runs)    RUNS="${2}";        shift ;;
+    -h|--help)    usage ;;
+    *)            usage ;;
+  esac
+
+  shift
+done
+
+for bin in "${BIN_DYNAMIC}" "${BIN_STATIC}"; do
+  if [ ! -x "${bin}" ]; then
+    echo "! ${bin}: not found, build it first (make && make static)"
+
+    exit 1
+  fi
+done
+
+HASH_FILE=$(mktemp)
+
+echo "8743b52063cd84097a65d1633f5c74f5" > "${HASH_FILE}"
+
+# every command touches all hash-modes, except the first one which is the baseline
+
+COMMANDS=(
+  "--hash-info -m 0"
+  "--hash-info"
+  "-hh"
+  "--identify ${HASH_FILE}"
+)
+
+# prints the milliseconds of the fastest and the average run
+
+function measure()
+{
+  local bin="${1}"
+  local cmd="${2}"
+
+  local min=0
+  local sum=0
+
+  for ((i = 0; i < RUNS; i++)); do
+    local t0=$(date +%s%N)
+
+    ${bin} ${cmd} --quiet > /dev/null 2>&1
+
+    local t1=$(date +%s%N)
+
+    local ms=$(( (t1 - t0) / 1000000 ))
+
+    sum=$(( sum + ms ))
+
+    if [ ${i} -eq 0 ] || [ ${ms} -lt ${min} ]; then
+      min=${ms}
+    fi
+  done
+
+  echo "${min} $(( sum / RUNS ))"
+}
+
+printf "%-40s %18s %18s %8s\n" "Command" "Dynamic min/avg" "Static min/avg" "Speedup"
+
+for cmd in "${COMMANDS[@]}"; do
+  read -r dyn_min dyn_avg <<< "$(measure "${BIN_DYNAMIC}" "${cmd}")"
+  read -r sta_min sta_avg <<< "$(measure "${BIN_STATIC}"  "${cmd}")"
+
+  speedup=$(awk -v d="${dyn_min}" -v s="${sta_min}" 'BEGIN { if (s > 0) printf ("%.2fx", d / s); else printf ("n/a"); }')
+
+  label="${cmd//${HASH_FILE}/hash.txt}"
+
+  printf "%-40s %9s/%-8s %9s/%-8s %8s\n" "${label}" "${dyn_min}ms" "${dyn_avg}ms" "${sta_min}ms" "${sta_avg}ms" "${speedup}"
+done
+
+rm -f "${HASH_FILE}"